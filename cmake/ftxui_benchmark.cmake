@@ -7,12 +7,17 @@ endif()
 
 include(cmake/ftxui_find_google_benchmark.cmake)
 
+# The numbers are only meaningful with -DCMAKE_BUILD_TYPE=Release. Run a subset
+# with, for instance: ftxui-benchmark --benchmark_filter=BenchmarkFrame
+
 add_executable(ftxui-benchmark
+  src/ftxui/component/benchmark_test.cpp
+  src/ftxui/component/complexity_benchmark_test.cpp
   src/ftxui/dom/benchmark_test.cpp
   )
 ftxui_set_options(ftxui-benchmark)
 target_link_libraries(ftxui-benchmark
-  PRIVATE dom
+  PRIVATE component
   PRIVATE benchmark::benchmark
   PRIVATE benchmark::benchmark_main
   )
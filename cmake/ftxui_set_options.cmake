@@ -101,6 +101,11 @@ function(ftxui_set_options library)
     target_compile_definitions(${library}
       PRIVATE "FTXUI_MICROSOFT_TERMINAL_FALLBACK")
   endif()
+
+  if (FTXUI_ALLOCATION_COUNTING)
+    target_compile_definitions(${library}
+      PRIVATE "FTXUI_ALLOCATION_COUNTING")
+  endif()
 endfunction()
 
 if (EMSCRIPTEN)
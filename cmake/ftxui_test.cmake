@@ -8,23 +8,42 @@ include(cmake/ftxui_find_google_test.cmake)
 
 add_executable(ftxui-tests
   src/ftxui/component/animation_test.cpp
+  src/ftxui/component/async_data_source_test.cpp
+  src/ftxui/component/async_renderer_test.cpp
   src/ftxui/component/button_test.cpp
+  src/ftxui/component/checkbox_list_test.cpp
   src/ftxui/component/collapsible_test.cpp
   src/ftxui/component/component_test.cpp
   src/ftxui/component/component_test.cpp
   src/ftxui/component/container_test.cpp
+  src/ftxui/component/dropdown_test.cpp
+  src/ftxui/component/file_data_source_test.cpp
+  src/ftxui/component/fuzzy_filter_test.cpp
   src/ftxui/component/hoverable_test.cpp
   src/ftxui/component/input_test.cpp
+  src/ftxui/component/keyed_children_test.cpp
+  src/ftxui/component/memo_test.cpp
   src/ftxui/component/menu_test.cpp
   src/ftxui/component/modal_test.cpp
+  src/ftxui/component/observable_test.cpp
+  src/ftxui/component/profiler_test.cpp
   src/ftxui/component/radiobox_test.cpp
   src/ftxui/util/ref_test.cpp
   src/ftxui/component/receiver_test.cpp
+  src/ftxui/component/render_sink_test.cpp
   src/ftxui/component/resizable_split_test.cpp
   src/ftxui/component/screen_interactive_test.cpp
+  src/ftxui/component/session_replay_test.cpp
+  src/ftxui/component/shared_value_test.cpp
   src/ftxui/component/slider_test.cpp
+  src/ftxui/component/task_test.cpp
   src/ftxui/component/terminal_input_parser_test.cpp
+  src/ftxui/component/terminal_probe_test.cpp
+  src/ftxui/component/timer_wheel_test.cpp
   src/ftxui/component/toggle_test.cpp
+  src/ftxui/component/tree_view_test.cpp
+  src/ftxui/component/window_test.cpp
+  src/ftxui/component/windows_mouse_test.cpp
   src/ftxui/dom/blink_test.cpp
   src/ftxui/dom/bold_test.cpp
   src/ftxui/dom/border_test.cpp
@@ -32,21 +51,39 @@ add_executable(ftxui-tests
   src/ftxui/dom/color_test.cpp
   src/ftxui/dom/dbox_test.cpp
   src/ftxui/dom/dim_test.cpp
+  src/ftxui/dom/element_stats_test.cpp
+  src/ftxui/dom/flat_layout_test.cpp
   src/ftxui/dom/flexbox_helper_test.cpp
   src/ftxui/dom/flexbox_test.cpp
   src/ftxui/dom/gauge_test.cpp
+  src/ftxui/dom/graph_series_test.cpp
   src/ftxui/dom/gridbox_test.cpp
   src/ftxui/dom/hbox_test.cpp
   src/ftxui/dom/hyperlink_test.cpp
+  src/ftxui/dom/image_test.cpp
   src/ftxui/dom/linear_gradient_test.cpp
+  src/ftxui/dom/live_test.cpp
+  src/ftxui/dom/log_buffer_test.cpp
+  src/ftxui/dom/node_pool_test.cpp
+  src/ftxui/dom/node_test.cpp
+  src/ftxui/dom/paragraph_test.cpp
   src/ftxui/dom/scroll_indicator_test.cpp
   src/ftxui/dom/separator_test.cpp
+  src/ftxui/dom/shared_test.cpp
   src/ftxui/dom/spinner_test.cpp
+  src/ftxui/dom/static_decorator_test.cpp
+  src/ftxui/dom/stream_renderer_test.cpp
+  src/ftxui/dom/style_test.cpp
   src/ftxui/dom/table_test.cpp
   src/ftxui/dom/text_test.cpp
   src/ftxui/dom/underlined_test.cpp
   src/ftxui/dom/vbox_test.cpp
+  src/ftxui/dom/worker_pool_test.cpp
+  src/ftxui/screen/allocations_test.cpp
+  src/ftxui/screen/cell_buffer_test.cpp
   src/ftxui/screen/color_test.cpp
+  src/ftxui/screen/cpu_dispatch_test.cpp
+  src/ftxui/screen/screen_test.cpp
   src/ftxui/screen/string_test.cpp
 )
 
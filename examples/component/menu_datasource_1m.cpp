@@ -86,6 +86,9 @@ int main() {
     // return false when offset would go out of bounds.
     return from != initial;
   };
+  // Optional: allow DBMenu to compute its scroll position directly.
+  data_source.id_to_index = [](int64_t id) { return id; };
+  data_source.index_to_id = [](int64_t index) { return index; };
   // transform is called component-height number of times in one render cycle.
   data_source.transform = [&items](DSRenderContext& c) -> Element {
     // Note: We access row text in transform callback. DBMenu doesn't access our
@@ -0,0 +1,52 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ftxui/component/component.hpp"
+#include "ftxui/component/component_options.hpp"
+#include "ftxui/component/fuzzy_filter.hpp"
+#include "ftxui/component/screen_interactive.hpp"
+#include "ftxui/dom/elements.hpp"
+
+int main() {
+  using namespace ftxui;
+  auto screen = ScreenInteractive::Fullscreen();
+
+  // Our large data set: 1M file names.
+  const std::vector<std::string> words = {
+      "alpha", "bravo",  "charlie", "delta",  "echo",    "foxtrot",
+      "golf",  "hotel",  "india",   "juliet", "kilo",    "lima",
+      "mike",  "oscar",  "papa",    "quebec", "romeo",   "sierra",
+  };
+  std::vector<std::string> entries;
+  entries.reserve(1000000);
+  for (int i = 0; i < 1000000; ++i) {
+    entries.push_back(words[i % words.size()] + "/" +
+                      words[(i / 7) % words.size()] + "_" +
+                      std::to_string(i) + ".txt");
+  }
+
+  FuzzyFilter filter({
+      .size = [&] { return int64_t(entries.size()); },
+      .entry = [&](int64_t i) -> std::string_view { return entries[i]; },
+      .transform =
+          [&](DSRenderContext& c) {
+            Element row = text(entries[filter.Entry(c.id)]);
+            return c.focused ? row | inverted : row;
+          },
+  });
+
+  auto menu = FuzzyFilterMenu(&filter);
+  auto app = Renderer(menu, [&] {
+    double render_time = ScreenInteractive::Active()->LastFrameTime();
+    return window(text(" Render time: " +
+                       std::to_string(int(render_time * 1000.0)) + "ms ") |
+                      hcenter,
+                  menu->Render());
+  });
+  screen.Loop(app);
+}
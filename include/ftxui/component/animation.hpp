@@ -4,8 +4,11 @@
 #ifndef FTXUI_ANIMATION_HPP
 #define FTXUI_ANIMATION_HPP
 
-#include <chrono>      // for milliseconds, duration, steady_clock, time_point
-#include <functional>  // for function
+#include <chrono>  // for milliseconds, duration, steady_clock, time_point
+#include <cstddef>        // for size_t
+#include <functional>     // for function
+#include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
 
 namespace ftxui::animation {
 // Components who haven't completed their animation can call this function to
@@ -108,6 +111,60 @@ class Animator {
   Duration current_;
 };
 
+// Animate many values sharing the same duration and easing function. This
+// behaves like a vector of Animator, but the animations in flight are stored
+// contiguously, and stepped all at once. Only the animations in flight and the
+// values at rest other than zero are stored: memory and work grow with them,
+// not with the size of the array.
+//
+// The polynomial easing functions (Linear, Quadratic, Cubic, Quartic, Quintic)
+// are applied by batch, in a loop the compiler can vectorize. Others are
+// called once per value.
+class AnimatorArray {
+ public:
+  explicit AnimatorArray(
+      Duration duration = std::chrono::milliseconds(250),
+      easing::Function easing_function = easing::Linear);
+
+  // Used by the next calls to AnimateTo().
+  void SetDuration(Duration duration);
+  void SetEasing(easing::Function easing_function);
+
+  // The new values start at zero.
+  void Resize(size_t size);
+  size_t size() const { return size_; }
+
+  float value(size_t i) const;
+  // The value |i| is animated toward.
+  float to(size_t i) const;
+
+  // Animate the value |i| from its current value to |to|.
+  void AnimateTo(size_t i, float to);
+
+  void OnAnimation(Params&);
+
+ private:
+  void Remove(size_t slot);
+
+  Duration duration_;
+  easing::Function easing_function_;
+  void (*batch_easing_)(float* p, size_t size) = nullptr;
+
+  size_t size_ = 0;
+  // The values at rest, other than zero.
+  std::unordered_map<size_t, float> rest_;
+  // The position of the values in flight in the arrays below.
+  std::unordered_map<size_t, int> slot_;
+
+  // The animations in flight:
+  std::vector<size_t> index_;
+  std::vector<float> value_;
+  std::vector<float> from_;
+  std::vector<float> to_;
+  std::vector<float> elapsed_;  // In seconds.
+  std::vector<float> progress_;
+};
+
 }  // namespace ftxui::animation
 
 #endif /* end of include guard: FTXUI_ANIMATION_HPP */
@@ -0,0 +1,60 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_ASYNC_DATA_SOURCE_HPP
+#define FTXUI_COMPONENT_ASYNC_DATA_SOURCE_HPP
+
+#include <cstdint>     // for int64_t
+#include <functional>  // for function
+#include <memory>      // for shared_ptr
+
+#include "ftxui/component/component_options.hpp"  // for DataSource, DSRenderContext
+#include "ftxui/dom/elements.hpp"                 // for Element
+
+namespace ftxui {
+
+struct AsyncDataSourceOption {
+  // Number of items fetched at once.
+  int64_t page_size = 64;
+  // Number of pages fetched ahead in the scroll direction, and behind it.
+  int prefetch_pages = 2;
+
+  // Load the items [first, first + count) into the user's storage. Called on a
+  // worker thread.
+  std::function<void(int64_t first, int64_t count)> fetch;
+  // Produce the row of an item already fetched.
+  std::function<Element(DSRenderContext&)> transform;
+  // Produce the row of an item being fetched.
+  std::function<Element(DSRenderContext&)> placeholder;
+};
+
+// Make a DataSource fetch its items asynchronously. Its |transform| is replaced:
+// rows whose page wasn't fetched yet are displayed using a placeholder, while
+// a worker thread fetches them, and the pages around. When a page arrives,
+// the active ScreenInteractive is asked to redraw.
+//
+// The ids of the DataSource are converted into indices using |id_to_index|,
+// or are assumed to be indices otherwise.
+class AsyncDataSource {
+ public:
+  AsyncDataSource(DataSource* source, AsyncDataSourceOption option);
+  ~AsyncDataSource();
+
+  // Forget about the pages fetched. They are fetched again when displayed.
+  void Invalidate();
+  bool IsFetched(int64_t id) const;
+
+  // This class is non copyable/movable.
+  AsyncDataSource(const AsyncDataSource&) = delete;
+  AsyncDataSource(AsyncDataSource&&) = delete;
+  AsyncDataSource& operator=(const AsyncDataSource&) = delete;
+  AsyncDataSource& operator=(AsyncDataSource&&) = delete;
+
+ private:
+  class Impl;
+  std::shared_ptr<Impl> impl_;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_ASYNC_DATA_SOURCE_HPP
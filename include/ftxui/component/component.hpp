@@ -4,6 +4,7 @@
 #ifndef FTXUI_COMPONENT_HPP
 #define FTXUI_COMPONENT_HPP
 
+#include <cstddef>     // for size_t
 #include <functional>  // for function
 #include <memory>      // for make_shared, shared_ptr
 #include <utility>     // for forward
@@ -14,12 +15,18 @@
 #include "ftxui/util/ref.hpp"  // for ConstRef, Ref, ConstStringRef, ConstStringListRef, StringRef
 
 namespace ftxui {
+struct AsyncOption;
+struct AsyncRendererOption;
 struct ButtonOption;
+struct CheckboxListOption;
 struct CheckboxOption;
 struct Event;
 struct InputOption;
 struct MenuOption;
+struct ModalOption;
 struct RadioboxOption;
+struct TabOption;
+struct TreeViewOption;
 struct MenuEntryOption;
 
 template <class T, class... Args>
@@ -41,6 +48,7 @@ Component Vertical(Components children, int* selector);
 Component Horizontal(Components children);
 Component Horizontal(Components children, int* selector);
 Component Tab(Components children, int* selector);
+Component Tab(Components children, int* selector, TabOption option);
 Component Stacked(Components children);
 }  // namespace Container
 
@@ -53,6 +61,10 @@ Component Checkbox(CheckboxOption options);
 Component Checkbox(ConstStringRef label,
                    bool* checked,
                    CheckboxOption options = CheckboxOption::Simple());
+Component CheckboxList(CheckboxListOption options);
+Component CheckboxList(ConstStringListRef entries,
+                       std::vector<bool>* checked,
+                       CheckboxListOption options = {});
 
 Component Input(InputOption options = {});
 Component Input(StringRef content, InputOption options = {});
@@ -68,6 +80,7 @@ Component MenuEntry(MenuEntryOption options);
 Component MenuEntry(ConstStringRef label, MenuEntryOption options = {});
 
 Component DBMenu(DataSource* dataSource);
+Component TreeView(TreeViewOption options);
 
 Component Radiobox(RadioboxOption options);
 Component Radiobox(ConstStringListRef entries,
@@ -76,6 +89,8 @@ Component Radiobox(ConstStringListRef entries,
 
 Component Dropdown(ConstStringListRef entries, int* selected);
 Component Dropdown(DropdownOption options);
+Component DBDropdown(ConstStringListRef entries, int* selected);
+Component DBDropdown(DropdownOption options);
 
 Component Toggle(ConstStringListRef entries, int* selected);
 
@@ -119,8 +134,24 @@ Component Maybe(Component, std::function<bool()>);
 ComponentDecorator Maybe(const bool* show);
 ComponentDecorator Maybe(std::function<bool()>);
 
+Component Memo(Component);
+Component Memo(Component, const int* version);
+Component Memo(Component, std::function<size_t()> version);
+ComponentDecorator Memo(const int* version);
+ComponentDecorator Memo(std::function<size_t()> version);
+
+Component AsyncRenderer(AsyncRendererOption option);
+Component Async(AsyncOption option);
+
 Component Modal(Component main, Component modal, const bool* show_modal);
 ComponentDecorator Modal(Component modal, const bool* show_modal);
+Component Modal(Component main,
+                Component modal,
+                const bool* show_modal,
+                ModalOption option);
+ComponentDecorator Modal(Component modal,
+                         const bool* show_modal,
+                         ModalOption option);
 
 Component Collapsible(ConstStringRef label,
                       Component child,
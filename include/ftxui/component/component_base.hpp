@@ -4,7 +4,8 @@
 #ifndef FTXUI_COMPONENT_BASE_HPP
 #define FTXUI_COMPONENT_BASE_HPP
 
-#include <memory>  // for unique_ptr
+#include <cstdint>  // for uint64_t
+#include <memory>   // for unique_ptr
 #include <vector>  // for vector
 
 #include "ftxui/component/captured_mouse.hpp"  // for CaptureMouse
@@ -54,10 +55,13 @@ class ComponentBase {
       (*it)->parent_ = this;
     }
     children_.insert(children_.begin(), first, last);
+    ReindexChildren(0);
+    Private::InvalidateFocus();
   }
 
   void Detach();
   void DetachAllChildren();
+  void SetChildren(Components children);
 
   // Renders the component.
   virtual Element Render();
@@ -71,6 +75,26 @@ class ComponentBase {
   // Handle an animation step.
   virtual void OnAnimation(animation::Params& params);
 
+  // Called when the component stops being displayed: hidden by Maybe, or
+  // detached. By default, propagated to the children.
+  virtual void OnHide();
+
+  // Called when the component is displayed again, after OnHide(): shown by
+  // Maybe, or its tab selected again. By default, propagated to the children.
+  virtual void OnShow();
+
+  // Release what is kept to render faster, like the element reused by Memo or
+  // the layer of a Window. By default, propagated to the children.
+  virtual void ReleaseCache();
+
+  // Request a new animation frame, during which only the OnAnimation() of
+  // this component is called, instead of the whole tree's.
+  void RequestAnimationFrame();
+
+  // Draw a new frame after the event being handled, even if it isn't handled.
+  // See ScreenInteractive::LazyRedraw().
+  void RequestRedraw();
+
   // Focus management ----------------------------------------------------------
   //
   // If this component contains children, this indicates which one is active,
@@ -83,6 +107,8 @@ class ComponentBase {
   // Return true when the component contains focusable elements.
   // The non focusable Component will be skipped when navigating using the
   // keyboard.
+  // By default, whether a child is focusable. This is cached until the next
+  // event or frame. See Private::InvalidateFocus().
   virtual bool Focusable() const;
 
   // Whether this is the active child of its parent.
@@ -100,10 +126,63 @@ class ComponentBase {
  protected:
   CapturedMouse CaptureMouse(const Event& event);
 
+  // Whether the mouse |event| is only routed to the components under the mouse.
+  // See ScreenInteractive::RoutedEvents().
+  static bool Routed(const Event& event);
+  // Whether a component currently holds the CapturedMouse.
+  static bool MouseCaptured(const Event& event);
+
   Components children_;
 
  private:
+  // Whether the chain of ActiveChild() from the root contains this component.
+  bool OnFocusPath() const;
+
+  // The position of this component in the children of its parent.
+  size_t PositionInParent() const;
+  // Refresh the index_hint_ of the children from |first|.
+  void ReindexChildren(size_t first);
+
   ComponentBase* parent_ = nullptr;
+  // The last known position in the children of the parent. Checked before
+  // use: a derived class might have reordered them.
+  mutable size_t index_hint_ = 0;
+  bool animation_requested_ = false;
+  bool suspended_ = false;
+
+  // The result of ComponentBase::Focusable() and OnFocusPath(), valid as long
+  // as the focus epoch is the one they were computed in.
+  mutable uint64_t focusable_epoch_ = 0;
+  mutable uint64_t focus_path_epoch_ = 0;
+  mutable bool focusable_ = false;
+  mutable bool focus_path_ = false;
+
+ public:
+  // Used by the main loop, to only animate the components requesting it.
+  class Private {
+   public:
+    // The component whose OnAnimation() is running, nullptr if none.
+    static ComponentBase* Animating();
+    // Call |component|->OnAnimation(), with |component| being Animating().
+    static void Animate(ComponentBase* component, animation::Params& params);
+    // Animate the components having requested an animation frame.
+    static void AnimateRequested(animation::Params& params);
+    static void Request(ComponentBase* component);
+    static size_t RequestCount();
+    // Forget about the requests past the |count| first ones.
+    static void DropRequests(size_t count);
+
+    // Suspend |component| and its descendants: their requests of animation
+    // frames are dropped. Used for the tabs not selected.
+    static void Suspend(ComponentBase* component, bool suspended);
+    static bool Suspended(const ComponentBase* component);
+
+    // Forget the cached focusability and focus path of every component. To
+    // call when they might have changed: the tree changed, an event was
+    // handled, or a frame is about to be drawn.
+    static void InvalidateFocus();
+  };
+  friend Private;
 };
 
 }  // namespace ftxui
@@ -4,7 +4,10 @@
 #ifndef FTXUI_COMPONENT_COMPONENT_OPTIONS_HPP
 #define FTXUI_COMPONENT_COMPONENT_OPTIONS_HPP
 
+#include <atomic>                         // for atomic
 #include <chrono>                         // for milliseconds
+#include <cstddef>                        // for size_t
+#include <cstdint>                        // for int64_t, uint64_t
 #include <ftxui/component/animation.hpp>  // for Duration, QuadraticInOut, Function
 #include <ftxui/component/screen_interactive.hpp>
 #include <ftxui/dom/direction.hpp>  // for Direction, Direction::Left, Direction::Right, Direction::Down
@@ -12,9 +15,12 @@
 #include <ftxui/util/ref.hpp>      // for Ref, ConstRef, StringRef
 #include <functional>              // for function
 #include <string>                  // for string
+#include <string_view>             // for string_view
+#include <vector>                  // for vector
 
 #include "ftxui/component/component_base.hpp"  // for Component
 #include "ftxui/screen/color.hpp"  // for Color, Color::GrayDark, Color::White
+#include "ftxui/screen/pixel.hpp"  // for Pixel
 
 namespace ftxui {
 
@@ -85,6 +91,7 @@ struct RedrawVariables {
   int items_produced   = 0;
   int items_total      = 0;
   int component_height = 10;
+  int component_width  = 80;
   int screen_height    = 50;
 
   bool operator==(const RedrawVariables& other) const;
@@ -95,6 +102,7 @@ struct DSRenderContext {
   bool    focused = false;
   bool    hovered = false;
   bool    component_focused = false;
+  int     column = -1; // the cell's column, for DataSource::cell
 };
 
 struct DataSource;
@@ -138,15 +146,55 @@ struct DataSource {
   void set_component_height(int height);
   void invoke_redraw();
 
+  // Cache of the rows produced by |transform|, keyed by id and row state.
+  // Disabled when 0. Call invalidate_row() or invalidate_rows() when the
+  // rendering of an item changes.
+  int row_cache_capacity     = 0;
+  uint64_t rows_version      = 0; // incremented by invalidate_rows()
+  std::vector<int64_t> invalidated_rows; // drained by DBMenu on render
+  void invalidate_row(int64_t id);
+  void invalidate_rows();
+
   DataSource();
   // Interface to getting external data
   std::function<DataSize()> dataset_size;
   std::function<int64_t(int64_t)> count_items_before;
   std::function<bool(int64_t&, int64_t)> move_id_by;
+  // Optional random access. When both are set, scroll positions are computed
+  // directly, instead of walking move_id_by() one item at a time.
+  std::function<int64_t(int64_t)> id_to_index;
+  std::function<int64_t(int64_t)> index_to_id;
+  bool random_access() const;
+  // Optional height, in rows, of the item at an index. Requires random access.
+  // The heights are summed in a Fenwick tree, built on the first render, so
+  // that scrolling, PageUp/PageDown and the scroll indicator are exact for
+  // multi-line items, in O(log n). Call invalidate_height() when the height of
+  // an item changes, or invalidate_heights() when many do.
+  std::function<int(int64_t)> item_height;
+  std::vector<int64_t> height_tree; // built by DBMenu on render
+  bool variable_height() const;
+  void update_heights();
+  void invalidate_height(int64_t id);
+  void invalidate_heights();
+  int64_t rows_before(int64_t index) const; // rows of the items before index
+  int64_t index_at_row(int64_t row) const;  // index of the item on the row
+  int64_t rows_total() const;
   // Override keyboard shortcuts and advanced event handling
   std::function<bool(DSEventContext)> on_event;
   // Produce custom row (Element)  ///> Called to override default event handling.
   std::function<Element(DSRenderContext&)> transform; // Produce Element representation of item referenced by id
+
+  // Optional columns. When both are set, the rows are made of |column_count()|
+  // cells, |column_width(column)| wide. Only the cells of the columns fitting
+  // in the width are produced, by |cell|, instead of |transform|. The columns
+  // scroll horizontally to keep |focused_column| visible, moved by the left
+  // and right arrows.
+  std::function<int()> column_count;
+  std::function<int(int)> column_width;
+  std::function<Element(DSRenderContext&)> cell; // DSRenderContext::column is set
+  int focused_column         = 0;
+  int first_column           = 0; // set by DBMenu::Render()
+  bool columns() const;
 };
 
 /// @brief Option for the Menu component.
@@ -217,6 +265,24 @@ struct CheckboxOption {
   std::function<void()> on_change = [] {};
 };
 
+/// @brief Option for the CheckboxList component.
+/// @ingroup component
+struct CheckboxListOption {
+  /// The labels of the entries.
+  ConstStringListRef entries;
+  /// The state of the entries, one bit each. Owned by the caller. It is
+  /// resized to the number of entries.
+  std::vector<bool>* checked = nullptr;
+  Ref<int> focused_entry = 0;
+
+  // Style:
+  std::function<Element(const EntryState&)> transform;
+
+  // Observer:
+  /// Called when the user changes the state of some entries.
+  std::function<void()> on_change = [] {};
+};
+
 /// @brief Used to define style for the Input component.
 struct InputState {
   Element element;
@@ -226,6 +292,15 @@ struct InputState {
                         ///< placeholder.
 };
 
+/// @brief A span of a line of the Input, drawn in its own style. See
+/// |InputOption::highlight|.
+/// @ingroup component
+struct InputToken {
+  size_t start = 0;  ///< The position of its first byte, in the line.
+  size_t size = 0;   ///< Its number of bytes.
+  std::function<void(Pixel&)> style;  ///< Applied to each of its cells.
+};
+
 /// @brief Option for the Input component.
 /// @ingroup component
 struct InputOption {
@@ -255,6 +330,22 @@ struct InputOption {
 
   // The char position of the cursor:
   Ref<int> cursor_position = 0;
+
+  /// The memory kept to undo the edits with Ctrl+Z, and redo them with Ctrl+Y,
+  /// in bytes. Only the text inserted or erased is kept. 0 disables undo.
+  size_t undo_memory = 1 << 20;
+
+  /// Highlight the content, one line at a time. Called with a line, and the
+  /// state at its start, 0 for the first line. Return the state at its end,
+  /// like being inside a comment. The tokens of the line are appended to
+  /// |tokens| in order, unless it is null.
+  /// The states are kept from one frame to the next. After an edit, the lines
+  /// are highlighted again from the one edited, until their state is the one
+  /// kept. The tokens are collected for the lines drawn only.
+  std::function<int(std::string_view line,
+                    int state,
+                    std::vector<InputToken>* tokens)>
+      highlight = nullptr;
 };
 
 /// @brief Option for the Radiobox component.
@@ -331,6 +422,26 @@ struct WindowOptions {
 
   /// An optional function to customize how the window looks like:
   std::function<Element(const WindowRenderState&)> render;
+
+  /// An optional function returning a version of the window's content. When
+  /// set, the window is rendered into a layer reused across frames, as long as
+  /// the version is the same, and the window doesn't change: geometry, title,
+  /// focus, events handled, mouse events while no other component holds the
+  /// mouse. The window must paint every cell of its box, like the default
+  /// |render|.
+  std::function<size_t()> layer;
+};
+
+/// @brief Option for Container::Tab.
+/// @ingroup component
+struct TabOption {
+  /// Whether the tabs not selected are suspended: they aren't animated, even
+  /// when requesting animation frames. They are told with OnHide() when they
+  /// are left, and with OnShow() when they are selected again.
+  bool suspend_inactive = false;
+  /// Whether the tabs left also release what is cached to render them faster.
+  /// See ComponentBase::ReleaseCache().
+  bool release_cache = false;
 };
 
 /// @brief Option for the Dropdown component.
@@ -348,6 +459,78 @@ struct DropdownOption {
       transform;
 };
 
+/// @brief Option for the AsyncRenderer component.
+/// @ingroup component
+struct AsyncRendererOption {
+  /// Build the element. Called on a worker thread: it must only read data safe
+  /// to access from there, like an immutable snapshot.
+  std::function<Element()> build;
+  /// Called on the UI thread. The element is built again whenever it returns a
+  /// different value. The element is built once when empty.
+  std::function<size_t()> version;
+  /// Displayed until the first element is built.
+  std::function<Element()> placeholder = [] { return text("...") | dim; };
+};
+
+/// @brief Option for the Async component.
+/// @ingroup component
+struct AsyncOption {
+  /// Fetch the data, on the |executor|, and return the function displaying it,
+  /// called on the UI thread. The data is usually moved into the function.
+  /// Should return early once |cancelled| is set: the result is then dropped.
+  std::function<std::function<Element()>(const std::atomic<bool>& cancelled)>
+      fetch;
+  /// Called on the UI thread. The data is fetched again whenever it returns a
+  /// different value. The data is fetched once when empty.
+  std::function<size_t()> version;
+  /// Displayed until the first data is fetched.
+  std::function<Element()> placeholder = [] { return text("...") | dim; };
+  /// Run a fetch. By default, on the worker pool of the active screen, see
+  /// ScreenInteractive::RunInBackground(), or else on a new thread.
+  std::function<void(std::function<void()> job)> executor;
+};
+
+/// @brief Option for the Modal component.
+/// @ingroup component
+struct ModalOption {
+  /// While the modal is shown, render the main component once, and draw a copy
+  /// of its pixels on the next frames instead of rendering it again.
+  bool snapshot_background = false;
+  /// Applied to the main component below the modal, like `dim`.
+  Decorator background;
+  /// Called while the snapshot is kept. The main component is rendered again
+  /// whenever it returns true.
+  std::function<bool()> background_changed;
+};
+
+/// @brief The state of a row of a TreeView.
+/// @ingroup component
+struct TreeNodeState {
+  int64_t node = 0;         ///< The node displayed.
+  std::string label;        ///< Its label.
+  int depth = 0;            ///< 0 for the children of the root.
+  bool expandable = false;  ///< Whether the node may have children.
+  bool expanded = false;    ///< Whether its children are displayed.
+  bool focused = false;     ///< Whether the row is the focused one.
+  bool active = false;      ///< Whether the row is focused, and the tree too.
+};
+
+/// @brief Option for the TreeView component.
+/// @ingroup component
+struct TreeViewOption {
+  /// The root node. It isn't displayed: its children are the top rows.
+  int64_t root = 0;
+  /// The children of a node. Called once, when it is first expanded.
+  std::function<std::vector<int64_t>(int64_t node)> children;
+  /// Whether a node may have children, without fetching them. By default,
+  /// until they are fetched.
+  std::function<bool(int64_t node)> expandable;
+  std::function<std::string(int64_t node)> label;
+  std::function<Element(const TreeNodeState&)> transform;
+  /// Called after a node is expanded or collapsed.
+  std::function<void(int64_t node, bool expanded)> on_toggle;
+};
+
 }  // namespace ftxui
 
 #endif /* end of include guard: FTXUI_COMPONENT_COMPONENT_OPTIONS_HPP */
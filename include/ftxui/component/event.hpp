@@ -4,6 +4,8 @@
 #ifndef FTXUI_COMPONENT_EVENT_HPP
 #define FTXUI_COMPONENT_EVENT_HPP
 
+#include <chrono>                     // for steady_clock
+#include <cstdint>                    // for uint64_t
 #include <ftxui/component/mouse.hpp>  // for Mouse
 #include <string>                     // for string, operator==
 
@@ -31,8 +33,16 @@ struct Event {
   static Event Character(wchar_t);
   static Event Special(std::string);
   static Event Mouse(std::string, Mouse mouse);
+  static Event Paste(std::string);
   static Event CursorPosition(std::string, int x, int y);  // Internal
   static Event CursorShape(std::string, int shape);        // Internal
+  static Event ModeReport(std::string, int mode, int value);  // Internal
+  static Event DeviceAttributes(std::string,
+                                int level,
+                                int type,
+                                int version,
+                                uint64_t attributes);  // Internal
+  static Event TerminalVersion(std::string);           // Internal
 
   // --- Arrow ---
   static const Event ArrowLeft;
@@ -95,9 +105,16 @@ struct Event {
   static const Event Custom;
 
   //--- Method section ---------------------------------------------------------
-  bool operator==(const Event& other) const { return input_ == other.input_; }
+  bool operator==(const Event& other) const {
+    return key_ == other.key_ && (key_ != 0 || input_ == other.input_);
+  }
   bool operator!=(const Event& other) const { return !operator==(other); }
-  bool operator<(const Event& other) const { return input_ < other.input_; }
+  bool operator<(const Event& other) const {
+    if (key_ != other.key_) {
+      return key_ < other.key_;
+    }
+    return key_ == 0 && input_ < other.input_;
+  }
 
   const std::string& input() const { return input_; }
 
@@ -107,6 +124,9 @@ struct Event {
   bool is_mouse() const { return type_ == Type::Mouse; }
   struct Mouse& mouse() { return data_.mouse; }
 
+  // A text pasted at once, in bracketed paste mode. See input().
+  bool is_paste() const { return type_ == Type::Paste; }
+
   // --- Internal Method section -----------------------------------------------
   bool is_cursor_position() const { return type_ == Type::CursorPosition; }
   int cursor_x() const { return data_.cursor.x; }
@@ -115,6 +135,31 @@ struct Event {
   bool is_cursor_shape() const { return type_ == Type::CursorShape; }
   int cursor_shape() const { return data_.cursor_shape; }
 
+  bool is_mode_report() const { return type_ == Type::ModeReport; }
+  int mode() const { return data_.mode_report.mode; }
+  int mode_value() const { return data_.mode_report.value; }
+
+  // DA1 (level 1) or DA2 (level 2) report.
+  bool is_device_attributes() const { return type_ == Type::DeviceAttributes; }
+  int device_level() const { return data_.device.level; }
+  int device_type() const { return data_.device.type; }
+  int device_version() const { return data_.device.version; }
+  bool device_attribute(int attribute) const {
+    return attribute >= 0 && attribute < 64 &&
+           ((data_.device.attributes >> attribute) & 1U);
+  }
+  uint64_t device_attributes() const { return data_.device.attributes; }
+
+  // XTVERSION report, like "kitty(0.35.2)".
+  bool is_terminal_version() const { return type_ == Type::TerminalVersion; }
+  std::string terminal_version() const;
+
+  // When the input of the event was read from the terminal. Unset for the
+  // events posted by the application.
+  std::chrono::steady_clock::time_point read_time() const {
+    return read_time_;
+  }
+
   // Debug
   std::string DebugString() const;
 
@@ -124,12 +169,17 @@ struct Event {
  private:
   friend ComponentBase;
   friend ScreenInteractive;
+  friend class TerminalInputParser;
   enum class Type {
     Unknown,
     Character,
     Mouse,
+    Paste,
     CursorPosition,
     CursorShape,
+    ModeReport,
+    DeviceAttributes,
+    TerminalVersion,
   };
   Type type_ = Type::Unknown;
 
@@ -138,13 +188,32 @@ struct Event {
     int y = 0;
   };
 
+  struct ModeReport {
+    int mode = 0;
+    int value = 0;
+  };
+
+  struct Device {
+    int level = 0;
+    int type = 0;
+    int version = 0;
+    uint64_t attributes = 0;  // Bit N is set when the attribute N is.
+  };
+
   union {
     struct Mouse mouse;
     struct Cursor cursor;
     int cursor_shape;
+    struct ModeReport mode_report;
+    struct Device device;
   } data_ = {};
 
+  void SetInput(std::string input);
+
   std::string input_;
+  // |input_| packed into an integer when it is short enough, 0 otherwise.
+  uint64_t key_ = 0;
+  std::chrono::steady_clock::time_point read_time_;
 };
 
 }  // namespace ftxui
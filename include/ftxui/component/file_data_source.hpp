@@ -0,0 +1,71 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_FILE_DATA_SOURCE_HPP
+#define FTXUI_COMPONENT_FILE_DATA_SOURCE_HPP
+
+#include <chrono>       // for milliseconds
+#include <cstddef>      // for size_t
+#include <cstdint>      // for int64_t
+#include <functional>   // for function
+#include <memory>       // for shared_ptr
+#include <string>       // for string
+#include <string_view>  // for string_view
+
+#include "ftxui/component/component_options.hpp"  // for DataSource, DSRenderContext
+#include "ftxui/dom/elements.hpp"                 // for Element
+
+namespace ftxui {
+
+class WorkerPool;
+
+struct FileDataSourceOption {
+  // Produce the row of a line, without its line ending. Defaults to text().
+  std::function<Element(std::string_view line, DSRenderContext&)> transform;
+  // Index the lines appended to the file, like `tail -f`, checking its size
+  // every |follow_interval|.
+  bool follow = false;
+  std::chrono::milliseconds follow_interval{250};
+  // The file is scanned by chunks of |chunk_size| bytes, spread over |pool|
+  // when provided.
+  size_t chunk_size = size_t(1) << 24;
+  WorkerPool* pool = nullptr;
+  // Longer lines are cut, for display.
+  size_t max_line_size = 4096;
+};
+
+// Serve the lines of a file to a DataSource. The file is memory mapped, and
+// its lines are indexed on a background thread: the DataSource grows while
+// the index is built, and the active ScreenInteractive is asked to redraw.
+// The lines are read from the mapping when displayed, so that only the page
+// cache holds the file.
+//
+// The ids of the DataSource are the indices of the lines.
+class FileDataSource {
+ public:
+  FileDataSource(DataSource* source,
+                 std::string path,
+                 FileDataSourceOption option = {});
+  ~FileDataSource();
+
+  // Whether the file could be opened, once the indexing started.
+  bool IsOpen() const;
+  // Whether the whole file, as of its last check, was indexed.
+  bool IsIndexed() const;
+  int64_t LineCount() const;
+  std::string Line(int64_t index) const;
+
+  // This class is non copyable/movable.
+  FileDataSource(const FileDataSource&) = delete;
+  FileDataSource(FileDataSource&&) = delete;
+  FileDataSource& operator=(const FileDataSource&) = delete;
+  FileDataSource& operator=(FileDataSource&&) = delete;
+
+ private:
+  class Impl;
+  std::shared_ptr<Impl> impl_;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_FILE_DATA_SOURCE_HPP
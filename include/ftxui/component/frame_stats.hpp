@@ -0,0 +1,66 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_FRAME_STATS_HPP
+#define FTXUI_COMPONENT_FRAME_STATS_HPP
+
+#include <array>    // for array
+#include <cstddef>  // for size_t
+
+#include "ftxui/dom/elements.hpp"        // for Element
+#include "ftxui/screen/allocations.hpp"  // for AllocationCount
+
+namespace ftxui {
+
+/// @brief Statistics about the frames drawn by a ScreenInteractive, over the
+/// last frames. The durations are in seconds.
+/// @ingroup component
+/// @see ScreenInteractive::Stats()
+struct FrameStats {
+  struct Duration {
+    double last = 0;
+    double p50 = 0;
+    double p99 = 0;
+  };
+
+  Duration component_render;  // Component::Render, building the elements.
+  Duration layout;            // Node::ComputeRequirement and Node::SetBox.
+  Duration node_render;       // Node::Render, drawing into the Screen.
+  Duration shader;            // Screen::ApplyShader.
+  Duration serialize;         // Producing the output, from the Screen.
+  Duration write;             // Writing and flushing the output.
+  Duration total;             // The whole frame.
+
+  // From an event being read from the terminal, or posted, to the frame
+  // reflecting it being written. The oldest event waiting for the frame.
+  Duration event_latency;
+
+  // The event latencies of every frame. The bucket |i| counts the ones below
+  // 2^i milliseconds, and not in a previous bucket. The last one counts the
+  // rest.
+  std::array<size_t, 12> event_latency_histogram{};
+
+  // The heap allocations made by the last frame, on the loop's thread. Only
+  // counted when FTXUI is built with FTXUI_ALLOCATION_COUNTING.
+  struct Allocations {
+    AllocationCount component_render;
+    AllocationCount render;  // Layout, Node::Render and the shaders.
+    AllocationCount serialize;
+    AllocationCount write;
+    AllocationCount total;
+  };
+  Allocations allocations;
+
+  size_t frames = 0;       // The number of frames drawn.
+  // The number of frames abandoned for the input received meanwhile. See
+  // ScreenInteractive::AbandonStaleFrames().
+  size_t frames_abandoned = 0;
+  size_t bytes_last = 0;   // The size of the output of the last frame.
+  size_t bytes_total = 0;  // The size of the output of every frame.
+};
+
+Element FrameStatsElement(const FrameStats& stats);
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_FRAME_STATS_HPP
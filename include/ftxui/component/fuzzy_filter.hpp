@@ -0,0 +1,89 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_FUZZY_FILTER_HPP
+#define FTXUI_COMPONENT_FUZZY_FILTER_HPP
+
+#include <cstdint>      // for int64_t
+#include <functional>   // for function
+#include <memory>       // for shared_ptr
+#include <string>       // for string
+#include <string_view>  // for string_view
+
+#include "ftxui/component/component_base.hpp"     // for Component
+#include "ftxui/component/component_options.hpp"  // for DataSource, DSRenderContext
+#include "ftxui/dom/elements.hpp"                 // for Element
+
+namespace ftxui {
+
+struct FuzzyFilterOption {
+  // The number of entries. Read when the query changes.
+  std::function<int64_t()> size;
+  // The text of the entry |index|. Called concurrently by the workers: the
+  // entries must not change while they are filtered. Call Invalidate() after
+  // changing them.
+  std::function<std::string_view(int64_t index)> entry;
+  // Produce the row of a match. |context.id| is its rank: use Entry() to get
+  // the index of the entry.
+  std::function<Element(DSRenderContext&)> transform;
+
+  // The number of worker threads. 0 for one per hardware thread.
+  int threads = 0;
+  // The number of entries scored at once by a worker.
+  int64_t chunk_size = 16384;
+};
+
+// Filter a list of entries with a fuzzy query, on a pool of worker threads.
+// The entries matching every character of the query, in order, are ranked by
+// score: consecutive characters, and characters starting a word, score higher.
+//
+// The matches are exposed as a DataSource, to display in a DBMenu. When the
+// query extends the previous one, only the previous matches are scored again.
+// The matches of the shorter queries are kept, so erasing characters is
+// instantaneous.
+//
+// The results are adopted by Update(), on the UI thread. When filtering
+// completes, the active ScreenInteractive is posted a task calling it, and
+// asked to redraw.
+class FuzzyFilter {
+ public:
+  explicit FuzzyFilter(FuzzyFilterOption option);
+  ~FuzzyFilter();
+
+  // The matches of the last query adopted, ranked.
+  DataSource* source();
+
+  // Filter the entries matching |query|, asynchronously.
+  void SetQuery(std::string query);
+  const std::string& query() const;
+
+  // Adopt the matches computed since the last call. Return whether they
+  // changed.
+  bool Update();
+  // Whether the matches of the last query are still being computed.
+  bool Busy() const;
+
+  // The number of matches adopted, and the index of the entry of rank |rank|.
+  int64_t size() const;
+  int64_t Entry(int64_t rank) const;
+
+  // Filter the entries again, after they changed.
+  void Invalidate();
+
+  // This class is non copyable/movable.
+  FuzzyFilter(const FuzzyFilter&) = delete;
+  FuzzyFilter(FuzzyFilter&&) = delete;
+  FuzzyFilter& operator=(const FuzzyFilter&) = delete;
+  FuzzyFilter& operator=(FuzzyFilter&&) = delete;
+
+ private:
+  class Impl;
+  std::shared_ptr<Impl> impl_;
+};
+
+// An Input editing the query of |filter|, above a DBMenu of its matches.
+Component FuzzyFilterMenu(FuzzyFilter* filter);
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_FUZZY_FILTER_HPP
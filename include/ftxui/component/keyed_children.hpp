@@ -0,0 +1,56 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_KEYED_CHILDREN_HPP
+#define FTXUI_COMPONENT_KEYED_CHILDREN_HPP
+
+#include <functional>     // for function
+#include <string>         // for string
+#include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
+
+#include "ftxui/component/component_base.hpp"  // for Component
+
+namespace ftxui {
+
+// Keep the children of a container in sync with a list of keys. The component
+// of a key is built once, and reused as long as the key is in the list: its
+// state, like the focus or its animations, is kept across updates.
+//
+// Usage:
+//
+// auto list = Container::Vertical({});
+// KeyedChildren children(list);
+//
+// // On every refresh of the data:
+// std::vector<std::string> keys;
+// for (const Connection& connection : connections) {
+//   keys.push_back(connection.id);
+// }
+// children.Update(keys, [&](const std::string& id) {
+//   return ConnectionRow(id);
+// });
+class KeyedChildren {
+ public:
+  using Factory = std::function<Component(const std::string& key)>;
+
+  explicit KeyedChildren(Component container);
+
+  // Make the children of the container the components of |keys|, in order.
+  // The missing ones are built by |factory|. The others are detached. The
+  // child that was active stays active, wherever it moved.
+  void Update(const std::vector<std::string>& keys, const Factory& factory);
+
+  // The component of |key|, or nullptr.
+  Component Find(const std::string& key) const;
+
+ private:
+  Component container_;
+  std::unordered_map<std::string, Component> components_;
+  std::unordered_map<std::string, Component> scratch_;
+  Components children_;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_KEYED_CHILDREN_HPP
@@ -24,6 +24,10 @@ class Loop {
   void RunOnceBlocking();
   void Run();
 
+  // Single threaded mode. See ScreenInteractive::SingleThreaded().
+  void OnInputReadable();
+  int NextTimeout();
+
   // This class is non copyable/movable.
   Loop(const Loop&) = default;
   Loop(Loop&&) = delete;
@@ -0,0 +1,96 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_OBSERVABLE_HPP
+#define FTXUI_COMPONENT_OBSERVABLE_HPP
+
+#include <cstddef>  // for size_t
+#include <memory>   // for shared_ptr, make_shared
+#include <utility>  // for move, forward
+
+#include "ftxui/util/ref.hpp"  // for Ref
+
+namespace ftxui {
+
+// The part of an Observable shared with the Memo components having read it.
+struct ObservableState {
+  size_t version = 0;
+  // The last recording this was added to. See ObservableReads.
+  size_t recorded = 0;
+};
+
+class ObservableBase {
+ public:
+  // The number of writes so far.
+  size_t version() const { return state_->version; }
+
+ protected:
+  ObservableBase() = default;
+
+  // Record the read into the Memo components being rendered, if any.
+  void Read() const;
+  // Invalidate the Memo components having read this, and redraw the active
+  // screen.
+  void Written();
+  // Invalidate the Memo components having read this.
+  void Changed() { state_->version++; }
+
+ private:
+  std::shared_ptr<ObservableState> state_ = std::make_shared<ObservableState>();
+};
+
+/// @brief A value whose readers are tracked. The Memo components reading it
+/// while rendering are rendered again once it is written, and only them: a
+/// clock ticking in a corner doesn't render again a large table next to it.
+/// Writing it also redraws the active ScreenInteractive.
+///
+/// Like Ref<T>, it owns or references the value. It must only be used from the
+/// UI thread. Other threads can ScreenInteractive::Post() the writes.
+/// @ingroup component
+///
+/// ### Example
+///
+/// ```cpp
+/// Observable<std::string> time;
+/// auto clock = Renderer([&] { return text(time()); });
+/// auto table = Memo(Renderer([&] { return Table(rows()); }));
+/// screen.PostPeriodic(1s, [&] { time.Set(Now()); });
+/// ```
+template <typename T>
+class Observable : public ObservableBase {
+ public:
+  Observable() = default;
+  Observable(T value) : value_(std::move(value)) {}  // NOLINT
+  Observable(T* value) : value_(value) {}            // NOLINT
+
+  // The readers would reference the state of the source.
+  Observable(const Observable&) = delete;
+  Observable& operator=(const Observable&) = delete;
+
+  const T& Get() const {
+    Read();
+    return *value_;
+  }
+  const T& operator()() const { return Get(); }
+  const T& operator*() const { return Get(); }
+  const T* operator->() const { return &Get(); }
+
+  void Set(T value) {
+    *value_ = std::move(value);
+    Written();
+  }
+
+  // Modify the value in place, through |fn(T&)|.
+  template <typename F>
+  void Update(F&& fn) {
+    std::forward<F>(fn)(*value_);
+    Written();
+  }
+
+ private:
+  Ref<T> value_;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_OBSERVABLE_HPP
@@ -0,0 +1,60 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_PROFILER_HPP
+#define FTXUI_COMPONENT_PROFILER_HPP
+
+#include <cstddef>  // for size_t
+#include <deque>    // for deque
+#include <ostream>  // for ostream
+#include <string>   // for string
+#include <vector>   // for vector
+
+#include "ftxui/component/component.hpp"  // for Component, ComponentDecorator
+#include "ftxui/dom/elements.hpp"         // for Element
+
+namespace ftxui {
+
+/// @brief The time spent in the Render() and OnEvent() of the components
+/// wrapped by Profiled(). The durations are in seconds.
+/// @ingroup component
+///
+/// The inclusive time of a component contains the time of the profiled
+/// components below it. The exclusive time doesn't. The layout and the drawing
+/// of the elements returned by Render() happen later, and aren't counted.
+class ComponentProfiler {
+ public:
+  struct Entry {
+    std::string name;
+    size_t renders = 0;
+    double render_inclusive = 0;
+    double render_exclusive = 0;
+    size_t events = 0;
+    double event_inclusive = 0;
+    double event_exclusive = 0;
+  };
+
+  // One per profiled component, by decreasing exclusive time.
+  std::vector<Entry> Entries() const;
+  // Zero the counters, keeping the components.
+  void Reset();
+
+  // The entries as a table.
+  Element Table() const;
+  // The entries as a JSON array of objects.
+  void WriteJson(std::ostream& out) const;
+
+ private:
+  friend Component Profiled(Component, std::string, ComponentProfiler*);
+  // Stable addresses: the components keep a pointer to their entry.
+  std::deque<Entry> entries_;
+};
+
+Component Profiled(Component child,
+                   std::string name,
+                   ComponentProfiler* profiler);
+ComponentDecorator Profiled(std::string name, ComponentProfiler* profiler);
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_PROFILER_HPP
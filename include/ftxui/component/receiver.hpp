@@ -7,10 +7,13 @@
 #include <algorithm>           // for copy, max
 #include <atomic>              // for atomic, __atomic_base
 #include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <deque>               // for deque
 #include <memory>              // for unique_ptr, make_unique
-#include <mutex>               // for mutex, unique_lock
-#include <queue>               // for queue
+#include <mutex>               // for mutex, unique_lock, lock_guard
+#include <unordered_map>       // for unordered_map
 #include <utility>             // for move
+#include <vector>              // for vector
 
 namespace ftxui {
 
@@ -37,6 +40,26 @@ namespace ftxui {
 //   print(c)
 //
 // Receiver::Receive() returns true when there are no more senders.
+//
+// Bounded receivers:
+// ------------------
+//
+// auto receiver = MakeReceiver<Task>(1000, ReceiverOverflow::DropOldest);
+//
+// At most 1000 items are pending. When full, the overflow policy applies.
+//
+// Keyed items:
+// ------------
+//
+// An item sent with a key replaces the pending item with the same key, if any:
+// [thread 1] sender->Send(progress_update, /*key=*/1);
+
+// What to do when sending to a full bounded receiver.
+enum class ReceiverOverflow {
+  Block,       // Wait for the receiver to make room.
+  DropOldest,  // Drop the oldest pending item.
+  DropNewest,  // Drop the item being sent.
+};
 
 // clang-format off
 template<class T> class SenderImpl;
@@ -45,6 +68,8 @@ template<class T> class ReceiverImpl;
 template<class T> using Sender = std::unique_ptr<SenderImpl<T>>;
 template<class T> using Receiver = std::unique_ptr<ReceiverImpl<T>>;
 template<class T> Receiver<T> MakeReceiver();
+template<class T> Receiver<T> MakeReceiver(size_t capacity,
+                                           ReceiverOverflow overflow);
 // clang-format on
 
 // ---- Implementation part ----
@@ -57,6 +82,12 @@ class SenderImpl {
   SenderImpl& operator=(const SenderImpl&) = delete;
   SenderImpl& operator=(SenderImpl&&) = delete;
   void Send(T t) { receiver_->Receive(std::move(t)); }
+  void Send(T t, size_t key) { receiver_->Receive(std::move(t), key); }
+  // Send every item of |items| at once, in order, and clear it.
+  void SendAll(std::vector<T>* items) {
+    receiver_->ReceiveBatch(items);
+    items->clear();
+  }
   ~SenderImpl() { receiver_->ReleaseSender(); }
 
   Sender<T> Clone() { return receiver_->MakeSender(); }
@@ -67,72 +98,295 @@ class SenderImpl {
   ReceiverImpl<T>* receiver_;
 };
 
+// The queue is a lock-free multi-producer single-consumer linked list (Dmitry
+// Vyukov's MPSC queue). Senders never block each other. The mutex and the
+// condition variable are only used when the receiver goes to sleep.
+//
+// Bounded receivers need the senders to inspect and modify the pending items.
+// They use a deque guarded by a mutex instead.
 template <class T>
 class ReceiverImpl {
  public:
   Sender<T> MakeSender() {
-    std::unique_lock<std::mutex> lock(mutex_);
     senders_++;
     return std::unique_ptr<SenderImpl<T>>(new SenderImpl<T>(this));
   }
-  ReceiverImpl() = default;
+  ReceiverImpl() : head_(&stub_), tail_(&stub_) {}
+  ReceiverImpl(size_t capacity, ReceiverOverflow overflow)
+      : head_(&stub_), tail_(&stub_), capacity_(capacity), overflow_(overflow) {}
+  ~ReceiverImpl() {
+    T t;
+    while (Pop(&t)) {
+    }
+    if (tail_ != &stub_) {
+      delete tail_;  // NOLINT
+    }
+  }
+
+  ReceiverImpl(const ReceiverImpl&) = delete;
+  ReceiverImpl(ReceiverImpl&&) = delete;
+  ReceiverImpl& operator=(const ReceiverImpl&) = delete;
+  ReceiverImpl& operator=(ReceiverImpl&&) = delete;
 
   bool Receive(T* t) {
-    while (senders_ || !queue_.empty()) {
+    while (true) {
+      if (Pop(t)) {
+        return true;
+      }
+      if (HasQuitted()) {
+        return false;
+      }
+
       std::unique_lock<std::mutex> lock(mutex_);
-      if (queue_.empty()) {
-        notifier_.wait(lock);
+      sleeping_ = true;
+      // Check again, now that the senders know they must wake us up.
+      if (Pop(t)) {
+        sleeping_ = false;
+        return true;
       }
-      if (queue_.empty()) {
-        continue;
+      if (senders_ || HasPending()) {
+        notifier_.wait(lock);
       }
-      *t = std::move(queue_.front());
-      queue_.pop();
-      return true;
+      sleeping_ = false;
     }
-    return false;
   }
 
-  bool ReceiveNonBlocking(T* t) {
-    std::unique_lock<std::mutex> lock(mutex_);
-    if (queue_.empty()) {
-      return false;
+  bool ReceiveNonBlocking(T* t) { return Pop(t); }
+
+  // Move every pending item at the end of |out|, without blocking. Returns the
+  // number of items received.
+  size_t ReceiveAll(std::vector<T>* out) {
+    if (capacity_) {
+      const std::lock_guard<std::mutex> lock(bounded_mutex_);
+      for (auto& item : bounded_) {
+        out->push_back(std::move(item.value));
+      }
+      const size_t received = bounded_.size();
+      bounded_.clear();
+      space_notifier_.notify_all();
+      return received;
     }
-    *t = queue_.front();
-    queue_.pop();
-    return true;
+
+    size_t received = 0;
+    while (Node* next = tail_->next.load()) {
+      out->push_back(TakeValue(next));
+      Advance(next);
+      received++;
+    }
+    return received;
   }
 
   bool HasPending() {
-    std::unique_lock<std::mutex> lock(mutex_);
-    return !queue_.empty();
+    if (capacity_) {
+      const std::lock_guard<std::mutex> lock(bounded_mutex_);
+      return !bounded_.empty();
+    }
+    return tail_->next.load() != nullptr;
+  }
+
+  // Release the storage grown by the past bursts of items. The pending items
+  // are kept.
+  void ShrinkToFit() {
+    if (capacity_) {
+      const std::lock_guard<std::mutex> lock(bounded_mutex_);
+      bounded_.shrink_to_fit();
+    }
+    const std::lock_guard<std::mutex> lock(keyed_mutex_);
+    keyed_.rehash(0);
   }
 
   bool HasQuitted() {
-    std::unique_lock<std::mutex> lock(mutex_);
-    return queue_.empty() && !senders_;
+    if (HasPending() || senders_) {
+      return false;
+    }
+    // Wait for the last sender to leave ReleaseSender(), so that the receiver
+    // can be destroyed.
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return true;
   }
 
  private:
   friend class SenderImpl<T>;
 
+  struct Node {
+    Node() = default;
+    explicit Node(T t) : value(std::move(t)) {}
+    std::atomic<Node*> next{nullptr};
+    T value{};
+    // Keyed nodes are placeholders. Their value lives in |keyed_|.
+    bool keyed = false;
+    size_t key = 0;
+  };
+
   void Receive(T t) {
+    if (capacity_) {
+      ReceiveBounded(std::move(t), false, 0);
+      return;
+    }
+    Push(new Node(std::move(t)));  // NOLINT
+  }
+
+  void Receive(T t, size_t key) {
+    if (capacity_) {
+      ReceiveBounded(std::move(t), true, key);
+      return;
+    }
+
+    // The first item sent with a given key enqueues a placeholder. The next
+    // ones only replace the value, until the placeholder is received.
     {
-      std::unique_lock<std::mutex> lock(mutex_);
-      queue_.push(std::move(t));
+      const std::lock_guard<std::mutex> lock(keyed_mutex_);
+      auto [it, inserted] = keyed_.try_emplace(key, std::move(t));
+      if (!inserted) {
+        it->second = std::move(t);
+        return;
+      }
     }
-    notifier_.notify_one();
+    Node* node = new Node();  // NOLINT
+    node->keyed = true;
+    node->key = key;
+    Push(node);
+  }
+
+  void ReceiveBatch(std::vector<T>* items) {
+    if (items->empty()) {
+      return;
+    }
+    if (capacity_) {
+      for (auto& item : *items) {
+        ReceiveBounded(std::move(item), false, 0);
+      }
+      return;
+    }
+
+    // Link the nodes together first, then publish the whole chain with a
+    // single exchange.
+    Node* first = new Node(std::move(items->front()));  // NOLINT
+    Node* last = first;
+    for (size_t i = 1; i < items->size(); ++i) {
+      Node* node = new Node(std::move((*items)[i]));  // NOLINT
+      last->next.store(node, std::memory_order_relaxed);
+      last = node;
+    }
+    Node* previous = head_.exchange(last);
+    previous->next.store(first);
+    WakeUp();
+  }
+
+  void Push(Node* node) {
+    Node* previous = head_.exchange(node);
+    previous->next.store(node);
+    WakeUp();
+  }
+
+  T TakeValue(Node* node) {
+    if (!node->keyed) {
+      return std::move(node->value);
+    }
+    const std::lock_guard<std::mutex> lock(keyed_mutex_);
+    auto it = keyed_.find(node->key);
+    T value = std::move(it->second);
+    keyed_.erase(it);
+    return value;
+  }
+
+  void ReceiveBounded(T t, bool keyed, size_t key) {
+    {
+      std::unique_lock<std::mutex> lock(bounded_mutex_);
+      if (keyed) {
+        for (auto& item : bounded_) {
+          if (item.keyed && item.key == key) {
+            item.value = std::move(t);
+            return;
+          }
+        }
+      }
+      if (bounded_.size() >= capacity_) {
+        switch (overflow_) {
+          case ReceiverOverflow::Block:
+            space_notifier_.wait(
+                lock, [this] { return bounded_.size() < capacity_; });
+            break;
+          case ReceiverOverflow::DropOldest:
+            bounded_.pop_front();
+            break;
+          case ReceiverOverflow::DropNewest:
+            return;
+        }
+      }
+      bounded_.push_back({std::move(t), keyed, key});
+    }
+    WakeUp();
   }
 
   void ReleaseSender() {
+    const std::lock_guard<std::mutex> lock(mutex_);
     senders_--;
     notifier_.notify_one();
   }
 
+  void WakeUp() {
+    if (!sleeping_) {
+      return;
+    }
+    // Taking the lock guarantees the receiver is either waiting, or will
+    // see what was sent.
+    const std::lock_guard<std::mutex> lock(mutex_);
+    notifier_.notify_one();
+  }
+
+  // Only called from the receiver side.
+  bool Pop(T* t) {
+    if (capacity_) {
+      const std::lock_guard<std::mutex> lock(bounded_mutex_);
+      if (bounded_.empty()) {
+        return false;
+      }
+      *t = std::move(bounded_.front().value);
+      bounded_.pop_front();
+      space_notifier_.notify_one();
+      return true;
+    }
+
+    Node* next = tail_->next.load();
+    if (next == nullptr) {
+      return false;
+    }
+    *t = TakeValue(next);
+    Advance(next);
+    return true;
+  }
+
+  void Advance(Node* next) {
+    if (tail_ != &stub_) {
+      delete tail_;  // NOLINT
+    }
+    tail_ = next;
+  }
+
+  Node stub_;
+  std::atomic<Node*> head_;  // Last node sent.
+  Node* tail_;               // Last node received.
+  std::atomic<bool> sleeping_{false};
   std::mutex mutex_;
-  std::queue<T> queue_;
   std::condition_variable notifier_;
   std::atomic<int> senders_{0};
+
+  // Values of the keyed items pending in the lock-free queue.
+  std::mutex keyed_mutex_;
+  std::unordered_map<size_t, T> keyed_;
+
+  // Bounded mode, when |capacity_| isn't 0:
+  struct Pending {
+    T value;
+    bool keyed = false;
+    size_t key = 0;
+  };
+  const size_t capacity_ = 0;
+  const ReceiverOverflow overflow_ = ReceiverOverflow::Block;
+  std::mutex bounded_mutex_;
+  std::condition_variable space_notifier_;
+  std::deque<Pending> bounded_;
 };
 
 template <class T>
@@ -140,6 +394,13 @@ Receiver<T> MakeReceiver() {
   return std::make_unique<ReceiverImpl<T>>();
 }
 
+// Make a receiver holding at most |capacity| pending items. 0 means unbounded.
+// ReceiverOverflow::Block must not be used if the receiving thread sends too.
+template <class T>
+Receiver<T> MakeReceiver(size_t capacity, ReceiverOverflow overflow) {
+  return std::make_unique<ReceiverImpl<T>>(capacity, overflow);
+}
+
 }  // namespace ftxui
 
 #endif  // FTXUI_COMPONENT_RECEIVER_HPP_
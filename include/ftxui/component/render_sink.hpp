@@ -0,0 +1,126 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_RENDER_SINK_HPP
+#define FTXUI_COMPONENT_RENDER_SINK_HPP
+
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t
+#include <map>          // for map
+#include <string>       // for string
+#include <string_view>  // for string_view
+#include <tuple>        // for tuple
+#include <vector>       // for vector
+
+#include "ftxui/screen/color.hpp"   // for Color
+#include "ftxui/screen/screen.hpp"  // for Screen
+
+namespace ftxui {
+
+/// @brief The style of some cells of a RenderFrame.
+/// @ingroup component
+struct RenderStyle {
+  Color foreground;
+  Color background;
+  // The CellBuffer::Attribute bits.
+  uint32_t attributes = 0;
+  std::string hyperlink;
+};
+
+/// @brief A cell of a RenderFrame.
+/// @ingroup component
+struct RenderCell {
+  // The character. Empty pixels are drawn as spaces. The cell following a
+  // fullwidth character is covered by it, whatever its content.
+  std::string_view glyph;
+  // The index of the style in RenderFrame::styles.
+  uint32_t style = 0;
+};
+
+/// @brief Consecutive cells of a row, changed since the previous frame.
+/// @ingroup component
+struct RenderRun {
+  int x = 0;
+  int y = 0;
+  // The cells [begin, end) of RenderFrame::cells.
+  size_t begin = 0;
+  size_t end = 0;
+};
+
+/// @brief A frame handed to a RenderSink. It is valid during
+/// RenderSink::Frame() only.
+/// @ingroup component
+struct RenderFrame {
+  // The frame drawn.
+  const Screen* screen = nullptr;
+  // Whether the size changed. The runs cover the whole frame then.
+  bool resized = false;
+  Screen::Cursor cursor;
+
+  // The cells changed since the previous frame. Empty unless
+  // RenderSink::WantsRuns().
+  std::vector<RenderRun> runs;
+  std::vector<RenderCell> cells;
+  // Every style, by id. The ids are kept from one frame to the next, for the
+  // sink to keep what it derived from them, like its GPU state. New styles are
+  // appended, from |first_new_style|.
+  const std::vector<RenderStyle>* styles = nullptr;
+  size_t first_new_style = 0;
+};
+
+/// @brief Where a ScreenInteractive draws its frames, instead of writing escape
+/// sequences to the terminal. A native application, like a GPU text renderer,
+/// consumes the cells changed directly.
+/// @ingroup component
+///
+/// ### Example
+///
+/// ```cpp
+/// class GpuSink : public RenderSink {
+///   void Frame(const RenderFrame& frame) override {
+///     for (size_t i = frame.first_new_style; i < frame.styles->size(); ++i) {
+///       atlas_.AddStyle((*frame.styles)[i]);
+///     }
+///     for (const RenderRun& run : frame.runs) {
+///       for (size_t i = run.begin; i < run.end; ++i) {
+///         const RenderCell& cell = frame.cells[i];
+///         atlas_.Draw(run.x + int(i - run.begin), run.y, cell.glyph,
+///                     cell.style);
+///       }
+///     }
+///   }
+/// };
+///
+/// screen.OutputSink(std::make_shared<GpuSink>());
+/// ```
+class RenderSink {
+ public:
+  virtual ~RenderSink() = default;
+
+  // Whether the runs of cells changed are computed for Frame(). Otherwise, the
+  // sink reads the screen itself.
+  virtual bool WantsRuns() const { return true; }
+
+  // Called after every frame drawn, on the loop's thread.
+  virtual void Frame(const RenderFrame& frame) = 0;
+};
+
+/// @brief Build the RenderFrame of successive screens: the runs of cells
+/// changed, and the ids of their styles.
+/// @ingroup component
+class RenderFrameBuilder {
+ public:
+  // Fill |frame| with the cells of |screen| drawn differently in |previous|.
+  void Build(const Screen& screen, const Screen& previous, RenderFrame* frame);
+
+ private:
+  uint32_t StyleOf(const Screen& screen, const Pixel& pixel);
+
+  std::vector<RenderStyle> styles_;
+  std::map<std::tuple<uint32_t, uint32_t, uint32_t, std::string>, uint32_t>
+      style_ids_;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_RENDER_SINK_HPP
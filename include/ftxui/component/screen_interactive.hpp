@@ -4,19 +4,29 @@
 #ifndef FTXUI_COMPONENT_SCREEN_INTERACTIVE_HPP
 #define FTXUI_COMPONENT_SCREEN_INTERACTIVE_HPP
 
+#include <array>                         // for array
 #include <atomic>                        // for atomic
-#include <ftxui/component/receiver.hpp>  // for Receiver, Sender
+#include <chrono>                        // for seconds
+#include <condition_variable>            // for condition_variable
+#include <cstddef>                       // for size_t
+#include <deque>                         // for deque
+#include <ftxui/component/receiver.hpp>  // for Receiver, Sender, ReceiverOverflow
 #include <functional>                    // for function
 #include <memory>                        // for shared_ptr
+#include <mutex>                         // for mutex
+#include <ostream>                       // for ostream
 #include <string>                        // for string
 #include <thread>                        // for thread
 #include <variant>                       // for variant
+#include <vector>                        // for vector
 
 #include "ftxui/component/animation.hpp"       // for TimePoint
 #include "ftxui/component/captured_mouse.hpp"  // for CapturedMouse
 #include "ftxui/component/event.hpp"           // for Event
+#include "ftxui/component/frame_stats.hpp"     // for FrameStats
 #include "ftxui/component/task.hpp"            // for Task, Closure
 #include "ftxui/screen/screen.hpp"             // for Screen
+#include "ftxui/screen/terminal.hpp"           // for Dimensions
 
 namespace ftxui {
 class ComponentBase;
@@ -24,7 +34,18 @@ class Loop;
 struct Event;
 
 using Component = std::shared_ptr<ComponentBase>;
+class CellBuffer;
 class ScreenInteractivePrivate;
+class IOWatcher;
+class TerminalInputParser;
+class TerminalProbe;
+class FrameRecorder;
+class RenderFrameBuilder;
+class RenderSink;
+struct RenderFrame;
+class SessionRecorder;
+class Tracer;
+class WorkerPool;
 
 class ScreenInteractive : public Screen {
  public:
@@ -38,10 +59,53 @@ class ScreenInteractive : public Screen {
 
   // Options. Must be called before Loop().
   void TrackMouse(bool enable = true);
+  void BracketedPaste(bool enable = true);
+  void DifferentialOutput(bool enable = true);
+  void CoalesceEvents(bool enable = true);
+  void RoutedEvents(bool enable = true);
+  void AbandonStaleFrames(bool enable = true);
+  void LazyRedraw(bool enable = true);
+  void TargetFrameRate(int fps);
+  void MaxFrameRate(int fps);
+  void TaskQueueCapacity(
+      size_t capacity,
+      ReceiverOverflow overflow = ReceiverOverflow::DropOldest);
+  void SingleThreaded(bool enable = true);
+  void RenderThreads(int threads);
+  void InputFd(int fd);
+  void OutputFd(int fd);
+  void SynchronizedOutput(bool enable = true);
+  void ProbeTerminal(std::string cache_file = "");
+  void OutputBandwidth(int bytes_per_second = 0);
+  void RecordTrace(size_t capacity = 4096);
+  void RecordSession(std::ostream* out);
+  void OutputSink(std::shared_ptr<RenderSink> sink);
+  void CellOutput(std::function<void(const CellBuffer&)> on_frame = nullptr);
+  void MemoryBudget(size_t bytes,
+                    animation::Duration idle = std::chrono::seconds(1));
 
   // Return the currently active screen, nullptr if none.
   static ScreenInteractive* Active();
 
+  // The size of the terminal, refreshed when it is resized.
+  Dimensions TerminalSize();
+  // Set the size of the terminal of a screen reading its own input, see
+  // InputFd(). Can be called from any thread.
+  void SetTerminalSize(Dimensions size);
+
+  // The time spent in each phase of the last frames.
+  FrameStats Stats() const;
+
+  // Write the spans recorded, see RecordTrace().
+  void WriteTrace(std::ostream& out) const;
+
+  // The bytes held by the buffers of the screen: the frames, the output and
+  // the pending tasks.
+  size_t MemoryUsage() const;
+  // Release the storage of the buffers beyond what the last frame needs. Done
+  // once idle when over the budget, see MemoryBudget(). From the loop only.
+  void TrimMemory();
+
   // Start/Stop the main loop.
   void Loop(Component);
   void Exit();
@@ -49,8 +113,34 @@ class ScreenInteractive : public Screen {
 
   // Post tasks to be executed by the loop.
   void Post(Task task);
+  void Post(size_t key, Task task);
   void PostEvent(Event event);
+
+  // Print |element| once, above the frame, into the terminal's scrollback.
+  // Only the frame below is drawn again. Can be called from any thread.
+  void PrintAbove(Element element);
+
+  // Run |fn| on a thread of the screen's worker pool, then |on_done| in the
+  // loop. Can be called from any thread.
+  void RunInBackground(Closure fn, Closure on_done = nullptr);
+
+  // Timers. The tasks are posted to the loop once due.
+  size_t PostDelayed(animation::Duration delay, Task task);
+  size_t PostPeriodic(animation::Duration period, Task task);
+  void CancelTimer(size_t timer);
+
+  // Run |task| by slices while the loop has nothing else to do. It receives
+  // the deadline of the slice, and returns whether it has more work.
+  using IdleTask = std::function<bool(animation::TimePoint deadline)>;
+  void PostIdle(IdleTask task);
+
   void RequestAnimationFrame();
+  // Draw a new frame, once the task being run returns. See LazyRedraw().
+  void RequestRedraw();
+
+  // Run |on_readable| in the loop, whenever |fd| has data to read. POSIX only.
+  void WatchFd(int fd, Closure on_readable);
+  void UnwatchFd(int fd);
 
   CapturedMouse CaptureMouse();
 
@@ -73,6 +163,12 @@ class ScreenInteractive : public Screen {
 
   void Install();
   void Uninstall();
+  void InstallTerminal();
+  void StartProbe();
+  void OnProbeReport(const Event& event);
+  void InstallLoop();
+  void UninstallLoop();
+  bool SharesTerminalWith(const ScreenInteractive& other) const;
 
   void PreMain();
   void PostMain();
@@ -81,11 +177,38 @@ class ScreenInteractive : public Screen {
   void RunOnce(Component component);
   void RunOnceBlocking(Component component);
 
+  // Single threaded mode:
+  void WaitForInput(int timeout);
+  void ReadInput();
+  int NextTimeout();
+  void RunDeadlines();
+
+  void ReceiveTasks();
+  bool HasPendingTasks() const;
+  size_t TasksCapacity() const;
+  void RunTask(Component component, Task& task);
+  bool IsFrameStale();
+  bool IsIdle();
+  void RunIdleTask();
+  void AbandonFrame(animation::TimePoint draw_start);
   void HandleTask(Component component, Task& task);
+  void TraceTask(Component component, Task& task);
+  void ScheduleAnimationFrame();
+  void AnimationListener(Sender<Task> out);
+  void ScheduleFrame(animation::TimePoint deadline);
+  void ScheduleTrim();
+  void TrimIfIdle();
+  animation::Duration AnimationInterval() const;
   void Draw(Component component);
+  int FrameOrigin(int y) const;
+  void MeasureOutput(size_t bytes, animation::TimePoint write_start);
   void ResetCursorPosition();
+  void WatchLiveCells();
+  void UnwatchLiveCells();
+  void PatchLiveCells();
 
   void Signal(int signal);
+  std::shared_ptr<WorkerPool> Workers();
 
   ScreenInteractive* suspended_screen_ = nullptr;
   enum class Dimension {
@@ -102,24 +225,149 @@ class ScreenInteractive : public Screen {
                     bool use_alternative_screen);
 
   bool track_mouse_ = true;
+  bool bracketed_paste_ = true;
+
+  // The last frame written to the terminal, used by the differential output.
+  bool differential_output_ = false;
+  Screen previous_frame_{0, 0};
+
+  // The live cells of the last frame. Their updates are written over it, see
+  // live().
+  std::vector<LiveCellPlacement> displayed_live_cells_;
+  std::vector<bool> live_cells_pending_;
+
+  bool coalesce_events_ = false;
+  bool abandon_stale_frames_ = false;
+  bool lazy_redraw_ = false;
+  // The frames abandoned in a row. Past a few, the frame is drawn anyway.
+  int frames_abandoned_ = 0;
+  static constexpr int kMaxFramesAbandoned = 3;
+  bool routed_events_ = false;
+  int render_threads_ = 1;
+  // Where the input is read from. stdin when negative.
+  int input_fd_ = -1;
+  // Where the output is written. std::cout when negative.
+  int output_fd_ = -1;
+  bool synchronized_output_ = false;
+  bool synchronized_output_supported_ = false;
+
+  // The terminal capabilities queried at install, see ProbeTerminal(). Null
+  // when the terminal answered, or wasn't queried.
+  bool probe_terminal_ = false;
+  std::string probe_cache_file_;
+  std::shared_ptr<TerminalProbe> probe_;
+
+  // Queried from the terminal once, then again after a resize event.
+  Dimensions terminal_size_{0, 0};
+  int terminal_size_generation_ = 0;
+  bool terminal_size_valid_ = false;
+  // Set by SetTerminalSize(), when positive.
+  std::mutex session_size_mutex_;
+  Dimensions session_size_{0, 0};
+  // The tasks drained at once from |task_receiver_|.
+  std::vector<Task> received_tasks_;
+
+  // The tasks received, not handled yet, by priority: the input events, then
+  // the timers and the animation ticks, then the closures posted.
+  struct TaskLane {
+    std::vector<Task> tasks;
+    size_t next = 0;  // The first task not handled.
+    bool empty() const { return next == tasks.size(); }
+    // Drop the tasks handled, once they are the majority.
+    void Compact() {
+      if (next * 2 >= tasks.size()) {
+        tasks.erase(tasks.begin(), tasks.begin() + std::ptrdiff_t(next));
+        next = 0;
+      }
+    }
+  };
+  enum { kInputLane, kTimerLane, kBackgroundLane, kTaskLanes };
+  std::array<TaskLane, kTaskLanes> lanes_;
+  // The closures handled in between two checks for input.
+  static constexpr size_t kBackgroundSlice = 64;
 
   Sender<Task> task_sender_;
   Receiver<Task> task_receiver_;
 
+  // The file descriptors and timers waited for by the event listener.
+  std::shared_ptr<IOWatcher> io_watcher_;
+
+  // Without helper threads, the terminal input is parsed by the loop.
+  bool single_threaded_ = false;
+  std::shared_ptr<TerminalInputParser> input_parser_;
+  animation::TimePoint input_time_;
+  bool input_closed_ = false;
+
   std::string set_cursor_position;
   std::string reset_cursor_position;
+  std::string output_buffer_;
+  // The elements to print above the next frame. See PrintAbove().
+  std::vector<Element> print_above_;
+
+  // One thread per core, started on first use, shared by RunInBackground and
+  // the parallel rendering. Stopped once the loop exits.
+  std::mutex workers_mutex_;
+  std::shared_ptr<WorkerPool> workers_;
 
   std::atomic<bool> quit_{false};
   std::thread event_listener_;
   std::thread animation_listener_;
   bool animation_requested_ = false;
+  // Whether the whole tree is animated on the next frame, or only the
+  // components having requested it.
+  bool animate_tree_ = false;
   animation::TimePoint previous_animation_time_;
 
+  // Frame pacing. The animation listener sleeps until |frame_deadline_| when
+  // |frame_scheduled_|, and doesn't wake up otherwise.
+  int target_frame_rate_ = 60;
+  int max_frame_rate_ = 0;
+  animation::TimePoint last_draw_time_;
+  // Output throttling. The next frame is drawn once the previous one is
+  // estimated to be drained by the terminal, at |output_drained_time_|.
+  bool throttle_output_ = false;
+  int output_bandwidth_ = 0;
+  float measured_bandwidth_ = 0.F;
+  animation::TimePoint output_drained_time_;
+
+  // Set by MemoryBudget(). The buffers are trimmed once no frame was drawn
+  // for |trim_delay_|, if they hold more than |memory_budget_| bytes. Zero
+  // disables it.
+  size_t memory_budget_ = 0;
+  animation::Duration trim_delay_;
+  size_t trim_timer_ = 0;
+
+  // The tasks run when the loop is idle, one slice at a time.
+  std::deque<IdleTask> idle_tasks_;
+  static constexpr std::chrono::milliseconds kIdleSlice{5};
+
+  std::shared_ptr<FrameRecorder> frame_recorder_;
+  // Null unless RecordTrace() is called.
+  std::shared_ptr<Tracer> tracer_;
+  // Null unless RecordSession() is called.
+  std::shared_ptr<SessionRecorder> session_recorder_;
+  // Null unless OutputSink() is called. The frames are then handed to the sink,
+  // instead of being written as escape sequences.
+  std::shared_ptr<RenderSink> sink_;
+  std::shared_ptr<RenderFrameBuilder> render_frame_builder_;
+  std::shared_ptr<RenderFrame> render_frame_;
+  // When the loop handled the first event not yet reflected by a frame.
+  bool event_pending_ = false;
+  animation::TimePoint event_time_;
+  std::mutex frame_mutex_;
+  std::condition_variable frame_notifier_;
+  bool frame_scheduled_ = false;
+  animation::TimePoint frame_deadline_;
+
+  // The position of the frame on the terminal, starting from 1. See Draw().
   int cursor_x_ = 1;
   int cursor_y_ = 1;
+  bool origin_known_ = false;
+  // The size of the terminal when the position was queried.
+  int origin_terminal_dimx_ = 0;
+  int origin_terminal_dimy_ = 0;
 
   bool mouse_captured = false;
-  bool previous_frame_resized_ = false;
 
   bool frame_valid_ = false;
 
@@ -135,6 +383,18 @@ class ScreenInteractive : public Screen {
   class Private {
    public:
     static void Signal(ScreenInteractive& s, int signal) { s.Signal(signal); }
+    static void ScheduleAnimationFrame(ScreenInteractive& s) {
+      s.ScheduleAnimationFrame();
+    }
+    static bool RoutedEvents(const ScreenInteractive& s) {
+      return s.routed_events_;
+    }
+    static bool MouseCaptured(const ScreenInteractive& s) {
+      return s.mouse_captured;
+    }
+    static std::shared_ptr<Tracer> Trace(const ScreenInteractive& s) {
+      return s.tracer_;
+    }
   };
   friend Private;
 };
@@ -0,0 +1,64 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_SESSION_REPLAY_HPP
+#define FTXUI_COMPONENT_SESSION_REPLAY_HPP
+
+#include <cstddef>  // for size_t
+#include <istream>  // for istream
+#include <memory>   // for shared_ptr
+
+#include "ftxui/component/component_base.hpp"  // for Component
+#include "ftxui/component/frame_stats.hpp"     // for FrameStats
+#include "ftxui/screen/screen.hpp"             // for Screen
+
+namespace ftxui {
+
+class FrameRecorder;
+
+/// @brief Feed a session recorded by ScreenInteractive::RecordSession() to a
+/// component, without a terminal. The events are handled, the animations run
+/// and the frames drawn in the order recorded, as fast as possible. The time
+/// spent drawing the frames is measured, like ScreenInteractive::Stats() does.
+/// @ingroup component
+///
+/// The tasks posted to the loop can't be recorded, only the fact they ran.
+/// The state they modify isn't restored.
+///
+/// ### Example
+///
+/// ```cpp
+/// std::ifstream file("session.ftxs", std::ios::binary);
+/// SessionReplay replay(file);
+/// replay.Run(MakeApplication());
+/// std::cout << replay.Stats().total.p99 << std::endl;
+/// ```
+class SessionReplay {
+ public:
+  explicit SessionReplay(std::istream& in);
+
+  // Replay the whole session. Return false if it is malformed or truncated.
+  // The records until then are replayed.
+  bool Run(Component component);
+
+  // The last frame drawn.
+  const Screen& screen() const { return screen_; }
+  // The time spent in each phase of the last frames drawn.
+  FrameStats Stats() const;
+
+  size_t events() const { return events_; }
+  size_t tasks() const { return tasks_; }
+
+ private:
+  void Draw(Component& component);
+
+  std::istream& in_;
+  Screen screen_{0, 0};
+  std::shared_ptr<FrameRecorder> frame_recorder_;
+  size_t events_ = 0;
+  size_t tasks_ = 0;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_SESSION_REPLAY_HPP
@@ -0,0 +1,191 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_SHARED_VALUE_HPP
+#define FTXUI_COMPONENT_SHARED_VALUE_HPP
+
+#include <array>        // for array
+#include <atomic>       // for atomic, atomic_thread_fence, memory_order
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t, uint64_t
+#include <cstring>      // for memcpy
+#include <thread>       // for this_thread
+#include <type_traits>  // for is_trivially_copyable_v, is_default_constructible_v
+
+#include "ftxui/component/observable.hpp"  // for ObservableBase
+#include "ftxui/util/ref.hpp"              // for ConstRef
+
+namespace ftxui {
+
+class ScreenInteractive;
+
+class SharedValueBase : public ObservableBase {
+ public:
+  SharedValueBase(const SharedValueBase&) = delete;
+  SharedValueBase& operator=(const SharedValueBase&) = delete;
+
+ protected:
+  SharedValueBase() = default;
+  virtual ~SharedValueBase() = default;
+
+  // Make Refresh() called by the loop, once written. Every SharedValue is
+  // registered while alive.
+  void Register();
+  void Unregister();
+
+  // Redraw the screen of the value, unless a redraw is pending already. From
+  // any thread.
+  void Written();
+
+  // Make the active screen the one redrawn, from the first read while
+  // rendering. From the UI thread.
+  void Bind() const {
+    if (screen_.load(std::memory_order_relaxed) == nullptr) {
+      BindActive();
+    }
+  }
+
+ private:
+  friend ScreenInteractive;
+
+  // Copy the value last written into the one read while rendering. From the
+  // UI thread.
+  virtual void Refresh() const = 0;
+
+  void BindActive() const;
+
+  // The screens running a loop. |main| is the one reading stdin: it is also
+  // redrawn by the values never read while rendering, like the ones only read
+  // through a ConstRef.
+  static void Attach(ScreenInteractive* screen, bool main);
+  static void Detach(ScreenInteractive* screen);
+  // Refresh the values of |screen| written, and redraw it. From its loop.
+  static void RefreshAll(ScreenInteractive* screen);
+
+  // Whether written since the last Refresh(), with a redraw pending.
+  mutable std::atomic<bool> dirty_{false};
+  // The screen redrawn once written, or null until read while rendering.
+  mutable std::atomic<ScreenInteractive*> screen_{nullptr};
+};
+
+/// @brief A value written by any thread, like the ones receiving data from the
+/// network, and read while rendering.
+/// @ingroup component
+///
+/// The values are written using a sequence lock, without waiting for the UI
+/// thread. The writes of every SharedValue in between two frames are coalesced
+/// into a single wakeup of the ScreenInteractive rendering them: the first one
+/// reading the value while rendering, a session's included, or else the screen
+/// reading stdin. The values written are then copied once, by its loop, into
+/// the ones read while rendering: every read of a frame sees the same value.
+///
+/// Like an Observable, the Memo components reading it are rendered again once
+/// it changes, and only them.
+///
+/// T must be trivially copyable and default constructible, like a number or a
+/// small struct of numbers. The value read while rendering is also available
+/// as a ConstRef<T>, for the components taking one, like the bounds of a
+/// Slider.
+///
+/// ### Example
+///
+/// ```cpp
+/// SharedValue<float> progress;
+/// std::thread network([&] {
+///   while (Receive()) {
+///     progress.Set(Done());
+///   }
+/// });
+/// auto component = Renderer([&] { return gauge(progress()); });
+/// screen.Loop(component);
+/// ```
+template <typename T>
+class SharedValue : public SharedValueBase {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "SharedValue<T> requires a trivially copyable T.");
+  static_assert(std::is_default_constructible_v<T>,
+                "SharedValue<T> requires a default constructible T.");
+
+ public:
+  SharedValue(T value = T{}) : snapshot_(value) {  // NOLINT
+    Store(value);
+    Register();
+  }
+  ~SharedValue() override { Unregister(); }
+
+  // Write the value. From any thread.
+  void Set(const T& value) {
+    // The sequence is odd while a thread writes. The writers wait for each
+    // other.
+    uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+    while ((sequence & 1U) ||
+           !sequence_.compare_exchange_weak(sequence, sequence + 1,
+                                            std::memory_order_relaxed)) {
+      if (sequence & 1U) {
+        std::this_thread::yield();
+        sequence = sequence_.load(std::memory_order_relaxed);
+      }
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    Store(value);
+    sequence_.store(sequence + 2, std::memory_order_release);
+    Written();
+  }
+
+  // The value last written. From any thread.
+  T Get() const {
+    while (true) {
+      const uint32_t before = sequence_.load(std::memory_order_acquire);
+      if (before & 1U) {
+        std::this_thread::yield();
+        continue;
+      }
+      T value = Load();
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence_.load(std::memory_order_relaxed) == before) {
+        return value;
+      }
+    }
+  }
+
+  // The value as of the frame being rendered. From the UI thread.
+  const T& operator()() const {
+    Bind();
+    Read();
+    return snapshot_;
+  }
+  const T& operator*() const { return operator()(); }
+  const T* operator->() const { return &operator()(); }
+  operator ConstRef<T>() const { return &snapshot_; }  // NOLINT
+
+ private:
+  static constexpr size_t kWords = (sizeof(T) + 7) / 8;
+
+  void Refresh() const override { snapshot_ = Get(); }
+
+  void Store(const T& value) {
+    std::array<uint64_t, kWords> words{};
+    std::memcpy(words.data(), &value, sizeof(T));
+    for (size_t i = 0; i < kWords; ++i) {
+      words_[i].store(words[i], std::memory_order_relaxed);
+    }
+  }
+
+  T Load() const {
+    std::array<uint64_t, kWords> words{};
+    for (size_t i = 0; i < kWords; ++i) {
+      words[i] = words_[i].load(std::memory_order_relaxed);
+    }
+    T value;
+    std::memcpy(&value, words.data(), sizeof(T));
+    return value;
+  }
+
+  std::atomic<uint32_t> sequence_{0};
+  std::array<std::atomic<uint64_t>, kWords> words_{};
+  mutable T snapshot_;  // Only written by the loop.
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_SHARED_VALUE_HPP
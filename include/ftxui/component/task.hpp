@@ -4,14 +4,128 @@
 #ifndef FTXUI_COMPONENT_ANIMATION_HPP
 #define FTXUI_COMPONENT_ANIMATION_HPP
 
-#include <functional>
+#include <cstddef>      // for size_t
+#include <functional>   // for function
+#include <new>          // for launder
+#include <type_traits>  // for decay_t, enable_if_t, is_invocable_r_v
+#include <utility>      // for forward, move
 #include <variant>
 #include "ftxui/component/event.hpp"
 
 namespace ftxui {
 class AnimationTask {};
 using Closure = std::function<void()>;
-using Task = std::variant<Event, Closure, AnimationTask>;
+
+// A move-only std::function<void()>, for the closures posted to the loop. The
+// callables up to kInlineSize bytes are stored inline: posting them doesn't
+// allocate. Their captures don't need to be copyable.
+class TaskClosure {
+ public:
+  // Large enough for a few pointers, a std::string, or a std::function, while
+  // keeping the closure smaller than an Event.
+  static constexpr size_t kInlineSize = 64;
+
+  TaskClosure() = default;
+
+  template <class F,
+            class = std::enable_if_t<
+                !std::is_same_v<std::decay_t<F>, TaskClosure> &&
+                std::is_invocable_r_v<void, std::decay_t<F>&>>>
+  TaskClosure(F&& f) {  // NOLINT
+    using Callable = std::decay_t<F>;
+    if constexpr (IsInline<Callable>()) {
+      new (storage_) Callable(std::forward<F>(f));
+    } else {
+      new (storage_) Callable*(new Callable(std::forward<F>(f)));  // NOLINT
+    }
+    ops_ = &kOps<Callable>;
+  }
+
+  TaskClosure(TaskClosure&& other) noexcept { MoveFrom(other); }
+  TaskClosure& operator=(TaskClosure&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+  TaskClosure(const TaskClosure&) = delete;
+  TaskClosure& operator=(const TaskClosure&) = delete;
+  ~TaskClosure() { Reset(); }
+
+  void operator()() { ops_->call(storage_); }
+  explicit operator bool() const { return ops_ != nullptr; }
+
+ private:
+  struct Ops {
+    void (*call)(void* storage);
+    // Move the callable from |from| into |to|, and destroy |from|.
+    void (*relocate)(void* from, void* to);
+    void (*destroy)(void* storage);
+  };
+
+  template <class F>
+  static constexpr bool IsInline() {
+    return sizeof(F) <= kInlineSize && alignof(F) <= alignof(void*) &&
+           std::is_nothrow_move_constructible_v<F>;
+  }
+
+  template <class F>
+  static F& Get(void* storage) {
+    if constexpr (IsInline<F>()) {
+      return *std::launder(static_cast<F*>(storage));
+    } else {
+      return **std::launder(static_cast<F**>(storage));
+    }
+  }
+
+  template <class F>
+  static void Call(void* storage) {
+    Get<F>(storage)();
+  }
+
+  template <class F>
+  static void Relocate(void* from, void* to) {
+    if constexpr (IsInline<F>()) {
+      new (to) F(std::move(Get<F>(from)));
+      Get<F>(from).~F();
+    } else {
+      new (to) F*(*static_cast<F**>(from));
+    }
+  }
+
+  template <class F>
+  static void Destroy(void* storage) {
+    if constexpr (IsInline<F>()) {
+      Get<F>(storage).~F();
+    } else {
+      delete &Get<F>(storage);  // NOLINT
+    }
+  }
+
+  template <class F>
+  static constexpr Ops kOps = {&Call<F>, &Relocate<F>, &Destroy<F>};
+
+  void MoveFrom(TaskClosure& other) {
+    if (other.ops_) {
+      other.ops_->relocate(other.storage_, storage_);
+      ops_ = other.ops_;
+      other.ops_ = nullptr;
+    }
+  }
+
+  void Reset() {
+    if (ops_) {
+      ops_->destroy(storage_);
+      ops_ = nullptr;
+    }
+  }
+
+  alignas(void*) unsigned char storage_[kInlineSize];  // NOLINT
+  const Ops* ops_ = nullptr;
+};
+
+using Task = std::variant<Event, TaskClosure, AnimationTask>;
 }  // namespace ftxui
 
 #endif  // FTXUI_COMPONENT_ANIMATION_HPP
@@ -0,0 +1,37 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_TRACE_HPP
+#define FTXUI_COMPONENT_TRACE_HPP
+
+#include <memory>  // for shared_ptr
+
+#include "ftxui/component/animation.hpp"  // for TimePoint
+
+namespace ftxui {
+
+class Tracer;
+
+/// @brief Add a span to the trace recorded by the active ScreenInteractive,
+/// lasting as long as this object.
+/// @ingroup component
+/// @see ScreenInteractive::RecordTrace()
+class TraceSpan {
+ public:
+  explicit TraceSpan(const char* name);
+  ~TraceSpan();
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan(TraceSpan&&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+  TraceSpan& operator=(TraceSpan&&) = delete;
+
+ private:
+  const char* name_;
+  std::shared_ptr<Tracer> tracer_;
+  animation::TimePoint start_;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_TRACE_HPP
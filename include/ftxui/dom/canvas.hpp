@@ -5,12 +5,15 @@
 #define FTXUI_DOM_CANVAS_HPP
 
 #include <cstddef>        // for size_t
+#include <cstdint>        // for uint8_t
 #include <functional>     // for function
 #include <string>         // for string
 #include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
 
-#include "ftxui/screen/color.hpp"  // for Color
-#include "ftxui/screen/image.hpp"  // for Pixel, Image
+#include "ftxui/dom/graph_series.hpp"  // for GraphSeries, GraphOption
+#include "ftxui/screen/color.hpp"         // for Color
+#include "ftxui/screen/image.hpp"         // for Pixel, Image
 
 #ifdef DrawText
 // Workaround for WinUsr.h (via Windows.h) defining macros that break things.
@@ -22,16 +25,39 @@ namespace ftxui {
 
 struct Canvas {
  public:
+  // How the cells are stored:
+  // - Sparse: in a hash map. Only the cells drawn use memory.
+  // - Dense: in a contiguous array. Faster when most of the cells are drawn.
+  enum class Storage {
+    Sparse,
+    Dense,
+  };
+
   Canvas() = default;
   Canvas(int width, int height);
+  Canvas(int width, int height, Storage storage);
 
   // Getters:
   int width() const { return width_; }
   int height() const { return height_; }
   Pixel GetPixel(int x, int y) const;
+  // The content of a cell, or nullptr when it was never drawn. Unlike
+  // GetPixel(), nothing is copied.
+  const Pixel* FindPixel(int x, int y) const;
+
+  // Erase every cell, keeping the storage for the next drawing.
+  void Clear();
+  // Change the size, in dots. Every cell is erased, the storage is kept.
+  void Resize(int width, int height);
 
   using Stylizer = std::function<void(Pixel&)>;
 
+  // A braille dot coordinate.
+  struct Point {
+    int x = 0;
+    int y = 0;
+  };
+
   // Draws using braille characters --------------------------------------------
   void DrawPointOn(int x, int y);
   void DrawPointOff(int x, int y);
@@ -55,6 +81,37 @@ struct Canvas {
   void DrawPointEllipseFilled(int x, int y, int r1, int r2, const Color& color);
   void DrawPointEllipseFilled(int x, int y, int r1, int r2, const Stylizer& s);
 
+  // Draw many braille dots at once ---------------------------------------------
+  void DrawPoints(const std::vector<Point>& points);
+  void DrawPoints(const std::vector<Point>& points, const Color& color);
+  void DrawPoints(const std::vector<Point>& points,
+                  const std::vector<Color>& colors);
+  void DrawPolyline(const std::vector<Point>& points);
+  void DrawPolyline(const std::vector<Point>& points, const Color& color);
+  void DrawPolyline(const std::vector<Point>& points,
+                    const std::vector<Color>& colors);
+  void DrawPointBitmap(int x,
+                       int y,
+                       int width,
+                       int height,
+                       const std::vector<uint8_t>& dots);
+  void DrawPointBitmap(int x,
+                       int y,
+                       int width,
+                       int height,
+                       const std::vector<uint8_t>& dots,
+                       const Color& color);
+
+  // Plot a series of samples ---------------------------------------------------
+  // Within the |width| x |height| dots from (x, y). The cost depends on
+  // |width|, not on the number of samples.
+  void DrawPointSeries(int x,
+                       int y,
+                       int width,
+                       int height,
+                       const GraphSeries& series,
+                       const GraphOption& option = {});
+
   // Draw using box characters -------------------------------------------------
   // Block are of size 1x2. y is considered to be a multiple of 2.
   void DrawBlockOn(int x, int y);
@@ -106,6 +163,10 @@ struct Canvas {
   // y is considered to be a multiple of 4.
   void Style(int x, int y, const Stylizer& style);
 
+  // Move the content by a number of cells (2x4 dots). The cells exposed are
+  // cleared. This is O(1) per exposed cell with Storage::Dense.
+  void Scroll(int dx, int dy);
+
  private:
   bool IsIn(int x, int y) const {
     return x >= 0 && x < width_ && y >= 0 && y < height_;
@@ -137,9 +198,34 @@ struct Canvas {
     }
   };
 
+  // Access the cell at the given cell coordinates. A cell is 2x4 dots.
+  Cell& CellAt(int x, int y);
+  const Cell* FindCell(int x, int y) const;
+  size_t DenseIndex(int x, int y) const;
+
+  // Draw a braille dot, or a line of braille dots. |color| is optional.
+  void PlotPoint(int x, int y, const Color* color);
+  void PlotLine(int x1, int y1, int x2, int y2, const Color* color);
+  void PlotBitmap(int x,
+                  int y,
+                  int width,
+                  int height,
+                  const std::vector<uint8_t>& dots,
+                  const Color* color);
+
   int width_ = 0;
   int height_ = 0;
+  Storage storage_type_ = Storage::Sparse;
   std::unordered_map<XY, Cell, XYHash> storage_;
+
+  // Used by Storage::Dense. The cells are stored in a ring buffer, starting
+  // at (dense_origin_x_, dense_origin_y_).
+  int dense_width_ = 0;
+  int dense_height_ = 0;
+  int dense_origin_x_ = 0;
+  int dense_origin_y_ = 0;
+  std::vector<Cell> dense_storage_;
+  Cell out_of_bounds_;
 };
 
 }  // namespace ftxui
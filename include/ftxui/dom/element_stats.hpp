@@ -0,0 +1,41 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_DOM_ELEMENT_STATS_HPP
+#define FTXUI_DOM_ELEMENT_STATS_HPP
+
+#include <cstddef>  // for size_t
+#include <map>      // for map
+#include <string>   // for string
+
+#include "ftxui/dom/node.hpp"  // for Element
+
+namespace ftxui {
+
+/// @brief The size of a tree of elements, to find out why a frame is slow.
+/// @ingroup dom
+/// @see Inspect()
+struct ElementStats {
+  size_t nodes = 0;  // The number of nodes.
+  int depth = 0;     // The number of nodes on the longest path from the root.
+
+  // The slots allocated for the children of the nodes, used or not.
+  size_t children_capacity = 0;
+
+  // The bytes of text owned by the nodes, like the characters of `text`.
+  size_t text_bytes = 0;
+
+  // An estimation of the heap memory used by the tree: the nodes, with their
+  // reference counts, the children slots, and the text. The nodes are counted
+  // as a Node, their own members excepted.
+  size_t heap_bytes = 0;
+
+  // The number of nodes of each concrete type, like "Text" or "HBox".
+  std::map<std::string, size_t> nodes_per_type;
+};
+
+ElementStats Inspect(const Element& element);
+
+}  // namespace ftxui
+
+#endif  // FTXUI_DOM_ELEMENT_STATS_HPP
@@ -4,16 +4,22 @@
 #ifndef FTXUI_DOM_ELEMENTS_HPP
 #define FTXUI_DOM_ELEMENTS_HPP
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 
 #include "ftxui/dom/canvas.hpp"
 #include "ftxui/dom/direction.hpp"
 #include "ftxui/dom/flexbox_config.hpp"
+#include "ftxui/dom/graph_series.hpp"
 #include "ftxui/dom/linear_gradient.hpp"
+#include "ftxui/dom/log_buffer.hpp"
 #include "ftxui/dom/node.hpp"
+#include "ftxui/dom/paragraph.hpp"
+#include "ftxui/screen/bitmap.hpp"
 #include "ftxui/screen/box.hpp"
 #include "ftxui/screen/color.hpp"
+#include "ftxui/screen/live_cell.hpp"
 #include "ftxui/screen/terminal.hpp"
 #include "ftxui/util/ref.hpp"
 
@@ -86,11 +92,25 @@ Element paragraphAlignLeft(const std::string& text);
 Element paragraphAlignRight(const std::string& text);
 Element paragraphAlignCenter(const std::string& text);
 Element paragraphAlignJustify(const std::string& text);
+Element paragraph(ConstRef<Paragraph>);
+Element paragraphAlignLeft(ConstRef<Paragraph>);
+Element paragraphAlignRight(ConstRef<Paragraph>);
+Element paragraphAlignCenter(ConstRef<Paragraph>);
+Element paragraphAlignJustify(ConstRef<Paragraph>);
 Element graph(GraphFunction);
+Element graph(ConstRef<GraphSeries>, GraphOption option = {});
+Element graph(std::vector<ConstRef<GraphSeries>>, GraphOption option = {});
 Element emptyElement();
 Element canvas(ConstRef<Canvas>);
 Element canvas(int width, int height, std::function<void(Canvas&)>);
 Element canvas(std::function<void(Canvas&)>);
+Element canvas(Canvas* canvas, std::function<void(Canvas&)>);
+Element image(const Image&);
+Element image(const Image&&) = delete;
+Element imageRGB(const uint8_t* rgb, int width, int height);
+Element imageBitmap(std::shared_ptr<const Bitmap> bitmap);
+Element live(std::shared_ptr<LiveCell> cell);
+Element logview(ConstRef<LogBuffer>, LogViewOption option = {});
 
 // -- Decorator ---
 Element bold(Element);
@@ -118,6 +138,10 @@ Element hyperlink(std::string link, Element child);
 // Horizontal, Vertical or stacked set of elements.
 Element hbox(Elements);
 Element vbox(Elements);
+Element vbox_virtual(int count,
+                     int row_height,
+                     std::function<Element(int)> generator,
+                     int selected = -1);
 Element dbox(Elements);
 Element flexbox(Elements, FlexboxConfig config = FlexboxConfig());
 Element gridbox(std::vector<Elements> lines);
@@ -174,6 +198,9 @@ Decorator reflect(Box& box);
 // Before drawing the |element| clear the pixel below. This is useful in
 // combinaison with dbox.
 Element clear_under(Element element);
+// Display an element which is displayed in other places, or kept across
+// frames.
+Element shared(Element element);
 
 // --- Util --------------------------------------------------------------------
 Element hcenter(Element);
@@ -0,0 +1,87 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_DOM_FLAT_LAYOUT_HPP
+#define FTXUI_DOM_FLAT_LAYOUT_HPP
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint32_t
+#include <vector>   // for vector
+
+#include "ftxui/dom/node.hpp"         // for Node, Element
+#include "ftxui/dom/requirement.hpp"  // for Requirement
+#include "ftxui/screen/box.hpp"       // for Box
+
+namespace ftxui {
+
+class Screen;
+
+namespace box_helper {
+struct Element;
+}  // namespace box_helper
+
+/// @brief Experimental: a layout engine laying the element out by linear
+/// passes over flat arrays, instead of recursive virtual calls.
+/// @ingroup dom
+///
+/// The rows, columns and decorators, see Node::LayoutKind, are flattened
+/// depth first, into arrays of kinds, requirements, boxes and child indices.
+/// Their requirements are computed in reverse order, children before parents,
+/// and their boxes in order, parents before children, without temporaries.
+/// The other nodes are laid out by their virtual functions, with their
+/// subtree. The result is the one of Render(), except for the requirement()
+/// of the flattened nodes, only kept in the arrays.
+///
+/// The arrays are kept across calls: reuse the same FlatLayout for every
+/// frame.
+///
+/// ### Example
+///
+/// ```cpp
+/// FlatLayout layout;
+/// while (running) {
+///   layout.Render(screen, document);
+/// }
+/// ```
+class FlatLayout {
+ public:
+  FlatLayout();
+  ~FlatLayout();
+  FlatLayout(const FlatLayout&) = delete;
+  FlatLayout& operator=(const FlatLayout&) = delete;
+
+  // Lay out |node| to fill |screen|, and draw it, like Render().
+  void Render(Screen& screen, const Element& element);
+  void Render(Screen& screen, Node* node);
+
+  // The nodes flattened by the last Render, the opaque ones included, but not
+  // their descendants.
+  size_t size() const { return nodes_.size(); }
+
+ private:
+  Box Layout(Screen& screen, Node* root);
+  void Flatten(Node* root, Node::Status* status);
+  uint32_t Append(Node* node, Node::Status* status);
+  void Check(Node::Status* status);
+  void CheckOpaque(size_t index, Node::Status* status);
+  void ComputeRequirements(bool opaque);
+  void SetBoxes(Box box);
+
+  // One entry per node, parents before children.
+  std::vector<Node*> nodes_;
+  std::vector<Node::LayoutKind> kinds_;
+  std::vector<uint32_t> first_child_;  // In |children_|.
+  std::vector<uint32_t> child_count_;
+  std::vector<Requirement> requirements_;
+  std::vector<Box> boxes_;
+
+  // The indices of the children of every node, next to each other.
+  std::vector<uint32_t> children_;
+
+  // Scratch space, kept across calls.
+  std::vector<box_helper::Element> sizes_;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_DOM_FLAT_LAYOUT_HPP
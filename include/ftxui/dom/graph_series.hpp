@@ -0,0 +1,85 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_DOM_GRAPH_SERIES_HPP
+#define FTXUI_DOM_GRAPH_SERIES_HPP
+
+#include <cstddef>  // for size_t
+#include <vector>   // for vector
+
+#include "ftxui/screen/color.hpp"  // for Color
+
+namespace ftxui {
+
+/// @brief The latest samples of a value, kept in a ring buffer, for graph().
+/// The minimum and the maximum of the samples are also kept per block of 2^k
+/// samples, so the extent of any range of samples is found in logarithmic
+/// time, whatever its length. A long series is drawn downsampled at this cost.
+/// @ingroup dom
+///
+/// ### Example
+///
+/// ```cpp
+/// GraphSeries cpu(100000);
+/// cpu.Push(0.42f);  // Once per sample.
+/// auto renderer = Renderer([&] { return graph(&cpu) | flex; });
+/// ```
+class GraphSeries {
+ public:
+  // Keep the latest |capacity| samples.
+  explicit GraphSeries(size_t capacity = 1024);
+
+  // Append a sample, dropping the oldest one when the series is full.
+  void Push(float value);
+  void Clear();
+
+  size_t size() const { return size_; }
+  size_t capacity() const { return samples_.size(); }
+
+  // The sample |index|, from the oldest one kept.
+  float At(size_t index) const;
+
+  // The minimum and the maximum of the samples in [begin, end), from the
+  // oldest one kept. The range must not be empty.
+  struct Extent {
+    float min = 0.F;
+    float max = 0.F;
+  };
+  Extent ExtentOf(size_t begin, size_t end) const;
+
+  // The extent of the samples displayed by the column |column|, when the
+  // latest |window| samples are spread over |columns| columns. Fewer samples
+  // than columns are aligned to the right. A column also covers the sample
+  // preceding its own ones, to join them. Return false when it covers none.
+  bool ColumnExtent(size_t column,
+                    size_t columns,
+                    size_t window,
+                    Extent* extent) const;
+
+ private:
+  std::vector<float> samples_;
+  size_t pushed_ = 0;  // The number of samples pushed since Clear().
+  size_t size_ = 0;
+
+  // |levels_[k - 1]| is the extent of the blocks of 2^k samples, the j-th block
+  // pushed being at |j % levels_[k - 1].size()|.
+  std::vector<std::vector<Extent>> levels_;
+};
+
+/// @brief The options of graph() over some GraphSeries.
+/// @ingroup dom
+struct GraphOption {
+  // The number of samples displayed, the latest ones of each series. 0 for all
+  // the samples kept.
+  size_t window = 0;
+  // The range of the values. When |min| >= |max|, the range of the samples
+  // displayed.
+  float min = 0.F;
+  float max = 0.F;
+  // The color of each series. The series without one use the current color.
+  std::vector<Color> colors;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_DOM_GRAPH_SERIES_HPP
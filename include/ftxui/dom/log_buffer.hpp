@@ -0,0 +1,129 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_DOM_LOG_BUFFER_HPP
+#define FTXUI_DOM_LOG_BUFFER_HPP
+
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t
+#include <string>       // for string
+#include <string_view>  // for string_view
+#include <vector>       // for vector
+
+namespace ftxui {
+
+/// @brief The options of a LogBuffer.
+/// @ingroup dom
+struct LogBufferOption {
+  // Compress the chunks of text once they are full. Only the last one, still
+  // appended to, is kept as is.
+  bool compress = false;
+  // The number of compressed chunks kept decompressed, for the lines read
+  // again, like the ones of a scrolled view. The least recently used is
+  // evicted first.
+  size_t cached_chunks = 4;
+};
+
+/// @brief An append-only list of lines, meant for logs. The text is stored in
+/// large chunks, and indexed by line, so appending and accessing a line don't
+/// depend on the size of the log.
+/// @ingroup dom
+///
+/// With LogBufferOption::compress, the full chunks are compressed, and
+/// decompressed on demand when their lines are read. Long histories then take
+/// a fraction of their size, while drawing the visible lines only decompresses
+/// their chunks. The reads then update the cache: a compressed LogBuffer can't
+/// be read by several threads at once.
+///
+/// ### Example
+///
+/// ```cpp
+/// LogBuffer log;
+/// log.Append("Starting\n");
+/// log.Append("Connected to ");  // The line is completed by the next Append.
+/// log.Append("localhost\n");
+/// auto renderer = Renderer([&] { return logview(&log) | yframe | flex; });
+/// ```
+class LogBuffer {
+ public:
+  LogBuffer() = default;
+  explicit LogBuffer(LogBufferOption option);
+
+  // Append |text|. It is split into lines at every '\n'. The last line stays
+  // open, and is continued by the next call, until a '\n' ends it.
+  void Append(std::string_view text);
+  // Append |line| as a whole line.
+  void AppendLine(std::string_view line);
+  void Clear();
+
+  size_t LineCount() const { return lines_.size(); }
+  // The line at |index|. With compression, the view is only valid until the
+  // next call, and LineAt() decompresses into a cache: unlike the other const
+  // functions, it must not be called by several threads at once.
+  std::string_view LineAt(size_t index) const;
+
+  // The bytes used to store the text, compressed or not, the decompressed
+  // chunks cached included. The index of the lines isn't counted.
+  size_t StorageSize() const;
+
+  // The number of rows the lines before |line| take, once wrapped at |width|.
+  // The result is cached, and updated incrementally when lines are appended.
+  size_t WrappedRowsBefore(size_t line, int width) const;
+  // The line displayed on the wrapped row |row|.
+  size_t LineAtWrappedRow(size_t row, int width) const;
+
+ private:
+  struct Line {
+    uint32_t chunk = 0;
+    uint32_t offset = 0;
+    uint32_t size = 0;
+  };
+
+  struct Chunk {
+    std::string text;  // Empty once compressed.
+    std::string compressed;
+    size_t size = 0;  // The size of the text, once decompressed.
+    bool is_compressed = false;
+  };
+
+  struct CachedChunk {
+    size_t chunk = 0;
+    size_t last_use = 0;
+    std::string text;
+  };
+
+  friend class LogView;
+  void AddPiece(std::string_view piece);
+  void AddChunk(size_t reserve);
+  void Seal(Chunk* chunk);
+  const std::string& ChunkText(size_t index) const;
+  void UpdateWrapCache(int width) const;
+
+  LogBufferOption option_;
+  std::vector<Chunk> chunks_;
+  std::vector<Line> lines_;
+  bool open_ = false;  // Whether the last line can be continued.
+
+  // The compressed chunks decompressed last, at most option_.cached_chunks.
+  mutable std::vector<CachedChunk> cache_;
+  mutable size_t use_counter_ = 0;
+
+  // The wrap cache. |wrap_rows_[i]| is the number of rows taken by the lines
+  // before the i-th one, for the first |wrap_rows_.size() - 1| lines.
+  mutable int wrap_width_ = 0;
+  mutable std::vector<size_t> wrap_rows_;
+};
+
+/// @brief The options of logview().
+/// @ingroup dom
+struct LogViewOption {
+  // Wrap the lines wider than the element, instead of clipping them.
+  bool wrap = false;
+  // The line focused, for frame() to scroll to it. -1 for the last line, to
+  // follow the end of the log.
+  int focused_line = -1;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_DOM_LOG_BUFFER_HPP
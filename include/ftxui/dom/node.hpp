@@ -4,8 +4,10 @@
 #ifndef FTXUI_DOM_NODE_HPP
 #define FTXUI_DOM_NODE_HPP
 
-#include <memory>  // for shared_ptr
-#include <vector>  // for vector
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint8_t
+#include <memory>   // for shared_ptr
+#include <vector>   // for vector
 
 #include "ftxui/dom/requirement.hpp"  // for Requirement
 #include "ftxui/screen/box.hpp"       // for Box
@@ -13,12 +15,19 @@
 
 namespace ftxui {
 
+class FlatLayout;
 class Node;
 class Screen;
+class WorkerPool;
+struct ElementStats;
 
 using Element = std::shared_ptr<Node>;
 using Elements = std::vector<Element>;
 
+namespace Dimension {
+Dimensions Fit(Element&, bool extend_beyond_screen);
+}  // namespace Dimension
+
 class Node {
  public:
   Node();
@@ -43,6 +52,12 @@ class Node {
   // Step 3: Draw this element.
   virtual void Render(Screen& screen);
 
+  // Optional step, between 2 and 3: Do the part of Render not writing into
+  // the Screen, like running the function drawing a canvas. RenderParallel
+  // calls it concurrently for several nodes. Render must do it itself when it
+  // wasn't called.
+  virtual void Prepare();
+
   // Layout may not resolve within a single iteration for some elements. This
   // allows them to request additionnal iterations. This signal must be
   // forwarded to children at least once.
@@ -52,14 +67,89 @@ class Node {
   };
   virtual void Check(Status* status);
 
+  // Debugging: the bytes of text owned by this node, like the characters of a
+  // `text`. See Inspect().
+  virtual size_t TextBytes() const;
+
+  // Whether the layout of this node only depends on the requirements of its
+  // children, so that it can be computed without calling ComputeRequirement
+  // and SetBox. FlatLayout lays out these nodes by flat passes, and the chains
+  // of decorators are laid out by a loop. Their Check must be Node::Check.
+  enum class LayoutKind : uint8_t {
+    kOpaque,     // Lay out by the virtual functions, like its subtree.
+    kRow,        // Like hbox.
+    kColumn,     // Like vbox.
+    kDecorator,  // The requirement and the box of its only child.
+    kAdjust,     // Like kDecorator, the requirement modified by the function
+                 // below.
+  };
+  virtual LayoutKind layout_kind() const;
+  virtual void AdjustRequirement(Requirement* requirement) const;
+
  protected:
+  // Render |node|, unless it is entirely outside of the stencil. Like the rows
+  // of a frame scrolled away.
+  static void RenderVisible(Screen& screen, Node* node);
+
+  // Forward the layout steps to a child. When neither |node|, nor any of its
+  // descendants, asked for another iteration in the last Check, its layout
+  // can't change: its requirement is kept, and so is its box, when it is
+  // given the same one. Nodes forwarding Check to their children directly must
+  // also use the direct ComputeRequirement and SetBox.
+  static void CheckChild(Node* node, Status* status);
+  static void ComputeChildRequirement(Node* node);
+  static void SetChildBox(Node* node, Box box);
+  static bool IsDecorator(Node* node);
+
   Elements children_;
   Requirement requirement_;
   Box box_;
+
+ private:
+  friend void RenderParallel(Screen& screen,
+                             Node* node,
+                             WorkerPool& pool,
+                             int threads);
+  friend class FlatLayout;
+  friend class SharedNode;
+  friend ElementStats Inspect(const Element& element);
+  friend Requirement Measure(Node* node);
+  friend Dimensions Dimension::Fit(Element&, bool extend_beyond_screen);
+  friend void Render(Screen& screen, Node* node);
+
+  // Lay out |node| to fill |screen|. Return the box it was given.
+  static Box LayoutRoot(Screen& screen, Node* node);
+
+  bool layout_stable_ = false;
+  // The layout_kind(), once queried. It can't be from the constructor.
+  static constexpr LayoutKind kUnknownKind = LayoutKind(0xFF);
+  LayoutKind layout_kind_ = kUnknownKind;
+  // Whether the requirement was just computed, outside of Render(). The next
+  // layout starts from it.
+  bool measured_ = false;
+  // Whether the requirement was computed by a placement of shared(), since the
+  // last Check. The other placements reuse it.
+  bool shared_requirement_ = false;
 };
 
+// Compute the requirement of |node|, to choose the dimensions of the Screen
+// from it. The next Render of |node| doesn't compute it again.
+Requirement Measure(Node* node);
+Requirement Measure(const Element& element);
+
 void Render(Screen& screen, const Element& element);
 void Render(Screen& screen, Node* node);
+void Render(Image& image, const Element& element);
+void RenderParallel(Screen& screen, const Element& element, int threads = 0);
+void RenderParallel(Screen& screen, Node* node, int threads = 0);
+void RenderParallel(Screen& screen,
+                    const Element& element,
+                    WorkerPool& pool,
+                    int threads = 0);
+void RenderParallel(Screen& screen,
+                    Node* node,
+                    WorkerPool& pool,
+                    int threads = 0);
 
 }  // namespace ftxui
 
@@ -0,0 +1,50 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_DOM_PARAGRAPH_HPP
+#define FTXUI_DOM_PARAGRAPH_HPP
+
+#include <cstddef>      // for size_t
+#include <string>       // for string
+#include <string_view>  // for string_view
+#include <vector>       // for vector
+
+namespace ftxui {
+
+/// @brief A text split into words, with their widths. They are computed once,
+/// so that the same paragraph can be rendered on every frame without splitting
+/// and measuring it again.
+/// @ingroup dom
+///
+/// ### Example
+///
+/// ```cpp
+/// Paragraph log_line("A long line of text, wrapped at the words.");
+/// auto renderer = Renderer([&] { return paragraph(&log_line); });
+/// ```
+class Paragraph {
+ public:
+  struct Word {
+    size_t start = 0;  // The position of the word in the text, in bytes.
+    size_t size = 0;   // The length of the word, in bytes.
+    int width = 0;     // The number of cells it takes.
+  };
+
+  Paragraph() = default;
+  explicit Paragraph(std::string text);
+
+  void SetText(std::string text);
+  const std::string& text() const { return text_; }
+
+  // The words separated by spaces.
+  const std::vector<Word>& words() const { return words_; }
+  std::string_view WordAt(size_t index) const;
+
+ private:
+  std::string text_;
+  std::vector<Word> words_;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_DOM_PARAGRAPH_HPP
@@ -0,0 +1,85 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_DOM_STATIC_DECORATOR_HPP
+#define FTXUI_DOM_STATIC_DECORATOR_HPP
+
+#include <utility>  // for move
+
+#include "ftxui/dom/elements.hpp"  // for Element, Elements
+
+namespace ftxui {
+
+/// @brief A decorator whose type is known at compile time.
+///
+/// Unlike `Decorator`, it isn't wrapped into a `std::function`. Composing two
+/// of them with `operator|` produces a new type, instead of allocating a
+/// closure, and applying them is a direct call. It converts implicitly into a
+/// `Decorator` when one is required.
+/// @ingroup dom
+///
+/// ### Example
+///
+/// ```cpp
+/// constexpr auto highlight = StaticDecorator(bold) | inverted;
+/// Element document = text("Hello") | highlight;
+/// ```
+template <typename F>
+class StaticDecorator {
+ public:
+  constexpr explicit StaticDecorator(F function)
+      : function_(std::move(function)) {}
+
+  Element operator()(Element element) const {
+    return function_(std::move(element));
+  }
+
+ private:
+  F function_;
+};
+
+/// @brief Compose two static decorators into one. |a| is applied first.
+/// @ingroup dom
+template <typename A, typename B>
+constexpr auto operator|(StaticDecorator<A> a, StaticDecorator<B> b) {
+  return StaticDecorator(
+      [a = std::move(a), b = std::move(b)](Element element) {
+        return b(a(std::move(element)));
+      });
+}
+
+/// @brief Compose a static decorator with a decorating function, like `bold`.
+/// @ingroup dom
+template <typename A>
+constexpr auto operator|(StaticDecorator<A> a, Element (*b)(Element)) {
+  return std::move(a) | StaticDecorator(b);
+}
+
+/// @brief From an element, apply a static decorator.
+/// @ingroup dom
+template <typename F>
+Element operator|(Element element, const StaticDecorator<F>& decorator) {
+  return decorator(std::move(element));
+}
+
+/// @brief Apply a static decorator to an element.
+/// @ingroup dom
+template <typename F>
+Element& operator|=(Element& element, const StaticDecorator<F>& decorator) {
+  element = decorator(std::move(element));
+  return element;
+}
+
+/// @brief From a set of element, apply a static decorator to every elements.
+/// @ingroup dom
+template <typename F>
+Elements operator|(Elements elements, const StaticDecorator<F>& decorator) {
+  for (auto& element : elements) {
+    element = decorator(std::move(element));
+  }
+  return elements;
+}
+
+}  // namespace ftxui
+
+#endif  // FTXUI_DOM_STATIC_DECORATOR_HPP
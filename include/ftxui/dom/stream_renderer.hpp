@@ -0,0 +1,103 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_DOM_STREAM_RENDERER_HPP
+#define FTXUI_DOM_STREAM_RENDERER_HPP
+
+#include <chrono>    // for steady_clock, milliseconds
+#include <cstddef>   // for size_t
+#include <iostream>  // for ostream, cout
+#include <string>    // for string
+#include <vector>    // for vector
+
+#include "ftxui/dom/elements.hpp"  // for Element
+
+namespace ftxui {
+
+/// @brief The options of StreamRenderer.
+/// @ingroup dom
+struct StreamRendererOption {
+  enum class Mode {
+    // Terminal when writing to std::cout and the standard output is a
+    // terminal. Plain otherwise.
+    Auto,
+    // Draw each frame over the previous one, with escape sequences.
+    Terminal,
+    // Write plain text lines, without escape sequences.
+    Plain,
+  };
+  Mode mode = Mode::Auto;
+
+  // The width of the frames. 0 for the width of the terminal.
+  int width = 0;
+
+  // In plain mode, the lines appended to a frame are written at once. When
+  // some of the lines written change instead, they are written again only
+  // once |snapshot_interval| has passed since the last write.
+  std::chrono::milliseconds snapshot_interval{1000};
+};
+
+/// @brief Write successive frames of an element to a stream, for progress
+/// output outside of a ScreenInteractive.
+/// @ingroup dom
+///
+/// On a terminal, each frame is drawn over the previous one. Otherwise, like
+/// when the output is a file or a pipe, nothing is redrawn: the frames are
+/// written as plain text, and only what changed is written again. The lines
+/// appended, like the ones of a log, are written once. The lines changing,
+/// like a progress bar, are written again at most once per
+/// |option.snapshot_interval|.
+///
+/// ### Example
+///
+/// ```cpp
+/// StreamRenderer renderer;
+/// for (int i = 0; i <= 100; ++i) {
+///   renderer.Render(hbox({text("Building "), gauge(i / 100.f)}));
+///   Build(i);
+/// }
+/// renderer.Finish();
+/// ```
+class StreamRenderer {
+ public:
+  explicit StreamRenderer(std::ostream& out = std::cout,
+                          StreamRendererOption option = {});
+  ~StreamRenderer();
+
+  // Draw |element|, and write what changed since the previous frame.
+  void Render(Element element);
+
+  // Write the last frame if it was held back, and end it with a new line.
+  // Called by the destructor, if not called before.
+  void Finish();
+
+  // This class is non copyable/movable.
+  StreamRenderer(const StreamRenderer&) = delete;
+  StreamRenderer(StreamRenderer&&) = delete;
+  StreamRenderer& operator=(const StreamRenderer&) = delete;
+  StreamRenderer& operator=(StreamRenderer&&) = delete;
+
+ private:
+  void RenderTerminal(Element element);
+  void RenderPlain(Element element);
+  void WritePlain(std::vector<std::string> lines, size_t first);
+
+  std::ostream& out_;
+  StreamRendererOption option_;
+  bool terminal_ = false;
+  bool finished_ = false;
+
+  // Terminal mode: the last frame written, and how to go back to its start.
+  std::string frame_;
+  std::string reset_position_;
+
+  // Plain mode: the lines written, and the latest frame held back, if any.
+  std::vector<std::string> written_;
+  std::vector<std::string> pending_;
+  bool has_pending_ = false;
+  std::chrono::steady_clock::time_point last_write_;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_DOM_STREAM_RENDERER_HPP
@@ -4,13 +4,20 @@
 #ifndef FTXUI_DOM_TABLE
 #define FTXUI_DOM_TABLE
 
-#include <string>  // for string
-#include <vector>  // for vector
+#include <cstddef>      // for size_t
+#include <cstdint>      // for int64_t
+#include <functional>   // for function
+#include <memory>       // for shared_ptr
+#include <string>       // for string
+#include <string_view>  // for string_view
+#include <vector>       // for vector
 
 #include "ftxui/dom/elements.hpp"  // for Element, BorderStyle, LIGHT, Decorator
 
 namespace ftxui {
 
+class WorkerPool;
+
 // Usage:
 //
 // Initialization:
@@ -52,9 +59,33 @@ class Table {
   Element Render();
 
  private:
+  // A decoration of a TableSelection. It is recorded, and applied to every
+  // element it selects once, by Render().
+  struct Decoration {
+    Decorator decorator;
+    int x_min = 0;
+    int x_max = 0;
+    int y_min = 0;
+    int y_max = 0;
+    // Only the rows of cells, not the horizontal lines.
+    bool rows_only = false;
+    // Only the cells, not the lines and the corners.
+    bool cells_only = false;
+    // Only the columns/rows whose index modulo |modulo| is |shift|. Unused
+    // when |modulo| is 0.
+    int column_modulo = 0;
+    int column_shift = 0;
+    int row_modulo = 0;
+    int row_shift = 0;
+
+    bool Selects(int x, int y) const;
+  };
+
   void Initialize(std::vector<std::vector<Element>>);
+  void ApplyDecorations();
   friend TableSelection;
   std::vector<std::vector<Element>> elements_;
+  std::vector<Decoration> decorations_;
   int input_dim_x_ = 0;
   int input_dim_y_ = 0;
   int dim_x_ = 0;
@@ -83,6 +114,7 @@ class TableSelection {
 
  private:
   friend Table;
+  Table::Decoration MakeDecoration(Decorator decorator) const;
   Table* table_;
   int x_min_;
   int x_max_;
@@ -90,6 +122,149 @@ class TableSelection {
   int y_max_;
 };
 
+// A column of cells borrowed from the caller, for a VirtualTable. Nothing is
+// copied: the data must outlive the table. The cells are formatted when they
+// are rendered.
+//
+// Usage:
+//
+// // The names, back to back, and where each one starts. The last offset is
+// // the end of the last name.
+// std::string names = "AliceBob";
+// std::vector<size_t> offsets = {0, 5, 8};
+// std::vector<int64_t> ages = {31, 42};
+//
+// auto table = VirtualTable({
+//     TableColumn::Strings(names, offsets.data(), 2),
+//     TableColumn::Integers(ages.data(), 2),
+// });
+class TableColumn {
+ public:
+  static TableColumn Strings(std::string_view arena,
+                             const size_t* offsets,
+                             int rows);
+  static TableColumn Integers(const int64_t* values, int rows);
+  static TableColumn Doubles(const double* values, int rows, int precision = 2);
+
+  int RowCount() const { return rows_; }
+
+  // The text of the cell at |row|. The strings are returned in place. The
+  // numbers are formatted into |buffer|, reused from one call to the next.
+  std::string_view Format(int row, std::string& buffer) const;
+
+ private:
+  friend std::vector<int> SortRows(std::vector<int> rows,
+                                   const TableColumn& column,
+                                   bool ascending,
+                                   WorkerPool* pool);
+
+  enum class Type { Strings, Integers, Doubles };
+  Type type_ = Type::Strings;
+  int rows_ = 0;
+  std::string_view arena_;
+  const size_t* offsets_ = nullptr;
+  const int64_t* integers_ = nullptr;
+  const double* doubles_ = nullptr;
+  int precision_ = 0;
+};
+
+// The rows of a VirtualTable, sorted and filtered. See
+// VirtualTable::RowOrder(). The work is split on |pool|, or by default on the
+// pool running the calling thread, like in ScreenInteractive::RunInBackground.
+// Without pool, it is done on the calling thread.
+//
+// Usage:
+//
+// screen.RunInBackground(
+//     [&, order] { *order = SortRows(FilterRows(count, keep), column); },
+//     [&, order] {
+//       table.RowOrder(order);
+//       screen.PostEvent(Event::Custom);
+//     });
+//
+// The rows sorted by the cells of |column|, in a stable way.
+std::vector<int> SortRows(std::vector<int> rows,
+                          const TableColumn& column,
+                          bool ascending = true,
+                          WorkerPool* pool = nullptr);
+// The rows sorted by |less|, in a stable way. |less| is called concurrently.
+std::vector<int> SortRows(std::vector<int> rows,
+                          const std::function<bool(int a, int b)>& less,
+                          WorkerPool* pool = nullptr);
+// The rows in [0, |count|) for which |keep| is true, in order. |keep| is called
+// concurrently.
+std::vector<int> FilterRows(int count,
+                            const std::function<bool(int row)>& keep,
+                            WorkerPool* pool = nullptr);
+
+// A table whose rows are produced on demand. Only the rows displayed are
+// requested, and turned into a Table.
+//
+// Usage:
+//
+// auto table = VirtualTable(3, [&] { return int(rows.size()); },
+//                           [&](int column, int row) {
+//                             return text(rows[row][column]);
+//                           });
+// table.ColumnWidths([](int column) { return column == 0 ? 10 : 20; });
+// // Or: table.MeasureColumnWidths();
+// // Or: table.SampleColumnWidths(100);
+// table.Decorate([](Table& slice, int first_row) {
+//   slice.SelectAll().Border(LIGHT);
+//   slice.SelectAll().DecorateAlternateRow(dim, 2, first_row % 2);
+// });
+//
+// table.Render(first_row, visible_rows);
+class VirtualTable {
+ public:
+  using Cell = std::function<Element(int column, int row)>;
+  using ColumnWidth = std::function<int(int column)>;
+  using Decorator = std::function<void(Table& slice, int first_row)>;
+
+  VirtualTable(int columns, std::function<int()> rows, Cell cell);
+  explicit VirtualTable(std::vector<TableColumn> columns);
+
+  // Column widths:
+  void ColumnWidths(ColumnWidth width);
+  void MeasureColumnWidths();
+  void SampleColumnWidths(int sample_size);
+  void InvalidateColumnWidths();
+  int ColumnWidthAt(int column) const;
+
+  void Decorate(Decorator decorator);
+
+  // The rows displayed, as indices of the rows of the model. All of them, in
+  // order, when null. See SortRows() and FilterRows().
+  void RowOrder(std::shared_ptr<const std::vector<int>> rows);
+
+  int ColumnCount() const { return columns_; }
+  int RowCount() const;
+  Element Render(int first_row, int row_count) const;
+
+ private:
+  void UpdateColumnWidths() const;
+  void MeasureRow(int row) const;
+  Element MakeCell(int column, int row) const;
+  int ModelRow(int row) const { return order_ ? (*order_)[row] : row; }
+
+  int columns_;
+  std::function<int()> rows_;
+  Cell cell_;
+  ColumnWidth column_width_;
+  Decorator decorator_;
+  // The columns the cells are read from, when built from TableColumn.
+  std::vector<TableColumn> data_;
+  // Set by RowOrder(). Replaced at once, never modified.
+  std::shared_ptr<const std::vector<int>> order_;
+
+  // Width cache, used by MeasureColumnWidths() and SampleColumnWidths(). The
+  // rows before |measured_rows_| have already been taken into account.
+  bool measure_ = false;
+  int sample_size_ = 0;
+  mutable std::vector<int> measured_widths_;
+  mutable int measured_rows_ = 0;
+};
+
 }  // namespace ftxui
 
 #endif /* end of include guard: FTXUI_DOM_TABLE */
@@ -0,0 +1,80 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_DOM_WORKER_POOL_HPP
+#define FTXUI_DOM_WORKER_POOL_HPP
+
+#include <atomic>              // for atomic
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <deque>               // for deque
+#include <functional>          // for function
+#include <memory>              // for unique_ptr
+#include <mutex>               // for mutex
+#include <thread>              // for thread
+#include <vector>              // for vector
+
+namespace ftxui {
+
+/// @brief A fixed set of threads running tasks. Each thread has its own queue,
+/// and steals from the others' once it is empty.
+/// @ingroup dom
+///
+/// ### Example
+///
+/// ```cpp
+/// WorkerPool pool;
+/// pool.Run([] { Compress(file); });
+/// pool.ParallelFor(rows.size(), [&](size_t i) { Highlight(rows[i]); });
+/// ```
+class WorkerPool {
+ public:
+  // |threads| negative for one per core.
+  explicit WorkerPool(int threads = -1);
+  // The tasks not started are dropped. The running ones are waited for.
+  ~WorkerPool();
+
+  // This class is non copyable/movable.
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool(WorkerPool&&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+  WorkerPool& operator=(WorkerPool&&) = delete;
+
+  int size() const { return int(threads_.size()); }
+
+  // The pool whose thread is the calling one, if any.
+  static WorkerPool* Current();
+
+  // Run |task| on one of the threads. Without threads, on the calling one.
+  void Run(std::function<void()> task);
+
+  // Call |fn| for every index in [0, count), on the calling thread and on up
+  // to |threads| - 1 threads of the pool, all of them for 0. Return once done.
+  // The calling thread doesn't wait for busy threads to pick the work up.
+  void ParallelFor(size_t count,
+                   const std::function<void(size_t)>& fn,
+                   int threads = 0);
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void Work(size_t index);
+  bool Pop(size_t index, std::function<void()>* task);
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> threads_;
+  std::atomic<size_t> next_queue_{0};
+
+  // The number of tasks queued. Guarded by |mutex_| for the threads to sleep.
+  std::atomic<size_t> pending_{0};
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool quit_ = false;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_DOM_WORKER_POOL_HPP
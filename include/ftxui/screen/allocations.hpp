@@ -0,0 +1,28 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_SCREEN_ALLOCATIONS_HPP
+#define FTXUI_SCREEN_ALLOCATIONS_HPP
+
+#include <cstddef>  // for size_t
+
+namespace ftxui {
+
+/// @brief A number of heap allocations, and the bytes they requested.
+/// @ingroup screen
+struct AllocationCount {
+  size_t count = 0;
+  size_t bytes = 0;
+};
+
+AllocationCount operator-(const AllocationCount& a, const AllocationCount& b);
+
+// The heap allocations made by the calling thread since it started. They are
+// only counted when FTXUI is built with the FTXUI_ALLOCATION_COUNTING CMake
+// option, which replaces the global operator new.
+AllocationCount Allocations();
+bool AllocationCountingEnabled();
+
+}  // namespace ftxui
+
+#endif  // FTXUI_SCREEN_ALLOCATIONS_HPP
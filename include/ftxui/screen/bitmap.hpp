@@ -0,0 +1,47 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_SCREEN_BITMAP_HPP
+#define FTXUI_SCREEN_BITMAP_HPP
+
+#include <cstdint>  // for uint8_t, uint32_t
+#include <mutex>    // for once_flag
+#include <string>   // for string
+#include <vector>   // for vector
+
+namespace ftxui {
+
+/// @brief Immutable RGB pixels, sent to terminals supporting graphics, see
+/// Terminal::GraphicsSupport(). Each bitmap has its own id: it is transmitted
+/// once to the terminal, and only placed on the next frames. The terminal
+/// forgets it once the bitmap is destroyed.
+/// @ingroup screen
+class Bitmap {
+ public:
+  // |rgb| holds 3 bytes per pixel, row after row.
+  Bitmap(int width, int height, std::vector<uint8_t> rgb);
+
+  int width() const { return width_; }
+  int height() const { return height_; }
+  const std::vector<uint8_t>& rgb() const { return rgb_; }
+  uint32_t id() const { return id_; }
+
+  // The pixels encoded as a Sixel image, computed once.
+  const std::string& Sixel() const;
+
+  // This class is non copyable: the copy would share the id.
+  Bitmap(const Bitmap&) = delete;
+  Bitmap& operator=(const Bitmap&) = delete;
+
+ private:
+  int width_;
+  int height_;
+  std::vector<uint8_t> rgb_;
+  uint32_t id_;
+  mutable std::once_flag sixel_once_;
+  mutable std::string sixel_;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_SCREEN_BITMAP_HPP
@@ -0,0 +1,106 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_SCREEN_CELL_BUFFER_HPP
+#define FTXUI_SCREEN_CELL_BUFFER_HPP
+
+#include <cstddef>        // for size_t
+#include <cstdint>        // for uint32_t
+#include <string>         // for string
+#include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
+
+#include "ftxui/screen/pixel.hpp"   // for Pixel
+#include "ftxui/screen/screen.hpp"  // for Screen
+
+namespace ftxui {
+
+/// @brief The pixels of a Screen as a flat array of 32 bits integers, and the
+/// list of the cells changed by the last update. A renderer drawing the cells
+/// itself, like a canvas or xterm.js in a browser, reads them in place instead
+/// of parsing escape sequences.
+/// @ingroup screen
+///
+/// Each cell is made of kCellSize integers, row after row:
+/// - kGlyph: the codepoint of the character, or kGlyphBase + i for the
+///   cluster Glyph(i) made of several codepoints. The cell following a
+///   fullwidth character is covered by it, whatever its content.
+/// - kForeground, kBackground: the Color::Key() of the colors. 0 is the
+///   default color. Bits 24-25 are the type: 1 for the 16 colors palette, 2
+///   for the 256 colors one, with the index in bits 16-23, 3 for RGB.
+/// - kStyle: the Attribute bits, and the id of the Hyperlink() in bits 16-31.
+///
+/// ### Example
+///
+/// ```cpp
+/// CellBuffer cells;
+/// cells.Update(screen);
+/// for (uint32_t index : cells.updates()) {
+///   Draw(index % cells.dimx(), index / cells.dimx(), cells.cell(index));
+/// }
+/// ```
+class CellBuffer {
+ public:
+  enum Field : uint32_t {
+    kGlyph = 0,
+    kForeground = 1,
+    kBackground = 2,
+    kStyle = 3,
+  };
+  static constexpr uint32_t kCellSize = 4;
+  static constexpr uint32_t kGlyphBase = 0x110000;
+
+  enum Attribute : uint32_t {
+    kBold = 1U << 0U,
+    kDim = 1U << 1U,
+    kUnderlined = 1U << 2U,
+    kUnderlinedDouble = 1U << 3U,
+    kBlink = 1U << 4U,
+    kInverted = 1U << 5U,
+    kStrikethrough = 1U << 6U,
+  };
+
+  // The Attribute bits of the style of |pixel|.
+  static uint32_t Attributes(const Pixel& pixel);
+
+  // Copy the pixels of |screen|, and list the cells changed since the previous
+  // update. Every cell is listed when the size changes.
+  void Update(const Screen& screen);
+
+  int dimx() const { return dimx_; }
+  int dimy() const { return dimy_; }
+  Screen::Cursor cursor() const { return cursor_; }
+
+  // The dimx() * dimy() * kCellSize integers.
+  const std::vector<uint32_t>& cells() const { return cells_; }
+  const uint32_t* cell(uint32_t index) const {
+    return cells_.data() + index * kCellSize;
+  }
+  // The index of the cells changed by the last Update(), in increasing order.
+  const std::vector<uint32_t>& updates() const { return updates_; }
+
+  // The clusters of codepoints and the hyperlinks referenced by the cells.
+  const std::string& Glyph(uint32_t index) const { return glyphs_[index]; }
+  const std::string& Hyperlink(uint32_t id) const { return hyperlinks_[id]; }
+
+ private:
+  uint32_t GlyphOf(const std::string& character);
+  uint32_t HyperlinkOf(const Screen& screen, uint16_t id);
+
+  int dimx_ = 0;
+  int dimy_ = 0;
+  Screen::Cursor cursor_;
+  std::vector<uint32_t> cells_;
+  std::vector<uint32_t> updates_;
+
+  // Kept from one update to the next, for the unchanged cells referencing
+  // them. Cleared when the size changes.
+  std::vector<std::string> glyphs_;
+  std::unordered_map<std::string, uint32_t> glyph_ids_;
+  std::vector<std::string> hyperlinks_ = {""};
+  std::unordered_map<std::string, uint32_t> hyperlink_ids_;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_SCREEN_CELL_BUFFER_HPP
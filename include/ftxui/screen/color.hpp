@@ -4,9 +4,11 @@
 #ifndef FTXUI_SCREEN_COLOR_HPP
 #define FTXUI_SCREEN_COLOR_HPP
 
-#include <cstdint>  // for uint8_t
+#include <cstdint>  // for uint8_t, uint32_t
 #include <string>   // for string
 
+#include "ftxui/screen/terminal.hpp"  // for Terminal::Color
+
 #ifdef RGB
 // Workaround for wingdi.h (via Windows.h) defining macros that break things.
 // https://docs.microsoft.com/en-us/windows/win32/api/wingdi/nf-wingdi-rgb
@@ -316,8 +318,23 @@ class Color {
   bool operator!=(const Color& rhs) const;
 
   std::string Print(bool is_background_color) const;
+  void PrintTo(std::string& output, bool is_background_color) const;
   bool IsOpaque() const { return alpha_ == 255; }
 
+  // A number identifying the color: two colors are equal when their keys are.
+  // It fits in 26 bits, and is 0 for Color::Default.
+  uint32_t Key() const {
+    return uint32_t(type_) << 24 | uint32_t(red_) << 16 |
+           uint32_t(green_) << 8 | uint32_t(blue_);
+  }
+  // The color of a Key(). The colors are used as is, whatever the terminal
+  // supports.
+  static Color FromKey(uint32_t key);
+
+  // The closest color of the palettes a terminal supporting |support| colors
+  // displays. Color::Default for a monochrome terminal.
+  Color Downgrade(Terminal::Color support) const;
+
  private:
   enum class ColorType : uint8_t {
     Palette1,
@@ -4,8 +4,11 @@
 #ifndef FTXUI_SCREEN_IMAGE_HPP
 #define FTXUI_SCREEN_IMAGE_HPP
 
-#include <string>  // for string, basic_string, allocator
-#include <vector>  // for vector
+#include <algorithm>  // for max, min
+#include <cstddef>    // for size_t
+#include <limits>     // for numeric_limits
+#include <string>     // for string, basic_string, allocator
+#include <vector>     // for vector
 
 #include "ftxui/screen/box.hpp"    // for Box
 #include "ftxui/screen/pixel.hpp"  // for Pixel
@@ -35,12 +38,101 @@ class Image {
   // Fill the image with space and default style
   void Clear();
 
+  // Copy the pixels of |image|, with its top-left corner at (x, y). Only the
+  // ones within the stencil are copied, a row at a time.
+  void DrawImage(int x, int y, const Image& image);
+
+  // Set the character of the pixels from (x_min, y) to (x_max, y), or from
+  // (x, y_min) to (x, y_max), within the stencil. Like calling at() for each
+  // of them, with the bounds checked once. When |automerge|, the pixels are
+  // also marked to be merged with the adjacent box drawing characters.
+  void FillRow(int x_min,
+               int x_max,
+               int y,
+               const std::string& character,
+               bool automerge = false);
+  void FillColumn(int x,
+                  int y_min,
+                  int y_max,
+                  const std::string& character,
+                  bool automerge = false);
+
+  // Same, replacing the whole pixels by |pixel|.
+  void FillRow(int x_min, int x_max, int y, const Pixel& pixel);
+  void FillColumn(int x, int y_min, int y_max, const Pixel& pixel);
+
+  // Contiguous pixels of a row, from the column x_min to x_max. They are
+  // indexed by their column, without bound checks.
+  struct PixelRow {
+    Pixel* pixels = nullptr;  // The pixel of the column x_min.
+    int x_min = 0;
+    int x_max = -1;
+
+    bool empty() const { return x_max < x_min; }
+    int size() const { return x_max - x_min + 1; }
+    Pixel& operator[](int x) const { return pixels[x - x_min]; }
+    Pixel* begin() const { return pixels; }
+    Pixel* end() const { return pixels + size(); }
+  };
+
+  // The pixels from (x_min, y) to (x_max, y) within the stencil, to be
+  // written by the caller. The bounds are checked once for the row, instead
+  // of once per pixel like PixelAt(). Empty when the row is outside of it.
+  PixelRow ClippedRow(int x_min, int x_max, int y);
+
+  // The bytes allocated by the image, including the storage kept from larger
+  // dimensions and the characters too long to be stored inline.
+  size_t MemoryUsage() const;
+  // Release the storage beyond what the current dimensions and characters
+  // need. The pixels are kept.
+  void ShrinkToFit();
+
   Box stencil;
 
  protected:
+  // Access the first pixel of the row |y|. The row is made of dimx_ contiguous
+  // pixels. There are no bound checks.
+  Pixel* RowAt(int y) { return pixels_.data() + y * dimx_; }
+  const Pixel* RowAt(int y) const { return pixels_.data() + y * dimx_; }
+
+  // Change the dimensions. Every pixel is reset. The storage is reused, and
+  // only reallocated when growing past its capacity.
+  void Resize(int dimx, int dimy);
+
+  // The range of columns of a row written through the Image API since the
+  // last Clear(): PixelAt(), FillRow(), FillColumn(), ClippedRow() and
+  // DrawImage(). The pixels outside of it are known to be default ones.
+  struct TouchedSpan {
+    int x_min = std::numeric_limits<int>::max();
+    int x_max = -1;
+
+    bool IsEmpty() const { return x_max < x_min; }
+  };
+  const TouchedSpan& TouchedSpanAt(int y) const { return touched_[y]; }
+  // The rows whose touched span isn't empty, in increasing order.
+  const std::vector<int>& TouchedRows();
+
   int dimx_;
   int dimy_;
-  std::vector<std::vector<Pixel>> pixels_;
+
+  // The pixels, stored row by row in a single contiguous buffer.
+  std::vector<Pixel> pixels_;
+
+ private:
+  // Extend the touched span of the row |y| to [x_min, x_max].
+  void Touch(int y, int x_min, int x_max) {
+    TouchedSpan& span = touched_[y];
+    if (span.IsEmpty()) {
+      touched_rows_.push_back(y);
+    }
+    span.x_min = std::min(span.x_min, x_min);
+    span.x_max = std::max(span.x_max, x_max);
+  }
+
+  std::vector<TouchedSpan> touched_;
+  // The rows whose span isn't empty, in the order they were touched. Clear()
+  // visits them only. Reserved for dimy_ rows.
+  std::vector<int> touched_rows_;
 };
 
 }  // namespace ftxui
@@ -0,0 +1,65 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_SCREEN_LIVE_CELL_HPP
+#define FTXUI_SCREEN_LIVE_CELL_HPP
+
+#include <functional>   // for function
+#include <mutex>        // for mutex
+#include <string_view>  // for string_view
+#include <vector>       // for vector
+
+#include "ftxui/screen/box.hpp"    // for Box
+#include "ftxui/screen/pixel.hpp"  // for Pixel
+
+namespace ftxui {
+
+class Image;
+
+/// @brief A row of cells updated at a high frequency, like a clock or a
+/// counter, without rendering the component tree again. See live().
+/// @ingroup screen
+///
+/// The element reserves the cells during the layout. Then, every Set(), from
+/// any thread, is written to the terminal by the ScreenInteractive displaying
+/// it, as a patch of these cells only.
+class LiveCell {
+ public:
+  explicit LiveCell(int width);
+
+  int width() const { return width_; }
+
+  // Display the glyphs of |text|, with the style of |style|. The cells left
+  // are blank, with the same style. Thread safe.
+  void Set(std::string_view text, const Pixel& style = Pixel());
+
+  // Draw the cells, from |x|,|y|, inside of |clip|. The pending update is
+  // consumed. Thread safe.
+  void Draw(Image& image, int x, int y, const Box& clip);
+
+  // Whether Set() was called since the last Draw().
+  bool Pending();
+
+  // Call |on_change| once Set() is called after a Draw(), or at once when it
+  // already was. Only the last |owner| is notified. It is called with the lock
+  // held: it must not call the LiveCell back.
+  void Watch(const void* owner, std::function<void()> on_change);
+  // Stop notifying |owner|. Once it returns, |owner| is no longer called.
+  void Unwatch(const void* owner);
+
+  // This class is non copyable: it is shared by the elements and the screens.
+  LiveCell(const LiveCell&) = delete;
+  LiveCell& operator=(const LiveCell&) = delete;
+
+ private:
+  const int width_;
+  std::mutex mutex_;
+  std::vector<Pixel> cells_;
+  bool pending_ = false;
+  const void* owner_ = nullptr;
+  std::function<void()> on_change_;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_SCREEN_LIVE_CELL_HPP
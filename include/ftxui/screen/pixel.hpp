@@ -4,7 +4,7 @@
 #ifndef FTXUI_SCREEN_PIXEL_HPP
 #define FTXUI_SCREEN_PIXEL_HPP
 
-#include <cstdint>                 // for uint8_t
+#include <cstdint>                 // for uint16_t
 #include <string>                  // for string, basic_string, allocator
 #include "ftxui/screen/color.hpp"  // for Color, Color::Default
 
@@ -36,15 +36,19 @@ struct Pixel {
   // The hyperlink associated with the pixel.
   // 0 is the default value, meaning no hyperlink.
   // It's an index for accessing Screen meta data
-  uint8_t hyperlink = 0;
-
-  // The graphemes stored into the pixel. To support combining characters,
-  // like: a?, this can potentially contain multiple codepoints.
-  std::string character = "";
+  uint16_t hyperlink = 0;
 
   // Colors:
+  // They are packed next to the style bits, ahead of the character, to avoid
+  // padding.
   Color background_color = Color::Default;
   Color foreground_color = Color::Default;
+
+  // The graphemes stored into the pixel. To support combining characters,
+  // like: a?, this can potentially contain multiple codepoints.
+  // Short graphemes, which are the vast majority, are stored inline by the
+  // small string optimization. Only long clusters use the heap.
+  std::string character = "";
 };
 
 }  // namespace ftxui
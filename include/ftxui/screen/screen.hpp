@@ -4,19 +4,27 @@
 #ifndef FTXUI_SCREEN_SCREEN_HPP
 #define FTXUI_SCREEN_SCREEN_HPP
 
-#include <cstdint>  // for uint8_t
-#include <string>   // for string, basic_string, allocator
-#include <vector>   // for vector
-
-#include "ftxui/screen/image.hpp"     // for Pixel, Image
-#include "ftxui/screen/terminal.hpp"  // for Dimensions
+#include <cstddef>        // for size_t
+#include <cstdint>        // for uint16_t, uint32_t
+#include <functional>     // for function
+#include <memory>         // for shared_ptr, weak_ptr
+#include <string>         // for string, basic_string, allocator
+#include <string_view>    // for string_view
+#include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
+
+#include "ftxui/screen/bitmap.hpp"     // for Bitmap
+#include "ftxui/screen/box.hpp"        // for Box
+#include "ftxui/screen/image.hpp"      // for Pixel, Image
+#include "ftxui/screen/live_cell.hpp"  // for LiveCell
+#include "ftxui/screen/terminal.hpp"   // for Dimensions
 
 namespace ftxui {
 
 struct PerfMeasure {
   void start();
   void end();
-  double measured; // last valid result
+  double measured = 0; // last valid result
   double _start, _end;
 };
 
@@ -37,6 +45,27 @@ class Screen : public Image {
   static Screen Create(Dimensions width, Dimensions height);
 
   std::string ToString() const;
+  void ToString(std::string& output) const;
+  std::string ToCompactString() const;
+  void ToCompactString(std::string& output) const;
+  // Call the function for every index in [0, count), possibly concurrently,
+  // and return once done. Like WorkerPool::ParallelFor.
+  using ParallelFor = std::function<void(
+      size_t count, const std::function<void(size_t)>& fn)>;
+  void ToString(std::string& output, const ParallelFor& parallel_for) const;
+  void ToCompactString(std::string& output,
+                       const ParallelFor& parallel_for) const;
+  std::string ToDiffString(const Screen& previous) const;
+  void ToDiffString(const Screen& previous, std::string& output) const;
+  // Append to |output| what writes the pixels of |box| again, from the cursor
+  // position left by ToString(), and back.
+  void ToPatchString(const Box& box, std::string& output) const;
+
+  // Compact binary snapshots of the pixels, for golden tests.
+  std::string ToSnapshot() const;
+  static bool FromSnapshot(std::string_view snapshot, Screen* screen);
+  // The rectangles covering the pixels drawn differently in |other|.
+  std::vector<Box> Diff(const Screen& other) const;
 
   // Print the Screen on to the terminal.
   void Print() const;
@@ -63,23 +92,85 @@ class Screen : public Image {
       BarBlinking = 5,
       Bar = 6,
     };
-    Shape shape;
+    Shape shape = Hidden;
   };
 
   Cursor cursor() const { return cursor_; }
   void SetCursor(Cursor cursor) { cursor_ = cursor; }
 
   // Store an hyperlink in the screen. Return the id of the hyperlink. The id is
-  // used to identify the hyperlink when the user click on it.
-  uint8_t RegisterHyperlink(const std::string& link);
-  const std::string& Hyperlink(uint8_t id) const;
+  // used to identify the hyperlink when the user click on it. Past 65535
+  // distinct hyperlinks, 0 is returned.
+  uint16_t RegisterHyperlink(const std::string& link);
+  const std::string& Hyperlink(uint16_t id) const;
+
+  // Place a bitmap over the cells of |box|. It is sent to the terminal after
+  // the cells, using Terminal::GraphicsSupport(). See imageBitmap().
+  struct BitmapPlacement {
+    std::shared_ptr<const Bitmap> bitmap;
+    Box box;
+  };
+  void PlaceBitmap(std::shared_ptr<const Bitmap> bitmap, const Box& box);
+  const std::vector<BitmapPlacement>& Bitmaps() const { return bitmaps_; }
+
+  // Place a live cell, drawn from |x|,|y|, over the cells of |box| it covers.
+  // ScreenInteractive writes its updates over them. See live().
+  struct LiveCellPlacement {
+    std::shared_ptr<LiveCell> cell;
+    int x;
+    int y;
+    Box box;
+  };
+  void PlaceLiveCell(std::shared_ptr<LiveCell> cell,
+                     int x,
+                     int y,
+                     const Box& box);
+  const std::vector<LiveCellPlacement>& LiveCells() const {
+    return live_cells_;
+  }
+
+  // Image::MemoryUsage() and Image::ShrinkToFit(), with the hyperlinks.
+  size_t MemoryUsage() const;
+  void ShrinkToFit();
 
   double LastFrameTime() const;
 
+  // The time spent by the last Render() in each of its phases, in seconds.
+  struct RenderTimings {
+    double layout = 0;  // Node::ComputeRequirement and Node::SetBox.
+    double draw = 0;    // Node::Render.
+    double shader = 0;  // Screen::ApplyShader.
+  };
+  const RenderTimings& LastRenderTimings() const { return render_timings_; }
+  void SetRenderTimings(const RenderTimings& timings) {
+    render_timings_ = timings;
+  }
+
  protected:
   PerfMeasure render_duration_;
+  RenderTimings render_timings_;
   Cursor cursor_;
   std::vector<std::string> hyperlinks_ = {""};
+  std::unordered_map<std::string, uint16_t> hyperlink_ids_;
+  std::vector<BitmapPlacement> bitmaps_;
+  std::vector<LiveCellPlacement> live_cells_;
+
+ private:
+  // The bitmaps displayed by the terminal, as of the last output.
+  struct PlacedBitmap {
+    uint32_t id;
+    int placement;  // The kitty placement id: 1 + earlier ones of the bitmap.
+    Box box;
+  };
+  void AppendBitmaps(bool full, std::string& output) const;
+  void AppendCells(const Box& box, std::string& output) const;
+  void AppendRows(int y_min, int y_max, std::string& output) const;
+  bool AppendCompactRows(int y_min, int y_max, std::string& output) const;
+  mutable std::vector<PlacedBitmap> placed_bitmaps_;
+  // The bitmaps transmitted with the kitty protocol, deleted from the
+  // terminal once destroyed.
+  mutable std::vector<std::pair<uint32_t, std::weak_ptr<const Bitmap>>>
+      transmitted_bitmaps_;
 };
 
 }  // namespace ftxui
@@ -4,8 +4,11 @@
 #ifndef FTXUI_SCREEN_STRING_HPP
 #define FTXUI_SCREEN_STRING_HPP
 
-#include <string>  // for string, wstring, to_string
-#include <vector>  // for vector
+#include <cstddef>      // for size_t, ptrdiff_t
+#include <iterator>     // for forward_iterator_tag
+#include <string>       // for string, wstring, to_string
+#include <string_view>  // for string_view
+#include <vector>       // for vector
 
 namespace ftxui {
 std::string to_string(const std::wstring& s);
@@ -16,12 +19,76 @@ std::wstring to_wstring(T s) {
   return to_wstring(std::to_string(s));
 }
 
-int string_width(const std::string&);
+int string_width(std::string_view);
 
 // Split the string into a its glyphs. An empty one is inserted ater fullwidth
 // ones.
 std::vector<std::string> Utf8ToGlyphs(const std::string& input);
 
+// A glyph of a string: a codepoint and the combining characters following it.
+struct Glyph {
+  std::string_view text;  // A view of the string iterated.
+  int width = 0;          // The number of cells it takes: 1 or 2.
+};
+
+// Iterate over the glyphs of |input|, without copying them. Control characters
+// are skipped. Unlike Utf8ToGlyphs(), fullwidth glyphs are not followed by an
+// empty one: their width is 2 instead.
+//
+// ### Example
+//
+// ```cpp
+// for (const Glyph& glyph : GlyphRange(text)) {
+//   ...
+// }
+// ```
+class GlyphRange {
+ public:
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Glyph;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Glyph*;
+    using reference = const Glyph&;
+
+    const Glyph& operator*() const { return glyph_; }
+    const Glyph* operator->() const { return &glyph_; }
+    Iterator& operator++() {
+      Advance();
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator previous = *this;
+      Advance();
+      return previous;
+    }
+    bool operator==(const Iterator& other) const {
+      return start_ == other.start_;
+    }
+    bool operator!=(const Iterator& other) const {
+      return start_ != other.start_;
+    }
+
+   private:
+    friend class GlyphRange;
+    Iterator(std::string_view input, size_t start);
+    void Advance();
+
+    std::string_view input_;
+    size_t start_ = 0;  // The start of |glyph_|.
+    size_t next_ = 0;   // The end of |glyph_|.
+    Glyph glyph_;
+  };
+
+  explicit GlyphRange(std::string_view input) : input_(input) {}
+  Iterator begin() const { return {input_, 0}; }
+  Iterator end() const { return {input_, input_.size()}; }
+
+ private:
+  std::string_view input_;
+};
+
 // Map every cells drawn by |input| to their corresponding Glyphs. Half-size
 // Glyphs takes one cell, full-size Glyphs take two cells.
 std::vector<int> CellToGlyphIndex(const std::string& input);
@@ -12,6 +12,7 @@ struct Dimensions {
 
 namespace Terminal {
 Dimensions Size();
+Dimensions Size(int fd);
 void SetFallbackSize(const Dimensions& fallbackSize);
 
 enum Color {
@@ -23,6 +24,17 @@ enum Color {
 Color ColorSupport();
 void SetColorSupport(Color color);
 
+bool RepeatSupport();
+void SetRepeatSupport(bool supported);
+
+enum class Graphics {
+  None,
+  Sixel,
+  Kitty,
+};
+Graphics GraphicsSupport();
+void SetGraphicsSupport(Graphics graphics);
+
 }  // namespace Terminal
 
 }  // namespace ftxui
@@ -7,6 +7,7 @@
 #include <ftxui/screen/string.hpp>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
@@ -172,7 +173,54 @@ class ConstStringListRef {
     return variant_ ? std::visit(IndexedGetter(i), *variant_) : "";
   }
 
+  // Access the |i|-th string without copying it. The std::wstring and the
+  // Adapter sources are converted into a cache owned by this object, reused
+  // while the source string doesn't change. The view is valid until the list
+  // or this object is modified.
+  std::string_view view(size_t i) const {
+    return variant_ ? std::visit(IndexedViewer{i, &cache_}, *variant_)
+                    : std::string_view();
+  }
+
  private:
+  struct Converted {
+    std::wstring source;
+    std::string value;
+  };
+
+  struct IndexedViewer {
+    size_t index_;
+    std::vector<Converted>* cache_;
+
+    Converted& Slot() const {
+      if (cache_->size() <= index_) {
+        cache_->resize(index_ + 1);
+      }
+      return (*cache_)[index_];
+    }
+
+    std::string_view operator()(const std::vector<std::string>& v) const {
+      return v[index_];
+    }
+    std::string_view operator()(const std::vector<std::string>* v) const {
+      return (*v)[index_];
+    }
+    std::string_view operator()(const std::vector<std::wstring>* v) const {
+      Converted& slot = Slot();
+      if (slot.value.empty() || slot.source != (*v)[index_]) {
+        slot.source = (*v)[index_];
+        slot.value = to_string(slot.source);
+      }
+      return slot.value;
+    }
+    std::string_view operator()(const Adapter* v) const {
+      return Slot().value = (*v)[index_];
+    }
+    std::string_view operator()(const std::unique_ptr<Adapter>& v) const {
+      return Slot().value = (*v)[index_];
+    }
+  };
+
   struct SizeVisitor {
     size_t operator()(const std::vector<std::string>& v) const {
       return v.size();
@@ -209,6 +257,7 @@ class ConstStringListRef {
   };
 
   std::shared_ptr<Variant> variant_;
+  mutable std::vector<Converted> cache_;
 };
 
 }  // namespace ftxui
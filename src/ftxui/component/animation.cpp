@@ -1,5 +1,8 @@
-#include <cmath>    // for sin, pow, sqrt, cos
-#include <utility>  // for move
+#include <algorithm>  // for min
+#include <cmath>      // for sin, pow, sqrt, cos
+#include <cstddef>    // for size_t
+#include <iterator>   // for next
+#include <utility>    // for move
 
 #include "ftxui/component/animation.hpp"
 
@@ -264,6 +267,57 @@ Animator::Animator(float* from,
   RequestAnimationFrame();
 }
 
+namespace {
+
+// Apply |F| to every value. |F| being known at compile time, it is inlined
+// and the loop vectorized.
+template <float (*F)(float)>
+void BatchEasing(float* p, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    p[i] = F(p[i]);  // NOLINT
+  }
+}
+
+using BatchFunction = void (*)(float*, size_t);
+
+// Return the batch implementation of |function|, or nullptr if it isn't one
+// of the polynomial easing functions.
+BatchFunction FindBatchEasing(const easing::Function& function) {
+  using Pointer = float (*)(float);
+  const Pointer* pointer = function.target<Pointer>();
+  if (pointer == nullptr) {
+    return nullptr;
+  }
+
+  struct Entry {
+    Pointer function;
+    BatchFunction batch;
+  };
+  static const Entry entries[] = {
+      {easing::Linear, BatchEasing<easing::Linear>},
+      {easing::QuadraticIn, BatchEasing<easing::QuadraticIn>},
+      {easing::QuadraticOut, BatchEasing<easing::QuadraticOut>},
+      {easing::QuadraticInOut, BatchEasing<easing::QuadraticInOut>},
+      {easing::CubicIn, BatchEasing<easing::CubicIn>},
+      {easing::CubicOut, BatchEasing<easing::CubicOut>},
+      {easing::CubicInOut, BatchEasing<easing::CubicInOut>},
+      {easing::QuarticIn, BatchEasing<easing::QuarticIn>},
+      {easing::QuarticOut, BatchEasing<easing::QuarticOut>},
+      {easing::QuarticInOut, BatchEasing<easing::QuarticInOut>},
+      {easing::QuinticIn, BatchEasing<easing::QuinticIn>},
+      {easing::QuinticOut, BatchEasing<easing::QuinticOut>},
+      {easing::QuinticInOut, BatchEasing<easing::QuinticInOut>},
+  };
+  for (const auto& entry : entries) {
+    if (*pointer == entry.function) {
+      return entry.batch;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
 void Animator::OnAnimation(Params& params) {
   current_ += params.duration();
 
@@ -281,6 +335,131 @@ void Animator::OnAnimation(Params& params) {
   RequestAnimationFrame();
 }
 
+AnimatorArray::AnimatorArray(Duration duration,
+                             easing::Function easing_function)
+    : duration_(duration) {
+  SetEasing(std::move(easing_function));
+}
+
+void AnimatorArray::SetDuration(Duration duration) {
+  duration_ = duration;
+}
+
+void AnimatorArray::SetEasing(easing::Function easing_function) {
+  easing_function_ = std::move(easing_function);
+  batch_easing_ = FindBatchEasing(easing_function_);
+}
+
+void AnimatorArray::Resize(size_t size) {
+  for (size_t slot = index_.size(); slot-- > 0;) {
+    if (index_[slot] >= size) {
+      Remove(slot);
+    }
+  }
+  for (auto it = rest_.begin(); it != rest_.end();) {
+    it = it->first >= size ? rest_.erase(it) : std::next(it);
+  }
+  size_ = size;
+}
+
+float AnimatorArray::value(size_t i) const {
+  const auto slot = slot_.find(i);
+  if (slot != slot_.end()) {
+    return value_[slot->second];
+  }
+  const auto rest = rest_.find(i);
+  return rest == rest_.end() ? 0.f : rest->second;
+}
+
+float AnimatorArray::to(size_t i) const {
+  const auto slot = slot_.find(i);
+  if (slot != slot_.end()) {
+    return to_[slot->second];
+  }
+  const auto rest = rest_.find(i);
+  return rest == rest_.end() ? 0.f : rest->second;
+}
+
+void AnimatorArray::AnimateTo(size_t i, float to) {
+  const float from = value(i);
+  auto [it, inserted] = slot_.emplace(i, int(index_.size()));
+  const int slot = it->second;
+  if (inserted) {
+    rest_.erase(i);
+    index_.push_back(i);
+    value_.push_back(from);
+    from_.push_back(0.f);
+    to_.push_back(0.f);
+    elapsed_.push_back(0.f);
+  }
+  from_[slot] = from;
+  to_[slot] = to;
+  elapsed_[slot] = 0.f;
+  RequestAnimationFrame();
+}
+
+void AnimatorArray::OnAnimation(Params& params) {
+  const size_t size = index_.size();
+  if (size == 0) {
+    return;
+  }
+
+  const float delta = params.duration().count();
+  const float duration = duration_.count();
+  progress_.resize(size);
+  for (size_t slot = 0; slot < size; ++slot) {
+    elapsed_[slot] += delta;
+    progress_[slot] =
+        duration > 0.f ? std::min(1.f, elapsed_[slot] / duration) : 1.f;
+  }
+
+  if (batch_easing_ != nullptr) {
+    batch_easing_(progress_.data(), size);
+  } else {
+    for (size_t slot = 0; slot < size; ++slot) {
+      progress_[slot] = easing_function_(progress_[slot]);
+    }
+  }
+
+  for (size_t slot = 0; slot < size; ++slot) {
+    value_[slot] = from_[slot] + (to_[slot] - from_[slot]) * progress_[slot];
+  }
+
+  // Remove the completed animations. They end exactly on their target.
+  for (size_t slot = size; slot-- > 0;) {
+    if (elapsed_[slot] >= duration) {
+      if (to_[slot] != 0.f) {
+        rest_[index_[slot]] = to_[slot];
+      }
+      Remove(slot);
+    }
+  }
+
+  if (!index_.empty()) {
+    RequestAnimationFrame();
+  }
+}
+
+// Remove the animation in flight at |slot|, by moving the last one in its
+// place.
+void AnimatorArray::Remove(size_t slot) {
+  const size_t last = index_.size() - 1;
+  slot_.erase(index_[slot]);
+  if (slot != last) {
+    index_[slot] = index_[last];
+    value_[slot] = value_[last];
+    from_[slot] = from_[last];
+    to_[slot] = to_[last];
+    elapsed_[slot] = elapsed_[last];
+    slot_[index_[slot]] = int(slot);
+  }
+  index_.pop_back();
+  value_.pop_back();
+  from_.pop_back();
+  to_.pop_back();
+  elapsed_.pop_back();
+}
+
 }  // namespace ftxui::animation
 
 // NOLINTEND(*-magic-numbers)
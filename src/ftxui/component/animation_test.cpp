@@ -3,6 +3,7 @@
 // the LICENSE file.
 
 #include <gtest/gtest.h>
+#include <chrono>      // for milliseconds
 #include <functional>  // for function
 #include <vector>      // for allocator, vector
 
@@ -35,4 +36,89 @@ TEST(AnimationTest, StartAndEnd) {
   }
 }
 
+TEST(AnimationTest, AnimatorArrayMatchesAnimator) {
+  const std::vector<animation::easing::Function> functions = {
+      animation::easing::Linear,
+      animation::easing::QuadraticInOut,
+      animation::easing::QuinticOut,
+      animation::easing::BackOut,  // Not applied by batch.
+      [](float p) { return p * 0.5F; },
+  };
+  const auto duration = std::chrono::milliseconds(100);
+  const animation::Duration step = std::chrono::milliseconds(15);
+  for (const auto& function : functions) {
+    animation::AnimatorArray array(duration, function);
+    array.Resize(3);
+    array.AnimateTo(1, 2.F);
+
+    float value = 0.F;
+    animation::Animator animator(&value, 2.F, duration, function);
+    for (int i = 0; i < 10; ++i) {
+      animation::Params params(step);
+      array.OnAnimation(params);
+      animator.OnAnimation(params);
+      EXPECT_NEAR(array.value(1), value, 1.0e-5);
+      EXPECT_EQ(array.value(0), 0.F);
+      EXPECT_EQ(array.value(2), 0.F);
+    }
+    EXPECT_EQ(array.value(1), 2.F);
+  }
+}
+
+TEST(AnimationTest, AnimatorArrayRetarget) {
+  animation::AnimatorArray array(std::chrono::milliseconds(100));
+  array.Resize(2);
+  EXPECT_EQ(array.to(0), 0.F);
+
+  array.AnimateTo(0, 1.F);
+  array.AnimateTo(1, 1.F);
+  EXPECT_EQ(array.to(0), 1.F);
+  animation::Params params(std::chrono::milliseconds(50));
+  array.OnAnimation(params);
+  EXPECT_NEAR(array.value(0), 0.5F, 1.0e-5);
+
+  // The new animation starts from the current value.
+  array.AnimateTo(0, 0.F);
+  array.OnAnimation(params);
+  EXPECT_NEAR(array.value(0), 0.25F, 1.0e-5);
+  EXPECT_EQ(array.value(1), 1.F);
+  array.OnAnimation(params);
+  EXPECT_EQ(array.value(0), 0.F);
+
+  // Shrinking drops the animations in flight.
+  array.AnimateTo(1, 3.F);
+  array.Resize(1);
+  array.Resize(2);
+  EXPECT_EQ(array.value(1), 0.F);
+  EXPECT_EQ(array.to(1), 0.F);
+}
+
+TEST(AnimationTest, AnimatorArraySparse) {
+  // Only the values other than zero are stored.
+  animation::AnimatorArray array(std::chrono::milliseconds(100));
+  array.Resize(1'000'000'000);
+  EXPECT_EQ(array.size(), 1'000'000'000);
+  array.AnimateTo(123'456'789, 1.F);
+  animation::Params params(std::chrono::milliseconds(100));
+  array.OnAnimation(params);
+  EXPECT_EQ(array.value(123'456'789), 1.F);
+  EXPECT_EQ(array.to(123'456'789), 1.F);
+  EXPECT_EQ(array.value(123'456'790), 0.F);
+
+  // The new animation starts from the value at rest.
+  array.AnimateTo(123'456'789, 0.F);
+  animation::Params half(std::chrono::milliseconds(50));
+  array.OnAnimation(half);
+  EXPECT_NEAR(array.value(123'456'789), 0.5F, 1.0e-5);
+  array.OnAnimation(half);
+  EXPECT_EQ(array.value(123'456'789), 0.F);
+
+  // Shrinking drops the values at rest too.
+  array.AnimateTo(7, 2.F);
+  array.OnAnimation(params);
+  array.Resize(5);
+  array.Resize(10);
+  EXPECT_EQ(array.value(7), 0.F);
+}
+
 }  // namespace ftxui
@@ -0,0 +1,235 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/component/async_data_source.hpp"
+
+#include <algorithm>           // for max, min
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <cstdint>             // for int64_t
+#include <deque>               // for deque
+#include <memory>  // for make_shared, shared_ptr, weak_ptr, enable_shared_from_this
+#include <mutex>               // for mutex, unique_lock, lock_guard
+#include <set>                 // for set
+#include <thread>              // for thread
+#include <utility>             // for move
+
+#include "ftxui/component/component_options.hpp"  // for DataSource, DSRenderContext
+#include "ftxui/component/event.hpp"              // for Event
+#include "ftxui/component/screen_interactive.hpp"  // for ScreenInteractive
+#include "ftxui/dom/elements.hpp"                  // for Element, text, dim
+
+namespace ftxui {
+
+class AsyncDataSource::Impl : public std::enable_shared_from_this<Impl> {
+ public:
+  Impl(DataSource* source, AsyncDataSourceOption option)
+      : source_(source), option_(std::move(option)) {
+    option_.page_size = std::max<int64_t>(1, option_.page_size);
+    option_.prefetch_pages = std::max(0, option_.prefetch_pages);
+    if (!option_.placeholder) {
+      option_.placeholder = [](DSRenderContext& /*context*/) {
+        return text("...") | dim;
+      };
+    }
+  }
+
+  void Start() { worker_ = std::thread(&Impl::Worker, this); }
+
+  void Stop() {
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      quit_ = true;
+    }
+    notifier_.notify_one();
+    if (worker_.joinable()) {
+      worker_.join();
+    }
+  }
+
+  // Called from the UI thread.
+  Element Transform(DSRenderContext& context) {
+    const int64_t page = ToIndex(context.id) / option_.page_size;
+    Prefetch();
+    if (IsPageFetched(page)) {
+      return option_.transform(context);
+    }
+    Request(page, /*urgent=*/true);
+    return option_.placeholder(context);
+  }
+
+  bool IsFetched(int64_t id) const {
+    return IsPageFetched(ToIndex(id) / option_.page_size);
+  }
+
+  void Invalidate() {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    fetched_.clear();
+    generation_++;
+    last_focused_page_ = -1;
+  }
+
+ private:
+  int64_t ToIndex(int64_t id) const {
+    return source_->id_to_index ? source_->id_to_index(id) : id;
+  }
+
+  bool IsPageFetched(int64_t page) const {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return fetched_.count(page) != 0;
+  }
+
+  // Fetch the pages around the focused item, starting with the scroll
+  // direction.
+  void Prefetch() {
+    const int64_t page = ToIndex(source_->focused_id) / option_.page_size;
+    if (page == last_focused_page_) {
+      return;
+    }
+    const int64_t direction = page >= last_focused_page_ ? 1 : -1;
+    last_focused_page_ = page;
+    for (int i = 1; i <= option_.prefetch_pages; ++i) {
+      Request(page + direction * i, /*urgent=*/false);
+    }
+    for (int i = 1; i <= option_.prefetch_pages; ++i) {
+      Request(page - direction * i, /*urgent=*/false);
+    }
+  }
+
+  void Request(int64_t page, bool urgent) {
+    const int64_t total = source_->dataset_size().total;
+    if (page < 0 || page * option_.page_size >= total) {
+      return;
+    }
+    ScreenInteractive* screen = ScreenInteractive::Active();
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      total_ = total;
+      if (screen != nullptr) {
+        screen_ = screen;
+      }
+      if (fetched_.count(page) != 0 || requested_.count(page) != 0) {
+        return;
+      }
+      requested_.insert(page);
+      if (urgent) {
+        queue_.push_front(page);
+      } else {
+        queue_.push_back(page);
+      }
+
+      // Drop the pages requested long ago. They are no longer displayed, or
+      // will be requested again.
+      const size_t max_queue = 4 * size_t(option_.prefetch_pages) + 8;
+      while (queue_.size() > max_queue) {
+        requested_.erase(queue_.back());
+        queue_.pop_back();
+      }
+    }
+    notifier_.notify_one();
+  }
+
+  void Worker() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      notifier_.wait(lock, [this] { return quit_ || !queue_.empty(); });
+      if (quit_) {
+        return;
+      }
+      const int64_t page = queue_.front();
+      queue_.pop_front();
+      const int generation = generation_;
+      const int64_t first = page * option_.page_size;
+      const int64_t count = std::min(option_.page_size, total_ - first);
+
+      if (count > 0) {
+        lock.unlock();
+        option_.fetch(first, count);
+        lock.lock();
+      }
+
+      requested_.erase(page);
+      if (generation == generation_) {
+        fetched_.insert(page);
+      }
+      if (screen_ != nullptr) {
+        // The rows cached by DBMenu are placeholders. Invalidate them, from
+        // the UI thread.
+        std::weak_ptr<Impl> weak = weak_from_this();
+        screen_->Post([weak] {
+          if (auto impl = weak.lock()) {
+            impl->source_->invalidate_rows();
+          }
+        });
+        screen_->PostEvent(Event::Custom);
+      }
+    }
+  }
+
+  DataSource* source_;
+  AsyncDataSourceOption option_;
+
+  // Owned by the UI thread:
+  int64_t last_focused_page_ = -1;
+
+  // Guarded by |mutex_|:
+  mutable std::mutex mutex_;
+  std::condition_variable notifier_;
+  std::deque<int64_t> queue_;
+  std::set<int64_t> requested_;
+  std::set<int64_t> fetched_;
+  int generation_ = 0;
+  int64_t total_ = 0;
+  bool quit_ = false;
+  ScreenInteractive* screen_ = nullptr;
+
+  std::thread worker_;
+};
+
+/// @brief Make |source| fetch its items asynchronously, on a worker thread.
+/// @param source The DataSource. Its |transform| is replaced. It must outlive
+/// this object.
+/// @param option The fetch function, and how to display the items.
+/// @ingroup component
+///
+/// ### Example
+///
+/// ```cpp
+/// DataSource source;
+/// source.dataset_size = ...;
+/// source.move_id_by = ...;
+/// AsyncDataSource async(&source, {
+///   .fetch = [&](int64_t first, int64_t count) { cache.Load(first, count); },
+///   .transform = [&](DSRenderContext& c) { return text(cache.At(c.id)); },
+/// });
+/// auto menu = DBMenu(&source);
+/// ```
+AsyncDataSource::AsyncDataSource(DataSource* source,
+                                 AsyncDataSourceOption option)
+    : impl_(std::make_shared<Impl>(source, std::move(option))) {
+  std::weak_ptr<Impl> weak = impl_;
+  source->transform = [weak](DSRenderContext& context) -> Element {
+    auto impl = weak.lock();
+    return impl ? impl->Transform(context) : text("");
+  };
+  impl_->Start();
+}
+
+AsyncDataSource::~AsyncDataSource() {
+  impl_->Stop();
+}
+
+/// @brief Forget about every page fetched. They are fetched again when
+/// displayed. Call this when the underlying data changes.
+/// @ingroup component
+void AsyncDataSource::Invalidate() {
+  impl_->Invalidate();
+}
+
+/// @brief Whether the item |id| has been fetched.
+/// @ingroup component
+bool AsyncDataSource::IsFetched(int64_t id) const {
+  return impl_->IsFetched(id);
+}
+
+}  // namespace ftxui
@@ -0,0 +1,111 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <algorithm>   // for max, min
+#include <atomic>      // for atomic
+#include <chrono>      // for milliseconds, steady_clock
+#include <cstdint>     // for int64_t
+#include <functional>  // for function
+#include <mutex>       // for mutex, lock_guard
+#include <string>      // for to_string
+#include <thread>      // for sleep_for
+#include <vector>      // for vector
+
+#include "ftxui/component/async_data_source.hpp"  // for AsyncDataSource
+#include "ftxui/component/component.hpp"           // for DBMenu
+#include "ftxui/component/component_options.hpp"  // for DataSource
+#include "ftxui/dom/elements.hpp"                  // for text
+#include "ftxui/dom/node.hpp"                      // for Render
+#include "ftxui/screen/screen.hpp"                 // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+
+bool WaitFor(const std::function<bool()>& condition) {
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!condition()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST(AsyncDataSourceTest, Placeholder) {
+  const int64_t size = 1000;
+  std::mutex mutex;
+  std::vector<int64_t> fetched;
+  std::vector<std::string> storage(size);
+  std::atomic<bool> release{false};
+
+  DataSource source;
+  source.dataset_size = [&] { return DataSize{size, 0, size - 1}; };
+  source.move_id_by = [&](int64_t& id, int64_t offset) {
+    const int64_t initial = id;
+    id = std::max<int64_t>(0, std::min(id + offset, size - 1));
+    return id != initial;
+  };
+
+  AsyncDataSourceOption option;
+  option.page_size = 10;
+  option.prefetch_pages = 1;
+  option.fetch = [&](int64_t first, int64_t count) {
+    // Hold the first fetches, until the placeholders are checked.
+    WaitFor([&] { return release.load(); });
+    const std::lock_guard<std::mutex> lock(mutex);
+    fetched.push_back(first);
+    for (int64_t i = first; i < first + count; ++i) {
+      storage[i] = std::to_string(i);
+    }
+  };
+  option.transform = [&](DSRenderContext& context) {
+    return text(storage[context.id]);
+  };
+  option.placeholder = [](DSRenderContext&) { return text("~"); };
+  AsyncDataSource async(&source, option);
+  auto menu = DBMenu(&source);
+
+  Screen screen(4, 3);
+  Render(screen, menu->Render());
+  EXPECT_EQ(screen.ToString(), "~   \r\n~   \r\n~   ");
+  release = true;
+
+  // The visible page, and the next one are fetched.
+  ASSERT_TRUE(WaitFor([&] { return async.IsFetched(0); }));
+  ASSERT_TRUE(WaitFor([&] { return async.IsFetched(10); }));
+  EXPECT_FALSE(async.IsFetched(20));
+
+  Render(screen, menu->Render());
+  EXPECT_EQ(screen.ToString(), "0   \r\n1   \r\n2   ");
+
+  // Jump far away.
+  source.focused_id = 500;
+  Render(screen, menu->Render());
+  ASSERT_TRUE(WaitFor([&] { return async.IsFetched(500); }));
+  ASSERT_TRUE(WaitFor([&] { return async.IsFetched(510); }));
+  ASSERT_TRUE(WaitFor([&] { return async.IsFetched(490); }));
+
+  Render(screen, menu->Render());
+  EXPECT_EQ(screen.ToString(), "499 \r\n500 \r\n501 ");
+
+  // Invalidated pages are fetched again.
+  async.Invalidate();
+  EXPECT_FALSE(async.IsFetched(500));
+  Render(screen, menu->Render());
+  ASSERT_TRUE(WaitFor([&] { return async.IsFetched(500); }));
+
+  const std::lock_guard<std::mutex> lock(mutex);
+  for (int64_t first : fetched) {
+    EXPECT_EQ(first % 10, 0);
+  }
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -0,0 +1,265 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <atomic>              // for atomic
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <functional>          // for function
+#include <memory>              // for make_shared, shared_ptr
+#include <mutex>               // for mutex, unique_lock, lock_guard
+#include <thread>              // for thread
+#include <utility>             // for move
+
+#include "ftxui/component/component.hpp"  // for Async, AsyncRenderer, Make
+#include "ftxui/component/component_base.hpp"  // for ComponentBase
+#include "ftxui/component/component_options.hpp"  // for AsyncOption, AsyncRendererOption
+#include "ftxui/component/event.hpp"               // for Event
+#include "ftxui/component/screen_interactive.hpp"  // for ScreenInteractive
+#include "ftxui/dom/elements.hpp"                  // for Element, text
+
+namespace ftxui {
+
+namespace {
+
+class AsyncRendererBase : public ComponentBase {
+ public:
+  explicit AsyncRendererBase(AsyncRendererOption option)
+      : option_(std::move(option)) {
+    worker_ = std::thread(&AsyncRendererBase::Worker, this);
+  }
+
+  ~AsyncRendererBase() override {
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      quit_ = true;
+    }
+    notifier_.notify_one();
+    worker_.join();
+  }
+
+  AsyncRendererBase(const AsyncRendererBase&) = delete;
+  AsyncRendererBase& operator=(const AsyncRendererBase&) = delete;
+
+ private:
+  Element Render() override {
+    const size_t version = option_.version ? option_.version() : 0;
+    ScreenInteractive* screen = ScreenInteractive::Active();
+    bool requested = false;
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      if (screen != nullptr) {
+        screen_ = screen;
+      }
+      if (!requested_ || version != requested_version_) {
+        requested_ = true;
+        requested_version_ = version;
+        pending_ = true;
+        requested = true;
+      }
+      // Adopt the latest element built. The previous one is released here.
+      if (ready_) {
+        element_ = std::move(ready_);
+      }
+    }
+    if (requested) {
+      notifier_.notify_one();
+    }
+
+    if (element_) {
+      return element_;
+    }
+    return option_.placeholder ? option_.placeholder() : text("");
+  }
+
+  void Worker() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      notifier_.wait(lock, [this] { return quit_ || pending_; });
+      if (quit_) {
+        return;
+      }
+      pending_ = false;
+
+      lock.unlock();
+      Element element = option_.build ? option_.build() : text("");
+      lock.lock();
+
+      // An element built but never adopted is released by this thread.
+      ready_ = std::move(element);
+      if (screen_ != nullptr) {
+        screen_->PostEvent(Event::Custom);
+      }
+    }
+  }
+
+  AsyncRendererOption option_;
+
+  // Owned by the UI thread:
+  Element element_;
+
+  // Guarded by |mutex_|:
+  std::mutex mutex_;
+  std::condition_variable notifier_;
+  bool requested_ = false;
+  size_t requested_version_ = 0;
+  bool pending_ = false;
+  bool quit_ = false;
+  Element ready_;
+  ScreenInteractive* screen_ = nullptr;
+
+  std::thread worker_;
+};
+
+// The state shared by an Async component and its fetches in flight. A fetch
+// finishing after the component is destroyed finds it cancelled.
+struct AsyncState {
+  std::mutex mutex;
+  std::function<Element()> result;
+  ScreenInteractive* screen = nullptr;
+};
+
+class AsyncBase : public ComponentBase {
+ public:
+  explicit AsyncBase(AsyncOption option) : option_(std::move(option)) {
+    if (!option_.executor) {
+      option_.executor = [](std::function<void()> job) {
+        if (ScreenInteractive* screen = ScreenInteractive::Active()) {
+          screen->RunInBackground(std::move(job));
+        } else {
+          std::thread(std::move(job)).detach();
+        }
+      };
+    }
+  }
+
+  ~AsyncBase() override { Cancel(); }
+
+ private:
+  Element Render() override {
+    const size_t version = option_.version ? option_.version() : 0;
+    if (!requested_ || version != requested_version_) {
+      requested_ = true;
+      requested_version_ = version;
+      Fetch();
+    }
+
+    {
+      const std::lock_guard<std::mutex> lock(state_->mutex);
+      if (ScreenInteractive* screen = ScreenInteractive::Active()) {
+        state_->screen = screen;
+      }
+      if (state_->result) {
+        display_ = std::move(state_->result);
+        state_->result = nullptr;
+      }
+    }
+
+    if (display_) {
+      return display_();
+    }
+    return option_.placeholder ? option_.placeholder() : text("");
+  }
+
+  // The data is fetched again when displayed again.
+  void OnHide() override {
+    if (fetching_ && !*fetching_) {
+      Cancel();
+      requested_ = false;
+    }
+    ComponentBase::OnHide();
+  }
+
+  void Fetch() {
+    Cancel();
+    auto cancelled = std::make_shared<std::atomic<bool>>(false);
+    fetching_ = cancelled;
+    option_.executor([state = state_, cancelled, fetch = option_.fetch] {
+      std::function<Element()> result = fetch(*cancelled);
+      const std::lock_guard<std::mutex> lock(state->mutex);
+      if (*cancelled) {
+        return;
+      }
+      // Done: cancelling it has no effect anymore.
+      *cancelled = true;
+      state->result = std::move(result);
+      if (state->screen != nullptr) {
+        state->screen->PostEvent(Event::Custom);
+      }
+    });
+  }
+
+  // Cancel the fetch in flight, if any. Its result is dropped.
+  void Cancel() {
+    if (!fetching_) {
+      return;
+    }
+    const std::lock_guard<std::mutex> lock(state_->mutex);
+    *fetching_ = true;
+    fetching_.reset();
+  }
+
+  AsyncOption option_;
+  std::shared_ptr<AsyncState> state_ = std::make_shared<AsyncState>();
+  // Set once the fetch in flight is done or cancelled.
+  std::shared_ptr<std::atomic<bool>> fetching_;
+  bool requested_ = false;
+  size_t requested_version_ = 0;
+  std::function<Element()> display_;
+};
+
+}  // namespace
+
+/// @brief A Renderer building its element on a worker thread. The
+/// placeholder is displayed until the first element is built. Afterward, the
+/// last element built is displayed, until the next one is ready. Once built,
+/// the active ScreenInteractive is asked to redraw.
+///
+/// This keeps the expensive elements, like large tables or highlighted code,
+/// from blocking the events. The functions building elements can be called from
+/// any thread: they don't share any mutable state, beside thread safe caches.
+/// The components and the screen can't be used from the worker thread.
+/// @param option The function building the element, when to build it again,
+/// and the placeholder.
+/// @ingroup component
+///
+/// ### Example
+///
+/// ```cpp
+/// auto code = AsyncRenderer({
+///     .build = [snapshot] { return Highlight(*snapshot); },
+/// });
+/// ```
+Component AsyncRenderer(AsyncRendererOption option) {
+  return Make<AsyncRendererBase>(std::move(option));
+}
+
+/// @brief A component fetching its data asynchronously, on an executor, and
+/// displaying it once fetched. The placeholder is displayed until the first
+/// data arrives. Afterward, the last data fetched is displayed, until the next
+/// one arrives. Once fetched, the active ScreenInteractive is asked to redraw.
+///
+/// The fetch in flight is cancelled when the component is hidden by Maybe,
+/// detached, or destroyed, and when the version changes. Its result is then
+/// dropped. Once hidden, the data is fetched again when displayed again.
+/// @param option The fetch function, when to fetch again, the placeholder and
+/// the executor.
+/// @ingroup component
+///
+/// ### Example
+///
+/// ```cpp
+/// auto status = Async({
+///     .fetch = [](const std::atomic<bool>& cancelled)
+///         -> std::function<Element()> {
+///       std::vector<std::string> lines = QueryServices(cancelled);
+///       return [lines] { return vbox(Text(lines)); };
+///     },
+///     .version = [&] { return refresh_count; },
+///     .executor = [&](std::function<void()> job) { pool.Run(job); },
+/// });
+/// ```
+Component Async(AsyncOption option) {
+  return Make<AsyncBase>(std::move(option));
+}
+
+}  // namespace ftxui
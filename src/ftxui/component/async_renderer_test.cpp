@@ -0,0 +1,192 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <atomic>      // for atomic
+#include <chrono>      // for milliseconds
+#include <functional>  // for function
+#include <string>      // for string, to_string
+#include <thread>      // for this_thread, thread::id
+#include <vector>      // for vector
+
+#include "ftxui/component/component.hpp"  // for Async, AsyncRenderer, Maybe
+#include "ftxui/component/component_options.hpp"  // for AsyncOption, AsyncRendererOption
+#include "ftxui/component/screen_interactive.hpp"  // for ScreenInteractive
+#include "ftxui/dom/elements.hpp"                  // for text, Element
+#include "ftxui/dom/node.hpp"                      // for Render
+#include "ftxui/screen/screen.hpp"                 // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+std::string Draw(Component component) {
+  Screen screen(5, 1);
+  Render(screen, component->Render());
+  return screen.ToString();
+}
+
+// Render |component| until it displays something else than |previous|.
+std::string DrawNext(Component component, const std::string& previous) {
+  for (int i = 0; i < 1000; ++i) {
+    const std::string drawn = Draw(component);
+    if (drawn != previous) {
+      return drawn;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return previous;
+}
+}  // namespace
+
+TEST(AsyncRendererTest, Placeholder) {
+  std::atomic<bool> release = false;
+  std::thread::id build_thread;
+  auto component = AsyncRenderer({
+      .build =
+          [&] {
+            while (!release) {
+              std::this_thread::yield();
+            }
+            build_thread = std::this_thread::get_id();
+            return text("built");
+          },
+      .version = nullptr,
+  });
+
+  // Displayed while the element is being built.
+  const std::string placeholder = Draw(component);
+  EXPECT_NE(placeholder.find("..."), std::string::npos);
+  release = true;
+  EXPECT_EQ(DrawNext(component, placeholder), "built");
+  EXPECT_NE(build_thread, std::this_thread::get_id());
+}
+
+TEST(AsyncRendererTest, Version) {
+  std::atomic<int> data = 1;
+  int version = 1;
+  auto component = AsyncRenderer({
+      .build = [&] { return text(std::to_string(data)); },
+      .version = [&] { return size_t(version); },
+      .placeholder = [] { return text("wait"); },
+  });
+  EXPECT_EQ(DrawNext(component, "wait "), "1    ");
+
+  // Not built again until the version changes.
+  data = 2;
+  EXPECT_EQ(Draw(component), "1    ");
+  version = 2;
+  EXPECT_EQ(DrawNext(component, "1    "), "2    ");
+}
+
+TEST(AsyncRendererTest, Redraw) {
+  auto screen = ScreenInteractive::FitComponent();
+  auto component = AsyncRenderer({
+      .build = [] { return text("built"); },
+      .version = nullptr,
+  });
+  int draws = 0;
+  auto renderer = Renderer(component, [&] {
+    Element element = component->Render();
+    Screen drawn(5, 1);
+    Render(drawn, element);
+    draws++;
+    if (drawn.ToString() == "built") {
+      screen.Exit();
+    }
+    return element;
+  });
+
+  // The screen is redrawn once the element is built, without any event.
+  screen.Loop(renderer);
+  EXPECT_GE(draws, 2);
+}
+
+namespace {
+// An executor running the jobs when asked to.
+struct ManualExecutor {
+  std::vector<std::function<void()>> jobs;
+  std::function<void(std::function<void()>)> Get() {
+    return [this](std::function<void()> job) { jobs.push_back(job); };
+  }
+};
+}  // namespace
+
+TEST(AsyncTest, Fetch) {
+  ManualExecutor executor;
+  int version = 0;
+  int fetched = 0;
+  auto component = Async({
+      .fetch = [&](const std::atomic<bool>&) -> std::function<Element()> {
+        const std::string data = std::to_string(++fetched);
+        return [data] { return text(data); };
+      },
+      .version = [&] { return size_t(version); },
+      .placeholder = [] { return text("wait"); },
+      .executor = executor.Get(),
+  });
+
+  EXPECT_EQ(Draw(component), "wait ");
+  ASSERT_EQ(executor.jobs.size(), 1u);
+  executor.jobs[0]();
+  EXPECT_EQ(Draw(component), "1    ");
+
+  // Fetched again once the version changes. The previous data is displayed
+  // meanwhile.
+  version++;
+  EXPECT_EQ(Draw(component), "1    ");
+  ASSERT_EQ(executor.jobs.size(), 2u);
+  executor.jobs[1]();
+  EXPECT_EQ(Draw(component), "2    ");
+}
+
+TEST(AsyncTest, CancelledWhenHidden) {
+  ManualExecutor executor;
+  std::vector<bool> cancelled;
+  auto component = Async({
+      .fetch = [&](const std::atomic<bool>& c) -> std::function<Element()> {
+        cancelled.push_back(c);
+        return [] { return text("data"); };
+      },
+      .version = nullptr,
+      .placeholder = [] { return text("wait"); },
+      .executor = executor.Get(),
+  });
+  bool show = true;
+  auto maybe = Maybe(component, &show);
+
+  EXPECT_EQ(Draw(maybe), "wait ");
+  show = false;
+  EXPECT_EQ(Draw(maybe), "     ");
+  executor.jobs[0]();
+  EXPECT_EQ(cancelled, std::vector<bool>{true});
+
+  // Fetched again once displayed again.
+  show = true;
+  EXPECT_EQ(Draw(maybe), "wait ");
+  ASSERT_EQ(executor.jobs.size(), 2u);
+  executor.jobs[1]();
+  EXPECT_EQ(Draw(maybe), "data ");
+}
+
+TEST(AsyncTest, CancelledWhenDestroyed) {
+  ManualExecutor executor;
+  bool cancelled = false;
+  auto component = Async({
+      .fetch = [&](const std::atomic<bool>& c) -> std::function<Element()> {
+        cancelled = c;
+        return [] { return text("data"); };
+      },
+      .version = nullptr,
+      .executor = executor.Get(),
+  });
+  Draw(component);
+  component.reset();
+
+  // The job outlives the component. Its result is dropped.
+  executor.jobs[0]();
+  EXPECT_TRUE(cancelled);
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -0,0 +1,416 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <benchmark/benchmark.h>
+#include <fcntl.h>    // for open, O_WRONLY
+#include <unistd.h>   // for close
+#include <algorithm>  // for max, min
+#include <cstdint>    // for int64_t
+#include <string>     // for string, to_string
+#include <utility>    // for move
+#include <vector>     // for vector
+
+#include "ftxui/component/component.hpp"  // for Menu, DBMenu, Input, Button, Renderer, Container, CatchEvent
+#include "ftxui/component/component_base.hpp"     // for ComponentBase
+#include "ftxui/component/component_options.hpp"  // for DataSource, DSRenderContext, DataSize, MenuOption
+#include "ftxui/component/event.hpp"  // for Event, Event::ArrowDown, Event::ArrowUp
+#include "ftxui/component/frame_stats.hpp"  // for FrameStats
+#include "ftxui/component/loop.hpp"         // for Loop
+#include "ftxui/component/mouse.hpp"        // for Mouse
+#include "ftxui/component/screen_interactive.hpp"  // for ScreenInteractive
+#include "ftxui/dom/elements.hpp"  // for text, operator|, border, frame, vbox, hbox, separator, gauge
+#include "ftxui/dom/node.hpp"       // for Render
+#include "ftxui/screen/screen.hpp"  // for Screen
+
+// Headless benchmarks of the components. They reproduce what
+// ScreenInteractive does for each frame, without a terminal.
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+
+// The terminal sizes the benchmarks are run with: {width, height}.
+void TerminalSizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->Args({80, 24})->Args({200, 60})->Args({400, 120});
+}
+
+// Draw a frame of |component| like ScreenInteractive::Draw, and return the
+// number of bytes which would be written to the terminal.
+size_t DrawFrame(const Component& component,
+                 Screen& screen,
+                 Screen& previous,
+                 std::string& output) {
+  std::swap(screen, previous);
+  screen.Clear();
+  Render(screen, component->Render());
+  output.clear();
+  screen.ToDiffString(previous, output);
+  return output.size();
+}
+
+DataSource MakeDataSource(int64_t size) {
+  DataSource source;
+  source.dataset_size = [size] { return DataSize{size, 0, size - 1}; };
+  source.count_items_before = [](int64_t id) { return id; };
+  source.move_id_by = [size](int64_t& id, int64_t offset) {
+    const int64_t initial = id;
+    id = std::max<int64_t>(0, std::min(id + offset, size - 1));
+    return id != initial;
+  };
+  source.id_to_index = [](int64_t id) { return id; };
+  source.index_to_id = [](int64_t index) { return index; };
+  source.transform = [](DSRenderContext& context) {
+    auto element = text("Row " + std::to_string(context.id));
+    return context.focused ? element | inverted : element;
+  };
+  return source;
+}
+
+}  // namespace
+
+// Move the selection of a 10k entries Menu, and draw it.
+static void BenchmarkMenu(benchmark::State& state) {
+  const int width = int(state.range(0));
+  const int height = int(state.range(1));
+  std::vector<std::string> entries;
+  for (int i = 0; i < 10000; ++i) {
+    entries.push_back("Entry " + std::to_string(i));
+  }
+  int selected = 0;
+  auto menu = Menu(&entries, &selected);
+  auto component = Renderer(menu, [&] { return menu->Render() | frame; });
+
+  Screen screen(width, height);
+  Screen previous(width, height);
+  std::string output;
+  for (auto _ : state) {
+    component->OnEvent(selected + 1 < int(entries.size()) ? Event::ArrowDown
+                                                           : Event::Home);
+    benchmark::DoNotOptimize(DrawFrame(component, screen, previous, output));
+  }
+}
+BENCHMARK(BenchmarkMenu)->Apply(TerminalSizes);
+
+// Move the focus of a DBMenu over a 1M rows DataSource, and draw it.
+static void BenchmarkDBMenu(benchmark::State& state) {
+  const int width = int(state.range(0));
+  const int height = int(state.range(1));
+  const int64_t size = 1000000;
+  DataSource source = MakeDataSource(size);
+  source.row_cache_capacity = 2 * height;
+  auto menu = DBMenu(&source);
+
+  Screen screen(width, height);
+  Screen previous(width, height);
+  std::string output;
+  for (auto _ : state) {
+    menu->OnEvent(source.focused_id + 1 < size ? Event::ArrowDown
+                                               : Event::Home);
+    benchmark::DoNotOptimize(DrawFrame(menu, screen, previous, output));
+  }
+}
+BENCHMARK(BenchmarkDBMenu)->Apply(TerminalSizes);
+
+// Type into an Input holding 10k lines, and draw it.
+static void BenchmarkInput(benchmark::State& state) {
+  const int width = int(state.range(0));
+  const int height = int(state.range(1));
+  std::string content;
+  for (int i = 0; i < 10000; ++i) {
+    content += "The quick brown fox jumps over the lazy dog " +
+               std::to_string(i) + "\n";
+  }
+  auto input = Input(&content);
+  auto component = Renderer(input, [&] { return input->Render() | frame; });
+  component->OnEvent(Event::ArrowUp);
+
+  Screen screen(width, height);
+  Screen previous(width, height);
+  std::string output;
+  int typed = 0;
+  for (auto _ : state) {
+    component->OnEvent(++typed % 64 ? Event::Character('a')
+                                    : Event::Backspace);
+    benchmark::DoNotOptimize(DrawFrame(component, screen, previous, output));
+  }
+}
+BENCHMARK(BenchmarkInput)->Apply(TerminalSizes);
+
+// A typical application: a sidebar menu, a form, and progress bars. The
+// focus moves in between frames.
+static void BenchmarkFrame(benchmark::State& state) {
+  const int width = int(state.range(0));
+  const int height = int(state.range(1));
+  std::vector<std::string> entries;
+  for (int i = 0; i < 100; ++i) {
+    entries.push_back("Item " + std::to_string(i));
+  }
+  int selected = 0;
+  std::vector<std::string> values(20);
+  auto menu = Menu(&entries, &selected);
+  auto form = Container::Vertical({});
+  for (auto& value : values) {
+    form->Add(Input(&value, "placeholder"));
+  }
+  auto button = Button("Submit", [] {});
+  form->Add(button);
+  float progress = 0.F;
+  auto layout = Container::Horizontal({menu, form});
+  auto component = Renderer(layout, [&] {
+    Elements gauges;
+    for (int i = 0; i < 10; ++i) {
+      gauges.push_back(gauge(progress * float(i + 1) / 10.F));
+    }
+    return hbox({
+               menu->Render() | frame,
+               separator(),
+               vbox({
+                   form->Render() | frame | flex,
+                   separator(),
+                   vbox(std::move(gauges)),
+               }) | flex,
+           }) |
+           border;
+  });
+
+  Screen screen(width, height);
+  Screen previous(width, height);
+  std::string output;
+  int frame_count = 0;
+  for (auto _ : state) {
+    frame_count++;
+    progress = float(frame_count % 100) / 100.F;
+    component->OnEvent(frame_count % 2 ? Event::ArrowDown
+                                       : Event::Character('x'));
+    benchmark::DoNotOptimize(DrawFrame(component, screen, previous, output));
+  }
+}
+BENCHMARK(BenchmarkFrame)->Apply(TerminalSizes);
+
+namespace {
+
+enum class Trace { Scroll, Typing, Resize };
+
+// Drive a ScreenInteractive through a scripted sequence of events, and report
+// the time spent in each phase of the frames, and the bytes they emit. The
+// output goes to /dev/null.
+void BenchmarkPipeline(benchmark::State& state, Trace trace) {
+  const int width = int(state.range(0));
+  const int height = int(state.range(1));
+  const bool differential = state.range(2) != 0;
+
+  std::vector<std::string> entries;
+  for (int i = 0; i < 10000; ++i) {
+    entries.push_back("Entry " + std::to_string(i));
+  }
+  int selected = 0;
+  std::string content;
+  bool small = false;
+  Component component;
+  std::vector<Event> events;
+  switch (trace) {
+    case Trace::Scroll: {
+      auto menu = Menu(&entries, &selected);
+      component = Renderer(menu, [menu] { return menu->Render() | frame; });
+      events = {Event::ArrowDown, Event::ArrowDown, Event::PageDown,
+                Event::ArrowUp};
+      break;
+    }
+    case Trace::Typing: {
+      for (int i = 0; i < 1000; ++i) {
+        content += "The quick brown fox jumps over the lazy dog\n";
+      }
+      auto input = Input(&content);
+      component = Renderer(input, [input] { return input->Render() | frame; });
+      for (const char c : std::string("hello world")) {
+        events.push_back(Event::Character(c));
+      }
+      events.push_back(Event::Return);
+      break;
+    }
+    case Trace::Resize: {
+      // The terminal is emulated by a component alternating in between two
+      // sizes, so that every frame is drawn after a resize.
+      component = Renderer([&, width, height] {
+        const int dimy = small ? height / 2 : height;
+        Elements rows;
+        for (int y = 0; y < dimy; ++y) {
+          rows.push_back(text(entries[size_t(y)]) | flex);
+        }
+        return vbox(std::move(rows)) |
+               size(WIDTH, EQUAL, small ? width / 2 : width);
+      });
+      component |= CatchEvent([&](Event event) {
+        small = !small;
+        return event == Event::Custom;
+      });
+      events = {Event::Custom};
+      break;
+    }
+  }
+
+  auto screen = trace == Trace::Resize
+                    ? ScreenInteractive::FitComponent()
+                    : ScreenInteractive::FixedSize(width, height);
+  const int sink = open("/dev/null", O_WRONLY);  // NOLINT
+  screen.OutputFd(sink);
+  screen.SingleThreaded();
+  screen.TrackMouse(false);
+  screen.DifferentialOutput(differential);
+  {
+    Loop loop(&screen, component);
+    size_t i = 0;
+    for (auto _ : state) {
+      screen.PostEvent(events[i++ % events.size()]);
+      loop.RunOnce();
+    }
+  }
+  close(sink);
+
+  const FrameStats stats = screen.Stats();
+  auto us = [](const FrameStats::Duration& duration) {
+    return benchmark::Counter(duration.p50 * 1e6);
+  };
+  state.counters["component_us"] = us(stats.component_render);
+  state.counters["layout_us"] = us(stats.layout);
+  state.counters["render_us"] = us(stats.node_render);
+  state.counters["serialize_us"] = us(stats.serialize);
+  state.counters["write_us"] = us(stats.write);
+  state.counters["bytes/frame"] = benchmark::Counter(
+      stats.frames ? double(stats.bytes_total) / double(stats.frames) : 0.0);
+}
+
+// The terminal sizes, with and without the differential output.
+void PipelineArgs(benchmark::internal::Benchmark* benchmark) {
+  for (const auto& size : {std::pair{80, 24}, std::pair{200, 60}}) {
+    for (const int differential : {0, 1}) {
+      benchmark->Args({size.first, size.second, differential});
+    }
+  }
+  benchmark->ArgNames({"width", "height", "diff"});
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BenchmarkPipeline, Scroll, Trace::Scroll)
+    ->Apply(PipelineArgs);
+BENCHMARK_CAPTURE(BenchmarkPipeline, Typing, Trace::Typing)
+    ->Apply(PipelineArgs);
+BENCHMARK_CAPTURE(BenchmarkPipeline, Resize, Trace::Resize)
+    ->Apply(PipelineArgs);
+
+namespace {
+
+// A tree of |depth| levels of containers, alternatively vertical and
+// horizontal, with |fanout| children each. The leaves are Renderer, and every
+// component is wrapped by a CatchEvent not handling the events, so that they
+// bubble up through every level.
+Component EventTree(int fanout, int depth) {
+  auto pass = CatchEvent([](const Event&) { return false; });
+  if (depth == 0) {
+    return Renderer([](bool focused) {
+             return text(focused ? "[x]" : "[ ]");
+           }) |
+           pass;
+  }
+  Components children;
+  children.reserve(size_t(fanout));
+  for (int i = 0; i < fanout; ++i) {
+    children.push_back(EventTree(fanout, depth - 1));
+  }
+  return (depth % 2 ? Container::Vertical(std::move(children))
+                    : Container::Horizontal(std::move(children))) |
+         pass;
+}
+
+// The trees, from wide and shallow to narrow and deep: {fanout, depth}.
+void EventTreeArgs(benchmark::internal::Benchmark* benchmark) {
+  for (const int fanout : {10, 100, 1000, 10000}) {
+    benchmark->Args({fanout, 1});
+  }
+  for (const int depth : {4, 8, 12}) {
+    benchmark->Args({2, depth});
+  }
+  benchmark->Args({8, 4});
+  benchmark->ArgNames({"fanout", "depth"});
+}
+
+// The trees, with and without the routed mouse events.
+void EventMouseArgs(benchmark::internal::Benchmark* benchmark) {
+  for (const int routed : {0, 1}) {
+    for (const auto& tree : {std::pair{10, 1}, std::pair{100, 1},
+                             std::pair{1000, 1}, std::pair{10000, 1},
+                             std::pair{2, 8}, std::pair{2, 12},
+                             std::pair{8, 4}}) {
+      benchmark->Args({tree.first, tree.second, routed});
+    }
+  }
+  benchmark->ArgNames({"fanout", "depth", "routed"});
+}
+
+}  // namespace
+
+// Dispatch the keyboard navigation events to the tree. Neither handled by the
+// leaves nor the CatchEvent, they go down the focus path and bubble up until a
+// container moves its selection.
+static void BenchmarkEventKeyboard(benchmark::State& state) {
+  auto tree = EventTree(int(state.range(0)), int(state.range(1)));
+  const Event events[] = {Event::ArrowDown, Event::ArrowRight, Event::ArrowUp,
+                          Event::ArrowLeft, Event::Character('x')};
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tree->OnEvent(events[i++ % 5]));
+  }
+}
+BENCHMARK(BenchmarkEventKeyboard)->Apply(EventTreeArgs);
+
+// Dispatch mouse moves over the tree, drawn once. Routed or not, see
+// ScreenInteractive::RoutedEvents().
+static void BenchmarkEventMouse(benchmark::State& state) {
+  const int width = 200;
+  const int height = 60;
+  auto tree = EventTree(int(state.range(0)), int(state.range(1)));
+
+  // The mouse events need to come from the screen, for the routing to apply.
+  // Capture one, and draw the frames giving the boxes to the containers.
+  Event move = Event::Custom;
+  auto component = tree | CatchEvent([&](Event event) {
+                     if (event.is_mouse()) {
+                       move = event;
+                     }
+                     return false;
+                   });
+  auto screen = ScreenInteractive::FixedSize(width, height);
+  const int sink = open("/dev/null", O_WRONLY);  // NOLINT
+  screen.OutputFd(sink);
+  screen.SingleThreaded();
+  screen.TrackMouse(false);
+  screen.RoutedEvents(state.range(2) != 0);
+  {
+    Loop loop(&screen, component);
+    Mouse mouse;
+    mouse.button = Mouse::None;
+    mouse.motion = Mouse::Moved;
+    for (int i = 0; i < 2; ++i) {
+      mouse.x = mouse.y = i + 1;
+      screen.PostEvent(Event::Mouse("", mouse));
+      loop.RunOnce();
+    }
+
+    int i = 0;
+    for (auto _ : state) {
+      ++i;
+      move.mouse().x = (i * 7) % width;
+      move.mouse().y = i % height;
+      // Like ScreenInteractive, before dispatching an event.
+      ComponentBase::Private::InvalidateFocus();
+      benchmark::DoNotOptimize(tree->OnEvent(move));
+    }
+  }
+  close(sink);
+}
+BENCHMARK(BenchmarkEventMouse)->Apply(EventMouseArgs);
+
+}  // namespace ftxui
+// NOLINTEND
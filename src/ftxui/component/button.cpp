@@ -115,8 +115,12 @@ class ButtonBase : public ComponentBase, public ButtonOption {
   }
 
   bool OnMouseEvent(Event event) {
-    mouse_hover_ =
+    const bool hover =
         box_.Contain(event.mouse().x, event.mouse().y) && CaptureMouse(event);
+    if (hover != mouse_hover_) {
+      mouse_hover_ = hover;
+      RequestRedraw();
+    }
 
     if (!mouse_hover_) {
       return false;
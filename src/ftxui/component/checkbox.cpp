@@ -1,17 +1,20 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
+#include <algorithm>   // for fill, max, min
+#include <cstdint>     // for int64_t
 #include <functional>  // for function
 #include <utility>     // for move
+#include <vector>      // for vector
 
-#include "ftxui/component/component.hpp"       // for Make, Checkbox
+#include "ftxui/component/component.hpp"  // for Make, Checkbox, CheckboxList, DBMenu
 #include "ftxui/component/component_base.hpp"  // for Component, ComponentBase
-#include "ftxui/component/component_options.hpp"  // for CheckboxOption, EntryState
+#include "ftxui/component/component_options.hpp"  // for CheckboxOption, CheckboxListOption, EntryState, DataSource
 #include "ftxui/component/event.hpp"              // for Event, Event::Return
 #include "ftxui/component/mouse.hpp"  // for Mouse, Mouse::Left, Mouse::Pressed
 #include "ftxui/dom/elements.hpp"  // for operator|, Element, reflect, focus, nothing, select
 #include "ftxui/screen/box.hpp"  // for Box
-#include "ftxui/util/ref.hpp"    // for Ref, ConstStringRef
+#include "ftxui/util/ref.hpp"    // for Ref, ConstStringRef, ConstStringListRef
 
 namespace ftxui {
 
@@ -44,7 +47,7 @@ class CheckboxBase : public ComponentBase, public CheckboxOption {
       return OnMouseEvent(event);
     }
 
-    hovered_ = false;
+    SetHovered(false);
     if (event == Event::Character(' ') || event == Event::Return) {
       *checked = !*checked;
       on_change();
@@ -55,7 +58,7 @@ class CheckboxBase : public ComponentBase, public CheckboxOption {
   }
 
   bool OnMouseEvent(Event event) {
-    hovered_ = box_.Contain(event.mouse().x, event.mouse().y);
+    SetHovered(box_.Contain(event.mouse().x, event.mouse().y));
 
     if (!CaptureMouse(event)) {
       return false;
@@ -78,9 +81,126 @@ class CheckboxBase : public ComponentBase, public CheckboxOption {
 
   bool Focusable() const final { return true; }
 
+  void SetHovered(bool hovered) {
+    if (hovered != hovered_) {
+      hovered_ = hovered;
+      RequestRedraw();
+    }
+  }
+
   bool hovered_ = false;
   Box box_;
 };
+
+// The entries are the rows of a DBMenu, rendered only when visible. Their
+// state is a bit of |checked|.
+class CheckboxListBase : public ComponentBase, public CheckboxListOption {
+ public:
+  explicit CheckboxListBase(CheckboxListOption option)
+      : CheckboxListOption(std::move(option)) {
+    if (!transform) {
+      transform = CheckboxOption::Simple().transform;
+    }
+
+    // The ids of the DataSource are the indices of the entries.
+    source_.dataset_size = [this] {
+      const auto size = int64_t(entries.size());
+      return DataSize{size, 0, size - 1};
+    };
+    source_.count_items_before = [](int64_t id) { return id; };
+    source_.move_id_by = [this](int64_t& id, int64_t offset) {
+      const int64_t initial = id;
+      const auto last = int64_t(entries.size()) - 1;
+      id = std::max<int64_t>(0, std::min(id + offset, last));
+      return id != initial;
+    };
+    source_.id_to_index = [](int64_t id) { return id; };
+    source_.index_to_id = [](int64_t index) { return index; };
+    source_.on_event = [this](DSEventContext context) {
+      return HandleEvent(context);
+    };
+    source_.transform = [this](DSRenderContext& context) {
+      const int index = int(context.id);
+      return transform({
+          entries[index],
+          (*checked)[index],
+          context.focused,
+          (context.focused && context.component_focused) || context.hovered,
+          index,
+      });
+    };
+
+    menu_ = DBMenu(&source_);
+    Add(menu_);
+  }
+
+ private:
+  Element Render() override {
+    Sync();
+    return menu_->Render();
+  }
+
+  bool OnEvent(Event event) override {
+    Sync();
+    const bool handled = ComponentBase::OnEvent(event);
+    focused_entry() = int(source_.focused_id);
+    return handled;
+  }
+
+  void Sync() {
+    checked->resize(entries.size());
+    source_.focused_id = focused_entry();
+  }
+
+  bool HandleEvent(DSEventContext context) {
+    const int64_t id = source_.focused_id;
+    if (id >= int64_t(checked->size())) {
+      return context.handled;
+    }
+
+    // Clicking an entry toggles it. With shift, the entries up to the one
+    // toggled last take its state.
+    if (context.event.is_mouse()) {
+      const Mouse& mouse = context.event.mouse();
+      if (context.handled && mouse.button == Mouse::Left &&
+          mouse.motion == Mouse::Pressed) {
+        if (mouse.shift && anchor_ < int64_t(checked->size())) {
+          SetRange(anchor_, id, (*checked)[anchor_]);
+        } else {
+          Toggle(id);
+        }
+      }
+      return context.handled;
+    }
+
+    if (context.focused &&
+        (context.event == Event::Character(' ') ||
+         context.event == Event::Return)) {
+      Toggle(id);
+      return true;
+    }
+    return context.handled;
+  }
+
+  void Toggle(int64_t id) {
+    (*checked)[id] = !(*checked)[id];
+    anchor_ = id;
+    on_change();
+  }
+
+  // Set the entries from |from| to |to| included, in any order.
+  void SetRange(int64_t from, int64_t to, bool value) {
+    const int64_t first = std::min(from, to);
+    const int64_t last = std::max(from, to);
+    std::fill(checked->begin() + first, checked->begin() + last + 1, value);
+    on_change();
+  }
+
+  Component menu_;
+  DataSource source_;
+  // The entry toggled last.
+  int64_t anchor_ = 0;
+};
 }  // namespace
 
 /// @brief Draw checkable element.
@@ -138,4 +258,41 @@ Component Checkbox(ConstStringRef label, bool* checked, CheckboxOption option) {
   return Make<CheckboxBase>(std::move(option));
 }
 
+/// @brief A list of checkable entries, for long lists. A single component
+/// draws the visible entries only, and their state is a bit of a
+/// `std::vector<bool>`.
+///
+/// Space, return or a click toggles an entry. A shift click gives the state of
+/// the entry toggled last to every entry up to the one clicked.
+/// @param option The entries, their state, and how to display them.
+/// @ingroup component
+///
+/// ### Example
+///
+/// ```cpp
+/// std::vector<std::string> entries = ...;
+/// std::vector<bool> checked(entries.size());
+/// Component list = CheckboxList(&entries, &checked);
+/// screen.Loop(list);
+/// ```
+// NOLINTNEXTLINE
+Component CheckboxList(CheckboxListOption option) {
+  return Make<CheckboxListBase>(std::move(option));
+}
+
+/// @brief A list of checkable entries, for long lists.
+/// @param entries The labels of the entries.
+/// @param checked The state of the entries, one bit each.
+/// @param option Additional optional parameters.
+/// @ingroup component
+/// @see CheckboxList
+// NOLINTNEXTLINE
+Component CheckboxList(ConstStringListRef entries,
+                       std::vector<bool>* checked,
+                       CheckboxListOption option) {
+  option.entries = std::move(entries);
+  option.checked = checked;
+  return Make<CheckboxListBase>(std::move(option));
+}
+
 }  // namespace ftxui
@@ -0,0 +1,101 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <string>  // for string, to_string
+#include <vector>  // for vector
+
+#include "ftxui/component/component.hpp"          // for CheckboxList
+#include "ftxui/component/component_options.hpp"  // for CheckboxListOption
+#include "ftxui/component/event.hpp"              // for Event
+#include "ftxui/component/mouse.hpp"              // for Mouse
+#include "ftxui/dom/elements.hpp"                 // for text
+#include "ftxui/dom/node.hpp"                     // for Render
+#include "ftxui/screen/screen.hpp"                // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+
+std::vector<std::string> Entries(int size) {
+  std::vector<std::string> entries;
+  for (int i = 0; i < size; ++i) {
+    entries.push_back("entry " + std::to_string(i));
+  }
+  return entries;
+}
+
+Event MousePressed(int y, bool shift) {
+  Mouse mouse;
+  mouse.button = Mouse::Left;
+  mouse.motion = Mouse::Pressed;
+  mouse.shift = shift;
+  mouse.x = 0;
+  mouse.y = y;
+  return Event::Mouse("", mouse);
+}
+
+}  // namespace
+
+TEST(CheckboxListTest, RendersVisibleEntries) {
+  std::vector<std::string> entries = Entries(20000);
+  std::vector<bool> checked;
+  int rendered = 0;
+  CheckboxListOption option;
+  option.transform = [&](const EntryState& state) {
+    rendered++;
+    return text((state.state ? "x " : "  ") + state.label);
+  };
+  Component list = CheckboxList(&entries, &checked, option);
+
+  Screen screen(10, 3);
+  Render(screen, list->Render());
+  EXPECT_EQ(checked.size(), 20000u);
+  // The rows are produced for a default height, then for the height assigned.
+  EXPECT_LT(rendered, 20);
+  EXPECT_EQ(screen.ToString(),
+            "  entry 0 \r\n"
+            "  entry 1 \r\n"
+            "  entry 2 ");
+}
+
+TEST(CheckboxListTest, Toggle) {
+  std::vector<std::string> entries = Entries(100);
+  std::vector<bool> checked(100);
+  int focused = 0;
+  int changes = 0;
+  CheckboxListOption option;
+  option.focused_entry = &focused;
+  option.on_change = [&] { changes++; };
+  Component list = CheckboxList(&entries, &checked, option);
+
+  EXPECT_TRUE(list->OnEvent(Event::Character(' ')));
+  EXPECT_TRUE(checked[0]);
+  EXPECT_TRUE(list->OnEvent(Event::ArrowDown));
+  EXPECT_EQ(focused, 1);
+  EXPECT_TRUE(list->OnEvent(Event::Return));
+  EXPECT_TRUE(checked[1]);
+  EXPECT_TRUE(list->OnEvent(Event::Return));
+  EXPECT_FALSE(checked[1]);
+  EXPECT_EQ(changes, 3);
+}
+
+TEST(CheckboxListTest, ShiftClick) {
+  std::vector<std::string> entries = Entries(100);
+  std::vector<bool> checked(100);
+  Component list = CheckboxList(&entries, &checked);
+
+  Screen screen(10, 10);
+  Render(screen, list->Render());
+
+  EXPECT_TRUE(list->OnEvent(MousePressed(2, false)));
+  EXPECT_TRUE(checked[2]);
+  EXPECT_TRUE(list->OnEvent(MousePressed(6, true)));
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(checked[i], i >= 2 && i <= 6) << i;
+  }
+}
+
+}  // namespace ftxui
+// NOLINTEND
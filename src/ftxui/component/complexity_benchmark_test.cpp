@@ -0,0 +1,148 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <benchmark/benchmark.h>
+#include <cstdint>  // for int64_t
+#include <string>   // for string, to_string
+#include <utility>  // for move
+#include <vector>   // for vector
+
+#include "ftxui/component/component.hpp"       // for Renderer, Container
+#include "ftxui/component/component_base.hpp"  // for ComponentBase
+#include "ftxui/component/receiver.hpp"        // for MakeReceiver
+#include "ftxui/component/task.hpp"            // for Task
+#include "ftxui/component/terminal_input_parser.hpp"  // for TerminalInputParser
+#include "ftxui/dom/elements.hpp"  // for text, flexbox, Elements
+#include "ftxui/dom/node.hpp"       // for Render
+#include "ftxui/screen/screen.hpp"  // for Screen
+
+// Complexity benchmarks of the operations which could silently become
+// quadratic. Each one is run over several decades of sizes, and Google
+// Benchmark fits its scaling. They are all expected to report (1), N, or at
+// worst NlgN. A regression shows up as N^2, or as a large RMS error of the
+// fit:
+//
+//   ftxui-benchmark --benchmark_filter=BenchmarkComplexity
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+
+// The sizes, from 64 to 256k.
+void ComplexitySizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->RangeMultiplier(4)->Range(1 << 6, 1 << 18)->Complexity();
+}
+
+}  // namespace
+
+// Register N distinct hyperlinks, then look every one of them up again, like
+// drawing N links twice.
+static void BenchmarkComplexityHyperlinks(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  std::vector<std::string> links;
+  for (int64_t i = 0; i < n; ++i) {
+    links.push_back("https://example.com/" + std::to_string(i));
+  }
+  for (auto _ : state) {
+    Screen screen(1, 1);
+    for (const std::string& link : links) {
+      benchmark::DoNotOptimize(screen.RegisterHyperlink(link));
+    }
+    for (const std::string& link : links) {
+      benchmark::DoNotOptimize(screen.RegisterHyperlink(link));
+    }
+  }
+  state.SetComplexityN(n);
+}
+// The ids are 16 bits: the sizes stay below 65536 links.
+BENCHMARK(BenchmarkComplexityHyperlinks)
+    ->RangeMultiplier(4)
+    ->Range(1 << 4, 1 << 14)
+    ->Complexity();
+
+// Detach the N children of a container, from the last one. Building the
+// container isn't measured.
+static void BenchmarkComplexityDetach(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto container = Container::Vertical({});
+    for (int64_t i = 0; i < n; ++i) {
+      container->Add(Renderer([] { return text("child"); }));
+    }
+    state.ResumeTiming();
+    container->DetachAllChildren();
+    state.PauseTiming();
+    container.reset();
+    state.ResumeTiming();
+  }
+  state.SetComplexityN(n);
+}
+BENCHMARK(BenchmarkComplexityDetach)->Apply(ComplexitySizes);
+
+// Parse N bytes of typical input, one byte at a time: characters, UTF-8,
+// arrow keys and mouse moves.
+static void BenchmarkComplexityInputBytes(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::string chunk = "abc\xC3\xA9\x1B[A\x1B[<35;12;7M";
+  std::string input;
+  while (int64_t(input.size()) < n) {
+    input += chunk;
+  }
+  input.resize(size_t(n));
+  auto receiver = MakeReceiver<Task>();
+  TerminalInputParser parser(receiver->MakeSender());
+  std::vector<Task> tasks;
+  for (auto _ : state) {
+    for (const char c : input) {
+      parser.Add(c);
+    }
+    tasks.clear();
+    receiver->ReceiveAll(&tasks);
+  }
+  state.SetComplexityN(n);
+}
+BENCHMARK(BenchmarkComplexityInputBytes)->Apply(ComplexitySizes);
+
+// Parse a single N bytes long sequence, received by chunks of 64 bytes, like
+// a large clipboard content (OSC 52) read from the terminal.
+static void BenchmarkComplexityInputSequence(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  std::string input = "\x1B]52;c;";
+  input.append(size_t(n), 'A');
+  input += "\x1B\\";
+  auto receiver = MakeReceiver<Task>();
+  TerminalInputParser parser(receiver->MakeSender());
+  std::vector<Task> tasks;
+  for (auto _ : state) {
+    for (size_t i = 0; i < input.size(); i += 64) {
+      parser.Add(std::string_view(input).substr(i, 64));
+    }
+    tasks.clear();
+    receiver->ReceiveAll(&tasks);
+  }
+  state.SetComplexityN(n);
+}
+BENCHMARK(BenchmarkComplexityInputSequence)->Apply(ComplexitySizes);
+
+// Wrap N words into the lines of a flexbox, and draw it.
+static void BenchmarkComplexityFlexboxWrap(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  Screen screen(80, 24);
+  for (auto _ : state) {
+    state.PauseTiming();
+    Elements words;
+    for (int64_t i = 0; i < n; ++i) {
+      words.push_back(text("word" + std::to_string(i % 100) + " "));
+    }
+    auto document = flexbox(std::move(words));
+    state.ResumeTiming();
+    Render(screen, document);
+  }
+  state.SetComplexityN(n);
+}
+BENCHMARK(BenchmarkComplexityFlexboxWrap)->Apply(ComplexitySizes);
+
+}  // namespace ftxui
+// NOLINTEND
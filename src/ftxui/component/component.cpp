@@ -1,10 +1,13 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <algorithm>  // for find_if
+#include <algorithm>  // for any_of, find_if, min, replace
+#include <atomic>     // for atomic
 #include <cassert>    // for assert
 #include <cstddef>    // for size_t
+#include <cstdint>    // for uint64_t
 #include <iterator>   // for begin, end
+#include <limits>     // for numeric_limits
 #include <memory>     // for unique_ptr, make_unique
 #include <utility>    // for move
 #include <vector>     // for vector, __alloc_traits<>::value_type
@@ -24,10 +27,40 @@ namespace ftxui {
 
 namespace {
 class CaptureMouseImpl : public CapturedMouseInterface {};
+
+// Per thread, like the active session: every session runs its loop, and owns
+// its components, on its own thread.
+
+// The component whose OnAnimation() is running.
+thread_local ComponentBase* g_animating = nullptr;  // NOLINT
+// The components having requested an animation frame.
+thread_local std::vector<ComponentBase*> g_animation_requests;  // NOLINT
+// The components being animated by AnimateRequested().
+thread_local std::vector<ComponentBase*> g_animated;  // NOLINT
+
+// The focus caches computed in another epoch are stale. The epochs are unique
+// across the threads: a component moved to another thread isn't matched by an
+// epoch it was cached in.
+std::atomic<uint64_t> g_last_focus_epoch{0};  // NOLINT
+uint64_t NewFocusEpoch() {
+  return ++g_last_focus_epoch;
+}
+thread_local uint64_t g_focus_epoch = NewFocusEpoch();  // NOLINT
+
+void Forget(std::vector<ComponentBase*>* components, ComponentBase* component) {
+  std::replace(components->begin(), components->end(), component,
+               static_cast<ComponentBase*>(nullptr));
+}
 }  // namespace
 
 ComponentBase::~ComponentBase() {
   DetachAllChildren();
+  if (animation_requested_) {
+    Forget(&g_animation_requests, this);
+  }
+  if (!g_animated.empty()) {
+    Forget(&g_animated, this);
+  }
 }
 
 /// @brief Return the parent ComponentBase, or nul if any.
@@ -57,14 +90,8 @@ int ComponentBase::Index() const {
   if (parent_ == nullptr) {
     return -1;
   }
-  int index = 0;
-  for (const Component& child : parent_->children_) {
-    if (child.get() == this) {
-      return index;
-    }
-    index++;
-  }
-  return -1;  // Not reached.
+  const size_t position = PositionInParent();
+  return position == parent_->children_.size() ? -1 : int(position);
 }
 
 /// @brief Add a child.
@@ -73,7 +100,9 @@ int ComponentBase::Index() const {
 void ComponentBase::Add(Component child) {
   child->Detach();
   child->parent_ = this;
+  child->index_hint_ = children_.size();
   children_.push_back(std::move(child));
+  Private::InvalidateFocus();
 }
 
 /// @brief Detach this child from its parent.
@@ -84,21 +113,78 @@ void ComponentBase::Detach() {
   if (parent_ == nullptr) {
     return;
   }
-  auto it = std::find_if(std::begin(parent_->children_),  //
-                         std::end(parent_->children_),    //
-                         [this](const Component& that) {  //
-                           return this == that.get();
-                         });
+  OnHide();
+  const size_t index = PositionInParent();
   ComponentBase* parent = parent_;
   parent_ = nullptr;
-  parent->children_.erase(it);  // Might delete |this|.
+  if (index == parent->children_.size()) {
+    return;
+  }
+  parent->children_.erase(parent->children_.begin() +
+                          std::ptrdiff_t(index));  // Might delete |this|.
+  parent->ReindexChildren(index);
+  Private::InvalidateFocus();
 }
 
 /// @brief Remove all children.
 /// @ingroup component
 void ComponentBase::DetachAllChildren() {
+  // From the last one, so that the others aren't moved.
   while (!children_.empty()) {
-    children_[0]->Detach();
+    children_.back()->Detach();
+  }
+}
+
+/// @brief Replace the children by |children|, in this order.
+/// @param children The new children. The ones already children of this
+/// component are only moved. The others are detached from their parent first.
+/// The children missing from the list are detached.
+/// @ingroup component
+void ComponentBase::SetChildren(Components children) {
+  for (const Component& child : children) {
+    child->index_hint_ = std::numeric_limits<size_t>::max();  // Mark as kept.
+  }
+  for (const Component& child : children_) {
+    if (child->index_hint_ != std::numeric_limits<size_t>::max()) {
+      child->OnHide();
+    }
+  }
+  for (const Component& child : children) {
+    if (child->parent_ != this) {
+      child->Detach();
+      child->parent_ = this;
+    }
+  }
+  for (const Component& child : children_) {
+    if (child->index_hint_ != std::numeric_limits<size_t>::max()) {
+      child->parent_ = nullptr;
+    }
+  }
+
+  // The children removed are released once the new ones are in place.
+  std::swap(children_, children);
+  ReindexChildren(0);
+  Private::InvalidateFocus();
+}
+
+// private
+size_t ComponentBase::PositionInParent() const {
+  const Components& siblings = parent_->children_;
+  if (index_hint_ < siblings.size() && siblings[index_hint_].get() == this) {
+    return index_hint_;
+  }
+  // The children were reordered. Index them all again.
+  parent_->ReindexChildren(0);
+  if (index_hint_ < siblings.size() && siblings[index_hint_].get() == this) {
+    return index_hint_;
+  }
+  return siblings.size();  // Removed from the children by a derived class.
+}
+
+// private
+void ComponentBase::ReindexChildren(size_t first) {
+  for (size_t i = first; i < children_.size(); ++i) {
+    children_[i]->index_hint_ = i;
   }
 }
 
@@ -107,6 +193,10 @@ void ComponentBase::DetachAllChildren() {
 /// ftxui::ComponentBase.
 /// @ingroup component
 Element ComponentBase::Render() {
+  // The state of the components might have changed since the last frame.
+  if (parent_ == nullptr) {
+    Private::InvalidateFocus();
+  }
   if (children_.size() == 1) {
     return children_.front()->Render();
   }
@@ -121,8 +211,13 @@ Element ComponentBase::Render() {
 /// true. If none returns true, return false.
 /// @ingroup component
 bool ComponentBase::OnEvent(Event event) {  // NOLINT
-  for (Component& child : children_) {      // NOLINT
+  // The state of the components might have changed since the last event.
+  if (parent_ == nullptr) {
+    Private::InvalidateFocus();
+  }
+  for (Component& child : children_) {  // NOLINT
     if (child->OnEvent(event)) {
+      Private::InvalidateFocus();
       return true;
     }
   }
@@ -135,8 +230,139 @@ bool ComponentBase::OnEvent(Event event) {  // NOLINT
 /// @ingroup component
 void ComponentBase::OnAnimation(animation::Params& params) {
   for (const Component& child : children_) {
-    child->OnAnimation(params);
+    Private::Animate(child.get(), params);
+  }
+}
+
+/// @brief Called when the component stops being displayed: hidden by Maybe, or
+/// detached from its parent. It is displayed again by its next Render().
+/// The default implementation dispatch it to every child.
+/// @ingroup component
+void ComponentBase::OnHide() {
+  for (const Component& child : children_) {
+    child->OnHide();
+  }
+}
+
+/// @brief Called when the component is displayed again after OnHide(): shown by
+/// Maybe, or its tab selected again in a Container::Tab suspending the others.
+/// The default implementation dispatch it to every child.
+/// @ingroup component
+void ComponentBase::OnShow() {
+  for (const Component& child : children_) {
+    child->OnShow();
+  }
+}
+
+/// @brief Release what is kept to render faster, like the element reused by
+/// Memo or the layer of a Window. It is rendered again by the next Render().
+/// The default implementation dispatch it to every child.
+/// @ingroup component
+void ComponentBase::ReleaseCache() {
+  for (const Component& child : children_) {
+    child->ReleaseCache();
+  }
+}
+
+/// @brief Request a new animation frame, during which only the OnAnimation()
+/// of this component is called.
+///
+/// While a component's OnAnimation() runs, animation::RequestAnimationFrame()
+/// does this on its behalf. So an Animator in flight only causes its own
+/// component to be animated on the next frames, not the whole tree.
+/// @ingroup component
+void ComponentBase::RequestAnimationFrame() {
+  Private::Request(this);
+  if (auto* screen = ScreenInteractive::Active()) {
+    ScreenInteractive::Private::ScheduleAnimationFrame(*screen);
+  }
+}
+
+/// @brief Draw a new frame after the event being handled, like when the
+/// component handles it. Needed when it changes how the component is drawn
+/// without being handled, like a hover effect, with
+/// ScreenInteractive::LazyRedraw().
+/// @ingroup component
+void ComponentBase::RequestRedraw() {
+  if (auto* screen = ScreenInteractive::Active()) {
+    screen->RequestRedraw();
+  }
+}
+
+// static
+ComponentBase* ComponentBase::Private::Animating() {
+  return g_animating;
+}
+
+// static
+void ComponentBase::Private::Animate(ComponentBase* component,
+                                     animation::Params& params) {
+  ComponentBase* const previous = g_animating;
+  g_animating = component;
+  component->OnAnimation(params);
+  g_animating = previous;
+}
+
+// static
+void ComponentBase::Private::AnimateRequested(animation::Params& params) {
+  g_animated.swap(g_animation_requests);
+  for (ComponentBase* component : g_animated) {
+    if (component != nullptr) {
+      component->animation_requested_ = false;
+    }
+  }
+  // A component might be destroyed by the animation of another one. It is
+  // then replaced by nullptr. The suspended components are not animated.
+  for (size_t i = 0; i < g_animated.size(); ++i) {
+    bool suspended = false;
+    for (const ComponentBase* it = g_animated[i]; it && !suspended;
+         it = it->parent_) {
+      suspended = it->suspended_;
+    }
+    if (g_animated[i] != nullptr && !suspended) {
+      Animate(g_animated[i], params);
+    }
+  }
+  g_animated.clear();
+}
+
+// static
+void ComponentBase::Private::Request(ComponentBase* component) {
+  if (component->animation_requested_) {
+    return;
+  }
+  component->animation_requested_ = true;
+  g_animation_requests.push_back(component);
+}
+
+// static
+size_t ComponentBase::Private::RequestCount() {
+  return g_animation_requests.size();
+}
+
+// static
+void ComponentBase::Private::DropRequests(size_t count) {
+  for (size_t i = count; i < g_animation_requests.size(); ++i) {
+    if (g_animation_requests[i] != nullptr) {
+      g_animation_requests[i]->animation_requested_ = false;
+    }
   }
+  g_animation_requests.resize(std::min(count, g_animation_requests.size()));
+}
+
+// static
+void ComponentBase::Private::Suspend(ComponentBase* component, bool suspended) {
+  component->suspended_ = suspended;
+}
+
+// static
+bool ComponentBase::Private::Suspended(const ComponentBase* component) {
+  return component->suspended_;
+}
+
+// static
+void ComponentBase::Private::InvalidateFocus() {
+  g_focus_epoch = NewFocusEpoch();
 }
 
 /// @brief Return the currently Active child.
@@ -156,12 +382,16 @@ Component ComponentBase::ActiveChild() {
 /// keyboard.
 /// @ingroup component
 bool ComponentBase::Focusable() const {
-  for (const Component& child : children_) {  // NOLINT
-    if (child->Focusable()) {
-      return true;
-    }
+  // In a deep tree, this is asked for every level, and might visit the whole
+  // subtree when its first leaves aren't focusable.
+  const uint64_t epoch = g_focus_epoch;
+  if (focusable_epoch_ != epoch) {
+    focusable_ = std::any_of(
+        children_.begin(), children_.end(),
+        [](const Component& child) { return child->Focusable(); });
+    focusable_epoch_ = epoch;
   }
-  return false;
+  return focusable_;
 }
 
 /// @brief Returns if the element if the currently active child of its parent.
@@ -176,11 +406,21 @@ bool ComponentBase::Active() const {
 /// Focusable().
 /// @ingroup component
 bool ComponentBase::Focused() const {
-  const auto* current = this;
-  while (current && current->Active()) {
-    current = current->parent_;
+  return OnFocusPath() && Focusable();
+}
+
+// Every component renders asking whether it is focused. The path is computed
+// once per epoch, instead of walking up to the root for each of them.
+bool ComponentBase::OnFocusPath() const {
+  if (parent_ == nullptr) {
+    return true;
+  }
+  const uint64_t epoch = g_focus_epoch;
+  if (focus_path_epoch_ != epoch) {
+    focus_path_ = parent_->OnFocusPath() && Active();
+    focus_path_epoch_ = epoch;
   }
-  return !current && Focusable();
+  return focus_path_;
 }
 
 /// @brief Make the |child| to be the "active" one.
@@ -192,17 +432,26 @@ void ComponentBase::SetActiveChild([[maybe_unused]] ComponentBase* child) {}
 /// @param child the child to become active.
 /// @ingroup component
 void ComponentBase::SetActiveChild(Component child) {  // NOLINT
+  if (ActiveChild() != child) {
+    RequestRedraw();
+  }
   SetActiveChild(child.get());
+  Private::InvalidateFocus();
 }
 
 /// @brief Configure all the ancestors to give focus to this component.
 /// @ingroup component
 void ComponentBase::TakeFocus() {
+  // Moving the focus changes how the components are drawn.
+  if (!OnFocusPath()) {
+    RequestRedraw();
+  }
   ComponentBase* child = this;
   while (ComponentBase* parent = child->parent_) {
     parent->SetActiveChild(child);
     child = parent;
   }
+  Private::InvalidateFocus();
 }
 
 /// @brief Take the CapturedMouse if available. There is only one component of
@@ -216,4 +465,16 @@ CapturedMouse ComponentBase::CaptureMouse(const Event& event) {  // NOLINT
   return std::make_unique<CaptureMouseImpl>();
 }
 
+// static
+bool ComponentBase::Routed(const Event& event) {
+  return event.screen_ &&
+         ScreenInteractive::Private::RoutedEvents(*event.screen_);
+}
+
+// static
+bool ComponentBase::MouseCaptured(const Event& event) {
+  return event.screen_ &&
+         ScreenInteractive::Private::MouseCaptured(*event.screen_);
+}
+
 }  // namespace ftxui
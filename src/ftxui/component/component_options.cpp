@@ -3,6 +3,7 @@
 // the LICENSE file.
 #include "ftxui/component/component_options.hpp"
 
+#include <algorithm>  // for max, min
 #include <cstdint>
 #include <ftxui/screen/color.hpp>  // for Color, Color::White, Color::Black, Color::GrayDark, Color::Blue, Color::GrayLight, Color::Red
 #include <memory>                  // for shared_ptr
@@ -10,6 +11,7 @@
 #include "ftxui/component/animation.hpp"  // for Function, Duration
 #include "ftxui/dom/direction.hpp"
 #include "ftxui/dom/elements.hpp"  // for operator|=, Element, text, bgcolor, inverted, bold, dim, operator|, color, borderEmpty, hbox, automerge, border, borderLight
+#include "ftxui/dom/static_decorator.hpp"  // for StaticDecorator, operator|=
 
 namespace ftxui {
 
@@ -70,11 +72,12 @@ void UnderlineOption::SetAnimationFunction(
 }
 
 bool RedrawVariables::operator==(const RedrawVariables& other) const {
-  return items_produced == other.items_produced && items_total == other.items_total && component_height == other.component_height && screen_height == other.screen_height;
+  return items_produced == other.items_produced && items_total == other.items_total && component_height == other.component_height && component_width == other.component_width && screen_height == other.screen_height;
 }
 
 void DataSource::set_screen_height(int height) {
-  if (height != v.screen_height) { should_redraw = true; }
+  // The rows are produced for the height assigned during layout. The screen
+  // height alone doesn't require a redraw.
   v.screen_height = height;
 }
 void DataSource::set_component_height(int height) {
@@ -85,7 +88,84 @@ void DataSource::invoke_redraw() {
   // protect against infinite redraws
   if (v == last_v) { return; }
   last_v = v;
-  ScreenInteractive::Active()->PostEvent(Event::Custom);
+  if (ScreenInteractive::Active() != nullptr) {
+    ScreenInteractive::Active()->PostEvent(Event::Custom);
+  }
+}
+void DataSource::invalidate_row(int64_t id) {
+  invalidated_rows.push_back(id);
+}
+void DataSource::invalidate_rows() {
+  invalidated_rows.clear();
+  rows_version++;
+}
+bool DataSource::random_access() const {
+  return id_to_index && index_to_id;
+}
+bool DataSource::variable_height() const {
+  return item_height && random_access();
+}
+void DataSource::update_heights() {
+  const int64_t total = dataset_size().total;
+  if (int64_t(height_tree.size()) == total + 1) {
+    return;
+  }
+  // Build the tree in O(n), each node adding itself to its parent.
+  height_tree.assign(total + 1, 0);
+  for (int64_t i = 1; i <= total; ++i) {
+    height_tree[i] += std::max(1, item_height(i - 1));
+    const int64_t parent = i + (i & -i);
+    if (parent <= total) {
+      height_tree[parent] += height_tree[i];
+    }
+  }
+}
+void DataSource::invalidate_height(int64_t id) {
+  const int64_t index = id_to_index(id);
+  if (index < 0 || index + 1 >= int64_t(height_tree.size())) {
+    return;
+  }
+  const int64_t delta = std::max(1, item_height(index)) -
+                        (rows_before(index + 1) - rows_before(index));
+  for (int64_t i = index + 1; i < int64_t(height_tree.size()); i += i & -i) {
+    height_tree[i] += delta;
+  }
+}
+void DataSource::invalidate_heights() {
+  height_tree.clear();
+}
+int64_t DataSource::rows_before(int64_t index) const {
+  index = std::min(index, int64_t(height_tree.size()) - 1);
+  int64_t rows = 0;
+  for (int64_t i = index; i > 0; i -= i & -i) {
+    rows += height_tree[i];
+  }
+  return rows;
+}
+int64_t DataSource::index_at_row(int64_t row) const {
+  const int64_t size = int64_t(height_tree.size()) - 1;
+  if (size <= 0) {
+    return 0;
+  }
+  // Descend the tree, skipping the items ending before |row|.
+  int64_t step = 1;
+  while (step * 2 <= size) {
+    step *= 2;
+  }
+  int64_t index = 0;
+  for (; step > 0; step /= 2) {
+    if (index + step <= size && height_tree[index + step] <= row) {
+      index += step;
+      row -= height_tree[index];
+    }
+  }
+  return std::min(index, size - 1);
+}
+int64_t DataSource::rows_total() const {
+  return rows_before(int64_t(height_tree.size()) - 1);
+}
+bool DataSource::columns() const {
+  return column_count && cell;
 }
 
 DataSource::DataSource() {
@@ -106,13 +186,13 @@ MenuOption MenuOption::Horizontal() {
   option.entries_option.transform = [](const EntryState& state) {
     Element e = text(state.label);
     if (state.focused) {
-      e |= inverted;
+      e |= StaticDecorator(inverted);
     }
     if (state.active) {
-      e |= bold;
+      e |= StaticDecorator(bold);
     }
     if (!state.focused && !state.active) {
-      e |= dim;
+      e |= StaticDecorator(dim);
     }
     return e;
   };
@@ -140,13 +220,13 @@ MenuOption MenuOption::Vertical() {
   option.entries_option.transform = [](const EntryState& state) {
     Element e = text((state.active ? "> " : "  ") + state.label);  // NOLINT
     if (state.focused) {
-      e |= inverted;
+      e |= StaticDecorator(inverted);
     }
     if (state.active) {
-      e |= bold;
+      e |= StaticDecorator(bold);
     }
     if (!state.focused && !state.active) {
-      e |= dim;
+      e |= StaticDecorator(dim);
     }
     return e;
   };
@@ -162,13 +242,13 @@ MenuOption MenuOption::VerticalAnimated() {
   option.entries_option.transform = [](const EntryState& state) {
     Element e = text(state.label);
     if (state.focused) {
-      e |= inverted;
+      e |= StaticDecorator(inverted);
     }
     if (state.active) {
-      e |= bold;
+      e |= StaticDecorator(bold);
     }
     if (!state.focused && !state.active) {
-      e |= dim;
+      e |= StaticDecorator(dim);
     }
     return e;
   };
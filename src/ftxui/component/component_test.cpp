@@ -2,6 +2,7 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 #include <memory>  // for shared_ptr, __shared_ptr_access, allocator, __shared_ptr_access<>::element_type, make_shared
+#include <vector>  // for vector
 
 #include "ftxui/component/component.hpp"       // for Make
 #include "ftxui/component/component_base.hpp"  // for ComponentBase, Component
@@ -76,6 +77,39 @@ TEST(ContainerTest, Detach) {
   EXPECT_EQ(child_3->Parent(), nullptr);
 }
 
+TEST(ContainerTest, DetachMany) {
+  auto parent = Make();
+  std::vector<Component> children;
+  for (int i = 0; i < 100; ++i) {
+    children.push_back(Make());
+    parent->Add(children.back());
+  }
+
+  // Detach every third child, then check the positions of the others.
+  std::vector<Component> kept;
+  for (int i = 0; i < 100; ++i) {
+    if (i % 3 == 0) {
+      children[i]->Detach();
+      EXPECT_EQ(children[i]->Index(), -1);
+    } else {
+      kept.push_back(children[i]);
+    }
+  }
+  ASSERT_EQ(parent->ChildCount(), kept.size());
+  for (size_t i = 0; i < kept.size(); ++i) {
+    EXPECT_EQ(kept[i]->Index(), int(i));
+    EXPECT_EQ(parent->ChildAt(i), kept[i]);
+  }
+
+  // Prepended children shift the others.
+  auto first = Make();
+  parent->Prepend(&first, &first + 1);
+  EXPECT_EQ(first->Index(), 0);
+  EXPECT_EQ(kept.back()->Index(), int(kept.size()));
+  kept.back()->Detach();
+  EXPECT_EQ(parent->ChildCount(), kept.size());
+}
+
 TEST(ContainerTest, DetachAllChildren) {
   auto parent = Make();
   auto child_1 = Make();
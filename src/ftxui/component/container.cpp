@@ -1,13 +1,15 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <algorithm>  // for max, min
+#include <algorithm>  // for max, min, partition_point
 #include <cstddef>    // for size_t
 #include <memory>  // for make_shared, __shared_ptr_access, allocator, shared_ptr, allocator_traits<>::value_type
 #include <utility>  // for move
+#include <vector>   // for vector
 
 #include "ftxui/component/component.hpp"  // for Horizontal, Vertical, Tab
 #include "ftxui/component/component_base.hpp"  // for Components, Component, ComponentBase
+#include "ftxui/component/component_options.hpp"  // for TabOption
 #include "ftxui/component/event.hpp"  // for Event, Event::Tab, Event::TabReverse, Event::ArrowDown, Event::ArrowLeft, Event::ArrowRight, Event::ArrowUp, Event::End, Event::Home, Event::PageDown, Event::PageUp
 #include "ftxui/component/mouse.hpp"  // for Mouse, Mouse::WheelDown, Mouse::WheelUp
 #include "ftxui/dom/elements.hpp"  // for text, Elements, operator|, reflect, Element, hbox, vbox
@@ -26,19 +28,16 @@ class ContainerBase : public ComponentBase {
 
   // Component override.
   bool OnEvent(Event event) override {
-    if (event.is_mouse()) {
-      return OnMouseEvent(event);
-    }
-
-    if (!Focused()) {
-      return false;
+    // The state of the components might have changed since the last event.
+    if (Parent() == nullptr) {
+      Private::InvalidateFocus();
     }
-
-    if (ActiveChild() && ActiveChild()->OnEvent(event)) {
+    // Handling the event might change the focus.
+    if (DispatchEvent(std::move(event))) {
+      Private::InvalidateFocus();
       return true;
     }
-
-    return EventHandler(event);
+    return false;
   }
 
   Component ActiveChild() override {
@@ -53,12 +52,30 @@ class ContainerBase : public ComponentBase {
     for (size_t i = 0; i < children_.size(); ++i) {
       if (children_[i].get() == child) {
         *selector_ = static_cast<int>(i);
+        Private::InvalidateFocus();
         return;
       }
     }
   }
 
  protected:
+  bool DispatchEvent(Event event) {
+    if (event.is_mouse()) {
+      return OnMouseEvent(event);
+    }
+
+    if (!Focused()) {
+      return false;
+    }
+
+    const Component active_child = ActiveChild();
+    if (active_child && active_child->OnEvent(event)) {
+      return true;
+    }
+
+    return EventHandler(event);
+  }
+
   // Handlers
   virtual bool EventHandler(Event /*unused*/) { return false; }  // NOLINT
 
@@ -66,9 +83,69 @@ class ContainerBase : public ComponentBase {
     return ComponentBase::OnEvent(std::move(event));
   }
 
+  // Record the box of the child |index|, once the mouse events are routed.
+  Element ReflectChild(Element element, size_t index) {
+    if (!route_mouse_) {
+      return element;
+    }
+    children_box_.resize(children_.size());
+    return std::move(element) | reflect(children_box_[index]);
+  }
+
+  // Forward the mouse |event| to the child under the mouse only, instead of
+  // every child. The one having received the previous event gets it first, so
+  // it notices the mouse leaving, and keeps receiving the events while it
+  // captures the mouse. See ScreenInteractive::RoutedEvents().
+  bool RouteMouseEvent(Event event, bool horizontal) {
+    route_mouse_ = true;
+    if (children_box_.size() != children_.size()) {
+      return ComponentBase::OnEvent(std::move(event));
+    }
+
+    // The children are laid out one after the other, so are their boxes.
+    const int x = event.mouse().x;
+    const int y = event.mouse().y;
+    const auto begin = children_box_.begin();
+    const auto end = children_box_.end();
+    const auto it =
+        horizontal
+            ? std::partition_point(
+                  begin, end, [x](const Box& box) { return box.x_max < x; })
+            : std::partition_point(
+                  begin, end, [y](const Box& box) { return box.y_max < y; });
+    Component hovered;
+    if (it != end && it->Contain(x, y)) {
+      hovered = children_[size_t(it - begin)];
+    }
+
+    Component previous;
+    if (mouse_child_index_ < children_.size() &&
+        children_[mouse_child_index_].get() == mouse_child_) {
+      previous = children_[mouse_child_index_];
+    }
+
+    if (!MouseCaptured(event)) {
+      mouse_child_ = hovered.get();
+      mouse_child_index_ = hovered ? size_t(it - begin) : 0;
+    }
+
+    if (previous && previous != hovered && previous->OnEvent(event)) {
+      return true;
+    }
+    return hovered && hovered->OnEvent(event);
+  }
+
   int selected_ = 0;
   int* selector_ = nullptr;
 
+  // Routed mouse events:
+  bool route_mouse_ = false;
+  std::vector<Box> children_box_;
+  // The child having received the last mouse event. Only compared, never
+  // dereferenced, as it might have been removed since.
+  ComponentBase* mouse_child_ = nullptr;
+  size_t mouse_child_index_ = 0;
+
   void MoveSelector(int dir) {
     for (int i = *selector_ + dir; i >= 0 && i < int(children_.size());
          i += dir) {
@@ -99,10 +176,13 @@ class VerticalContainer : public ContainerBase {
   using ContainerBase::ContainerBase;
 
   Element Render() override {
+    if (Parent() == nullptr) {
+      Private::InvalidateFocus();
+    }
     Elements elements;
     elements.reserve(children_.size());
-    for (auto& it : children_) {
-      elements.push_back(it->Render());
+    for (size_t i = 0; i < children_.size(); ++i) {
+      elements.push_back(ReflectChild(children_[i]->Render(), i));
     }
     if (elements.empty()) {
       return text("Empty container") | reflect(box_);
@@ -150,7 +230,9 @@ class VerticalContainer : public ContainerBase {
   }
 
   bool OnMouseEvent(Event event) override {
-    if (ContainerBase::OnMouseEvent(event)) {
+    const bool handled = Routed(event) ? RouteMouseEvent(event, false)
+                                       : ContainerBase::OnMouseEvent(event);
+    if (handled) {
       return true;
     }
 
@@ -182,10 +264,13 @@ class HorizontalContainer : public ContainerBase {
   using ContainerBase::ContainerBase;
 
   Element Render() override {
+    if (Parent() == nullptr) {
+      Private::InvalidateFocus();
+    }
     Elements elements;
     elements.reserve(children_.size());
-    for (auto& it : children_) {
-      elements.push_back(it->Render());
+    for (size_t i = 0; i < children_.size(); ++i) {
+      elements.push_back(ReflectChild(children_[i]->Render(), i));
     }
     if (elements.empty()) {
       return text("Empty container");
@@ -211,13 +296,25 @@ class HorizontalContainer : public ContainerBase {
     *selector_ = std::max(0, std::min(int(children_.size()) - 1, *selector_));
     return old_selected != *selector_;
   }
+
+  bool OnMouseEvent(Event event) override {
+    if (Routed(event)) {
+      return RouteMouseEvent(std::move(event), true);
+    }
+    return ContainerBase::OnMouseEvent(std::move(event));
+  }
 };
 
 class TabContainer : public ContainerBase {
  public:
-  using ContainerBase::ContainerBase;
+  TabContainer(Components children, int* selector, TabOption option)
+      : ContainerBase(std::move(children), selector), option_(option) {}
 
   Element Render() override {
+    if (Parent() == nullptr) {
+      Private::InvalidateFocus();
+    }
+    Suspend();
     const Component active_child = ActiveChild();
     if (active_child) {
       return active_child->Render();
@@ -232,9 +329,59 @@ class TabContainer : public ContainerBase {
     return children_[size_t(*selector_) % children_.size()]->Focusable();
   }
 
+  bool OnEvent(Event event) override {
+    Suspend();
+    return ContainerBase::OnEvent(std::move(event));
+  }
+
+  void OnAnimation(animation::Params& params) override {
+    if (!option_.suspend_inactive) {
+      ContainerBase::OnAnimation(params);
+      return;
+    }
+    Suspend();
+    if (const Component active_child = ActiveChild()) {
+      Private::Animate(active_child.get(), params);
+    }
+  }
+
   bool OnMouseEvent(Event event) override {
     return ActiveChild() && ActiveChild()->OnEvent(event);
   }
+
+ private:
+  // Suspend the children not selected, and resume the one selected. The
+  // selector can be changed from anywhere: this is checked before rendering,
+  // and handling events or animations.
+  void Suspend() {
+    if (!option_.suspend_inactive) {
+      return;
+    }
+    ComponentBase* const active_child = ActiveChild().get();
+    for (const Component& child : children_) {
+      const bool suspended = child.get() != active_child;
+      if (Private::Suspended(child.get()) == suspended) {
+        continue;
+      }
+      Private::Suspend(child.get(), suspended);
+      if (!suspended) {
+        // Its animations in flight were dropped. They request new frames
+        // once animated again.
+        child->OnShow();
+        child->RequestAnimationFrame();
+      } else if (child.get() == shown_) {
+        child->OnHide();
+        if (option_.release_cache) {
+          child->ReleaseCache();
+        }
+      }
+    }
+    shown_ = active_child;
+  }
+
+  TabOption option_;
+  // The child displayed last.
+  ComponentBase* shown_ = nullptr;
 };
 
 class StackedContainer : public ContainerBase {
@@ -244,6 +391,9 @@ class StackedContainer : public ContainerBase {
 
  private:
   Element Render() final {
+    if (Parent() == nullptr) {
+      Private::InvalidateFocus();
+    }
     Elements elements;
     for (auto& child : children_) {
       elements.push_back(child->Render());
@@ -253,15 +403,6 @@ class StackedContainer : public ContainerBase {
     return dbox(std::move(elements));
   }
 
-  bool Focusable() const final {
-    for (const auto& child : children_) {
-      if (child->Focusable()) {
-        return true;
-      }
-    }
-    return false;
-  }
-
   Component ActiveChild() final {
     if (children_.empty()) {
       return nullptr;
@@ -283,11 +424,16 @@ class StackedContainer : public ContainerBase {
       return;
     }
     std::rotate(children_.begin(), it, it + 1);
+    Private::InvalidateFocus();
   }
 
   bool OnEvent(Event event) final {
+    if (Parent() == nullptr) {
+      Private::InvalidateFocus();
+    }
     for (auto& child : children_) {
       if (child->OnEvent(event)) {
+        Private::InvalidateFocus();
         return true;
       }
     }
@@ -402,7 +548,32 @@ Component Horizontal(Components children, int* selector) {
 /// }, &tab_drawn);
 /// ```
 Component Tab(Components children, int* selector) {
-  return std::make_shared<TabContainer>(std::move(children), selector);
+  return std::make_shared<TabContainer>(std::move(children), selector,
+                                        TabOption());
+}
+
+/// @brief A list of components, where only one is drawn and interacted with at
+/// a time. With |option.suspend_inactive|, the others aren't animated either,
+/// and are told with OnHide() and OnShow() when they are left and selected
+/// again, for instance to pause fetching their data.
+/// @param children The list of components.
+/// @param selector The index of the drawn children.
+/// @param option Whether the children not drawn are suspended.
+/// @ingroup component
+/// @see ContainerBase
+///
+/// ### Example
+///
+/// ```cpp
+/// int tab_drawn = 0;
+/// auto container = Container::Tab({
+///   children_1,
+///   children_2,
+///   children_3,
+/// }, &tab_drawn, {.suspend_inactive = true, .release_cache = true});
+/// ```
+Component Tab(Components children, int* selector, TabOption option) {
+  return std::make_shared<TabContainer>(std::move(children), selector, option);
 }
 
 /// @brief A list of components to be stacked on top of each other.
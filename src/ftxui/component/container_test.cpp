@@ -2,8 +2,16 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 
+#include <algorithm>   // for count_if
+#include <chrono>      // for operator""s
+#include <functional>  // for function
+#include <memory>      // for make_shared
+#include <vector>      // for vector
+
 #include "ftxui/component/component.hpp"  // for Horizontal, Vertical, Button, Tab
+#include "ftxui/component/animation.hpp"  // for Params
 #include "ftxui/component/component_base.hpp"  // for ComponentBase, Component
+#include "ftxui/component/component_options.hpp"  // for TabOption
 #include "ftxui/component/event.hpp"  // for Event, Event::Tab, Event::TabReverse, Event::ArrowDown, Event::ArrowLeft, Event::ArrowRight, Event::ArrowUp
 #include "gtest/gtest.h"  // for AssertionResult, Message, TestPartResult, EXPECT_EQ, EXPECT_FALSE, Test, EXPECT_TRUE, TEST
 
@@ -334,4 +342,135 @@ TEST(ContainerTest, TabFocusable) {
   EXPECT_FALSE(c->Focused());
 }
 
+TEST(ContainerTest, FocusableCache) {
+  bool show_1 = false;
+  bool show_2 = true;
+  auto c1 = Focusable();
+  auto c2 = Focusable();
+  auto c3 = Focusable();
+  auto c = Container::Vertical({
+      Container::Horizontal({Maybe(c1, &show_1)}),
+      Container::Horizontal({Maybe(c2, &show_2)}),
+      Container::Horizontal({c3}),
+  });
+
+  // The hidden child is skipped.
+  c->OnEvent(Event::ArrowDown);
+  c->OnEvent(Event::ArrowUp);
+  EXPECT_TRUE(c2->Focused());
+  EXPECT_FALSE(c1->Focused());
+
+  // Changing a condition is noticed by the next event.
+  show_1 = true;
+  show_2 = false;
+  c->OnEvent(Event::ArrowUp);
+  EXPECT_TRUE(c1->Focused());
+  c->OnEvent(Event::ArrowDown);
+  EXPECT_TRUE(c3->Focused());
+  EXPECT_FALSE(c2->Focused());
+
+  // Adding and removing children too.
+  auto c4 = Focusable();
+  c->ChildAt(1)->Add(c4);
+  c->OnEvent(Event::ArrowUp);
+  EXPECT_FALSE(c3->Focused());
+  c->OnEvent(Event::ArrowRight);
+  EXPECT_TRUE(c4->Focused());
+  c4->Detach();
+  EXPECT_FALSE(c->ChildAt(1)->Focusable());
+}
+
+TEST(ContainerTest, FocusDeepTree) {
+  // 5 levels of containers, with 4 children each.
+  Components leaves;
+  std::function<Component(int)> build = [&](int depth) -> Component {
+    if (depth == 5) {
+      leaves.push_back(Focusable());
+      return leaves.back();
+    }
+    Components children;
+    for (int i = 0; i < 4; ++i) {
+      children.push_back(build(depth + 1));
+    }
+    return depth % 2 ? Container::Horizontal(std::move(children))
+                     : Container::Vertical(std::move(children));
+  };
+  auto root = build(0);
+  ASSERT_EQ(leaves.size(), 1024u);
+
+  auto focused_count = [&] {
+    return std::count_if(leaves.begin(), leaves.end(),
+                         [](const Component& leaf) { return leaf->Focused(); });
+  };
+  EXPECT_TRUE(leaves[0]->Focused());
+  EXPECT_EQ(focused_count(), 1);
+
+  leaves[777]->TakeFocus();
+  EXPECT_TRUE(leaves[777]->Focused());
+  EXPECT_EQ(focused_count(), 1);
+
+  // 777 is the leaf {3,0,0,2,1} in base 4. The even levels are vertical.
+  root->OnEvent(Event::ArrowDown);
+  EXPECT_TRUE(leaves[778]->Focused());
+  root->OnEvent(Event::ArrowRight);
+  EXPECT_TRUE(leaves[780]->Focused());
+  root->OnEvent(Event::ArrowUp);
+  EXPECT_TRUE(leaves[512]->Focused());
+  EXPECT_EQ(focused_count(), 1);
+}
+
+TEST(ContainerTest, TabSuspendInactive) {
+  using namespace std::chrono_literals;
+
+  class Probe : public ComponentBase {
+   public:
+    void OnAnimation(animation::Params& /*params*/) override { animated++; }
+    void OnHide() override { hidden++; }
+    void OnShow() override { shown++; }
+    void ReleaseCache() override { released++; }
+    int animated = 0;
+    int hidden = 0;
+    int shown = 0;
+    int released = 0;
+  };
+  std::vector<std::shared_ptr<Probe>> probes = {
+      std::make_shared<Probe>(),
+      std::make_shared<Probe>(),
+      std::make_shared<Probe>(),
+  };
+  int selected = 0;
+  auto tab = Container::Tab({probes[0], probes[1], probes[2]}, &selected,
+                            {.suspend_inactive = true, .release_cache = true});
+
+  animation::Params params(1s);
+  tab->Render();
+  tab->OnAnimation(params);
+  EXPECT_EQ(probes[0]->animated, 1);
+  EXPECT_EQ(probes[1]->animated, 0);
+  EXPECT_EQ(probes[2]->animated, 0);
+
+  // The tab left is told, and releases its cache. The one selected is resumed,
+  // and animated.
+  selected = 1;
+  tab->Render();
+  EXPECT_EQ(probes[0]->hidden, 1);
+  EXPECT_EQ(probes[0]->released, 1);
+  EXPECT_EQ(probes[1]->shown, 1);
+  EXPECT_EQ(probes[2]->hidden, 0);
+  ComponentBase::Private::AnimateRequested(params);
+  EXPECT_EQ(probes[1]->animated, 1);
+
+  // The animation frames requested by a suspended tab are dropped.
+  probes[0]->RequestAnimationFrame();
+  ComponentBase::Private::AnimateRequested(params);
+  EXPECT_EQ(probes[0]->animated, 1);
+
+  // Without the option, every tab is animated.
+  auto all = Container::Tab({std::make_shared<Probe>()}, &selected);
+  auto probe = std::make_shared<Probe>();
+  all->Add(probe);
+  all->OnAnimation(params);
+  EXPECT_EQ(probe->animated, 1);
+}
+
 }  // namespace ftxui
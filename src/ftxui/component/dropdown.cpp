@@ -2,19 +2,43 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 #include <ftxui/component/event.hpp>
+#include <algorithm>   // for lower_bound, min, sort
+#include <cctype>      // for tolower
+#include <cstdint>     // for int64_t
 #include <functional>  // for function
 #include <string>      // for string
+#include <utility>     // for pair
+#include <vector>      // for vector
 
-#include <utility>
-#include "ftxui/component/component.hpp"  // for Maybe, Checkbox, Make, Radiobox, Vertical, Dropdown
+#include "ftxui/component/component.hpp"  // for Maybe, Checkbox, Make, Radiobox, Vertical, Dropdown, DBMenu
 #include "ftxui/component/component_base.hpp"  // for Component, ComponentBase
-#include "ftxui/component/component_options.hpp"  // for CheckboxOption, EntryState
+#include "ftxui/component/component_options.hpp"  // for CheckboxOption, EntryState, DataSource
+#include "ftxui/component/mouse.hpp"  // for Mouse, Mouse::Left, Mouse::Pressed
 #include "ftxui/dom/elements.hpp"  // for operator|, Element, border, filler, operator|=, separator, size, text, vbox, frame, vscroll_indicator, hbox, HEIGHT, LESS_THAN, bold, inverted
 #include "ftxui/screen/util.hpp"   // for clamp
 #include "ftxui/util/ref.hpp"      // for ConstStringListRef
 
 namespace ftxui {
 
+namespace {
+
+// The maximum height of the list of an open dropdown.
+constexpr int kDropdownMaxHeight = 12;
+
+Element DropdownCheckboxTransform(const EntryState& s) {
+  auto prefix = text(s.state ? "↓ " : "→ ");  // NOLINT
+  auto t = text(s.label);
+  if (s.active) {
+    t |= bold;
+  }
+  if (s.focused) {
+    t |= inverted;
+  }
+  return hbox({prefix, t});
+}
+
+}  // namespace
+
 /// @brief A dropdown menu.
 /// @ingroup component
 /// @param entries The list of entries to display.
@@ -89,29 +113,18 @@ Component Dropdown(DropdownOption option) {
       checkbox.label = &title_;
 
       if (!checkbox.transform) {
-        checkbox.transform = [](const EntryState& s) {
-          auto prefix = text(s.state ? "↓ " : "→ ");  // NOLINT
-          auto t = text(s.label);
-          if (s.active) {
-            t |= bold;
-          }
-          if (s.focused) {
-            t |= inverted;
-          }
-          return hbox({prefix, t});
-        };
+        checkbox.transform = DropdownCheckboxTransform;
       }
 
       if (!transform) {
         transform = [](bool is_open, Element checkbox_element,
                        Element radiobox_element) {
           if (is_open) {
-            const int max_height = 12;
             return vbox({
                        std::move(checkbox_element),
                        separator(),
                        std::move(radiobox_element) | vscroll_indicator | frame |
-                           size(HEIGHT, LESS_THAN, max_height),
+                           size(HEIGHT, LESS_THAN, kDropdownMaxHeight),
                    }) |
                    border;
           }
@@ -131,4 +144,213 @@ Component Dropdown(DropdownOption option) {
   return Make<Impl>(option);
 }
 
+/// @brief A dropdown menu, for long lists of entries.
+/// @ingroup component
+/// @param entries The list of entries to display.
+/// @param selected The index of the selected entry.
+Component DBDropdown(ConstStringListRef entries, int* selected) {
+  DropdownOption option;
+  option.radiobox.entries = std::move(entries);
+  option.radiobox.selected = selected;
+  return DBDropdown(option);
+}
+
+/// @brief A dropdown menu, for long lists of entries. Unlike Dropdown(), the
+/// open list is a DBMenu: only the visible entries are rendered.
+///
+/// While the list is open, typing characters focuses the first entry starting
+/// with them, ignoring the case. The entries are sorted on the first
+/// keystroke, then every keystroke is a binary search. They are sorted again
+/// when their number changes.
+/// @ingroup component
+/// @param option The options for the dropdown. The entries are rendered using
+/// `radiobox.transform`.
+// NOLINTNEXTLINE
+Component DBDropdown(DropdownOption option) {
+  class Impl : public ComponentBase, public DropdownOption {
+   public:
+    explicit Impl(DropdownOption option) : DropdownOption(std::move(option)) {
+      FillDefault();
+      checkbox_ = Checkbox(checkbox);
+      menu_ = DBMenu(&source_);
+
+      Add(Container::Vertical({
+          checkbox_,
+          Maybe(menu_, &*open_),
+      }));
+    }
+
+    Element Render() override {
+      const int size = int(radiobox.entries.size());
+      selected_() = util::clamp(selected_(), 0, size - 1);
+      title_ = size ? radiobox.entries[selected_()] : "";
+      source_.min_y = std::max(1, std::min(size, kDropdownMaxHeight));
+
+      return transform(*open_, checkbox_->Render(),
+                       *open_ ? menu_->Render() : text(""));
+    }
+
+    bool OnEvent(Event event) override {
+      if (*open_ && menu_->Active()) {
+        // A space continues the characters typed, if any.
+        if (event == Event::Return ||
+            (event == Event::Character(' ') && prefix_.empty())) {
+          Select(source_.focused_id);
+          return true;
+        }
+        if (event == Event::Escape) {
+          Close();
+          return true;
+        }
+        if (event.is_character()) {
+          return TypeAhead(event.character());
+        }
+      }
+      if (!event.is_mouse()) {
+        prefix_.clear();
+      }
+
+      const bool open_old = *open_;
+      const bool handled = ComponentBase::OnEvent(event);
+
+      // Open the list on the selected entry.
+      if (!open_old && *open_) {
+        source_.focused_id = selected_();
+        menu_->TakeFocus();
+      }
+
+      // Clicking an entry selects it.
+      if (open_old && *open_ && handled && menu_->Active() &&
+          event.is_mouse() && event.mouse().button == Mouse::Left &&
+          event.mouse().motion == Mouse::Pressed) {
+        Select(source_.focused_id);
+      }
+      return handled;
+    }
+
+    void FillDefault() {
+      open_ = checkbox.checked;
+      selected_ = radiobox.selected;
+      checkbox.checked = &*open_;
+      checkbox.label = &title_;
+
+      if (!checkbox.transform) {
+        checkbox.transform = DropdownCheckboxTransform;
+      }
+      if (!radiobox.transform) {
+        radiobox.transform = RadioboxOption::Simple().transform;
+      }
+
+      if (!transform) {
+        // The list is as high as its entries, up to kDropdownMaxHeight.
+        transform = [this](bool is_open, Element checkbox_element,
+                           Element menu_element) {
+          if (is_open) {
+            return vbox({
+                       std::move(checkbox_element),
+                       separator(),
+                       std::move(menu_element) |
+                           size(HEIGHT, EQUAL, source_.min_y),
+                   }) |
+                   border;
+          }
+          return vbox({std::move(checkbox_element), filler()}) | border;
+        };
+      }
+
+      // The ids of the DataSource are the indices of the entries.
+      source_.dataset_size = [this] {
+        const auto size = int64_t(radiobox.entries.size());
+        return DataSize{size, 0, size - 1};
+      };
+      source_.count_items_before = [](int64_t id) { return id; };
+      source_.move_id_by = [this](int64_t& id, int64_t offset) {
+        const int64_t initial = id;
+        const auto last = int64_t(radiobox.entries.size()) - 1;
+        id = std::max<int64_t>(0, std::min(id + offset, last));
+        return id != initial;
+      };
+      source_.id_to_index = [](int64_t id) { return id; };
+      source_.index_to_id = [](int64_t index) { return index; };
+      source_.on_event = [](DSEventContext context) {
+        return context.handled;
+      };
+      source_.transform = [this](DSRenderContext& context) {
+        const int index = int(context.id);
+        return radiobox.transform({
+            radiobox.entries[index],
+            index == selected_(),
+            context.focused,
+            context.focused && context.component_focused,
+            index,
+        });
+      };
+    }
+
+   private:
+    void Select(int64_t id) {
+      const int selected_old = selected_();
+      selected_() = int(id);
+      Close();
+      if (selected_() != selected_old && radiobox.on_change) {
+        radiobox.on_change();
+      }
+    }
+
+    void Close() {
+      *open_ = false;
+      prefix_.clear();
+      checkbox_->TakeFocus();
+    }
+
+    static std::string Fold(std::string input) {
+      for (char& c : input) {
+        c = char(std::tolower(static_cast<unsigned char>(c)));
+      }
+      return input;
+    }
+
+    // Focus the first entry starting with the characters typed, or else with
+    // |character| alone.
+    bool TypeAhead(const std::string& character) {
+      if (index_.size() != radiobox.entries.size()) {
+        index_.clear();
+        index_.reserve(radiobox.entries.size());
+        for (size_t i = 0; i < radiobox.entries.size(); ++i) {
+          index_.emplace_back(Fold(radiobox.entries[i]), int(i));
+        }
+        std::sort(index_.begin(), index_.end());
+      }
+
+      for (std::string prefix : {prefix_ + character, character}) {
+        prefix = Fold(prefix);
+        const auto it = std::lower_bound(
+            index_.begin(), index_.end(), prefix,
+            [](const std::pair<std::string, int>& entry,
+               const std::string& value) { return entry.first < value; });
+        if (it != index_.end() &&
+            it->first.compare(0, prefix.size(), prefix) == 0) {
+          prefix_ = prefix;
+          source_.focused_id = it->second;
+          return true;
+        }
+      }
+      return false;
+    }
+
+    Ref<bool> open_;
+    Ref<int> selected_;
+    Component checkbox_;
+    Component menu_;
+    DataSource source_;
+    std::string title_;
+
+    // The characters typed, and the folded entries sorted with their index.
+    std::string prefix_;
+    std::vector<std::pair<std::string, int>> index_;
+  };
+
+  return Make<Impl>(option);
+}
+
 }  // namespace ftxui
@@ -0,0 +1,102 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <algorithm>  // for find
+#include <string>     // for string, to_string
+#include <vector>     // for vector
+
+#include "ftxui/component/component.hpp"          // for DBDropdown
+#include "ftxui/component/component_options.hpp"  // for DropdownOption
+#include "ftxui/component/event.hpp"              // for Event
+#include "ftxui/dom/elements.hpp"                 // for text
+#include "ftxui/dom/node.hpp"                     // for Render
+#include "ftxui/screen/screen.hpp"                // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+
+// Entries in no particular order.
+std::vector<std::string> Hosts() {
+  std::vector<std::string> entries;
+  for (int i = 0; i < 50000; ++i) {
+    entries.push_back("Host " + std::to_string(i * 7919 % 50000));
+  }
+  return entries;
+}
+
+int IndexOf(const std::vector<std::string>& entries, const std::string& entry) {
+  return int(std::find(entries.begin(), entries.end(), entry) -
+             entries.begin());
+}
+
+}  // namespace
+
+TEST(DBDropdownTest, RendersVisibleEntries) {
+  std::vector<std::string> entries = Hosts();
+  int selected = 0;
+  int rendered = 0;
+  DropdownOption option;
+  option.radiobox.entries = &entries;
+  option.radiobox.selected = &selected;
+  option.radiobox.transform = [&](const EntryState& state) {
+    rendered++;
+    return text(state.label);
+  };
+  Component dropdown = DBDropdown(option);
+
+  auto screen = Screen(20, 30);
+  Render(screen, dropdown->Render());
+  EXPECT_EQ(rendered, 0);
+
+  EXPECT_TRUE(dropdown->OnEvent(Event::Return));
+  Render(screen, dropdown->Render());
+  EXPECT_GT(rendered, 0);
+  EXPECT_LE(rendered, 2 * 12);
+}
+
+TEST(DBDropdownTest, TypeAhead) {
+  std::vector<std::string> entries = Hosts();
+  int selected = 0;
+  int changes = 0;
+  DropdownOption option;
+  option.radiobox.entries = &entries;
+  option.radiobox.selected = &selected;
+  option.radiobox.on_change = [&] { changes++; };
+  Component dropdown = DBDropdown(option);
+
+  // Typing does nothing while the dropdown is closed.
+  EXPECT_FALSE(dropdown->OnEvent(Event::Character('h')));
+
+  EXPECT_TRUE(dropdown->OnEvent(Event::Return));
+  for (char c : std::string("host 123")) {
+    EXPECT_TRUE(dropdown->OnEvent(Event::Character(c)));
+  }
+  EXPECT_EQ(selected, 0);
+  EXPECT_TRUE(dropdown->OnEvent(Event::Return));
+  EXPECT_EQ(selected, IndexOf(entries, "Host 123"));
+  EXPECT_EQ(changes, 1);
+
+  // The entries following the one typed are reached with the arrows.
+  EXPECT_TRUE(dropdown->OnEvent(Event::Return));
+  for (char c : std::string("Host 4999")) {
+    EXPECT_TRUE(dropdown->OnEvent(Event::Character(c)));
+  }
+  EXPECT_TRUE(dropdown->OnEvent(Event::ArrowDown));
+  EXPECT_TRUE(dropdown->OnEvent(Event::Return));
+  EXPECT_EQ(selected, IndexOf(entries, "Host 4999") + 1);
+
+  // A character not continuing the prefix starts a new one. Escape closes the
+  // dropdown without selecting.
+  EXPECT_TRUE(dropdown->OnEvent(Event::Return));
+  EXPECT_TRUE(dropdown->OnEvent(Event::Character('h')));
+  EXPECT_FALSE(dropdown->OnEvent(Event::Character('x')));
+  EXPECT_TRUE(dropdown->OnEvent(Event::Escape));
+  EXPECT_EQ(selected, IndexOf(entries, "Host 4999") + 1);
+  EXPECT_EQ(changes, 2);
+}
+
+}  // namespace ftxui
+// NOLINTEND
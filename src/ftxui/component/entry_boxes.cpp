@@ -0,0 +1,136 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/component/entry_boxes.hpp"
+
+#include <algorithm>  // for fill, max, min, partition_point
+#include <memory>     // for make_shared
+#include <utility>    // for move
+
+#include "ftxui/dom/node.hpp"         // for Node
+#include "ftxui/dom/requirement.hpp"  // for Requirement
+#include "ftxui/screen/screen.hpp"    // for Screen
+
+namespace ftxui {
+
+// Like reflect(), and measure the entry.
+class EntryReflect : public Node {
+ public:
+  EntryReflect(Element child, EntryBoxes* boxes, int index)
+      : Node(unpack(std::move(child))), boxes_(boxes), index_(index) {}
+
+  void ComputeRequirement() final {
+    Node::ComputeRequirement();
+    requirement_ = children_[0]->requirement();
+    boxes_->width_ = std::max(boxes_->width_, requirement_.min_x);
+    if (requirement_.min_y != 1) {
+      boxes_->single_line_ = false;
+    }
+  }
+
+  void SetBox(Box box) final {
+    // Empty, unless rendered. Elements outside of the stencil aren't.
+    boxes_->boxes_[index_] = Box{0, -1, 0, -1};
+    Node::SetBox(box);
+    children_[0]->SetBox(box);
+  }
+
+  void Render(Screen& screen) final {
+    boxes_->boxes_[index_] = Box::Intersection(screen.stencil, box_);
+    if (boxes_->first_ > boxes_->last_) {
+      boxes_->first_ = boxes_->last_ = index_;
+    } else {
+      boxes_->first_ = std::min(boxes_->first_, index_);
+      boxes_->last_ = std::max(boxes_->last_, index_);
+    }
+    Node::Render(screen);
+  }
+
+ private:
+  EntryBoxes* boxes_;
+  int index_;
+};
+
+void EntryBoxes::Resize(int size) {
+  boxes_.resize(size);
+  last_ = std::min(last_, size - 1);
+  if (first_ > last_) {
+    first_ = 0;
+    last_ = -1;
+  }
+}
+
+bool EntryBoxes::Windowed() const {
+  const int size = int(boxes_.size());
+  return size > kWindowedSize && measured_size_ == size && single_line_;
+}
+
+void EntryBoxes::Clear(bool windowed) {
+  if (!windowed) {
+    measured_size_ = int(boxes_.size());
+    width_ = 0;
+    single_line_ = true;
+  }
+
+  // Only the entries rendered in the last frame can have a box.
+  if (first_ > last_) {
+    return;
+  }
+  std::fill(boxes_.begin() + first_, boxes_.begin() + last_ + 1,
+            Box{0, -1, 0, -1});
+  first_ = 0;
+  last_ = -1;
+}
+
+Decorator EntryBoxes::Reflect(int index) {
+  return [this, index](Element child) -> Element {
+    return std::make_shared<EntryReflect>(std::move(child), this, index);
+  };
+}
+
+int EntryAt(const std::vector<Box>& boxes,
+            int first,
+            int last,
+            Direction direction,
+            int x,
+            int y) {
+  // The boxes are sorted, so a binary search replaces the linear scan. This
+  // matters for the mouse moves, received at a high rate over lists with many
+  // entries.
+  if (first > last) {
+    return -1;
+  }
+  const auto begin = boxes.begin() + first;
+  const auto end = boxes.begin() + last + 1;
+  auto it = end;
+  switch (direction) {
+    case Direction::Down:
+      it = std::partition_point(
+          begin, end, [y](const Box& box) { return box.y_max < y; });
+      break;
+    case Direction::Up:
+      it = std::partition_point(
+          begin, end, [y](const Box& box) { return box.y_min > y; });
+      break;
+    case Direction::Right:
+      it = std::partition_point(
+          begin, end, [x](const Box& box) { return box.x_max < x; });
+      break;
+    case Direction::Left:
+      it = std::partition_point(
+          begin, end, [x](const Box& box) { return box.x_min > x; });
+      break;
+  }
+  if (it == end || !it->Contain(x, y)) {
+    return -1;
+  }
+  return int(it - boxes.begin());
+}
+
+int EntryBoxes::At(Direction direction, int x, int y) const {
+  // The entries rendered are contiguous. The other ones have empty boxes, which
+  // would break the ordering.
+  return EntryAt(boxes_, first_, last_, direction, x, y);
+}
+
+}  // namespace ftxui
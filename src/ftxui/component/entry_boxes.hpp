@@ -0,0 +1,73 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_ENTRY_BOXES_HPP
+#define FTXUI_COMPONENT_ENTRY_BOXES_HPP
+
+#include <vector>  // for vector
+
+#include "ftxui/dom/direction.hpp"  // for Direction
+#include "ftxui/dom/elements.hpp"   // for Decorator
+#include "ftxui/screen/box.hpp"     // for Box
+
+namespace ftxui {
+
+// Return the index of the box in |boxes|[first, last] containing (x,y), or -1.
+// The boxes must be laid out one after the other along |direction|.
+int EntryAt(const std::vector<Box>& boxes,
+            int first,
+            int last,
+            Direction direction,
+            int x,
+            int y);
+
+// The boxes of the entries of a list, like Menu or Radiobox, used for mouse
+// hit-testing. Only the entries rendered in the last frame have a box: the
+// ones outside of the parent frame aren't rendered, and the lists with many
+// entries don't even produce them.
+class EntryBoxes {
+ public:
+  // The number of entries above which a list only produces the visible ones.
+  static constexpr int kWindowedSize = 256;
+
+  void Resize(int size);
+
+  // Whether the list can produce only its visible entries: it has many
+  // entries, measured by a previous frame as single lines.
+  bool Windowed() const;
+
+  // Forget the boxes of the last frame. To call before rendering a new one.
+  // When all the entries are produced, they are measured again.
+  void Clear(bool windowed);
+
+  // Reflect the box of the entry |index| when it is rendered, and measure it.
+  Decorator Reflect(int index);
+
+  // Return the index of the entry containing (x,y), or -1. The entries are
+  // laid out one after the other along |direction|.
+  int At(Direction direction, int x, int y) const;
+
+  // The width of the widest entry measured. A windowed list is given this
+  // width, as if all of its entries were produced.
+  int Width() const { return width_; }
+
+  Box& operator[](int index) { return boxes_[index]; }
+  bool empty() const { return boxes_.empty(); }
+
+ private:
+  friend class EntryReflect;
+
+  std::vector<Box> boxes_;
+  // The range of the entries rendered in the last frame.
+  int first_ = 0;
+  int last_ = -1;
+
+  // The measure of the entries.
+  int measured_size_ = -1;
+  int width_ = 0;
+  bool single_line_ = true;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_ENTRY_BOXES_HPP
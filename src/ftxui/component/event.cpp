@@ -1,7 +1,9 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <map>  // for map
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint64_t, uint8_t
+#include <map>      // for map
 #include <string>
 #include <utility>  // for move
 
@@ -22,13 +24,29 @@
 
 namespace ftxui {
 
+// The inputs of up to 7 bytes, like every key, are packed with their size into
+// |key_|, and compared as integers. The longer ones, like the mouse events,
+// have a zero key, and are compared as strings.
+void Event::SetInput(std::string input) {
+  input_ = std::move(input);
+  key_ = 0;
+  if (input_.empty() || input_.size() > sizeof(key_) - 1) {
+    return;
+  }
+  key_ = input_.size();
+  key_ <<= 56U;  // NOLINT
+  for (size_t i = 0; i < input_.size(); ++i) {
+    key_ |= uint64_t(uint8_t(input_[i])) << (8U * i);  // NOLINT
+  }
+}
+
 /// @brief An event corresponding to a given typed character.
 /// @param input The character typed by the user.
 /// @ingroup component
 // static
 Event Event::Character(std::string input) {
   Event event;
-  event.input_ = std::move(input);
+  event.SetInput(std::move(input));
   event.type_ = Type::Character;
   return event;
 }
@@ -56,29 +74,94 @@ Event Event::Character(wchar_t c) {
 // static
 Event Event::Mouse(std::string input, struct Mouse mouse) {
   Event event;
-  event.input_ = std::move(input);
+  event.SetInput(std::move(input));
   event.type_ = Type::Mouse;
   event.data_.mouse = mouse;  // NOLINT
   return event;
 }
 
+/// @brief An event corresponding to a text pasted into the terminal, while the
+/// bracketed paste mode is enabled.
+/// @param input The text pasted.
+/// @ingroup component
+// static
+Event Event::Paste(std::string input) {
+  Event event;
+  event.SetInput(std::move(input));
+  event.type_ = Type::Paste;
+  return event;
+}
+
 /// @brief An event corresponding to a terminal DCS (Device Control String).
 // static
 Event Event::CursorShape(std::string input, int shape) {
   Event event;
-  event.input_ = std::move(input);
+  event.SetInput(std::move(input));
   event.type_ = Type::CursorShape;
   event.data_.cursor_shape = shape;  // NOLINT
   return event;
 }
 
+/// @brief An event corresponding to a terminal DECRPM (Report Mode), answering
+/// a DECRQM query about a private |mode|.
+/// @param value 0: not recognized, 1: set, 2: reset, 3: permanently set,
+/// 4: permanently reset.
+// static
+Event Event::ModeReport(std::string input, int mode, int value) {
+  Event event;
+  event.SetInput(std::move(input));
+  event.type_ = Type::ModeReport;
+  event.data_.mode_report = {mode, value};  // NOLINT
+  return event;
+}
+
+/// @brief An event corresponding to a terminal Device Attributes report.
+/// @param level 1 for the primary attributes (DA1), 2 for the secondary ones
+/// (DA2).
+/// @param type DA1: the conformance level, like 62 for a VT220. DA2: the
+/// terminal type, like 41 for a VT420.
+/// @param version DA2: the firmware version. Zero for DA1.
+/// @param attributes DA1: the features, the bit N set for the attribute N.
+// static
+Event Event::DeviceAttributes(std::string input,
+                              int level,
+                              int type,
+                              int version,
+                              uint64_t attributes) {
+  Event event;
+  event.SetInput(std::move(input));
+  event.type_ = Type::DeviceAttributes;
+  event.data_.device = {level, type, version, attributes};  // NOLINT
+  return event;
+}
+
+/// @brief An event corresponding to a terminal XTVERSION report: the name and
+/// version of the terminal, like "kitty(0.35.2)".
+// static
+Event Event::TerminalVersion(std::string input) {
+  Event event;
+  event.SetInput(std::move(input));
+  event.type_ = Type::TerminalVersion;
+  return event;
+}
+
+/// @brief The text of a XTVERSION report: ESC P > | text ESC BACKSLASH.
+std::string Event::terminal_version() const {
+  const size_t prefix = 4;  // ESC P > |
+  const size_t suffix = 2;  // ESC BACKSLASH
+  if (input_.size() < prefix + suffix) {
+    return "";
+  }
+  return input_.substr(prefix, input_.size() - prefix - suffix);
+}
+
 /// @brief An custom event whose meaning is defined by the user of the library.
 /// @param input An arbitrary sequence of character defined by the developer.
 /// @ingroup component.
 // static
 Event Event::Special(std::string input) {
   Event event;
-  event.input_ = std::move(input);
+  event.SetInput(std::move(input));
   return event;
 }
 
@@ -86,7 +169,7 @@ Event Event::Special(std::string input) {
 // static
 Event Event::CursorPosition(std::string input, int x, int y) {
   Event event;
-  event.input_ = std::move(input);
+  event.SetInput(std::move(input));
   event.type_ = Type::CursorPosition;
   event.data_.cursor = {x, y};  // NOLINT
   return event;
@@ -266,9 +349,23 @@ std::string Event::DebugString() const {
       out += "})";
       return out;
     }
+    case Type::Paste:
+      return "Event::Paste(\"" + input_ + "\")";
     case Type::CursorShape:
       return "Event::CursorShape(" + input_ + ", " +
              std::to_string(data_.cursor_shape) + ")";
+    case Type::ModeReport:
+      return "Event::ModeReport(" + input_ + ", " +
+             std::to_string(data_.mode_report.mode) + ", " +
+             std::to_string(data_.mode_report.value) + ")";
+    case Type::DeviceAttributes:
+      return "Event::DeviceAttributes(" + input_ + ", " +
+             std::to_string(data_.device.level) + ", " +
+             std::to_string(data_.device.type) + ", " +
+             std::to_string(data_.device.version) + ", " +
+             std::to_string(data_.device.attributes) + ")";
+    case Type::TerminalVersion:
+      return "Event::TerminalVersion(" + input_ + ")";
     case Type::CursorPosition:
       return "Event::CursorPosition(" + input_ + ", " +
              std::to_string(data_.cursor.x) + ", " +
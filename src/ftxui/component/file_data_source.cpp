@@ -0,0 +1,412 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/component/file_data_source.hpp"
+
+#include <algorithm>           // for max, min
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <cstdint>             // for int64_t
+#include <cstring>             // for memchr
+#include <memory>  // for make_shared, shared_ptr, weak_ptr, enable_shared_from_this
+#include <mutex>               // for mutex, unique_lock, lock_guard
+#include <string>              // for string
+#include <string_view>         // for string_view
+#include <thread>              // for thread
+#include <utility>             // for move
+#include <vector>              // for vector
+
+#if defined(_WIN32)
+#include <fstream>   // for ifstream
+#include <iterator>  // for istreambuf_iterator
+#else
+#include <fcntl.h>     // for open, O_RDONLY
+#include <sys/mman.h>  // for mmap, munmap, MAP_FAILED, MAP_SHARED, PROT_READ
+#include <sys/stat.h>  // for stat, fstat
+#include <unistd.h>    // for close
+#endif
+
+#include "ftxui/component/component_options.hpp"  // for DataSource, DSRenderContext
+#include "ftxui/component/event.hpp"              // for Event
+#include "ftxui/component/screen_interactive.hpp"  // for ScreenInteractive
+#include "ftxui/dom/elements.hpp"                  // for Element, text
+#include "ftxui/dom/worker_pool.hpp"               // for WorkerPool
+
+namespace ftxui {
+
+namespace {
+
+// A read only view of the whole file, as of its size when mapped. A file
+// growing is mapped again; the previous mappings live as long as they are
+// read from.
+class Mapping {
+ public:
+  static std::shared_ptr<const Mapping> Open(const std::string& path) {
+    auto mapping = std::make_shared<Mapping>();
+#if defined(_WIN32)
+    // No mmap: the file is read instead.
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+      return nullptr;
+    }
+    mapping->buffer_.assign(std::istreambuf_iterator<char>(file),
+                            std::istreambuf_iterator<char>());
+    mapping->data_ = mapping->buffer_.data();
+    mapping->size_ = mapping->buffer_.size();
+#else
+    const int fd = open(path.c_str(), O_RDONLY);  // NOLINT
+    if (fd < 0) {
+      return nullptr;
+    }
+    struct stat info {};
+    if (fstat(fd, &info) != 0) {
+      close(fd);
+      return nullptr;
+    }
+    mapping->size_ = size_t(info.st_size);
+    if (mapping->size_ != 0) {
+      void* data =
+          mmap(nullptr, mapping->size_, PROT_READ, MAP_SHARED, fd, 0);
+      if (data == MAP_FAILED) {  // NOLINT
+        close(fd);
+        return nullptr;
+      }
+      mapping->data_ = static_cast<const char*>(data);
+    }
+    close(fd);
+#endif
+    return mapping;
+  }
+
+  // The size of the file on disk, without mapping it.
+  static int64_t FileSize(const std::string& path) {
+#if defined(_WIN32)
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    return file ? int64_t(file.tellg()) : -1;
+#else
+    struct stat info {};
+    if (stat(path.c_str(), &info) != 0) {
+      return -1;
+    }
+    return info.st_size;
+#endif
+  }
+
+  Mapping() = default;
+  ~Mapping() {
+#if !defined(_WIN32)
+    if (data_ != nullptr) {
+      munmap(const_cast<char*>(data_), size_);  // NOLINT
+    }
+#endif
+  }
+  Mapping(const Mapping&) = delete;
+  Mapping& operator=(const Mapping&) = delete;
+
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+#if defined(_WIN32)
+  std::string buffer_;
+#endif
+};
+
+// The offsets following the newlines in [begin, end).
+std::vector<int64_t> ScanChunk(const char* data, size_t begin, size_t end) {
+  std::vector<int64_t> starts;
+  const char* it = data + begin;
+  const char* const last = data + end;
+  while (it < last) {
+    // memchr is vectorized by the C library.
+    const void* found = std::memchr(it, '\n', size_t(last - it));
+    if (found == nullptr) {
+      break;
+    }
+    it = static_cast<const char*>(found) + 1;
+    starts.push_back(it - data);
+  }
+  return starts;
+}
+
+}  // namespace
+
+class FileDataSource::Impl : public std::enable_shared_from_this<Impl> {
+ public:
+  Impl(DataSource* source, std::string path, FileDataSourceOption option)
+      : source_(source), path_(std::move(path)), option_(std::move(option)) {
+    option_.chunk_size = std::max<size_t>(1, option_.chunk_size);
+    if (!option_.transform) {
+      option_.transform = [](std::string_view line, DSRenderContext&) {
+        return text(std::string(line));
+      };
+    }
+  }
+
+  void Start() { worker_ = std::thread(&Impl::Worker, this); }
+
+  void Stop() {
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      quit_ = true;
+    }
+    notifier_.notify_one();
+    if (worker_.joinable()) {
+      worker_.join();
+    }
+  }
+
+  bool IsOpen() const {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return open_;
+  }
+
+  bool IsIndexed() const {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return indexed_;
+  }
+
+  int64_t LineCount() const {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return LineCountLocked();
+  }
+
+  std::string Line(int64_t index) const {
+    std::shared_ptr<const Mapping> mapping;
+    int64_t begin = 0;
+    int64_t end = 0;
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      if (index < 0 || index >= LineCountLocked()) {
+        return "";
+      }
+      mapping = mapping_;
+      begin = starts_[index];
+      end = index + 1 < int64_t(starts_.size()) ? starts_[index + 1]
+                                                : scanned_;
+    }
+    // Drop the line ending.
+    while (end > begin && (mapping->data()[end - 1] == '\n' ||
+                           mapping->data()[end - 1] == '\r')) {
+      end--;
+    }
+    end = std::min(end, begin + int64_t(option_.max_line_size));
+    return {mapping->data() + begin, size_t(end - begin)};
+  }
+
+  // Called from the UI thread.
+  Element Transform(DSRenderContext& context) {
+    ScreenInteractive* screen = ScreenInteractive::Active();
+    if (screen != nullptr) {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      screen_ = screen;
+    }
+    const std::string line = Line(context.id);
+    return option_.transform(line, context);
+  }
+
+ private:
+  // The lines, the last one possibly lacking its newline.
+  int64_t LineCountLocked() const {
+    const int64_t count = int64_t(starts_.size());
+    return starts_.back() == scanned_ ? count - 1 : count;
+  }
+
+  void Worker() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!quit_) {
+      lock.unlock();
+      const int64_t size = Mapping::FileSize(path_);
+      std::shared_ptr<const Mapping> mapping;
+      if (size >= 0 && size != mapped_size_) {
+        mapping = Mapping::Open(path_);
+      }
+      lock.lock();
+
+      if (mapping) {
+        mapped_size_ = int64_t(mapping->size());
+        open_ = true;
+        if (mapped_size_ < scanned_) {
+          // The file was truncated, or replaced. Start over.
+          starts_ = {0};
+          scanned_ = 0;
+          generation_++;
+        }
+        mapping_ = std::move(mapping);
+      }
+
+      while (!quit_ && scanned_ < mapped_size_) {
+        lock.unlock();
+        Scan();
+        lock.lock();
+      }
+      indexed_ = open_;
+
+      if (!option_.follow) {
+        return;
+      }
+      notifier_.wait_for(lock, option_.follow_interval,
+                         [this] { return quit_; });
+    }
+  }
+
+  // Index the next chunks of the mapping, one per thread of the pool.
+  void Scan() {
+    std::shared_ptr<const Mapping> mapping;
+    int64_t begin = 0;
+    int generation = 0;
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      mapping = mapping_;
+      begin = scanned_;
+      generation = generation_;
+    }
+    const size_t chunks = option_.pool ? size_t(option_.pool->size()) + 1 : 1;
+    const size_t chunk = option_.chunk_size;
+    const size_t end =
+        std::min(mapping->size(), size_t(begin) + chunks * chunk);
+    std::vector<std::vector<int64_t>> found(chunks);
+    auto scan = [&](size_t i) {
+      const size_t chunk_begin = std::min(end, size_t(begin) + i * chunk);
+      const size_t chunk_end = std::min(end, chunk_begin + chunk);
+      found[i] = ScanChunk(mapping->data(), chunk_begin, chunk_end);
+    };
+    if (option_.pool) {
+      option_.pool->ParallelFor(chunks, scan);
+    } else {
+      scan(0);
+    }
+
+    int64_t last_line = 0;
+    ScreenInteractive* screen = nullptr;
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      if (generation != generation_) {
+        return;
+      }
+      last_line = LineCountLocked() - 1;
+      for (const auto& starts : found) {
+        starts_.insert(starts_.end(), starts.begin(), starts.end());
+      }
+      scanned_ = int64_t(end);
+      screen = screen_;
+    }
+    if (screen == nullptr) {
+      return;
+    }
+
+    // The last line displayed may have grown. When it was focused, the focus
+    // follows the end of the file.
+    std::weak_ptr<Impl> weak = weak_from_this();
+    screen->Post([weak, last_line, reset = begin == 0] {
+      auto impl = weak.lock();
+      if (!impl) {
+        return;
+      }
+      DataSource* source = impl->source_;
+      if (reset) {
+        source->invalidate_rows();
+      } else if (last_line >= 0) {
+        source->invalidate_row(last_line);
+      }
+      if (impl->option_.follow && source->focused_id == last_line) {
+        source->focused_id = std::max<int64_t>(0, impl->LineCount() - 1);
+      }
+    });
+    screen->PostEvent(Event::Custom);
+  }
+
+  DataSource* source_;
+  const std::string path_;
+  FileDataSourceOption option_;
+
+  // Guarded by |mutex_|:
+  mutable std::mutex mutex_;
+  std::condition_variable notifier_;
+  std::shared_ptr<const Mapping> mapping_;
+  std::vector<int64_t> starts_ = {0};  // The offsets of the lines.
+  int64_t scanned_ = 0;
+  int64_t mapped_size_ = -1;
+  int generation_ = 0;
+  bool open_ = false;
+  bool indexed_ = false;
+  bool quit_ = false;
+  ScreenInteractive* screen_ = nullptr;
+
+  std::thread worker_;
+};
+
+/// @brief Serve the lines of the file at |path| to |source|.
+/// @param source The DataSource. Its |dataset_size|, |move_id_by|,
+/// |count_items_before|, |id_to_index|, |index_to_id| and |transform| are
+/// replaced. It must outlive this object.
+/// @param path The file.
+/// @param option How to display the lines, and whether to follow appends.
+/// @ingroup component
+///
+/// ### Example
+///
+/// ```cpp
+/// DataSource source;
+/// FileDataSource file(&source, "/var/log/syslog", {.follow = true});
+/// auto menu = DBMenu(&source);
+/// ```
+FileDataSource::FileDataSource(DataSource* source,
+                               std::string path,
+                               FileDataSourceOption option)
+    : impl_(std::make_shared<Impl>(source, std::move(path), std::move(option))) {
+  std::weak_ptr<Impl> weak = impl_;
+  auto count = [weak]() -> int64_t {
+    auto impl = weak.lock();
+    return impl ? impl->LineCount() : 0;
+  };
+  source->dataset_size = [count] {
+    const int64_t total = count();
+    return DataSize{total, 0, std::max<int64_t>(0, total - 1)};
+  };
+  source->move_id_by = [count](int64_t& id, int64_t offset) {
+    const int64_t initial = id;
+    id = std::max<int64_t>(0, std::min(id + offset, count() - 1));
+    return id != initial;
+  };
+  source->count_items_before = [](int64_t id) { return id; };
+  source->id_to_index = [](int64_t id) { return id; };
+  source->index_to_id = [](int64_t index) { return index; };
+  source->transform = [weak](DSRenderContext& context) -> Element {
+    auto impl = weak.lock();
+    return impl ? impl->Transform(context) : text("");
+  };
+  impl_->Start();
+}
+
+FileDataSource::~FileDataSource() {
+  impl_->Stop();
+}
+
+/// @brief Whether the file could be opened. False until the indexing started.
+/// @ingroup component
+bool FileDataSource::IsOpen() const {
+  return impl_->IsOpen();
+}
+
+/// @brief Whether the whole file, as of its last check, was indexed.
+/// @ingroup component
+bool FileDataSource::IsIndexed() const {
+  return impl_->IsIndexed();
+}
+
+/// @brief The number of lines indexed so far.
+/// @ingroup component
+int64_t FileDataSource::LineCount() const {
+  return impl_->LineCount();
+}
+
+/// @brief The line at |index|, without its line ending.
+/// @ingroup component
+std::string FileDataSource::Line(int64_t index) const {
+  return impl_->Line(index);
+}
+
+}  // namespace ftxui
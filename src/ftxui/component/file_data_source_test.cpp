@@ -0,0 +1,129 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <chrono>      // for milliseconds, steady_clock
+#include <cstdint>     // for int64_t
+#include <cstdio>      // for remove
+#include <fstream>     // for ofstream
+#include <functional>  // for function
+#include <string>      // for string, to_string
+#include <thread>      // for sleep_for
+
+#include "ftxui/component/component.hpp"           // for DBMenu
+#include "ftxui/component/component_options.hpp"  // for DataSource
+#include "ftxui/component/file_data_source.hpp"  // for FileDataSource
+#include "ftxui/dom/node.hpp"                      // for Render
+#include "ftxui/dom/worker_pool.hpp"               // for WorkerPool
+#include "ftxui/screen/screen.hpp"                 // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+
+bool WaitFor(const std::function<bool()>& condition) {
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!condition()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+std::string TempFile(const std::string& name) {
+  return testing::TempDir() + name;
+}
+
+}  // namespace
+
+TEST(FileDataSourceTest, Lines) {
+  const std::string path = TempFile("file_data_source_lines.txt");
+  {
+    std::ofstream file(path, std::ios::binary);
+    for (int i = 0; i < 1000; ++i) {
+      file << i << (i % 2 ? "\r\n" : "\n");
+    }
+    file << "last";
+  }
+
+  // Small chunks, spread over the pool.
+  WorkerPool pool(3);
+  DataSource source;
+  FileDataSourceOption option;
+  option.chunk_size = 100;
+  option.pool = &pool;
+  FileDataSource file(&source, path, option);
+  ASSERT_TRUE(WaitFor([&] { return file.IsIndexed(); }));
+  EXPECT_TRUE(file.IsOpen());
+  EXPECT_EQ(file.LineCount(), 1001);
+  EXPECT_EQ(source.dataset_size().total, 1001);
+  for (int i : {0, 1, 2, 99, 500, 999}) {
+    EXPECT_EQ(file.Line(i), std::to_string(i));
+  }
+  EXPECT_EQ(file.Line(1000), "last");
+  EXPECT_EQ(file.Line(1001), "");
+
+  auto menu = DBMenu(&source);
+  source.focused_id = 500;
+  Screen screen(4, 3);
+  Render(screen, menu->Render());
+  for (int y = 0; y < 3; ++y) {
+    const std::string line = std::to_string(499 + y);
+    for (int x = 0; x < 3; ++x) {
+      EXPECT_EQ(screen.PixelAt(x, y).character, line.substr(x, 1));
+    }
+  }
+
+  std::remove(path.c_str());
+}
+
+TEST(FileDataSourceTest, Missing) {
+  DataSource source;
+  FileDataSource file(&source, TempFile("file_data_source_missing.txt"));
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_FALSE(file.IsOpen());
+  EXPECT_EQ(file.LineCount(), 0);
+  EXPECT_EQ(source.dataset_size().total, 0);
+}
+
+TEST(FileDataSourceTest, Follow) {
+  const std::string path = TempFile("file_data_source_follow.txt");
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "a\nb";
+  }
+
+  DataSource source;
+  FileDataSourceOption option;
+  option.follow = true;
+  option.follow_interval = std::chrono::milliseconds(1);
+  FileDataSource file(&source, path, option);
+  ASSERT_TRUE(WaitFor([&] { return file.LineCount() == 2; }));
+  EXPECT_EQ(file.Line(1), "b");
+
+  // The last line grows, and more lines are appended.
+  {
+    std::ofstream append(path, std::ios::binary | std::ios::app);
+    append << "c\nd\ne\n";
+  }
+  ASSERT_TRUE(WaitFor([&] { return file.LineCount() == 4; }));
+  EXPECT_EQ(file.Line(1), "bc");
+  EXPECT_EQ(file.Line(3), "e");
+
+  // The file is replaced by a shorter one.
+  {
+    std::ofstream replace(path, std::ios::binary | std::ios::trunc);
+    replace << "x\n";
+  }
+  ASSERT_TRUE(WaitFor([&] { return file.LineCount() == 1; }));
+  EXPECT_EQ(file.Line(0), "x");
+
+  std::remove(path.c_str());
+}
+
+}  // namespace ftxui
+// NOLINTEND
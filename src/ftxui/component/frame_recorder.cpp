@@ -0,0 +1,143 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/component/frame_recorder.hpp"
+
+#include <algorithm>  // for min, nth_element
+#include <array>      // for array
+#include <cstdio>     // for snprintf
+#include <string>     // for string
+#include <utility>    // for move
+#include <vector>     // for vector
+
+#include "ftxui/component/frame_stats.hpp"  // for FrameStats
+#include "ftxui/dom/elements.hpp"  // for text, gridbox, window, Element
+#include "ftxui/screen/allocations.hpp"  // for AllocationCountingEnabled
+
+namespace ftxui {
+
+void FrameRecorder::Add(Phase phase, double seconds) {
+  Samples& samples = samples_[phase];
+  samples.values[samples.count % kWindow] = seconds;
+  samples.count++;
+
+  if (phase == kEventLatency) {
+    size_t bucket = 0;
+    double bound = 0.001;  // NOLINT
+    while (bucket + 1 < event_latency_histogram_.size() && seconds >= bound) {
+      bucket++;
+      bound *= 2;
+    }
+    event_latency_histogram_[bucket]++;
+  }
+}
+
+void FrameRecorder::AddFrame(size_t bytes) {
+  frames_++;
+  bytes_last_ = bytes;
+  bytes_total_ += bytes;
+}
+
+void FrameRecorder::SetAllocations(
+    const FrameStats::Allocations& allocations) {
+  allocations_ = allocations;
+}
+
+FrameStats::Duration FrameRecorder::Summarize(Phase phase) const {
+  const Samples& samples = samples_[phase];
+  FrameStats::Duration duration;
+  if (samples.count == 0) {
+    return duration;
+  }
+  duration.last = samples.values[(samples.count - 1) % kWindow];
+
+  std::vector<double> values(
+      samples.values.begin(),
+      samples.values.begin() + std::min(samples.count, kWindow));
+  auto percentile = [&](size_t percent) {
+    const size_t index = (values.size() - 1) * percent / 100;
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+  };
+  duration.p50 = percentile(50);  // NOLINT
+  duration.p99 = percentile(99);  // NOLINT
+  return duration;
+}
+
+FrameStats FrameRecorder::Stats() const {
+  FrameStats stats;
+  stats.component_render = Summarize(kComponentRender);
+  stats.layout = Summarize(kLayout);
+  stats.node_render = Summarize(kNodeRender);
+  stats.shader = Summarize(kShader);
+  stats.serialize = Summarize(kSerialize);
+  stats.write = Summarize(kWrite);
+  stats.total = Summarize(kTotal);
+  stats.event_latency = Summarize(kEventLatency);
+  stats.event_latency_histogram = event_latency_histogram_;
+  stats.allocations = allocations_;
+  stats.frames = frames_;
+  stats.frames_abandoned = frames_abandoned_;
+  stats.bytes_last = bytes_last_;
+  stats.bytes_total = bytes_total_;
+  return stats;
+}
+
+namespace {
+
+std::string Milliseconds(double seconds) {
+  std::array<char, 32> buffer{};  // NOLINT
+  (void)std::snprintf(buffer.data(), buffer.size(), "%.2f",
+                      seconds * 1000.0);  // NOLINT
+  return buffer.data();
+}
+
+}  // namespace
+
+/// @brief A table of the frame statistics, in milliseconds. Meant to be drawn
+/// on top of the application, to find which phase exceeds the frame budget.
+/// @param stats The statistics, see ScreenInteractive::Stats().
+/// @ingroup component
+///
+/// ### Example
+///
+/// ```cpp
+/// auto renderer = Renderer(component, [&] {
+///   return dbox({
+///     component->Render(),
+///     FrameStatsElement(screen.Stats()) | align_right,
+///   });
+/// });
+/// ```
+Element FrameStatsElement(const FrameStats& stats) {
+  std::vector<Elements> lines;
+  lines.push_back({text("ms "), text("last "), text("p50 "), text("p99")});
+  auto add = [&](const char* name, const FrameStats::Duration& duration) {
+    lines.push_back({
+        text(std::string(name) + " "),
+        text(Milliseconds(duration.last) + " ") | align_right,
+        text(Milliseconds(duration.p50) + " ") | align_right,
+        text(Milliseconds(duration.p99)) | align_right,
+    });
+  };
+  add("render", stats.component_render);
+  add("layout", stats.layout);
+  add("draw", stats.node_render);
+  add("shader", stats.shader);
+  add("output", stats.serialize);
+  add("write", stats.write);
+  add("total", stats.total);
+  add("latency", stats.event_latency);
+  Elements footer = {
+      gridbox(std::move(lines)),
+      text(std::to_string(stats.bytes_last) + " bytes"),
+  };
+  if (AllocationCountingEnabled()) {
+    footer.push_back(
+        text(std::to_string(stats.allocations.total.count) + " allocations"));
+  }
+  return window(text("Frame " + std::to_string(stats.frames)),
+                vbox(std::move(footer)));
+}
+
+}  // namespace ftxui
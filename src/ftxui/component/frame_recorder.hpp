@@ -0,0 +1,58 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_FRAME_RECORDER_HPP
+#define FTXUI_COMPONENT_FRAME_RECORDER_HPP
+
+#include <array>    // for array
+#include <cstddef>  // for size_t
+
+#include "ftxui/component/frame_stats.hpp"  // for FrameStats
+
+namespace ftxui {
+
+// Record the durations of the phases of the frames, and report their
+// percentiles over a rolling window of the last frames.
+class FrameRecorder {
+ public:
+  enum Phase {
+    kComponentRender,
+    kLayout,
+    kNodeRender,
+    kShader,
+    kSerialize,
+    kWrite,
+    kTotal,
+    kEventLatency,
+    kPhaseCount,
+  };
+
+  void Add(Phase phase, double seconds);
+  void AddFrame(size_t bytes);
+  void AbandonFrame() { frames_abandoned_++; }
+  void SetAllocations(const FrameStats::Allocations& allocations);
+
+  FrameStats Stats() const;
+
+ private:
+  static constexpr size_t kWindow = 128;
+
+  // The last |kWindow| samples, in a circular buffer.
+  struct Samples {
+    std::array<double, kWindow> values{};
+    size_t count = 0;
+  };
+  FrameStats::Duration Summarize(Phase phase) const;
+
+  std::array<Samples, kPhaseCount> samples_;
+  FrameStats::Allocations allocations_;
+  std::array<size_t, 12> event_latency_histogram_{};
+  size_t frames_ = 0;
+  size_t frames_abandoned_ = 0;
+  size_t bytes_last_ = 0;
+  size_t bytes_total_ = 0;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_FRAME_RECORDER_HPP
@@ -0,0 +1,550 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/component/fuzzy_filter.hpp"
+
+#include <algorithm>  // for max, min, sort
+#include <atomic>     // for atomic
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <cstdint>             // for int64_t
+#include <memory>  // for make_shared, shared_ptr, weak_ptr, enable_shared_from_this
+#include <mutex>   // for mutex, unique_lock, lock_guard
+#include <optional>     // for optional
+#include <queue>        // for priority_queue
+#include <string>       // for string, to_string
+#include <string_view>  // for string_view
+#include <thread>       // for thread
+#include <utility>      // for move
+#include <vector>       // for vector
+
+#include "ftxui/component/component.hpp"  // for Input, DBMenu, Container::Vertical
+#include "ftxui/component/component_base.hpp"     // for ComponentBase
+#include "ftxui/component/component_options.hpp"  // for DataSource, DataSize, InputOption
+#include "ftxui/component/event.hpp"               // for Event
+#include "ftxui/component/screen_interactive.hpp"  // for ScreenInteractive
+#include "ftxui/dom/elements.hpp"  // for Element, text, hbox, vbox, separator, flex, dim
+
+namespace ftxui {
+
+namespace {
+
+// NOLINTBEGIN(*-magic-numbers)
+const int kMatchScore = 16;
+const int kBoundaryBonus = 8;
+const int kConsecutiveBonus = 4;
+const int kMaxGapPenalty = 3;
+// NOLINTEND(*-magic-numbers)
+
+char Lower(char c) {
+  return (c >= 'A' && c <= 'Z') ? char(c - 'A' + 'a') : c;
+}
+
+bool IsLower(char c) {
+  return c >= 'a' && c <= 'z';
+}
+
+bool IsUpper(char c) {
+  return c >= 'A' && c <= 'Z';
+}
+
+bool IsWordCharacter(char c) {
+  return IsLower(c) || IsUpper(c) || (c >= '0' && c <= '9') ||
+         (static_cast<unsigned char>(c) >= 0x80);  // NOLINT
+}
+
+std::string Lowered(std::string text) {
+  for (char& c : text) {
+    c = Lower(c);
+  }
+  return text;
+}
+
+// Score |text| against the lowercase |query|, or return -1 when the characters
+// of |query| don't appear in |text|, in order. The leftmost match is found,
+// then tightened from its end, like fzf's first algorithm.
+int Score(std::string_view query, std::string_view text) {
+  if (query.empty()) {
+    return 0;
+  }
+
+  // The end of the leftmost match.
+  size_t q = 0;
+  size_t end = 0;
+  for (; end < text.size(); ++end) {
+    if (Lower(text[end]) == query[q] && ++q == query.size()) {
+      break;
+    }
+  }
+  if (q != query.size()) {
+    return -1;
+  }
+
+  // The latest start of a match ending there.
+  size_t start = end + 1;
+  for (q = query.size(); q > 0;) {
+    --start;
+    if (Lower(text[start]) == query[q - 1]) {
+      --q;
+    }
+  }
+
+  int score = 0;
+  int run_bonus = 0;  // The bonus of the first character of a run.
+  size_t previous = start;
+  q = 0;
+  for (size_t i = start; i <= end && q < query.size(); ++i) {
+    const char c = text[i];
+    if (Lower(c) != query[q]) {
+      continue;
+    }
+    int bonus = (i == 0 || !IsWordCharacter(text[i - 1]) ||
+                 (IsUpper(c) && IsLower(text[i - 1])))
+                    ? kBoundaryBonus
+                    : 0;
+    if (q != 0 && i == previous + 1) {
+      // The characters of a run share the bonus of its first one.
+      bonus = std::max({bonus, run_bonus, kConsecutiveBonus});
+    } else {
+      run_bonus = bonus;
+      if (q != 0) {
+        score -= std::min(kMaxGapPenalty, int(i - previous - 1));
+      }
+    }
+    score += kMatchScore + bonus;
+    previous = i;
+    ++q;
+  }
+  return score;
+}
+
+struct Scored {
+  int score;
+  int64_t index;
+};
+
+// The best scores first, then the entries in order.
+bool Before(const Scored& a, const Scored& b) {
+  return a.score != b.score ? a.score > b.score : a.index < b.index;
+}
+
+}  // namespace
+
+class FuzzyFilter::Impl : public std::enable_shared_from_this<Impl> {
+ public:
+  explicit Impl(FuzzyFilterOption option) : option_(std::move(option)) {
+    option_.chunk_size = std::max<int64_t>(1, option_.chunk_size);
+    if (option_.threads <= 0) {
+      option_.threads = std::max(1, int(std::thread::hardware_concurrency()));
+    }
+
+    source_.dataset_size = [this] {
+      const int64_t size = this->size();
+      return DataSize{size, 0, size - 1};
+    };
+    source_.count_items_before = [](int64_t id) { return id; };
+    source_.move_id_by = [this](int64_t& id, int64_t offset) {
+      const int64_t initial = id;
+      id = std::max<int64_t>(0, std::min(id + offset, this->size() - 1));
+      return id != initial;
+    };
+    source_.id_to_index = [](int64_t id) { return id; };
+    source_.index_to_id = [](int64_t index) { return index; };
+    source_.transform = option_.transform;
+  }
+
+  void Start() {
+    for (int i = 0; i < option_.threads; ++i) {
+      workers_.emplace_back(&Impl::Worker, this);
+    }
+    Filter(query_);
+  }
+
+  void Stop() {
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      quit_ = true;
+      generation_++;  // Interrupt the job in flight.
+    }
+    notifier_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  DataSource* source() { return &source_; }
+  const std::string& query() const { return query_; }
+  bool Busy() const { return adopted_generation_ != requested_generation_; }
+
+  int64_t size() const {
+    return ranked_ ? int64_t(ranked_->size()) : all_size_;
+  }
+
+  int64_t Entry(int64_t rank) const {
+    return ranked_ ? (*ranked_)[size_t(rank)] : rank;
+  }
+
+  void SetQuery(std::string query) {
+    if (query != query_) {
+      Filter(std::move(query));
+    }
+  }
+
+  void Invalidate() {
+    levels_.clear();
+    Filter(query_);
+  }
+
+  // Called from the UI thread.
+  bool Update() {
+    std::optional<Result> result;
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      result.swap(pending_);
+    }
+    if (!result || result->generation != requested_generation_) {
+      return false;
+    }
+    if (levels_.empty() || levels_.back().query != result->query) {
+      levels_.push_back(result->level);
+    }
+    Adopt(result->generation, result->level.ranked);
+    return true;
+  }
+
+ private:
+  using Indices = std::vector<int64_t>;
+
+  // The matches of a query: in the order of the entries, to filter the longer
+  // queries, and ranked, to be displayed.
+  struct Level {
+    std::string query;
+    std::shared_ptr<const Indices> matches;
+    std::shared_ptr<const Indices> ranked;
+  };
+
+  struct Result {
+    int generation = 0;
+    std::string query;
+    Level level;
+  };
+
+  // A query scored by the workers, chunk by chunk.
+  struct Job {
+    int generation = 0;
+    std::string query;  // Lowercase.
+    // The entries to score. Every entry when null.
+    std::shared_ptr<const Indices> candidates;
+    int64_t count = 0;
+    size_t chunks = 0;
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    // The matches of each chunk, in the order of the entries.
+    std::vector<std::vector<Scored>> matches;
+  };
+
+  // Called from the UI thread.
+  void Filter(std::string query) {
+    query_ = std::move(query);
+    const std::string lowered = Lowered(query_);
+
+    // The matches of the queries the new one extends are kept.
+    while (!levels_.empty() &&
+           lowered.compare(0, levels_.back().query.size(),
+                           levels_.back().query) != 0) {
+      levels_.pop_back();
+    }
+
+    std::shared_ptr<Job> job;
+    ScreenInteractive* screen = ScreenInteractive::Active();
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      if (screen != nullptr) {
+        screen_ = screen;
+      }
+      requested_generation_ = ++generation_;
+      pending_.reset();
+      job_.reset();
+
+      if (!lowered.empty() &&
+          (levels_.empty() || levels_.back().query != lowered)) {
+        job = std::make_shared<Job>();
+        job->generation = generation_;
+        job->query = lowered;
+        if (!levels_.empty()) {
+          job->candidates = levels_.back().matches;
+        }
+        job->count = job->candidates ? int64_t(job->candidates->size())
+                                     : option_.size();
+        job->chunks = size_t((job->count + option_.chunk_size - 1) /
+                             option_.chunk_size);
+        job->matches.resize(job->chunks);
+        job_ = job;
+      }
+    }
+
+    if (lowered.empty()) {
+      // Every entry matches the empty query, in order.
+      all_size_ = option_.size();
+      Adopt(requested_generation_, nullptr);
+      return;
+    }
+
+    if (!job) {
+      // The matches of this query are known already.
+      Adopt(requested_generation_, levels_.back().ranked);
+      return;
+    }
+
+    if (job->chunks == 0) {
+      Publish(*job);
+      Update();
+      return;
+    }
+    notifier_.notify_all();
+  }
+
+  void Adopt(int generation, std::shared_ptr<const Indices> ranked) {
+    adopted_generation_ = generation;
+    ranked_ = std::move(ranked);
+    source_.focused_id = 0;
+    source_.hovered_id = -1;
+    source_.invalidate_rows();
+  }
+
+  void Worker() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      notifier_.wait(lock, [this] {
+        return quit_ || (job_ && job_->next.load() < job_->chunks);
+      });
+      if (quit_) {
+        return;
+      }
+      const std::shared_ptr<Job> job = job_;
+      lock.unlock();
+      Run(*job);
+      lock.lock();
+    }
+  }
+
+  // Score the chunks of |job| until there are none left, or the query changes.
+  void Run(Job& job) {
+    while (job.generation == generation_.load()) {
+      const size_t chunk = job.next.fetch_add(1);
+      if (chunk >= job.chunks) {
+        return;
+      }
+      const int64_t first = int64_t(chunk) * option_.chunk_size;
+      const int64_t last = std::min(job.count, first + option_.chunk_size);
+      std::vector<Scored>& matches = job.matches[chunk];
+      for (int64_t i = first; i < last; ++i) {
+        const int64_t index = job.candidates ? (*job.candidates)[size_t(i)] : i;
+        const int score = Score(job.query, option_.entry(index));
+        if (score >= 0) {
+          matches.push_back({score, index});
+        }
+      }
+
+      if (job.done.fetch_add(1) + 1 == job.chunks) {
+        Publish(job);
+      }
+    }
+  }
+
+  // Merge the matches of every chunk, and hand them to the UI thread.
+  void Publish(Job& job) {
+    auto matches = std::make_shared<Indices>();
+    for (const auto& chunk : job.matches) {
+      for (const Scored& match : chunk) {
+        matches->push_back(match.index);
+      }
+    }
+
+    // Every chunk is ranked, then they are merged.
+    for (auto& chunk : job.matches) {
+      std::sort(chunk.begin(), chunk.end(), Before);
+    }
+    auto ranked = std::make_shared<Indices>();
+    ranked->reserve(matches->size());
+    using Cursor = std::pair<const Scored*, const Scored*>;
+    auto after = [](const Cursor& a, const Cursor& b) {
+      return Before(*b.first, *a.first);
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(after)> heap(
+        after);
+    for (const auto& chunk : job.matches) {
+      if (!chunk.empty()) {
+        heap.push({chunk.data(), chunk.data() + chunk.size()});
+      }
+    }
+    while (!heap.empty()) {
+      Cursor cursor = heap.top();
+      heap.pop();
+      ranked->push_back(cursor.first->index);
+      if (++cursor.first != cursor.second) {
+        heap.push(cursor);
+      }
+    }
+
+    ScreenInteractive* screen = nullptr;
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      if (job.generation != generation_) {
+        return;
+      }
+      pending_ = Result{job.generation,
+                        job.query,
+                        {job.query, std::move(matches), std::move(ranked)}};
+      screen = screen_;
+    }
+    if (screen != nullptr) {
+      std::weak_ptr<Impl> weak = weak_from_this();
+      screen->Post([weak] {
+        if (auto impl = weak.lock()) {
+          impl->Update();
+        }
+      });
+      screen->PostEvent(Event::Custom);
+    }
+  }
+
+  FuzzyFilterOption option_;
+  DataSource source_;
+
+  // Owned by the UI thread:
+  std::string query_;
+  std::vector<Level> levels_;
+  std::shared_ptr<const Indices> ranked_;  // Every entry when null.
+  int64_t all_size_ = 0;
+  int requested_generation_ = 0;
+  int adopted_generation_ = 0;
+
+  // Guarded by |mutex_|:
+  std::mutex mutex_;
+  std::condition_variable notifier_;
+  std::atomic<int> generation_{0};
+  std::shared_ptr<Job> job_;
+  std::optional<Result> pending_;
+  ScreenInteractive* screen_ = nullptr;
+  bool quit_ = false;
+
+  std::vector<std::thread> workers_;
+};
+
+/// @brief Filter a list of entries with a fuzzy query, on worker threads.
+/// @param option The entries, and how to display the matches.
+/// @ingroup component
+///
+/// ### Example
+///
+/// ```cpp
+/// std::vector<std::string> entries = ...;
+/// FuzzyFilter filter({
+///   .size = [&] { return int64_t(entries.size()); },
+///   .entry = [&](int64_t i) -> std::string_view { return entries[i]; },
+///   .transform = [&](DSRenderContext& c) {
+///     auto row = text(entries[filter.Entry(c.id)]);
+///     return c.focused ? row | inverted : row;
+///   },
+/// });
+/// screen.Loop(FuzzyFilterMenu(&filter));
+/// ```
+FuzzyFilter::FuzzyFilter(FuzzyFilterOption option)
+    : impl_(std::make_shared<Impl>(std::move(option))) {
+  impl_->Start();
+}
+
+FuzzyFilter::~FuzzyFilter() {
+  impl_->Stop();
+}
+
+DataSource* FuzzyFilter::source() {
+  return impl_->source();
+}
+
+/// @brief Filter the entries matching |query|. The matches are computed by the
+/// workers, and adopted by Update().
+/// @ingroup component
+void FuzzyFilter::SetQuery(std::string query) {
+  impl_->SetQuery(std::move(query));
+}
+
+const std::string& FuzzyFilter::query() const {
+  return impl_->query();
+}
+
+/// @brief Adopt the matches computed since the last call. Called from the UI
+/// thread, automatically when a ScreenInteractive is active.
+/// @return Whether the matches changed.
+/// @ingroup component
+bool FuzzyFilter::Update() {
+  return impl_->Update();
+}
+
+bool FuzzyFilter::Busy() const {
+  return impl_->Busy();
+}
+
+int64_t FuzzyFilter::size() const {
+  return impl_->size();
+}
+
+int64_t FuzzyFilter::Entry(int64_t rank) const {
+  return impl_->Entry(rank);
+}
+
+/// @brief Forget about the matches computed, and filter the entries again.
+/// Call this after the entries changed.
+/// @ingroup component
+void FuzzyFilter::Invalidate() {
+  impl_->Invalidate();
+}
+
+namespace {
+
+class FuzzyFilterMenuBase : public ComponentBase {
+ public:
+  explicit FuzzyFilterMenuBase(FuzzyFilter* filter)
+      : filter_(filter), query_(filter->query()) {
+    InputOption option;
+    option.content = &query_;
+    option.placeholder = "Filter";
+    option.multiline = false;
+    option.on_change = [this] { filter_->SetQuery(query_); };
+    input_ = Input(option);
+    menu_ = DBMenu(filter_->source());
+    Add(Container::Vertical({input_, menu_}));
+  }
+
+ private:
+  Element Render() override {
+    filter_->Update();
+    std::string count = std::to_string(filter_->size());
+    if (filter_->Busy()) {
+      count += "…";
+    }
+    return vbox({
+        hbox({input_->Render() | flex, text(" " + count) | dim}),
+        separator(),
+        menu_->Render() | flex,
+    });
+  }
+
+  FuzzyFilter* filter_;
+  std::string query_;
+  Component input_;
+  Component menu_;
+};
+
+}  // namespace
+
+/// @brief An Input editing the query of |filter|, above a DBMenu displaying
+/// its matches, best first.
+/// @param filter The filter. It must outlive the component.
+/// @ingroup component
+Component FuzzyFilterMenu(FuzzyFilter* filter) {
+  return Make<FuzzyFilterMenuBase>(filter);
+}
+
+}  // namespace ftxui
@@ -0,0 +1,157 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <atomic>       // for atomic
+#include <chrono>       // for milliseconds, seconds, steady_clock
+#include <cstdint>      // for int64_t
+#include <string>       // for string, to_string
+#include <string_view>  // for string_view
+#include <thread>       // for sleep_for
+#include <vector>       // for vector
+
+#include "ftxui/component/component_base.hpp"  // for ComponentBase
+#include "ftxui/component/event.hpp"           // for Event
+#include "ftxui/component/fuzzy_filter.hpp"  // for FuzzyFilter, FuzzyFilterMenu
+#include "ftxui/dom/elements.hpp"   // for text
+#include "ftxui/dom/node.hpp"       // for Render
+#include "ftxui/screen/screen.hpp"  // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+
+// Wait for the matches of the last query to be adopted.
+bool Wait(FuzzyFilter& filter) {
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (filter.Update(), filter.Busy()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+std::vector<std::string> Matches(const FuzzyFilter& filter,
+                                 const std::vector<std::string>& entries) {
+  std::vector<std::string> matches;
+  for (int64_t rank = 0; rank < filter.size(); ++rank) {
+    matches.push_back(entries[filter.Entry(rank)]);
+  }
+  return matches;
+}
+
+FuzzyFilterOption Option(const std::vector<std::string>& entries,
+                         std::atomic<int64_t>* scored = nullptr) {
+  FuzzyFilterOption option;
+  option.size = [&entries] { return int64_t(entries.size()); };
+  option.entry = [&entries, scored](int64_t index) -> std::string_view {
+    if (scored) {
+      (*scored)++;
+    }
+    return entries[index];
+  };
+  option.transform = [](DSRenderContext& context) {
+    return text(std::to_string(context.id));
+  };
+  option.threads = 2;
+  option.chunk_size = 3;
+  return option;
+}
+
+}  // namespace
+
+TEST(FuzzyFilterTest, Rank) {
+  const std::vector<std::string> entries = {
+      "xaxbxc", "cba", "a_b_c", "ABC", "abc", "axbc",
+  };
+  FuzzyFilter filter(Option(entries));
+
+  // Every entry matches the empty query.
+  EXPECT_FALSE(filter.Busy());
+  EXPECT_EQ(Matches(filter, entries), entries);
+
+  filter.SetQuery("abc");
+  EXPECT_TRUE(filter.Busy());
+  ASSERT_TRUE(Wait(filter));
+  EXPECT_EQ(Matches(filter, entries),
+            (std::vector<std::string>{"ABC", "abc", "a_b_c", "axbc",
+                                      "xaxbxc"}));
+
+  filter.SetQuery("zz");
+  ASSERT_TRUE(Wait(filter));
+  EXPECT_EQ(filter.size(), 0);
+}
+
+TEST(FuzzyFilterTest, Incremental) {
+  std::vector<std::string> entries;
+  for (int i = 0; i < 1000; ++i) {
+    entries.push_back((i % 10 ? "entry " : "item ") + std::to_string(i));
+  }
+  std::atomic<int64_t> scored{0};
+  FuzzyFilter filter(Option(entries, &scored));
+
+  filter.SetQuery("t");
+  ASSERT_TRUE(Wait(filter));
+  EXPECT_EQ(scored, 1000);
+  EXPECT_EQ(filter.size(), 1000);
+
+  // Only the matches of "t" are scored again.
+  scored = 0;
+  filter.SetQuery("tr");
+  ASSERT_TRUE(Wait(filter));
+  EXPECT_EQ(scored, 1000);
+  EXPECT_EQ(filter.size(), 900);
+
+  scored = 0;
+  filter.SetQuery("try 5");
+  ASSERT_TRUE(Wait(filter));
+  EXPECT_EQ(scored, 900);
+  EXPECT_EQ(entries[filter.Entry(0)], "entry 5");
+
+  // Erasing characters reuses the matches computed already.
+  scored = 0;
+  filter.SetQuery("tr");
+  EXPECT_FALSE(filter.Busy());
+  EXPECT_EQ(filter.size(), 900);
+  filter.SetQuery("");
+  EXPECT_EQ(filter.size(), 1000);
+  EXPECT_EQ(scored, 0);
+
+  // Another query starts over.
+  filter.SetQuery("item");
+  ASSERT_TRUE(Wait(filter));
+  EXPECT_EQ(scored, 1000);
+  EXPECT_EQ(filter.size(), 100);
+}
+
+TEST(FuzzyFilterTest, Menu) {
+  const std::vector<std::string> entries = {"apple", "banana", "cherry"};
+  FuzzyFilterOption option = Option(entries);
+  FuzzyFilter* filter_pointer = nullptr;
+  option.transform = [&](DSRenderContext& context) {
+    return text(entries[filter_pointer->Entry(context.id)]);
+  };
+  FuzzyFilter filter(option);
+  filter_pointer = &filter;
+  auto menu = FuzzyFilterMenu(&filter);
+
+  menu->OnEvent(Event::Character('a'));
+  menu->OnEvent(Event::Character('n'));
+  EXPECT_EQ(filter.query(), "an");
+  ASSERT_TRUE(Wait(filter));
+
+  Screen screen(10, 4);
+  Render(screen, menu->Render());
+  EXPECT_EQ(screen.ToString(),
+            "\x1B[7;97man      \x1B[2;27;39m 1\x1B[22m\r\n"
+            "──────────\r\n"
+            "banana    \r\n"
+            "          ");
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -55,8 +55,12 @@ Component Hoverable(Component component, bool* hover) {
 
     bool OnEvent(Event event) override {
       if (event.is_mouse()) {
-        *hover_ = box_.Contain(event.mouse().x, event.mouse().y) &&
-                  CaptureMouse(event);
+        const bool hover = box_.Contain(event.mouse().x, event.mouse().y) &&
+                           CaptureMouse(event);
+        if (hover != *hover_) {
+          *hover_ = hover;
+          RequestRedraw();
+        }
       }
 
       return ComponentBase::OnEvent(event);
@@ -108,6 +112,7 @@ Component Hoverable(Component component,
                            CaptureMouse(event);
         if (hover != hover_) {
           Post(hover ? on_enter_ : on_leave_);
+          RequestRedraw();
         }
         hover_ = hover;
       }
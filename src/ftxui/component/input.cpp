@@ -1,14 +1,17 @@
 // Copyright 2022 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <algorithm>   // for max, min
-#include <cstddef>     // for size_t
-#include <cstdint>     // for uint32_t
-#include <functional>  // for function
-#include <sstream>     // for basic_istream, stringstream
-#include <string>      // for string, basic_string, operator==, getline
-#include <utility>     // for move
-#include <vector>      // for vector
+#include <algorithm>    // for max, min, upper_bound
+#include <cstddef>      // for size_t, ptrdiff_t
+#include <cstdint>      // for uint32_t
+#include <deque>        // for deque
+#include <functional>   // for function
+#include <iterator>     // for distance
+#include <memory>       // for make_shared
+#include <string>       // for string, basic_string, operator==
+#include <string_view>  // for string_view
+#include <utility>      // for move
+#include <vector>       // for vector
 
 #include "ftxui/component/component.hpp"          // for Make, Input
 #include "ftxui/component/component_base.hpp"     // for ComponentBase
@@ -16,9 +19,12 @@
 #include "ftxui/component/event.hpp"  // for Event, Event::ArrowDown, Event::ArrowLeft, Event::ArrowLeftCtrl, Event::ArrowRight, Event::ArrowRightCtrl, Event::ArrowUp, Event::Backspace, Event::Delete, Event::End, Event::Home, Event::Return
 #include "ftxui/component/mouse.hpp"  // for Mouse, Mouse::Left, Mouse::Pressed
 #include "ftxui/component/screen_interactive.hpp"  // for Component
-#include "ftxui/dom/elements.hpp"  // for operator|, reflect, text, Element, xflex, hbox, Elements, frame, operator|=, vbox, focus, focusCursorBarBlinking, select
-#include "ftxui/screen/box.hpp"    // for Box
-#include "ftxui/screen/string.hpp"           // for string_width
+#include "ftxui/dom/elements.hpp"  // for operator|, reflect, text, Element, xflex, hbox, Elements, frame, operator|=, focus, focusCursorBarBlinking, select
+#include "ftxui/dom/node.hpp"         // for Node
+#include "ftxui/dom/requirement.hpp"  // for Requirement
+#include "ftxui/screen/box.hpp"       // for Box
+#include "ftxui/screen/screen.hpp"    // for Screen
+#include "ftxui/screen/string.hpp"    // for string_width, Glyph, GlyphRange
 #include "ftxui/screen/string_internal.hpp"  // for GlyphNext, GlyphPrevious, WordBreakProperty, EatCodePoint, CodepointToWordBreakProperty, IsFullWidth, WordBreakProperty::ALetter, WordBreakProperty::CR, WordBreakProperty::Double_Quote, WordBreakProperty::Extend, WordBreakProperty::ExtendNumLet, WordBreakProperty::Format, WordBreakProperty::Hebrew_Letter, WordBreakProperty::Katakana, WordBreakProperty::LF, WordBreakProperty::MidLetter, WordBreakProperty::MidNum, WordBreakProperty::MidNumLet, WordBreakProperty::Newline, WordBreakProperty::Numeric, WordBreakProperty::Regional_Indicator, WordBreakProperty::Single_Quote, WordBreakProperty::WSegSpace, WordBreakProperty::ZWJ
 #include "ftxui/screen/util.hpp"             // for clamp
 #include "ftxui/util/ref.hpp"                // for StringRef, Ref
@@ -27,17 +33,17 @@ namespace ftxui {
 
 namespace {
 
-std::vector<std::string> Split(const std::string& input) {
-  std::vector<std::string> output;
-  std::stringstream ss(input);
-  std::string line;
-  while (std::getline(ss, line)) {
-    output.push_back(line);
+// Store into |starts| the position of every line of |input|. There is always
+// at least one. The lines aren't copied, and |starts| keeps its capacity
+// across calls.
+void IndexLines(const std::string& input, std::vector<size_t>* starts) {
+  starts->clear();
+  starts->push_back(0);
+  size_t end = input.find('\n');
+  while (end != std::string::npos) {
+    starts->push_back(end + 1);
+    end = input.find('\n', end + 1);
   }
-  if (input.back() == '\n') {
-    output.emplace_back("");
-  }
-  return output;
 }
 
 size_t GlyphWidth(const std::string& input, size_t iter) {
@@ -88,6 +94,425 @@ bool IsWordCharacter(const std::string& input, size_t iter) {
   return IsWordCodePoint(ucs);
 }
 
+// The number of glyphs of |input|, each displayed as a bullet in password
+// mode.
+int GlyphCount(std::string_view input) {
+  const GlyphRange glyphs(input);
+  return static_cast<int>(std::distance(glyphs.begin(), glyphs.end()));
+}
+
+// Draw |count| bullets from |x| to |x_max|, masking a password.
+void DrawBullets(Screen& screen, int count, int x, int y, int x_max) {
+  const int end = std::min(x_max + 1, x + count);
+  for (; x < end; ++x) {
+    screen.PixelAt(x, y).character = "•";
+  }
+}
+
+// A password, masked with one bullet per glyph. The bullets are drawn directly
+// into the screen, without building a string.
+class Password : public Node {
+ public:
+  explicit Password(std::string_view input) : count_(GlyphCount(input)) {}
+
+  void ComputeRequirement() override {
+    requirement_.min_x = count_;
+    requirement_.min_y = 1;
+  }
+
+  void Render(Screen& screen) override {
+    if (box_.y_min > box_.y_max) {
+      return;
+    }
+    DrawBullets(screen, count_, box_.x_min, box_.y_min,
+                std::min(box_.x_max, screen.stencil.x_max));
+  }
+
+ private:
+  int count_;
+};
+
+using Highlighter = std::function<int(std::string_view line,
+                                      int state,
+                                      std::vector<InputToken>* tokens)>;
+
+// The line |index| of |content|, without its '\n'. See IndexLines().
+std::string_view LineAt(const std::string& content,
+                        const std::vector<size_t>& starts,
+                        size_t index) {
+  const size_t start = starts[index];
+  const size_t end =
+      index + 1 < starts.size() ? starts[index + 1] - 1 : content.size();
+  return std::string_view(content).substr(start, end - start);
+}
+
+// The state of the highlighter at the start of the lines, kept across frames.
+// The edits invalidate the states from the line edited. They are computed
+// again up to the lines drawn, until the state at the start of a line left
+// unchanged is the one kept: the following ones are kept too.
+class HighlightCache {
+ public:
+  // Start over, when the content was modified from outside.
+  void Reset() {
+    states_.assign(1, 0);
+    valid_ = 1;
+    changed_end_ = 0;
+  }
+
+  // |added| lines were inserted after the line |line|, which was modified.
+  void Insert(size_t line, size_t added) {
+    if (line + 1 < states_.size()) {
+      states_.insert(states_.begin() + std::ptrdiff_t(line + 1), added, 0);
+    }
+    if (changed_end_ > line) {
+      changed_end_ += added;
+    }
+    Invalidate(line, line + added + 1);
+    edited_ = true;
+  }
+
+  // |removed| lines after the line |line| were merged into it.
+  void Erase(size_t line, size_t removed) {
+    if (line + 1 < states_.size()) {
+      const size_t end = std::min(line + 1 + removed, states_.size());
+      states_.erase(states_.begin() + std::ptrdiff_t(line + 1),
+                    states_.begin() + std::ptrdiff_t(end));
+    }
+    if (changed_end_ > line) {
+      changed_end_ =
+          changed_end_ > line + removed ? changed_end_ - removed : line + 1;
+    }
+    Invalidate(line, line + 1);
+    edited_ = true;
+  }
+
+  // Start over if |content| was modified from outside, since the last call.
+  void Check(const std::string& content, size_t lines) {
+    const size_t hash = std::hash<std::string>()(content);
+    if ((hash != hash_ && !edited_) || states_.size() > lines) {
+      Reset();
+    }
+    hash_ = hash;
+    edited_ = false;
+  }
+
+  // The state at the start of the line |index|. The lines before it are
+  // highlighted as needed.
+  int StateAt(size_t index,
+              const Highlighter& highlight,
+              const std::string& content,
+              const std::vector<size_t>& starts) {
+    while (valid_ <= index) {
+      const int state = highlight(LineAt(content, starts, valid_ - 1),
+                                  states_[valid_ - 1], nullptr);
+      if (valid_ == states_.size()) {
+        states_.push_back(state);
+        ++valid_;
+      } else if (valid_ >= changed_end_ && states_[valid_] == state) {
+        valid_ = states_.size();
+      } else {
+        states_[valid_++] = state;
+      }
+    }
+    return states_[index];
+  }
+
+ private:
+  // The lines from |line| to |end| excluded were modified.
+  void Invalidate(size_t line, size_t end) {
+    // Merged with the lines modified before, unless already highlighted again.
+    changed_end_ = valid_ < changed_end_ ? std::max(changed_end_, end) : end;
+    valid_ = std::min(valid_, line + 1);
+  }
+
+  // The state at the start of the lines computed. The first |valid_| ones are
+  // up to date. The others are, once one of them from |changed_end_| is.
+  std::vector<int> states_ = {0};
+  size_t valid_ = 1;
+  size_t changed_end_ = 0;
+  // The hash of the content, and whether it was edited by the Input since.
+  size_t hash_ = 0;
+  bool edited_ = false;
+};
+
+// The lines of an Input. The requirement covers all of them, so that frame()
+// scrolls as usual, but only the ones intersecting the stencil are drawn. The
+// line holding the cursor is a child element, to be focused and reflected.
+//
+// The content and its index are referenced: the element must be rendered
+// before the Input changes.
+class InputLines : public Node {
+ public:
+  InputLines(const std::string& content,
+             const std::vector<size_t>& starts,
+             bool password,
+             int cursor_line,
+             Element cursor_element,
+             const Highlighter* highlight = nullptr,
+             HighlightCache* highlight_cache = nullptr)
+      : Node({std::move(cursor_element)}),
+        content_(content),
+        starts_(starts),
+        password_(password),
+        cursor_line_(cursor_line),
+        highlight_(highlight),
+        highlight_cache_(highlight_cache) {}
+
+  std::string_view Line(size_t index) const {
+    return LineAt(content_, starts_, index);
+  }
+
+  void ComputeRequirement() override {
+    Node::ComputeRequirement();
+    const Requirement cursor = children_[0]->requirement();
+    requirement_ = Requirement();
+    requirement_.min_y = static_cast<int>(starts_.size());
+    requirement_.min_x = cursor.min_x;
+    for (size_t i = 0; i < starts_.size(); ++i) {
+      if (static_cast<int>(i) == cursor_line_) {
+        continue;
+      }
+      const std::string_view line = Line(i);
+      const int width = password_ ? GlyphCount(line) : string_width(line);
+      requirement_.min_x = std::max(requirement_.min_x, width);
+    }
+    if (cursor.selection != Requirement::NORMAL) {
+      requirement_.selection = cursor.selection;
+      requirement_.selected_box = cursor.selected_box;
+      requirement_.selected_box.y_min += cursor_line_;
+      requirement_.selected_box.y_max += cursor_line_;
+    }
+  }
+
+  void SetBox(Box box) override {
+    Node::SetBox(box);
+    box.y_min += cursor_line_;
+    box.y_max = box.y_min;
+    children_[0]->SetBox(box);
+  }
+
+  void Render(Screen& screen) override {
+    Node::Render(screen);
+
+    const Box visible = Box::Intersection(box_, screen.stencil);
+    const int lines = static_cast<int>(starts_.size());
+    for (int y = visible.y_min; y <= visible.y_max; ++y) {
+      const int index = y - box_.y_min;
+      if (index >= lines) {
+        break;
+      }
+      const std::string_view line = Line(index);
+      if (index != cursor_line_) {
+        DrawLine(screen, line, y, visible.x_max);
+      }
+      if (highlight_) {
+        HighlightLine(screen, index, line, y, visible.x_max);
+      }
+    }
+  }
+
+ private:
+  // Draw |line| like text() does, stopping at |x_max|.
+  void DrawLine(Screen& screen, std::string_view line, int y, int x_max) const {
+    int x = box_.x_min;
+    if (password_) {
+      DrawBullets(screen, GlyphCount(line), x, y, x_max);
+      return;
+    }
+
+    for (const Glyph& glyph : GlyphRange(line)) {
+      if (x > x_max) {
+        return;
+      }
+      screen.PixelAt(x, y).character = glyph.text;
+      ++x;
+
+      // Fullwidth glyphs take two cells. The second is left empty.
+      if (glyph.width == 2) {
+        if (x > x_max) {
+          return;
+        }
+        screen.PixelAt(x, y).character.clear();
+        ++x;
+      }
+    }
+  }
+
+  // Apply the style of the tokens of |line| to its cells, already drawn.
+  void HighlightLine(Screen& screen,
+                     int index,
+                     std::string_view line,
+                     int y,
+                     int x_max) {
+    const int state =
+        highlight_cache_->StateAt(size_t(index), *highlight_, content_, starts_);
+    tokens_.clear();
+    (*highlight_)(line, state, &tokens_);
+
+    auto token = tokens_.begin();
+    int x = box_.x_min;
+    for (const Glyph& glyph : GlyphRange(line)) {
+      if (x > x_max) {
+        return;
+      }
+      const auto offset = size_t(glyph.text.data() - line.data());
+      while (token != tokens_.end() && token->start + token->size <= offset) {
+        ++token;
+      }
+      if (token == tokens_.end()) {
+        return;
+      }
+      if (token->start <= offset && token->style) {
+        for (int i = 0; i < glyph.width && x + i <= x_max; ++i) {
+          token->style(screen.PixelAt(x + i, y));
+        }
+      }
+      x += glyph.width;
+    }
+  }
+
+  const std::string& content_;
+  const std::vector<size_t>& starts_;
+  bool password_;
+  int cursor_line_;
+  // Null unless the content is highlighted.
+  const Highlighter* highlight_;
+  HighlightCache* highlight_cache_;
+  std::vector<InputToken> tokens_;
+};
+
+// The edits made to the content, to undo and redo them. Only the text inserted
+// or erased is kept, never the content, so undoing costs the size of the edit.
+// Consecutive keystrokes are coalesced into a single edit.
+class EditHistory {
+ public:
+  struct Edit {
+    size_t position = 0;
+    std::string text;
+    bool insert = true;
+    // Undone and redone along with the previous edit.
+    bool joined = false;
+    int cursor_before = 0;
+    int cursor_after = 0;
+  };
+
+  // Record |edit|, extending the last one when it continues it. The oldest
+  // edits are forgotten to keep the history under |limit| bytes.
+  void Record(Edit edit, size_t limit) {
+    redo_.clear();
+    if (limit == 0) {
+      Clear();
+      return;
+    }
+    if (!Extend(edit)) {
+      bytes_ += Bytes(edit);
+      undo_.push_back(std::move(edit));
+    }
+    sealed_ = false;
+
+    // Forget whole groups of edits, from the oldest.
+    while (bytes_ > limit && !undo_.empty()) {
+      do {
+        bytes_ -= Bytes(undo_.front());
+        undo_.pop_front();
+      } while (!undo_.empty() && undo_.front().joined);
+    }
+  }
+
+  // The next edit recorded starts a new one.
+  void Seal() { sealed_ = true; }
+
+  void Clear() {
+    undo_.clear();
+    redo_.clear();
+    bytes_ = 0;
+  }
+
+  // Call |revert| on the last group of edits, from the last one.
+  template <typename F>
+  bool Undo(F revert) {
+    if (undo_.empty()) {
+      return false;
+    }
+    bool joined = true;
+    while (joined && !undo_.empty()) {
+      Edit edit = std::move(undo_.back());
+      undo_.pop_back();
+      revert(edit);
+      joined = edit.joined;
+      redo_.push_back(std::move(edit));
+    }
+    sealed_ = true;
+    return true;
+  }
+
+  // Call |apply| on the last group of edits undone, from the first one.
+  template <typename F>
+  bool Redo(F apply) {
+    if (redo_.empty()) {
+      return false;
+    }
+    do {
+      Edit edit = std::move(redo_.back());
+      redo_.pop_back();
+      apply(edit);
+      undo_.push_back(std::move(edit));
+    } while (!redo_.empty() && redo_.back().joined);
+    sealed_ = true;
+    return true;
+  }
+
+ private:
+  static size_t Bytes(const Edit& edit) {
+    return sizeof(Edit) + edit.text.size();
+  }
+
+  // Whether |edit| erased the text before the cursor, rather than after.
+  static bool IsBackspace(const Edit& edit) {
+    return edit.cursor_before != static_cast<int>(edit.position);
+  }
+
+  // Coalesce |edit| into the last edit, when typed right after it.
+  bool Extend(const Edit& edit) {
+    // Beyond this size, prepending the characters erased costs too much.
+    constexpr size_t kMaxRun = 1024;
+    if (sealed_ || undo_.empty() || edit.joined) {
+      return false;
+    }
+    Edit& last = undo_.back();
+    if (last.insert != edit.insert || last.text.size() >= kMaxRun) {
+      return false;
+    }
+    if (edit.insert) {
+      // Typing. A new line starts a new edit.
+      if (edit.position != last.position + last.text.size() ||
+          edit.text == "\n" || last.text.back() == '\n') {
+        return false;
+      }
+      last.text += edit.text;
+    } else if (IsBackspace(edit) != IsBackspace(last)) {
+      return false;
+    } else if (edit.position + edit.text.size() == last.position) {
+      // Backspace.
+      last.text.insert(0, edit.text);
+      last.position = edit.position;
+    } else if (edit.position == last.position) {
+      // Delete.
+      last.text += edit.text;
+    } else {
+      return false;
+    }
+    bytes_ += edit.text.size();
+    last.cursor_after = edit.cursor_after;
+    return true;
+  }
+
+  std::deque<Edit> undo_;
+  std::vector<Edit> redo_;
+  size_t bytes_ = 0;
+  bool sealed_ = true;
+};
+
 // An input box. The user can type text into it.
 class InputBase : public ComponentBase, public InputOption {
  public:
@@ -119,47 +544,27 @@ class InputBase : public ComponentBase, public InputOption {
              reflect(box_);
     }
 
-    Elements elements;
-    const std::vector<std::string> lines = Split(*content);
+    // The content may have been modified from outside, index it again. Only
+    // the line of the cursor is copied.
+    IndexContent();
 
     cursor_position() = util::clamp(cursor_position(), 0, (int)content->size());
 
     // Find the line and index of the cursor.
-    int cursor_line = 0;
-    int cursor_char_index = cursor_position();
-    for (const auto& line : lines) {
-      if (cursor_char_index <= (int)line.size()) {
-        break;
-      }
-
-      cursor_char_index -= static_cast<int>(line.size() + 1);
-      cursor_line++;
-    }
-
-    if (lines.empty()) {
-      elements.push_back(text("") | focused);
-    }
-
-    elements.reserve(lines.size());
-    for (size_t i = 0; i < lines.size(); ++i) {
-      const std::string& line = lines[i];
-
-      // This is not the cursor line.
-      if (int(i) != cursor_line) {
-        elements.push_back(Text(line));
-        continue;
-      }
+    const int cursor_line = LineOf(cursor_position());
+    const std::string line = std::string(Line(cursor_line));
+    const int cursor_char_index =
+        cursor_position() - static_cast<int>(line_starts_[cursor_line]);
 
+    Element cursor_element;
+    if (cursor_char_index >= (int)line.size()) {
       // The cursor is at the end of the line.
-      if (cursor_char_index >= (int)line.size()) {
-        elements.push_back(hbox({
-                               Text(line),
-                               text(" ") | focused | reflect(cursor_box_),
-                           }) |
-                           xflex);
-        continue;
-      }
-
+      cursor_element = hbox({
+                           Text(line),
+                           text(" ") | focused | reflect(cursor_box_),
+                       }) |
+                       xflex;
+    } else {
       // The cursor is on this line.
       const int glyph_start = cursor_char_index;
       const int glyph_end = static_cast<int>(GlyphNext(line, glyph_start));
@@ -167,16 +572,25 @@ class InputBase : public ComponentBase, public InputOption {
       const std::string part_at_cursor =
           line.substr(glyph_start, glyph_end - glyph_start);
       const std::string part_after_cursor = line.substr(glyph_end);
-      auto element = hbox({
-                         Text(part_before_cursor),
-                         Text(part_at_cursor) | focused | reflect(cursor_box_),
-                         Text(part_after_cursor),
-                     }) |
-                     xflex;
-      elements.push_back(element);
+      cursor_element =
+          hbox({
+              Text(part_before_cursor),
+              Text(part_at_cursor) | focused | reflect(cursor_box_),
+              Text(part_after_cursor),
+          }) |
+          xflex;
     }
 
-    auto element = vbox(std::move(elements)) | frame;
+    // Passwords are never highlighted.
+    const bool highlighted = highlight && !password();
+    if (highlighted) {
+      highlight_cache_.Check(*content, line_starts_.size());
+    }
+    auto element = std::make_shared<InputLines>(
+                       *content, line_starts_, password(), cursor_line,
+                       std::move(cursor_element),
+                       highlighted ? &highlight : nullptr, &highlight_cache_) |
+                   frame;
     return transform_func({
                std::move(element), hovered_, is_focused,
                false  // placeholder
@@ -184,17 +598,91 @@ class InputBase : public ComponentBase, public InputOption {
            xflex | reflect(box_);
   }
 
+  void IndexContent() {
+    IndexLines(*content, &line_starts_);
+    indexed_size_ = content->size();
+  }
+
+  // The edits made by the component keep the index up to date. Index the
+  // content again only when it was resized from outside.
+  void UpdateIndex() {
+    if (line_starts_.empty() || indexed_size_ != content->size()) {
+      IndexContent();
+      highlight_cache_.Reset();
+    }
+  }
+
+  // Insert |text| at |position|, shifting the lines after it.
+  void Insert(size_t position, const std::string& text) {
+    content->insert(position, text);
+    const auto first =
+        std::upper_bound(line_starts_.begin(), line_starts_.end(), position);
+    for (auto it = first; it != line_starts_.end(); ++it) {
+      *it += text.size();
+    }
+    std::vector<size_t> added;
+    size_t end = text.find('\n');
+    while (end != std::string::npos) {
+      added.push_back(position + end + 1);
+      end = text.find('\n', end + 1);
+    }
+    const auto line = size_t(first - line_starts_.begin()) - 1;
+    line_starts_.insert(first, added.begin(), added.end());
+    highlight_cache_.Insert(line, added.size());
+    indexed_size_ = content->size();
+    history_size_ = content->size();
+  }
+
+  // Erase |size| bytes at |position|, merging the lines it spans.
+  void Erase(size_t position, size_t size) {
+    content->erase(position, size);
+    const auto first =
+        std::upper_bound(line_starts_.begin(), line_starts_.end(), position);
+    const auto last =
+        std::upper_bound(first, line_starts_.end(), position + size);
+    for (auto it = last; it != line_starts_.end(); ++it) {
+      *it -= size;
+    }
+    highlight_cache_.Erase(size_t(first - line_starts_.begin()) - 1,
+                           size_t(last - first));
+    line_starts_.erase(first, last);
+    indexed_size_ = content->size();
+    history_size_ = content->size();
+  }
+
+  // Record the edit of |text| at |position|, made by the user.
+  void Record(bool inserted,
+              size_t position,
+              std::string text,
+              int cursor_before,
+              bool joined = false) {
+    EditHistory::Edit edit;
+    edit.position = position;
+    edit.text = std::move(text);
+    edit.insert = inserted;
+    edit.joined = joined;
+    edit.cursor_before = cursor_before;
+    edit.cursor_after = cursor_position();
+    history_.Record(std::move(edit), undo_memory);
+  }
+
+  // The line holding |position|.
+  int LineOf(int position) const {
+    const auto it = std::upper_bound(line_starts_.begin(), line_starts_.end(),
+                                     size_t(position));
+    return static_cast<int>(it - line_starts_.begin()) - 1;
+  }
+
+  // The content of the line |index|, without its '\n'.
+  std::string_view Line(int index) const {
+    return LineAt(*content, line_starts_, size_t(index));
+  }
+
   Element Text(const std::string& input) {
     if (!password()) {
       return text(input);
     }
-
-    std::string out;
-    out.reserve(10 + input.size() * 3 / 2);
-    for (size_t i = 0; i < input.size(); ++i) {
-      out += "•";
-    }
-    return text(out);
+    return std::make_shared<Password>(input);
   }
 
   bool HandleBackspace() {
@@ -203,8 +691,10 @@ class InputBase : public ComponentBase, public InputOption {
     }
     const size_t start = GlyphPrevious(content(), cursor_position());
     const size_t end = cursor_position();
-    content->erase(start, end - start);
+    std::string erased = content->substr(start, end - start);
+    Erase(start, end - start);
     cursor_position() = static_cast<int>(start);
+    Record(false, start, std::move(erased), static_cast<int>(end));
     on_change();
     return true;
   }
@@ -215,7 +705,9 @@ class InputBase : public ComponentBase, public InputOption {
     }
     const size_t start = cursor_position();
     const size_t end = GlyphNext(content(), cursor_position());
-    content->erase(start, end - start);
+    std::string erased = content->substr(start, end - start);
+    Erase(start, end - start);
+    Record(false, start, std::move(erased), cursor_position());
     return true;
   }
 
@@ -284,29 +776,13 @@ class InputBase : public ComponentBase, public InputOption {
 
     const size_t columns = CursorColumn();
 
-    // Move cursor at the beginning of 2 lines above.
-    while (true) {
-      if (cursor_position() == 0) {
-        return true;
-      }
-      const size_t previous = GlyphPrevious(content(), cursor_position());
-      if (content()[previous] == '\n') {
-        break;
-      }
-      cursor_position() = static_cast<int>(previous);
-    }
-    cursor_position() =
-        static_cast<int>(GlyphPrevious(content(), cursor_position()));
-    while (true) {
-      if (cursor_position() == 0) {
-        break;
-      }
-      const size_t previous = GlyphPrevious(content(), cursor_position());
-      if (content()[previous] == '\n') {
-        break;
-      }
-      cursor_position() = static_cast<int>(previous);
+    // Move cursor at the beginning of the line above.
+    const int line = LineOf(cursor_position());
+    if (line == 0) {
+      cursor_position() = 0;
+      return true;
     }
+    cursor_position() = static_cast<int>(line_starts_[line - 1]);
 
     MoveCursorColumn(static_cast<int>(columns));
     return true;
@@ -320,18 +796,12 @@ class InputBase : public ComponentBase, public InputOption {
     const size_t columns = CursorColumn();
 
     // Move cursor at the beginning of the next line
-    while (true) {
-      if (content()[cursor_position()] == '\n') {
-        break;
-      }
-      cursor_position() =
-          static_cast<int>(GlyphNext(content(), cursor_position()));
-      if (cursor_position() == (int)content().size()) {
-        return true;
-      }
+    const int line = LineOf(cursor_position());
+    if (line + 1 == (int)line_starts_.size()) {
+      cursor_position() = static_cast<int>(content->size());
+      return true;
     }
-    cursor_position() =
-        static_cast<int>(GlyphNext(content(), cursor_position()));
+    cursor_position() = static_cast<int>(line_starts_[line + 1]);
 
     MoveCursorColumn(static_cast<int>(columns));
     return true;
@@ -356,19 +826,91 @@ class InputBase : public ComponentBase, public InputOption {
   }
 
   bool HandleCharacter(const std::string& character) {
-    if (!insert() && cursor_position() < (int)content->size() &&
-        content()[cursor_position()] != '\n') {
-      DeleteImpl();
-    }
-    content->insert(cursor_position(), character);
+    // In overtype mode, the character replaced is restored along with it.
+    const bool replaced = !insert() &&
+                          cursor_position() < (int)content->size() &&
+                          content()[cursor_position()] != '\n' && DeleteImpl();
+    const int cursor_before = cursor_position();
+    Insert(cursor_position(), character);
     cursor_position() += static_cast<int>(character.size());
+    Record(true, cursor_before, character, cursor_before, replaced);
     on_change();
     return true;
   }
 
+  // The whole text is inserted at once. The line breaks are normalized, and
+  // replaced by spaces when the input isn't multiline.
+  bool HandlePaste(const std::string& text) {
+    std::string normalized;
+    normalized.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+      char c = text[i];
+      if (c == '\r') {
+        if (i + 1 < text.size() && text[i + 1] == '\n') {
+          continue;
+        }
+        c = '\n';
+      }
+      if (c == '\n' && !multiline()) {
+        c = ' ';
+      }
+      normalized += c;
+    }
+    if (normalized.empty()) {
+      return true;
+    }
+    return HandleCharacter(normalized);
+  }
+
+  bool HandleUndo() {
+    const bool undone = history_.Undo([&](const EditHistory::Edit& edit) {
+      if (edit.insert) {
+        Erase(edit.position, edit.text.size());
+      } else {
+        Insert(edit.position, edit.text);
+      }
+      cursor_position() = edit.cursor_before;
+    });
+    if (undone) {
+      on_change();
+    }
+    return undone;
+  }
+
+  bool HandleRedo() {
+    const bool redone = history_.Redo([&](const EditHistory::Edit& edit) {
+      if (edit.insert) {
+        Insert(edit.position, edit.text);
+      } else {
+        Erase(edit.position, edit.text.size());
+      }
+      cursor_position() = edit.cursor_after;
+    });
+    if (redone) {
+      on_change();
+    }
+    return redone;
+  }
+
   bool OnEvent(Event event) override {
     cursor_position() = util::clamp(cursor_position(), 0, (int)content->size());
+    UpdateIndex();
+
+    // The content was modified from outside. The edits recorded no longer
+    // apply to it.
+    if (content->size() != history_size_) {
+      history_.Clear();
+      history_size_ = content->size();
+    }
+    // Only consecutive keystrokes are coalesced.
+    if (!event.is_character() && event != Event::Backspace &&
+        event != Event::Delete) {
+      history_.Seal();
+    }
 
+    if (event.is_paste()) {
+      return HandlePaste(event.input());
+    }
     if (event == Event::Return) {
       return HandleReturn();
     }
@@ -411,6 +953,12 @@ class InputBase : public ComponentBase, public InputOption {
     if (event == Event::Insert) {
       return HandleInsert();
     }
+    if (event == Event::CtrlZ) {
+      return HandleUndo();
+    }
+    if (event == Event::CtrlY) {
+      return HandleRedo();
+    }
     return false;
   }
 
@@ -464,9 +1012,13 @@ class InputBase : public ComponentBase, public InputOption {
   }
 
   bool HandleMouse(Event event) {
-    hovered_ = box_.Contain(event.mouse().x,  //
-                            event.mouse().y) &&
-               CaptureMouse(event);
+    const bool hovered = box_.Contain(event.mouse().x,  //
+                                      event.mouse().y) &&
+                         CaptureMouse(event);
+    if (hovered != hovered_) {
+      hovered_ = hovered;
+      RequestRedraw();
+    }
     if (!hovered_) {
       return false;
     }
@@ -486,30 +1038,21 @@ class InputBase : public ComponentBase, public InputOption {
     }
 
     // Find the line and index of the cursor.
-    std::vector<std::string> lines = Split(*content);
-    int cursor_line = 0;
-    int cursor_char_index = cursor_position();
-    for (const auto& line : lines) {
-      if (cursor_char_index <= (int)line.size()) {
-        break;
-      }
-
-      cursor_char_index -= static_cast<int>(line.size() + 1);
-      cursor_line++;
-    }
+    const int lines = static_cast<int>(line_starts_.size());
+    const int cursor_line = LineOf(cursor_position());
+    const int cursor_char_index =
+        cursor_position() - static_cast<int>(line_starts_[cursor_line]);
     const int cursor_column =
-        string_width(lines[cursor_line].substr(0, cursor_char_index));
+        string_width(Line(cursor_line).substr(0, cursor_char_index));
 
     int new_cursor_column = cursor_column + event.mouse().x - cursor_box_.x_min;
     int new_cursor_line = cursor_line + event.mouse().y - cursor_box_.y_min;
 
     // Fix the new cursor position:
-    new_cursor_line = std::max(std::min(new_cursor_line, (int)lines.size()), 0);
+    new_cursor_line = std::max(std::min(new_cursor_line, lines), 0);
 
-    const std::string empty_string;
-    const std::string& line = new_cursor_line < (int)lines.size()
-                                  ? lines[new_cursor_line]
-                                  : empty_string;
+    const std::string_view line =
+        new_cursor_line < lines ? Line(new_cursor_line) : std::string_view();
     new_cursor_column = util::clamp(new_cursor_column, 0, string_width(line));
 
     if (new_cursor_column == cursor_column &&  //
@@ -518,10 +1061,9 @@ class InputBase : public ComponentBase, public InputOption {
     }
 
     // Convert back the new_cursor_{line,column} toward cursor_position:
-    cursor_position() = 0;
-    for (int i = 0; i < new_cursor_line; ++i) {
-      cursor_position() += static_cast<int>(lines[i].size() + 1);
-    }
+    cursor_position() = new_cursor_line < lines
+                            ? static_cast<int>(line_starts_[new_cursor_line])
+                            : static_cast<int>(content->size());
     while (new_cursor_column > 0) {
       new_cursor_column -=
           static_cast<int>(GlyphWidth(content(), cursor_position()));
@@ -544,6 +1086,18 @@ class InputBase : public ComponentBase, public InputOption {
 
   Box box_;
   Box cursor_box_;
+
+  // The position of every line of the content, when its size was
+  // |indexed_size_|.
+  std::vector<size_t> line_starts_;
+  size_t indexed_size_ = 0;
+
+  // The edits to undo, made to the content when its size was |history_size_|.
+  EditHistory history_;
+  size_t history_size_ = 0;
+
+  // The states of |highlight|, when set.
+  HighlightCache highlight_cache_;
 };
 
 }  // namespace
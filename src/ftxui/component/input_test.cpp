@@ -188,6 +188,28 @@ TEST(InputTest, ArrowUpDown) {
   EXPECT_EQ(cursor_position, 7);
 }
 
+TEST(InputTest, Paste) {
+  std::string content = "ad";
+  int cursor_position = 1;
+  bool entered = false;
+  auto option = InputOption();
+  option.cursor_position = &cursor_position;
+  option.on_enter = [&] { entered = true; };
+  Component input = Input(&content, option);
+
+  // The text is inserted at once, the line breaks are normalized.
+  input->OnEvent(Event::Paste("b\r\nc\r"));
+  EXPECT_EQ(content, "ab\nc\nd");
+  EXPECT_EQ(cursor_position, 5);
+  EXPECT_FALSE(entered);
+
+  // A single line input replaces them by spaces.
+  std::string line;
+  Component single_line = Input(&line, {.multiline = false});
+  single_line->OnEvent(Event::Paste("a\nb"));
+  EXPECT_EQ(line, "a b");
+}
+
 TEST(InputTest, Insert) {
   std::string content;
   int cursor_position = 0;
@@ -590,6 +612,31 @@ TEST(InputTest, TypePassword) {
   EXPECT_EQ(screen.PixelAt(1, 0).character, "•");
 }
 
+TEST(InputTest, PasswordGlyphs) {
+  std::string content = "a测ā\nb";
+  Component input = Input(&content, {
+                                        .transform = [](InputState state) {
+                                          return state.element;
+                                        },
+                                        .password = true,
+                                    });
+
+  // One bullet per glyph, whatever its size in bytes.
+  auto screen = Screen::Create(Dimension::Fixed(5), Dimension::Fixed(2));
+  Render(screen, input->Render());
+  EXPECT_EQ(screen.ToString(),
+            "•••  \r\n"
+            "•    ");
+
+  // The cursor line is masked the same way.
+  EXPECT_TRUE(input->OnEvent(Event::End));
+  screen.Clear();
+  Render(screen, input->Render());
+  EXPECT_EQ(screen.ToString(),
+            "•••  \r\n"
+            "•    ");
+}
+
 TEST(InputTest, MouseClick) {
   std::string content;
   int cursor_position = 0;
@@ -781,4 +828,317 @@ TEST(InputTest, InsertMode) {
   EXPECT_EQ(content, "axyz\nefgX");
 }
 
+TEST(InputTest, LinesFollowEdits) {
+  std::string content = "abc\ndef\nghi";
+  int cursor_position = 4;
+  Component input = Input(&content, {.cursor_position = &cursor_position});
+
+  // Join the first two lines, then split them again.
+  EXPECT_TRUE(input->OnEvent(Event::Backspace));
+  EXPECT_EQ(content, "abcdef\nghi");
+  EXPECT_TRUE(input->OnEvent(Event::ArrowDown));
+  EXPECT_EQ(cursor_position, 10);
+  EXPECT_TRUE(input->OnEvent(Event::ArrowUp));
+  EXPECT_EQ(cursor_position, 3);
+  EXPECT_TRUE(input->OnEvent(Event::Return));
+  EXPECT_TRUE(input->OnEvent(Event::Character("x\ny")));
+  EXPECT_EQ(content, "abc\nx\nydef\nghi");
+  EXPECT_EQ(cursor_position, 7);
+  EXPECT_TRUE(input->OnEvent(Event::ArrowDown));
+  EXPECT_EQ(cursor_position, 12);
+  EXPECT_TRUE(input->OnEvent(Event::ArrowUp));
+  EXPECT_EQ(cursor_position, 7);
+  EXPECT_TRUE(input->OnEvent(Event::ArrowUp));
+  EXPECT_EQ(cursor_position, 5);
+  EXPECT_TRUE(input->OnEvent(Event::ArrowUp));
+  EXPECT_EQ(cursor_position, 1);
+
+  // Delete a line break.
+  cursor_position = 5;
+  EXPECT_TRUE(input->OnEvent(Event::Delete));
+  EXPECT_EQ(content, "abc\nxydef\nghi");
+  EXPECT_TRUE(input->OnEvent(Event::ArrowDown));
+  EXPECT_EQ(cursor_position, 11);
+}
+
+TEST(InputTest, OnChangeResizesContent) {
+  std::string content;
+  int cursor_position = 0;
+  Component input = Input(&content, {
+                                        .on_change =
+                                            [&] {
+                                              if (content == "a") {
+                                                content = "x\ny\nz";
+                                                cursor_position = 5;
+                                              }
+                                            },
+                                        .cursor_position = &cursor_position,
+                                    });
+  EXPECT_TRUE(input->OnEvent(Event::Character('a')));
+  EXPECT_EQ(content, "x\ny\nz");
+  EXPECT_TRUE(input->OnEvent(Event::ArrowUp));
+  EXPECT_EQ(cursor_position, 3);
+  EXPECT_TRUE(input->OnEvent(Event::ArrowUp));
+  EXPECT_EQ(cursor_position, 1);
+}
+
+TEST(InputTest, LargeContent) {
+  std::string content;
+  for (int i = 0; i < 100000; ++i) {
+    content += "line " + std::to_string(i) + "\n";
+  }
+  int cursor_position = content.find("line 50000");
+  Component input = Input(&content, {
+                                        .transform = [](InputState state) {
+                                          return state.element;
+                                        },
+                                        .cursor_position = &cursor_position,
+                                    });
+
+  auto screen = Screen::Create(Dimension::Fixed(11), Dimension::Fixed(3));
+  Render(screen, input->Render());
+  EXPECT_EQ(screen.ToString(),
+            "line 49999 \r\n"
+            "line 50000 \r\n"
+            "line 50001 ");
+
+  // Click on the line below the cursor.
+  Mouse mouse;
+  mouse.button = Mouse::Button::Left;
+  mouse.motion = Mouse::Motion::Pressed;
+  mouse.x = 2;
+  mouse.y = 2;
+  EXPECT_TRUE(input->OnEvent(Event::Mouse("", mouse)));
+  EXPECT_EQ(cursor_position, int(content.find("line 50001")) + 2);
+
+  // Edit the middle of the content, then reach its end.
+  EXPECT_TRUE(input->OnEvent(Event::Character('X')));
+  EXPECT_TRUE(input->OnEvent(Event::Return));
+  screen.Clear();
+  Render(screen, input->Render());
+  EXPECT_EQ(screen.ToString(),
+            "liX        \r\n"
+            "ne 50001   \r\n"
+            "line 50002 ");
+
+  EXPECT_TRUE(input->OnEvent(Event::End));
+  screen.Clear();
+  Render(screen, input->Render());
+  EXPECT_EQ(screen.ToString(),
+            "line 99998 \r\n"
+            "line 99999 \r\n"
+            "           ");
+}
+
+TEST(InputTest, ContentModifiedOutside) {
+  std::string content = "ab\ncd";
+  Component input = Input(&content, {
+                                        .transform = [](InputState state) {
+                                          return state.element;
+                                        },
+                                    });
+
+  auto screen = Screen::Create(Dimension::Fixed(3), Dimension::Fixed(2));
+  Render(screen, input->Render());
+  EXPECT_EQ(screen.ToString(),
+            "ab \r\n"
+            "cd ");
+
+  // Same size, different lines.
+  content = "a\nbcd";
+  screen.Clear();
+  Render(screen, input->Render());
+  EXPECT_EQ(screen.ToString(),
+            "a  \r\n"
+            "bcd");
+}
+
+TEST(InputTest, Undo) {
+  std::string content = "abc";
+  int cursor_position = 3;
+  Component input = Input(&content, {.cursor_position = &cursor_position});
+
+  // The keystrokes typed in a row are undone at once.
+  EXPECT_TRUE(input->OnEvent(Event::Character('d')));
+  EXPECT_TRUE(input->OnEvent(Event::Character('e')));
+  EXPECT_TRUE(input->OnEvent(Event::ArrowLeft));
+  EXPECT_TRUE(input->OnEvent(Event::Backspace));
+  EXPECT_TRUE(input->OnEvent(Event::Backspace));
+  EXPECT_EQ(content, "abe");
+  EXPECT_TRUE(input->OnEvent(Event::Delete));
+  EXPECT_EQ(content, "ab");
+
+  EXPECT_TRUE(input->OnEvent(Event::CtrlZ));
+  EXPECT_EQ(content, "abe");
+  EXPECT_EQ(cursor_position, 2);
+  EXPECT_TRUE(input->OnEvent(Event::CtrlZ));
+  EXPECT_EQ(content, "abcde");
+  EXPECT_EQ(cursor_position, 4);
+  EXPECT_TRUE(input->OnEvent(Event::CtrlZ));
+  EXPECT_EQ(content, "abc");
+  EXPECT_EQ(cursor_position, 3);
+  EXPECT_FALSE(input->OnEvent(Event::CtrlZ));
+
+  EXPECT_TRUE(input->OnEvent(Event::CtrlY));
+  EXPECT_EQ(content, "abcde");
+  EXPECT_EQ(cursor_position, 5);
+  EXPECT_TRUE(input->OnEvent(Event::CtrlY));
+  EXPECT_EQ(content, "abe");
+  EXPECT_EQ(cursor_position, 2);
+
+  // A new edit forgets the edits undone.
+  EXPECT_TRUE(input->OnEvent(Event::Character('x')));
+  EXPECT_FALSE(input->OnEvent(Event::CtrlY));
+  EXPECT_TRUE(input->OnEvent(Event::CtrlZ));
+  EXPECT_EQ(content, "abe");
+}
+
+TEST(InputTest, UndoOvertype) {
+  std::string content = "abc";
+  int cursor_position = 0;
+  Component input = Input({
+      .content = &content,
+      .insert = false,
+      .cursor_position = &cursor_position,
+  });
+
+  EXPECT_TRUE(input->OnEvent(Event::Character('x')));
+  EXPECT_TRUE(input->OnEvent(Event::Character('y')));
+  EXPECT_EQ(content, "xyc");
+  EXPECT_TRUE(input->OnEvent(Event::CtrlZ));
+  EXPECT_EQ(content, "xbc");
+  EXPECT_TRUE(input->OnEvent(Event::CtrlZ));
+  EXPECT_EQ(content, "abc");
+  EXPECT_EQ(cursor_position, 0);
+  EXPECT_TRUE(input->OnEvent(Event::CtrlY));
+  EXPECT_EQ(content, "xbc");
+  EXPECT_EQ(cursor_position, 1);
+}
+
+TEST(InputTest, UndoMemory) {
+  std::string content;
+  Component input = Input(&content, {.undo_memory = 0});
+  EXPECT_TRUE(input->OnEvent(Event::Character('a')));
+  EXPECT_FALSE(input->OnEvent(Event::CtrlZ));
+
+  // Only the last edits fit.
+  content.clear();
+  input = Input(&content, {.undo_memory = 1000});
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(input->OnEvent(Event::Return));
+  }
+  int undone = 0;
+  while (input->OnEvent(Event::CtrlZ)) {
+    undone++;
+  }
+  EXPECT_GT(undone, 0);
+  EXPECT_LT(undone, 100);
+  EXPECT_EQ(content.size(), size_t(100 - undone));
+}
+
+TEST(InputTest, UndoAfterContentModifiedOutside) {
+  std::string content;
+  Component input = Input(&content);
+  EXPECT_TRUE(input->OnEvent(Event::Character('a')));
+  content = "hello";
+  EXPECT_FALSE(input->OnEvent(Event::CtrlZ));
+  EXPECT_EQ(content, "hello");
+}
+
+TEST(InputTest, Highlight) {
+  std::string content;
+  for (int i = 0; i < 100; ++i) {
+    content += "line " + std::to_string(i) + "\n";
+  }
+  int cursor_position = 0;
+
+  // The digits in red, and the comments in blue. The state is 1 inside a
+  // comment.
+  int calls = 0;
+  auto highlight = [&](std::string_view line, int state,
+                       std::vector<InputToken>* tokens) {
+    calls++;
+    for (size_t i = 0; i < line.size(); ++i) {
+      const std::string_view next = line.substr(i, 2);
+      if (state == 0 && next == "/*") {
+        state = 1;
+      } else if (state == 1 && next == "*/") {
+        if (tokens) {
+          tokens->push_back({i, 2, [](Pixel& p) {
+                               p.foreground_color = Color::Blue;
+                             }});
+        }
+        state = 0;
+        ++i;
+        continue;
+      }
+      const bool digit = line[i] >= '0' && line[i] <= '9';
+      if (tokens && (state == 1 || digit)) {
+        const Color color = state == 1 ? Color::Blue : Color::Red;
+        tokens->push_back({i, 1, [color](Pixel& p) {
+                             p.foreground_color = color;
+                           }});
+      }
+    }
+    return state;
+  };
+  Component input = Input(&content, {
+                                        .transform = [](InputState state) {
+                                          return state.element;
+                                        },
+                                        .cursor_position = &cursor_position,
+                                        .highlight = highlight,
+                                    });
+
+  auto screen = Screen::Create(Dimension::Fixed(10), Dimension::Fixed(5));
+  auto draw = [&] {
+    calls = 0;
+    screen.Clear();
+    Render(screen, input->Render());
+  };
+
+  // The 5 lines drawn are highlighted, and the 4 first ones once more for the
+  // state at the start of the next.
+  draw();
+  EXPECT_EQ(calls, 9);
+  EXPECT_EQ(screen.PixelAt(5, 1).character, "1");
+  EXPECT_EQ(screen.PixelAt(5, 1).foreground_color, Color::Red);
+  EXPECT_EQ(screen.PixelAt(4, 1).foreground_color, Color::Default);
+
+  // Nothing was edited, only the lines drawn are highlighted.
+  draw();
+  EXPECT_EQ(calls, 5);
+
+  // Opening a comment on the cursor line changes the state of the next ones.
+  EXPECT_TRUE(input->OnEvent(Event::Character("/*")));
+  draw();
+  EXPECT_EQ(calls, 9);
+  EXPECT_EQ(screen.PixelAt(0, 0).foreground_color, Color::Blue);
+  EXPECT_EQ(screen.PixelAt(0, 3).foreground_color, Color::Blue);
+
+  // Closing it on the line 2 changes the state of the next ones too.
+  cursor_position = int(content.find("line 2"));
+  EXPECT_TRUE(input->OnEvent(Event::Character("*/")));
+  draw();
+  EXPECT_EQ(calls, 7);
+  EXPECT_EQ(screen.PixelAt(0, 2).foreground_color, Color::Blue);
+  EXPECT_EQ(screen.PixelAt(2, 2).foreground_color, Color::Default);
+  EXPECT_EQ(screen.PixelAt(7, 2).foreground_color, Color::Red);
+  EXPECT_EQ(screen.PixelAt(5, 3).foreground_color, Color::Red);
+
+  // Typing within the comment doesn't change the state of the next line. The
+  // states kept for the lines after it are used again.
+  cursor_position = int(content.find("line 1"));
+  EXPECT_TRUE(input->OnEvent(Event::Character("x")));
+  draw();
+  EXPECT_EQ(calls, 6);
+  EXPECT_EQ(screen.PixelAt(0, 1).foreground_color, Color::Blue);
+  EXPECT_EQ(screen.PixelAt(5, 3).foreground_color, Color::Red);
+
+  // Modified from outside, the content is highlighted from the start.
+  content[0] = 'L';
+  draw();
+  EXPECT_EQ(calls, 9);
+}
+
 }  // namespace ftxui
@@ -0,0 +1,62 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/component/keyed_children.hpp"
+
+#include <string>   // for string
+#include <utility>  // for move, swap
+#include <vector>   // for vector
+
+#include "ftxui/component/component_base.hpp"  // for Component, ComponentBase
+
+namespace ftxui {
+
+/// @brief Keep the children of |container| in sync with a list of keys.
+/// @param container The container, like Container::Vertical(). Its children
+/// are replaced by Update().
+KeyedChildren::KeyedChildren(Component container)
+    : container_(std::move(container)) {}
+
+/// @brief Make the children of the container the components of |keys|.
+/// @param keys The keys, in the order of the children. They are unique.
+/// @param factory Build the component of a key seen for the first time.
+///
+/// The components of the keys already known are reused, not rebuilt. Their
+/// entries are moved from one map to the other, without allocating.
+void KeyedChildren::Update(const std::vector<std::string>& keys,
+                           const Factory& factory) {
+  const Component active = container_->ActiveChild();
+
+  scratch_.clear();
+  scratch_.reserve(keys.size());
+  children_.clear();
+  children_.reserve(keys.size());
+  for (const std::string& key : keys) {
+    auto node = components_.extract(key);
+    if (node.empty()) {
+      auto it = scratch_.emplace(key, factory(key)).first;
+      children_.push_back(it->second);
+      continue;
+    }
+    children_.push_back(node.mapped());
+    scratch_.insert(std::move(node));
+  }
+  // The components left are the ones of the keys removed.
+  std::swap(components_, scratch_);
+
+  container_->SetChildren(children_);
+  children_.clear();
+  scratch_.clear();  // Keeps the buckets for the next update.
+
+  if (active && active->Parent() == container_.get()) {
+    container_->SetActiveChild(active);
+  }
+}
+
+/// @brief The component of |key|, or nullptr if it isn't displayed.
+Component KeyedChildren::Find(const std::string& key) const {
+  auto it = components_.find(key);
+  return it == components_.end() ? nullptr : it->second;
+}
+
+}  // namespace ftxui
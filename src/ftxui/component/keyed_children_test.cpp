@@ -0,0 +1,72 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <map>     // for map
+#include <string>  // for string
+#include <vector>  // for vector
+
+#include "ftxui/component/component.hpp"       // for Button, Vertical
+#include "ftxui/component/component_base.hpp"  // for ComponentBase
+#include "ftxui/component/event.hpp"           // for Event
+#include "ftxui/component/keyed_children.hpp"
+
+// NOLINTBEGIN
+namespace ftxui {
+
+TEST(KeyedChildrenTest, Update) {
+  auto container = Container::Vertical({});
+  KeyedChildren children(container);
+
+  std::map<std::string, int> built;
+  auto factory = [&](const std::string& key) {
+    built[key]++;
+    return Button(key, [] {});
+  };
+
+  children.Update({"a", "b", "c"}, factory);
+  ASSERT_EQ(container->ChildCount(), 3u);
+  Component a = children.Find("a");
+  Component b = children.Find("b");
+  EXPECT_EQ(container->ChildAt(1), b);
+
+  // Focus "b".
+  container->OnEvent(Event::ArrowDown);
+  EXPECT_EQ(container->ActiveChild(), b);
+
+  // Only the new key is built. The removed one is detached. The focus follows
+  // "b" to its new position.
+  children.Update({"z", "c", "b"}, factory);
+  ASSERT_EQ(container->ChildCount(), 3u);
+  EXPECT_EQ(built["a"], 1);
+  EXPECT_EQ(built["b"], 1);
+  EXPECT_EQ(built["c"], 1);
+  EXPECT_EQ(built["z"], 1);
+  EXPECT_EQ(container->ChildAt(2), b);
+  EXPECT_EQ(b->Index(), 2);
+  EXPECT_EQ(container->ActiveChild(), b);
+  EXPECT_EQ(a->Parent(), nullptr);
+  EXPECT_EQ(children.Find("a"), nullptr);
+
+  // A removed key is built again.
+  children.Update({"a"}, factory);
+  EXPECT_EQ(built["a"], 2);
+  EXPECT_NE(children.Find("a"), a);
+  EXPECT_EQ(b->Parent(), nullptr);
+  EXPECT_EQ(container->ChildCount(), 1u);
+}
+
+TEST(KeyedChildrenTest, SetChildrenFromOtherParent) {
+  auto first = Container::Vertical({});
+  auto second = Container::Vertical({});
+  auto child = Button("x", [] {});
+  first->Add(child);
+
+  second->SetChildren({child});
+  EXPECT_EQ(child->Parent(), second.get());
+  EXPECT_EQ(first->ChildCount(), 0u);
+  EXPECT_EQ(second->ChildCount(), 1u);
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -46,6 +46,21 @@ void Loop::RunOnceBlocking() {
   screen_->RunOnceBlocking(component_);
 }
 
+/// @brief Read the terminal input. Call this when stdin is readable, in single
+/// threaded mode.
+/// @see ScreenInteractive::SingleThreaded()
+void Loop::OnInputReadable() {
+  screen_->ReadInput();
+}
+
+/// @brief The number of milliseconds after which `Loop::RunOnce()` has
+/// something to do, in single threaded mode. This is suited as a poll()
+/// timeout: 0 means now, and -1 means only on input.
+/// @see ScreenInteractive::SingleThreaded()
+int Loop::NextTimeout() {
+  return screen_->NextTimeout();
+}
+
 /// Execute the loop, blocking the current thread, up until the loop has
 /// quitted.
 void Loop::Run() {
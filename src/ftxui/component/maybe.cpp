@@ -25,16 +25,36 @@ Component Maybe(Component child, std::function<bool()> show) {
 
    private:
     Element Render() override {
-      return show_() ? ComponentBase::Render() : std::make_unique<Node>();
+      return Shown() ? ComponentBase::Render() : std::make_unique<Node>();
     }
     bool Focusable() const override {
-      return show_() && ComponentBase::Focusable();
+      return Shown() && ComponentBase::Focusable();
     }
     bool OnEvent(Event event) override {
-      return show_() && ComponentBase::OnEvent(event);
+      return Shown() && ComponentBase::OnEvent(event);
+    }
+
+    // The ancestors cache whether they are focusable, which depends on the
+    // condition. They are invalidated when it is noticed changing. The child
+    // is told when it gets hidden, and shown again.
+    bool Shown() const {
+      const bool shown = show_();
+      if (shown != shown_) {
+        shown_ = shown;
+        Private::InvalidateFocus();
+        for (const Component& child : children_) {
+          if (shown) {
+            child->OnShow();
+          } else {
+            child->OnHide();
+          }
+        }
+      }
+      return shown;
     }
 
     std::function<bool()> show_;
+    mutable bool shown_ = true;
   };
 
   auto maybe = Make<Impl>(std::move(show));
@@ -0,0 +1,252 @@
+// Copyright 2024 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <cstddef>     // for size_t
+#include <functional>  // for function
+#include <memory>  // for make_shared, __shared_ptr_access, shared_ptr
+#include <utility>  // for move
+
+#include "ftxui/component/animation.hpp"  // for Params
+#include "ftxui/component/component.hpp"  // for ComponentDecorator, Memo, Make
+#include "ftxui/component/component_base.hpp"  // for Component, ComponentBase
+#include "ftxui/component/event.hpp"           // for Event
+#include "ftxui/component/observable_reads.hpp"  // for ObservableReads
+#include "ftxui/dom/elements.hpp"              // for Element, unpack
+#include "ftxui/dom/node.hpp"                  // for Node
+#include "ftxui/screen/box.hpp"                // for Box
+#include "ftxui/screen/screen.hpp"             // for Screen
+
+namespace ftxui {
+
+namespace {
+
+// Wrap an Element reused across several frames. Its layout only depends on
+// its content and on the box it is assigned. As long as the box doesn't
+// change, the layout of the previous frame is kept, and the Check,
+// ComputeRequirement and SetBox passes aren't propagated into the subtree.
+class MemoNode : public Node {
+ public:
+  explicit MemoNode(Element child) : Node(unpack(std::move(child))) {}
+
+  void ComputeRequirement() override {
+    if (layout_valid_) {
+      return;
+    }
+    Node::ComputeRequirement();
+    requirement_ = children_[0]->requirement();
+  }
+
+  void SetBox(Box box) override {
+    if (layout_valid_) {
+      if (box == box_) {
+        return;
+      }
+
+      // Some elements (flexbox, paragraph, ...) have a requirement depending
+      // on the box they were given. Restart the layout of the subtree, and ask
+      // for one more iteration using its fresh requirement.
+      layout_valid_ = false;
+      need_iteration_ = true;
+      Status status;
+      CheckChild(children_[0].get(), &status);
+    }
+    Node::SetBox(box);
+    children_[0]->SetBox(box);
+  }
+
+  void Check(Status* status) override {
+    if (layout_valid_) {
+      status->need_iteration |= (status->iteration == 0);
+    } else {
+      Node::Check(status);
+    }
+    status->need_iteration |= need_iteration_;
+    need_iteration_ = false;
+  }
+
+  void Render(Screen& screen) override {
+    Node::Render(screen);
+    layout_valid_ = true;
+  }
+
+ private:
+  bool layout_valid_ = false;
+  bool need_iteration_ = false;
+};
+
+class MemoBase : public ComponentBase {
+ public:
+  explicit MemoBase(std::function<size_t()> version)
+      : version_(std::move(version)) {}
+
+ private:
+  Element Render() override {
+    const size_t version = version_ ? version_() : 0;
+    const bool active = Active();
+    const bool focused = Focused();
+    if (!element_ || dirty_ ||       //
+        version != last_version_ ||  //
+        active != last_active_ ||    //
+        focused != last_focused_ ||  //
+        reads_.Changed()) {
+      {
+        const ObservableReads::Recording recording(&reads_);
+        element_ = std::make_shared<MemoNode>(ComponentBase::Render());
+      }
+      dirty_ = false;
+      last_version_ = version;
+      last_active_ = active;
+      last_focused_ = focused;
+    } else {
+      // The Memo components around are invalidated by the same writes.
+      reads_.Forward();
+    }
+    return element_;
+  }
+
+  bool OnEvent(Event event) override {
+    const bool handled = ComponentBase::OnEvent(event);
+
+    // Mouse events are delivered to every components. They can update the
+    // hover state of the child, while not being handled. Not while another
+    // component holds the mouse, like a ResizableSplit being dragged: the
+    // child can't capture it, and reacting to the mouse requires capturing it.
+    dirty_ |= handled || (event.is_mouse() && !MouseCaptured(event));
+    return handled;
+  }
+
+  void OnAnimation(animation::Params& params) override {
+    // Animations are only run when some component requested a new frame. The
+    // child might be one of them.
+    const size_t requests = Private::RequestCount();
+    ComponentBase::OnAnimation(params);
+    dirty_ = true;
+
+    // The components below are animated through this one, so that it is
+    // rendered again.
+    if (Private::RequestCount() != requests) {
+      Private::DropRequests(requests);
+      RequestAnimationFrame();
+    }
+  }
+
+  void ReleaseCache() override {
+    element_ = nullptr;
+    ComponentBase::ReleaseCache();
+  }
+
+  std::function<size_t()> version_;
+  ObservableReads reads_;
+  Element element_;
+  bool dirty_ = true;
+  size_t last_version_ = 0;
+  bool last_active_ = false;
+  bool last_focused_ = false;
+};
+
+}  // namespace
+
+/// @brief Decorate a component |child|. The Element it renders is reused
+/// across frames, as long as |version| returns the same value.
+///
+/// This is an optimization for large, mostly static, parts of the UI. Beside
+/// |version| changing, the child is rendered again when:
+/// - it handles an event, or receives a mouse event while no component holds
+///   the CapturedMouse.
+/// - it runs an animation.
+/// - it gains or loses the focus.
+/// - an Observable it read while rendering is written.
+///
+/// Any other state the child's Render() depends on must be reflected by
+/// |version|.
+/// @param child the component to decorate.
+/// @param version a function returning a different value whenever the
+/// rendering of |child| may have changed.
+/// @ingroup component
+///
+/// ### Example
+///
+/// ```cpp
+/// auto log = Renderer([&] { return vbox(LogLines(log_lines)); });
+/// auto memo_log = Memo(log, [&] { return log_lines.size(); });
+/// ```
+Component Memo(Component child, std::function<size_t()> version) {
+  auto memo = Make<MemoBase>(std::move(version));
+  memo->Add(std::move(child));
+  return memo;
+}
+
+/// @brief Decorate a component |child|. The Element it renders is reused
+/// across frames, until an Observable it read is written.
+/// @param child the component to decorate.
+/// @ingroup component
+/// @see Memo, Observable
+///
+/// Beside the Observable, the child is rendered again like with a |version|:
+/// when it handles an event, runs an animation, or gains or loses the focus.
+///
+/// ### Example
+///
+/// ```cpp
+/// Observable<std::vector<Row>> rows;
+/// auto table = Memo(Renderer([&] { return Table(rows()); }));
+/// ```
+Component Memo(Component child) {
+  return Memo(std::move(child), std::function<size_t()>());
+}
+
+/// @brief Decorate a component. The Element it renders is reused across
+/// frames, as long as |version| returns the same value.
+/// @param version a function returning a different value whenever the
+/// rendering of the decorated component may have changed.
+/// @ingroup component
+/// @see Memo
+///
+/// ### Example
+///
+/// ```cpp
+/// auto component = Renderer([&] { return text(label); });
+/// auto memo_component = component | Memo([&] { return label_version; });
+/// ```
+ComponentDecorator Memo(std::function<size_t()> version) {
+  return [version = std::move(version)](Component child) mutable {
+    return Memo(std::move(child), std::move(version));
+  };
+}
+
+/// @brief Decorate a component |child|. The Element it renders is reused
+/// across frames, as long as |version| holds the same value.
+/// @param child the component to decorate.
+/// @param version a counter to increment whenever the rendering of |child| may
+/// have changed.
+/// @ingroup component
+/// @see Memo
+///
+/// ### Example
+///
+/// ```cpp
+/// auto component = Renderer([&] { return text(label); });
+/// auto memo_component = Memo(component, &label_version);
+/// ```
+Component Memo(Component child, const int* version) {
+  return Memo(std::move(child), [version] { return size_t(*version); });
+}
+
+/// @brief Decorate a component. The Element it renders is reused across
+/// frames, as long as |version| holds the same value.
+/// @param version a counter to increment whenever the rendering of the
+/// decorated component may have changed.
+/// @ingroup component
+/// @see Memo
+///
+/// ### Example
+///
+/// ```cpp
+/// auto component = Renderer([&] { return text(label); });
+/// auto memo_component = component | Memo(&label_version);
+/// ```
+ComponentDecorator Memo(const int* version) {
+  return [version](Component child) { return Memo(std::move(child), version); };
+}
+
+}  // namespace ftxui
@@ -0,0 +1,171 @@
+// Copyright 2024 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <string>  // for string
+
+#include "ftxui/component/component.hpp"  // for Memo, Renderer, Container
+#include "ftxui/component/component_base.hpp"  // for ComponentBase, Component
+#include "ftxui/component/event.hpp"           // for Event
+#include "ftxui/dom/elements.hpp"              // for text, hflow, Element
+#include "ftxui/dom/node.hpp"                  // for Render
+#include "ftxui/screen/screen.hpp"             // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+class CountingNode : public Node {
+ public:
+  CountingNode(int* compute_count, int* set_box_count)
+      : compute_count_(compute_count), set_box_count_(set_box_count) {}
+
+  void ComputeRequirement() override {
+    (*compute_count_)++;
+    requirement_.min_x = 1;
+    requirement_.min_y = 1;
+  }
+
+  void SetBox(Box box) override {
+    (*set_box_count_)++;
+    Node::SetBox(box);
+  }
+
+ private:
+  int* compute_count_;
+  int* set_box_count_;
+};
+}  // namespace
+
+TEST(MemoTest, ReuseElement) {
+  int render_count = 0;
+  int version = 0;
+  std::string label = "a";
+  auto component = Memo(Renderer([&] {
+                          render_count++;
+                          return text(label);
+                        }),
+                        &version);
+
+  Screen screen(3, 1);
+  Render(screen, component->Render());
+  EXPECT_EQ(render_count, 1);
+  EXPECT_EQ(screen.ToString(), "a  ");
+
+  // Not invalidated: the previous Element is reused.
+  label = "b";
+  Render(screen, component->Render());
+  EXPECT_EQ(render_count, 1);
+  EXPECT_EQ(screen.ToString(), "a  ");
+
+  version++;
+  Render(screen, component->Render());
+  EXPECT_EQ(render_count, 2);
+  EXPECT_EQ(screen.ToString(), "b  ");
+}
+
+TEST(MemoTest, HandledEvent) {
+  int render_count = 0;
+  auto child = Renderer([&] {
+    render_count++;
+    return text("a");
+  });
+  child |= CatchEvent([](Event event) { return event == Event::Return; });
+  auto component = Memo(child, [] { return size_t(0); });
+
+  component->Render();
+  component->Render();
+  EXPECT_EQ(render_count, 1);
+
+  EXPECT_FALSE(component->OnEvent(Event::Character('x')));
+  component->Render();
+  EXPECT_EQ(render_count, 1);
+
+  EXPECT_TRUE(component->OnEvent(Event::Return));
+  component->Render();
+  EXPECT_EQ(render_count, 2);
+}
+
+TEST(MemoTest, FocusChange) {
+  int render_count = 0;
+  auto memo = Memo(Renderer([&](bool focused) {
+                     render_count++;
+                     return text(focused ? "focused" : "");
+                   }),
+                   [] { return size_t(0); });
+  auto other = Renderer([](bool) { return text(""); });
+  auto container = Container::Horizontal({memo, other});
+
+  container->Render();
+  container->Render();
+  EXPECT_EQ(render_count, 1);
+
+  other->TakeFocus();
+  container->Render();
+  EXPECT_EQ(render_count, 2);
+}
+
+TEST(MemoTest, BoxChange) {
+  int version = 0;
+  auto component = Memo(Renderer([] {
+                          return hflow({
+                              text("aaa"),
+                              text("bbb"),
+                          });
+                        }),
+                        &version);
+
+  Screen large(6, 2);
+  Render(large, component->Render());
+  EXPECT_EQ(large.ToString(), "aaabbb\r\n      ");
+
+  // The cached requirement is recomputed for the new box.
+  Screen small(3, 2);
+  Render(small, component->Render());
+  EXPECT_EQ(small.ToString(), "aaa\r\nbbb");
+
+  Render(large, component->Render());
+  EXPECT_EQ(large.ToString(), "aaabbb\r\n      ");
+}
+
+TEST(MemoTest, ReuseLayout) {
+  int compute_count = 0;
+  int set_box_count = 0;
+  int version = 0;
+  auto component = Memo(Renderer([&] {
+                          return vbox({
+                              hbox({
+                                  std::make_shared<CountingNode>(
+                                      &compute_count, &set_box_count),
+                              }),
+                          });
+                        }),
+                        &version);
+
+  Screen screen(3, 3);
+  Render(screen, component->Render());
+  EXPECT_EQ(compute_count, 1);
+  EXPECT_EQ(set_box_count, 1);
+
+  // The layout of the previous frame is kept.
+  Render(screen, component->Render());
+  Render(screen, component->Render());
+  EXPECT_EQ(compute_count, 1);
+  EXPECT_EQ(set_box_count, 1);
+
+  // A different box restarts the layout of the subtree. Nothing in it asked
+  // for another iteration: its requirement is kept, only the boxes are
+  // assigned again.
+  Screen other(4, 4);
+  Render(other, component->Render());
+  EXPECT_EQ(compute_count, 1);
+  EXPECT_EQ(set_box_count, 2);
+
+  version++;
+  Render(other, component->Render());
+  EXPECT_EQ(compute_count, 2);
+  EXPECT_EQ(set_box_count, 3);
+}
+
+}  // namespace ftxui
+// NOLINTEND
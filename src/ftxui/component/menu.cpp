@@ -1,23 +1,29 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <algorithm>                // for max, fill_n, reverse
+#include <algorithm>                // for max, fill_n, min, reverse, sort, unique
 #include <chrono>                   // for milliseconds
 #include <ftxui/dom/direction.hpp>  // for Direction, Direction::Down, Direction::Left, Direction::Right, Direction::Up
-#include <functional>               // for function
+#include <cstddef>                  // for size_t
+#include <cstdint>                  // for int64_t, uint64_t
+#include <functional>               // for function, hash
+#include <list>                     // for list
 #include <string>                   // for operator+, string
-#include <utility>                  // for move
+#include <unordered_map>            // for unordered_map
+#include <utility>                  // for move, pair
 #include <vector>                   // for vector, __alloc_traits<>::value_type
 
 #include "ftxui/component/animation.hpp"  // for Animator, Linear
 #include "ftxui/component/component.hpp"  // for Make, Menu, MenuEntry, Toggle
 #include "ftxui/component/component_base.hpp"     // for ComponentBase
 #include "ftxui/component/component_options.hpp"  // for MenuOption, MenuEntryOption, UnderlineOption, AnimatedColorOption, AnimatedColorsOption, EntryState
+#include "ftxui/component/entry_boxes.hpp"  // for EntryBoxes, EntryAt
 #include "ftxui/component/event.hpp"  // for Event, Event::ArrowDown, Event::ArrowLeft, Event::ArrowRight, Event::ArrowUp, Event::End, Event::Home, Event::PageDown, Event::PageUp, Event::Return, Event::Tab, Event::TabReverse
 #include "ftxui/component/mouse.hpp"  // for Mouse, Mouse::Left, Mouse::Released, Mouse::WheelDown, Mouse::WheelUp, Mouse::None
 #include "ftxui/component/screen_interactive.hpp"  // for Component
 #include "ftxui/dom/elements.hpp"  // for operator|, Element, reflect, Decorator, nothing, Elements, bgcolor, color, hbox, separatorHSelector, separatorVSelector, vbox, xflex, yflex, text, bold, focus, inverted, select
 #include "ftxui/dom/node_decorator.hpp"  // for NodeDecorator
+#include "ftxui/dom/static_decorator.hpp"  // for StaticDecorator, operator|, operator|=
 #include "ftxui/screen/box.hpp"          // for Box
 #include "ftxui/screen/color.hpp"        // for Color
 #include "ftxui/screen/util.hpp"         // for clamp
@@ -31,10 +37,10 @@ Element DefaultOptionTransform(const EntryState& state) {
   std::string label = (state.active ? "> " : "  ") + state.label;  // NOLINT
   Element e = text(std::move(label));
   if (state.focused) {
-    e = e | inverted;
+    e |= StaticDecorator(inverted);
   }
   if (state.active) {
-    e = e | bold;
+    e |= StaticDecorator(bold);
   }
   return e;
 }
@@ -119,11 +125,17 @@ class DataSourceScrollIndicator : public NodeDecorator {
     _context->real_start_id =
         _context->estimated_start_id + valid_count.first_visible;
     _context->items_visible = valid_count.valid;
-    const int64_t items_before = _count_items_before(_context->real_start_id);
+    int64_t items_before = _count_items_before(_context->real_start_id);
 
-    const float items_total = _context->v.items_total;
+    float items_total = _context->v.items_total;
     const float widget_height = float(box_.y_max) - box_.y_min + 1;
-    const float visible_portion = float(_context->items_visible) / items_total;
+    float visible_portion = float(_context->items_visible) / items_total;
+    if (_context->variable_height()) {
+      // Measure in rows, instead of items.
+      items_before = _context->rows_before(items_before);
+      items_total = float(_context->rows_total());
+      visible_portion = std::min(1.f, widget_height / items_total);
+    }
     const float start_point = (items_before / items_total) * widget_height;
     const float end_point = start_point + (visible_portion * widget_height);
     const float start_y = box_.y_min + start_point;
@@ -177,10 +189,25 @@ Decorator filelist_scroll_indicator(
   };
 }
 
+// Produce the rows of a DBMenu, for DataSource::v.component_height.
+using ProduceRows = std::function<Element()>;
+
 class DataSourceReflect : public Node {
  public:
-  DataSourceReflect(Element child, DataSource* context, Box* b)
-      : Node(unpack(std::move(child))), _context(context), _box(b) {}
+  DataSourceReflect(Element child,
+                    DataSource* context,
+                    Box* b,
+                    ProduceRows produce)
+      : Node(unpack(std::move(child))),
+        _context(context),
+        _box(b),
+        _produce(std::move(produce)) {}
+
+  void Check(Status* status) final {
+    Node::Check(status);
+    status->need_iteration |= _need_iteration;
+    _need_iteration = false;
+  }
 
   void ComputeRequirement() final {
     Node::ComputeRequirement();
@@ -193,6 +220,26 @@ class DataSourceReflect : public Node {
   void SetBox(Box box) final {
     *_box = box;
     Node::SetBox(box);
+
+    // The height of the menu is known now. Produce the matching number of
+    // rows, and ask for one more layout iteration, instead of drawing another
+    // frame.
+    const int height = box.y_max - box.y_min + 1;
+    const int width = box.x_max - box.x_min + 1;
+    const bool width_changed = _context->columns() && width > 0 &&
+                               width != _context->v.component_width;
+    if (_produce && height > 0 &&
+        (height != _context->v.component_height || width_changed)) {
+      _context->v.component_height = height;
+      _context->v.component_width = _context->columns()
+                                        ? width
+                                        : _context->v.component_width;
+      children_[0] = _produce();
+      Status status;
+      children_[0]->Check(&status);
+      children_[0]->ComputeRequirement();
+      _need_iteration = true;
+    }
     children_[0]->SetBox(box);
   }
 
@@ -201,15 +248,18 @@ class DataSourceReflect : public Node {
     *_box = Box::Intersection(screen.stencil, *_box);
     _context->set_component_height(_box->y_max - _box->y_min + 1);
     //
-    // Redraw to allow VerticalMenu to produce more Elements
-    // This action can cause a cascade of redraws.
+    // Redraw to allow VerticalMenu to produce more Elements. The rows are
+    // already produced for the height assigned during layout, so this only
+    // happens when the menu is clipped by the screen.
     const bool all_items_visible =
         _context->v.items_total == _context->v.items_produced;
     const bool rowcount_larger_than_component =
         _context->v.items_total > _context->v.component_height;
+    // The items of variable height are produced for the exact number of rows.
     const bool menu_matched_rowcount =
+        _context->variable_height() ||
         _context->v.component_height ==
-        _context->v.items_produced;  // should also trigger y-shrink
+            _context->v.items_produced;  // should also trigger y-shrink
     if (_context->should_redraw || !all_items_visible &&
                                        rowcount_larger_than_component &&
                                        !menu_matched_rowcount) {
@@ -222,19 +272,117 @@ class DataSourceReflect : public Node {
  private:
   DataSource* _context;
   Box* _box;
+  ProduceRows _produce;
+  bool _need_iteration = false;
 };
 
-Decorator datasource_reflect(DataSource* context, Box* b) {
-  return [context, b](Element child) -> Element {
-    return std::make_shared<DataSourceReflect>(std::move(child), context, b);
+Decorator datasource_reflect(DataSource* context, Box* b, ProduceRows produce) {
+  return [context, b, produce = std::move(produce)](Element child) -> Element {
+    return std::make_shared<DataSourceReflect>(std::move(child), context, b,
+                                               produce);
   };
 }
 
+// Least recently used cache of the rows produced by DataSource::transform, or
+// by the cells of the visible columns.
+using ProduceRow = std::function<Element(DSRenderContext&)>;
+
+class RowCache {
+ public:
+  explicit RowCache(DataSource* data) : data_(data) {}
+
+  Element Get(DSRenderContext& row_info, const ProduceRow& produce) {
+    Synchronize();
+    if (data_->row_cache_capacity <= 0) {
+      return produce(row_info);
+    }
+
+    const Key key = MakeKey(row_info);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return it->second->second;
+    }
+
+    entries_.emplace_front(key, produce(row_info));
+    index_[key] = entries_.begin();
+    while (int(entries_.size()) > data_->row_cache_capacity) {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+    }
+    return entries_.front().second;
+  }
+
+ private:
+  // The id, and the row state packed in the 3 lowest bits.
+  using Key = std::pair<int64_t, int>;
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      return std::hash<int64_t>()(key.first) * 31 + size_t(key.second);
+    }
+  };
+
+  static Key MakeKey(const DSRenderContext& row_info) {
+    return {row_info.id, int(row_info.focused) << 0 |         //
+                             int(row_info.hovered) << 1 |     //
+                             int(row_info.component_focused) << 2};
+  }
+
+  // Apply the invalidations requested on the DataSource.
+  void Synchronize() {
+    if (version_ != data_->rows_version) {
+      version_ = data_->rows_version;
+      entries_.clear();
+      index_.clear();
+    }
+    for (const int64_t id : data_->invalidated_rows) {
+      for (int state = 0; state < 8; ++state) {
+        auto it = index_.find({id, state});
+        if (it != index_.end()) {
+          entries_.erase(it->second);
+          index_.erase(it);
+        }
+      }
+    }
+    data_->invalidated_rows.clear();
+  }
+
+  DataSource* data_;
+  uint64_t version_ = 0;
+  std::list<std::pair<Key, Element>> entries_;
+  std::unordered_map<Key,
+                     std::list<std::pair<Key, Element>>::iterator,
+                     KeyHash>
+      index_;
+};
+
 class VerticalMenu : public ComponentBase {
  public:
-  explicit VerticalMenu(DataSource* dataSource) : data_(dataSource) {}
+  explicit VerticalMenu(DataSource* dataSource)
+      : data_(dataSource), row_cache_(dataSource) {}
 
   int64_t find_start_id() {
+    if (data_->variable_height()) {
+      // Center the focused item, in rows, and keep its end visible.
+      const int64_t height = data_->v.component_height;
+      const int64_t index = data_->id_to_index(data_->focused_id);
+      const int64_t end = data_->rows_before(index + 1);
+      int64_t top = data_->rows_before(index) - height / 2;
+      top = std::max<int64_t>(0, std::min(top, data_->rows_total() - height));
+      int64_t start = data_->index_at_row(top);
+      if (data_->rows_before(start) < end - height) {
+        start = data_->index_at_row(end - height - 1) + 1;
+      }
+      return data_->index_to_id(std::min(start, index));
+    }
+    if (data_->random_access()) {
+      const int64_t height = data_->v.component_height;
+      const int64_t total = data_->v.items_total;
+      int64_t index = data_->id_to_index(data_->focused_id) - height / 2;
+      index = std::max<int64_t>(0, std::min(index, total - height));
+      return data_->index_to_id(index);
+    }
+
     int64_t items_placed = 0;
     int64_t start_id = data_->focused_id;
     data_->move_id_by(start_id, -data_->v.component_height / 2);
@@ -274,8 +422,95 @@ class VerticalMenu : public ComponentBase {
     return valid_count;
   }
 
-  Element Render() override {
+  // Scroll the columns to keep the focused one visible, and list the columns
+  // fitting in |data_->v.component_width|, the last one possibly clipped.
+  void UpdateColumns() {
+    visible_columns_.clear();
+    const int count = data_->column_count();
+    if (count <= 0) {
+      return;
+    }
+    const int width = std::max(1, data_->v.component_width);
+    int& focused = data_->focused_column;
+    int& first = data_->first_column;
+    focused = std::max(0, std::min(focused, count - 1));
+    first = std::max(0, std::min(first, focused));
+    auto column_width = [this](int column) {
+      return data_->column_width ? std::max(0, data_->column_width(column))
+                                 : 1;
+    };
+    int span = 0;
+    for (int column = first; column <= focused; ++column) {
+      span += column_width(column);
+    }
+    while (first < focused && span > width) {
+      span -= column_width(first++);
+    }
+
+    int x = 0;
+    for (int column = first; column < count && x < width; ++column) {
+      const int w = std::min(column_width(column), width - x);
+      visible_columns_.emplace_back(column, w);
+      x += w;
+    }
+
+    // The cached rows hold the cells of the previous columns.
+    if (first != first_column_ || width != width_) {
+      data_->invalidate_rows();
+    } else if (focused != focused_column_) {
+      data_->invalidate_row(data_->focused_id);
+    }
+    first_column_ = first;
+    focused_column_ = focused;
+    width_ = width;
+  }
+
+  Element RenderCells(DSRenderContext& row_info) {
+    DSRenderContext cell_info = row_info;
+    Elements cells;
+    for (const auto& [column, width] : visible_columns_) {
+      cell_info.column = column;
+      cell_info.focused =
+          row_info.focused && column == data_->focused_column;
+      cells.push_back(data_->cell(cell_info) |
+                      size(WIDTH, EQUAL, width));
+    }
+    return hbox(std::move(cells));
+  }
+
+  // The number of rows taken by an item.
+  int64_t ItemRows(int64_t id) {
+    if (!data_->variable_height()) {
+      return 1;
+    }
+    const int64_t index = data_->id_to_index(id);
+    return data_->rows_before(index + 1) - data_->rows_before(index);
+  }
+
+  // Move the focus by |rows|, to the item drawn on the row reached.
+  void MoveByRows(int64_t rows) {
+    data_->update_heights();
+    const int64_t index = data_->id_to_index(data_->focused_id);
+    int64_t row = data_->rows_before(index) + rows;
+    row = std::max<int64_t>(0, std::min(row, data_->rows_total() - 1));
+    data_->focused_id = data_->index_to_id(data_->index_at_row(row));
+  }
+
+  // Produce the rows fitting in |data_->v.component_height|.
+  Element RenderRows() {
     boxes_.resize(data_->v.component_height);
+    if (data_->variable_height()) {
+      data_->update_heights();
+    }
+    const bool columns = data_->columns();
+    if (columns) {
+      UpdateColumns();
+    }
+    const ProduceRow produce =
+        columns ? ProduceRow([this](DSRenderContext& row_info) {
+          return RenderCells(row_info);
+        })
+                : data_->transform;
     data_->v.items_total = data_->dataset_size().total;
     data_->estimated_start_id = find_start_id();
 
@@ -283,13 +518,15 @@ class VerticalMenu : public ComponentBase {
     row_info.id = data_->estimated_start_id;
     row_info.component_focused = Focused();
     Elements elements;
+    int64_t rows = 0;
     if(data_->v.items_total) {
-      while (elements.size() < data_->v.component_height) {
+      while (rows < data_->v.component_height) {
         auto box_index = elements.size();
         row_info.focused = (data_->focused_id == row_info.id);
         row_info.hovered = (data_->hovered_id == row_info.id);
-        elements.push_back(data_->transform(row_info) |
-                          reflect(boxes_[box_index]));
+        elements.push_back(row_cache_.Get(row_info, produce) |
+                           reflect(boxes_[box_index]));
+        rows += ItemRows(row_info.id);
         // Increment loop variables
         if (false == data_->move_id_by(row_info.id, 1)) {
           break;
@@ -298,15 +535,22 @@ class VerticalMenu : public ComponentBase {
     }
     data_->v.items_produced = elements.size();
     boxes_.resize(elements.size());
-    auto reflect = datasource_reflect(data_, &box_);
+    return vbox(std::move(elements)) | yframe;
+  }
+
+  Element Render() override {
+    // The rows are produced for the last known height. If the layout assigns
+    // a different one, they are produced again during the layout.
+    auto produce = [this] { return RenderRows(); };
+    auto reflect = datasource_reflect(data_, &box_, produce);
     auto get_valid_boxes = [this]() { return count_valid_boxes(); };
     auto get_items_before = [this](int64_t id) {
-      return data_->count_items_before(id);
+      return data_->random_access() ? data_->id_to_index(id)
+                                    : data_->count_items_before(id);
     };
     auto scroll =
         filelist_scroll_indicator(data_, get_valid_boxes, get_items_before);
-    return vbox(std::move(elements)) | yframe | std::move(reflect) |
-           std::move(scroll);
+    return RenderRows() | std::move(reflect) | std::move(scroll);
   }
 
   bool mouse_wheel(Event event) {
@@ -327,12 +571,8 @@ class VerticalMenu : public ComponentBase {
 
   bool mouse_click(Event event) {
     if (event.mouse().button == Mouse::Left) {
-      for (int i = 0; i < boxes_.size(); ++i) {
-        const bool in_box = boxes_[i].Contain(event.mouse().x, event.mouse().y);
-        const bool box_out_of_screen = boxes_[i].y_min > box_.y_max;
-        if (box_out_of_screen || !in_box) {
-          continue;
-        }
+      const int i = HoveredBox(event);
+      if (i != -1) {
         data_->focused_id = data_->estimated_start_id;
         data_->move_id_by(data_->focused_id, i);
         TakeFocus();
@@ -343,20 +583,28 @@ class VerticalMenu : public ComponentBase {
   }
 
   bool mouse_move(Event event) {
-    for (int i = 0; i < boxes_.size(); ++i) {
-      const bool in_box = boxes_[i].Contain(event.mouse().x, event.mouse().y);
-      const bool box_out_of_screen = boxes_[i].y_min > box_.y_max;
-      if (box_out_of_screen || !in_box) {
-        continue;
-      }
+    const int i = HoveredBox(event);
+    if (i != -1) {
       data_->hovered_id = data_->estimated_start_id;
       data_->move_id_by(data_->hovered_id, i);
       return true;
     }
-    data_->hovered_id = -1;
+    if (data_->hovered_id != -1) {
+      data_->hovered_id = -1;
+      RequestRedraw();
+    }
     return false;
   }
 
+  int HoveredBox(Event event) {
+    const int i = EntryAt(boxes_, 0, int(boxes_.size()) - 1, Direction::Down,
+                          event.mouse().x, event.mouse().y);
+    if (i == -1 || boxes_[i].y_min > box_.y_max) {
+      return -1;
+    }
+    return i;
+  }
+
   bool OnEvent(Event event) override {
     data_->move_id_by(data_->focused_id, 0);  // << Clamp()
     DSEventContext ctx{
@@ -382,6 +630,10 @@ class VerticalMenu : public ComponentBase {
         data_->move_id_by(data_->focused_id, -1);
       } else if (ctx.event == Event::ArrowDown) {
         data_->move_id_by(data_->focused_id, 1);
+      } else if (ctx.event == Event::PageUp && data_->variable_height()) {
+        MoveByRows(-data_->v.component_height);
+      } else if (ctx.event == Event::PageDown && data_->variable_height()) {
+        MoveByRows(data_->v.component_height);
       } else if (ctx.event == Event::PageUp) {
         data_->move_id_by(data_->focused_id, -height);
       } else if (ctx.event == Event::PageDown) {
@@ -392,6 +644,14 @@ class VerticalMenu : public ComponentBase {
       } else if (ctx.event == Event::End) {
         data_->focused_id = data_->dataset_size().ending_id;
         data_->move_id_by(data_->focused_id, 0);
+      } else if (data_->columns() && ctx.event == Event::ArrowLeft &&
+                 data_->focused_column > 0) {
+        data_->focused_column--;
+        ctx.handled = true;
+      } else if (data_->columns() && ctx.event == Event::ArrowRight &&
+                 data_->focused_column < data_->column_count() - 1) {
+        data_->focused_column++;
+        ctx.handled = true;
       }
     }
     ctx.handled = ctx.handled || data_->focused_id != ctx.starting_focused_id;
@@ -405,7 +665,14 @@ class VerticalMenu : public ComponentBase {
  protected:
   Box box_;
   DataSource* data_;
+  RowCache row_cache_;
   std::vector<Box> boxes_;
+  // The (column, width) of the cells produced, and the window they were
+  // produced for.
+  std::vector<std::pair<int, int>> visible_columns_;
+  int first_column_ = -1;
+  int focused_column_ = -1;
+  int width_ = -1;
 };
 
 /// @brief A list of items. The user can navigate through them.
@@ -431,7 +698,7 @@ class MenuBase : public ComponentBase, public MenuOption {
     if (selected() != selected_previous_) {
       SelectedTakeFocus();
     }
-    boxes_.resize(size());
+    boxes_.Resize(size());
     selected() = util::clamp(selected(), 0, size() - 1);
     selected_previous_ = util::clamp(selected_previous_, 0, size() - 1);
     selected_focus_ = util::clamp(selected_focus_, 0, size() - 1);
@@ -441,20 +708,22 @@ class MenuBase : public ComponentBase, public MenuOption {
   void OnAnimation(animation::Params& params) override {
     animator_first_.OnAnimation(params);
     animator_second_.OnAnimation(params);
-    for (auto& animator : animator_background_) {
-      animator.OnAnimation(params);
-    }
-    for (auto& animator : animator_foreground_) {
-      animator.OnAnimation(params);
-    }
+    animator_background_.OnAnimation(params);
+    animator_foreground_.OnAnimation(params);
   }
 
   Element Render() override {
     Clamp();
     UpdateAnimationTarget();
+    const bool windowed = IsWindowed();
+    boxes_.Clear(windowed);
 
-    Elements elements;
     const bool is_menu_focused = Focused();
+    if (windowed) {
+      return RenderWindowed(is_menu_focused);
+    }
+
+    Elements elements;
     if (elements_prefix) {
       elements.push_back(elements_prefix());
     }
@@ -463,23 +732,7 @@ class MenuBase : public ComponentBase, public MenuOption {
       if (i != 0 && elements_infix) {
         elements.push_back(elements_infix());
       }
-      const bool is_focused = (focused_entry() == i) && is_menu_focused;
-      const bool is_selected = (selected() == i);
-
-      const EntryState state = {
-          entries[i], false, is_selected, is_focused, i,
-      };
-
-      auto focus_management = (selected_focus_ != i) ? nothing
-                              : is_menu_focused      ? focus
-                                                     : select;
-
-      const Element element =
-          (entries_option.transform ? entries_option.transform
-                                    : DefaultOptionTransform)  //
-          (state);
-      elements.push_back(element | AnimatedColorStyle(i) | reflect(boxes_[i]) |
-                         focus_management);
+      elements.push_back(RenderEntry(i, is_menu_focused));
     }
     if (elements_postfix) {
       elements.push_back(elements_postfix());
@@ -515,6 +768,53 @@ class MenuBase : public ComponentBase, public MenuOption {
     }
   }
 
+  Element RenderEntry(int i, bool is_menu_focused) {
+    const bool is_focused = (focused_entry() == i) && is_menu_focused;
+    const bool is_selected = (selected() == i);
+
+    // The label's allocation is reused from one entry and frame to the next.
+    EntryState& state = entry_state_;
+    state.label.assign(entries.view(i));
+    state.state = false;
+    state.active = is_selected;
+    state.focused = is_focused;
+    state.index = i;
+
+    auto focus_management = (selected_focus_ != i) ? nothing
+                            : is_menu_focused      ? focus
+                                                   : select;
+
+    const Element element =
+        (entries_option.transform ? entries_option.transform
+                                  : DefaultOptionTransform)  //
+        (state);
+    return element | AnimatedColorStyle(i) | boxes_.Reflect(i) |
+           StaticDecorator(focus_management);
+  }
+
+  // Vertical menus with many entries only produce the visible ones, like
+  // DBMenu. The layout of the others is deduced from the measure of a previous
+  // frame producing them all.
+  bool IsWindowed() const {
+    return boxes_.Windowed() && !ftxui::IsHorizontal(direction) &&
+           !elements_prefix && !elements_infix && !elements_postfix &&
+           !underline.enabled;
+  }
+
+  Element RenderWindowed(bool is_menu_focused) {
+    const int count = size();
+    const bool inverted = IsInverted(direction);
+    // The rows are counted from the top.
+    auto row = [this, count, inverted, is_menu_focused](int index) {
+      return RenderEntry(inverted ? count - 1 - index : index,
+                         is_menu_focused);
+    };
+    const int selected_row =
+        inverted ? count - 1 - selected_focus_ : selected_focus_;
+    return vbox_virtual(count, 1, std::move(row), selected_row) |
+           ftxui::size(WIDTH, GREATER_THAN, boxes_.Width()) | reflect(box_);
+  }
+
   void SelectedTakeFocus() {
     selected_previous_ = selected();
     selected_focus_ = selected();
@@ -651,23 +951,25 @@ class MenuBase : public ComponentBase, public MenuOption {
     if (!CaptureMouse(event)) {
       return false;
     }
-    for (int i = 0; i < size(); ++i) {
-      if (!boxes_[i].Contain(event.mouse().x, event.mouse().y)) {
-        continue;
-      }
+    const int i = boxes_.At(direction, event.mouse().x, event.mouse().y);
+    if (i == -1) {
+      return false;
+    }
 
-      TakeFocus();
+    TakeFocus();
+    if (focused_entry() != i) {
       focused_entry() = i;
+      RequestRedraw();
+    }
 
-      if (event.mouse().button == Mouse::Left &&
-          event.mouse().motion == Mouse::Pressed) {
-        if (selected() != i) {
-          selected() = i;
-          selected_previous_ = selected();
-          OnChange();
-        }
-        return true;
+    if (event.mouse().button == Mouse::Left &&
+        event.mouse().motion == Mouse::Pressed) {
+      if (selected() != i) {
+        selected() = i;
+        selected_previous_ = selected();
+        OnChange();
       }
+      return true;
     }
     return false;
   }
@@ -700,57 +1002,66 @@ class MenuBase : public ComponentBase, public MenuOption {
   }
 
   void UpdateColorTarget() {
-    if (size() != int(animation_background_.size())) {
-      animation_background_.resize(size());
-      animation_foreground_.resize(size());
-      animator_background_.clear();
-      animator_foreground_.clear();
-
-      const int len = size();
-      animator_background_.reserve(len);
-      animator_foreground_.reserve(len);
-      for (int i = 0; i < len; ++i) {
-        animation_background_[i] = 0.F;
-        animation_foreground_[i] = 0.F;
-        animator_background_.emplace_back(&animation_background_[i], 0.F,
-                                          std::chrono::milliseconds(0),
-                                          animation::easing::Linear);
-        animator_foreground_.emplace_back(&animation_foreground_[i], 0.F,
-                                          std::chrono::milliseconds(0),
-                                          animation::easing::Linear);
-      }
+    if (size() != int(animator_background_.size())) {
+      animator_background_.Resize(size());
+      animator_foreground_.Resize(size());
     }
 
+    // Only the entries with a target other than zero are visited: the
+    // selected one, the focused one, and the previous ones, going back to zero.
     const bool is_menu_focused = Focused();
-    for (int i = 0; i < size(); ++i) {
+    colored_entries_.push_back(selected());
+    if (is_menu_focused) {
+      colored_entries_.push_back(focused_entry());
+    }
+    std::sort(colored_entries_.begin(), colored_entries_.end());
+    colored_entries_.erase(
+        std::unique(colored_entries_.begin(), colored_entries_.end()),
+        colored_entries_.end());
+
+    bool configured = false;
+    size_t kept = 0;
+    for (size_t k = 0; k < colored_entries_.size(); ++k) {
+      const int i = colored_entries_[k];
+      if (i < 0 || i >= size()) {
+        continue;
+      }
       const bool is_focused = (focused_entry() == i) && is_menu_focused;
       const bool is_selected = (selected() == i);
       float target = is_selected ? 1.F : is_focused ? 0.5F : 0.F;  // NOLINT
-      if (animator_background_[i].to() != target) {
-        animator_background_[i] = animation::Animator(
-            &animation_background_[i], target,
-            entries_option.animated_colors.background.duration,
-            entries_option.animated_colors.background.function);
-        animator_foreground_[i] = animation::Animator(
-            &animation_foreground_[i], target,
-            entries_option.animated_colors.foreground.duration,
-            entries_option.animated_colors.foreground.function);
+      if (target != 0.F) {
+        colored_entries_[kept++] = i;
+      }
+      if (animator_background_.to(i) == target) {
+        continue;
       }
+      // The options might have been modified since the last animation.
+      if (!configured) {
+        configured = true;
+        const auto& colors = entries_option.animated_colors;
+        animator_background_.SetDuration(colors.background.duration);
+        animator_background_.SetEasing(colors.background.function);
+        animator_foreground_.SetDuration(colors.foreground.duration);
+        animator_foreground_.SetEasing(colors.foreground.function);
+      }
+      animator_background_.AnimateTo(i, target);
+      animator_foreground_.AnimateTo(i, target);
     }
+    colored_entries_.resize(kept);
   }
 
   Decorator AnimatedColorStyle(int i) {
     Decorator style = nothing;
     if (entries_option.animated_colors.foreground.enabled) {
       style = style | color(Color::Interpolate(
-                          animation_foreground_[i],
+                          animator_foreground_.value(i),
                           entries_option.animated_colors.foreground.inactive,
                           entries_option.animated_colors.foreground.active));
     }
 
     if (entries_option.animated_colors.background.enabled) {
       style = style | bgcolor(Color::Interpolate(
-                          animation_background_[i],
+                          animator_background_.value(i),
                           entries_option.animated_colors.background.inactive,
                           entries_option.animated_colors.background.active));
     }
@@ -810,7 +1121,8 @@ class MenuBase : public ComponentBase, public MenuOption {
   int selected_focus_ = selected();
 
   // Mouse click support:
-  std::vector<Box> boxes_;
+  EntryBoxes boxes_;
+  EntryState entry_state_{};
   Box box_;
 
   // Animation support:
@@ -818,10 +1130,10 @@ class MenuBase : public ComponentBase, public MenuOption {
   float second_ = 0.F;
   animation::Animator animator_first_ = animation::Animator(&first_, 0.F);
   animation::Animator animator_second_ = animation::Animator(&second_, 0.F);
-  std::vector<animation::Animator> animator_background_;
-  std::vector<animation::Animator> animator_foreground_;
-  std::vector<float> animation_background_;
-  std::vector<float> animation_foreground_;
+  animation::AnimatorArray animator_background_;
+  animation::AnimatorArray animator_foreground_;
+  // The entries animated toward a color other than the default one.
+  std::vector<int> colored_entries_;
 };
 
 /// @brief A list of text. The focused element is selected.
@@ -1020,7 +1332,11 @@ Component MenuEntry(MenuEntryOption option) {
         return false;
       }
 
-      hovered_ = box_.Contain(event.mouse().x, event.mouse().y);
+      const bool hovered = box_.Contain(event.mouse().x, event.mouse().y);
+      if (hovered != hovered_) {
+        hovered_ = hovered;
+        RequestRedraw();
+      }
 
       if (!hovered_) {
         return false;
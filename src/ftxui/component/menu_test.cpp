@@ -2,6 +2,8 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 #include <gtest/gtest.h>  // for Test, EXPECT_EQ, Message, TestPartResult, TestInfo (ptr only), TEST
+#include <algorithm>               // for max, min
+#include <cstdint>                 // for int64_t
 #include <ftxui/dom/direction.hpp>  // for Direction, Direction::Down, Direction::Left, Direction::Right, Direction::Up
 #include <string>                   // for string, basic_string
 #include <vector>                   // for vector
@@ -11,6 +13,8 @@
 #include "ftxui/component/component_base.hpp"     // for ComponentBase
 #include "ftxui/component/component_options.hpp"  // for MenuOption
 #include "ftxui/component/event.hpp"  // for Event, Event::ArrowDown, Event::ArrowLeft, Event::ArrowRight, Event::ArrowUp, Event::Return
+#include "ftxui/component/mouse.hpp"  // for Mouse, Mouse::Left, Mouse::None, Mouse::Moved, Mouse::Pressed
+#include "ftxui/dom/elements.hpp"     // for frame, hbox, text, vbox
 #include "ftxui/dom/node.hpp"         // for Render
 #include "ftxui/screen/screen.hpp"    // for Screen
 #include "ftxui/util/ref.hpp"         // for Ref
@@ -60,7 +64,7 @@ TEST(MenuTest, DirectionDown) {
   Screen screen(4, 3);
   Render(screen, menu->Render());
   EXPECT_EQ(screen.ToString(),
-            "\x1B[1m\x1B[7m> 1 \x1B[22m\x1B[27m\r\n"
+            "\x1B[1;7m> 1 \x1B[22;27m\r\n"
             "  2 \r\n"
             "  3 ");
 
@@ -87,7 +91,7 @@ TEST(MenuTest, DirectionsUp) {
   EXPECT_EQ(screen.ToString(),
             "  3 \r\n"
             "  2 \r\n"
-            "\x1B[1m\x1B[7m> 1 \x1B[22m\x1B[27m");
+            "\x1B[1;7m> 1 \x1B[22;27m");
   menu->OnEvent(Event::ArrowDown);
   EXPECT_EQ(selected, 0);
   menu->OnEvent(Event::ArrowUp);
@@ -109,7 +113,7 @@ TEST(MenuTest, DirectionsRight) {
   Screen screen(10, 1);
   Render(screen, menu->Render());
   EXPECT_EQ(screen.ToString(),
-            "\x1B[1m\x1B[7m> 1\x1B[22m\x1B[27m"
+            "\x1B[1;7m> 1\x1B[22;27m"
             "  2"
             "  3 ");
   menu->OnEvent(Event::ArrowLeft);
@@ -135,7 +139,7 @@ TEST(MenuTest, DirectionsLeft) {
   EXPECT_EQ(screen.ToString(),
             "  3"
             "  2"
-            "\x1B[1m\x1B[7m> 1\x1B[22m\x1B[27m ");
+            "\x1B[1;7m> 1\x1B[22;27m ");
   menu->OnEvent(Event::ArrowRight);
   EXPECT_EQ(selected, 0);
   menu->OnEvent(Event::ArrowLeft);
@@ -150,6 +154,129 @@ TEST(MenuTest, DirectionsLeft) {
   EXPECT_EQ(selected, 2);
 }
 
+namespace {
+Event MouseEvent(Mouse::Button button, Mouse::Motion motion, int x, int y) {
+  Mouse mouse;
+  mouse.button = button;
+  mouse.motion = motion;
+  mouse.x = x;
+  mouse.y = y;
+  return Event::Mouse("", mouse);
+}
+}  // namespace
+
+TEST(MenuTest, MouseManyEntries) {
+  int selected = 0;
+  int focused_entry = 0;
+  std::vector<std::string> entries(500, "entry");
+  auto option = MenuOption::Vertical();
+  option.entries = &entries;
+  option.selected = &selected;
+  option.focused_entry = &focused_entry;
+  auto menu = Menu(option);
+  Screen screen(10, 500);
+  Render(screen, menu->Render());
+
+  menu->OnEvent(MouseEvent(Mouse::None, Mouse::Moved, 2, 321));
+  EXPECT_EQ(focused_entry, 321);
+  EXPECT_EQ(selected, 0);
+  EXPECT_TRUE(menu->OnEvent(MouseEvent(Mouse::Left, Mouse::Pressed, 2, 499)));
+  EXPECT_EQ(selected, 499);
+  EXPECT_TRUE(menu->OnEvent(MouseEvent(Mouse::Left, Mouse::Pressed, 2, 0)));
+  EXPECT_EQ(selected, 0);
+  EXPECT_FALSE(menu->OnEvent(MouseEvent(Mouse::Left, Mouse::Pressed, 20, 5)));
+  EXPECT_EQ(selected, 0);
+}
+
+TEST(MenuTest, MouseDirections) {
+  for (auto direction : {Direction::Up, Direction::Down, Direction::Left,
+                         Direction::Right}) {
+    int selected = 0;
+    std::vector<std::string> entries = {"0", "1", "2", "3", "4"};
+    auto menu = Menu(&entries, &selected, {.direction = direction});
+    Screen screen(20, 5);
+    Render(screen, menu->Render());
+    const bool horizontal =
+        direction == Direction::Left || direction == Direction::Right;
+    // Click on every cell, and check the entry label drawn under it.
+    for (int y = 0; y < (horizontal ? 1 : 5); ++y) {
+      for (int x = 0; x < 20; ++x) {
+        const std::string& label = screen.PixelAt(x, y).character;
+        if (label < "0" || label > "4") {
+          continue;
+        }
+        EXPECT_TRUE(
+            menu->OnEvent(MouseEvent(Mouse::Left, Mouse::Pressed, x, y)));
+        EXPECT_EQ(selected, std::stoi(label));
+      }
+    }
+  }
+}
+
+TEST(MenuTest, Windowed) {
+  for (auto direction : {Direction::Down, Direction::Up}) {
+    int selected = 500;
+    int produced = 0;
+    std::vector<std::string> entries;
+    for (int i = 0; i < 1000; ++i) {
+      entries.push_back("entry " + std::to_string(i));
+    }
+    auto option = MenuOption::Vertical();
+    auto transform = option.entries_option.transform;
+    option.entries_option.transform = [&](const EntryState& state) {
+      produced++;
+      return transform(state);
+    };
+    option.direction = direction;
+    auto menu = Menu(&entries, &selected, option);
+    menu->TakeFocus();
+
+    // The first frame produces every entry, to measure them. The next ones
+    // only produce the visible ones, and draw the same thing.
+    std::string frames[2];
+    for (auto& output : frames) {
+      produced = 0;
+      Screen screen(20, 10);
+      Render(screen, hbox({menu->Render() | frame, text("|")}));
+      output = screen.ToString();
+    }
+    EXPECT_EQ(frames[0], frames[1]);
+    EXPECT_EQ(produced, 10);
+
+    // The visible entries are still clickable.
+    Screen screen(20, 10);
+    Render(screen, menu->Render() | frame);
+    for (int y = 0; y < 10; ++y) {
+      std::string line;
+      for (int x = 0; x < 20; ++x) {
+        line += screen.PixelAt(x, y).character;
+      }
+      const int entry = std::stoi(line.substr(line.find("entry ") + 6));
+      EXPECT_TRUE(menu->OnEvent(MouseEvent(Mouse::Left, Mouse::Pressed, 5, y)));
+      EXPECT_EQ(selected, entry);
+    }
+  }
+}
+
+TEST(MenuTest, WindowedMultiline) {
+  int selected = 0;
+  int produced = 0;
+  std::vector<std::string> entries(1000, "entry");
+  MenuOption option;
+  option.entries_option.transform = [&](const EntryState& state) {
+    produced++;
+    return vbox({text(state.label), text(state.label)});
+  };
+  auto menu = Menu(&entries, &selected, option);
+  for (int i = 0; i < 2; ++i) {
+    produced = 0;
+    Screen screen(20, 10);
+    Render(screen, menu->Render() | frame);
+    // The entries aren't single lines: they are all produced.
+    EXPECT_EQ(produced, 1000);
+  }
+}
+
 TEST(MenuTest, AnimationsHorizontal) {
   int selected = 0;
   std::vector<std::string> entries = {"1", "2", "3"};
@@ -159,9 +286,9 @@ TEST(MenuTest, AnimationsHorizontal) {
     Render(screen, menu->Render());
     EXPECT_EQ(
         screen.ToString(),
-        "\x1B[1m\x1B[7m1\x1B[22m\x1B[27m \x1B[2m2\x1B[22m "
-        "\r\n\x1B[97m\x1B[49m\xE2\x94\x80\x1B[90m\x1B["
-        "49m\xE2\x95\xB6\xE2\x94\x80\xE2\x94\x80\x1B[39m\x1B[49m\r\n    ");
+        "\x1B[1;7m1\x1B[22;27m \x1B[2m2\x1B[22m "
+        "\r\n\x1B[97m\xE2\x94\x80\x1B[90m\xE2\x95\xB6\xE2\x94\x80\xE2\x94\x80"
+        "\x1B[39m\r\n    ");
   }
   selected = 1;
   {
@@ -170,8 +297,8 @@ TEST(MenuTest, AnimationsHorizontal) {
     EXPECT_EQ(
         screen.ToString(),
         "\x1B[7m1\x1B[27m \x1B[1m2\x1B[22m "
-        "\r\n\x1B[97m\x1B[49m\xE2\x94\x80\x1B[90m\x1B["
-        "49m\xE2\x95\xB6\xE2\x94\x80\xE2\x94\x80\x1B[39m\x1B[49m\r\n    ");
+        "\r\n\x1B[97m\xE2\x94\x80\x1B[90m\xE2\x95\xB6\xE2\x94\x80\xE2\x94\x80"
+        "\x1B[39m\r\n    ");
   }
   animation::Params params(2s);
   menu->OnAnimation(params);
@@ -181,8 +308,8 @@ TEST(MenuTest, AnimationsHorizontal) {
     EXPECT_EQ(
         screen.ToString(),
         "\x1B[7m1\x1B[27m \x1B[1m2\x1B[22m "
-        "\r\n\x1B[90m\x1B[49m\xE2\x94\x80\xE2\x95\xB4\x1B[97m\x1B["
-        "49m\xE2\x94\x80\x1B[90m\x1B[49m\xE2\x95\xB6\x1B[39m\x1B[49m\r\n    ");
+        "\r\n\x1B[90m\xE2\x94\x80\xE2\x95\xB4\x1B[97m\xE2\x94\x80\x1B[90m"
+        "\xE2\x95\xB6\x1B[39m\r\n    ");
   }
 }
 
@@ -195,10 +322,9 @@ TEST(MenuTest, AnimationsVertical) {
     Render(screen, menu->Render());
     EXPECT_EQ(
         screen.ToString(),
-        "\x1B[90m\x1B[49m\xE2\x94\x82\x1B[1m\x1B[7m\x1B[39m\x1B[49m1\x1B["
-        "22m\x1B[27m        "
-        "\r\n\x1B[97m\x1B[49m\xE2\x95\xB7\x1B[2m\x1B[39m\x1B[49m2\x1B[22m      "
-        "  \r\n\x1B[97m\x1B[49m\xE2\x94\x82\x1B[2m\x1B[39m\x1B[49m3\x1B[22m    "
+        "\x1B[90m\xE2\x94\x82\x1B[1;7;39m1\x1B[22;27m        "
+        "\r\n\x1B[97m\xE2\x95\xB7\x1B[2;39m2\x1B[22m      "
+        "  \r\n\x1B[97m\xE2\x94\x82\x1B[2;39m3\x1B[22m    "
         "    ");
   }
   selected = 1;
@@ -207,9 +333,9 @@ TEST(MenuTest, AnimationsVertical) {
     Render(screen, menu->Render());
     EXPECT_EQ(
         screen.ToString(),
-        "\x1B[90m\x1B[49m\xE2\x94\x82\x1B[7m\x1B[39m\x1B[49m1\x1B[27m        "
-        "\r\n\x1B[97m\x1B[49m\xE2\x95\xB7\x1B[1m\x1B[39m\x1B[49m2\x1B[22m      "
-        "  \r\n\x1B[97m\x1B[49m\xE2\x94\x82\x1B[2m\x1B[39m\x1B[49m3\x1B[22m    "
+        "\x1B[90m\xE2\x94\x82\x1B[7;39m1\x1B[27m        "
+        "\r\n\x1B[97m\xE2\x95\xB7\x1B[1;39m2\x1B[22m      "
+        "  \r\n\x1B[97m\xE2\x94\x82\x1B[2;39m3\x1B[22m    "
         "    ");
   }
   animation::Params params(2s);
@@ -219,9 +345,9 @@ TEST(MenuTest, AnimationsVertical) {
     Render(screen, menu->Render());
     EXPECT_EQ(
         screen.ToString(),
-        "\x1B[97m\x1B[49m\xE2\x95\xB5\x1B[7m\x1B[39m\x1B[49m1\x1B[27m        "
-        "\r\n\x1B[90m\x1B[49m\xE2\x94\x82\x1B[1m\x1B[39m\x1B[49m2\x1B[22m      "
-        "  \r\n\x1B[97m\x1B[49m\xE2\x95\xB7\x1B[2m\x1B[39m\x1B[49m3\x1B[22m    "
+        "\x1B[97m\xE2\x95\xB5\x1B[7;39m1\x1B[27m        "
+        "\r\n\x1B[90m\xE2\x94\x82\x1B[1;39m2\x1B[22m      "
+        "  \r\n\x1B[97m\xE2\x95\xB7\x1B[2;39m3\x1B[22m    "
         "    ");
   }
 }
@@ -271,5 +397,212 @@ TEST(MenuTest, MenuEntryIndex) {
   }
 }
 
+namespace {
+DataSource MakeDataSource(int64_t size, int* moves) {
+  DataSource source;
+  source.dataset_size = [size] { return DataSize{size, 0, size - 1}; };
+  source.count_items_before = [](int64_t id) { return id; };
+  source.move_id_by = [size, moves](int64_t& id, int64_t offset) {
+    (*moves)++;
+    const int64_t initial = id;
+    id = std::max<int64_t>(0, std::min(id + offset, size - 1));
+    return id != initial;
+  };
+  source.transform = [](DSRenderContext& context) {
+    return text(std::to_string(context.id));
+  };
+  return source;
+}
+}  // namespace
+
+TEST(MenuTest, DBMenuRandomAccess) {
+  const int64_t size = 50000000;
+  int walk_moves = 0;
+  int jump_moves = 0;
+  DataSource walk = MakeDataSource(size, &walk_moves);
+  DataSource jump = MakeDataSource(size, &jump_moves);
+  jump.id_to_index = [](int64_t id) { return id; };
+  jump.index_to_id = [](int64_t index) { return index; };
+  auto walk_menu = DBMenu(&walk);
+  auto jump_menu = DBMenu(&jump);
+
+  for (int64_t focused : {int64_t(0), int64_t(3), int64_t(1000),
+                          size - 4, size - 1}) {
+    walk.focused_id = focused;
+    jump.focused_id = focused;
+    walk_moves = 0;
+    jump_moves = 0;
+    Screen walk_screen(10, 10);
+    Screen jump_screen(10, 10);
+    Render(walk_screen, walk_menu->Render());
+    Render(jump_screen, jump_menu->Render());
+    EXPECT_EQ(walk.estimated_start_id, jump.estimated_start_id);
+    EXPECT_EQ(walk_screen.ToString(), jump_screen.ToString());
+
+    // Only the rows rendered are walked through.
+    EXPECT_LE(jump_moves, walk.v.component_height);
+    EXPECT_GT(walk_moves, jump_moves);
+  }
+}
+
+TEST(MenuTest, DBMenuRowCache) {
+  int moves = 0;
+  int transforms = 0;
+  DataSource source = MakeDataSource(1000, &moves);
+  source.row_cache_capacity = 32;
+  source.transform = [&](DSRenderContext& context) {
+    transforms++;
+    return text(std::to_string(context.id) + (context.focused ? "*" : ""));
+  };
+  auto menu = DBMenu(&source);
+
+  Screen screen(6, 10);
+  source.focused_id = 100;
+  Render(screen, menu->Render());
+  EXPECT_EQ(transforms, 10);
+
+  // The window scrolls by one row. Only the row entering the window, and the
+  // two rows whose focus changed are produced.
+  transforms = 0;
+  source.focused_id = 101;
+  Render(screen, menu->Render());
+  EXPECT_EQ(transforms, 3);
+  EXPECT_EQ(screen.PixelAt(0, 0).character, "9");
+  EXPECT_EQ(screen.PixelAt(1, 0).character, "6");
+  EXPECT_EQ(screen.PixelAt(3, 4).character, "");
+  EXPECT_EQ(screen.PixelAt(3, 5).character, "*");
+
+  transforms = 0;
+  Render(screen, menu->Render());
+  EXPECT_EQ(transforms, 0);
+
+  source.invalidate_row(97);
+  Render(screen, menu->Render());
+  EXPECT_EQ(transforms, 1);
+
+  transforms = 0;
+  source.invalidate_rows();
+  Render(screen, menu->Render());
+  EXPECT_EQ(transforms, 10);
+}
+
+TEST(MenuTest, DBMenuHeightSingleFrame) {
+  int moves = 0;
+  DataSource source = MakeDataSource(1000, &moves);
+  auto menu = DBMenu(&source);
+
+  // The rows are produced for the height assigned during the layout, without
+  // needing another frame.
+  for (int height : {7, 15, 3}) {
+    Screen screen(6, height);
+    Render(screen, menu->Render());
+    EXPECT_EQ(source.v.component_height, height);
+    EXPECT_EQ(source.v.items_produced, height);
+    EXPECT_EQ(screen.PixelAt(0, height - 1).character,
+              std::to_string(height - 1).substr(0, 1));
+  }
+
+  // No additional frame was requested.
+  EXPECT_TRUE(source.last_v == RedrawVariables());
+}
+
+TEST(MenuTest, DBMenuColumns) {
+  int moves = 0;
+  int cells = 0;
+  DataSource source = MakeDataSource(1000, &moves);
+  source.column_count = [] { return 1000; };
+  source.column_width = [](int column) { return column % 2 ? 3 : 2; };
+  source.cell = [&](DSRenderContext& context) {
+    cells++;
+    return text(context.focused ? "*" : std::to_string(context.column % 10));
+  };
+  auto menu = DBMenu(&source);
+  menu->TakeFocus();
+
+  // Only the cells of the columns fitting in the width are produced. The
+  // scroll indicator takes the last column.
+  Screen screen(12, 4);
+  Render(screen, menu->Render());
+  cells = 0;
+  Render(screen, menu->Render());
+  EXPECT_EQ(source.v.component_width, 11);
+  EXPECT_EQ(cells, 4 * 5);
+  EXPECT_EQ(screen.PixelAt(0, 0).character, "*");
+  EXPECT_EQ(screen.PixelAt(2, 0).character, "1");
+  EXPECT_EQ(screen.PixelAt(10, 1).character, "4");
+
+  // The columns scroll to keep the focused one visible.
+  for (int i = 0; i < 5; ++i) {
+    menu->OnEvent(Event::ArrowRight);
+  }
+  cells = 0;
+  Render(screen, menu->Render());
+  EXPECT_EQ(source.focused_column, 5);
+  EXPECT_EQ(source.first_column, 2);
+  EXPECT_EQ(cells, 4 * 5);
+  EXPECT_EQ(screen.PixelAt(0, 0).character, "2");
+  EXPECT_EQ(screen.PixelAt(7, 0).character, "*");
+
+  menu->OnEvent(Event::ArrowLeft);
+  Render(screen, menu->Render());
+  EXPECT_EQ(source.first_column, 2);
+  EXPECT_EQ(screen.PixelAt(5, 0).character, "*");
+}
+
+TEST(MenuTest, DBMenuVariableHeight) {
+  int moves = 0;
+  DataSource source = MakeDataSource(1000, &moves);
+  source.id_to_index = [](int64_t id) { return id; };
+  source.index_to_id = [](int64_t index) { return index; };
+  source.item_height = [](int64_t index) { return int(index % 3) + 1; };
+  source.transform = [](DSRenderContext& context) {
+    Elements lines;
+    for (int i = 0; i <= context.id % 3; ++i) {
+      lines.push_back(text(std::to_string(context.id)));
+    }
+    return vbox(std::move(lines));
+  };
+  auto menu = DBMenu(&source);
+  menu->TakeFocus();
+
+  Screen screen(6, 10);
+  source.focused_id = 100;
+  Render(screen, menu->Render());
+  EXPECT_EQ(source.rows_total(), 1000 / 3 * 6 + 1);
+  for (int64_t index : {0, 1, 2, 3, 100, 999, 1000}) {
+    int64_t rows = 0;
+    for (int64_t i = 0; i < index; ++i) {
+      rows += i % 3 + 1;
+    }
+    EXPECT_EQ(source.rows_before(index), rows);
+    if (index < 1000) {
+      EXPECT_EQ(source.index_at_row(rows), index);
+      EXPECT_EQ(source.index_at_row(rows + index % 3), index);
+    }
+  }
+
+  // The focused item is centered in rows: 10 rows hold 5 items here.
+  EXPECT_EQ(source.estimated_start_id, 97);
+  EXPECT_EQ(source.v.items_produced, 5);
+  EXPECT_EQ(screen.PixelAt(1, 1).character, "7");
+  EXPECT_EQ(screen.PixelAt(1, 4).character, "8");
+  EXPECT_EQ(screen.PixelAt(2, 6).character, "0");
+  EXPECT_EQ(screen.PixelAt(2, 9).character, "1");
+
+  // PageDown moves by the height, in rows.
+  menu->OnEvent(Event::PageDown);
+  EXPECT_EQ(source.focused_id, 104);
+  menu->OnEvent(Event::End);
+  Render(screen, menu->Render());
+  EXPECT_EQ(source.estimated_start_id, 995);
+  EXPECT_EQ(screen.PixelAt(2, 9).character, "9");
+
+  // Heights are updated one item at a time.
+  source.item_height = [](int64_t index) { return index == 0 ? 5 : 1; };
+  source.invalidate_height(0);
+  EXPECT_EQ(source.rows_before(1), 5);
+  EXPECT_EQ(source.rows_total(), 1000 / 3 * 6 + 1 + 4);
+}
+
 }  // namespace ftxui
 // NOLINTEND
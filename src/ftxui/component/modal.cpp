@@ -3,39 +3,167 @@
 // the LICENSE file.
 #include <ftxui/component/event.hpp>  // for Event
 #include <ftxui/dom/elements.hpp>  // for operator|, Element, center, clear_under, dbox
+#include <algorithm>               // for max, min
 #include <memory>                  // for __shared_ptr_access, shared_ptr
 #include <utility>                 // for move
 
+#include "ftxui/component/animation.hpp"  // for RequestAnimationFrame
 #include "ftxui/component/component.hpp"  // for Make, Tab, ComponentDecorator, Modal
 #include "ftxui/component/component_base.hpp"  // for Component, ComponentBase
+#include "ftxui/component/component_options.hpp"  // for ModalOption
+#include "ftxui/dom/node.hpp"                     // for Node, Elements
+#include "ftxui/dom/requirement.hpp"              // for Requirement
+#include "ftxui/screen/box.hpp"                   // for Box
+#include "ftxui/screen/image.hpp"                 // for Image
+#include "ftxui/screen/screen.hpp"                // for Screen
 
 namespace ftxui {
 
+namespace {
+
+// The pixels of the main component, drawn below the modal.
+struct Snapshot {
+  bool valid = false;
+  Requirement requirement;
+  Image image{0, 0};
+};
+
+// Render the child, then copy the pixels it covers into the snapshot.
+class SnapshotCapture : public Node {
+ public:
+  SnapshotCapture(Element child, std::shared_ptr<Snapshot> snapshot)
+      : Node({std::move(child)}), snapshot_(std::move(snapshot)) {}
+
+  void ComputeRequirement() override {
+    Node::ComputeRequirement();
+    requirement_ = children_[0]->requirement();
+  }
+
+  void SetBox(Box box) override {
+    Node::SetBox(box);
+    SetChildBox(children_[0].get(), box);
+  }
+
+  void Render(Screen& screen) override {
+    Node::Render(screen);
+    Image& image = snapshot_->image;
+    if (image.dimx() != box_.x_max - box_.x_min + 1 ||
+        image.dimy() != box_.y_max - box_.y_min + 1) {
+      image = Image(std::max(0, box_.x_max - box_.x_min + 1),
+                    std::max(0, box_.y_max - box_.y_min + 1));
+    }
+    image.DrawImage(-box_.x_min, -box_.y_min, screen);
+    // The hyperlink ids are only valid for the current frame of the screen.
+    for (int y = 0; y < image.dimy(); ++y) {
+      for (int x = 0; x < image.dimx(); ++x) {
+        image.PixelAt(x, y).hyperlink = 0;
+      }
+    }
+    snapshot_->requirement = requirement_;
+    snapshot_->valid = true;
+  }
+
+ private:
+  std::shared_ptr<Snapshot> snapshot_;
+};
+
+// Draw the pixels stored by a SnapshotCapture.
+class SnapshotBlit : public Node {
+ public:
+  explicit SnapshotBlit(std::shared_ptr<Snapshot> snapshot)
+      : snapshot_(std::move(snapshot)) {}
+
+  void ComputeRequirement() override {
+    requirement_ = snapshot_->requirement;
+  }
+
+  void Render(Screen& screen) override {
+    const Image& image = snapshot_->image;
+    const Box stencil = screen.stencil;
+    screen.stencil = Box::Intersection(stencil, box_);
+    screen.DrawImage(box_.x_min, box_.y_min, image);
+    screen.stencil = stencil;
+
+    // The area changed, like after a terminal resize: capture it again.
+    if (image.dimx() != box_.x_max - box_.x_min + 1 ||
+        image.dimy() != box_.y_max - box_.y_min + 1) {
+      snapshot_->valid = false;
+      animation::RequestAnimationFrame();
+    }
+  }
+
+ private:
+  std::shared_ptr<Snapshot> snapshot_;
+};
+
+}  // namespace
+
 // Add a |modal| window on top of the |main| component. It is shown one on the
 // top of the other when |show_modal| is true.
 /// @ingroup component
 // NOLINTNEXTLINE
 Component Modal(Component main, Component modal, const bool* show_modal) {
+  return Modal(std::move(main), std::move(modal), show_modal, ModalOption());
+}
+
+// Add a |modal| window on top of the |main| component. It is shown one on the
+// top of the other when |show_modal| is true. With
+// |option.snapshot_background|, the |main| component is rendered once when the
+// modal opens, and its pixels are reused until the modal closes or
+// |option.background_changed| returns true.
+/// @ingroup component
+// NOLINTNEXTLINE
+Component Modal(Component main,
+                Component modal,
+                const bool* show_modal,
+                ModalOption option) {
   class Impl : public ComponentBase {
    public:
-    explicit Impl(Component main, Component modal, const bool* show_modal)
+    explicit Impl(Component main,
+                  Component modal,
+                  const bool* show_modal,
+                  ModalOption option)
         : main_(std::move(main)),
           modal_(std::move(modal)),
-          show_modal_(show_modal) {
+          show_modal_(show_modal),
+          option_(std::move(option)) {
       Add(Container::Tab({main_, modal_}, &selector_));
     }
 
    private:
     Element Render() override {
       selector_ = *show_modal_;
+      if (!*show_modal_) {
+        snapshot_->valid = false;
+        return main_->Render();
+      }
+      return dbox({
+          RenderBackground(),
+          modal_->Render() | clear_under | center,
+      });
+    }
+
+    Element RenderBackground() {
+      if (!option_.snapshot_background) {
+        auto document = main_->Render();
+        if (option_.background) {
+          document = document | option_.background;
+        }
+        return document;
+      }
+
+      if (snapshot_->valid && option_.background_changed &&
+          option_.background_changed()) {
+        snapshot_->valid = false;
+      }
+      if (snapshot_->valid) {
+        return std::make_shared<SnapshotBlit>(snapshot_);
+      }
       auto document = main_->Render();
-      if (*show_modal_) {
-        document = dbox({
-            document,
-            modal_->Render() | clear_under | center,
-        });
+      if (option_.background) {
+        document = document | option_.background;
       }
-      return document;
+      return std::make_shared<SnapshotCapture>(std::move(document), snapshot_);
     }
 
     bool OnEvent(Event event) override {
@@ -46,9 +174,12 @@ Component Modal(Component main, Component modal, const bool* show_modal) {
     Component main_;
     Component modal_;
     const bool* show_modal_;
+    ModalOption option_;
     int selector_ = *show_modal_;
+    std::shared_ptr<Snapshot> snapshot_ = std::make_shared<Snapshot>();
   };
-  return Make<Impl>(main, modal, show_modal);
+  return Make<Impl>(std::move(main), std::move(modal), show_modal,
+                    std::move(option));
 }
 
 // Decorate a component. Add a |modal| window on top of it. It is shown one on
@@ -56,8 +187,18 @@ Component Modal(Component main, Component modal, const bool* show_modal) {
 /// @ingroup component
 // NOLINTNEXTLINE
 ComponentDecorator Modal(Component modal, const bool* show_modal) {
-  return [modal, show_modal](Component main) {
-    return Modal(std::move(main), modal, show_modal);
+  return Modal(std::move(modal), show_modal, ModalOption());
+}
+
+// Decorate a component. Add a |modal| window on top of it. It is shown one on
+// the top of the other when |show_modal| is true.
+/// @ingroup component
+// NOLINTNEXTLINE
+ComponentDecorator Modal(Component modal,
+                         const bool* show_modal,
+                         ModalOption option) {
+  return [modal, show_modal, option](Component main) {
+    return Modal(std::move(main), modal, show_modal, option);
   };
 }
 
@@ -6,6 +6,7 @@
 
 #include "ftxui/component/component.hpp"       // for Renderer, Modal
 #include "ftxui/component/component_base.hpp"  // for ComponentBase
+#include "ftxui/component/component_options.hpp"  // for ModalOption
 #include "ftxui/dom/node.hpp"                  // for Render
 #include "ftxui/screen/screen.hpp"             // for Screen
 
@@ -41,5 +42,53 @@ TEST(ModalTest, Basic) {
             "╰────────╯");
 }
 
+TEST(ModalTest, SnapshotBackground) {
+  int main_renders = 0;
+  auto main = Renderer([&] {
+    ++main_renders;
+    return text("main") | border;
+  });
+  auto modal = Renderer([] { return text("modal") | border; });
+  bool show_modal = true;
+  bool changed = false;
+  ModalOption option;
+  option.snapshot_background = true;
+  option.background_changed = [&] { return changed; };
+  auto component = Modal(main, modal, &show_modal, option);
+
+  const std::string expected =
+      "╭────────╮\r\n"
+      "│main    │\r\n"
+      "│╭─────╮ │\r\n"
+      "││modal│ │\r\n"
+      "│╰─────╯ │\r\n"
+      "│        │\r\n"
+      "╰────────╯";
+  for (int i = 0; i < 3; ++i) {
+    Screen screen(10, 7);
+    Render(screen, component->Render());
+    EXPECT_EQ(screen.ToString(), expected);
+  }
+  EXPECT_EQ(main_renders, 1);
+
+  // The background asks to be rendered again.
+  changed = true;
+  Screen screen(10, 7);
+  Render(screen, component->Render());
+  EXPECT_EQ(screen.ToString(), expected);
+  EXPECT_EQ(main_renders, 2);
+  changed = false;
+
+  // Closing the modal drops the snapshot.
+  show_modal = false;
+  Render(screen, component->Render());
+  EXPECT_EQ(main_renders, 3);
+  show_modal = true;
+  Render(screen, component->Render());
+  EXPECT_EQ(main_renders, 4);
+  Render(screen, component->Render());
+  EXPECT_EQ(main_renders, 4);
+}
+
 }  // namespace ftxui
 // NOLINTEND
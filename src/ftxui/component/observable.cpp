@@ -0,0 +1,79 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <algorithm>  // for sort, unique
+#include <cstddef>    // for size_t
+#include <memory>     // for shared_ptr
+
+#include "ftxui/component/event.hpp"               // for Event
+#include "ftxui/component/observable.hpp"          // for ObservableBase
+#include "ftxui/component/observable_reads.hpp"    // for ObservableReads
+#include "ftxui/component/screen_interactive.hpp"  // for ScreenInteractive
+
+namespace ftxui {
+
+namespace {
+
+// The innermost recording in progress on this thread.
+thread_local ObservableReads::Recording* g_recording = nullptr;  // NOLINT
+// Identifies the recordings, to add an Observable read repeatedly only once.
+thread_local size_t g_recording_id = 0;  // NOLINT
+
+// The writes of a frame are coalesced into a single redraw.
+const int g_redraw_key = 0;
+}  // namespace
+
+void ObservableBase::Read() const {
+  ObservableReads::Record(state_);
+}
+
+void ObservableBase::Written() {
+  Changed();
+  if (ScreenInteractive* screen = ScreenInteractive::Active()) {
+    screen->Post(reinterpret_cast<size_t>(&g_redraw_key), Event::Custom);
+  }
+}
+
+ObservableReads::Recording::Recording(ObservableReads* reads)
+    : reads_(reads), parent_(g_recording), id_(++g_recording_id) {
+  reads_->reads_.clear();
+  g_recording = this;
+}
+
+ObservableReads::Recording::~Recording() {
+  g_recording = parent_;
+  auto& reads = reads_->reads_;
+  std::sort(reads.begin(), reads.end(), [](const Read& a, const Read& b) {
+    return a.state < b.state;
+  });
+  reads.erase(std::unique(reads.begin(), reads.end(),
+                          [](const Read& a, const Read& b) {
+                            return a.state == b.state;
+                          }),
+              reads.end());
+  reads_->Forward();
+}
+
+bool ObservableReads::Changed() const {
+  return std::any_of(reads_.begin(), reads_.end(), [](const Read& read) {
+    return read.state->version != read.version;
+  });
+}
+
+void ObservableReads::Forward() const {
+  if (g_recording == nullptr) {
+    return;
+  }
+  auto& reads = g_recording->reads_->reads_;
+  reads.insert(reads.end(), reads_.begin(), reads_.end());
+}
+
+void ObservableReads::Record(const std::shared_ptr<ObservableState>& state) {
+  if (g_recording == nullptr || state->recorded == g_recording->id_) {
+    return;
+  }
+  state->recorded = g_recording->id_;
+  g_recording->reads_->reads_.push_back({state, state->version});
+}
+
+}  // namespace ftxui
@@ -0,0 +1,55 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_OBSERVABLE_READS_HPP
+#define FTXUI_COMPONENT_OBSERVABLE_READS_HPP
+
+#include <cstddef>  // for size_t
+#include <memory>   // for shared_ptr
+#include <vector>   // for vector
+
+#include "ftxui/component/observable.hpp"  // for ObservableState
+
+namespace ftxui {
+
+// The Observable read while rendering a component, and their version then.
+class ObservableReads {
+ public:
+  // Record the Observable read on this thread while alive, replacing the ones
+  // of |reads|. Recordings nest: the reads of the inner one are also added to
+  // the outer one, once done.
+  class Recording {
+   public:
+    explicit Recording(ObservableReads* reads);
+    ~Recording();
+    Recording(const Recording&) = delete;
+    Recording& operator=(const Recording&) = delete;
+
+   private:
+    ObservableReads* reads_;
+    Recording* parent_;
+    size_t id_;
+    friend ObservableReads;
+  };
+
+  // Whether one of the Observable read was written since.
+  bool Changed() const;
+
+  // Add the reads to the recording in progress, if any. For a component
+  // reusing its previous rendering within another one being recorded.
+  void Forward() const;
+
+  // Add |state| to the recording in progress, if any.
+  static void Record(const std::shared_ptr<ObservableState>& state);
+
+ private:
+  struct Read {
+    std::shared_ptr<const ObservableState> state;
+    size_t version;
+  };
+  std::vector<Read> reads_;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_OBSERVABLE_READS_HPP
@@ -0,0 +1,100 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <string>  // for string
+
+#include "ftxui/component/component.hpp"   // for Memo, Renderer, Container
+#include "ftxui/component/observable.hpp"  // for Observable
+#include "ftxui/dom/elements.hpp"          // for text, hbox
+#include "ftxui/dom/node.hpp"              // for Render
+#include "ftxui/screen/screen.hpp"         // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+TEST(ObservableTest, Value) {
+  Observable<int> owned = 1;
+  EXPECT_EQ(owned(), 1);
+  owned.Set(2);
+  EXPECT_EQ(*owned, 2);
+  EXPECT_EQ(owned.version(), 1u);
+
+  std::string value = "a";
+  Observable<std::string> referenced = &value;
+  referenced.Update([](std::string& s) { s += "b"; });
+  EXPECT_EQ(value, "ab");
+  EXPECT_EQ(referenced->size(), 2u);
+  EXPECT_EQ(referenced.version(), 1u);
+}
+
+TEST(ObservableTest, OnlyReadersRenderedAgain) {
+  Observable<int> clock = 0;
+  Observable<std::string> label{"a"};
+  int clock_renders = 0;
+  int table_renders = 0;
+  auto clock_component = Memo(Renderer([&] {
+    clock_renders++;
+    return text(std::to_string(clock()));
+  }));
+  auto table = Memo(Renderer([&] {
+    table_renders++;
+    return text(label());
+  }));
+  auto component = Container::Horizontal({clock_component, table});
+
+  Screen screen(2, 1);
+  Render(screen, component->Render());
+  EXPECT_EQ(clock_renders, 1);
+  EXPECT_EQ(table_renders, 1);
+  EXPECT_EQ(screen.ToString(), "0a");
+
+  clock.Set(1);
+  Render(screen, component->Render());
+  EXPECT_EQ(clock_renders, 2);
+  EXPECT_EQ(table_renders, 1);
+  EXPECT_EQ(screen.ToString(), "1a");
+
+  label.Set("b");
+  Render(screen, component->Render());
+  EXPECT_EQ(clock_renders, 2);
+  EXPECT_EQ(table_renders, 2);
+  EXPECT_EQ(screen.ToString(), "1b");
+
+  // Nothing written.
+  Render(screen, component->Render());
+  EXPECT_EQ(clock_renders, 2);
+  EXPECT_EQ(table_renders, 2);
+}
+
+TEST(ObservableTest, NestedMemo) {
+  Observable<std::string> label{"a"};
+  int inner_renders = 0;
+  int outer_renders = 0;
+  auto inner = Memo(Renderer([&] {
+    inner_renders++;
+    return text(label());
+  }));
+  auto outer = Memo(Renderer(inner, [&] {
+    outer_renders++;
+    return hbox({text(">"), inner->Render()});
+  }));
+
+  Screen screen(2, 1);
+  Render(screen, outer->Render());
+  EXPECT_EQ(screen.ToString(), ">a");
+
+  // The outer Memo depends on what the inner one read.
+  label.Set("b");
+  Render(screen, outer->Render());
+  EXPECT_EQ(inner_renders, 2);
+  EXPECT_EQ(outer_renders, 2);
+  EXPECT_EQ(screen.ToString(), ">b");
+
+  Render(screen, outer->Render());
+  EXPECT_EQ(inner_renders, 2);
+  EXPECT_EQ(outer_renders, 2);
+}
+
+}  // namespace ftxui
+// NOLINTEND
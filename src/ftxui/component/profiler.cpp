@@ -0,0 +1,215 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/component/profiler.hpp"
+
+#include <algorithm>  // for stable_sort
+#include <array>      // for array
+#include <chrono>     // for duration, steady_clock
+#include <cstdio>     // for snprintf
+#include <string>     // for string, to_string
+#include <utility>    // for move
+#include <vector>     // for vector
+
+#include "ftxui/component/component.hpp"       // for Make
+#include "ftxui/component/component_base.hpp"  // for ComponentBase
+#include "ftxui/component/event.hpp"           // for Event
+#include "ftxui/dom/elements.hpp"  // for text, gridbox, align_right, operator|
+
+namespace ftxui {
+
+namespace {
+
+// A call being measured. The profiled calls below it add their duration to
+// |children|, to be removed from its exclusive time.
+struct Scope {
+  Scope* parent = nullptr;
+  double children = 0;
+};
+
+Scope*& CurrentScope() {
+  thread_local Scope* scope = nullptr;
+  return scope;
+}
+
+template <typename Function>
+auto Measure(double* inclusive, double* exclusive, Function function) {
+  Scope scope;
+  scope.parent = CurrentScope();
+  CurrentScope() = &scope;
+  const auto start = std::chrono::steady_clock::now();
+  auto result = function();
+  const double elapsed =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count();
+  CurrentScope() = scope.parent;
+
+  *inclusive += elapsed;
+  *exclusive += elapsed - scope.children;
+  if (scope.parent) {
+    scope.parent->children += elapsed;
+  }
+  return result;
+}
+
+std::string Milliseconds(double seconds) {
+  std::array<char, 32> buffer{};  // NOLINT
+  (void)std::snprintf(buffer.data(), buffer.size(), "%.2f",
+                      seconds * 1000.0);  // NOLINT
+  return buffer.data();
+}
+
+void WriteEscaped(std::ostream& out, const std::string& value) {
+  for (const char c : value) {
+    switch (c) {
+      case '"':
+        out << "\\\"";
+        break;
+      case '\\':
+        out << "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {  // NOLINT
+          std::array<char, 8> buffer{};                // NOLINT
+          (void)std::snprintf(buffer.data(), buffer.size(), "\\u%04x",
+                              int(c));  // NOLINT
+          out << buffer.data();
+        } else {
+          out << c;
+        }
+    }
+  }
+}
+
+}  // namespace
+
+/// @brief The time spent by each profiled component, the slowest first, by
+/// exclusive time.
+std::vector<ComponentProfiler::Entry> ComponentProfiler::Entries() const {
+  std::vector<Entry> entries(entries_.begin(), entries_.end());
+  std::stable_sort(entries.begin(), entries.end(),
+                   [](const Entry& a, const Entry& b) {
+                     return a.render_exclusive + a.event_exclusive >
+                            b.render_exclusive + b.event_exclusive;
+                   });
+  return entries;
+}
+
+/// @brief Zero the counters of every profiled component.
+void ComponentProfiler::Reset() {
+  for (Entry& entry : entries_) {
+    std::string name = std::move(entry.name);
+    entry = Entry();
+    entry.name = std::move(name);
+  }
+}
+
+/// @brief A table of the time spent by each profiled component, in
+/// milliseconds, the slowest first.
+Element ComponentProfiler::Table() const {
+  std::vector<Elements> lines;
+  lines.push_back({
+      text("component "),
+      text("renders ") | align_right,
+      text("incl ") | align_right,
+      text("excl ") | align_right,
+      text("events ") | align_right,
+      text("incl ") | align_right,
+      text("excl") | align_right,
+  });
+  for (const Entry& entry : Entries()) {
+    lines.push_back({
+        text(entry.name + " "),
+        text(std::to_string(entry.renders) + " ") | align_right,
+        text(Milliseconds(entry.render_inclusive) + " ") | align_right,
+        text(Milliseconds(entry.render_exclusive) + " ") | align_right,
+        text(std::to_string(entry.events) + " ") | align_right,
+        text(Milliseconds(entry.event_inclusive) + " ") | align_right,
+        text(Milliseconds(entry.event_exclusive)) | align_right,
+    });
+  }
+  return gridbox(std::move(lines));
+}
+
+/// @brief Write the time spent by each profiled component, the slowest first,
+/// as a JSON array. The durations are in seconds.
+void ComponentProfiler::WriteJson(std::ostream& out) const {
+  out << "[";
+  bool first = true;
+  for (const Entry& entry : Entries()) {
+    out << (first ? "\n" : ",\n");
+    first = false;
+    out << R"(  {"name": ")";
+    WriteEscaped(out, entry.name);
+    out << R"(", "renders": )" << entry.renders            //
+        << R"(, "render_inclusive": )" << entry.render_inclusive  //
+        << R"(, "render_exclusive": )" << entry.render_exclusive  //
+        << R"(, "events": )" << entry.events                      //
+        << R"(, "event_inclusive": )" << entry.event_inclusive    //
+        << R"(, "event_exclusive": )" << entry.event_exclusive << "}";
+  }
+  out << "\n]\n";
+}
+
+/// @brief Wrap a component, measuring the time spent in its Render() and
+/// OnEvent().
+/// @param child The wrapped component.
+/// @param name The name of the component, in the reports of |profiler|.
+/// @param profiler Accumulates the time. It must outlive the component.
+/// @ingroup component
+///
+/// ### Example
+///
+/// ```cpp
+/// ComponentProfiler profiler;
+/// auto sidebar = Profiled(Sidebar(), "sidebar", &profiler);
+/// auto editor = Profiled(Editor(), "editor", &profiler);
+/// auto layout = Container::Horizontal({sidebar, editor});
+/// screen.Loop(layout);
+/// profiler.WriteJson(std::cout);
+/// ```
+// NOLINTNEXTLINE
+Component Profiled(Component child,
+                   std::string name,
+                   ComponentProfiler* profiler) {
+  class Impl : public ComponentBase {
+   public:
+    Impl(Component child, ComponentProfiler::Entry* entry) : entry_(entry) {
+      Add(std::move(child));
+    }
+
+   private:
+    Element Render() override {
+      entry_->renders++;
+      return Measure(&entry_->render_inclusive, &entry_->render_exclusive,
+                     [&] { return ComponentBase::Render(); });
+    }
+
+    bool OnEvent(Event event) override {
+      entry_->events++;
+      return Measure(&entry_->event_inclusive, &entry_->event_exclusive,
+                     [&] { return ComponentBase::OnEvent(event); });
+    }
+
+    ComponentProfiler::Entry* entry_;
+  };
+
+  profiler->entries_.emplace_back();
+  ComponentProfiler::Entry* entry = &profiler->entries_.back();
+  entry->name = std::move(name);
+  return Make<Impl>(std::move(child), entry);
+}
+
+/// @brief Decorate a component, measuring the time spent in its Render() and
+/// OnEvent().
+/// @param name The name of the component, in the reports of |profiler|.
+/// @param profiler Accumulates the time. It must outlive the component.
+/// @ingroup component
+/// @see Profiled(Component, std::string, ComponentProfiler*)
+ComponentDecorator Profiled(std::string name, ComponentProfiler* profiler) {
+  return [name = std::move(name), profiler](Component child) {
+    return Profiled(std::move(child), name, profiler);
+  };
+}
+
+}  // namespace ftxui
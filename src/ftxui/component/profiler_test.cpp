@@ -0,0 +1,67 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <sstream>  // for stringstream
+#include <string>   // for string
+
+#include "ftxui/component/component.hpp"  // for Renderer, CatchEvent
+#include "ftxui/component/event.hpp"      // for Event
+#include "ftxui/component/profiler.hpp"
+#include "ftxui/dom/elements.hpp"   // for text
+#include "ftxui/dom/node.hpp"       // for Render
+#include "ftxui/screen/screen.hpp"  // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+TEST(ProfilerTest, NestedComponents) {
+  ComponentProfiler profiler;
+  auto inner = Renderer([] { return text("inner"); }) |
+               Profiled("inner", &profiler);
+  auto outer = Renderer(inner, [&] { return inner->Render(); }) |
+               Profiled("\"outer\"", &profiler);
+
+  for (int i = 0; i < 3; ++i) {
+    outer->Render();
+  }
+  outer->OnEvent(Event::Character('a'));
+
+  auto entries = profiler.Entries();
+  ASSERT_EQ(entries.size(), 2u);
+  const bool inner_first = entries[0].name == "inner";
+  const auto& inner_entry = entries[inner_first ? 0 : 1];
+  const auto& outer_entry = entries[inner_first ? 1 : 0];
+  EXPECT_EQ(outer_entry.name, "\"outer\"");
+  EXPECT_EQ(inner_entry.renders, 3u);
+  EXPECT_EQ(outer_entry.renders, 3u);
+  EXPECT_EQ(inner_entry.events, 1u);
+  EXPECT_EQ(outer_entry.events, 1u);
+
+  // The time of the inner component is excluded from the outer one.
+  EXPECT_GE(outer_entry.render_inclusive, inner_entry.render_inclusive);
+  EXPECT_NEAR(outer_entry.render_exclusive,
+              outer_entry.render_inclusive - inner_entry.render_inclusive,
+              1e-9);
+  EXPECT_DOUBLE_EQ(inner_entry.render_exclusive,
+                   inner_entry.render_inclusive);
+
+  std::stringstream json;
+  profiler.WriteJson(json);
+  EXPECT_NE(json.str().find(R"("name": "inner")"), std::string::npos);
+  EXPECT_NE(json.str().find(R"("name": "\"outer\"")"), std::string::npos);
+
+  Screen screen(60, 3);
+  Render(screen, profiler.Table());
+  EXPECT_NE(screen.ToString().find("inner"), std::string::npos);
+
+  profiler.Reset();
+  for (const auto& entry : profiler.Entries()) {
+    EXPECT_EQ(entry.renders, 0u);
+    EXPECT_EQ(entry.render_inclusive, 0.0);
+  }
+  EXPECT_EQ(profiler.Entries().size(), 2u);
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -8,10 +8,12 @@
 #include "ftxui/component/component.hpp"          // for Make, Radiobox
 #include "ftxui/component/component_base.hpp"     // for ComponentBase
 #include "ftxui/component/component_options.hpp"  // for RadioboxOption, EntryState
+#include "ftxui/component/entry_boxes.hpp"  // for EntryBoxes
 #include "ftxui/component/event.hpp"  // for Event, Event::ArrowDown, Event::ArrowUp, Event::End, Event::Home, Event::PageDown, Event::PageUp, Event::Return, Event::Tab, Event::TabReverse
 #include "ftxui/component/mouse.hpp"  // for Mouse, Mouse::WheelDown, Mouse::WheelUp, Mouse::Left, Mouse::Released
 #include "ftxui/component/screen_interactive.hpp"  // for Component
-#include "ftxui/dom/elements.hpp"  // for operator|, reflect, Element, vbox, Elements, focus, nothing, select
+#include "ftxui/dom/direction.hpp"  // for Direction, Direction::Down
+#include "ftxui/dom/elements.hpp"  // for operator|, reflect, Element, vbox, vbox_virtual, size, Elements, focus, nothing, select, WIDTH, GREATER_THAN
 #include "ftxui/screen/box.hpp"   // for Box
 #include "ftxui/screen/util.hpp"  // for clamp
 #include "ftxui/util/ref.hpp"     // for Ref, ConstStringListRef
@@ -30,26 +32,51 @@ class RadioboxBase : public ComponentBase, public RadioboxOption {
  private:
   Element Render() override {
     Clamp();
-    Elements elements;
+    const bool windowed = boxes_.Windowed();
+    boxes_.Clear(windowed);
     const bool is_menu_focused = Focused();
-    elements.reserve(size());
-    for (int i = 0; i < size(); ++i) {
-      const bool is_focused = (focused_entry() == i) && is_menu_focused;
-      const bool is_selected = (hovered_ == i);
-      auto focus_management = !is_selected      ? nothing
-                              : is_menu_focused ? focus
-                                                : select;
-      auto state = EntryState{
-          entries[i], selected() == i, is_selected, is_focused, i,
+    auto entry_transform =
+        transform ? transform : RadioboxOption::Simple().transform;
+
+    // Radioboxes with many entries only produce the visible ones. The layout
+    // of the others is deduced from the measure of a previous frame producing
+    // them all.
+    if (windowed) {
+      auto row = [this, is_menu_focused,
+                  entry_transform = std::move(entry_transform)](int i) {
+        return RenderEntry(i, is_menu_focused, entry_transform);
       };
-      auto element =
-          (transform ? transform : RadioboxOption::Simple().transform)(state);
+      return vbox_virtual(size(), 1, std::move(row), hovered_) |
+             ftxui::size(WIDTH, GREATER_THAN, boxes_.Width()) | reflect(box_);
+    }
 
-      elements.push_back(element | focus_management | reflect(boxes_[i]));
+    Elements elements;
+    elements.reserve(size());
+    for (int i = 0; i < size(); ++i) {
+      elements.push_back(RenderEntry(i, is_menu_focused, entry_transform));
     }
     return vbox(std::move(elements)) | reflect(box_);
   }
 
+  Element RenderEntry(
+      int i,
+      bool is_menu_focused,
+      const std::function<Element(const EntryState&)>& entry_transform) {
+    const bool is_focused = (focused_entry() == i) && is_menu_focused;
+    const bool is_selected = (hovered_ == i);
+    auto focus_management = !is_selected      ? nothing
+                            : is_menu_focused ? focus
+                                              : select;
+    // The label's allocation is reused from one entry and frame to the next.
+    EntryState& state = entry_state_;
+    state.label.assign(entries.view(i));
+    state.state = selected() == i;
+    state.active = is_selected;
+    state.focused = is_focused;
+    state.index = i;
+    return entry_transform(state) | focus_management | boxes_.Reflect(i);
+  }
+
   // NOLINTNEXTLINE(readability-function-cognitive-complexity)
   bool OnEvent(Event event) override {
     Clamp();
@@ -112,22 +139,24 @@ class RadioboxBase : public ComponentBase, public RadioboxOption {
       return OnMouseWheel(event);
     }
 
-    for (int i = 0; i < size(); ++i) {
-      if (!boxes_[i].Contain(event.mouse().x, event.mouse().y)) {
-        continue;
-      }
+    const int i = boxes_.At(Direction::Down, event.mouse().x, event.mouse().y);
+    if (i == -1) {
+      return false;
+    }
 
-      TakeFocus();
+    TakeFocus();
+    if (focused_entry() != i) {
       focused_entry() = i;
-      if (event.mouse().button == Mouse::Left &&
-          event.mouse().motion == Mouse::Pressed) {
-        if (selected() != i) {
-          selected() = i;
-          on_change();
-        }
-
-        return true;
+      RequestRedraw();
+    }
+    if (event.mouse().button == Mouse::Left &&
+        event.mouse().motion == Mouse::Pressed) {
+      if (selected() != i) {
+        selected() = i;
+        on_change();
       }
+
+      return true;
     }
     return false;
   }
@@ -156,7 +185,7 @@ class RadioboxBase : public ComponentBase, public RadioboxOption {
   }
 
   void Clamp() {
-    boxes_.resize(size());
+    boxes_.Resize(size());
     selected() = util::clamp(selected(), 0, size() - 1);
     focused_entry() = util::clamp(focused_entry(), 0, size() - 1);
     hovered_ = util::clamp(hovered_, 0, size() - 1);
@@ -166,7 +195,8 @@ class RadioboxBase : public ComponentBase, public RadioboxOption {
   int size() const { return int(entries.size()); }
 
   int hovered_ = selected();
-  std::vector<Box> boxes_;
+  EntryBoxes boxes_;
+  EntryState entry_state_{};
   Box box_;
 };
 
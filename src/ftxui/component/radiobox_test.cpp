@@ -11,6 +11,7 @@
 #include "ftxui/component/component_base.hpp"  // for ComponentBase, Component
 #include "ftxui/component/component_options.hpp"  // for RadioboxOption
 #include "ftxui/component/event.hpp"  // for Event, Event::Return, Event::ArrowDown, Event::End, Event::Home, Event::Tab, Event::TabReverse, Event::PageDown, Event::PageUp, Event::ArrowUp
+#include "ftxui/component/mouse.hpp"  // for Mouse, Mouse::Left, Mouse::Pressed
 #include "ftxui/util/ref.hpp"         // for Ref
 #include "gtest/gtest.h"  // for AssertionResult, Message, TestPartResult, EXPECT_EQ, EXPECT_TRUE, Test, EXPECT_FALSE, TEST
 
@@ -305,5 +306,44 @@ TEST(RadioboxTest, RemoveEntries) {
   EXPECT_EQ(focused_entry, 1);
 }
 
+TEST(RadioboxTest, Windowed) {
+  int selected = 0;
+  std::vector<std::string> entries;
+  for (int i = 0; i < 1000; ++i) {
+    entries.push_back("entry " + std::to_string(i));
+  }
+  auto radiobox = Radiobox(&entries, &selected);
+  radiobox->TakeFocus();
+  for (int i = 0; i < 500; ++i) {
+    radiobox->OnEvent(Event::ArrowDown);
+  }
+
+  // The first frame produces every entry, to measure them. The next ones only
+  // produce the visible ones, and draw the same thing.
+  std::string frames[2];
+  for (auto& output : frames) {
+    Screen screen(20, 5);
+    Render(screen, radiobox->Render() | yframe);
+    output = screen.ToString();
+  }
+  EXPECT_EQ(frames[0], frames[1]);
+
+  // Click on the first visible entry.
+  Screen screen(20, 5);
+  Render(screen, radiobox->Render() | yframe);
+  std::string line;
+  for (int x = 0; x < 20; ++x) {
+    line += screen.PixelAt(x, 0).character;
+  }
+  const int entry = std::stoi(line.substr(line.find("entry ") + 6));
+  Mouse mouse;
+  mouse.button = Mouse::Left;
+  mouse.motion = Mouse::Pressed;
+  mouse.x = 5;
+  mouse.y = 0;
+  EXPECT_TRUE(radiobox->OnEvent(Event::Mouse("", mouse)));
+  EXPECT_EQ(selected, entry);
+}
+
 }  // namespace ftxui
 // NOLINTEND
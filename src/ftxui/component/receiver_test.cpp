@@ -1,8 +1,10 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
+#include <string>   // for string
 #include <thread>   // for thread
 #include <utility>  // for move
+#include <vector>   // for vector
 
 #include "ftxui/component/receiver.hpp"
 #include "gtest/gtest.h"  // for AssertionResult, Message, Test, TestPartResult, EXPECT_EQ, EXPECT_TRUE, EXPECT_FALSE, TEST
@@ -77,5 +79,200 @@ TEST(Receiver, BasicWithThread) {
   t23.join();
 }
 
+TEST(Receiver, NonBlocking) {
+  auto receiver = MakeReceiver<int>();
+  auto sender = receiver->MakeSender();
+
+  int value = 0;
+  EXPECT_FALSE(receiver->HasPending());
+  EXPECT_FALSE(receiver->ReceiveNonBlocking(&value));
+
+  sender->Send(1);
+  sender->Send(2);
+  EXPECT_TRUE(receiver->HasPending());
+  EXPECT_TRUE(receiver->ReceiveNonBlocking(&value));
+  EXPECT_EQ(value, 1);
+  EXPECT_TRUE(receiver->ReceiveNonBlocking(&value));
+  EXPECT_EQ(value, 2);
+  EXPECT_FALSE(receiver->ReceiveNonBlocking(&value));
+  EXPECT_FALSE(receiver->HasQuitted());
+
+  sender.reset();
+  EXPECT_TRUE(receiver->HasQuitted());
+}
+
+TEST(Receiver, ReceiveAll) {
+  auto receiver = MakeReceiver<std::string>();
+  auto sender = receiver->MakeSender();
+
+  std::vector<std::string> out = {"x"};
+  EXPECT_EQ(receiver->ReceiveAll(&out), 0u);
+
+  sender->Send("a");
+  sender->Send("b");
+  sender->Send("c");
+  EXPECT_EQ(receiver->ReceiveAll(&out), 3u);
+  EXPECT_EQ(out, std::vector<std::string>({"x", "a", "b", "c"}));
+  EXPECT_FALSE(receiver->HasPending());
+
+  sender->Send("d");
+  EXPECT_EQ(receiver->ReceiveAll(&out), 1u);
+  EXPECT_EQ(out.back(), "d");
+}
+
+TEST(Receiver, SendAll) {
+  auto receiver = MakeReceiver<int>();
+  auto sender = receiver->MakeSender();
+
+  std::vector<int> items = {1, 2, 3};
+  sender->Send(0);
+  sender->SendAll(&items);
+  EXPECT_TRUE(items.empty());
+  sender->SendAll(&items);
+  sender->Send(4);
+
+  std::vector<int> received;
+  EXPECT_EQ(receiver->ReceiveAll(&received), 5u);
+  EXPECT_EQ(received, std::vector<int>({0, 1, 2, 3, 4}));
+}
+
+TEST(Receiver, BoundedDropOldest) {
+  auto receiver = MakeReceiver<int>(3, ReceiverOverflow::DropOldest);
+  auto sender = receiver->MakeSender();
+  for (int i = 0; i < 10; ++i) {
+    sender->Send(i);
+  }
+  sender.reset();
+
+  std::vector<int> out;
+  receiver->ReceiveAll(&out);
+  EXPECT_EQ(out, std::vector<int>({7, 8, 9}));
+  EXPECT_TRUE(receiver->HasQuitted());
+}
+
+TEST(Receiver, BoundedDropNewest) {
+  auto receiver = MakeReceiver<int>(3, ReceiverOverflow::DropNewest);
+  auto sender = receiver->MakeSender();
+  for (int i = 0; i < 10; ++i) {
+    sender->Send(i);
+  }
+  sender.reset();
+
+  int value = 0;
+  std::vector<int> out;
+  while (receiver->Receive(&value)) {
+    out.push_back(value);
+  }
+  EXPECT_EQ(out, std::vector<int>({0, 1, 2}));
+}
+
+TEST(Receiver, BoundedBlock) {
+  auto receiver = MakeReceiver<int>(2, ReceiverOverflow::Block);
+  auto thread = std::thread(
+      [](Sender<int> sender) {
+        for (int i = 0; i < 1000; ++i) {
+          sender->Send(i);
+        }
+      },
+      receiver->MakeSender());
+
+  // Nothing is dropped, the sender waits for room.
+  int value = 0;
+  int expected = 0;
+  while (receiver->Receive(&value)) {
+    EXPECT_EQ(value, expected++);
+  }
+  EXPECT_EQ(expected, 1000);
+  thread.join();
+}
+
+TEST(Receiver, BoundedKeyed) {
+  auto receiver = MakeReceiver<int>(10, ReceiverOverflow::DropOldest);
+  auto sender = receiver->MakeSender();
+  sender->Send(1, /*key=*/0);
+  sender->Send(100);
+  for (int i = 2; i <= 50; ++i) {
+    sender->Send(i, /*key=*/0);
+  }
+  sender->Send(200, /*key=*/1);
+
+  // The keyed items replaced the pending one with the same key, in place.
+  std::vector<int> out;
+  receiver->ReceiveAll(&out);
+  EXPECT_EQ(out, std::vector<int>({50, 100, 200}));
+
+  sender->Send(51, /*key=*/0);
+  receiver->ReceiveAll(&out);
+  EXPECT_EQ(out.back(), 51);
+}
+
+TEST(Receiver, Keyed) {
+  auto receiver = MakeReceiver<int>();
+  auto sender = receiver->MakeSender();
+  sender->Send(1, /*key=*/0);
+  sender->Send(100);
+  for (int i = 2; i <= 50; ++i) {
+    sender->Send(i, /*key=*/0);
+  }
+  sender->Send(200, /*key=*/1);
+
+  // The keyed items replaced the pending one with the same key, in place.
+  int value = 0;
+  std::vector<int> out;
+  EXPECT_TRUE(receiver->ReceiveNonBlocking(&value));
+  EXPECT_EQ(value, 50);
+  receiver->ReceiveAll(&out);
+  EXPECT_EQ(out, std::vector<int>({100, 200}));
+
+  // Once received, the key can be sent again.
+  sender->Send(51, /*key=*/0);
+  sender.reset();
+  EXPECT_TRUE(receiver->Receive(&value));
+  EXPECT_EQ(value, 51);
+  EXPECT_FALSE(receiver->Receive(&value));
+}
+
+// Many producers sending concurrently, while the consumer alternates between
+// blocking and non blocking receptions.
+TEST(Receiver, Contention) {
+  const int producers = 8;
+  const int messages = 20000;
+
+  auto receiver = MakeReceiver<int>();
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back(
+        [p](Sender<int> sender) {
+          for (int i = 0; i < messages; ++i) {
+            sender->Send(p * messages + i);
+          }
+        },
+        receiver->MakeSender());
+  }
+
+  std::vector<int> next(producers, 0);
+  int received = 0;
+  int value = 0;
+  while (receiver->Receive(&value)) {
+    // Messages from a given producer are received in order.
+    const int p = value / messages;
+    EXPECT_EQ(value % messages, next[p]);
+    next[p]++;
+    received++;
+
+    while (receiver->ReceiveNonBlocking(&value)) {
+      const int q = value / messages;
+      EXPECT_EQ(value % messages, next[q]);
+      next[q]++;
+      received++;
+    }
+  }
+  EXPECT_EQ(received, producers * messages);
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
 }  // namespace ftxui
 // NOLINTEND
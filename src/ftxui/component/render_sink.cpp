@@ -0,0 +1,83 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/component/render_sink.hpp"
+
+#include <algorithm>    // for min, sort
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t
+#include <string_view>  // for string_view
+
+#include "ftxui/screen/box.hpp"          // for Box
+#include "ftxui/screen/cell_buffer.hpp"  // for CellBuffer
+#include "ftxui/screen/pixel.hpp"        // for Pixel
+
+namespace ftxui {
+
+/// @brief Fill |frame| with the cells of |screen| drawn differently in
+/// |previous|, and the styles they use.
+/// @param screen The frame drawn.
+/// @param previous The previous frame. Every cell is changed when its size
+/// differs.
+/// @param frame The frame to fill. Its vectors are reused.
+void RenderFrameBuilder::Build(const Screen& screen,
+                               const Screen& previous,
+                               RenderFrame* frame) {
+  frame->screen = &screen;
+  frame->resized = screen.dimx() != previous.dimx() ||  //
+                   screen.dimy() != previous.dimy();
+  frame->cursor = screen.cursor();
+  frame->runs.clear();
+  frame->cells.clear();
+  frame->first_new_style = styles_.size();
+
+  for (const Box& box : screen.Diff(previous)) {
+    const int x_max = std::min(box.x_max, screen.dimx() - 1);
+    const int y_max = std::min(box.y_max, screen.dimy() - 1);
+    for (int y = box.y_min; y <= y_max; ++y) {
+      RenderRun run;
+      run.x = box.x_min;
+      run.y = y;
+      run.begin = frame->cells.size();
+      for (int x = box.x_min; x <= x_max; ++x) {
+        const Pixel& pixel = screen.PixelAt(x, y);
+        const std::string_view glyph =
+            pixel.character.empty() ? std::string_view(" ") : pixel.character;
+        frame->cells.push_back({glyph, StyleOf(screen, pixel)});
+      }
+      run.end = frame->cells.size();
+      frame->runs.push_back(run);
+    }
+  }
+
+  // The rectangles of the diff span several rows. Draw the rows in order.
+  std::sort(frame->runs.begin(), frame->runs.end(),
+            [](const RenderRun& a, const RenderRun& b) {
+              return a.y != b.y ? a.y < b.y : a.x < b.x;
+            });
+  frame->styles = &styles_;
+}
+
+// The id of the style of |pixel|, registered on first use.
+uint32_t RenderFrameBuilder::StyleOf(const Screen& screen, const Pixel& pixel) {
+  const uint32_t foreground = pixel.foreground_color.Key();
+  const uint32_t background = pixel.background_color.Key();
+  const uint32_t attributes = CellBuffer::Attributes(pixel);
+  // Most cells have no hyperlink. Their key is built without allocating.
+  static const std::string no_hyperlink;
+  const std::string& hyperlink =
+      pixel.hyperlink == 0 ? no_hyperlink : screen.Hyperlink(pixel.hyperlink);
+
+  auto key = std::make_tuple(foreground, background, attributes, hyperlink);
+  auto it = style_ids_.find(key);
+  if (it != style_ids_.end()) {
+    return it->second;
+  }
+  const auto id = uint32_t(styles_.size());
+  styles_.push_back({pixel.foreground_color, pixel.background_color,
+                     attributes, hyperlink});
+  style_ids_.emplace(std::move(key), id);
+  return id;
+}
+
+}  // namespace ftxui
@@ -0,0 +1,125 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <memory>  // for make_shared
+#include <string>  // for string
+#include <vector>  // for vector
+
+#include "ftxui/component/component.hpp"  // for Renderer
+#include "ftxui/component/event.hpp"      // for Event
+#include "ftxui/component/render_sink.hpp"
+#include "ftxui/component/screen_interactive.hpp"  // for ScreenInteractive
+#include "ftxui/dom/elements.hpp"                  // for text
+#include "ftxui/screen/cell_buffer.hpp"            // for CellBuffer
+#include "ftxui/screen/color.hpp"                  // for Color
+#include "ftxui/screen/screen.hpp"                 // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+
+std::string Glyphs(const RenderFrame& frame, const RenderRun& run) {
+  std::string glyphs;
+  for (size_t i = run.begin; i < run.end; ++i) {
+    glyphs += std::string(frame.cells[i].glyph);
+  }
+  return glyphs;
+}
+
+}  // namespace
+
+TEST(RenderSinkTest, Resized) {
+  Screen screen(3, 2);
+  screen.PixelAt(0, 0).character = "a";
+  screen.PixelAt(1, 1).character = "b";
+
+  RenderFrameBuilder builder;
+  RenderFrame frame;
+  builder.Build(screen, Screen(0, 0), &frame);
+  EXPECT_TRUE(frame.resized);
+  ASSERT_EQ(frame.runs.size(), 2u);
+  EXPECT_EQ(frame.runs[0].y, 0);
+  EXPECT_EQ(frame.runs[1].y, 1);
+  EXPECT_EQ(Glyphs(frame, frame.runs[0]), "a  ");
+  EXPECT_EQ(Glyphs(frame, frame.runs[1]), " b ");
+  EXPECT_EQ(frame.first_new_style, 0u);
+  EXPECT_EQ(frame.styles->size(), 1u);
+}
+
+TEST(RenderSinkTest, Runs) {
+  Screen previous(6, 3);
+  Screen screen(6, 3);
+  for (int y = 0; y < 2; ++y) {
+    screen.PixelAt(1, y).character = "x";
+    screen.PixelAt(2, y).character = "y";
+  }
+  screen.PixelAt(4, 0).character = "z";
+  screen.PixelAt(4, 0).bold = true;
+  screen.PixelAt(4, 0).foreground_color = Color::Red;
+
+  RenderFrameBuilder builder;
+  RenderFrame frame;
+  builder.Build(previous, Screen(0, 0), &frame);
+  builder.Build(screen, previous, &frame);
+  EXPECT_FALSE(frame.resized);
+
+  // The rows are in order, even when a rectangle spans several of them.
+  ASSERT_EQ(frame.runs.size(), 3u);
+  EXPECT_EQ(frame.runs[0].x, 1);
+  EXPECT_EQ(frame.runs[0].y, 0);
+  EXPECT_EQ(Glyphs(frame, frame.runs[0]), "xy");
+  EXPECT_EQ(frame.runs[1].x, 4);
+  EXPECT_EQ(frame.runs[1].y, 0);
+  EXPECT_EQ(frame.runs[2].x, 1);
+  EXPECT_EQ(frame.runs[2].y, 1);
+
+  // Only the new style is appended.
+  EXPECT_EQ(frame.first_new_style, 1u);
+  ASSERT_EQ(frame.styles->size(), 2u);
+  const RenderStyle& style = (*frame.styles)[frame.cells[frame.runs[1].begin]
+                                                  .style];
+  EXPECT_EQ(style.foreground, Color(Color::Red));
+  EXPECT_EQ(style.attributes, uint32_t(CellBuffer::kBold));
+  EXPECT_EQ(frame.cells[frame.runs[0].begin].style, 0u);
+}
+
+TEST(RenderSinkTest, ScreenInteractive) {
+  class Sink : public RenderSink {
+   public:
+    void Frame(const RenderFrame& frame) override {
+      frames.push_back(frame.runs.size());
+      if (!frame.runs.empty()) {
+        last = Glyphs(frame, frame.runs.back());
+      }
+    }
+    std::vector<size_t> frames;
+    std::string last;
+  };
+  auto sink = std::make_shared<Sink>();
+
+  auto screen = ScreenInteractive::FixedSize(5, 1);
+  screen.OutputSink(sink);
+  std::string label = "hello";
+  int draw_count = 0;
+  screen.Loop(Renderer([&] {
+    Element element = text(label);
+    draw_count++;
+    if (draw_count == 1) {
+      label = "help";
+      screen.PostEvent(Event::Custom);
+    } else {
+      screen.Post(screen.ExitLoopClosure());
+    }
+    return element;
+  }));
+
+  // The first frame is drawn entirely. The second one only changes "lo".
+  ASSERT_EQ(sink->frames.size(), 2u);
+  EXPECT_EQ(sink->frames[0], 1u);
+  EXPECT_EQ(sink->last, "p ");
+}
+
+}  // namespace ftxui
+// NOLINTEND
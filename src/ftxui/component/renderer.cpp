@@ -31,7 +31,13 @@ Component Renderer(std::function<Element()> render) {
    public:
     explicit Impl(std::function<Element()> render)
         : render_(std::move(render)) {}
-    Element Render() override { return render_(); }
+    Element Render() override {
+      // The state of the components might have changed since the last frame.
+      if (Parent() == nullptr) {
+        Private::InvalidateFocus();
+      }
+      return render_();
+    }
     std::function<Element()> render_;
   };
 
@@ -125,7 +131,7 @@ Component Renderer(std::function<Element(bool)> render) {
 ComponentDecorator Renderer(ElementDecorator decorator) {  // NOLINT
   return [decorator](Component component) {                // NOLINT
     return Renderer(component, [component, decorator] {
-      return component->Render() | decorator;
+      return decorator(component->Render());
     });
   };
 }
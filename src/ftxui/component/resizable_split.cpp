@@ -161,6 +161,10 @@ class ResizableSplitBase : public ComponentBase {
 /// @brief A split in between two components.
 /// @param options all the parameters.
 ///
+/// While the split is dragged, the frames are drawn with the mouse captured.
+/// The components wrapped by Memo, the panes and the rest of the UI, reuse
+/// their Element: only their layout is computed again.
+///
 /// ### Example
 ///
 /// ```cpp
@@ -7,7 +7,9 @@
 #include "ftxui/component/component.hpp"  // for ResizableSplit, Renderer, ResizableSplitBottom, ResizableSplitLeft, ResizableSplitRight, ResizableSplitTop
 #include "ftxui/component/component_base.hpp"  // for ComponentBase, Component
 #include "ftxui/component/event.hpp"           // for Event
+#include "ftxui/component/loop.hpp"            // for Loop
 #include "ftxui/component/mouse.hpp"  // for Mouse, Mouse::Left, Mouse::Pressed, Mouse::Released
+#include "ftxui/component/screen_interactive.hpp"  // for ScreenInteractive
 #include "ftxui/dom/elements.hpp"   // for Element, separatorDouble, text
 #include "ftxui/dom/node.hpp"       // for Render
 #include "ftxui/screen/screen.hpp"  // for Screen
@@ -233,5 +235,49 @@ TEST(ResizableSplit, NavigationVertical) {
   EXPECT_FALSE(component_bottom->Active());
 }
 
+// While dragging the split, the memoized components are not rendered again:
+// the panes, because they keep their state, and the rest of the UI, because
+// the mouse is captured.
+TEST(ResizableSplit, DragMemo) {
+  auto screen = ScreenInteractive::FixedSize(20, 3);
+  int position = 5;
+  int left_renders = 0;
+  int right_renders = 0;
+  int status_renders = 0;
+  auto pane = [](int* renders) {
+    return Renderer([renders] {
+             (*renders)++;
+             return text("pane");
+           }) |
+           Memo([] { return 0; });
+  };
+  auto split = ResizableSplitLeft(pane(&left_renders), pane(&right_renders),
+                                  &position);
+  auto component = Container::Vertical({pane(&status_renders), split});
+
+  Loop loop(&screen, component);
+  auto send = [&](Event event) {
+    screen.PostEvent(event);
+    loop.RunOnce();
+  };
+  loop.RunOnce();
+
+  // The separator is at {5, 1}. The terminal coordinates start at 1.
+  send(MousePressed(6, 2));
+  EXPECT_EQ(left_renders, 1);
+  EXPECT_EQ(right_renders, 1);
+  EXPECT_EQ(status_renders, 2);  // The mouse wasn't captured yet.
+
+  for (int x = 7; x < 15; ++x) {
+    send(MousePressed(x, 2));
+    EXPECT_EQ(position, x - 1);
+  }
+  send(MouseReleased(15, 2));
+  EXPECT_EQ(position, 13);
+  EXPECT_EQ(left_renders, 1);
+  EXPECT_EQ(right_renders, 1);
+  EXPECT_EQ(status_renders, 2);
+}
+
 }  // namespace ftxui
 // NOLINTEND
@@ -7,16 +7,23 @@
 #include <atomic>
 #include <chrono>  // for operator-, milliseconds, operator>=, duration, common_type<>::type, time_point
 #include <csignal>  // for signal, SIGTSTP, SIGABRT, SIGWINCH, raise, SIGFPE, SIGILL, SIGINT, SIGSEGV, SIGTERM, __sighandler_t, size_t
+#include <cerrno>  // for errno, EINTR, EAGAIN
 #include <cstdint>
+#include <cmath>               // for ceil
+#include <condition_variable>  // for condition_variable, cv_status
 #include <cstdio>                    // for fileno, stdin
 #include <ftxui/component/task.hpp>  // for Task, Closure, AnimationTask
 #include <ftxui/screen/screen.hpp>  // for Pixel, Screen::Cursor, Screen, Screen::Cursor::Hidden
 #include <functional>        // for function
 #include <initializer_list>  // for initializer_list
 #include <iostream>  // for cout, ostream, operator<<, basic_ostream, endl, flush
+#include <limits>    // for numeric_limits
+#include <map>       // for map
 #include <memory>
+#include <mutex>  // for mutex, lock_guard, unique_lock
 #include <stack>  // for stack
 #include <string>
+#include <string_view>  // for string_view
 #include <thread>       // for thread, sleep_for
 #include <tuple>        // for _Swallow_assign, ignore
 #include <type_traits>  // for decay_t
@@ -27,11 +34,25 @@
 #include "ftxui/component/captured_mouse.hpp"  // for CapturedMouse, CapturedMouseInterface
 #include "ftxui/component/component_base.hpp"  // for ComponentBase
 #include "ftxui/component/event.hpp"           // for Event
+#include "ftxui/component/frame_recorder.hpp"  // for FrameRecorder
+#include "ftxui/component/frame_stats.hpp"     // for FrameStats
 #include "ftxui/component/loop.hpp"            // for Loop
+#include "ftxui/component/mouse.hpp"           // for Mouse, Mouse::Moved
 #include "ftxui/component/receiver.hpp"  // for ReceiverImpl, Sender, MakeReceiver, SenderImpl, Receiver
+#include "ftxui/component/render_sink.hpp"  // for RenderSink, RenderFrame, RenderFrameBuilder
+#include "ftxui/component/session_recorder.hpp"  // for SessionRecorder
+#include "ftxui/component/shared_value.hpp"      // for SharedValueBase
 #include "ftxui/component/terminal_input_parser.hpp"  // for TerminalInputParser
-#include "ftxui/dom/node.hpp"                         // for Node, Render
+#include "ftxui/component/terminal_probe.hpp"  // for TerminalProbe, TerminalCapabilities
+#include "ftxui/component/timer_wheel.hpp"            // for TimerWheel
+#include "ftxui/component/tracer.hpp"                 // for Tracer
+#include "ftxui/component/windows_mouse.hpp"  // for WindowsMouseTranslator, WindowsMouseRecord
+#include "ftxui/dom/elements.hpp"  // for focusPositionRelative, yframe
+#include "ftxui/dom/node.hpp"  // for Node, Render, RenderParallel
+#include "ftxui/dom/worker_pool.hpp"  // for WorkerPool
 #include "ftxui/dom/requirement.hpp"                  // for Requirement
+#include "ftxui/screen/allocations.hpp"  // for AllocationCount, Allocations
+#include "ftxui/screen/cell_buffer.hpp"  // for CellBuffer
 #include "ftxui/screen/pixel.hpp"                     // for Pixel
 #include "ftxui/screen/terminal.hpp"                  // for Dimensions, Size
 
@@ -46,9 +67,10 @@
 #error Must be compiled in UNICODE mode
 #endif
 #else
-#include <sys/select.h>  // for select, FD_ISSET, FD_SET, FD_ZERO, fd_set, timeval
+#include <fcntl.h>  // for fcntl, F_GETFL, F_SETFL, F_SETFD, O_NONBLOCK, FD_CLOEXEC
+#include <poll.h>   // for poll, pollfd, POLLIN
 #include <termios.h>  // for tcsetattr, termios, tcgetattr, TCSANOW, cc_t, ECHO, ICANON, VMIN, VTIME
-#include <unistd.h>  // for STDIN_FILENO, read
+#include <unistd.h>  // for STDIN_FILENO, read, write, pipe, close
 #endif
 
 // Quick exit is missing in standard CLang headers
@@ -67,29 +89,361 @@ void RequestAnimationFrame() {
 }
 }  // namespace animation
 
+namespace {
+// Return the number of milliseconds from |now| to |deadline|, rounded up.
+int MillisecondsUntil(animation::TimePoint deadline, animation::TimePoint now) {
+  if (deadline <= now) {
+    return 0;
+  }
+  const auto delay =
+      std::chrono::ceil<std::chrono::milliseconds>(deadline - now);
+  return int(std::min<std::chrono::milliseconds::rep>(
+      delay.count(), std::numeric_limits<int>::max()));
+}
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+// Open a non blocking pipe, closed on exec. Return false on failure.
+bool OpenPipe(std::array<int, 2>* pipe_fds) {
+  std::array<int, 2> fds = {-1, -1};
+  if (pipe(fds.data()) != 0) {
+    return false;
+  }
+  for (const int fd : fds) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);  // NOLINT
+    fcntl(fd, F_SETFD, FD_CLOEXEC);                       // NOLINT
+  }
+  *pipe_fds = fds;
+  return true;
+}
+
+// Async signal safe function
+void WritePipe(int fd) {
+  if (fd != -1) {
+    const char c = 0;
+    std::ignore = write(fd, &c, 1);
+  }
+}
+
+void DrainPipe(int fd) {
+  std::array<char, 64> buffer;  // NOLINT
+  while (read(fd, buffer.data(), buffer.size()) > 0) {
+  }
+}
+#endif
+}  // namespace
+
+// The file descriptors and timers registered by the application. They are
+// waited for by the event listener thread, while their callbacks run on the
+// main loop.
+class IOWatcher {
+ public:
+  IOWatcher() = default;
+  IOWatcher(const IOWatcher&) = delete;
+  IOWatcher& operator=(const IOWatcher&) = delete;
+  ~IOWatcher() { CloseWakeUpPipe(); }
+
+  // The self-pipe waking the event listener up from poll(). The screens
+  // reading stdin use |shared|, also written to by the signal handlers. The
+  // others, given null, open their own: they are woken up by their screen only.
+  void UseWakeUpPipe(const std::array<int, 2>* shared) {
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+    if (shared) {
+      CloseWakeUpPipe();
+      wakeup_pipe_ = *shared;
+    } else if (!owns_wakeup_pipe_) {
+      owns_wakeup_pipe_ = OpenPipe(&wakeup_pipe_);
+    }
+#else
+    std::ignore = shared;
+#endif
+  }
+
+  void WakeUp() const {
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+    WritePipe(wakeup_pipe_[1]);
+#endif
+  }
+
+  void DrainWakeUp() const {
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+    DrainPipe(wakeup_pipe_[0]);
+#endif
+  }
+
+  int WakeUpFd() const { return wakeup_pipe_[0]; }
+
+  void Watch(int fd, Closure callback) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    fds_[fd] = {std::move(callback), /*armed=*/true};
+  }
+
+  void Unwatch(int fd) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    fds_.erase(fd);
+  }
+
+  size_t AddTimer(animation::TimePoint deadline,
+                  Task task,
+                  animation::Duration period) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    // Catch the wheel up first, so that the timer is placed relative to now.
+    timers_.Advance(animation::Clock::now(), &expired_);
+    return timers_.Add(deadline, std::move(task), period);
+  }
+
+  void CancelTimer(size_t id) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    timers_.Cancel(id);
+  }
+
+  // Called from the event listener. Return the file descriptors to wait for.
+  // A file descriptor is readable until its callback reads it. So after being
+  // reported, it is disarmed until the callback has run.
+  std::vector<int> ArmedFds() const {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<int> fds;
+    for (const auto& it : fds_) {
+      if (it.second.armed) {
+        fds.push_back(it.first);
+      }
+    }
+    return fds;
+  }
+
+  void Disarm(int fd) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    auto it = fds_.find(fd);
+    if (it != fds_.end()) {
+      it->second.armed = false;
+    }
+  }
+
+  // Called from the main loop. Run the callback of |fd|, and arm it again.
+  void Run(int fd) {
+    Closure callback;
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      auto it = fds_.find(fd);
+      if (it == fds_.end()) {
+        return;
+      }
+      callback = it->second.callback;
+    }
+    callback();
+    const std::lock_guard<std::mutex> lock(mutex_);
+    auto it = fds_.find(fd);
+    if (it != fds_.end()) {
+      it->second.armed = true;
+    }
+  }
+
+  // Called from the event listener. Wake the main loop up once timers expired,
+  // for it to take their tasks. Return the number of milliseconds until the
+  // next one, or -1 if none.
+  int NotifyExpiredTimers(const Sender<Task>& out) {
+    bool notify = false;
+    int timeout = -1;
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      const auto now = animation::Clock::now();
+      timers_.Advance(now, &expired_);
+      notify = !expired_.empty() && !notified_;
+      notified_ = notified_ || notify;
+      timeout = timers_.TimeUntilNext(now);
+    }
+    if (notify) {
+      out->Send(TaskClosure([] {}));
+    }
+    return timeout;
+  }
+
+  // Called from the main loop. Append the tasks of the timers expired to |out|.
+  void TakeExpiredTimers(std::vector<Task>* out) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    timers_.Advance(animation::Clock::now(), &expired_);
+    for (auto& task : expired_) {
+      out->push_back(std::move(task));
+    }
+    expired_.clear();
+    notified_ = false;
+  }
+
+  int TimeUntilNextTimer() const {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    if (!expired_.empty()) {
+      return 0;
+    }
+    return timers_.TimeUntilNext(animation::Clock::now());
+  }
+
+ private:
+
+  struct Fd {
+    Closure callback;
+    bool armed = true;
+  };
+
+  void CloseWakeUpPipe() {
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+    if (owns_wakeup_pipe_) {
+      close(wakeup_pipe_[0]);
+      close(wakeup_pipe_[1]);
+    }
+#endif
+    owns_wakeup_pipe_ = false;
+    wakeup_pipe_ = {-1, -1};
+  }
+
+  std::array<int, 2> wakeup_pipe_ = {-1, -1};
+  bool owns_wakeup_pipe_ = false;
+
+  mutable std::mutex mutex_;
+  std::map<int, Fd> fds_;
+  TimerWheel timers_{animation::Clock::now()};
+  // The tasks of the timers expired, until the main loop takes them.
+  std::vector<Task> expired_;
+  bool notified_ = false;
+};
+
 namespace {
 
 ScreenInteractive* g_active_screen = nullptr;  // NOLINT
+// The active screen reading its own input, see ScreenInteractive::InputFd().
+// Each of them runs its loop on its own thread.
+thread_local ScreenInteractive* g_active_session = nullptr;  // NOLINT
+// The screen whose terminal configuration is restored by OnExit(), if any.
+thread_local ScreenInteractive* g_terminal_owner = nullptr;  // NOLINT
+
+// Where the active screen is recorded: per process for the screens reading
+// stdin, per thread for the others.
+ScreenInteractive*& ActiveScreen(bool session) {
+  return session ? g_active_session : g_active_screen;
+}
+
+// Write |data| to |fd|, or to std::cout when |fd| is negative. The data is
+// handed to the kernel at once, looping only over partial writes.
+void Write(int fd, std::string_view data) {
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+  if (fd >= 0) {
+    while (!data.empty()) {
+      const ssize_t written = write(fd, data.data(), data.size());
+      if (written >= 0) {
+        data.remove_prefix(size_t(written));
+        continue;
+      }
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        return;
+      }
+      // Non blocking file descriptor, like a socket. Wait for it.
+      pollfd output{fd, POLLOUT, 0};
+      std::ignore = poll(&output, 1, -1);
+    }
+    return;
+  }
+#endif
+  std::cout << data;
+}
 
-void Flush() {
+void Flush(int fd) {
+  // Writes to a file descriptor aren't buffered.
+  if (fd >= 0) {
+    return;
+  }
   // Emscripten doesn't implement flush. We interpret zero as flush.
   std::cout << '\0' << std::flush;
 }
 
+std::atomic<int> g_signal_exit_count = 0;  // NOLINT
+#if !defined(_WIN32)
+std::atomic<int> g_signal_stop_count = 0;    // NOLINT
+std::atomic<int> g_signal_resize_count = 0;  // NOLINT
+#endif
+
+// Incremented whenever the terminal is resized.
+std::atomic<int> g_terminal_size_generation = 0;  // NOLINT
+
+// Whether a signal was recorded, and not yet handled by the main loop.
+bool HasPendingSignal() {
+#if defined(_WIN32)
+  return g_signal_exit_count != 0;
+#else
+  return g_signal_exit_count != 0 || g_signal_stop_count != 0 ||
+         g_signal_resize_count != 0;
+#endif
+}
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+// A self-pipe waking the event listener up from poll(). It is written to by
+// the signal handlers, and when the loop exits.
+std::array<int, 2> g_wakeup_pipe = {-1, -1};  // NOLINT
+
+void CreateWakeUpPipe() {
+  if (g_wakeup_pipe[0] == -1) {
+    OpenPipe(&g_wakeup_pipe);
+  }
+}
+
+// Async signal safe function
+void WakeUpEventListener() {
+  WritePipe(g_wakeup_pipe[1]);
+}
+#else
+void WakeUpEventListener() {}
+#endif
+
+// Combine two timeouts, where -1 means waiting forever.
+int MinTimeout(int a, int b) {
+  if (a < 0) {
+    return b;
+  }
+  if (b < 0) {
+    return a;
+  }
+  return std::min(a, b);
+}
+
+// The main loop only wakes up when it receives a task. The signal handlers
+// can't post one, so the event listener does it on their behalf.
+void WakeUpOnPendingSignal(const Sender<Task>& out) {
+  if (HasPendingSignal()) {
+    out->Send(TaskClosure([] {}));
+  }
+}
+
 constexpr int timeout_milliseconds = 20;
-[[maybe_unused]] constexpr int timeout_microseconds =
-    timeout_milliseconds * 1000;
 #if defined(_WIN32)
 
-void EventListener(std::atomic<bool>* quit, Sender<Task> out) {
+void EventListener(std::atomic<bool>* quit,
+                   Sender<Task> out,
+                   std::shared_ptr<IOWatcher> watcher,
+                   int /*input_fd*/) {
   auto console = GetStdHandle(STD_INPUT_HANDLE);
   auto parser = TerminalInputParser(out->Clone());
+  WindowsMouseTranslator mouse_translator;
+
+  // Reused across reads. The characters typed are accumulated as UTF-16, and
+  // converted at once.
+  std::vector<INPUT_RECORD> records;
+  std::wstring characters;
+  const auto flush_characters = [&] {
+    if (!characters.empty()) {
+      parser.Add(to_string(characters));
+      characters.clear();
+    }
+  };
+
   while (!*quit) {
+    WakeUpOnPendingSignal(out);
+    const int timeout =
+        MinTimeout(timeout_milliseconds, watcher->NotifyExpiredTimers(out));
     // Throttle ReadConsoleInput by waiting 250ms, this wait function will
     // return if there is input in the console.
-    auto wait_result = WaitForSingleObject(console, timeout_milliseconds);
+    auto wait_result = WaitForSingleObject(console, timeout);
     if (wait_result == WAIT_TIMEOUT) {
-      parser.Timeout(timeout_milliseconds);
+      parser.Timeout(timeout);
       continue;
     }
 
@@ -99,35 +453,64 @@ void EventListener(std::atomic<bool>* quit, Sender<Task> out) {
     if (number_of_events <= 0)
       continue;
 
-    std::vector<INPUT_RECORD> records{number_of_events};
+    if (records.size() < number_of_events) {
+      records.resize(number_of_events);
+    }
     DWORD number_of_events_read = 0;
-    ReadConsoleInput(console, records.data(), (DWORD)records.size(),
+    ReadConsoleInput(console, records.data(), number_of_events,
                      &number_of_events_read);
-    records.resize(number_of_events_read);
 
-    for (const auto& r : records) {
+    // The mouse positions are relative to the console buffer. The window's
+    // origin is queried once per read, when needed.
+    bool has_window = false;
+    SMALL_RECT window = {};
+
+    for (DWORD i = 0; i < number_of_events_read; ++i) {
+      const INPUT_RECORD& r = records[i];
       switch (r.EventType) {
         case KEY_EVENT: {
-          auto key_event = r.Event.KeyEvent;
+          const auto& key_event = r.Event.KeyEvent;
           // ignore UP key events
-          if (key_event.bKeyDown == FALSE)
+          if (key_event.bKeyDown == FALSE ||
+              key_event.uChar.UnicodeChar == 0) {
             continue;
-          std::wstring wstring;
-          wstring += key_event.uChar.UnicodeChar;
-          for (auto it : to_string(wstring)) {
-            parser.Add(it);
+          }
+          characters.append(std::max<WORD>(1, key_event.wRepeatCount),
+                            key_event.uChar.UnicodeChar);
+        } break;
+        case MOUSE_EVENT: {
+          if (!has_window) {
+            CONSOLE_SCREEN_BUFFER_INFO info;
+            if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE),
+                                           &info)) {
+              window = info.srWindow;
+            }
+            has_window = true;
+          }
+          const auto& mouse_event = r.Event.MouseEvent;
+          WindowsMouseRecord record;
+          record.x = mouse_event.dwMousePosition.X - window.Left + 1;
+          record.y = mouse_event.dwMousePosition.Y - window.Top + 1;
+          record.button_state = mouse_event.dwButtonState;
+          record.control_key_state = mouse_event.dwControlKeyState;
+          record.event_flags = mouse_event.dwEventFlags;
+          Mouse mouse;
+          if (mouse_translator.Translate(record, &mouse)) {
+            flush_characters();
+            out->Send(Event::Mouse("", mouse));
           }
         } break;
         case WINDOW_BUFFER_SIZE_EVENT:
+          flush_characters();
+          g_terminal_size_generation++;
           out->Send(Event::Special({0}));
           break;
         case MENU_EVENT:
         case FOCUS_EVENT:
-        case MOUSE_EVENT:
-          // TODO(mauve): Implement later.
           break;
       }
     }
+    flush_characters();
   }
 }
 
@@ -135,8 +518,11 @@ void EventListener(std::atomic<bool>* quit, Sender<Task> out) {
 #include <emscripten.h>
 
 // Read char from the terminal.
-void EventListener(std::atomic<bool>* quit, Sender<Task> out) {
-  auto parser = TerminalInputParser(std::move(out));
+void EventListener(std::atomic<bool>* quit,
+                   Sender<Task> out,
+                   std::shared_ptr<IOWatcher> watcher,
+                   int /*input_fd*/) {
+  auto parser = TerminalInputParser(out->Clone());
 
   char c;
   while (!*quit) {
@@ -145,9 +531,25 @@ void EventListener(std::atomic<bool>* quit, Sender<Task> out) {
 
     emscripten_sleep(1);
     parser.Timeout(1);
+    WakeUpOnPendingSignal(out);
+    watcher->NotifyExpiredTimers(out);
   }
 }
 
+// The cells of the last frame published to JavaScript, see CellOutput().
+std::shared_ptr<const CellBuffer> g_cells;  // NOLINT
+
+void PublishCells(std::shared_ptr<const CellBuffer> cells) {
+  g_cells = std::move(cells);
+  // clang-format off
+  EM_ASM({
+    if (Module.ftxuiOnCells) {
+      Module.ftxuiOnCells();
+    }
+  });
+  // clang-format on
+}
+
 extern "C" {
 EMSCRIPTEN_KEEPALIVE
 void ftxui_on_resize(int columns, int rows) {
@@ -157,40 +559,121 @@ void ftxui_on_resize(int columns, int rows) {
   });
   std::raise(SIGWINCH);
 }
+
+EMSCRIPTEN_KEEPALIVE
+const uint32_t* ftxui_cells() {
+  return g_cells ? g_cells->cells().data() : nullptr;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int ftxui_cells_dimx() {
+  return g_cells ? g_cells->dimx() : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int ftxui_cells_dimy() {
+  return g_cells ? g_cells->dimy() : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+const uint32_t* ftxui_cell_updates() {
+  return g_cells ? g_cells->updates().data() : nullptr;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int ftxui_cell_updates_size() {
+  return g_cells ? int(g_cells->updates().size()) : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+const char* ftxui_cell_glyph(uint32_t index) {
+  return g_cells ? g_cells->Glyph(index).c_str() : "";
+}
+
+EMSCRIPTEN_KEEPALIVE
+const char* ftxui_cell_hyperlink(uint32_t id) {
+  return g_cells ? g_cells->Hyperlink(id).c_str() : "";
+}
 }
 
 #else  // POSIX (Linux & Mac)
 
-int CheckStdinReady(int usec_timeout) {
-  timeval tv = {0, usec_timeout};  // NOLINT
-  fd_set fds;
-  FD_ZERO(&fds);                                          // NOLINT
-  FD_SET(STDIN_FILENO, &fds);                             // NOLINT
-  select(STDIN_FILENO + 1, &fds, nullptr, nullptr, &tv);  // NOLINT
-  return FD_ISSET(STDIN_FILENO, &fds);                    // NOLINT
+// Ask the main loop to run the callback of |fd|.
+void SendReadable(const std::shared_ptr<IOWatcher>& watcher,
+                  int fd,
+                  const Sender<Task>& out) {
+  watcher->Disarm(fd);
+  out->Send(TaskClosure([watcher, fd] {
+    watcher->Run(fd);
+    watcher->WakeUp();
+  }));
 }
 
-// Read char from the terminal.
-void EventListener(std::atomic<bool>* quit, Sender<Task> out) {
-  auto parser = TerminalInputParser(std::move(out));
+// Read char from the terminal. The thread sleeps in poll() until |input_fd|, or
+// a file descriptor watched by the application is readable, or the wakeup pipe
+// is written to. A timeout is only used to flush incomplete sequences, like a
+// lone escape character, and to fire the timers. A negative |input_fd| means
+// stdin.
+void EventListener(std::atomic<bool>* quit,
+                   Sender<Task> out,
+                   std::shared_ptr<IOWatcher> watcher,
+                   int input_fd) {
+  auto parser = TerminalInputParser(out->Clone());
 
+  if (input_fd < 0) {
+    input_fd = STDIN_FILENO;
+  }
+  std::vector<pollfd> fds;
   while (!*quit) {
-    if (!CheckStdinReady(timeout_microseconds)) {
-      parser.Timeout(timeout_milliseconds);
+    WakeUpOnPendingSignal(out);
+    const int timeout =
+        MinTimeout(parser.HasPending() ? timeout_milliseconds : -1,
+                   watcher->NotifyExpiredTimers(out));
+
+    fds.clear();
+    fds.push_back({input_fd, POLLIN, 0});
+    fds.push_back({watcher->WakeUpFd(), POLLIN, 0});
+    for (const int fd : watcher->ArmedFds()) {
+      fds.push_back({fd, POLLIN, 0});
+    }
+
+    const int ready = poll(fds.data(), fds.size(), timeout);
+    if (ready == 0) {
+      parser.Timeout(timeout);
       continue;
     }
+    if (ready < 0) {
+      continue;  // Interrupted by a signal.
+    }
+
+    if (fds[1].revents != 0) {
+      watcher->DrainWakeUp();
+    }
+
+    for (size_t i = 2; i < fds.size(); ++i) {
+      if (fds[i].revents != 0) {
+        SendReadable(watcher, fds[i].fd, out);
+      }
+    }
 
-    const size_t buffer_size = 100;
-    std::array<char, buffer_size> buffer;                        // NOLINT;
-    size_t l = read(fileno(stdin), buffer.data(), buffer_size);  // NOLINT
-    for (size_t i = 0; i < l; ++i) {
-      parser.Add(buffer[i]);  // NOLINT
+    if (fds[0].revents == 0) {
+      continue;
+    }
+    const size_t buffer_size = 1024;
+    std::array<char, buffer_size> buffer;  // NOLINT;
+    const ssize_t l = read(input_fd, buffer.data(), buffer_size);
+    if (l == 0 || (l < 0 && errno != EINTR && errno != EAGAIN)) {
+      // The input was closed. Stop waiting for it.
+      input_fd = -1;
+    }
+    if (l > 0) {
+      parser.Add(std::string_view(buffer.data(), size_t(l)));
     }
   }
 }
 #endif
 
-std::stack<Closure> on_exit_functions;  // NOLINT
+thread_local std::stack<Closure> on_exit_functions;  // NOLINT
 void OnExit() {
   while (!on_exit_functions.empty()) {
     on_exit_functions.top()();
@@ -198,12 +681,6 @@ void OnExit() {
   }
 }
 
-std::atomic<int> g_signal_exit_count = 0;  // NOLINT
-#if !defined(_WIN32)
-std::atomic<int> g_signal_stop_count = 0;    // NOLINT
-std::atomic<int> g_signal_resize_count = 0;  // NOLINT
-#endif
-
 // Async signal safe function
 void RecordSignal(int signal) {
   switch (signal) {
@@ -223,15 +700,23 @@ void RecordSignal(int signal) {
 
     case SIGWINCH:  // NOLINT
       g_signal_resize_count++;
+      g_terminal_size_generation++;
       break;
 #endif
 
     default:
       break;
   }
+  WakeUpEventListener();
 }
 
 void ExecuteSignalHandlers() {
+  // The signals are for the screen reading stdin, not for the sessions reading
+  // their own input.
+  if (g_active_session || !g_active_screen) {
+    return;
+  }
+
   int signal_exit_count = g_signal_exit_count.exchange(0);
   while (signal_exit_count--) {
     ScreenInteractive::Private::Signal(*g_active_screen, SIGABRT);
@@ -285,6 +770,8 @@ enum class DECMode : std::uint16_t {
   kMouseUrxvtMode = 1015,
   kMouseSgrPixelsMode = 1016,
   kAlternateScreen = 1049,
+  kBracketedPaste = 2004,
+  kSynchronizedOutput = 2026,
 };
 
 // Device Status Report (DSR) {
@@ -320,6 +807,11 @@ std::string DeviceStatusReport(DSRMode ps) {
   return CSI + std::to_string(int(ps)) + "n";
 }
 
+// DEC Private Mode Request (DECRQM). Answered by a DECRPM report.
+std::string RequestMode(DECMode ps) {
+  return CSI + "?" + std::to_string(int(ps)) + "$p";
+}
+
 class CapturedMouseImpl : public CapturedMouseInterface {
  public:
   explicit CapturedMouseImpl(std::function<void(void)> callback)
@@ -334,15 +826,62 @@ class CapturedMouseImpl : public CapturedMouseInterface {
   std::function<void(void)> callback_;
 };
 
-void AnimationListener(std::atomic<bool>* quit, Sender<Task> out) {
-  // Animation at around 60fps.
-  const auto time_delta = std::chrono::milliseconds(15);
-  while (!*quit) {
-    out->Send(AnimationTask());
-    std::this_thread::sleep_for(time_delta);
+// Return whether |task| can be dropped, because |next| makes it obsolete. This
+// is the case for consecutive mouse moves, and for consecutive resizes.
+bool IsSuperseded(Task& task, Task& next) {
+  auto* event = std::get_if<Event>(&task);
+  auto* next_event = std::get_if<Event>(&next);
+  if (!event || !next_event) {
+    return false;
   }
+
+  if (*event == Event::Special({0})) {
+    return *next_event == Event::Special({0});
+  }
+
+  if (!event->is_mouse() || !next_event->is_mouse()) {
+    return false;
+  }
+  const Mouse& mouse = event->mouse();
+  const Mouse& next_mouse = next_event->mouse();
+  return mouse.motion == Mouse::Moved &&       //
+         next_mouse.motion == Mouse::Moved &&  //
+         mouse.button == next_mouse.button &&  //
+         mouse.shift == next_mouse.shift &&    //
+         mouse.meta == next_mouse.meta &&      //
+         mouse.control == next_mouse.control;
 }
 
+// The sink of CellOutput(): the frames are copied into a CellBuffer.
+class CellSink : public RenderSink {
+ public:
+  explicit CellSink(std::function<void(const CellBuffer&)> on_frame)
+      : on_frame_(std::move(on_frame)) {
+#if defined(__EMSCRIPTEN__)
+    if (!on_frame_) {
+      on_frame_ = [cells = std::weak_ptr<CellBuffer>(cells_)](
+                      const CellBuffer& /*unused*/) {
+        PublishCells(cells.lock());
+      };
+    }
+#endif
+  }
+
+  // The CellBuffer compares the cells itself.
+  bool WantsRuns() const override { return false; }
+
+  void Frame(const RenderFrame& frame) override {
+    cells_->Update(*frame.screen);
+    if (on_frame_) {
+      on_frame_(*cells_);
+    }
+  }
+
+ private:
+  std::shared_ptr<CellBuffer> cells_ = std::make_shared<CellBuffer>();
+  std::function<void(const CellBuffer&)> on_frame_;
+};
+
 }  // namespace
 
 ScreenInteractive::ScreenInteractive(int dimx,
@@ -353,6 +892,8 @@ ScreenInteractive::ScreenInteractive(int dimx,
       dimension_(dimension),
       use_alternative_screen_(use_alternative_screen) {
   task_receiver_ = MakeReceiver<Task>();
+  io_watcher_ = std::make_shared<IOWatcher>();
+  frame_recorder_ = std::make_shared<FrameRecorder>();
 }
 
 // static
@@ -441,58 +982,786 @@ void ScreenInteractive::TrackMouse(bool enable) {
   track_mouse_ = enable;
 }
 
-/// @brief Add a task to the main loop.
-/// It will be executed later, after every other scheduled tasks.
 /// @ingroup component
-void ScreenInteractive::Post(Task task) {
-  // Task/Events sent toward inactive screen or screen waiting to become
-  // inactive are dropped.
-  if (!task_sender_) {
-    return;
-  }
-
-  task_sender_->Send(std::move(task));
+/// @brief Set whether the text pasted into the terminal is received as a
+/// single Event::Paste, instead of one event per character.
+/// @param enable Whether to enable the bracketed paste mode.
+/// @note This must be called before Loop().
+/// @note The bracketed paste mode is enabled by default. Terminals not
+/// supporting it keep sending the characters one by one.
+void ScreenInteractive::BracketedPaste(bool enable) {
+  bracketed_paste_ = enable;
 }
 
-/// @brief Add an event to the main loop.
-/// It will be executed later, after every other scheduled events.
 /// @ingroup component
-void ScreenInteractive::PostEvent(Event event) {
-  Post(event);
+/// @brief Set whether only the cells modified since the previous frame are
+/// written to the terminal.
+/// @param enable Whether to enable the differential output.
+/// @note This must be called outside of the main loop. E.g. before calling
+/// `ScreenInteractive::Loop`.
+/// @note The differential output is disabled by default. Every frame is then
+/// fully repainted.
+///
+/// This reduces a lot the amount of bytes sent to the terminal when only a
+/// small part of the screen changes in between two frames. This is useful for
+/// remote sessions.
+///
+/// ### Example
+///
+/// ```cpp
+/// auto screen = ScreenInteractive::Fullscreen();
+/// screen.DifferentialOutput();
+/// screen.Loop(component);
+/// ```
+void ScreenInteractive::DifferentialOutput(bool enable) {
+  differential_output_ = enable;
 }
 
-/// @brief Add a task to draw the screen one more time, until all the animations
-/// are done.
-void ScreenInteractive::RequestAnimationFrame() {
-  if (animation_requested_) {
-    return;
-  }
-  animation_requested_ = true;
-  auto now = animation::Clock::now();
-  const auto time_histeresis = std::chrono::milliseconds(33);
-  if (now - previous_animation_time_ >= time_histeresis) {
-    previous_animation_time_ = now;
-  }
+/// @ingroup component
+/// @brief Set whether consecutive mouse moves and terminal resizes are merged.
+/// @param enable Whether to enable the coalescing of events.
+/// @note This must be called outside of the main loop. E.g. before calling
+/// `ScreenInteractive::Loop`.
+/// @note The coalescing is disabled by default. Every event is then delivered
+/// to the component.
+///
+/// Every pending task is drained at once. Among a series of consecutive mouse
+/// moves, only the last one is delivered to the component. The same applies to
+/// terminal resizes. The frame is then drawn once. This avoids building a
+/// backlog when the terminal emits events faster than they can be handled.
+///
+/// ### Example
+///
+/// ```cpp
+/// auto screen = ScreenInteractive::Fullscreen();
+/// screen.CoalesceEvents();
+/// screen.Loop(component);
+/// ```
+void ScreenInteractive::CoalesceEvents(bool enable) {
+  coalesce_events_ = enable;
 }
 
-/// @brief Try to get the unique lock about behing able to capture the mouse.
-/// @return A unique lock if the mouse is not already captured, otherwise a
-/// null.
 /// @ingroup component
-CapturedMouse ScreenInteractive::CaptureMouse() {
-  if (mouse_captured) {
-    return nullptr;
-  }
-  mouse_captured = true;
-  return std::make_unique<CapturedMouseImpl>(
-      [this] { mouse_captured = false; });
+/// @brief Set whether a frame is abandoned when input arrives while drawing it.
+/// @param enable Whether to abandon the stale frames.
+/// @note This must be called outside of the main loop. E.g. before calling
+/// `ScreenInteractive::Loop`.
+/// @note This is disabled by default. Every frame started is then written.
+///
+/// The input received is checked after the components are rendered, and again
+/// before the frame is serialized. If there is some, the frame is already
+/// stale: it is dropped, the input is handled, and the frame is rendered again
+/// from the freshest state. With expensive frames, a key held down moves the
+/// focus at the speed of the keyboard, instead of lagging behind.
+///
+/// A frame is only abandoned a few times in a row, so that a continuous stream
+/// of input doesn't prevent drawing. See FrameStats::frames_abandoned.
+///
+/// ### Example
+///
+/// ```cpp
+/// auto screen = ScreenInteractive::Fullscreen();
+/// screen.AbandonStaleFrames();
+/// screen.Loop(component);
+/// ```
+void ScreenInteractive::AbandonStaleFrames(bool enable) {
+  abandon_stale_frames_ = enable;
 }
 
-/// @brief Execute the main loop.
-/// @param component The component to draw.
 /// @ingroup component
-void ScreenInteractive::Loop(Component component) {  // NOLINT
-  class Loop loop(this, std::move(component));
+/// @brief Set whether the events not changing anything are drawn.
+/// @param enable Whether to draw only the events changing the state.
+/// @note This must be called outside of the main loop. E.g. before calling
+/// `ScreenInteractive::Loop`.
+/// @note This is disabled by default. Every event is then followed by a frame.
+///
+/// An event is followed by a frame only when the component handled it, when
+/// it is Event::Custom or a resize, or when RequestRedraw() is called while
+/// handling it. The mouse moving over inert areas, or the keys not bound, are
+/// then not rendered at all.
+///
+/// The components changing how they are drawn without handling the event,
+/// like a hover effect, call ComponentBase::RequestRedraw(). The built-in ones
+/// do, and so does moving the focus.
+///
+/// ### Example
+///
+/// ```cpp
+/// auto screen = ScreenInteractive::Fullscreen();
+/// screen.LazyRedraw();
+/// screen.Loop(component);
+/// ```
+void ScreenInteractive::LazyRedraw(bool enable) {
+  lazy_redraw_ = enable;
+}
+
+/// @ingroup component
+/// @brief Route the mouse events to the components under the mouse, instead of
+/// offering them to every component.
+/// @param enable Whether the mouse events are routed. Defaults to false.
+///
+/// `Container::Vertical` and `Container::Horizontal` remember where each of
+/// their children was drawn, and only forward a mouse event to the child under
+/// the mouse, and to the one which received the previous mouse event, so it
+/// can notice the mouse leaving. While a component captures the mouse, the
+/// events keep being forwarded to it. The keyboard events already follow the
+/// focused path.
+///
+/// The handling cost of a mouse event then grows with the depth of the tree
+/// instead of its size. This requires the containers to be drawn by their own
+/// Render(). Until they are, they forward the events to every child.
+///
+/// ### Example
+///
+/// ```cpp
+/// auto screen = ScreenInteractive::Fullscreen();
+/// screen.RoutedEvents();
+/// screen.Loop(component);
+/// ```
+void ScreenInteractive::RoutedEvents(bool enable) {
+  routed_events_ = enable;
+}
+
+/// @ingroup component
+/// @brief Set the frame rate at which the animations are run.
+/// @param fps The number of animation frames per second. Defaults to 60.
+///
+/// When drawing a frame takes longer than the budget, some animation frames
+/// are skipped. No frame is scheduled when no animation is running.
+void ScreenInteractive::TargetFrameRate(int fps) {
+  target_frame_rate_ = std::max(1, fps);
+}
+
+/// @ingroup component
+/// @brief Set the number of threads used to render a frame.
+/// @param threads The number of threads, including the UI one. One, the
+/// default, renders on the UI thread only. Zero uses one per core.
+///
+/// Once the layout is done, the elements doing work independent from the
+/// screen, like `canvas` and `graph`, do it concurrently. Their functions must
+/// be safe to call from any thread. The frames drawn entirely are encoded by
+/// blocks of rows concurrently as well, on large screens. The threads are the
+/// ones of the worker pool, see RunInBackground(), kept across frames.
+///
+/// ### Example
+///
+/// ```cpp
+/// auto screen = ScreenInteractive::Fullscreen();
+/// screen.RenderThreads(4);
+/// screen.Loop(component);
+/// ```
+void ScreenInteractive::RenderThreads(int threads) {
+  render_threads_ = std::max(0, threads);
+}
+
+/// @ingroup component
+/// @brief Wrap every frame into the synchronized output sequences (DEC mode
+/// 2026), on terminals supporting it.
+///
+/// The terminal displays the frame once it is fully received, instead of
+/// drawing the partial updates. This avoids tearing on large frames, and
+/// saves work on the terminal side. The support is queried when the screen is
+/// installed. The frames are left unwrapped until the terminal confirms it.
+/// This must be called before Loop().
+/// @param enable Whether the frames are synchronized.
+void ScreenInteractive::SynchronizedOutput(bool enable) {
+  synchronized_output_ = enable;
+}
+
+/// @ingroup component
+/// @brief Ask the terminal what it supports when the screen is installed, and
+/// enable the output paths it does: REP, true colors, the graphics protocols
+/// and the synchronized output.
+/// @param cache_file A file remembering the answers of every terminal, for the
+/// next sessions. None when empty.
+///
+/// The terminal is queried with DA1, DA2, XTVERSION and DECRQM. Nothing waits
+/// for the answers: they are read by the loop like the other input, and
+/// applied once received. Meanwhile, the capabilities already known for this
+/// terminal, from this process or from |cache_file|, are used. The terminal is
+/// identified by its environment: TERM, TERM_PROGRAM and TERM_PROGRAM_VERSION.
+///
+/// The capabilities are the ones of the Terminal, for the whole process. The
+/// screens reading their own input, see InputFd(), aren't probed.
+///
+/// @note This must be called outside of the main loop. The capabilities
+/// applied are kept after it exits.
+///
+/// ### Example
+///
+/// ```cpp
+/// auto screen = ScreenInteractive::Fullscreen();
+/// screen.SynchronizedOutput();
+/// screen.ProbeTerminal("/tmp/my_app_terminals");
+/// screen.Loop(component);
+/// ```
+void ScreenInteractive::ProbeTerminal(std::string cache_file) {
+  probe_terminal_ = true;
+  probe_cache_file_ = std::move(cache_file);
+}
+
+/// @ingroup component
+/// @brief Drop the intermediate frames when the terminal can't keep up, like
+/// over a slow remote connection.
+/// @param bytes_per_second The bandwidth of the output. Zero, the default,
+/// means it is only measured.
+///
+/// The bandwidth is measured from the time the frames take to be written,
+/// once the terminal output buffer is full. The lowest of the two is used.
+/// After a frame is written, the next one is postponed until the terminal is
+/// estimated to have drained it. The events are still handled meanwhile, only
+/// the latest state is drawn, instead of queuing stale frames.
+///
+/// ### Example
+///
+/// ```cpp
+/// auto screen = ScreenInteractive::Fullscreen();
+/// screen.OutputBandwidth(64 * 1024);
+/// screen.Loop(component);
+/// ```
+void ScreenInteractive::OutputBandwidth(int bytes_per_second) {
+  throttle_output_ = true;
+  output_bandwidth_ = std::max(0, bytes_per_second);
+}
+
+/// @ingroup component
+/// @brief Record a trace of the loop: the phases of the frames and the tasks
+/// handled, with the spans added by TraceSpan.
+/// @param capacity The number of spans kept. The oldest ones are dropped.
+///
+/// The trace is written by WriteTrace(), in the Chrome trace event format,
+/// read by chrome://tracing and https://ui.perfetto.dev. Unless this is called,
+/// the loop and TraceSpan only check a null pointer.
+///
+/// ### Example
+///
+/// ```cpp
+/// auto screen = ScreenInteractive::Fullscreen();
+/// screen.RecordTrace();
+/// screen.Loop(component);
+/// std::ofstream file("trace.json");
+/// screen.WriteTrace(file);
+/// ```
+void ScreenInteractive::RecordTrace(size_t capacity) {
+  tracer_ = std::make_shared<Tracer>(capacity);
+}
+
+/// @ingroup component
+/// @brief Record the session into |out|: the events handled, the tasks and the
+/// animations run, and the frames drawn, with their size and timestamps.
+/// @param out Where to write the session, in a compact binary format. It must
+/// outlive the loop. Null to stop recording.
+///
+/// The session is replayed without a terminal by SessionReplay, to reproduce
+/// the frames drawn, and measure them. The stream is flushed after every frame.
+///
+/// ### Example
+///
+/// ```cpp
+/// std::ofstream file("session.ftxs", std::ios::binary);
+/// auto screen = ScreenInteractive::Fullscreen();
+/// screen.RecordSession(&file);
+/// screen.Loop(component);
+/// ```
+void ScreenInteractive::RecordSession(std::ostream* out) {
+  session_recorder_ = out ? std::make_shared<SessionRecorder>(out) : nullptr;
+}
+
+/// @ingroup component
+/// @brief Hand the frames to |sink|, instead of writing them as escape
+/// sequences. A native application, like a GPU text renderer, draws the cells
+/// changed directly, without encoding and parsing escape sequences.
+/// @param sink Called after every frame, with the runs of cells changed since
+/// the previous one, and the ids of their styles. Null to write escape
+/// sequences again.
+///
+/// The terminal is still configured through the output, for the input: the
+/// mouse tracking, the bracketed paste, etc. This must be called before Loop().
+void ScreenInteractive::OutputSink(std::shared_ptr<RenderSink> sink) {
+  sink_ = std::move(sink);
+  render_frame_builder_ =
+      sink_ ? std::make_shared<RenderFrameBuilder>() : nullptr;
+  render_frame_ = sink_ ? std::make_shared<RenderFrame>() : nullptr;
+}
+
+/// @ingroup component
+/// @brief Publish the frames as a CellBuffer, instead of writing them as escape
+/// sequences. The renderer reading the cells, like a canvas or xterm.js in a
+/// browser, draws them itself, without parsing the output back.
+/// @param on_frame Called after every frame, with the cells. The cells changed
+/// since the previous frame are listed by CellBuffer::updates().
+///
+/// This sets the OutputSink(). It must be called before Loop().
+///
+/// On WebAssembly, without |on_frame|, the cells are published to JavaScript.
+/// `Module.ftxuiOnCells()` is called after every frame. The cells are read in
+/// place from the memory of the module, through the exported functions
+/// `ftxui_cells()`, `ftxui_cells_dimx()`, `ftxui_cells_dimy()`,
+/// `ftxui_cell_updates()`, `ftxui_cell_updates_size()`, `ftxui_cell_glyph(i)`
+/// and `ftxui_cell_hyperlink(id)`. The size is set by `ftxui_on_resize()`.
+///
+/// ### Example
+///
+/// ```js
+/// Module.ftxuiOnCells = () => {
+///   const dimx = Module._ftxui_cells_dimx();
+///   const cells = new Uint32Array(Module.HEAPU32.buffer,
+///                                 Module._ftxui_cells(),
+///                                 dimx * Module._ftxui_cells_dimy() * 4);
+///   const updates = new Uint32Array(Module.HEAPU32.buffer,
+///                                   Module._ftxui_cell_updates(),
+///                                   Module._ftxui_cell_updates_size());
+///   for (const i of updates) {
+///     drawCell(i % dimx, Math.floor(i / dimx), cells.subarray(4 * i));
+///   }
+/// };
+/// ```
+void ScreenInteractive::CellOutput(
+    std::function<void(const CellBuffer&)> on_frame) {
+  OutputSink(std::make_shared<CellSink>(std::move(on_frame)));
+}
+
+/// @ingroup component
+/// @brief Write the output to |fd|, instead of std::cout.
+///
+/// The frames are written directly with write(), usually in a single system
+/// call, without going through the iostream buffers. This also allows
+/// drawing to a pseudo terminal or a socket. Non blocking file descriptors are
+/// waited for. This must be called before Loop().
+/// @param fd The file descriptor. It is not owned. A negative value restores
+/// std::cout.
+/// @note This is only supported on POSIX systems.
+///
+/// ### Example
+///
+/// ```cpp
+/// auto screen = ScreenInteractive::Fullscreen();
+/// screen.OutputFd(STDOUT_FILENO);
+/// screen.Loop(component);
+/// ```
+void ScreenInteractive::OutputFd(int fd) {
+  output_fd_ = fd;
+}
+
+/// @ingroup component
+/// @brief Read the input from |fd|, instead of stdin. This makes the screen a
+/// session, independent of the process' terminal, for instance to serve a
+/// pseudo terminal or a socket per client.
+///
+/// A session has its own input parser, size, and wakeup pipe. It doesn't handle
+/// the signals, and it configures |fd| only when it is a terminal. Its size is
+/// the one of its file descriptors, unless set by SetTerminalSize(). Several
+/// sessions can run at once, each on its own thread. Active() returns the
+/// session running on the calling thread.
+/// This must be called before Loop().
+/// @param fd The file descriptor. It is not owned. A negative value restores
+/// stdin.
+/// @note This is only supported on POSIX systems.
+///
+/// ### Example
+///
+/// ```cpp
+/// std::thread([client] {
+///   auto screen = ScreenInteractive::Fullscreen();
+///   screen.InputFd(client);
+///   screen.OutputFd(client);
+///   screen.SingleThreaded();
+///   screen.Loop(MakeConsole());
+/// }).detach();
+/// ```
+void ScreenInteractive::InputFd(int fd) {
+  input_fd_ = fd;
+}
+
+/// @ingroup component
+/// @brief Limit the rate at which frames are drawn in response to events.
+/// @param fps The maximum number of frames per second. Zero, the default,
+/// means unlimited.
+///
+/// The events are still handled as soon as they are received. When the
+/// previous frame was drawn too recently, drawing the next one is postponed.
+///
+/// ### Example
+///
+/// ```cpp
+/// auto screen = ScreenInteractive::Fullscreen();
+/// screen.MaxFrameRate(30);
+/// screen.Loop(component);
+/// ```
+void ScreenInteractive::MaxFrameRate(int fps) {
+  max_frame_rate_ = std::max(0, fps);
+}
+
+/// @ingroup component
+/// @brief Bound the memory kept by the screen's buffers while idle.
+/// @param bytes The budget, see MemoryUsage(). Zero, the default, disables it.
+/// @param idle How long without drawing a frame before the loop is idle.
+///
+/// The buffers grow to the largest frame, output and burst of tasks seen, and
+/// keep their storage to avoid allocating again. Once the loop is idle, if they
+/// hold more than |bytes|, TrimMemory() releases what the last frame doesn't
+/// need. This keeps the memory of long running sessions close to their working
+/// set, after a large resize for instance.
+///
+/// ### Example
+///
+/// ```cpp
+/// auto screen = ScreenInteractive::Fullscreen();
+/// screen.MemoryBudget(1 << 20);
+/// screen.Loop(component);
+/// ```
+void ScreenInteractive::MemoryBudget(size_t bytes, animation::Duration idle) {
+  memory_budget_ = bytes;
+  trim_delay_ = idle;
+}
+
+/// @ingroup component
+/// @brief Bound the number of tasks waiting to be handled.
+/// @param capacity The maximum number of pending tasks. Zero, the default,
+/// means unbounded.
+/// @param overflow What to do when a task is posted while the queue is full.
+///
+/// This prevents a producer posting faster than the UI thread handles from
+/// growing the memory without limit. The terminal events share the same
+/// queue, and can be dropped too. ReceiverOverflow::Block must not be used if
+/// the components post tasks themselves. This must be called before the loop
+/// starts.
+///
+/// ### Example
+///
+/// ```cpp
+/// auto screen = ScreenInteractive::Fullscreen();
+/// screen.TaskQueueCapacity(1000, ReceiverOverflow::DropOldest);
+/// screen.Loop(component);
+/// ```
+void ScreenInteractive::TaskQueueCapacity(size_t capacity,
+                                          ReceiverOverflow overflow) {
+  if (task_sender_) {
+    return;
+  }
+  task_receiver_ = MakeReceiver<Task>(capacity, overflow);
+}
+
+/// @brief Run the loop without helper threads. The terminal input is read,
+/// and the animation frames are scheduled, from the thread running the loop.
+/// @param enable Whether to run without helper threads.
+/// @note This must be called outside of the main loop.
+/// @note This is only supported on POSIX systems. It is ignored otherwise.
+/// @ingroup component
+///
+/// The loop is either run by `ScreenInteractive::Loop`, or driven by the
+/// application's own reactor, waiting for stdin to be readable:
+///
+/// ### Example
+///
+/// ```cpp
+/// auto screen = ScreenInteractive::Fullscreen();
+/// screen.SingleThreaded();
+/// Loop loop(&screen, component);
+/// while (!loop.HasQuitted()) {
+///   pollfd fds[] = {{STDIN_FILENO, POLLIN, 0}, {socket, POLLIN, 0}};
+///   poll(fds, 2, loop.NextTimeout());
+///   if (fds[0].revents) {
+///     loop.OnInputReadable();
+///   }
+///   ...
+///   loop.RunOnce();
+/// }
+/// ```
+///
+/// Tasks posted from other threads only wake `ScreenInteractive::Loop` up.
+/// A custom reactor must be woken up by the application.
+void ScreenInteractive::SingleThreaded(bool enable) {
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+  if (!task_sender_) {
+    single_threaded_ = enable;
+  }
+#else
+  std::ignore = enable;
+#endif
+}
+
+/// @brief Add a task to the main loop.
+/// It will be executed later, with the other tasks of its lane. The lanes are
+/// handled by priority: the input events first, then the timers and the
+/// animation ticks, then the closures. The closures run by slices of
+/// `kBackgroundSlice`, checking for input in between.
+/// @ingroup component
+///
+/// The order is FIFO only within a lane: an event posted after a closure may
+/// be handled before it.
+void ScreenInteractive::Post(Task task) {
+  // Task/Events sent toward inactive screen or screen waiting to become
+  // inactive are dropped.
+  if (!task_sender_) {
+    return;
+  }
+
+  task_sender_->Send(std::move(task));
+  if (single_threaded_) {
+    io_watcher_->WakeUp();
+  }
+}
+
+/// @brief Add a task to the main loop, replacing the one previously posted
+/// with the same |key|, if it wasn't executed yet.
+/// @param key Identifies what the task updates. For instance, a gauge.
+/// @param task The task.
+/// @ingroup component
+///
+/// Posting many times with the same key, faster than they are handled,
+/// results in a single execution: the last one.
+///
+/// ### Example
+///
+/// ```cpp
+/// // From a worker thread:
+/// screen.Post(kProgressKey, [&, value] { progress = value; });
+/// ```
+void ScreenInteractive::Post(size_t key, Task task) {
+  if (!task_sender_) {
+    return;
+  }
+
+  task_sender_->Send(std::move(task), key);
+  if (single_threaded_) {
+    io_watcher_->WakeUp();
+  }
+}
+
+/// @brief Add an event to the main loop.
+/// It will be handled later, after the events posted before it. The events
+/// overtake the timers, the animation ticks, and the closures still queued.
+/// @ingroup component
+///
+/// The order is FIFO only within a lane: an event posted after a closure may
+/// be handled before it.
+void ScreenInteractive::PostEvent(Event event) {
+  Post(event);
+}
+
+/// @brief Print an element above the frame, once.
+/// @param element The element, as tall as it requires, as wide as the
+/// terminal.
+/// @ingroup component
+///
+/// In the TerminalOutput, FitComponent and FixedSize modes, the element is
+/// written where the frame was, and the frame is drawn again below it. The
+/// element then scrolls up with the rest of the terminal's content, and is
+/// never drawn again. This keeps the frame small, like a progress bar below a
+/// growing log. In the alternate screen, or with an OutputSink(), there is no
+/// scrollback: the element is dropped.
+///
+/// Like Post(), the element is dropped when the loop isn't running.
+void ScreenInteractive::PrintAbove(Element element) {
+  Post([this, element = std::move(element)]() mutable {
+    print_above_.push_back(std::move(element));
+    frame_valid_ = false;
+  });
+}
+
+/// @brief Run a function on a worker thread, then a continuation in the loop.
+/// @param fn The function, run on a thread of the screen's worker pool.
+/// @param on_done Posted to the loop once |fn| returns, if any.
+/// @ingroup component
+///
+/// The pool has one thread per core. It is started on first use, shared with
+/// the parallel rendering, see RenderThreads(), and stopped once the loop
+/// exits: the functions not started by then are dropped, the running ones are
+/// waited for. Like Post(), this can be called from any thread.
+///
+/// ### Example
+///
+/// ```cpp
+/// auto result = std::make_shared<std::string>();
+/// screen.RunInBackground([result] { *result = Search(query); },
+///                        [&, result] { results = *result; });
+/// ```
+void ScreenInteractive::RunInBackground(Closure fn, Closure on_done) {
+  Workers()->Run([this, fn = std::move(fn), on_done = std::move(on_done)] {
+    fn();
+    if (on_done) {
+      Post(on_done);
+    }
+  });
+}
+
+// private
+std::shared_ptr<WorkerPool> ScreenInteractive::Workers() {
+  const std::lock_guard<std::mutex> lock(workers_mutex_);
+  if (!workers_) {
+    workers_ = std::make_shared<WorkerPool>();
+  }
+  return workers_;
+}
+
+/// @brief Add a task to the main loop, executed once |delay| has elapsed.
+/// @param delay The time to wait for.
+/// @param task The task.
+/// @return The id of the timer, for CancelTimer().
+/// @ingroup component
+///
+/// ### Example
+///
+/// ```cpp
+/// screen.PostDelayed(std::chrono::seconds(1), [&] { status = ""; });
+/// ```
+size_t ScreenInteractive::PostDelayed(animation::Duration delay, Task task) {
+  const size_t id = io_watcher_->AddTimer(
+      animation::Clock::now() +
+          std::chrono::duration_cast<animation::Clock::duration>(delay),
+      std::move(task), animation::Duration(0));
+  io_watcher_->WakeUp();
+  return id;
+}
+
+/// @brief Add a task to the main loop, executed every |period|, until
+/// cancelled. The periods elapsed while the loop was busy are skipped.
+/// @param period The time in between two executions.
+/// @param task The task.
+/// @return The id of the timer, for CancelTimer().
+/// @ingroup component
+///
+/// ### Example
+///
+/// ```cpp
+/// const size_t blink = screen.PostPeriodic(std::chrono::milliseconds(500),
+///                                          [&] { cursor_visible ^= true; });
+/// ...
+/// screen.CancelTimer(blink);
+/// ```
+size_t ScreenInteractive::PostPeriodic(animation::Duration period, Task task) {
+  const size_t id = io_watcher_->AddTimer(
+      animation::Clock::now() +
+          std::chrono::duration_cast<animation::Clock::duration>(period),
+      std::move(task), period);
+  io_watcher_->WakeUp();
+  return id;
+}
+
+/// @brief Cancel a timer added by PostDelayed() or PostPeriodic(). Its task
+/// isn't executed anymore, unless already posted to the main loop.
+/// @param timer The id of the timer.
+/// @ingroup component
+void ScreenInteractive::CancelTimer(size_t timer) {
+  io_watcher_->CancelTimer(timer);
+}
+
+/// @brief Run a task whenever the loop has nothing else to do, like
+/// prefetching, warming a cache or building an index.
+/// @param task Called with the deadline of the slice it may use, a few
+/// milliseconds from now. It returns whether it has more work. If so, it is
+/// called again, after the other idle tasks.
+/// @ingroup component
+///
+/// The loop is idle once every task posted was handled, the frame is drawn,
+/// and no frame is scheduled. Instead of waiting for the next task, it then
+/// runs a slice of an idle task, and checks for tasks again. Like Post(), this
+/// can be called from any thread.
+///
+/// ### Example
+///
+/// ```cpp
+/// screen.PostIdle([&](animation::TimePoint deadline) {
+///   while (animation::Clock::now() < deadline && !index.Complete()) {
+///     index.AddNextFile();
+///   }
+///   return !index.Complete();
+/// });
+/// ```
+void ScreenInteractive::PostIdle(IdleTask task) {
+  Post([this, task = std::move(task)]() mutable {
+    idle_tasks_.push_back(std::move(task));
+  });
+}
+
+/// @brief Run |on_readable| in the main loop, whenever |fd| has data to read.
+/// This lets the application handle a socket, or a pipe, on the UI thread,
+/// without a thread of its own.
+/// @param fd The file descriptor. It is not owned. Call UnwatchFd() before
+/// closing it.
+/// @param on_readable Called when |fd| is readable. It should read from it,
+/// otherwise it is called again right away.
+/// @note This is only supported on POSIX systems.
+/// @ingroup component
+///
+/// ### Example
+///
+/// ```cpp
+/// screen.WatchFd(socket, [&] {
+///   const ssize_t n = read(socket, buffer, sizeof(buffer));
+///   log.append(buffer, n);
+/// });
+/// ```
+void ScreenInteractive::WatchFd(int fd, Closure on_readable) {
+  io_watcher_->Watch(fd, std::move(on_readable));
+  io_watcher_->WakeUp();
+}
+
+/// @brief Stop watching |fd|.
+/// @ingroup component
+/// @see WatchFd
+void ScreenInteractive::UnwatchFd(int fd) {
+  io_watcher_->Unwatch(fd);
+  io_watcher_->WakeUp();
+}
+
+/// @brief Add a task to draw the screen one more time, until all the animations
+/// are done.
+///
+/// When called from a component's OnAnimation(), only this component is
+/// animated on the next frame. The whole tree is animated otherwise.
+void ScreenInteractive::RequestAnimationFrame() {
+  if (auto* component = ComponentBase::Private::Animating()) {
+    ComponentBase::Private::Request(component);
+  } else {
+    animate_tree_ = true;
+  }
+  ScheduleAnimationFrame();
+}
+
+/// @brief Draw a new frame, once the task being run returns. With
+/// LazyRedraw(), it is needed when an event changes how the components are
+/// drawn without being handled. It must be called from the loop, like the
+/// closures given to Post().
+void ScreenInteractive::RequestRedraw() {
+  frame_valid_ = false;
+}
+
+// private
+void ScreenInteractive::ScheduleAnimationFrame() {
+  if (animation_requested_) {
+    return;
+  }
+  animation_requested_ = true;
+  auto now = animation::Clock::now();
+  const auto time_histeresis = std::chrono::milliseconds(33);
+  if (now - previous_animation_time_ >= time_histeresis) {
+    previous_animation_time_ = now;
+  }
+  ScheduleFrame(previous_animation_time_ +
+                std::chrono::duration_cast<animation::Clock::duration>(
+                    AnimationInterval()));
+}
+
+/// @brief Try to get the unique lock about behing able to capture the mouse.
+/// @return A unique lock if the mouse is not already captured, otherwise a
+/// null.
+/// @ingroup component
+CapturedMouse ScreenInteractive::CaptureMouse() {
+  if (mouse_captured) {
+    return nullptr;
+  }
+  mouse_captured = true;
+  return std::make_unique<CapturedMouseImpl>(
+      [this] { mouse_captured = false; });
+}
+
+/// @brief Execute the main loop.
+/// @param component The component to draw.
+/// @ingroup component
+void ScreenInteractive::Loop(Component component) {  // NOLINT
+  class Loop loop(this, std::move(component));
   loop.Run();
 }
 
@@ -504,55 +1773,104 @@ bool ScreenInteractive::HasQuitted() {
 
 // private
 void ScreenInteractive::PreMain() {
+  ScreenInteractive*& active = ActiveScreen(input_fd_ >= 0);
   // Suspend previously active screen:
-  if (g_active_screen) {
-    std::swap(suspended_screen_, g_active_screen);
+  if (active) {
+    std::swap(suspended_screen_, active);
     // Reset cursor position to the top of the screen and clear the screen.
     suspended_screen_->ResetCursorPosition();
-    std::cout << suspended_screen_->ResetPosition(/*clear=*/true);
+    Write(suspended_screen_->output_fd_,
+          suspended_screen_->ResetPosition(/*clear=*/true));
     suspended_screen_->dimx_ = 0;
     suspended_screen_->dimy_ = 0;
 
-    // Reset dimensions to force drawing the screen again next time:
-    suspended_screen_->Uninstall();
+    // Reset dimensions to force drawing the screen again next time. The
+    // terminal is left configured when this screen needs the same
+    // configuration: only the loop of the suspended screen is stopped.
+    if (SharesTerminalWith(*suspended_screen_)) {
+      suspended_screen_->UninstallLoop();
+    } else {
+      suspended_screen_->Uninstall();
+    }
   }
 
   // This screen is now active:
-  g_active_screen = this;
-  g_active_screen->Install();
+  active = this;
+  if (g_terminal_owner) {
+    synchronized_output_supported_ =
+        g_terminal_owner->synchronized_output_supported_;
+    InstallLoop();
+  } else {
+    Install();
+  }
 
   previous_animation_time_ = animation::Clock::now();
 }
 
 // private
 void ScreenInteractive::PostMain() {
+  ScreenInteractive*& active = ActiveScreen(input_fd_ >= 0);
   // Put cursor position at the end of the drawing.
   ResetCursorPosition();
 
-  g_active_screen = nullptr;
+  active = nullptr;
 
   // Restore suspended screen.
   if (suspended_screen_) {
     // Clear screen, and put the cursor at the beginning of the drawing.
-    std::cout << ResetPosition(/*clear=*/true);
+    Write(output_fd_, ResetPosition(/*clear=*/true));
     dimx_ = 0;
     dimy_ = 0;
-    Uninstall();
-    std::swap(g_active_screen, suspended_screen_);
-    g_active_screen->Install();
+
+    // The terminal is still configured by the suspended screen, unless this
+    // one had to configure it again, for instance after being suspended.
+    if (g_terminal_owner == suspended_screen_) {
+      UninstallLoop();
+      std::swap(active, suspended_screen_);
+      active->synchronized_output_supported_ =
+          synchronized_output_supported_;
+      active->InstallLoop();
+    } else {
+      Uninstall();
+      std::swap(active, suspended_screen_);
+      active->Install();
+    }
   } else {
     Uninstall();
 
-    std::cout << '\r';
+    // Stop the worker pool. The continuations of the functions still running
+    // are dropped: the loop is gone.
+    std::shared_ptr<WorkerPool> workers;
+    {
+      const std::lock_guard<std::mutex> lock(workers_mutex_);
+      workers = std::move(workers_);
+    }
+    workers.reset();
+
+    Write(output_fd_, "\r");
     // On final exit, keep the current drawing and reset cursor position one
     // line after it.
     if (!use_alternative_screen_) {
-      std::cout << '\n';
-      std::cout << std::flush;
+      Write(output_fd_, "\n");
+      if (output_fd_ < 0) {
+        std::cout << std::flush;
+      }
     }
   }
 }
 
+// private
+// Whether the terminal configured for |other| suits this screen as well, so a
+// nested loop can run without configuring it again.
+bool ScreenInteractive::SharesTerminalWith(
+    const ScreenInteractive& other) const {
+  return output_fd_ == other.output_fd_ && input_fd_ == other.input_fd_ &&
+         use_alternative_screen_ == other.use_alternative_screen_ &&
+         track_mouse_ == other.track_mouse_ &&
+         bracketed_paste_ == other.bracketed_paste_ &&
+         synchronized_output_ == other.synchronized_output_;
+}
+
 /// @brief Decorate a function. It executes the same way, but with the currently
 /// active screen terminal hooks temporarilly uninstalled during its execution.
 /// @param fn The function to decorate.
@@ -579,38 +1897,141 @@ void ScreenInteractive::ForceHandleCtrlZ(bool force) {
 /// @brief Return the currently active screen, or null if none.
 // static
 ScreenInteractive* ScreenInteractive::Active() {
-  return g_active_screen;
+  return g_active_session ? g_active_session : g_active_screen;
+}
+
+/// @brief Return the time spent in each phase of the last frames, with the
+/// size of their output.
+///
+/// The percentiles are computed over the last 128 frames. See
+/// FrameStatsElement() to draw them.
+FrameStats ScreenInteractive::Stats() const {
+  return frame_recorder_->Stats();
+}
+
+/// @brief Write the trace recorded, in the Chrome trace event JSON format.
+/// Nothing is recorded unless RecordTrace() was called. This can be called from
+/// any thread, including while the loop runs.
+/// @param out Where to write the trace.
+void ScreenInteractive::WriteTrace(std::ostream& out) const {
+  if (tracer_) {
+    tracer_->Write(out);
+  }
+}
+
+/// @brief Return the number of bytes held by the buffers of the screen.
+/// This includes the current and the previous frame, the output buffer, and
+/// the storage of the tasks queued.
+size_t ScreenInteractive::MemoryUsage() const {
+  return Screen::MemoryUsage() + previous_frame_.MemoryUsage() +
+         output_buffer_.capacity() + TasksCapacity() * sizeof(Task) +
+         print_above_.capacity() * sizeof(Element);
+}
+
+/// @brief Release the storage of the buffers beyond what the last frame needs.
+/// The buffers otherwise keep the storage of the largest frame, output and
+/// burst of tasks seen. This must be called from the loop. See MemoryBudget()
+/// to call it once idle.
+void ScreenInteractive::TrimMemory() {
+  Screen::ShrinkToFit();
+  previous_frame_.ShrinkToFit();
+  output_buffer_.clear();
+  output_buffer_.shrink_to_fit();
+  received_tasks_.shrink_to_fit();
+  for (TaskLane& lane : lanes_) {
+    lane.tasks.shrink_to_fit();
+  }
+  print_above_.shrink_to_fit();
+  task_receiver_->ShrinkToFit();
+}
+
+/// @brief Return the size of the terminal.
+///
+/// Unlike `Terminal::Size()`, this doesn't query the terminal every time. The
+/// size is kept until the terminal is resized, or the screen installed again.
+/// For a screen reading its own input, this is the size set by
+/// SetTerminalSize(), or else the one of its file descriptors.
+/// Must be called from the loop's thread.
+Dimensions ScreenInteractive::TerminalSize() {
+  if (input_fd_ >= 0) {
+    {
+      const std::lock_guard<std::mutex> lock(session_size_mutex_);
+      if (session_size_.dimx > 0 && session_size_.dimy > 0) {
+        return session_size_;
+      }
+    }
+    if (!terminal_size_valid_) {
+      terminal_size_ = Terminal::Size(output_fd_ >= 0 ? output_fd_ : input_fd_);
+      terminal_size_valid_ = true;
+    }
+    return terminal_size_;
+  }
+
+  const int generation = g_terminal_size_generation;
+  if (!terminal_size_valid_ || terminal_size_generation_ != generation) {
+    terminal_size_ = Terminal::Size();
+    terminal_size_generation_ = generation;
+    terminal_size_valid_ = true;
+  }
+  return terminal_size_;
+}
+
+/// @brief Set the size of the terminal of a screen reading its own input, see
+/// InputFd(). Its terminal isn't the process' one: it is resized by the
+/// application, for instance when a remote client reports its new size. The
+/// screen is drawn again at the new size.
+/// @param size The size of the terminal. Zero to query the file descriptors.
+/// @note This can be called from any thread.
+void ScreenInteractive::SetTerminalSize(Dimensions size) {
+  {
+    const std::lock_guard<std::mutex> lock(session_size_mutex_);
+    session_size_ = size;
+  }
+  Post([this] { terminal_size_valid_ = false; });
+  PostEvent(Event::Special({0}));
 }
 
 // private
 void ScreenInteractive::Install() {
-  frame_valid_ = false;
+  InstallTerminal();
+  InstallLoop();
+}
+
+// private
+// Configure the terminal. The previous configuration is restored by OnExit().
+void ScreenInteractive::InstallTerminal() {
+  g_terminal_owner = this;
 
   // Flush the buffer for stdout to ensure whatever the user has printed before
   // is fully applied before we start modifying the terminal configuration. This
   // is important, because we are using two different channels (stdout vs
   // termios/WinAPI) to communicate with the terminal emulator below. See
   // https://github.com/ArthurSonzogni/FTXUI/issues/846
-  Flush();
+  Flush(output_fd_);
 
   // After uninstalling the new configuration, flush it to the terminal to
   // ensure it is fully applied:
-  on_exit_functions.emplace([] { Flush(); });
+  on_exit_functions.emplace([fd = output_fd_] { Flush(fd); });
 
   on_exit_functions.emplace([this] { ExitLoopClosure()(); });
 
   // Request the terminal to report the current cursor shape. We will restore it
   // on exit.
-  std::cout << DECRQSS_DECSCUSR;
+  Write(output_fd_, DECRQSS_DECSCUSR);
   on_exit_functions.emplace([this] {
-    std::cout << "\033[?25h";  // Enable cursor.
-    std::cout << "\033[" + std::to_string(cursor_reset_shape_) + " q";
+    Write(output_fd_, "\033[?25h");  // Enable cursor.
+    Write(output_fd_, "\033[" + std::to_string(cursor_reset_shape_) + " q");
   });
 
   // Install signal handlers to restore the terminal state on exit. The default
-  // signal handlers are restored on exit.
-  for (const int signal : {SIGTERM, SIGSEGV, SIGINT, SIGILL, SIGABRT, SIGFPE}) {
-    InstallSignalHandler(signal);
+  // signal handlers are restored on exit. The signals are for the process'
+  // terminal: the sessions reading their own input don't handle them.
+  const bool session = input_fd_ >= 0;
+  if (!session) {
+    for (const int signal :
+         {SIGTERM, SIGSEGV, SIGINT, SIGILL, SIGABRT, SIGFPE}) {
+      InstallSignalHandler(signal);
+    }
   }
 
 // Save the old terminal configuration and restore it on exit.
@@ -637,22 +2058,40 @@ void ScreenInteractive::Install() {
   const int enable_echo_input = 0x0004;
   const int enable_virtual_terminal_input = 0x0200;
   const int enable_window_input = 0x0008;
+  const int enable_mouse_input = 0x0010;
+  const int enable_quick_edit_mode = 0x0040;
+  const int enable_extended_flags = 0x0080;
   in_mode &= ~enable_echo_input;
   in_mode &= ~enable_line_input;
   in_mode |= enable_virtual_terminal_input;
   in_mode |= enable_window_input;
 
+  // Receive the mouse as native records, instead of the selection of the
+  // quick edit mode.
+  if (track_mouse_) {
+    in_mode |= enable_mouse_input;
+    in_mode |= enable_extended_flags;
+    in_mode &= ~enable_quick_edit_mode;
+  }
+
   SetConsoleMode(stdin_handle, in_mode);
   SetConsoleMode(stdout_handle, out_mode);
 #else
-  for (const int signal : {SIGWINCH, SIGTSTP}) {
-    InstallSignalHandler(signal);
+  if (!session) {
+    for (const int signal : {SIGWINCH, SIGTSTP}) {
+      InstallSignalHandler(signal);
+    }
   }
 
+  // A session's input may be a socket, without a terminal configuration.
+  const int input_fd = session ? input_fd_ : STDIN_FILENO;
   struct termios terminal;  // NOLINT
-  tcgetattr(STDIN_FILENO, &terminal);
-  on_exit_functions.emplace(
-      [=] { tcsetattr(STDIN_FILENO, TCSANOW, &terminal); });
+  const bool has_termios = tcgetattr(input_fd, &terminal) == 0;
+  on_exit_functions.emplace([=] {
+    if (has_termios) {
+      tcsetattr(input_fd, TCSANOW, &terminal);
+    }
+  });
 
   // Enabling raw terminal input mode
   terminal.c_iflag &= ~IGNBRK;  // Disable ignoring break condition
@@ -680,18 +2119,22 @@ void ScreenInteractive::Install() {
                              // read.
   terminal.c_cc[VTIME] = 0;  // Timeout in deciseconds for non-canonical read.
 
-  tcsetattr(STDIN_FILENO, TCSANOW, &terminal);
+  if (has_termios) {
+    tcsetattr(input_fd, TCSANOW, &terminal);
+  }
 
 #endif
 
   auto enable = [&](const std::vector<DECMode>& parameters) {
-    std::cout << Set(parameters);
-    on_exit_functions.emplace([=] { std::cout << Reset(parameters); });
+    Write(output_fd_, Set(parameters));
+    on_exit_functions.emplace(
+        [fd = output_fd_, parameters] { Write(fd, Reset(parameters)); });
   };
 
   auto disable = [&](const std::vector<DECMode>& parameters) {
-    std::cout << Reset(parameters);
-    on_exit_functions.emplace([=] { std::cout << Set(parameters); });
+    Write(output_fd_, Reset(parameters));
+    on_exit_functions.emplace(
+        [fd = output_fd_, parameters] { Write(fd, Set(parameters)); });
   };
 
   if (use_alternative_screen_) {
@@ -705,6 +2148,20 @@ void ScreenInteractive::Install() {
       DECMode::kLineWrap,
   });
 
+  // Ask the terminal whether it supports synchronized output, with the other
+  // capabilities when probed. The frames are synchronized once it answers
+  // positively.
+  synchronized_output_supported_ = false;
+  if (probe_terminal_ && !session) {
+    StartProbe();
+  } else if (synchronized_output_) {
+    Write(output_fd_, RequestMode(DECMode::kSynchronizedOutput));
+  }
+
+  if (bracketed_paste_) {
+    enable({DECMode::kBracketedPaste});
+  }
+
   if (track_mouse_) {
     enable({DECMode::kMouseVt200});
     enable({DECMode::kMouseAnyEvent});
@@ -714,43 +2171,410 @@ void ScreenInteractive::Install() {
 
   // After installing the new configuration, flush it to the terminal to
   // ensure it is fully applied:
-  Flush();
+  Flush(output_fd_);
+}
+
+// private
+// Use the capabilities known for this terminal, and query them, unless this
+// process already did. Its synchronized output support is queried as well.
+void ScreenInteractive::StartProbe() {
+  probe_.reset();
+  const std::string identity = TerminalProbe::Identity();
+  TerminalCapabilities known;
+  const bool probed = TerminalProbe::Lookup(identity, &known);
+  if (probed || TerminalProbe::Load(probe_cache_file_, identity, &known)) {
+    TerminalProbe::Apply(known);
+    synchronized_output_supported_ = known.synchronized_output;
+  }
+  if (!probed) {
+    probe_ = std::make_shared<TerminalProbe>();
+    Write(output_fd_, TerminalProbe::Queries());
+  }
+}
+
+// private
+// Record an answer to the probe. Once the terminal answered, apply and
+// remember what it supports.
+void ScreenInteractive::OnProbeReport(const Event& event) {
+  if (!probe_ || !probe_->OnEvent(event)) {
+    return;
+  }
+  const TerminalCapabilities& capabilities = probe_->capabilities();
+  TerminalProbe::Apply(capabilities);
+  TerminalProbe::Store(probe_cache_file_, TerminalProbe::Identity(),
+                       capabilities);
+  probe_.reset();
+  // The colors may have changed.
+  frame_valid_ = false;
+}
+
+// private
+// Start the loop: the helper threads, and the first frame.
+void ScreenInteractive::InstallLoop() {
+  frame_valid_ = false;
+  terminal_size_valid_ = false;
+  origin_known_ = false;
+
+  // The terminal content might have been modified while the screen was
+  // uninstalled. The next frame must be fully repainted.
+  previous_frame_ = Screen(0, 0);
 
   quit_ = false;
+  frame_scheduled_ = false;
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+  if (input_fd_ < 0) {
+    CreateWakeUpPipe();
+    io_watcher_->UseWakeUpPipe(&g_wakeup_pipe);
+  } else {
+    io_watcher_->UseWakeUpPipe(nullptr);
+  }
+#endif
   task_sender_ = task_receiver_->MakeSender();
-  event_listener_ =
-      std::thread(&EventListener, &quit_, task_receiver_->MakeSender());
-  animation_listener_ =
-      std::thread(&AnimationListener, &quit_, task_receiver_->MakeSender());
+  if (single_threaded_) {
+    input_parser_ =
+        std::make_shared<TerminalInputParser>(task_receiver_->MakeSender());
+    input_time_ = animation::Clock::now();
+    input_closed_ = false;
+  } else {
+    event_listener_ =
+        std::thread(&EventListener, &quit_, task_receiver_->MakeSender(),
+                    io_watcher_, input_fd_);
+    animation_listener_ = std::thread(&ScreenInteractive::AnimationListener,
+                                      this, task_receiver_->MakeSender());
+  }
+
+  // The SharedValue written redraw the screen rendering them.
+  SharedValueBase::Attach(this, /*main=*/input_fd_ < 0);
+
+  // Wake the loop up, to draw the first frame.
+  task_sender_->Send(AnimationTask());
 }
 
 // private
 void ScreenInteractive::Uninstall() {
-  ExitNow();
-  event_listener_.join();
-  animation_listener_.join();
+  UninstallLoop();
   OnExit();
+  g_terminal_owner = nullptr;
+}
+
+// private
+// Stop the loop and its helper threads. The terminal is left configured.
+void ScreenInteractive::UninstallLoop() {
+  UnwatchLiveCells();
+  SharedValueBase::Detach(this);
+  ExitNow();
+  if (event_listener_.joinable()) {
+    event_listener_.join();
+  }
+  if (animation_listener_.joinable()) {
+    animation_listener_.join();
+  }
+  if (trim_timer_ != 0) {
+    io_watcher_->CancelTimer(trim_timer_);
+    trim_timer_ = 0;
+  }
 }
 
 // private
 // NOLINTNEXTLINE
 void ScreenInteractive::RunOnceBlocking(Component component) {
   ExecuteSignalHandlers();
-  Task task;
-  if (task_receiver_->Receive(&task)) {
-    HandleTask(component, task);
+  // With idle tasks left, the loop checks for tasks without waiting.
+  const bool wait = idle_tasks_.empty() || !IsIdle();
+  if (single_threaded_) {
+    WaitForInput(wait ? NextTimeout() : 0);
+  } else if (wait && !HasPendingTasks()) {
+    Task task;
+    if (task_receiver_->Receive(&task)) {
+      received_tasks_.push_back(std::move(task));
+    }
   }
   RunOnce(component);
 }
 
+// private
+// Single threaded mode: wait for up to |timeout| milliseconds for stdin to be
+// readable, or for the wakeup pipe to be written to. With idle tasks, the
+// input is only polled.
+void ScreenInteractive::WaitForInput(int timeout) {
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+  if (timeout == 0 && idle_tasks_.empty()) {
+    return;
+  }
+  const int input_fd = input_fd_ < 0 ? STDIN_FILENO : input_fd_;
+  std::array<pollfd, 2> fds = {{
+      {input_closed_ ? -1 : input_fd, POLLIN, 0},
+      {io_watcher_->WakeUpFd(), POLLIN, 0},
+  }};
+  if (poll(fds.data(), fds.size(), timeout) <= 0) {
+    return;
+  }
+  if (fds[1].revents != 0) {
+    io_watcher_->DrainWakeUp();
+  }
+  if (fds[0].revents != 0) {
+    ReadInput();
+  }
+#else
+  std::ignore = timeout;
+#endif
+}
+
+// private
+// Single threaded mode: read the available input, without blocking.
+void ScreenInteractive::ReadInput() {
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+  if (!input_parser_ || input_closed_) {
+    return;
+  }
+  const size_t buffer_size = 1024;
+  std::array<char, buffer_size> buffer;  // NOLINT;
+  const int input_fd = input_fd_ < 0 ? STDIN_FILENO : input_fd_;
+  const ssize_t l = read(input_fd, buffer.data(), buffer_size);
+  if (l == 0 || (l < 0 && errno != EINTR && errno != EAGAIN)) {
+    input_closed_ = true;
+  }
+  if (l > 0) {
+    input_parser_->Add(std::string_view(buffer.data(), size_t(l)));
+  }
+  input_time_ = animation::Clock::now();
+#endif
+}
+
+// private
+// Single threaded mode: the number of milliseconds until RunOnce() has
+// something to do, or -1 if it only waits for input.
+int ScreenInteractive::NextTimeout() {
+  if (HasPendingTasks() || task_receiver_->HasPending()) {
+    return 0;
+  }
+  const auto now = animation::Clock::now();
+  int timeout = io_watcher_->TimeUntilNextTimer();
+  if (input_parser_ && input_parser_->HasPending()) {
+    timeout = MinTimeout(
+        timeout,
+        MillisecondsUntil(
+            input_time_ + std::chrono::milliseconds(timeout_milliseconds),
+            now));
+  }
+  const std::lock_guard<std::mutex> lock(frame_mutex_);
+  if (frame_scheduled_) {
+    timeout = MinTimeout(timeout, MillisecondsUntil(frame_deadline_, now));
+  }
+  return timeout;
+}
+
+// private
+// Single threaded mode: do what the event listener and the animation listener
+// threads would have done by now.
+void ScreenInteractive::RunDeadlines() {
+  const auto now = animation::Clock::now();
+  if (input_parser_ && input_parser_->HasPending()) {
+    const auto elapsed =
+        std::chrono::duration_cast<std::chrono::milliseconds>(now -
+                                                              input_time_);
+    if (elapsed.count() >= timeout_milliseconds) {
+      input_parser_->Timeout(int(elapsed.count()));
+      input_time_ = now;
+    }
+  }
+
+  bool frame_due = false;
+  {
+    const std::lock_guard<std::mutex> lock(frame_mutex_);
+    if (frame_scheduled_ && frame_deadline_ <= now) {
+      frame_scheduled_ = false;
+      frame_due = true;
+    }
+  }
+  if (frame_due) {
+    lanes_[kTimerLane].tasks.emplace_back(AnimationTask());
+  }
+}
+
+// private
+// Move the tasks received to their lane.
+void ScreenInteractive::ReceiveTasks() {
+  task_receiver_->ReceiveAll(&received_tasks_);
+  for (Task& task : received_tasks_) {
+    const size_t lane = std::holds_alternative<Event>(task) ? kInputLane
+                        : std::holds_alternative<AnimationTask>(task)
+                            ? kTimerLane
+                            : kBackgroundLane;
+    lanes_[lane].tasks.push_back(std::move(task));
+  }
+  received_tasks_.clear();
+
+  io_watcher_->TakeExpiredTimers(&received_tasks_);
+  for (Task& task : received_tasks_) {
+    lanes_[kTimerLane].tasks.push_back(std::move(task));
+  }
+  received_tasks_.clear();
+}
+
+// private
+bool ScreenInteractive::HasPendingTasks() const {
+  return std::any_of(lanes_.begin(), lanes_.end(),
+                     [](const TaskLane& lane) { return !lane.empty(); });
+}
+
+// private
+size_t ScreenInteractive::TasksCapacity() const {
+  size_t capacity = received_tasks_.capacity();
+  for (const TaskLane& lane : lanes_) {
+    capacity += lane.tasks.capacity();
+  }
+  return capacity;
+}
+
+// private
+// Handle |task|, measuring the latency of the input events.
+void ScreenInteractive::RunTask(Component component, Task& task) {
+  const auto* event = std::get_if<Event>(&task);
+  const bool measure_latency = !event_pending_ && event;
+  // From the input being read, or from now for the events posted.
+  animation::TimePoint input_time;
+  if (measure_latency) {
+    input_time = event->read_time() != animation::TimePoint()
+                     ? event->read_time()
+                     : animation::Clock::now();
+  }
+  if (tracer_) {
+    TraceTask(std::move(component), task);
+  } else {
+    HandleTask(std::move(component), task);
+  }
+  // The events not invalidating the frame, like the terminal reports, aren't
+  // waiting for one.
+  if (measure_latency && !frame_valid_) {
+    event_pending_ = true;
+    event_time_ = input_time;
+  }
+  ExecuteSignalHandlers();
+}
+
+// private
+// Whether the frame being drawn should be abandoned, for the input received.
+bool ScreenInteractive::IsFrameStale() {
+  if (!abandon_stale_frames_ || frames_abandoned_ >= kMaxFramesAbandoned) {
+    return false;
+  }
+  ReceiveTasks();
+  return !lanes_[kInputLane].empty();
+}
+
+// private
+// Whether the loop has nothing to do: no task pending, and the frame drawn.
+bool ScreenInteractive::IsIdle() {
+  if (!frame_valid_ || HasPendingTasks() || task_receiver_->HasPending() ||
+      io_watcher_->TimeUntilNextTimer() == 0 ||
+      (input_parser_ && input_parser_->HasPending())) {
+    return false;
+  }
+  const std::lock_guard<std::mutex> lock(frame_mutex_);
+  return !frame_scheduled_;
+}
+
+// private
+// Run a slice of the first idle task, if the loop is idle.
+void ScreenInteractive::RunIdleTask() {
+  if (idle_tasks_.empty() || !IsIdle()) {
+    return;
+  }
+  IdleTask task = std::move(idle_tasks_.front());
+  idle_tasks_.pop_front();
+  const auto start = animation::Clock::now();
+  const bool more = task(start + kIdleSlice);
+  if (tracer_) {
+    tracer_->Add("Idle", start, animation::Clock::now());
+  }
+  if (more) {
+    idle_tasks_.push_back(std::move(task));
+  }
+  ExecuteSignalHandlers();
+}
+
+// private
+void ScreenInteractive::AbandonFrame(animation::TimePoint draw_start) {
+  frames_abandoned_++;
+  frame_recorder_->AbandonFrame();
+  if (tracer_) {
+    tracer_->Add("Draw (abandoned)", draw_start, animation::Clock::now());
+  }
+}
+
 // private
 void ScreenInteractive::RunOnce(Component component) {
-  Task task;
-  while (task_receiver_->ReceiveNonBlocking(&task)) {
-    HandleTask(component, task);
+  if (single_threaded_) {
     ExecuteSignalHandlers();
+    RunDeadlines();
+  }
+
+  // Handle the pending tasks by rounds. Each round handles the input events,
+  // then the timers and the animation ticks, then a slice of the closures
+  // posted. The tasks received meanwhile are handled by the next round, so a
+  // flood of closures delays the input by one slice at most.
+  //
+  // Once an input event invalidated the frame, the closures left after a slice
+  // wait for the frame to be drawn.
+  ReceiveTasks();
+  int background_slices = 0;
+  while (HasPendingTasks()) {
+    TaskLane& input = lanes_[kInputLane];
+    for (size_t end = input.tasks.size(); input.next < end;) {
+      Task& task = input.tasks[input.next++];
+      if (coalesce_events_ && input.next < end &&
+          IsSuperseded(task, input.tasks[input.next])) {
+        continue;
+      }
+      RunTask(component, task);
+    }
+
+    TaskLane& timer = lanes_[kTimerLane];
+    for (size_t end = timer.tasks.size(); timer.next < end;) {
+      RunTask(component, timer.tasks[timer.next++]);
+    }
+
+    TaskLane& background = lanes_[kBackgroundLane];
+    if (!background.empty() && event_pending_ && background_slices > 0) {
+      break;
+    }
+    const size_t end =
+        std::min(background.tasks.size(), background.next + kBackgroundSlice);
+    while (background.next < end) {
+      RunTask(component, background.tasks[background.next++]);
+    }
+    background_slices++;
+
+    for (TaskLane& lane : lanes_) {
+      lane.Compact();
+    }
+    ReceiveTasks();
+  }
+
+  // Postpone the frame when the previous one was drawn too recently. The
+  // animation listener wakes the loop up when it is due.
+  if (!frame_valid_ && max_frame_rate_ > 0) {
+    const auto next_draw =
+        last_draw_time_ + std::chrono::duration_cast<animation::Clock::duration>(
+                              std::chrono::duration<float>(
+                                  1.F / float(max_frame_rate_)));
+    if (animation::Clock::now() < next_draw) {
+      ScheduleFrame(next_draw);
+      return;
+    }
+  }
+
+  // Postpone the frame while the previous one is still being drained by a slow
+  // terminal.
+  if (!frame_valid_ && throttle_output_ &&
+      animation::Clock::now() < output_drained_time_) {
+    ScheduleFrame(output_drained_time_);
+    return;
   }
+
   Draw(std::move(component));
+  RunIdleTask();
 }
 
 // private
@@ -763,9 +2587,15 @@ void ScreenInteractive::HandleTask(Component component, Task& task) {
         // clang-format off
     // Handle Event.
     if constexpr (std::is_same_v<T, Event>) {
+      if (session_recorder_) {
+        session_recorder_->AddEvent(arg);
+      }
+
+      // The position of the frame, before drawing the frames since the
+      // query.
       if (arg.is_cursor_position()) {
         cursor_x_ = arg.cursor_x();
-        cursor_y_ = arg.cursor_y();
+        cursor_y_ = FrameOrigin(arg.cursor_y());
         return;
       }
 
@@ -774,6 +2604,21 @@ void ScreenInteractive::HandleTask(Component component, Task& task) {
         return;
       }
 
+      if (arg.is_mode_report()) {
+        if (arg.mode() == int(DECMode::kSynchronizedOutput)) {
+          // 1: set, 2: reset, 3: permanently set. The mode is supported.
+          synchronized_output_supported_ =
+              arg.mode_value() >= 1 && arg.mode_value() <= 3;
+        }
+        OnProbeReport(arg);
+        return;
+      }
+
+      if (arg.is_device_attributes() || arg.is_terminal_version()) {
+        OnProbeReport(arg);
+        return;
+      }
+
       if (arg.is_mouse()) {
         arg.mouse().x -= cursor_x_;
         arg.mouse().y -= cursor_y_;
@@ -781,6 +2626,7 @@ void ScreenInteractive::HandleTask(Component component, Task& task) {
 
       arg.screen_ = this;
 
+      ComponentBase::Private::InvalidateFocus();
       const bool handled = component->OnEvent(arg);
 
       if (arg == Event::CtrlC && (!handled || force_handle_ctrl_c_)) {
@@ -792,13 +2638,21 @@ void ScreenInteractive::HandleTask(Component component, Task& task) {
         RecordSignal(SIGTSTP);
       }
 #endif
-      
-      frame_valid_ = false;
+
+      // The events changing nothing aren't drawn, when lazy. The resizes are
+      // signaled by Event::Special({0}).
+      if (!lazy_redraw_ || handled || arg == Event::Custom ||
+          arg == Event::Special({0})) {
+        frame_valid_ = false;
+      }
       return;
     }
 
     // Handle callback
-    if constexpr (std::is_same_v<T, Closure>) {
+    if constexpr (std::is_same_v<T, TaskClosure>) {
+      if (session_recorder_) {
+        session_recorder_->AddTask();
+      }
       arg();
       return;
     }
@@ -808,6 +2662,9 @@ void ScreenInteractive::HandleTask(Component component, Task& task) {
       if (!animation_requested_) {
         return;
       }
+      if (session_recorder_) {
+        session_recorder_->AddAnimation();
+      }
 
       animation_requested_ = false;
       const animation::TimePoint now = animation::Clock::now();
@@ -815,7 +2672,13 @@ void ScreenInteractive::HandleTask(Component component, Task& task) {
       previous_animation_time_ = now;
 
       animation::Params params(delta);
-      component->OnAnimation(params);
+      if (animate_tree_) {
+        animate_tree_ = false;
+        ComponentBase::Private::DropRequests(0);
+        ComponentBase::Private::Animate(component.get(), params);
+      } else {
+        ComponentBase::Private::AnimateRequested(params);
+      }
       frame_valid_ = false;
       return;
     }
@@ -824,6 +2687,52 @@ void ScreenInteractive::HandleTask(Component component, Task& task) {
   // clang-format on
 }
 
+// private
+// Run by |animation_listener_|. Sleep until a frame is scheduled, then wake
+// the main loop up.
+void ScreenInteractive::AnimationListener(Sender<Task> out) {
+  std::unique_lock<std::mutex> lock(frame_mutex_);
+  while (!quit_) {
+    if (!frame_scheduled_) {
+      frame_notifier_.wait(lock);
+      continue;
+    }
+
+    // The deadline might have been moved earlier, or the loop asked to quit.
+    if (frame_notifier_.wait_until(lock, frame_deadline_) !=
+        std::cv_status::timeout) {
+      continue;
+    }
+
+    frame_scheduled_ = false;
+    lock.unlock();
+    out->Send(AnimationTask());
+    lock.lock();
+  }
+}
+
+// private
+void ScreenInteractive::ScheduleFrame(animation::TimePoint deadline) {
+  {
+    const std::lock_guard<std::mutex> lock(frame_mutex_);
+    if (frame_scheduled_ && frame_deadline_ <= deadline) {
+      return;
+    }
+    frame_scheduled_ = true;
+    frame_deadline_ = deadline;
+  }
+  frame_notifier_.notify_one();
+}
+
+// private
+// The delay in between two animation frames. When drawing takes longer than
+// the budget of the target frame rate, whole frames are skipped.
+animation::Duration ScreenInteractive::AnimationInterval() const {
+  const float budget = 1.F / float(target_frame_rate_);
+  const float frames = std::ceil(float(LastFrameTime()) / budget);
+  return animation::Duration(budget * std::max(1.F, frames));
+}
+
 struct DrawTimer {
   PerfMeasure& m_;
   explicit DrawTimer(PerfMeasure& m) : m_(m) {m_.start();}
@@ -835,6 +2744,13 @@ struct DrawTimer {
   DrawTimer& operator=(const DrawTimer&& other) = delete;
 };
 
+// private
+// The row of the frame drawn from row |y|, once the terminal scrolled to fit
+// it.
+int ScreenInteractive::FrameOrigin(int y) const {
+  return std::max(1, std::min(y, origin_terminal_dimy_ - dimy_ + 1));
+}
+
 // private
 // NOLINTNEXTLINE
 void ScreenInteractive::Draw(Component component) {
@@ -842,11 +2758,27 @@ void ScreenInteractive::Draw(Component component) {
     return;
   }
   DrawTimer timeit(render_duration_); // captures execution time of this method
+  const auto draw_start = animation::Clock::now();
+  const AllocationCount draw_start_allocations = Allocations();
+  // The components might have changed since the last event.
+  ComponentBase::Private::InvalidateFocus();
   auto document = component->Render();
+  const auto component_render_end = animation::Clock::now();
+  const AllocationCount component_render_end_allocations = Allocations();
   int dimx = 0;
   int dimy = 0;
-  auto terminal = Terminal::Size();
-  document->ComputeRequirement();
+  auto terminal = TerminalSize();
+  // The layout continues from this requirement, instead of computing it again.
+  Measure(document);
+  const auto requirement_end = animation::Clock::now();
+
+  // The input received meanwhile makes this frame stale. It is handled first,
+  // and the frame rendered again.
+  if (IsFrameStale()) {
+    AbandonFrame(draw_start);
+    return;
+  }
+  last_draw_time_ = draw_start;
   switch (dimension_) {
     case Dimension::Fixed:
       dimx = dimx_;
@@ -855,6 +2787,12 @@ void ScreenInteractive::Draw(Component component) {
     case Dimension::TerminalOutput:
       dimx = terminal.dimx;
       dimy = document->requirement().min_y;
+      // The rows past the top of the terminal can't be drawn again. Only the
+      // last ones are, the nodes above them being skipped.
+      if (dimy > terminal.dimy) {
+        dimy = terminal.dimy;
+        document = document | focusPositionRelative(0.F, 1.F) | yframe;
+      }
       break;
     case Dimension::Fullscreen:
       dimx = terminal.dimx;
@@ -867,51 +2805,88 @@ void ScreenInteractive::Draw(Component component) {
   }
 
   const bool resized = (dimx != dimx_) || (dimy != dimy_);
-  ResetCursorPosition();
-  std::cout << ResetPosition(/*clear=*/resized);
+
+  // The whole frame is accumulated into the output buffer, and written at once.
+  // The buffer is reused from one frame to the next, to avoid allocating.
+  output_buffer_.clear();
+  const bool synchronized =
+      synchronized_output_ && synchronized_output_supported_;
+  if (synchronized) {
+    output_buffer_ += Set({DECMode::kSynchronizedOutput});
+  }
+  output_buffer_ += reset_cursor_position;
+  // Restored if the frame is abandoned: the cursor didn't move.
+  std::string previous_reset_cursor_position;
+  previous_reset_cursor_position.swap(reset_cursor_position);
+  const bool print_above =
+      !print_above_.empty() && !use_alternative_screen_ && !sink_;
+  output_buffer_ += ResetPosition(/*clear=*/resized || print_above);
 
   // If the terminal width decrease, the terminal emulator will start wrapping
   // lines and make the display dirty. We should clear it completely.
   if ((dimx < dimx_) && !use_alternative_screen_) {
-    std::cout << "\033[J";  // clear terminal output
-    std::cout << "\033[H";  // move cursor to home position
+    output_buffer_ += "\033[J";  // clear terminal output
+    output_buffer_ += "\033[H";  // move cursor to home position
+    cursor_x_ = 1;
+    cursor_y_ = 1;
+  }
+
+  // The elements printed above are written where the frame was, and the frame
+  // is drawn in full below them.
+  if (print_above) {
+    for (const Element& element : print_above_) {
+      element->ComputeRequirement();
+      Screen printed(terminal.dimx, element->requirement().min_y);
+      Render(printed, element);
+      output_buffer_ += printed.ToString();
+      output_buffer_ += "\r\n";
+      cursor_y_ += printed.dimy();
+    }
   }
+  print_above_.clear();
 
   // Resize the screen if needed.
   if (resized) {
-    dimx_ = dimx;
-    dimy_ = dimy;
-    pixels_ = std::vector<std::vector<Pixel>>(dimy, std::vector<Pixel>(dimx));
+    Resize(dimx, dimy);
     cursor_.x = dimx_ - 1;
     cursor_.y = dimy_ - 1;
   }
 
-  // Periodically request the terminal emulator the frame position relative to
-  // the screen. This is useful for converting mouse position reported in
-  // screen's coordinates to frame's coordinates.
-#if defined(FTXUI_MICROSOFT_TERMINAL_FALLBACK)
-  // Microsoft's terminal suffers from a [bug]. When reporting the cursor
-  // position, several output sequences are mixed together into garbage.
-  // This causes FTXUI user to see some "1;1;R" sequences into the Input
-  // component. See [issue]. Solution is to request cursor position less
-  // often. [bug]: https://github.com/microsoft/terminal/pull/7583 [issue]:
-  // https://github.com/ArthurSonzogni/FTXUI/issues/136
-  static int i = -3;
-  ++i;
-  if (!use_alternative_screen_ && (i % 150 == 0)) {  // NOLINT
-    std::cout << DeviceStatusReport(DSRMode::kCursor);
+  // A frame going past the bottom of the terminal scrolls it.
+  if (!use_alternative_screen_) {
+    cursor_y_ = FrameOrigin(cursor_y_);
   }
-#else
-  static int i = -3;
-  ++i;
-  if (!use_alternative_screen_ &&
-      (previous_frame_resized_ || i % 40 == 0)) {  // NOLINT
-    std::cout << DeviceStatusReport(DSRMode::kCursor);
+
+  // The position of the frame on the terminal converts the mouse positions,
+  // reported relative to the terminal, into the frame's. In the alternate
+  // screen, it is the top left corner. Otherwise, the terminal emulator is
+  // asked once, and the position is then followed from our own output. It is
+  // asked again only when the terminal is resized, reflowing its content.
+  //
+  // This also avoids Microsoft's terminal [bug], mixing the reply with other
+  // output sequences into garbage, like "1;1;R" typed into an Input. See
+  // [issue]. [bug]: https://github.com/microsoft/terminal/pull/7583 [issue]:
+  // https://github.com/ArthurSonzogni/FTXUI/issues/136
+  bool queried_origin = false;
+  if (!use_alternative_screen_) {
+    if (terminal.dimx != origin_terminal_dimx_ ||
+        terminal.dimy != origin_terminal_dimy_) {
+      origin_known_ = false;
+    }
+    if (!origin_known_) {
+      queried_origin = true;
+      output_buffer_ += DeviceStatusReport(DSRMode::kCursor);
+      origin_known_ = true;
+      origin_terminal_dimx_ = terminal.dimx;
+      origin_terminal_dimy_ = terminal.dimy;
+    }
   }
-#endif
-  previous_frame_resized_ = resized;
 
-  Render(*this, document);
+  if (render_threads_ == 1) {
+    Render(*this, document);
+  } else {
+    RenderParallel(*this, document, *Workers(), render_threads_);
+  }
 
   // Set cursor position for user using tools to insert CJK characters.
   {
@@ -940,15 +2915,267 @@ void ScreenInteractive::Draw(Component component) {
     }
   }
 
-  std::cout << ToString() << set_cursor_position;
-  Flush();
+  // Check the input again, unless the terminal was already affected. Nothing
+  // was written yet.
+  if (!resized && !print_above && !queried_origin && IsFrameStale()) {
+    reset_cursor_position.swap(previous_reset_cursor_position);
+    Clear();
+    AbandonFrame(draw_start);
+    return;
+  }
+  frames_abandoned_ = 0;
+
+  const auto serialize_start = animation::Clock::now();
+  const AllocationCount serialize_start_allocations = Allocations();
+  if (sink_) {
+    // The sink draws the whole frame itself.
+    output_buffer_.clear();
+    if (sink_->WantsRuns()) {
+      render_frame_builder_->Build(*this, previous_frame_, render_frame_.get());
+    } else {
+      render_frame_->screen = this;
+      render_frame_->resized = resized;
+      render_frame_->cursor = cursor_;
+    }
+  } else {
+    if (differential_output_ && !resized && !print_above) {
+      ToDiffString(previous_frame_, output_buffer_);
+    } else if (render_threads_ == 1) {
+      ToCompactString(output_buffer_);
+    } else {
+      ToCompactString(output_buffer_,
+                      [this](size_t count, const auto& fn) {
+                        Workers()->ParallelFor(count, fn, render_threads_);
+                      });
+    }
+    output_buffer_ += set_cursor_position;
+    if (synchronized) {
+      output_buffer_ += Reset({DECMode::kSynchronizedOutput});
+    }
+  }
+  const auto write_start = animation::Clock::now();
+  const AllocationCount write_start_allocations = Allocations();
+  if (sink_) {
+    sink_->Frame(*render_frame_);
+  } else {
+    Write(output_fd_, output_buffer_);
+    Flush(output_fd_);
+  }
+  const auto write_end = animation::Clock::now();
+  const AllocationCount write_end_allocations = Allocations();
+  if (throttle_output_) {
+    MeasureOutput(output_buffer_.size(), write_start);
+  }
+
+  auto seconds = [](animation::Clock::duration duration) {
+    return std::chrono::duration<double>(duration).count();
+  };
+  const RenderTimings& timings = LastRenderTimings();
+  FrameRecorder& recorder = *frame_recorder_;
+  recorder.Add(FrameRecorder::kComponentRender,
+               seconds(component_render_end - draw_start));
+  recorder.Add(FrameRecorder::kLayout,
+               seconds(requirement_end - component_render_end) +
+                   timings.layout);
+  recorder.Add(FrameRecorder::kNodeRender, timings.draw);
+  recorder.Add(FrameRecorder::kShader, timings.shader);
+  recorder.Add(FrameRecorder::kSerialize, seconds(write_start - serialize_start));
+  recorder.Add(FrameRecorder::kWrite, seconds(write_end - write_start));
+  recorder.Add(FrameRecorder::kTotal, seconds(write_end - draw_start));
+  if (event_pending_) {
+    event_pending_ = false;
+    recorder.Add(FrameRecorder::kEventLatency, seconds(write_end - event_time_));
+  }
+  recorder.SetAllocations({
+      component_render_end_allocations - draw_start_allocations,
+      serialize_start_allocations - component_render_end_allocations,
+      write_start_allocations - serialize_start_allocations,
+      write_end_allocations - write_start_allocations,
+      write_end_allocations - draw_start_allocations,
+  });
+  recorder.AddFrame(output_buffer_.size());
+  if (tracer_) {
+    // The layout, the drawing and the shaders are only known by their
+    // durations. They run one after the other, starting with the layout.
+    auto after = [](animation::TimePoint start, double duration) {
+      return start + std::chrono::duration_cast<animation::Clock::duration>(
+                         std::chrono::duration<double>(duration));
+    };
+    const auto layout_end = after(requirement_end, timings.layout);
+    const auto node_render_end = after(layout_end, timings.draw);
+    tracer_->Add("Draw", draw_start, write_end);
+    tracer_->Add("Component::Render", draw_start, component_render_end);
+    tracer_->Add("Layout", component_render_end, layout_end);
+    tracer_->Add("Node::Render", layout_end, node_render_end);
+    tracer_->Add("Shader", node_render_end,
+                 after(node_render_end, timings.shader));
+    tracer_->Add("Serialize", serialize_start, write_start);
+    tracer_->Add("Write", write_start, write_end,
+                 std::to_string(output_buffer_.size()) + " bytes");
+  }
+  // The live cells are written over the last frame.
+  if (differential_output_ || !LiveCells().empty() ||
+      (sink_ && sink_->WantsRuns())) {
+    previous_frame_ = *this;
+  }
+  WatchLiveCells();
+  if (session_recorder_) {
+    session_recorder_->AddFrame(dimx_, dimy_);
+  }
   Clear();
   frame_valid_ = true;
+  ScheduleTrim();
+}
+
+// private
+// Follow the live cells of the frame just drawn, until the next one. Their
+// updates wake the loop up, to patch the frame.
+void ScreenInteractive::WatchLiveCells() {
+  UnwatchLiveCells();
+  displayed_live_cells_ = LiveCells();
+  for (const LiveCellPlacement& placement : displayed_live_cells_) {
+    placement.cell->Watch(this, [this] { Post([this] { PatchLiveCells(); }); });
+  }
+}
+
+// private
+void ScreenInteractive::UnwatchLiveCells() {
+  for (const LiveCellPlacement& placement : displayed_live_cells_) {
+    placement.cell->Unwatch(this);
+  }
+  displayed_live_cells_.clear();
+}
+
+// private
+// Write the updated live cells over the last frame, without drawing a new one.
+// Only their cells are written, from where the frame left the cursor.
+void ScreenInteractive::PatchLiveCells() {
+  // The next frame draws them anyway.
+  if (!frame_valid_) {
+    return;
+  }
+  // The sinks are given whole frames. The last frame might be unknown, after
+  // a resize or a suspension.
+  if (sink_ || previous_frame_.dimx() != dimx_ ||
+      previous_frame_.dimy() != dimy_) {
+    frame_valid_ = false;
+    return;
+  }
+
+  // A cell placed twice is consumed by its first placement.
+  live_cells_pending_.clear();
+  bool pending = false;
+  for (const LiveCellPlacement& placement : displayed_live_cells_) {
+    live_cells_pending_.push_back(placement.cell->Pending());
+    pending |= live_cells_pending_.back();
+  }
+  if (!pending) {
+    return;
+  }
+
+  output_buffer_.clear();
+  const bool synchronized =
+      synchronized_output_ && synchronized_output_supported_;
+  if (synchronized) {
+    output_buffer_ += Set({DECMode::kSynchronizedOutput});
+  }
+  output_buffer_ += reset_cursor_position;
+  for (size_t i = 0; i < displayed_live_cells_.size(); ++i) {
+    if (!live_cells_pending_[i]) {
+      continue;
+    }
+    const LiveCellPlacement& placement = displayed_live_cells_[i];
+    placement.cell->Draw(previous_frame_, placement.x, placement.y,
+                         placement.box);
+    previous_frame_.ToPatchString(placement.box, output_buffer_);
+  }
+  output_buffer_ += set_cursor_position;
+  if (synchronized) {
+    output_buffer_ += Reset({DECMode::kSynchronizedOutput});
+  }
+
+  const auto write_start = animation::Clock::now();
+  Write(output_fd_, output_buffer_);
+  Flush(output_fd_);
+  if (throttle_output_) {
+    MeasureOutput(output_buffer_.size(), write_start);
+  }
+}
+
+// private
+// Check the memory once no frame was drawn for |trim_delay_|. See
+// MemoryBudget().
+void ScreenInteractive::ScheduleTrim() {
+  if (memory_budget_ == 0 || trim_timer_ != 0) {
+    return;
+  }
+  trim_timer_ = PostDelayed(trim_delay_, [this] { TrimIfIdle(); });
+}
+
+// private
+void ScreenInteractive::TrimIfIdle() {
+  trim_timer_ = 0;
+  const auto now = animation::Clock::now();
+  const auto idle_time = last_draw_time_ + trim_delay_;
+  if (now < idle_time) {
+    trim_timer_ = PostDelayed(idle_time - now, [this] { TrimIfIdle(); });
+    return;
+  }
+  if (MemoryUsage() > memory_budget_) {
+    TrimMemory();
+  }
+}
+
+// private
+// HandleTask(), adding a span to the trace.
+void ScreenInteractive::TraceTask(Component component, Task& task) {
+  const auto start = animation::Clock::now();
+  const char* name = "Animation";
+  std::string detail;
+  if (const auto* event = std::get_if<Event>(&task)) {
+    name = "Event";
+    detail = event->DebugString();
+  } else if (std::holds_alternative<TaskClosure>(task)) {
+    name = "Task";
+  }
+  HandleTask(std::move(component), task);
+  tracer_->Add(name, start, animation::Clock::now(), std::move(detail));
+}
+
+// private
+// Estimate when the terminal will have drained the frame just written.
+void ScreenInteractive::MeasureOutput(size_t bytes,
+                                      animation::TimePoint write_start) {
+  const auto now = animation::Clock::now();
+
+  // A write blocks once the terminal output buffer is full. The time it takes
+  // then tells how fast the terminal drains it.
+  const float elapsed = std::chrono::duration<float>(now - write_start).count();
+  const float min_blocking_time = 0.001F;
+  if (elapsed > min_blocking_time) {
+    const float bandwidth = float(bytes) / elapsed;
+    measured_bandwidth_ = measured_bandwidth_ == 0.F
+                              ? bandwidth
+                              : 0.75F * measured_bandwidth_ + 0.25F * bandwidth;
+  }
+
+  float bandwidth = float(output_bandwidth_);
+  if (measured_bandwidth_ > 0.F &&
+      (bandwidth == 0.F || measured_bandwidth_ < bandwidth)) {
+    bandwidth = measured_bandwidth_;
+  }
+  if (bandwidth == 0.F) {
+    output_drained_time_ = now;
+    return;
+  }
+  output_drained_time_ =
+      now + std::chrono::duration_cast<animation::Clock::duration>(
+                std::chrono::duration<float>(float(bytes) / bandwidth));
 }
 
 // private
 void ScreenInteractive::ResetCursorPosition() {
-  std::cout << reset_cursor_position;
+  Write(output_fd_, reset_cursor_position);
   reset_cursor_position = "";
 }
 
@@ -966,8 +3193,14 @@ void ScreenInteractive::Exit() {
 
 // private:
 void ScreenInteractive::ExitNow() {
-  quit_ = true;
+  {
+    const std::lock_guard<std::mutex> lock(frame_mutex_);
+    quit_ = true;
+  }
+  frame_notifier_.notify_one();
+  io_watcher_->WakeUp();
   task_sender_.reset();
+  input_parser_.reset();
 }
 
 // private:
@@ -982,11 +3215,11 @@ void ScreenInteractive::Signal(int signal) {
   if (signal == SIGTSTP) {
     Post([&] {
       ResetCursorPosition();
-      std::cout << ResetPosition(/*clear*/ true);  // Cursor to the beginning
+      Write(output_fd_, ResetPosition(/*clear*/ true));  // Cursor to beginning
       Uninstall();
       dimx_ = 0;
       dimy_ = 0;
-      Flush();
+      Flush(output_fd_);
       std::ignore = std::raise(SIGTSTP);
       Install();
     });
@@ -2,13 +2,31 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 #include <gtest/gtest.h>  // for Test, TestInfo (ptr only), TEST, EXPECT_EQ, Message, TestPartResult
+#include <chrono>   // for steady_clock, milliseconds
 #include <csignal>  // for raise, SIGABRT, SIGFPE, SIGILL, SIGINT, SIGSEGV, SIGTERM
 #include <ftxui/component/event.hpp>  // for Event, Event::Custom
+#include <memory>                     // for make_shared
+#include <sstream>                    // for stringstream
+#include <string>                     // for string
+#include <thread>                     // for this_thread, sleep_for
 #include <tuple>                      // for _Swallow_assign, ignore
+#include <vector>                     // for vector
 
-#include "ftxui/component/component.hpp"  // for Renderer
+#include "ftxui/component/animation.hpp"  // for Animator, Params
+#include "ftxui/component/component.hpp"  // for Renderer, Memo, Container
+#include "ftxui/component/frame_stats.hpp"  // for FrameStats, FrameStatsElement
+#include "ftxui/component/loop.hpp"       // for Loop
+#include "ftxui/component/mouse.hpp"      // for Mouse, Mouse::Moved
 #include "ftxui/component/screen_interactive.hpp"
-#include "ftxui/dom/elements.hpp"  // for text, Element
+#include "ftxui/component/trace.hpp"  // for TraceSpan
+#include "ftxui/dom/elements.hpp"  // for text, hbox, live, Element
+#include "ftxui/screen/allocations.hpp"  // for AllocationCountingEnabled
+#include "ftxui/screen/cell_buffer.hpp"  // for CellBuffer
+#include "ftxui/screen/terminal.hpp"     // for RepeatSupport, ColorSupport
+
+#if !defined(_WIN32)
+#include <unistd.h>  // for pipe, read, write, close
+#endif
 
 namespace ftxui {
 
@@ -29,6 +47,53 @@ bool TestSignal(int signal) {
   EXPECT_EQ(called, 2);
   return true;
 }
+
+Event MouseMove(int x, int y) {
+  Mouse mouse;
+  mouse.button = Mouse::None;
+  mouse.motion = Mouse::Moved;
+  mouse.x = x;
+  mouse.y = y;
+  return Event::Mouse("", mouse);
+}
+
+// Count the animation frames it receives.
+class Counter : public ComponentBase {
+ public:
+  Element Render() override { return text(""); }
+  void OnAnimation(animation::Params& /*params*/) override { frames++; }
+  int frames = 0;
+};
+
+// Animate a value from 0 to 1, then call |on_done|.
+class Animated : public ComponentBase {
+ public:
+  explicit Animated(Closure on_done) : on_done_(std::move(on_done)) {}
+  Element Render() override {
+    renders++;
+    // Start the animation, like Menu does when its targets change.
+    if (animator_.to() != 1.F) {
+      animator_ = animation::Animator(&value_, 1.F,
+                                      std::chrono::milliseconds(100));
+    }
+    return text("");
+  }
+  void OnAnimation(animation::Params& params) override {
+    frames++;
+    animator_.OnAnimation(params);
+    if (value_ == 1.F && on_done_) {
+      on_done_();
+      on_done_ = nullptr;
+    }
+  }
+  int frames = 0;
+  int renders = 0;
+
+ private:
+  float value_ = 0.F;
+  animation::Animator animator_{&value_, 0.F};
+  Closure on_done_;
+};
 }  // namespace
 
 TEST(ScreenInteractive, Signal_SIGTERM) {
@@ -131,4 +196,1080 @@ TEST(ScreenInteractive, CtrlC_NotForced) {
   ASSERT_GE(ctrl_c_count, 50);
 }
 
+TEST(ScreenInteractive, CoalesceEvents) {
+  auto screen = ScreenInteractive::FitComponent();
+  screen.CoalesceEvents();
+
+  bool posted = false;
+  auto component = Renderer([&] {
+    if (!posted) {
+      posted = true;
+      for (int i = 0; i < 10; ++i) {
+        screen.PostEvent(MouseMove(i, 0));
+      }
+      screen.PostEvent(Event::Character('a'));
+      screen.PostEvent(MouseMove(20, 0));
+      screen.PostEvent(MouseMove(21, 0));
+      screen.Post(screen.ExitLoopClosure());
+    }
+    return text("");
+  });
+
+  std::string received;
+  std::vector<int> mouse_x;
+  component |= CatchEvent([&](Event event) {
+    if (event.is_mouse()) {
+      received += "m";
+      mouse_x.push_back(event.mouse().x);
+    } else if (event.is_character()) {
+      received += event.character();
+    }
+    return false;
+  });
+  screen.Loop(component);
+
+  // Only the last mouse move of each series is delivered.
+  EXPECT_EQ(received, "mam");
+  ASSERT_EQ(mouse_x.size(), 2u);
+  EXPECT_EQ(mouse_x[1] - mouse_x[0], 21 - 9);
+}
+
+TEST(ScreenInteractive, LazyRedraw) {
+  auto screen = ScreenInteractive::FixedSize(20, 3);
+  screen.LazyRedraw();
+
+  int draw_count = 0;
+  auto component = Renderer([&] {
+    draw_count++;
+    return text("hello");
+  });
+  component |= CatchEvent([&](Event event) {
+    if (event == Event::Character('b')) {
+      screen.RequestRedraw();
+    }
+    return event == Event::Character('a');
+  });
+
+  Loop loop(&screen, component);
+  loop.RunOnce();
+  ASSERT_EQ(draw_count, 1);
+  auto step = [&](Event event) {
+    screen.PostEvent(event);
+    loop.RunOnce();
+    return draw_count;
+  };
+
+  // The events not handled aren't drawn.
+  EXPECT_EQ(step(MouseMove(2, 1)), 1);
+  EXPECT_EQ(step(Event::Character('z')), 1);
+  // Unless they ask for it.
+  EXPECT_EQ(step(Event::Character('a')), 2);
+  EXPECT_EQ(step(Event::Character('b')), 3);
+  EXPECT_EQ(step(Event::Custom), 4);
+}
+
+TEST(ScreenInteractive, LazyRedrawHover) {
+  auto screen = ScreenInteractive::FixedSize(20, 3);
+  screen.LazyRedraw();
+
+  int draw_count = 0;
+  bool hover = false;
+  auto hoverable = Hoverable(Renderer([&] {
+                               draw_count++;
+                               return text(hover ? "hover" : "-----");
+                             }),
+                             &hover);
+  auto component = Renderer(hoverable, [&] {
+    return hbox({hoverable->Render(), filler()});
+  });
+
+  Loop loop(&screen, component);
+  loop.RunOnce();
+  ASSERT_EQ(draw_count, 1);
+  auto step = [&](Event event) {
+    screen.PostEvent(event);
+    loop.RunOnce();
+    return draw_count;
+  };
+
+  // Only entering and leaving the component are drawn. The terminal coordinates
+  // start at 1.
+  EXPECT_EQ(step(MouseMove(15, 1)), 1);
+  EXPECT_EQ(step(MouseMove(2, 1)), 2);
+  EXPECT_EQ(step(MouseMove(3, 1)), 2);
+  EXPECT_EQ(step(MouseMove(15, 1)), 3);
+}
+
+TEST(ScreenInteractive, TaskLanes) {
+  auto screen = ScreenInteractive::FitComponent();
+
+  int renders = 0;
+  int closures = 0;
+  int closures_at_second_render = -1;
+  auto component = Renderer([&] {
+    renders++;
+    if (renders == 1) {
+      for (int i = 0; i < 1000; ++i) {
+        screen.Post([&] { closures++; });
+      }
+      screen.PostEvent(Event::Character('a'));
+      screen.Post(screen.ExitLoopClosure());
+    }
+    if (renders == 2) {
+      closures_at_second_render = closures;
+    }
+    return text("");
+  });
+
+  int closures_before_input = -1;
+  component |= CatchEvent([&](Event event) {
+    if (event == Event::Character('a')) {
+      closures_before_input = closures;
+    }
+    return false;
+  });
+  screen.Loop(component);
+
+  // The input is handled first, and drawn after a single slice of closures.
+  EXPECT_EQ(closures_before_input, 0);
+  EXPECT_GT(closures_at_second_render, 0);
+  EXPECT_LT(closures_at_second_render, 1000);
+  EXPECT_EQ(closures, 1000);
+}
+
+TEST(ScreenInteractive, AbandonStaleFrames) {
+  auto screen = ScreenInteractive::FitComponent();
+  screen.AbandonStaleFrames();
+
+  // Every render receives an event, until the 6th.
+  int renders = 0;
+  auto component = Renderer([&] {
+    renders++;
+    if (renders <= 5) {
+      screen.PostEvent(Event::Custom);
+    } else {
+      screen.Post(screen.ExitLoopClosure());
+    }
+    return text("hello");
+  });
+  screen.Loop(component);
+
+  // At most 3 frames are abandoned in a row. The 4th and the 6th are drawn.
+  const FrameStats stats = screen.Stats();
+  EXPECT_EQ(renders, 6);
+  EXPECT_EQ(stats.frames_abandoned, 4u);
+  EXPECT_EQ(stats.frames, 2u);
+}
+
+TEST(ScreenInteractive, PostIdle) {
+  auto screen = ScreenInteractive::FitComponent();
+
+  std::string order;
+  bool posted = false;
+  auto component = Renderer([&] {
+    if (!posted) {
+      posted = true;
+      screen.PostIdle([&](animation::TimePoint deadline) {
+        EXPECT_GT(deadline, animation::Clock::now());
+        order += "i";
+        if (order.size() < 4) {
+          return true;
+        }
+        screen.Post(screen.ExitLoopClosure());
+        return false;
+      });
+      screen.Post([&] { order += "p"; });
+    }
+    return text("");
+  });
+  screen.Loop(component);
+
+  // The idle task runs once the task posted after it was handled.
+  EXPECT_EQ(order, "piii");
+}
+
+TEST(ScreenInteractive, RoutedEvents) {
+  auto screen = ScreenInteractive::FixedSize(10, 20);
+  screen.RoutedEvents();
+
+  std::vector<int> received(20, 0);
+  auto container = Container::Vertical({});
+  for (int i = 0; i < 20; ++i) {
+    container->Add(Renderer([] { return text("row"); }) |
+                   CatchEvent([&received, i](Event event) {
+                     received[i] += event.is_mouse();
+                     return false;
+                   }));
+  }
+
+  // The children boxes are known starting from the frame following the first
+  // routed event.
+  int frame = 0;
+  auto component = Renderer(container, [&] {
+    if (frame == 0) {
+      screen.PostEvent(MouseMove(1, 6));
+    }
+    if (frame == 1) {
+      // The terminal coordinates start at 1.
+      screen.PostEvent(MouseMove(1, 8));
+      screen.PostEvent(MouseMove(1, 10));
+      screen.Post(screen.ExitLoopClosure());
+    }
+    frame++;
+    return container->Render();
+  });
+  screen.Loop(component);
+
+  // The first event is offered to every child. The next ones only to the child
+  // under the mouse, and to the one the mouse left.
+  std::vector<int> expected(20, 1);
+  expected[7] = 3;
+  expected[9] = 2;
+  EXPECT_EQ(received, expected);
+}
+
+TEST(ScreenInteractive, PostKeyed) {
+  auto screen = ScreenInteractive::FitComponent();
+
+  const size_t gauge_key = 1;
+  int executed = 0;
+  int gauge = 0;
+  int draw_count = 0;
+  int draw_count_at_update = 0;
+  auto component = Renderer([&] {
+    draw_count++;
+    if (draw_count == 1) {
+      for (int i = 1; i <= 1000; ++i) {
+        screen.Post(gauge_key, [&, i] {
+          executed++;
+          gauge = i;
+          draw_count_at_update = draw_count;
+        });
+      }
+      screen.Post(screen.ExitLoopClosure());
+    }
+    return text("");
+  });
+  screen.Loop(component);
+
+  // The 1000 updates collapsed into a single one.
+  EXPECT_EQ(executed, 1);
+  EXPECT_EQ(gauge, 1000);
+  EXPECT_EQ(draw_count_at_update, 1);
+}
+
+TEST(ScreenInteractive, MaxFrameRate) {
+  auto screen = ScreenInteractive::FitComponent();
+  screen.MaxFrameRate(10);
+
+  int draw_count = 0;
+  const auto start = std::chrono::steady_clock::now();
+  auto component = Renderer([&] {
+    draw_count++;
+    if (std::chrono::steady_clock::now() - start <
+        std::chrono::milliseconds(250)) {
+      screen.PostEvent(Event::Custom);
+    } else {
+      screen.Exit();
+    }
+    return text("");
+  });
+  screen.Loop(component);
+
+  // Every event invalidates the frame, but at most one frame is drawn every
+  // 100ms.
+  EXPECT_GE(draw_count, 2);
+  EXPECT_LE(draw_count, 5);
+}
+
+TEST(ScreenInteractive, OutputBandwidth) {
+  auto screen = ScreenInteractive::FitComponent();
+  screen.OutputBandwidth(500);
+
+  int draw_count = 0;
+  const auto start = std::chrono::steady_clock::now();
+  auto component = Renderer([&] {
+    draw_count++;
+    if (std::chrono::steady_clock::now() - start <
+        std::chrono::milliseconds(250)) {
+      screen.PostEvent(Event::Custom);
+    } else {
+      screen.Exit();
+    }
+    return text(std::string(80, 'x'));
+  });
+  screen.Loop(component);
+
+  // Every frame is more than 80 bytes, which takes more than 160ms to drain.
+  EXPECT_GE(draw_count, 2);
+  EXPECT_LE(draw_count, 3);
+}
+
+TEST(ScreenInteractive, Stats) {
+  auto screen = ScreenInteractive::FitComponent();
+
+  int draw_count = 0;
+  auto component = Renderer([&] {
+    draw_count++;
+    if (draw_count == 1) {
+      screen.PostEvent(Event::Custom);
+    } else {
+      screen.Post(screen.ExitLoopClosure());
+    }
+    return text("hello");
+  });
+  screen.Loop(component);
+
+  const FrameStats stats = screen.Stats();
+  EXPECT_EQ(stats.frames, 2u);
+  EXPECT_GT(stats.bytes_last, 0u);
+  EXPECT_GT(stats.bytes_total, stats.bytes_last);
+  EXPECT_GT(stats.total.last, 0.0);
+  EXPECT_GE(stats.total.p99, stats.total.p50);
+  EXPECT_GE(stats.total.last, stats.component_render.last);
+
+  // The event posted was reflected by the second frame.
+  EXPECT_GT(stats.event_latency.last, 0.0);
+  size_t latencies = 0;
+  for (size_t count : stats.event_latency_histogram) {
+    latencies += count;
+  }
+  EXPECT_EQ(latencies, 1u);
+
+  if (AllocationCountingEnabled()) {
+    EXPECT_GT(stats.allocations.component_render.count, 0u);
+    EXPECT_GE(stats.allocations.total.count,
+              stats.allocations.component_render.count +
+                  stats.allocations.render.count);
+  }
+
+  Screen overlay(40, 14);
+  Render(overlay, FrameStatsElement(stats));
+  EXPECT_NE(overlay.ToString().find("Frame 2"), std::string::npos);
+  EXPECT_NE(overlay.ToString().find("latency"), std::string::npos);
+}
+
+TEST(ScreenInteractive, MemoryBudget) {
+  auto screen = ScreenInteractive::FitComponent();
+  screen.MemoryBudget(1, std::chrono::milliseconds(10));
+
+  int draw_count = 0;
+  size_t peak = 0;
+  auto component = Renderer([&] {
+    draw_count++;
+    if (draw_count == 1) {
+      screen.PostEvent(Event::Custom);
+      Elements lines;
+      for (int i = 0; i < 20; ++i) {
+        lines.push_back(text(std::string(70, 'x')));
+      }
+      return vbox(std::move(lines));
+    }
+    if (draw_count == 2) {
+      // Still holding the storage of the first frame.
+      peak = screen.MemoryUsage();
+      screen.PostDelayed(std::chrono::milliseconds(100),
+                         screen.ExitLoopClosure());
+    }
+    return text("hello");
+  });
+  screen.Loop(component);
+
+  // Trimmed once idle, down to what the last frame needs.
+  EXPECT_EQ(draw_count, 2);
+  EXPECT_LT(screen.MemoryUsage(), peak / 10);
+}
+
+TEST(ScreenInteractive, RecordTrace) {
+  auto screen = ScreenInteractive::FitComponent();
+  screen.RecordTrace(64);
+
+  int draw_count = 0;
+  auto component = Renderer([&] {
+    TraceSpan span("Custom");
+    draw_count++;
+    if (draw_count == 1) {
+      screen.PostEvent(Event::Character('"'));
+    } else {
+      screen.Post(screen.ExitLoopClosure());
+    }
+    return text("hello");
+  });
+  screen.Loop(component);
+
+  std::stringstream trace;
+  screen.WriteTrace(trace);
+  const std::string json = trace.str();
+  EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u);
+  for (const char* name : {"Draw", "Component::Render", "Layout",
+                           "Node::Render", "Serialize", "Write", "Event",
+                           "Task", "Custom"}) {
+    EXPECT_NE(json.find(std::string("\"name\":\"") + name + "\""),
+              std::string::npos)
+        << name;
+  }
+  // The event is escaped.
+  EXPECT_NE(json.find(R"x("detail":"Event::Character(\"\"\")")x"),
+            std::string::npos);
+}
+
+TEST(ScreenInteractive, PostDelayed) {
+  auto screen = ScreenInteractive::FitComponent();
+
+  const auto start = std::chrono::steady_clock::now();
+  std::chrono::steady_clock::duration elapsed{};
+  screen.PostDelayed(std::chrono::milliseconds(50), [&] {
+    elapsed = std::chrono::steady_clock::now() - start;
+    screen.Exit();
+  });
+  auto component = Renderer([] { return text(""); });
+  screen.Loop(component);
+
+  EXPECT_GE(elapsed, std::chrono::milliseconds(50));
+}
+
+TEST(ScreenInteractive, PostPeriodic) {
+  auto screen = ScreenInteractive::FitComponent();
+
+  int fired = 0;
+  size_t timer = 0;
+  timer = screen.PostPeriodic(std::chrono::milliseconds(10), [&] {
+    fired++;
+    if (fired == 3) {
+      screen.CancelTimer(timer);
+      screen.PostDelayed(std::chrono::milliseconds(50),
+                         screen.ExitLoopClosure());
+    }
+  });
+  auto component = Renderer([] { return text(""); });
+  screen.Loop(component);
+
+  EXPECT_EQ(fired, 3);
+}
+
+#if !defined(_WIN32)
+TEST(ScreenInteractive, RunInBackground) {
+  auto screen = ScreenInteractive::FitComponent();
+  const auto ui_thread = std::this_thread::get_id();
+  std::thread::id fn_thread;
+  std::thread::id on_done_thread;
+
+  bool started = false;
+  auto component = Renderer([&] {
+    if (!started) {
+      started = true;
+      screen.RunInBackground(
+          [&] { fn_thread = std::this_thread::get_id(); },
+          [&] {
+            on_done_thread = std::this_thread::get_id();
+            screen.Exit();
+          });
+    }
+    return text("");
+  });
+  screen.Loop(component);
+
+  EXPECT_NE(fn_thread, std::thread::id());
+  EXPECT_EQ(on_done_thread, ui_thread);
+}
+
+TEST(ScreenInteractive, WatchFd) {
+  auto screen = ScreenInteractive::FitComponent();
+
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+
+  std::string received;
+  int draw_count = 0;
+  int draw_count_at_read = 0;
+  screen.WatchFd(fds[0], [&] {
+    char buffer[16];
+    const ssize_t n = read(fds[0], buffer, sizeof(buffer));
+    received.append(buffer, n > 0 ? size_t(n) : 0);
+    draw_count_at_read = draw_count;
+    if (received == "hello") {
+      screen.UnwatchFd(fds[0]);
+      screen.Exit();
+    }
+  });
+
+  auto component = Renderer([&] {
+    draw_count++;
+    if (draw_count == 1) {
+      std::ignore = write(fds[1], "hello", 5);
+    }
+    return text("");
+  });
+  screen.Loop(component);
+
+  // The data was read on the UI thread, after the first frame.
+  EXPECT_EQ(received, "hello");
+  EXPECT_EQ(draw_count_at_read, 1);
+
+  close(fds[0]);
+  close(fds[1]);
+}
+
+TEST(ScreenInteractive, OutputFd) {
+  auto screen = ScreenInteractive::FitComponent();
+
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  screen.OutputFd(fds[1]);
+
+  auto component = Renderer([&] {
+    screen.Post(screen.ExitLoopClosure());
+    return text("hello");
+  });
+  screen.Loop(component);
+  close(fds[1]);
+
+  std::string output;
+  char buffer[256];
+  ssize_t n = 0;
+  while ((n = read(fds[0], buffer, sizeof(buffer))) > 0) {
+    output.append(buffer, size_t(n));
+  }
+  close(fds[0]);
+
+  // The frame, and the terminal configuration, went to the pipe.
+  EXPECT_NE(output.find("hello"), std::string::npos);
+  EXPECT_NE(output.find("\x1B[?7l"), std::string::npos);
+}
+
+TEST(ScreenInteractive, CursorPositionQueriedOnce) {
+  auto screen = ScreenInteractive::FitComponent();
+
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  screen.OutputFd(fds[1]);
+
+  int draw_count = 0;
+  screen.Loop(Renderer([&] {
+    Element element = text("frame " + std::to_string(draw_count));
+    draw_count++;
+    if (draw_count < 50) {
+      screen.PostEvent(Event::Custom);
+    } else {
+      screen.Post(screen.ExitLoopClosure());
+    }
+    return element;
+  }));
+  close(fds[1]);
+
+  std::string output;
+  char buffer[256];
+  ssize_t n = 0;
+  while ((n = read(fds[0], buffer, sizeof(buffer))) > 0) {
+    output.append(buffer, size_t(n));
+  }
+  close(fds[0]);
+
+  // The position of the frame is followed, instead of being asked again.
+  size_t queries = 0;
+  for (size_t i = output.find("\x1B[6n"); i != std::string::npos;
+       i = output.find("\x1B[6n", i + 1)) {
+    queries++;
+  }
+  EXPECT_EQ(draw_count, 50);
+  EXPECT_EQ(queries, 1u);
+}
+
+TEST(ScreenInteractive, PrintAbove) {
+  auto screen = ScreenInteractive::TerminalOutput();
+
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  screen.OutputFd(fds[1]);
+
+  int draw_count = 0;
+  screen.Loop(Renderer([&] {
+    if (draw_count < 5) {
+      screen.PrintAbove(text("log " + std::to_string(draw_count)));
+    } else {
+      screen.Post(screen.ExitLoopClosure());
+    }
+    draw_count++;
+    return text("progress");
+  }));
+  close(fds[1]);
+
+  std::string output;
+  char buffer[256];
+  ssize_t n = 0;
+  while ((n = read(fds[0], buffer, sizeof(buffer))) > 0) {
+    output.append(buffer, size_t(n));
+  }
+  close(fds[0]);
+
+  auto count = [&](const std::string& needle) {
+    size_t found = 0;
+    for (size_t i = output.find(needle); i != std::string::npos;
+         i = output.find(needle, i + 1)) {
+      found++;
+    }
+    return found;
+  };
+  // Each element is printed once, and the frame below it each time.
+  EXPECT_EQ(draw_count, 6);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(count("log " + std::to_string(i)), 1u);
+  }
+  EXPECT_LT(output.find("log 0"), output.find("log 1"));
+  EXPECT_LT(output.rfind("log 4"), output.rfind("progress"));
+}
+
+TEST(ScreenInteractive, TerminalOutputTallerThanTerminal) {
+  auto screen = ScreenInteractive::TerminalOutput();
+
+  int input[2];
+  int output[2];
+  ASSERT_EQ(pipe(input), 0);
+  ASSERT_EQ(pipe(output), 0);
+  screen.InputFd(input[0]);
+  screen.OutputFd(output[1]);
+  screen.SetTerminalSize({10, 3});
+
+  screen.Loop(Renderer([&] {
+    screen.Post(screen.ExitLoopClosure());
+    Elements rows;
+    for (int i = 0; i < 10; ++i) {
+      rows.push_back(text("row" + std::to_string(i)));
+    }
+    return vbox(std::move(rows));
+  }));
+  close(output[1]);
+
+  std::string written;
+  char buffer[256];
+  ssize_t n = 0;
+  while ((n = read(output[0], buffer, sizeof(buffer))) > 0) {
+    written.append(buffer, size_t(n));
+  }
+  close(output[0]);
+  close(input[0]);
+  close(input[1]);
+
+  // Only the last rows fitting in the terminal are drawn.
+  for (int i = 0; i < 10; ++i) {
+    const bool drawn =
+        written.find("row" + std::to_string(i)) != std::string::npos;
+    EXPECT_EQ(drawn, i >= 7) << i;
+  }
+}
+
+TEST(ScreenInteractive, Nested) {
+  auto parent = ScreenInteractive::FitComponent();
+  auto child = ScreenInteractive::FitComponent();
+
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  parent.OutputFd(fds[1]);
+  child.OutputFd(fds[1]);
+
+  auto child_component = Renderer([&] {
+    child.Post(child.ExitLoopClosure());
+    return text("child");
+  });
+  int parent_draws = 0;
+  auto parent_component = Renderer([&] {
+    if (parent_draws++ == 0) {
+      parent.Post([&] { child.Loop(child_component); });
+    } else {
+      parent.Post(parent.ExitLoopClosure());
+    }
+    return text("parent");
+  });
+  parent.Loop(parent_component);
+  close(fds[1]);
+
+  std::string output;
+  char buffer[256];
+  ssize_t n = 0;
+  while ((n = read(fds[0], buffer, sizeof(buffer))) > 0) {
+    output.append(buffer, size_t(n));
+  }
+  close(fds[0]);
+
+  // Both screens were drawn, then the parent again.
+  const size_t child_frame = output.find("child");
+  ASSERT_NE(child_frame, std::string::npos);
+  EXPECT_LT(output.find("parent"), child_frame);
+  EXPECT_NE(output.find("parent", child_frame), std::string::npos);
+
+  // The terminal was configured once, and restored once.
+  auto count = [&](const std::string& sequence) {
+    int found = 0;
+    for (size_t i = output.find(sequence); i != std::string::npos;
+         i = output.find(sequence, i + 1)) {
+      found++;
+    }
+    return found;
+  };
+  EXPECT_EQ(count("\x1B[?7l"), 1);
+  EXPECT_EQ(count("\x1B[?7h"), 1);
+}
+
+TEST(ScreenInteractive, Sessions) {
+  // Two sessions, each reading and writing its own pipes, on its own thread.
+  struct Session {
+    int input[2];
+    int output[2];
+    std::string typed;
+    Dimensions size{0, 0};
+    bool active = false;
+  };
+  Session sessions[2];
+  for (auto& session : sessions) {
+    ASSERT_EQ(pipe(session.input), 0);
+    ASSERT_EQ(pipe(session.output), 0);
+  }
+
+  auto run = [](Session* session, bool single_threaded) {
+    auto screen = ScreenInteractive::FitComponent();
+    screen.InputFd(session->input[0]);
+    screen.OutputFd(session->output[1]);
+    screen.SingleThreaded(single_threaded);
+    screen.SetTerminalSize({7, 3});
+
+    auto component = Renderer([&] {
+      session->active = ScreenInteractive::Active() == &screen;
+      session->size = screen.TerminalSize();
+      return text("session");
+    });
+    component |= CatchEvent([&](Event event) {
+      if (event.is_character()) {
+        session->typed += event.character();
+        if (session->typed.size() == 2) {
+          screen.Exit();
+        }
+      }
+      return false;
+    });
+    screen.Loop(component);
+  };
+  std::thread first(run, &sessions[0], false);
+  std::thread second(run, &sessions[1], true);
+  std::ignore = write(sessions[0].input[1], "ab", 2);
+  std::ignore = write(sessions[1].input[1], "cd", 2);
+  first.join();
+  second.join();
+
+  EXPECT_EQ(sessions[0].typed, "ab");
+  EXPECT_EQ(sessions[1].typed, "cd");
+  for (auto& session : sessions) {
+    EXPECT_TRUE(session.active);
+    EXPECT_EQ(session.size.dimx, 7);
+    EXPECT_EQ(session.size.dimy, 3);
+
+    close(session.output[1]);
+    std::string output;
+    char buffer[256];
+    ssize_t n = 0;
+    while ((n = read(session.output[0], buffer, sizeof(buffer))) > 0) {
+      output.append(buffer, size_t(n));
+    }
+    EXPECT_NE(output.find("session"), std::string::npos);
+    EXPECT_NE(output.find("\x1B[?7l"), std::string::npos);
+    close(session.output[0]);
+    close(session.input[0]);
+    close(session.input[1]);
+  }
+
+  // No session is left active.
+  EXPECT_EQ(ScreenInteractive::Active(), nullptr);
+}
+
+TEST(ScreenInteractive, SynchronizedOutput) {
+  auto screen = ScreenInteractive::FitComponent();
+  screen.SynchronizedOutput();
+
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  screen.OutputFd(fds[1]);
+
+  int draw_count = 0;
+  auto component = Renderer([&] {
+    draw_count++;
+    if (draw_count == 1) {
+      // The terminal answers the query.
+      screen.PostEvent(Event::ModeReport("\x1B[?2026;2$y", 2026, 2));
+      screen.PostEvent(Event::Custom);
+    } else {
+      screen.Post(screen.ExitLoopClosure());
+    }
+    return text("hello");
+  });
+  screen.Loop(component);
+  close(fds[1]);
+
+  std::string output;
+  char buffer[256];
+  ssize_t n = 0;
+  while ((n = read(fds[0], buffer, sizeof(buffer))) > 0) {
+    output.append(buffer, size_t(n));
+  }
+  close(fds[0]);
+
+  // The support was queried. The first frame was drawn before the answer.
+  const size_t query = output.find("\x1B[?2026$p");
+  const size_t first_frame = output.find("hello");
+  const size_t begin = output.find("\x1B[?2026h");
+  const size_t second_frame = output.find("hello", first_frame + 1);
+  const size_t end = output.find("\x1B[?2026l");
+  ASSERT_NE(query, std::string::npos);
+  ASSERT_NE(second_frame, std::string::npos);
+  EXPECT_LT(query, first_frame);
+  EXPECT_LT(first_frame, begin);
+  EXPECT_LT(begin, second_frame);
+  EXPECT_LT(second_frame, end);
+  EXPECT_NE(end, std::string::npos);
+}
+
+TEST(ScreenInteractive, ProbeTerminal) {
+  const bool repeat = Terminal::RepeatSupport();
+  const Terminal::Color color = Terminal::ColorSupport();
+  const Terminal::Graphics graphics = Terminal::GraphicsSupport();
+  Terminal::SetRepeatSupport(false);
+  Terminal::SetColorSupport(Terminal::Color::Palette256);
+  Terminal::SetGraphicsSupport(Terminal::Graphics::None);
+
+  auto screen = ScreenInteractive::FitComponent();
+  screen.SynchronizedOutput();
+  screen.ProbeTerminal();
+
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  screen.OutputFd(fds[1]);
+
+  int draw_count = 0;
+  auto component = Renderer([&] {
+    draw_count++;
+    if (draw_count == 1) {
+      // Nothing is known before the terminal answers.
+      EXPECT_FALSE(Terminal::RepeatSupport());
+      screen.PostEvent(Event::ModeReport("\x1B[?2026;2$y", 2026, 2));
+      screen.PostEvent(Event::TerminalVersion("\x1BP>|kitty(0.35.2)\x1B\\"));
+      screen.PostEvent(Event::DeviceAttributes("\x1B[?62;22c", 1, 62, 0,
+                                               uint64_t(1) << 22));
+    } else {
+      // The answers are applied, and the frame is drawn again.
+      screen.Post(screen.ExitLoopClosure());
+    }
+    return text("hello");
+  });
+  screen.Loop(component);
+  close(fds[1]);
+
+  std::string output;
+  char buffer[256];
+  ssize_t n = 0;
+  while ((n = read(fds[0], buffer, sizeof(buffer))) > 0) {
+    output.append(buffer, size_t(n));
+  }
+  close(fds[0]);
+
+  // The synchronized output is queried once, with the other capabilities.
+  const size_t query = output.find("\x1B[?2026$p\x1B[>0q\x1B[>c\x1B[c");
+  EXPECT_NE(query, std::string::npos);
+  EXPECT_EQ(output.find("\x1B[?2026$p", query + 1), std::string::npos);
+  EXPECT_NE(output.find("\x1B[?2026h"), std::string::npos);
+  EXPECT_EQ(draw_count, 2);
+
+  EXPECT_TRUE(Terminal::RepeatSupport());
+  EXPECT_EQ(Terminal::ColorSupport(), Terminal::Color::TrueColor);
+  EXPECT_EQ(Terminal::GraphicsSupport(), Terminal::Graphics::Kitty);
+
+  Terminal::SetRepeatSupport(repeat);
+  Terminal::SetColorSupport(color);
+  Terminal::SetGraphicsSupport(graphics);
+}
+
+TEST(ScreenInteractive, CellOutput) {
+  auto screen = ScreenInteractive::FitComponent();
+
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  screen.OutputFd(fds[1]);
+
+  std::string label = "hello";
+  std::vector<std::vector<uint32_t>> updates;
+  std::string first_row;
+  screen.CellOutput([&](const CellBuffer& cells) {
+    updates.push_back(cells.updates());
+    if (updates.size() == 1) {
+      for (int x = 0; x < cells.dimx(); ++x) {
+        first_row += char(cells.cell(uint32_t(x))[CellBuffer::kGlyph]);
+      }
+      label = "hallo";
+      screen.PostEvent(Event::Custom);
+    } else {
+      screen.Post(screen.ExitLoopClosure());
+    }
+  });
+  screen.Loop(Renderer([&] { return text(label); }));
+  close(fds[1]);
+
+  std::string output;
+  char buffer[256];
+  ssize_t n = 0;
+  while ((n = read(fds[0], buffer, sizeof(buffer))) > 0) {
+    output.append(buffer, size_t(n));
+  }
+  close(fds[0]);
+
+  // The frames are only published as cells.
+  EXPECT_EQ(output.find("hello"), std::string::npos);
+  EXPECT_EQ(first_row, "hello");
+  ASSERT_EQ(updates.size(), 2u);
+  EXPECT_EQ(updates[0].size(), 5u);
+  EXPECT_EQ(updates[1], std::vector<uint32_t>{1});
+}
+
+TEST(ScreenInteractive, LiveCell) {
+  auto screen = ScreenInteractive::FitComponent();
+
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  screen.OutputFd(fds[1]);
+
+  auto cell = std::make_shared<LiveCell>(4);
+  cell->Set("0");
+  int draw_count = 0;
+  auto component = Renderer([&] {
+    draw_count++;
+    screen.Post([&] {
+      // Another thread could do the same.
+      cell->Set("1234");
+      screen.Post(screen.ExitLoopClosure());
+    });
+    return hbox({text("hello "), live(cell)});
+  });
+  screen.Loop(component);
+  close(fds[1]);
+
+  std::string output;
+  char buffer[256];
+  ssize_t n = 0;
+  while ((n = read(fds[0], buffer, sizeof(buffer))) > 0) {
+    output.append(buffer, size_t(n));
+  }
+  close(fds[0]);
+
+  // The update was written over the frame, without drawing it again.
+  EXPECT_EQ(draw_count, 1);
+  const size_t frame = output.find("hello 0");
+  const size_t patch = output.find("1234");
+  ASSERT_NE(frame, std::string::npos);
+  ASSERT_NE(patch, std::string::npos);
+  EXPECT_LT(frame, patch);
+  EXPECT_EQ(output.find("hello", frame + 1), std::string::npos);
+}
+#endif
+
+TEST(ScreenInteractive, SingleThreaded) {
+  auto screen = ScreenInteractive::FitComponent();
+  screen.SingleThreaded();
+
+  const auto main_thread = std::this_thread::get_id();
+  bool same_thread = true;
+  int draw_count = 0;
+  auto component = Renderer([&] {
+    same_thread &= std::this_thread::get_id() == main_thread;
+    draw_count++;
+    if (draw_count == 1) {
+      screen.PostEvent(Event::Custom);
+      screen.PostDelayed(std::chrono::milliseconds(30), [&] {
+        same_thread &= std::this_thread::get_id() == main_thread;
+        screen.Exit();
+      });
+    }
+    return text("");
+  });
+  screen.Loop(component);
+
+  EXPECT_TRUE(same_thread);
+  EXPECT_GE(draw_count, 2);
+}
+
+#if !defined(_WIN32)
+TEST(ScreenInteractive, TerminalSize) {
+  auto screen = ScreenInteractive::FitComponent();
+  const Dimensions fallback = Terminal::Size();
+
+  auto component = Renderer([&] {
+    const Dimensions initial = screen.TerminalSize();
+
+    // Not queried again, until the terminal is resized.
+    Terminal::SetFallbackSize({fallback.dimx + 1, fallback.dimy + 1});
+    EXPECT_EQ(screen.TerminalSize().dimx, initial.dimx);
+    EXPECT_EQ(screen.TerminalSize().dimy, initial.dimy);
+
+    std::ignore = std::raise(SIGWINCH);
+    EXPECT_EQ(screen.TerminalSize().dimx, Terminal::Size().dimx);
+    EXPECT_EQ(screen.TerminalSize().dimy, Terminal::Size().dimy);
+
+    screen.Exit();
+    return text("");
+  });
+  screen.Loop(component);
+  Terminal::SetFallbackSize(fallback);
+}
+#endif
+
+TEST(ScreenInteractive, SingleThreadedCustomLoop) {
+  auto screen = ScreenInteractive::FitComponent();
+  screen.SingleThreaded();
+  screen.PostDelayed(std::chrono::milliseconds(50), screen.ExitLoopClosure());
+
+  auto component = Renderer([] { return text(""); });
+  Loop loop(&screen, component);
+  int iterations = 0;
+  while (!loop.HasQuitted()) {
+    const int timeout = loop.NextTimeout();
+    ASSERT_GE(timeout, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+    loop.RunOnce();
+    iterations++;
+  }
+
+  // The loop slept until the timer was due, instead of spinning.
+  EXPECT_LE(iterations, 10);
+}
+
+TEST(ScreenInteractive, AnimateRequestingComponentsOnly) {
+  auto screen = ScreenInteractive::FitComponent();
+
+  auto animated = Make<Animated>(screen.ExitLoopClosure());
+  Components children = {animated};
+  std::vector<std::shared_ptr<Counter>> counters;
+  for (int i = 0; i < 50; ++i) {
+    counters.push_back(Make<Counter>());
+    children.push_back(counters.back());
+  }
+  screen.Loop(Container::Vertical(children));
+
+  // The whole tree is walked once, when the animation starts. Then only the
+  // animated component receives the next frames.
+  EXPECT_GE(animated->frames, 3);
+  for (const auto& counter : counters) {
+    EXPECT_EQ(counter->frames, 1);
+  }
+}
+
+TEST(ScreenInteractive, AnimateThroughMemo) {
+  auto screen = ScreenInteractive::FitComponent();
+
+  auto animated = Make<Animated>(screen.ExitLoopClosure());
+  auto counter = Make<Counter>();
+  auto memo = Memo(animated, [] { return size_t(0); });
+  screen.Loop(Container::Vertical({memo, counter}));
+
+  // The memo is animated with its child, so that the child is rendered on
+  // every frame.
+  EXPECT_GE(animated->frames, 3);
+  EXPECT_GE(animated->renders, animated->frames);
+  EXPECT_EQ(counter->frames, 1);
+}
+
 }  // namespace ftxui
@@ -0,0 +1,312 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/component/session_recorder.hpp"
+
+#include <chrono>   // for duration_cast, microseconds
+#include <cstdint>  // for uint8_t, uint64_t
+#include <string>   // for string
+#include <utility>  // for move
+
+#include "ftxui/component/mouse.hpp"  // for Mouse
+
+namespace ftxui {
+
+namespace {
+
+const char kMagic[] = "FTXS";
+const uint64_t kVersion = 1;
+
+// The kinds of Event recorded, with the integers following their input.
+enum class EventKind : uint8_t {
+  kSpecial,           // none.
+  kCharacter,         // none.
+  kPaste,             // none.
+  kMouse,             // button, motion, shift, meta, control, x, y.
+  kCursorPosition,    // x, y.
+  kCursorShape,       // shape.
+  kModeReport,        // mode, value.
+  kDeviceAttributes,  // level, type, version, attributes.
+  kTerminalVersion,   // none.
+};
+
+// The strings longer than this are considered malformed, rather than
+// allocated.
+const uint64_t kMaxString = 1 << 24;
+const uint64_t kMaxDimension = 1 << 16;
+
+}  // namespace
+
+SessionRecorder::SessionRecorder(std::ostream* out)
+    : out_(out), last_time_(animation::Clock::now()) {
+  out_->write(kMagic, sizeof(kMagic) - 1);
+  WriteNumber(kVersion);
+}
+
+void SessionRecorder::AddEvent(Event event) {
+  Begin(SessionRecord::kEvent);
+  EventKind kind = EventKind::kSpecial;
+  if (event.is_character()) {
+    kind = EventKind::kCharacter;
+  } else if (event.is_paste()) {
+    kind = EventKind::kPaste;
+  } else if (event.is_mouse()) {
+    kind = EventKind::kMouse;
+  } else if (event.is_cursor_position()) {
+    kind = EventKind::kCursorPosition;
+  } else if (event.is_cursor_shape()) {
+    kind = EventKind::kCursorShape;
+  } else if (event.is_mode_report()) {
+    kind = EventKind::kModeReport;
+  } else if (event.is_device_attributes()) {
+    kind = EventKind::kDeviceAttributes;
+  } else if (event.is_terminal_version()) {
+    kind = EventKind::kTerminalVersion;
+  }
+  out_->put(char(kind));
+  WriteString(event.input());
+
+  switch (kind) {
+    case EventKind::kMouse: {
+      const Mouse& mouse = event.mouse();
+      WriteInt(mouse.button);
+      WriteInt(mouse.motion);
+      WriteInt(mouse.shift);
+      WriteInt(mouse.meta);
+      WriteInt(mouse.control);
+      WriteInt(mouse.x);
+      WriteInt(mouse.y);
+      break;
+    }
+    case EventKind::kCursorPosition:
+      WriteInt(event.cursor_x());
+      WriteInt(event.cursor_y());
+      break;
+    case EventKind::kCursorShape:
+      WriteInt(event.cursor_shape());
+      break;
+    case EventKind::kModeReport:
+      WriteInt(event.mode());
+      WriteInt(event.mode_value());
+      break;
+    case EventKind::kDeviceAttributes:
+      WriteInt(event.device_level());
+      WriteInt(event.device_type());
+      WriteInt(event.device_version());
+      WriteNumber(event.device_attributes());
+      break;
+    default:
+      break;
+  }
+}
+
+void SessionRecorder::AddTask() {
+  Begin(SessionRecord::kTask);
+}
+
+void SessionRecorder::AddAnimation() {
+  Begin(SessionRecord::kAnimation);
+}
+
+void SessionRecorder::AddFrame(int dimx, int dimy) {
+  if (dimx != dimx_ || dimy != dimy_) {
+    dimx_ = dimx;
+    dimy_ = dimy;
+    Begin(SessionRecord::kResize);
+    WriteNumber(uint64_t(dimx));
+    WriteNumber(uint64_t(dimy));
+  }
+  Begin(SessionRecord::kFrame);
+  // The session is readable up to the last frame, even if the program crashes.
+  out_->flush();
+}
+
+void SessionRecorder::Begin(SessionRecord type) {
+  const auto now = animation::Clock::now();
+  const auto delay =
+      std::chrono::duration_cast<std::chrono::microseconds>(now - last_time_);
+  last_time_ = now;
+  WriteNumber(uint64_t(delay.count()));
+  out_->put(char(type));
+}
+
+void SessionRecorder::WriteNumber(uint64_t value) {
+  while (value >= 0x80) {                    // NOLINT
+    out_->put(char((value & 0x7F) | 0x80));  // NOLINT
+    value >>= 7;                             // NOLINT
+  }
+  out_->put(char(value));
+}
+
+void SessionRecorder::WriteInt(int value) {
+  const auto wide = int64_t(value);
+  WriteNumber((uint64_t(wide) << 1) ^ uint64_t(wide >> 63));  // NOLINT
+}
+
+void SessionRecorder::WriteString(const std::string& value) {
+  WriteNumber(value.size());
+  out_->write(value.data(), std::streamsize(value.size()));
+}
+
+SessionReader::SessionReader(std::istream* in) : in_(in) {
+  char magic[sizeof(kMagic) - 1] = {};
+  uint64_t version = 0;
+  if (!in_->read(magic, sizeof(magic)) ||
+      std::string(magic, sizeof(magic)) != kMagic || !ReadNumber(&version) ||
+      version != kVersion) {
+    malformed_ = true;
+  }
+}
+
+bool SessionReader::Next(Record* record) {
+  if (malformed_ || in_->peek() == std::istream::traits_type::eof()) {
+    return false;
+  }
+
+  bool ok = ReadNumber(&record->delay);
+  const int type = ok ? in_->get() : -1;
+  record->type = SessionRecord(type);
+  switch (record->type) {
+    case SessionRecord::kEvent:
+      ok = ReadEvent(&record->event);
+      break;
+    case SessionRecord::kResize: {
+      uint64_t dimx = 0;
+      uint64_t dimy = 0;
+      ok = ReadNumber(&dimx) && ReadNumber(&dimy) && dimx <= kMaxDimension &&
+           dimy <= kMaxDimension;
+      record->dimx = int(dimx);
+      record->dimy = int(dimy);
+      break;
+    }
+    case SessionRecord::kTask:
+    case SessionRecord::kAnimation:
+    case SessionRecord::kFrame:
+      break;
+    default:
+      ok = false;
+      break;
+  }
+  malformed_ = !ok;
+  return ok;
+}
+
+bool SessionReader::ReadNumber(uint64_t* value) {
+  *value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {  // NOLINT
+    const int byte = in_->get();
+    if (byte < 0) {
+      return false;
+    }
+    *value |= uint64_t(byte & 0x7F) << shift;  // NOLINT
+    if ((byte & 0x80) == 0) {                  // NOLINT
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SessionReader::ReadInt(int* value) {
+  uint64_t number = 0;
+  if (!ReadNumber(&number)) {
+    return false;
+  }
+  *value = int(int64_t(number >> 1) ^ -int64_t(number & 1));  // NOLINT
+  return true;
+}
+
+bool SessionReader::ReadString(std::string* value) {
+  uint64_t size = 0;
+  if (!ReadNumber(&size) || size > kMaxString) {
+    return false;
+  }
+  value->resize(size);
+  return bool(in_->read(&(*value)[0], std::streamsize(size)));
+}
+
+bool SessionReader::ReadEvent(Event* event) {
+  const int kind = in_->get();
+  std::string input;
+  if (kind < 0 || !ReadString(&input)) {
+    return false;
+  }
+
+  switch (EventKind(kind)) {
+    case EventKind::kSpecial:
+      *event = Event::Special(std::move(input));
+      return true;
+    case EventKind::kCharacter:
+      *event = Event::Character(std::move(input));
+      return true;
+    case EventKind::kPaste:
+      *event = Event::Paste(std::move(input));
+      return true;
+    case EventKind::kMouse: {
+      int button = 0;
+      int motion = 0;
+      int shift = 0;
+      int meta = 0;
+      int control = 0;
+      Mouse mouse;
+      if (!ReadInt(&button) || !ReadInt(&motion) || !ReadInt(&shift) ||
+          !ReadInt(&meta) || !ReadInt(&control) || !ReadInt(&mouse.x) ||
+          !ReadInt(&mouse.y) || button < Mouse::Left ||
+          button > Mouse::WheelRight || motion < Mouse::Released ||
+          motion > Mouse::Moved) {
+        return false;
+      }
+      mouse.button = Mouse::Button(button);
+      mouse.motion = Mouse::Motion(motion);
+      mouse.shift = shift != 0;
+      mouse.meta = meta != 0;
+      mouse.control = control != 0;
+      *event = Event::Mouse(std::move(input), mouse);
+      return true;
+    }
+    case EventKind::kCursorPosition: {
+      int x = 0;
+      int y = 0;
+      if (!ReadInt(&x) || !ReadInt(&y)) {
+        return false;
+      }
+      *event = Event::CursorPosition(std::move(input), x, y);
+      return true;
+    }
+    case EventKind::kCursorShape: {
+      int shape = 0;
+      if (!ReadInt(&shape)) {
+        return false;
+      }
+      *event = Event::CursorShape(std::move(input), shape);
+      return true;
+    }
+    case EventKind::kModeReport: {
+      int mode = 0;
+      int value = 0;
+      if (!ReadInt(&mode) || !ReadInt(&value)) {
+        return false;
+      }
+      *event = Event::ModeReport(std::move(input), mode, value);
+      return true;
+    }
+    case EventKind::kDeviceAttributes: {
+      int level = 0;
+      int type = 0;
+      int version = 0;
+      uint64_t attributes = 0;
+      if (!ReadInt(&level) || !ReadInt(&type) || !ReadInt(&version) ||
+          !ReadNumber(&attributes)) {
+        return false;
+      }
+      *event = Event::DeviceAttributes(std::move(input), level, type, version,
+                                       attributes);
+      return true;
+    }
+    case EventKind::kTerminalVersion:
+      *event = Event::TerminalVersion(std::move(input));
+      return true;
+  }
+  return false;
+}
+
+}  // namespace ftxui
@@ -0,0 +1,92 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_SESSION_RECORDER_HPP
+#define FTXUI_COMPONENT_SESSION_RECORDER_HPP
+
+#include <cstdint>  // for uint8_t, uint64_t
+#include <istream>  // for istream
+#include <ostream>  // for ostream
+#include <string>   // for string
+
+#include "ftxui/component/animation.hpp"  // for TimePoint
+#include "ftxui/component/event.hpp"      // for Event
+
+namespace ftxui {
+
+// The sessions are recorded in a compact binary format:
+//
+//   session := "FTXS" version:varint record*
+//   record  := delay:varint type:u8 payload
+//
+// |delay| is the number of microseconds since the previous record. The
+// integers are LEB128 varints, the signed ones zigzag encoded. The strings are
+// a varint length, followed by their bytes. The payload depends on |type|:
+//
+//   kEvent      kind:u8 input:string int*  (the ints depend on |kind|)
+//   kResize     dimx:varint dimy:varint    (the size of the next frames)
+//   kTask       (a task posted to the loop was run)
+//   kAnimation  (the animations were run)
+//   kFrame      (a frame was drawn)
+enum class SessionRecord : uint8_t {
+  kEvent,
+  kResize,
+  kTask,
+  kAnimation,
+  kFrame,
+};
+
+// Append the records of a session to a stream, from the loop's thread.
+class SessionRecorder {
+ public:
+  explicit SessionRecorder(std::ostream* out);
+
+  void AddEvent(Event event);
+  void AddTask();
+  void AddAnimation();
+  // Preceded by a kResize record, when the size changed.
+  void AddFrame(int dimx, int dimy);
+
+ private:
+  void Begin(SessionRecord type);
+  void WriteNumber(uint64_t value);
+  void WriteInt(int value);
+  void WriteString(const std::string& value);
+
+  std::ostream* out_;
+  animation::TimePoint last_time_;
+  int dimx_ = -1;
+  int dimy_ = -1;
+};
+
+// Read the records of a session.
+class SessionReader {
+ public:
+  explicit SessionReader(std::istream* in);
+
+  struct Record {
+    SessionRecord type = SessionRecord::kTask;
+    uint64_t delay = 0;  // In microseconds.
+    Event event;         // kEvent.
+    int dimx = 0;        // kResize.
+    int dimy = 0;
+  };
+
+  // Read the next record. Return false at the end of the session, or when it
+  // is malformed.
+  bool Next(Record* record);
+  bool malformed() const { return malformed_; }
+
+ private:
+  bool ReadNumber(uint64_t* value);
+  bool ReadInt(int* value);
+  bool ReadString(std::string* value);
+  bool ReadEvent(Event* event);
+
+  std::istream* in_;
+  bool malformed_ = false;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_SESSION_RECORDER_HPP
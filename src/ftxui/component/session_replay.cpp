@@ -0,0 +1,118 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/component/session_replay.hpp"
+
+#include <chrono>   // for duration, microseconds
+#include <memory>   // for make_shared
+#include <string>   // for string
+#include <utility>  // for move
+
+#include "ftxui/component/animation.hpp"         // for Params, Clock
+#include "ftxui/component/component_base.hpp"    // for ComponentBase
+#include "ftxui/component/event.hpp"             // for Event
+#include "ftxui/component/frame_recorder.hpp"    // for FrameRecorder
+#include "ftxui/component/session_recorder.hpp"  // for SessionReader
+#include "ftxui/dom/node.hpp"                    // for Node, Render
+
+namespace ftxui {
+
+/// @brief Read the session from |in|, which must outlive this object.
+SessionReplay::SessionReplay(std::istream& in)
+    : in_(in), frame_recorder_(std::make_shared<FrameRecorder>()) {}
+
+/// @brief Replay the whole session into |component|.
+/// @return false if the session is malformed or truncated. The records read
+/// until then are replayed.
+bool SessionReplay::Run(Component component) {
+  SessionReader reader(&in_);
+  SessionReader::Record record;
+  // The offset of the mouse coordinates, reported by the terminal. Like in
+  // ScreenInteractive.
+  int cursor_x = 1;
+  int cursor_y = 1;
+  std::chrono::microseconds since_animation{0};
+  while (reader.Next(&record)) {
+    since_animation += std::chrono::microseconds(record.delay);
+    switch (record.type) {
+      case SessionRecord::kEvent: {
+        Event& event = record.event;
+        if (event.is_cursor_position()) {
+          cursor_x = event.cursor_x();
+          cursor_y = event.cursor_y();
+          break;
+        }
+        if (event.is_cursor_shape() || event.is_mode_report()) {
+          break;
+        }
+        if (event.is_mouse()) {
+          event.mouse().x -= cursor_x;
+          event.mouse().y -= cursor_y;
+        }
+        events_++;
+        ComponentBase::Private::InvalidateFocus();
+        component->OnEvent(event);
+        break;
+      }
+
+      case SessionRecord::kResize:
+        screen_ = Screen(record.dimx, record.dimy);
+        break;
+
+      case SessionRecord::kTask:
+        tasks_++;
+        break;
+
+      case SessionRecord::kAnimation: {
+        animation::Params params(
+            std::chrono::duration_cast<animation::Duration>(since_animation));
+        since_animation = std::chrono::microseconds(0);
+        ComponentBase::Private::DropRequests(0);
+        ComponentBase::Private::Animate(component.get(), params);
+        break;
+      }
+
+      case SessionRecord::kFrame:
+        Draw(component);
+        break;
+    }
+  }
+  return !reader.malformed();
+}
+
+/// @brief Return the time spent in each phase of the frames replayed, with the
+/// size of their output. The percentiles are computed over the last 128
+/// frames.
+FrameStats SessionReplay::Stats() const {
+  return frame_recorder_->Stats();
+}
+
+void SessionReplay::Draw(Component& component) {
+  auto seconds = [](animation::Clock::duration duration) {
+    return std::chrono::duration<double>(duration).count();
+  };
+  const auto start = animation::Clock::now();
+  ComponentBase::Private::InvalidateFocus();
+  Element document = component->Render();
+  const auto component_render_end = animation::Clock::now();
+  screen_.Clear();
+  Render(screen_, document);
+  const auto render_end = animation::Clock::now();
+  std::string output;
+  screen_.ToCompactString(output);
+  const auto serialize_end = animation::Clock::now();
+
+  const Screen::RenderTimings& timings = screen_.LastRenderTimings();
+  FrameRecorder& recorder = *frame_recorder_;
+  recorder.Add(FrameRecorder::kComponentRender,
+               seconds(component_render_end - start));
+  recorder.Add(FrameRecorder::kLayout, timings.layout);
+  recorder.Add(FrameRecorder::kNodeRender, timings.draw);
+  recorder.Add(FrameRecorder::kShader, timings.shader);
+  recorder.Add(FrameRecorder::kSerialize, seconds(serialize_end - render_end));
+  recorder.Add(FrameRecorder::kWrite, 0);
+  recorder.Add(FrameRecorder::kTotal, seconds(serialize_end - start));
+  recorder.AddFrame(output.size());
+}
+
+}  // namespace ftxui
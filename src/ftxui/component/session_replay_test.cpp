@@ -0,0 +1,102 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <sstream>  // for stringstream
+#include <string>   // for string
+
+#include "ftxui/component/component.hpp"  // for Renderer, CatchEvent
+#include "ftxui/component/event.hpp"      // for Event
+#include "ftxui/component/screen_interactive.hpp"
+#include "ftxui/component/session_replay.hpp"  // for SessionReplay
+#include "ftxui/dom/elements.hpp"              // for text
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+// Display the characters typed, and the mouse clicks.
+Component Typewriter(std::string* typed) {
+  return Renderer([typed] { return text(*typed); }) |
+         CatchEvent([typed](Event event) {
+           if (event.is_character()) {
+             *typed += event.character();
+             return true;
+           }
+           if (event.is_mouse() && event.mouse().motion == Mouse::Pressed) {
+             *typed += "@" + std::to_string(event.mouse().x);
+             return true;
+           }
+           return false;
+         });
+}
+
+Mouse Click(int x) {
+  Mouse mouse;
+  mouse.button = Mouse::Left;
+  mouse.motion = Mouse::Pressed;
+  mouse.x = x;
+  mouse.y = 1;
+  return mouse;
+}
+
+std::string Record(std::string* typed) {
+  std::stringstream session;
+  auto screen = ScreenInteractive::FixedSize(6, 1);
+  screen.RecordSession(&session);
+  auto component = Typewriter(typed);
+  bool started = false;
+  auto renderer = Renderer(component, [&] {
+    if (!started) {
+      started = true;
+      screen.PostEvent(Event::Character('a'));
+      screen.PostEvent(Event::Mouse("click", Click(4)));
+      screen.Post([] {});
+      screen.PostEvent(Event::Character("b"));
+      screen.Post(screen.ExitLoopClosure());
+    }
+    return component->Render();
+  });
+  screen.Loop(renderer);
+  return session.str();
+}
+}  // namespace
+
+TEST(SessionReplayTest, Replay) {
+  std::string recorded;
+  std::stringstream session(Record(&recorded));
+  // The mouse coordinates are relative to the drawing.
+  EXPECT_EQ(recorded, "a@3b");
+
+  std::string replayed;
+  SessionReplay replay(session);
+  EXPECT_TRUE(replay.Run(Typewriter(&replayed)));
+  EXPECT_EQ(replayed, "a@3b");
+  EXPECT_EQ(replay.screen().ToString(), "a@3b  ");
+  EXPECT_GE(replay.Stats().frames, 2u);
+  EXPECT_EQ(replay.events(), 3u);
+  EXPECT_GE(replay.tasks(), 2u);
+}
+
+TEST(SessionReplayTest, Truncated) {
+  std::string recorded;
+  std::string log = Record(&recorded);
+  log.pop_back();
+  std::stringstream session(log);
+
+  std::string replayed;
+  SessionReplay replay(session);
+  EXPECT_FALSE(replay.Run(Typewriter(&replayed)));
+  EXPECT_EQ(replayed, "a@3b");
+}
+
+TEST(SessionReplayTest, Malformed) {
+  std::stringstream session("not a session");
+  std::string replayed;
+  SessionReplay replay(session);
+  EXPECT_FALSE(replay.Run(Typewriter(&replayed)));
+  EXPECT_EQ(replay.Stats().frames, 0u);
+}
+
+}  // namespace ftxui
+// NOLINTEND
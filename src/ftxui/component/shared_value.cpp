@@ -0,0 +1,122 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/component/shared_value.hpp"
+
+#include <atomic>         // for atomic, memory_order
+#include <mutex>          // for mutex, lock_guard
+#include <unordered_map>  // for unordered_map
+#include <unordered_set>  // for unordered_set
+
+#include "ftxui/component/screen_interactive.hpp"  // for ScreenInteractive
+
+namespace ftxui {
+
+namespace {
+
+// Guards the screens, and the values registered.
+std::mutex g_mutex;  // NOLINT
+// The screens running a loop, and whether a redraw was posted to them, and
+// not run yet. It coalesces the writes.
+std::unordered_map<ScreenInteractive*, bool> g_screens;  // NOLINT
+// The screen reading stdin, if any.
+ScreenInteractive* g_main_screen = nullptr;     // NOLINT
+std::unordered_set<SharedValueBase*> g_values;  // NOLINT
+
+}  // namespace
+
+void SharedValueBase::Register() {
+  const std::lock_guard<std::mutex> lock(g_mutex);
+  g_values.insert(this);
+}
+
+void SharedValueBase::Unregister() {
+  const std::lock_guard<std::mutex> lock(g_mutex);
+  g_values.erase(this);
+}
+
+void SharedValueBase::Written() {
+  // Only the first write since the last refresh posts it.
+  if (dirty_.exchange(true, std::memory_order_acq_rel)) {
+    return;
+  }
+  const std::lock_guard<std::mutex> lock(g_mutex);
+  ScreenInteractive* screen = screen_.load(std::memory_order_relaxed);
+  if (screen == nullptr) {
+    screen = g_main_screen;
+  }
+  const auto it = g_screens.find(screen);
+  // Without a loop, the screen attached next refreshes the value.
+  if (it == g_screens.end() || it->second) {
+    return;
+  }
+  it->second = true;
+  screen->Post([screen] { RefreshAll(screen); });
+}
+
+void SharedValueBase::BindActive() const {
+  ScreenInteractive* screen = ScreenInteractive::Active();
+  if (screen == nullptr) {
+    return;
+  }
+  const std::lock_guard<std::mutex> lock(g_mutex);
+  screen_.store(screen, std::memory_order_relaxed);
+  // A redraw of another screen may be pending: refresh the value now, and
+  // make the next write redraw this one.
+  if (dirty_.exchange(false, std::memory_order_acq_rel)) {
+    Refresh();
+  }
+}
+
+// static
+void SharedValueBase::Attach(ScreenInteractive* screen, bool main) {
+  {
+    const std::lock_guard<std::mutex> lock(g_mutex);
+    g_screens[screen] = false;
+    if (main) {
+      g_main_screen = screen;
+    }
+  }
+  // The values written while the screen had no loop.
+  RefreshAll(screen);
+}
+
+// static
+void SharedValueBase::Detach(ScreenInteractive* screen) {
+  const std::lock_guard<std::mutex> lock(g_mutex);
+  g_screens.erase(screen);
+  if (g_main_screen == screen) {
+    g_main_screen = nullptr;
+  }
+}
+
+// static
+void SharedValueBase::RefreshAll(ScreenInteractive* screen) {
+  bool changed = false;
+  {
+    const std::lock_guard<std::mutex> lock(g_mutex);
+    const auto it = g_screens.find(screen);
+    if (it == g_screens.end()) {
+      return;
+    }
+    // The writes from now on post another redraw.
+    it->second = false;
+    for (SharedValueBase* value : g_values) {
+      ScreenInteractive* owner = value->screen_.load(std::memory_order_relaxed);
+      if (owner == nullptr) {
+        owner = g_main_screen;
+      }
+      if (owner == screen &&
+          value->dirty_.exchange(false, std::memory_order_acq_rel)) {
+        value->Refresh();
+        value->Changed();
+        changed = true;
+      }
+    }
+  }
+  if (changed) {
+    screen->RequestRedraw();
+  }
+}
+
+}  // namespace ftxui
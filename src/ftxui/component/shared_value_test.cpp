@@ -0,0 +1,176 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <atomic>  // for atomic
+#include <chrono>  // for steady_clock, seconds, milliseconds
+#include <string>  // for to_string
+#include <thread>  // for thread, this_thread
+#include <vector>  // for vector
+
+#include "ftxui/component/component.hpp"  // for Renderer, Memo, Container
+#include "ftxui/component/loop.hpp"       // for Loop
+#include "ftxui/component/screen_interactive.hpp"  // for ScreenInteractive
+#include "ftxui/component/shared_value.hpp"        // for SharedValue
+#include "ftxui/dom/elements.hpp"                  // for text
+#include "ftxui/util/ref.hpp"                      // for ConstRef
+
+#if !defined(_WIN32)
+#include <unistd.h>  // for pipe, close
+#endif
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+
+struct Pair {
+  uint64_t a = 0;
+  uint64_t b = 0;
+  uint64_t c = 0;
+};
+
+}  // namespace
+
+TEST(SharedValueTest, SetGet) {
+  SharedValue<int> value = 1;
+  EXPECT_EQ(value.Get(), 1);
+  EXPECT_EQ(value(), 1);
+
+  // Without a screen, the value read while rendering isn't refreshed.
+  value.Set(2);
+  EXPECT_EQ(value.Get(), 2);
+  EXPECT_EQ(value(), 1);
+  const ConstRef<int> ref = value;
+  EXPECT_EQ(ref(), 1);
+}
+
+// The values read are never a mix of two writes.
+TEST(SharedValueTest, NoTornReads) {
+  SharedValue<Pair> value;
+  std::atomic<bool> done{false};
+  std::vector<std::thread> writers;
+  for (int w = 0; w < 2; ++w) {
+    writers.emplace_back([&, w] {
+      for (uint64_t i = 0; i < 20000; ++i) {
+        const uint64_t x = i * 2 + uint64_t(w);
+        value.Set({x, x, x});
+      }
+    });
+  }
+  std::thread reader([&] {
+    while (!done) {
+      const Pair pair = value.Get();
+      ASSERT_EQ(pair.a, pair.b);
+      ASSERT_EQ(pair.b, pair.c);
+    }
+  });
+  for (auto& writer : writers) {
+    writer.join();
+  }
+  done = true;
+  reader.join();
+}
+
+TEST(SharedValueTest, CoalescedRedraw) {
+  auto screen = ScreenInteractive::FixedSize(20, 1);
+  screen.LazyRedraw();
+
+  SharedValue<int> counter = 0;
+  SharedValue<int> other = 0;
+  int counter_renders = 0;
+  int other_renders = 0;
+  auto component = Container::Horizontal({
+      Memo(Renderer([&] {
+        counter_renders++;
+        return text(std::to_string(counter()));
+      })),
+      Memo(Renderer([&] {
+        other_renders++;
+        return text(std::to_string(other()));
+      })),
+  });
+
+  Loop loop(&screen, component);
+  loop.RunOnce();
+  ASSERT_EQ(counter_renders, 1);
+  ASSERT_EQ(other_renders, 1);
+
+  // Many writes from another thread: a single frame, with the last value.
+  std::thread writer([&] {
+    for (int i = 1; i <= 1000; ++i) {
+      counter.Set(i);
+    }
+  });
+  writer.join();
+  loop.RunOnce();
+  EXPECT_EQ(counter_renders, 2);
+  EXPECT_EQ(counter(), 1000);
+  // The Memo not reading it isn't rendered again.
+  EXPECT_EQ(other_renders, 1);
+
+  // Nothing written, nothing drawn.
+  loop.RunOnce();
+  EXPECT_EQ(counter_renders, 2);
+
+  other.Set(7);
+  loop.RunOnce();
+  EXPECT_EQ(other_renders, 2);
+  EXPECT_EQ(counter_renders, 2);
+}
+
+#if !defined(_WIN32)
+// A value read by a session's screen wakes that session, not the stdin one.
+TEST(SharedValueTest, Session) {
+  int input[2];
+  int output[2];
+  ASSERT_EQ(pipe(input), 0);
+  ASSERT_EQ(pipe(output), 0);
+
+  SharedValue<int> value = 0;
+  std::atomic<bool> rendered{false};
+  std::atomic<bool> done{false};
+  std::atomic<ScreenInteractive*> session{nullptr};
+  std::thread thread([&] {
+    auto screen = ScreenInteractive::FitComponent();
+    screen.InputFd(input[0]);
+    screen.OutputFd(output[1]);
+    screen.SetTerminalSize({7, 3});
+    session = &screen;
+    auto component = Renderer([&] {
+      const int seen = value();
+      if (seen == 42) {
+        screen.Exit();
+      }
+      rendered = true;
+      return text(std::to_string(seen));
+    });
+    screen.Loop(component);
+    session = nullptr;
+    done = true;
+  });
+
+  while (!rendered) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  value.Set(42);
+
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!done && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_TRUE(done);
+  if (!done) {
+    session.load()->Exit();
+  }
+  thread.join();
+
+  for (int fd : {input[0], input[1], output[0], output[1]}) {
+    close(fd);
+  }
+}
+#endif
+
+}  // namespace ftxui
+// NOLINTEND
@@ -229,7 +229,11 @@ class SliderWithLabel : public ComponentBase {
       return false;
     }
 
-    mouse_hover_ = box_.Contain(event.mouse().x, event.mouse().y);
+    const bool hover = box_.Contain(event.mouse().x, event.mouse().y);
+    if (hover != mouse_hover_) {
+      mouse_hover_ = hover;
+      RequestRedraw();
+    }
 
     if (!mouse_hover_) {
       return false;
@@ -0,0 +1,64 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <array>    // for array
+#include <memory>   // for unique_ptr, make_unique, make_shared
+#include <utility>  // for move
+#include <variant>  // for get, holds_alternative
+#include <vector>   // for vector
+
+#include "ftxui/component/receiver.hpp"  // for MakeReceiver
+#include "ftxui/component/task.hpp"      // for Task, TaskClosure
+
+// NOLINTBEGIN
+namespace ftxui {
+
+TEST(TaskClosure, MoveOnlyCapture) {
+  int value = 0;
+  auto increment = std::make_unique<int>(3);
+  TaskClosure closure = [&value, increment = std::move(increment)] {
+    value += *increment;
+  };
+  TaskClosure moved = std::move(closure);
+  EXPECT_FALSE(closure);
+  ASSERT_TRUE(moved);
+  moved();
+  moved();
+  EXPECT_EQ(value, 6);
+}
+
+TEST(TaskClosure, Destroy) {
+  // The captures are destroyed once, with the last closure holding them,
+  // whether they are stored inline or not.
+  auto shared = std::make_shared<int>(0);
+  std::array<char, TaskClosure::kInlineSize> large{};
+  {
+    TaskClosure small = [shared] {};
+    TaskClosure big = [shared, large] { (void)large; };
+    EXPECT_EQ(shared.use_count(), 3);
+    TaskClosure other = std::move(big);
+    other = std::move(small);
+    EXPECT_EQ(shared.use_count(), 2);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(TaskClosure, Receiver) {
+  auto receiver = MakeReceiver<Task>();
+  auto sender = receiver->MakeSender();
+  int value = 0;
+  sender->Send([&value, p = std::make_unique<int>(1)] { value += *p; });
+  sender->Send(Event::Character('a'));
+
+  Task task;
+  ASSERT_TRUE(receiver->ReceiveNonBlocking(&task));
+  ASSERT_TRUE(std::holds_alternative<TaskClosure>(task));
+  std::get<TaskClosure>(task)();
+  EXPECT_EQ(value, 1);
+  ASSERT_TRUE(receiver->ReceiveNonBlocking(&task));
+  EXPECT_EQ(std::get<Event>(task), Event::Character('a'));
+}
+
+}  // namespace ftxui
+// NOLINTEND
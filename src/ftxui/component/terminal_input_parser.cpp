@@ -3,20 +3,34 @@
 // the LICENSE file.
 #include "ftxui/component/terminal_input_parser.hpp"
 
-#include <cstdint>                    // for uint32_t
+#include <algorithm>                  // for max, min
+#include <array>                      // for array
+#include <chrono>                     // for steady_clock
+#include <cstddef>                    // for size_t
+#include <cstdint>                    // for uint32_t, uint64_t, uint8_t
 #include <ftxui/component/mouse.hpp>  // for Mouse, Mouse::Button, Mouse::Motion
 #include <ftxui/component/receiver.hpp>  // for SenderImpl, Sender
-#include <map>
-#include <memory>   // for unique_ptr, allocator
-#include <utility>  // for move
-#include <vector>
+#include <iterator>     // for size
+#include <memory>       // for unique_ptr, allocator
+#include <string>       // for string
+#include <string_view>  // for string_view
+#include <utility>      // for move
+#include <variant>      // for get
+#include <vector>       // for vector
 #include "ftxui/component/event.hpp"  // for Event
 #include "ftxui/component/task.hpp"   // for Task
 
 namespace ftxui {
 
+namespace {
+
+struct Uniformization {
+  std::string_view from;
+  std::string_view to;
+};
+
 // NOLINTNEXTLINE
-const std::map<std::string, std::string> g_uniformize = {
+constexpr Uniformization g_uniformize[] = {
     // Microsoft's terminal uses a different new line character for the return
     // key. This also happens with linux with the `bind` command:
     // See https://github.com/ArthurSonzogni/FTXUI/issues/337
@@ -24,7 +38,7 @@ const std::map<std::string, std::string> g_uniformize = {
     {"\r", "\n"},
 
     // See: https://github.com/ArthurSonzogni/FTXUI/issues/508
-    {std::string({8}), std::string({127})},
+    {"\x08", "\x7F"},
 
     // See: https://github.com/ArthurSonzogni/FTXUI/issues/626
     //
@@ -90,6 +104,62 @@ const std::map<std::string, std::string> g_uniformize = {
     {"\x1B[X", "\x1B[24~"},  // F12
 };
 
+// The sequences are at most 7 bytes long. They are packed with their size into
+// an integer, to be compared at once.
+constexpr uint64_t Pack(std::string_view sequence) {
+  uint64_t key = sequence.size();
+  key <<= 56U;  // NOLINT
+  for (size_t i = 0; i < sequence.size(); ++i) {
+    key |= uint64_t(uint8_t(sequence[i])) << (8U * i);  // NOLINT
+  }
+  return key;
+}
+
+// A hash table of the indices in |g_uniformize|, built at compile time. The
+// collisions are resolved by linear probing.
+constexpr size_t kUniformizeSlots = 128;
+constexpr uint8_t kEmptySlot = 0xFF;
+
+constexpr size_t Slot(uint64_t key) {
+  return size_t((key * 0x9E3779B97F4A7C15ULL) >> 57U);  // NOLINT
+}
+
+constexpr std::array<uint8_t, kUniformizeSlots> BuildUniformizeTable() {
+  std::array<uint8_t, kUniformizeSlots> table{};
+  for (auto& slot : table) {
+    slot = kEmptySlot;
+  }
+  for (size_t i = 0; i < std::size(g_uniformize); ++i) {
+    size_t slot = Slot(Pack(g_uniformize[i].from));
+    while (table[slot] != kEmptySlot) {
+      slot = (slot + 1) % kUniformizeSlots;
+    }
+    table[slot] = uint8_t(i);
+  }
+  return table;
+}
+
+constexpr std::array<uint8_t, kUniformizeSlots> g_uniformize_table =
+    BuildUniformizeTable();
+
+// Return the sequence |sequence| is uniformized to, or |sequence| itself.
+std::string_view Uniformize(std::string_view sequence) {
+  if (sequence.size() > 7) {  // NOLINT
+    return sequence;
+  }
+  const uint64_t key = Pack(sequence);
+  for (size_t slot = Slot(key); g_uniformize_table[slot] != kEmptySlot;
+       slot = (slot + 1) % kUniformizeSlots) {
+    const Uniformization& entry = g_uniformize[g_uniformize_table[slot]];
+    if (entry.from == sequence) {
+      return entry.to;
+    }
+  }
+  return sequence;
+}
+
+}  // namespace
+
 TerminalInputParser::TerminalInputParser(Sender<Task> out)
     : out_(std::move(out)) {}
 
@@ -102,14 +172,72 @@ void TerminalInputParser::Timeout(int time) {
   timeout_ = 0;
   if (!pending_.empty()) {
     Send(SPECIAL);
+    Flush();
   }
 }
 
 void TerminalInputParser::Add(char c) {
-  pending_ += c;
+  Add(std::string_view(&c, 1));
+}
+
+void TerminalInputParser::Add(std::string_view input) {
+  read_time_ = std::chrono::steady_clock::now();
   timeout_ = 0;
-  position_ = -1;
-  Send(Parse());
+  Consume(input);
+  Flush();
+}
+
+void TerminalInputParser::Consume(std::string_view input) {
+  size_t i = 0;
+  while (i < input.size()) {
+    // In bracketed paste mode, everything up to the end marker is the text
+    // pasted. The marker can be split in between two buffers.
+    if (pasting_) {
+      const std::string_view end_marker = "\x1B[201~";
+      const size_t searched =
+          paste_.size() >= end_marker.size() ? paste_.size() - end_marker.size()
+                                             : 0;
+      paste_.append(input.substr(i));
+      const size_t end = paste_.find(end_marker, searched);
+      if (end == std::string::npos) {
+        return;
+      }
+      const std::string rest = paste_.substr(end + end_marker.size());
+      paste_.resize(end);
+      events_.emplace_back(Event::Paste(std::move(paste_)));
+      paste_.clear();
+      pasting_ = false;
+      Consume(rest);
+      return;
+    }
+
+    // Fast path: a printable ASCII character is a whole event on its own, when
+    // no sequence is pending.
+    if (pending_.empty()) {
+      while (i < input.size() && input[i] >= ' ' && input[i] < 127) {
+        events_.emplace_back(Event::Character(input[i]));
+        ++i;
+      }
+      if (i == input.size()) {
+        break;
+      }
+    }
+
+    pending_ += input[i++];
+    position_ = -1;
+    Send(Parse());
+  }
+}
+
+void TerminalInputParser::Flush() {
+  if (events_.empty()) {
+    return;
+  }
+  // The events completed by a timeout were read with the last input too.
+  for (Task& task : events_) {
+    std::get<Event>(task).read_time_ = read_time_;
+  }
+  out_->SendAll(&events_);
 }
 
 unsigned char TerminalInputParser::Current() {
@@ -122,6 +250,9 @@ bool TerminalInputParser::Eat() {
 }
 
 void TerminalInputParser::Send(TerminalInputParser::Output output) {
+  if (output.type != UNCOMPLETED) {
+    string_scanned_ = -1;
+  }
   switch (output.type) {
     case UNCOMPLETED:
       return;
@@ -131,34 +262,60 @@ void TerminalInputParser::Send(TerminalInputParser::Output output) {
       return;
 
     case CHARACTER:
-      out_->Send(Event::Character(std::move(pending_)));
+      events_.emplace_back(Event::Character(std::move(pending_)));
       pending_.clear();
       return;
 
     case SPECIAL: {
-      auto it = g_uniformize.find(pending_);
-      if (it != g_uniformize.end()) {
-        pending_ = it->second;
+      const std::string_view uniformized = Uniformize(pending_);
+      if (uniformized.data() != pending_.data()) {
+        pending_ = uniformized;
       }
-      out_->Send(Event::Special(std::move(pending_)));
+      events_.emplace_back(Event::Special(std::move(pending_)));
       pending_.clear();
     }
       return;
 
     case MOUSE:
-      out_->Send(Event::Mouse(std::move(pending_), output.mouse));  // NOLINT
+      events_.emplace_back(
+          Event::Mouse(std::move(pending_), output.mouse));  // NOLINT
       pending_.clear();
       return;
 
     case CURSOR_POSITION:
-      out_->Send(Event::CursorPosition(std::move(pending_),  // NOLINT
-                                       output.cursor.x,      // NOLINT
-                                       output.cursor.y));    // NOLINT
+      events_.emplace_back(Event::CursorPosition(std::move(pending_),  // NOLINT
+                                                 output.cursor.x,  // NOLINT
+                                                 output.cursor.y));  // NOLINT
       pending_.clear();
       return;
 
     case CURSOR_SHAPE:
-      out_->Send(Event::CursorShape(std::move(pending_), output.cursor_shape));
+      events_.emplace_back(
+          Event::CursorShape(std::move(pending_), output.cursor_shape));
+      pending_.clear();
+      return;
+
+    case PASTE_BEGIN:
+      pending_.clear();
+      pasting_ = true;
+      return;
+
+    case MODE_REPORT:
+      events_.emplace_back(Event::ModeReport(std::move(pending_),  // NOLINT
+                                             output.mode_report.mode,
+                                             output.mode_report.value));
+      pending_.clear();
+      return;
+
+    case DEVICE_ATTRIBUTES:
+      events_.emplace_back(Event::DeviceAttributes(  // NOLINT
+          std::move(pending_), output.device.level, output.device.type,
+          output.device.version, output.device.attributes));
+      pending_.clear();
+      return;
+
+    case TERMINAL_VERSION:
+      events_.emplace_back(Event::TerminalVersion(std::move(pending_)));
       pending_.clear();
       return;
   }
@@ -297,44 +454,60 @@ TerminalInputParser::Output TerminalInputParser::ParseESC() {
   }
 }
 
-// ESC P ... ESC BACKSLASH
-TerminalInputParser::Output TerminalInputParser::ParseDCS() {
-  // Parse until the string terminator ST.
+// Eat the characters of a DCS or OSC string, up to the string terminator ST.
+// Return false when it wasn't received yet. The characters already scanned
+// are skipped by the next call, so that a long string isn't scanned again for
+// every character received.
+bool TerminalInputParser::EatString() {
+  position_ = std::max(position_, string_scanned_);
   while (true) {
     if (!Eat()) {
-      return UNCOMPLETED;
+      string_scanned_ = position_ - 1;
+      return false;
     }
-
     if (Current() != '\x1B') {
       continue;
     }
-
     if (!Eat()) {
-      return UNCOMPLETED;
+      string_scanned_ = position_ - 2;  // The ESC is eaten again.
+      return false;
     }
-
-    if (Current() != '\\') {
-      continue;
+    if (Current() == '\\') {
+      return true;
     }
+  }
+}
 
-    if (pending_.size() == 10 &&  //
-        pending_[2] == '1' &&     //
-        pending_[3] == '$' &&     //
-        pending_[4] == 'r' &&     //
-        true) {
-      Output output(CURSOR_SHAPE);
-      output.cursor_shape = pending_[5] - '0';
-      return output;
-    }
+// ESC P ... ESC BACKSLASH
+TerminalInputParser::Output TerminalInputParser::ParseDCS() {
+  if (!EatString()) {
+    return UNCOMPLETED;
+  }
 
-    return SPECIAL;
+  if (pending_.size() == 10 &&  //
+      pending_[2] == '1' &&     //
+      pending_[3] == '$' &&     //
+      pending_[4] == 'r' &&     //
+      true) {
+    Output output(CURSOR_SHAPE);
+    output.cursor_shape = pending_[5] - '0';
+    return output;
   }
+
+  // XTVERSION: ESC P > | text ESC BACKSLASH
+  if (pending_.size() >= 6 &&  //
+      pending_[2] == '>' &&    //
+      pending_[3] == '|') {
+    return TERMINAL_VERSION;
+  }
+
+  return SPECIAL;
 }
 
 TerminalInputParser::Output TerminalInputParser::ParseCSI() {
   bool altered = false;
   int argument = 0;
-  std::vector<int> arguments;
+  Arguments arguments;
   while (true) {
     if (!Eat()) {
       return UNCOMPLETED;
@@ -369,11 +542,20 @@ TerminalInputParser::Output TerminalInputParser::ParseCSI() {
 
       switch (Current()) {
         case 'M':
-          return ParseMouse(altered, true, std::move(arguments));
+          return ParseMouse(altered, true, arguments);
         case 'm':
-          return ParseMouse(altered, false, std::move(arguments));
+          return ParseMouse(altered, false, arguments);
         case 'R':
-          return ParseCursorPosition(std::move(arguments));
+          return ParseCursorPosition(arguments);
+        case 'y':
+          return ParseModeReport(arguments);
+        case 'c':
+          return ParseDeviceAttributes(arguments);
+        case '~':
+          if (arguments.size() == 1 && arguments[0] == 200) {  // NOLINT
+            return PASTE_BEGIN;
+          }
+          return SPECIAL;
         default:
           return SPECIAL;
       }
@@ -387,28 +569,16 @@ TerminalInputParser::Output TerminalInputParser::ParseCSI() {
 }
 
 TerminalInputParser::Output TerminalInputParser::ParseOSC() {
-  // Parse until the string terminator ST.
-  while (true) {
-    if (!Eat()) {
-      return UNCOMPLETED;
-    }
-    if (Current() != '\x1B') {
-      continue;
-    }
-    if (!Eat()) {
-      return UNCOMPLETED;
-    }
-    if (Current() != '\\') {
-      continue;
-    }
-    return SPECIAL;
+  if (!EatString()) {
+    return UNCOMPLETED;
   }
+  return SPECIAL;
 }
 
 TerminalInputParser::Output TerminalInputParser::ParseMouse(  // NOLINT
     bool altered,
     bool pressed,
-    std::vector<int> arguments) {
+    const Arguments& arguments) {
   if (arguments.size() != 3) {
     return SPECIAL;
   }
@@ -451,7 +621,7 @@ TerminalInputParser::Output TerminalInputParser::ParseMouse(  // NOLINT
 
 // NOLINTNEXTLINE
 TerminalInputParser::Output TerminalInputParser::ParseCursorPosition(
-    std::vector<int> arguments) {
+    const Arguments& arguments) {
   if (arguments.size() != 2) {
     return SPECIAL;
   }
@@ -461,4 +631,58 @@ TerminalInputParser::Output TerminalInputParser::ParseCursorPosition(
   return output;
 }
 
+// DECRPM: ESC [ ? mode ; value $ y
+TerminalInputParser::Output TerminalInputParser::ParseModeReport(
+    const Arguments& arguments) {
+  if (arguments.size() != 2 ||  //
+      pending_.size() < 4 ||    //
+      pending_[2] != '?' ||     //
+      pending_[pending_.size() - 2] != '$') {
+    return SPECIAL;
+  }
+  Output output(MODE_REPORT);
+  output.mode_report.mode = arguments[0];   // NOLINT
+  output.mode_report.value = arguments[1];  // NOLINT
+  return output;
+}
+
+// DA1: ESC [ ? type ; attribute ; ... c
+// DA2: ESC [ > type ; version ; rom c
+TerminalInputParser::Output TerminalInputParser::ParseDeviceAttributes(
+    const Arguments& arguments) {
+  if (pending_.size() < 4 || (pending_[2] != '?' && pending_[2] != '>')) {
+    return SPECIAL;
+  }
+  Output output(DEVICE_ATTRIBUTES);
+  output.device.type = arguments[0];  // NOLINT
+  output.device.version = 0;          // NOLINT
+  output.device.attributes = 0;       // NOLINT
+  if (pending_[2] == '>') {
+    output.device.level = 2;  // NOLINT
+    if (arguments.size() >= 2) {
+      output.device.version = arguments[1];  // NOLINT
+    }
+    return output;
+  }
+
+  // The attributes are more than the arguments kept: they are read again from
+  // the sequence.
+  output.device.level = 1;  // NOLINT
+  int attribute = 0;
+  bool first = true;
+  for (size_t i = 3; i < pending_.size(); ++i) {
+    const char c = pending_[i];
+    if (c >= '0' && c <= '9') {
+      attribute = std::min(attribute * 10 + (c - '0'), 1000);  // NOLINT
+      continue;
+    }
+    if (!first && attribute < 64) {                          // NOLINT
+      output.device.attributes |= uint64_t(1) << attribute;  // NOLINT
+    }
+    first = false;
+    attribute = 0;
+  }
+  return output;
+}
+
 }  // namespace ftxui
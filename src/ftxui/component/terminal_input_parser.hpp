@@ -4,8 +4,13 @@
 #ifndef FTXUI_COMPONENT_TERMINAL_INPUT_PARSER
 #define FTXUI_COMPONENT_TERMINAL_INPUT_PARSER
 
-#include <string>  // for string
-#include <vector>  // for vector
+#include <array>        // for array
+#include <chrono>       // for steady_clock
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint64_t
+#include <string>       // for string
+#include <string_view>  // for string_view
+#include <vector>       // for vector
 
 #include "ftxui/component/mouse.hpp"     // for Mouse
 #include "ftxui/component/receiver.hpp"  // for Sender
@@ -20,10 +25,16 @@ class TerminalInputParser {
   explicit TerminalInputParser(Sender<Task> out);
   void Timeout(int time);
   void Add(char c);
+  // Parse a whole buffer read from the terminal. The events are sent at once.
+  void Add(std::string_view input);
+
+  // Whether some characters are waiting for more input, or for a timeout.
+  bool HasPending() const { return !pending_.empty(); }
 
  private:
   unsigned char Current();
   bool Eat();
+  bool EatString();
 
   enum Type {
     UNCOMPLETED,
@@ -32,20 +43,56 @@ class TerminalInputParser {
     MOUSE,
     CURSOR_POSITION,
     CURSOR_SHAPE,
+    MODE_REPORT,
+    DEVICE_ATTRIBUTES,
+    TERMINAL_VERSION,
+    PASTE_BEGIN,
     SPECIAL,
   };
 
+  // The numeric parameters of a CSI sequence, stored inline. Only the first
+  // ones are kept, but all of them are counted.
+  class Arguments {
+   public:
+    void push_back(int value) {
+      if (size_ < values_.size()) {
+        values_[size_] = value;
+      }
+      size_++;
+    }
+    size_t size() const { return size_; }
+    int operator[](size_t i) const { return values_[i]; }
+
+   private:
+    std::array<int, 4> values_{};
+    size_t size_ = 0;
+  };
+
   struct CursorPosition {
     int x;
     int y;
   };
 
+  struct ModeReport {
+    int mode;
+    int value;
+  };
+
+  struct DeviceAttributes {
+    int level;
+    int type;
+    int version;
+    uint64_t attributes;
+  };
+
   struct Output {
     Type type;
     union {
       Mouse mouse;
       CursorPosition cursor{};
       int cursor_shape;
+      ModeReport mode_report;
+      DeviceAttributes device;
     };
 
     Output(Type t)  // NOLINT
@@ -53,19 +100,35 @@ class TerminalInputParser {
   };
 
   void Send(Output output);
+  void Flush();
+  void Consume(std::string_view input);
   Output Parse();
   Output ParseUTF8();
   Output ParseESC();
   Output ParseDCS();
   Output ParseCSI();
   Output ParseOSC();
-  Output ParseMouse(bool altered, bool pressed, std::vector<int> arguments);
-  Output ParseCursorPosition(std::vector<int> arguments);
+  Output ParseMouse(bool altered, bool pressed, const Arguments& arguments);
+  Output ParseCursorPosition(const Arguments& arguments);
+  Output ParseModeReport(const Arguments& arguments);
+  Output ParseDeviceAttributes(const Arguments& arguments);
 
   Sender<Task> out_;
   int position_ = -1;
+  // The position up to which the DCS or OSC string pending was scanned,
+  // without finding its terminator.
+  int string_scanned_ = -1;
   int timeout_ = 0;
   std::string pending_;
+  // The events parsed, not yet sent.
+  std::vector<Task> events_;
+
+  // When the last input was added. The events are stamped with it.
+  std::chrono::steady_clock::time_point read_time_;
+
+  // In bracketed paste mode, the text is accumulated until the end marker.
+  bool pasting_ = false;
+  std::string paste_;
 };
 
 }  // namespace ftxui
@@ -2,9 +2,12 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 #include <ftxui/component/mouse.hpp>  // for Mouse, Mouse::Left, Mouse::Middle, Mouse::Pressed, Mouse::Released, Mouse::Right
+#include <chrono>                     // for steady_clock
 #include <ftxui/component/task.hpp>   // for Task
 #include <initializer_list>           // for initializer_list
 #include <memory>                     // for allocator, unique_ptr
+#include <string_view>                // for string_view
+#include <vector>                     // for vector
 
 #include "ftxui/component/event.hpp"  // for Event, Event::Return, Event::ArrowDown, Event::ArrowLeft, Event::ArrowRight, Event::ArrowUp, Event::Backspace, Event::End, Event::Home, Event::Custom, Event::Delete, Event::F1, Event::F10, Event::F11, Event::F12, Event::F2, Event::F3, Event::F4, Event::F5, Event::F6, Event::F7, Event::F8, Event::F9, Event::PageDown, Event::PageUp, Event::Tab, Event::TabReverse, Event::Escape
 #include "ftxui/component/receiver.hpp"  // for MakeReceiver, ReceiverImpl
@@ -38,6 +41,83 @@ TEST(Event, Character) {
   EXPECT_FALSE(event_receiver->Receive(&received));
 }
 
+TEST(Event, ReadTime) {
+  auto event_receiver = MakeReceiver<Task>();
+  const auto before = std::chrono::steady_clock::now();
+  {
+    auto parser = TerminalInputParser(event_receiver->MakeSender());
+    parser.Add(std::string_view("a\x1B"));
+    // The escape key is only known after the timeout.
+    parser.Timeout(100);
+  }
+  const auto after = std::chrono::steady_clock::now();
+
+  std::vector<Task> received;
+  event_receiver->ReceiveAll(&received);
+  ASSERT_EQ(received.size(), 2u);
+  for (const Task& task : received) {
+    const auto read_time = std::get<Event>(task).read_time();
+    EXPECT_GE(read_time, before);
+    EXPECT_LE(read_time, after);
+  }
+  EXPECT_EQ(std::get<Event>(received[1]), Event::Escape);
+
+  // The events posted by the application aren't read.
+  EXPECT_EQ(Event::Custom.read_time(), std::chrono::steady_clock::time_point());
+}
+
+TEST(Event, AddBuffer) {
+  auto event_receiver = MakeReceiver<Task>();
+  {
+    auto parser = TerminalInputParser(event_receiver->MakeSender());
+    // The escape sequence is split in between two buffers.
+    parser.Add(std::string_view("ab\x1B[", 4));
+    parser.Add(std::string_view("Aé\rc"));
+  }
+
+  std::vector<Task> received;
+  event_receiver->ReceiveAll(&received);
+  ASSERT_EQ(received.size(), 6u);
+  EXPECT_EQ(std::get<Event>(received[0]), Event::Character('a'));
+  EXPECT_EQ(std::get<Event>(received[1]), Event::Character('b'));
+  EXPECT_EQ(std::get<Event>(received[2]), Event::ArrowUp);
+  EXPECT_EQ(std::get<Event>(received[3]), Event::Character("é"));
+  EXPECT_EQ(std::get<Event>(received[4]), Event::Return);
+  EXPECT_EQ(std::get<Event>(received[5]), Event::Character('c'));
+}
+
+TEST(Event, BracketedPaste) {
+  auto event_receiver = MakeReceiver<Task>();
+  {
+    auto parser = TerminalInputParser(event_receiver->MakeSender());
+    parser.Add(std::string_view("a\x1B[200~b\x1B[A\r\nc\x1B[20"));
+    // The end marker is split in between two buffers.
+    parser.Add(std::string_view("1~d"));
+  }
+
+  std::vector<Task> received;
+  event_receiver->ReceiveAll(&received);
+  ASSERT_EQ(received.size(), 3u);
+  EXPECT_EQ(std::get<Event>(received[0]), Event::Character('a'));
+  EXPECT_TRUE(std::get<Event>(received[1]).is_paste());
+  EXPECT_EQ(std::get<Event>(received[1]).input(), "b\x1B[A\r\nc");
+  EXPECT_EQ(std::get<Event>(received[2]), Event::Character('d'));
+}
+
+TEST(Event, ManyArguments) {
+  auto event_receiver = MakeReceiver<Task>();
+  {
+    auto parser = TerminalInputParser(event_receiver->MakeSender());
+    // More arguments than stored inline. Not a mouse event.
+    parser.Add(std::string_view("\x1B[<1;2;3;4;5;6;7M"));
+  }
+
+  Task received;
+  EXPECT_TRUE(event_receiver->Receive(&received));
+  EXPECT_FALSE(std::get<Event>(received).is_mouse());
+  EXPECT_FALSE(event_receiver->Receive(&received));
+}
+
 TEST(Event, EscapeKeyWithoutWaiting) {
   auto event_receiver = MakeReceiver<Task>();
   {
@@ -510,5 +590,124 @@ TEST(Event, DeviceControlString) {
   EXPECT_FALSE(event_receiver->Receive(&received));
 }
 
+TEST(Event, ModeReport) {
+  auto event_receiver = MakeReceiver<Task>();
+  {
+    auto parser = TerminalInputParser(event_receiver->MakeSender());
+    for (const char c : std::string("\x1B[?2026;2$y")) {
+      parser.Add(c);
+    }
+  }
+
+  Task received;
+  EXPECT_TRUE(event_receiver->Receive(&received));
+  EXPECT_TRUE(std::get<Event>(received).is_mode_report());
+  EXPECT_EQ(2026, std::get<Event>(received).mode());
+  EXPECT_EQ(2, std::get<Event>(received).mode_value());
+  EXPECT_FALSE(event_receiver->Receive(&received));
+}
+
+TEST(Event, DeviceAttributes) {
+  auto event_receiver = MakeReceiver<Task>();
+  {
+    auto parser = TerminalInputParser(event_receiver->MakeSender());
+    // DA1 of a VT220 class terminal, with more attributes than the arguments
+    // of a CSI kept, then DA2.
+    parser.Add("\x1B[?62;1;4;6;9;15;22;52c");
+    parser.Add("\x1B[>41;390;0c");
+    // rxvt's Shift+Right isn't a report.
+    parser.Add("\x1B[c");
+  }
+
+  Task received;
+  EXPECT_TRUE(event_receiver->Receive(&received));
+  Event da1 = std::get<Event>(received);
+  EXPECT_TRUE(da1.is_device_attributes());
+  EXPECT_EQ(1, da1.device_level());
+  EXPECT_EQ(62, da1.device_type());
+  EXPECT_FALSE(da1.device_attribute(62));
+  EXPECT_FALSE(da1.device_attribute(2));
+  EXPECT_TRUE(da1.device_attribute(4));
+  EXPECT_TRUE(da1.device_attribute(22));
+  EXPECT_TRUE(da1.device_attribute(52));
+
+  EXPECT_TRUE(event_receiver->Receive(&received));
+  Event da2 = std::get<Event>(received);
+  EXPECT_TRUE(da2.is_device_attributes());
+  EXPECT_EQ(2, da2.device_level());
+  EXPECT_EQ(41, da2.device_type());
+  EXPECT_EQ(390, da2.device_version());
+
+  EXPECT_TRUE(event_receiver->Receive(&received));
+  EXPECT_FALSE(std::get<Event>(received).is_device_attributes());
+  EXPECT_FALSE(event_receiver->Receive(&received));
+}
+
+TEST(Event, TerminalVersion) {
+  auto event_receiver = MakeReceiver<Task>();
+  {
+    auto parser = TerminalInputParser(event_receiver->MakeSender());
+    parser.Add("\x1BP>|kitty(0.35.2)\x1B\\");
+  }
+
+  Task received;
+  EXPECT_TRUE(event_receiver->Receive(&received));
+  EXPECT_TRUE(std::get<Event>(received).is_terminal_version());
+  EXPECT_EQ("kitty(0.35.2)", std::get<Event>(received).terminal_version());
+  EXPECT_FALSE(event_receiver->Receive(&received));
+}
+
+// A long string sequence, received by small chunks. The terminator can be
+// split in between two of them.
+TEST(Event, LongStringSequence) {
+  const std::string sequence =
+      "\x1B]52;c;" + std::string(1000, 'A') + "\x1B" + "B" + "\x1B\\";
+  auto event_receiver = MakeReceiver<Task>();
+  {
+    auto parser = TerminalInputParser(event_receiver->MakeSender());
+    for (size_t i = 0; i < sequence.size(); i += 7) {
+      parser.Add(std::string_view(sequence).substr(i, 7));
+    }
+    parser.Add(std::string_view(sequence).substr(0, sequence.size() - 1));
+    parser.Add("\\a");
+  }
+
+  Task received;
+  EXPECT_TRUE(event_receiver->Receive(&received));
+  EXPECT_EQ(std::get<Event>(received).input(), sequence);
+  EXPECT_TRUE(event_receiver->Receive(&received));
+  EXPECT_EQ(std::get<Event>(received).input(), sequence);
+  EXPECT_TRUE(event_receiver->Receive(&received));
+  EXPECT_EQ(std::get<Event>(received), Event::Character('a'));
+  EXPECT_FALSE(event_receiver->Receive(&received));
+}
+
+TEST(Event, Compare) {
+  // Short inputs are compared by their packed key.
+  EXPECT_EQ(Event::Special("\x1B[B"), Event::ArrowDown);
+  EXPECT_NE(Event::ArrowUp, Event::ArrowDown);
+  EXPECT_NE(Event::Character("a"), Event::Character(std::string("a\0", 2)));
+  EXPECT_EQ(Event::Character("é"), Event::Character("é"));
+
+  // Long inputs are compared as strings.
+  const std::string long_input = "\x1B[<0;12;34M";
+  EXPECT_EQ(Event::Special(long_input), Event::Special(long_input));
+  EXPECT_NE(Event::Special(long_input), Event::Special("\x1B[<0;12;35M"));
+  EXPECT_NE(Event::Special(long_input), Event::ArrowDown);
+  EXPECT_NE(Event::Special(""), Event::Custom);
+
+  // The order is strict and consistent with the equality.
+  const Event events[] = {Event::ArrowUp, Event::ArrowDown,
+                          Event::Special(long_input), Event::Special("")};
+  for (const Event& a : events) {
+    EXPECT_FALSE(a < a);
+    for (const Event& b : events) {
+      if (a != b) {
+        EXPECT_NE(a < b, b < a);
+      }
+    }
+  }
+}
+
 }  // namespace ftxui
    // NOLINTEND
@@ -0,0 +1,273 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/component/terminal_probe.hpp"
+
+#include <array>         // for array
+#include <charconv>      // for from_chars
+#include <cstdlib>       // for getenv
+#include <system_error>  // for errc
+#include <fstream>       // for ifstream, ofstream
+#include <map>           // for map
+#include <mutex>         // for mutex, lock_guard
+#include <sstream>       // for istringstream
+#include <string>        // for string, getline
+#include <utility>       // for move
+#include <vector>        // for vector
+
+#include "ftxui/component/event.hpp"  // for Event
+#include "ftxui/screen/terminal.hpp"  // for ColorSupport, SetColorSupport
+
+namespace ftxui {
+
+namespace {
+
+// The terminal modes queried with DECRQM.
+const int kSynchronizedOutputMode = 2026;
+// The DA1 attribute announcing sixel graphics.
+const int kSixelAttribute = 4;
+// The DA2 terminal type of VTE, the library of GNOME Terminal and others.
+const int kVteDeviceType = 65;
+// VTE 0.36, supporting the true colors.
+const int kVteTrueColorVersion = 3600;
+
+// The terminals known from their XTVERSION, and what they support.
+struct KnownTerminal {
+  const char* prefix;
+  bool repeat;
+  bool true_color;
+  bool kitty_graphics;
+};
+
+// clang-format off
+const std::array<KnownTerminal, 7> kKnownTerminals = {{
+    {"XTerm(",   true,  false, false},
+    {"kitty(",   true,  true,  true },
+    {"WezTerm ", true,  true,  true },
+    {"ghostty ", true,  true,  true },
+    {"foot(",    true,  true,  false},
+    {"contour ", true,  true,  false},
+    {"iTerm2 ",  false, true,  false},
+}};
+// clang-format on
+
+std::mutex g_probed_mutex;                             // NOLINT
+std::map<std::string, TerminalCapabilities> g_probed;  // NOLINT
+
+const char* Safe(const char* c) {
+  return (c != nullptr) ? c : "";
+}
+
+// Keep the separators of the cache file out of its fields.
+std::string Sanitize(std::string s) {
+  for (char& c : s) {
+    if (c == '\t' || c == '\n' || c == '\r') {
+      c = ' ';
+    }
+  }
+  return s;
+}
+
+// One line per terminal, with its fields separated by tabulations:
+// identity, sixel, synchronized output, DA2 type, DA2 version, XTVERSION.
+std::string Serialize(const std::string& identity,
+                      const TerminalCapabilities& capabilities) {
+  return Sanitize(identity) + "\t" +                       //
+         std::to_string(int(capabilities.sixel)) + "\t" +  //
+         std::to_string(int(capabilities.synchronized_output)) + "\t" +
+         std::to_string(capabilities.device_type) + "\t" +
+         std::to_string(capabilities.device_version) + "\t" +
+         Sanitize(capabilities.version);
+}
+
+bool ParseInt(const std::string& s, int* value) {
+  const char* end = s.data() + s.size();
+  auto result = std::from_chars(s.data(), end, *value);
+  return result.ec == std::errc() && result.ptr == end;
+}
+
+bool Parse(const std::string& line,
+           std::string* identity,
+           TerminalCapabilities* capabilities) {
+  std::istringstream in(line);
+  std::vector<std::string> fields;
+  std::string field;
+  while (std::getline(in, field, '\t')) {
+    fields.push_back(std::move(field));
+  }
+  if (fields.size() == 5) {  // The version was empty.
+    fields.emplace_back();
+  }
+  if (fields.size() != 6) {
+    return false;
+  }
+  int sixel = 0;
+  int synchronized_output = 0;
+  if (!ParseInt(fields[1], &sixel) ||
+      !ParseInt(fields[2], &synchronized_output) ||
+      !ParseInt(fields[3], &capabilities->device_type) ||
+      !ParseInt(fields[4], &capabilities->device_version)) {
+    return false;
+  }
+  *identity = fields[0];
+  capabilities->sixel = sixel != 0;
+  capabilities->synchronized_output = synchronized_output != 0;
+  capabilities->version = fields[5];
+  capabilities->Deduce();
+  return true;
+}
+
+}  // namespace
+
+// The terminals don't announce REP, the true colors or the kitty graphics
+// protocol: they are known from the terminal's name and version.
+void TerminalCapabilities::Deduce() {
+  repeat = false;
+  true_color = false;
+  kitty_graphics = false;
+  for (const KnownTerminal& known : kKnownTerminals) {
+    if (version.rfind(known.prefix, 0) == 0) {
+      repeat = known.repeat;
+      true_color = known.true_color;
+      kitty_graphics = known.kitty_graphics;
+      return;
+    }
+  }
+  if (device_type == kVteDeviceType &&
+      device_version >= kVteTrueColorVersion) {
+    true_color = true;
+  }
+}
+
+// DECRQM of the synchronized output, XTVERSION, DA2, then DA1.
+// static
+std::string TerminalProbe::Queries() {
+  return "\x1B[?" + std::to_string(kSynchronizedOutputMode) + "$p" +
+         "\x1B[>0q"  // XTVERSION
+         "\x1B[>c"   // DA2
+         "\x1B[c";   // DA1
+}
+
+bool TerminalProbe::OnEvent(const Event& event) {
+  if (complete_) {
+    return false;
+  }
+  if (event.is_mode_report()) {
+    if (event.mode() == kSynchronizedOutputMode) {
+      // 1: set, 2: reset, 3: permanently set. The mode is supported.
+      capabilities_.synchronized_output =
+          event.mode_value() >= 1 && event.mode_value() <= 3;
+    }
+    return false;
+  }
+  if (event.is_terminal_version()) {
+    capabilities_.version = event.terminal_version();
+    return false;
+  }
+  if (!event.is_device_attributes()) {
+    return false;
+  }
+  if (event.device_level() == 2) {
+    capabilities_.device_type = event.device_type();
+    capabilities_.device_version = event.device_version();
+    return false;
+  }
+  capabilities_.sixel = event.device_attribute(kSixelAttribute);
+  capabilities_.Deduce();
+  complete_ = true;
+  return true;
+}
+
+// static
+void TerminalProbe::Apply(const TerminalCapabilities& capabilities) {
+  if (capabilities.repeat) {
+    Terminal::SetRepeatSupport(true);
+  }
+  // The colors dropped on purpose, see NO_COLOR, stay dropped.
+  const Terminal::Color color = Terminal::ColorSupport();
+  if (capabilities.true_color && color != Terminal::Color::Palette1) {
+    Terminal::SetColorSupport(Terminal::Color::TrueColor);
+  }
+  if (capabilities.kitty_graphics) {
+    Terminal::SetGraphicsSupport(Terminal::Graphics::Kitty);
+  } else if (capabilities.sixel &&
+             Terminal::GraphicsSupport() == Terminal::Graphics::None) {
+    Terminal::SetGraphicsSupport(Terminal::Graphics::Sixel);
+  }
+}
+
+// static
+std::string TerminalProbe::Identity() {
+  return std::string(Safe(std::getenv("TERM"))) + "/" +  // NOLINT
+         Safe(std::getenv("TERM_PROGRAM")) + "/" +       // NOLINT
+         Safe(std::getenv("TERM_PROGRAM_VERSION"));      // NOLINT
+}
+
+// static
+bool TerminalProbe::Lookup(const std::string& identity,
+                           TerminalCapabilities* capabilities) {
+  const std::lock_guard<std::mutex> lock(g_probed_mutex);
+  auto it = g_probed.find(identity);
+  if (it == g_probed.end()) {
+    return false;
+  }
+  *capabilities = it->second;
+  return true;
+}
+
+// static
+bool TerminalProbe::Load(const std::string& path,
+                         const std::string& identity,
+                         TerminalCapabilities* capabilities) {
+  if (path.empty()) {
+    return false;
+  }
+  std::ifstream in(path);
+  std::string line;
+  std::string line_identity;
+  TerminalCapabilities line_capabilities;
+  while (std::getline(in, line)) {
+    if (Parse(line, &line_identity, &line_capabilities) &&
+        line_identity == Sanitize(identity)) {
+      *capabilities = line_capabilities;
+      return true;
+    }
+  }
+  return false;
+}
+
+// static
+void TerminalProbe::Store(const std::string& path,
+                          const std::string& identity,
+                          const TerminalCapabilities& capabilities) {
+  {
+    const std::lock_guard<std::mutex> lock(g_probed_mutex);
+    g_probed[identity] = capabilities;
+  }
+  if (path.empty()) {
+    return;
+  }
+
+  // Keep the other terminals, and replace this one.
+  std::vector<std::string> lines;
+  {
+    std::ifstream in(path);
+    std::string line;
+    std::string line_identity;
+    TerminalCapabilities line_capabilities;
+    while (std::getline(in, line)) {
+      if (Parse(line, &line_identity, &line_capabilities) &&
+          line_identity != Sanitize(identity)) {
+        lines.push_back(std::move(line));
+      }
+    }
+  }
+  lines.push_back(Serialize(identity, capabilities));
+
+  std::ofstream out(path, std::ios::trunc);
+  for (const std::string& line : lines) {
+    out << line << '\n';
+  }
+}
+
+}  // namespace ftxui
@@ -0,0 +1,77 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_TERMINAL_PROBE_HPP
+#define FTXUI_COMPONENT_TERMINAL_PROBE_HPP
+
+#include <string>  // for string
+
+namespace ftxui {
+
+struct Event;
+
+// What a terminal reported about itself, and what it implies.
+struct TerminalCapabilities {
+  // Reported.
+  std::string version;               // XTVERSION, like "kitty(0.35.2)".
+  int device_type = 0;               // DA2, like 41 for a VT420.
+  int device_version = 0;            // DA2.
+  bool sixel = false;                // DA1 attribute 4.
+  bool synchronized_output = false;  // DECRQM of the mode 2026.
+
+  // Deduced from the terminal reported, see Deduce().
+  bool repeat = false;
+  bool true_color = false;
+  bool kitty_graphics = false;
+
+  void Deduce();
+};
+
+// Query the capabilities of the terminal, without waiting for the answers.
+// The queries are written at install. The answers are parsed by
+// TerminalInputParser into events, read by the loop like the other ones, and
+// given to OnEvent().
+//
+// The primary device attributes (DA1) are queried last. Every terminal
+// answers them, and the queries are answered in order: their answer means the
+// other queries were either answered or ignored.
+class TerminalProbe {
+ public:
+  // The queries to write to the terminal.
+  static std::string Queries();
+
+  // Record |event| when it answers a query. Return true once the terminal
+  // answered the last query: capabilities() is then complete.
+  bool OnEvent(const Event& event);
+  bool complete() const { return complete_; }
+  const TerminalCapabilities& capabilities() const { return capabilities_; }
+
+  // Enable the output paths the terminal supports: REP, true colors and the
+  // graphics protocols. The ones already enabled are kept.
+  static void Apply(const TerminalCapabilities& capabilities);
+
+  // The terminal the process runs in, from its environment.
+  static std::string Identity();
+
+  // The capabilities of the terminal |identity|, probed by this process.
+  static bool Lookup(const std::string& identity,
+                     TerminalCapabilities* capabilities);
+  // The capabilities of the terminal |identity|, stored in the file |path| by
+  // a previous session. False when |path| is empty.
+  static bool Load(const std::string& path,
+                   const std::string& identity,
+                   TerminalCapabilities* capabilities);
+  // Remember the capabilities of the terminal |identity| for this process,
+  // and in the file |path| unless empty.
+  static void Store(const std::string& path,
+                    const std::string& identity,
+                    const TerminalCapabilities& capabilities);
+
+ private:
+  TerminalCapabilities capabilities_;
+  bool complete_ = false;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_TERMINAL_PROBE_HPP
@@ -0,0 +1,129 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <cstdint>  // for uint64_t
+#include <cstdio>   // for remove
+#include <fstream>  // for ofstream
+#include <string>   // for string
+
+#include "ftxui/component/event.hpp"           // for Event
+#include "ftxui/component/terminal_probe.hpp"  // for TerminalProbe
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+
+const uint64_t kSixel = uint64_t(1) << 4;
+
+}  // namespace
+
+TEST(TerminalProbeTest, CompletedByDA1) {
+  TerminalProbe probe;
+  EXPECT_FALSE(probe.OnEvent(Event::ModeReport("", 2026, 2)));
+  EXPECT_FALSE(
+      probe.OnEvent(Event::TerminalVersion("\x1BP>|foot(1.16.2)\x1B\\")));
+  EXPECT_FALSE(probe.OnEvent(Event::DeviceAttributes("", 2, 1, 11602, 0)));
+  EXPECT_FALSE(probe.complete());
+  EXPECT_TRUE(probe.OnEvent(Event::DeviceAttributes("", 1, 62, 0, kSixel)));
+  EXPECT_TRUE(probe.complete());
+
+  const TerminalCapabilities& capabilities = probe.capabilities();
+  EXPECT_EQ(capabilities.version, "foot(1.16.2)");
+  EXPECT_EQ(capabilities.device_type, 1);
+  EXPECT_EQ(capabilities.device_version, 11602);
+  EXPECT_TRUE(capabilities.sixel);
+  EXPECT_TRUE(capabilities.synchronized_output);
+  EXPECT_TRUE(capabilities.repeat);
+  EXPECT_TRUE(capabilities.true_color);
+  EXPECT_FALSE(capabilities.kitty_graphics);
+
+  // The late answers are ignored.
+  EXPECT_FALSE(probe.OnEvent(Event::DeviceAttributes("", 1, 62, 0, 0)));
+  EXPECT_TRUE(probe.capabilities().sixel);
+}
+
+TEST(TerminalProbeTest, UnknownTerminal) {
+  TerminalProbe probe;
+  // No answer to XTVERSION, nor to DECRQM.
+  EXPECT_TRUE(probe.OnEvent(Event::DeviceAttributes("", 1, 62, 0, 0)));
+  const TerminalCapabilities& capabilities = probe.capabilities();
+  EXPECT_FALSE(capabilities.sixel);
+  EXPECT_FALSE(capabilities.synchronized_output);
+  EXPECT_FALSE(capabilities.repeat);
+  EXPECT_FALSE(capabilities.true_color);
+  EXPECT_FALSE(capabilities.kitty_graphics);
+}
+
+TEST(TerminalProbeTest, Queries) {
+  // DA1 last: it completes the probe.
+  const std::string queries = TerminalProbe::Queries();
+  EXPECT_EQ(queries, "\x1B[?2026$p\x1B[>0q\x1B[>c\x1B[c");
+}
+
+TEST(TerminalProbeTest, Lookup) {
+  TerminalCapabilities capabilities;
+  EXPECT_FALSE(TerminalProbe::Lookup("test-lookup", &capabilities));
+
+  capabilities.version = "kitty(0.35.2)";
+  capabilities.Deduce();
+  TerminalProbe::Store("", "test-lookup", capabilities);
+
+  TerminalCapabilities found;
+  EXPECT_TRUE(TerminalProbe::Lookup("test-lookup", &found));
+  EXPECT_EQ(found.version, "kitty(0.35.2)");
+  EXPECT_TRUE(found.kitty_graphics);
+  EXPECT_FALSE(TerminalProbe::Load("", "test-lookup", &found));
+}
+
+TEST(TerminalProbeTest, CacheFile) {
+  const std::string path = testing::TempDir() + "ftxui_terminal_probe_test";
+  std::remove(path.c_str());
+  {
+    // A malformed line is skipped.
+    std::ofstream out(path);
+    out << "garbage\n";
+  }
+
+  TerminalCapabilities xterm;
+  xterm.version = "XTerm(390)";
+  xterm.device_type = 41;
+  xterm.device_version = 390;
+  xterm.sixel = true;
+  xterm.Deduce();
+  TerminalProbe::Store(path, "xterm-256color//", xterm);
+
+  TerminalCapabilities vte;
+  vte.device_type = 65;
+  vte.device_version = 7600;
+  vte.synchronized_output = true;
+  vte.Deduce();
+  TerminalProbe::Store(path, "xterm-256color/vte/", vte);
+
+  // Stored again: replaced.
+  xterm.sixel = false;
+  TerminalProbe::Store(path, "xterm-256color//", xterm);
+
+  TerminalCapabilities found;
+  EXPECT_FALSE(TerminalProbe::Load(path, "unknown", &found));
+
+  EXPECT_TRUE(TerminalProbe::Load(path, "xterm-256color//", &found));
+  EXPECT_EQ(found.version, "XTerm(390)");
+  EXPECT_EQ(found.device_type, 41);
+  EXPECT_EQ(found.device_version, 390);
+  EXPECT_FALSE(found.sixel);
+  EXPECT_TRUE(found.repeat);
+  EXPECT_FALSE(found.true_color);
+
+  EXPECT_TRUE(TerminalProbe::Load(path, "xterm-256color/vte/", &found));
+  EXPECT_EQ(found.version, "");
+  EXPECT_TRUE(found.synchronized_output);
+  EXPECT_FALSE(found.repeat);
+  EXPECT_TRUE(found.true_color);
+
+  std::remove(path.c_str());
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -0,0 +1,214 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/component/timer_wheel.hpp"
+
+#include <algorithm>  // for max, min
+#include <chrono>     // for ceil, duration_cast, milliseconds
+#include <iterator>   // for next
+#include <limits>     // for numeric_limits
+#include <memory>     // for make_shared
+#include <utility>    // for move
+#include <variant>    // for get_if
+
+namespace ftxui {
+
+namespace {
+
+// Round |duration| up to a number of milliseconds. Never negative.
+uint64_t CeilMilliseconds(animation::Clock::duration duration) {
+  const auto ms = std::chrono::ceil<std::chrono::milliseconds>(duration);
+  return uint64_t(std::max<std::chrono::milliseconds::rep>(0, ms.count()));
+}
+
+}  // namespace
+
+TimerWheel::TimerWheel(animation::TimePoint origin) : origin_(origin) {}
+
+/// Register |task| to expire at |deadline|, then every |period| if it isn't
+/// zero. Advance() is expected to have been called recently, so that the timer
+/// lands in the finest level possible.
+size_t TimerWheel::Add(animation::TimePoint deadline,
+                       Task task,
+                       animation::Duration period) {
+  const size_t id = next_id_++;
+  uint64_t period_ticks = 0;
+  if (period > animation::Duration(0)) {
+    period_ticks = std::max<uint64_t>(
+        1, CeilMilliseconds(
+               std::chrono::duration_cast<animation::Clock::duration>(period)));
+  }
+  // The current tick was already processed.
+  const uint64_t expiry = std::max(
+      current_ + 1,
+      deadline <= origin_ ? 0 : CeilMilliseconds(deadline - origin_));
+
+  Slot pending;
+  pending.push_back({id, expiry, period_ticks, std::move(task), nullptr});
+  Timer& timer = pending.front();
+  if (period_ticks != 0) {
+    if (auto* closure = std::get_if<TaskClosure>(&timer.task)) {
+      timer.closure = std::make_shared<TaskClosure>(std::move(*closure));
+    }
+  }
+  Place(&pending, -1, pending.begin());
+  return id;
+}
+
+void TimerWheel::Cancel(size_t id) {
+  auto it = index_.find(id);
+  if (it == index_.end()) {
+    return;
+  }
+  const Location& location = it->second;
+  slots_[location.level][location.slot].erase(location.it);
+  level_size_[location.level]--;
+  index_.erase(it);
+}
+
+void TimerWheel::Advance(animation::TimePoint now, std::vector<Task>* expired) {
+  const uint64_t target = Tick(now);
+  while (current_ < target) {
+    if (index_.empty()) {
+      current_ = target;
+      return;
+    }
+
+    // Nothing happens until the next turn of the finest non empty level.
+    int lowest = 0;
+    while (level_size_[lowest] == 0) {
+      ++lowest;
+    }
+    if (lowest > 0) {
+      const uint64_t granularity = uint64_t(1) << (kSlotBits * lowest);
+      const uint64_t boundary = (current_ / granularity + 1) * granularity;
+      current_ = std::min(target, boundary - 1);
+      if (current_ == target) {
+        return;
+      }
+    }
+
+    ++current_;
+    for (int level = 1; level < kLevels; ++level) {
+      const uint64_t mask = (uint64_t(1) << (kSlotBits * level)) - 1;
+      if ((current_ & mask) != 0) {
+        break;
+      }
+      Cascade(level);
+    }
+    Expire(target, expired);
+  }
+}
+
+int TimerWheel::TimeUntilNext(animation::TimePoint now) const {
+  if (index_.empty()) {
+    return -1;
+  }
+
+  // The level 0 slots are expired, and the others cascade, when the current
+  // tick reaches them. Find the first non empty one.
+  uint64_t next = std::numeric_limits<uint64_t>::max();
+  for (int level = 0; level < kLevels; ++level) {
+    if (level_size_[level] == 0) {
+      continue;
+    }
+    const int shift = kSlotBits * level;
+    for (uint64_t i = 1; i <= kSlots; ++i) {
+      const uint64_t block = (current_ >> shift) + i;
+      if (!slots_[level][block & kSlotMask].empty()) {
+        next = std::min(next, block << shift);
+        break;
+      }
+    }
+  }
+
+  const uint64_t now_tick = Tick(now);
+  if (next <= now_tick) {
+    return 0;
+  }
+  return int(std::min<uint64_t>(next - now_tick,
+                                std::numeric_limits<int>::max()));
+}
+
+uint64_t TimerWheel::Tick(animation::TimePoint time) const {
+  if (time <= origin_) {
+    return 0;
+  }
+  return uint64_t(
+      std::chrono::duration_cast<std::chrono::milliseconds>(time - origin_)
+          .count());
+}
+
+// Move the timer |it| out of |from|, into the slot matching its expiry. The
+// expiry must not be earlier than the current tick.
+void TimerWheel::Place(Slot* from, int from_level, Slot::iterator it) {
+  const uint64_t delta = it->expiry - current_;
+
+  int level = 0;
+  while (level < kLevels - 1 &&
+         delta >= (uint64_t(1) << (kSlotBits * (level + 1)))) {
+    ++level;
+  }
+
+  // Timers beyond the range of the wheel are parked in the farthest slot, and
+  // placed again when it cascades.
+  const uint64_t range = uint64_t(1) << (kSlotBits * kLevels);
+  const uint64_t expiry = std::min(it->expiry, current_ + range - 1);
+  const uint64_t slot = (expiry >> (kSlotBits * level)) & kSlotMask;
+
+  Slot& to = slots_[level][slot];
+  to.splice(to.end(), *from, it);
+  if (from_level >= 0) {
+    level_size_[from_level]--;
+  }
+  level_size_[level]++;
+  index_[it->id] = {level, slot, it};
+}
+
+// Redistribute the current slot of |level| into the finer levels.
+void TimerWheel::Cascade(int level) {
+  Slot& slot = slots_[level][(current_ >> (kSlotBits * level)) & kSlotMask];
+  while (!slot.empty()) {
+    Place(&slot, level, slot.begin());
+  }
+}
+
+// Expire the timers of the current slot. Periodic timers are placed again,
+// skipping the periods already elapsed by |now|.
+void TimerWheel::Expire(uint64_t now, std::vector<Task>* expired) {
+  Slot& slot = slots_[0][current_ & kSlotMask];
+  auto it = slot.begin();
+  while (it != slot.end()) {
+    auto next = std::next(it);
+    if (it->expiry > current_) {
+      Place(&slot, 0, it);
+    } else if (it->period != 0) {
+      expired->push_back(Repeat(*it));
+      it->expiry += it->period;
+      if (it->expiry <= now) {
+        it->expiry += it->period * ((now - it->expiry) / it->period + 1);
+      }
+      Place(&slot, 0, it);
+    } else {
+      expired->push_back(std::move(it->task));
+      index_.erase(it->id);
+      level_size_[0]--;
+      slot.erase(it);
+    }
+    it = next;
+  }
+}
+
+// The task posted by an expiry of the periodic |timer|.
+// static
+Task TimerWheel::Repeat(const Timer& timer) {
+  if (timer.closure) {
+    return TaskClosure([closure = timer.closure] { (*closure)(); });
+  }
+  if (const auto* event = std::get_if<Event>(&timer.task)) {
+    return *event;
+  }
+  return AnimationTask();
+}
+
+}  // namespace ftxui
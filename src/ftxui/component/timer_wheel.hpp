@@ -0,0 +1,91 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_TIMER_WHEEL_HPP
+#define FTXUI_COMPONENT_TIMER_WHEEL_HPP
+
+#include <array>          // for array
+#include <cstddef>        // for size_t
+#include <cstdint>        // for uint64_t
+#include <list>           // for list
+#include <memory>         // for shared_ptr
+#include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
+
+#include "ftxui/component/animation.hpp"  // for TimePoint, Duration
+#include "ftxui/component/task.hpp"       // for Task
+
+namespace ftxui {
+
+// A hierarchical timer wheel, with a resolution of one millisecond. Adding,
+// cancelling and expiring a timer are O(1). Advancing the time costs O(1) per
+// millisecond elapsed, and nothing while no timer is pending below the
+// coarsest non empty level.
+//
+// The timers are kept in 4 levels of 256 slots. The level 0 holds the
+// timers expiring during the next 256 milliseconds, one slot per millisecond.
+// The level L holds the timers expiring later, with slots 256^L milliseconds
+// wide. Every time a level completes a turn, the next slot of the level
+// above is redistributed into the finer levels.
+class TimerWheel {
+ public:
+  explicit TimerWheel(animation::TimePoint origin);
+
+  // Register |task| to expire at |deadline|, then every |period| if not zero.
+  // Return an id, to cancel it.
+  size_t Add(animation::TimePoint deadline,
+             Task task,
+             animation::Duration period = animation::Duration(0));
+  void Cancel(size_t id);
+
+  // Move the time forward up to |now|, and append the tasks of the timers
+  // expired to |expired|, by deadline.
+  void Advance(animation::TimePoint now, std::vector<Task>* expired);
+
+  // The number of milliseconds after which Advance() might have something to
+  // do, or -1 if no timer is pending. This is never later than the next
+  // deadline.
+  int TimeUntilNext(animation::TimePoint now) const;
+
+  size_t size() const { return index_.size(); }
+
+ private:
+  static constexpr int kLevels = 4;
+  static constexpr int kSlotBits = 8;
+  static constexpr uint64_t kSlots = uint64_t(1) << kSlotBits;
+  static constexpr uint64_t kSlotMask = kSlots - 1;
+
+  struct Timer {
+    size_t id;
+    uint64_t expiry;  // In ticks.
+    uint64_t period;  // In ticks. Zero for one shot timers.
+    Task task;
+    // The closure of a periodic timer. It isn't copyable: every expiry posts a
+    // closure calling this one.
+    std::shared_ptr<TaskClosure> closure;
+  };
+  using Slot = std::list<Timer>;
+
+  struct Location {
+    int level;
+    uint64_t slot;
+    Slot::iterator it;
+  };
+
+  uint64_t Tick(animation::TimePoint time) const;
+  void Place(Slot* from, int from_level, Slot::iterator it);
+  void Cascade(int level);
+  void Expire(uint64_t now, std::vector<Task>* expired);
+  static Task Repeat(const Timer& timer);
+
+  animation::TimePoint origin_;
+  uint64_t current_ = 0;  // The last tick processed.
+  size_t next_id_ = 1;
+  std::array<std::array<Slot, kSlots>, kLevels> slots_;
+  std::array<size_t, kLevels> level_size_{};
+  std::unordered_map<size_t, Location> index_;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_TIMER_WHEEL_HPP
@@ -0,0 +1,177 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <chrono>   // for milliseconds
+#include <random>   // for mt19937, uniform_int_distribution
+#include <variant>  // for get
+#include <vector>   // for vector
+
+#include "ftxui/component/animation.hpp"    // for TimePoint, Clock
+#include "ftxui/component/task.hpp"         // for Task, TaskClosure
+#include "ftxui/component/timer_wheel.hpp"  // for TimerWheel
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+
+const animation::TimePoint origin = animation::Clock::now();
+
+animation::TimePoint At(int ms) {
+  return origin + std::chrono::milliseconds(ms);
+}
+
+// Advance |wheel| to |ms|, and run the tasks expired.
+void AdvanceTo(TimerWheel& wheel, int ms) {
+  std::vector<Task> expired;
+  wheel.Advance(At(ms), &expired);
+  for (auto& task : expired) {
+    std::get<TaskClosure>(task)();
+  }
+}
+
+}  // namespace
+
+TEST(TimerWheel, OneShot) {
+  TimerWheel wheel(origin);
+  int fired = 0;
+  wheel.Add(At(10), [&] { fired++; });
+  EXPECT_EQ(wheel.size(), 1u);
+
+  AdvanceTo(wheel, 9);
+  EXPECT_EQ(fired, 0);
+  AdvanceTo(wheel, 10);
+  EXPECT_EQ(fired, 1);
+  AdvanceTo(wheel, 1000);
+  EXPECT_EQ(fired, 1);
+  EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(TimerWheel, OrderAcrossLevels) {
+  TimerWheel wheel(origin);
+  std::vector<int> fired;
+  for (int ms : {70000, 5, 300, 1, 256}) {
+    wheel.Add(At(ms), [&fired, ms] { fired.push_back(ms); });
+  }
+
+  AdvanceTo(wheel, 100000);
+  EXPECT_EQ(fired, (std::vector<int>{1, 5, 256, 300, 70000}));
+}
+
+TEST(TimerWheel, ExpireOnTime) {
+  TimerWheel wheel(origin);
+  std::vector<int> deadlines = {1, 255, 256, 257, 511, 512, 65535, 65536,
+                                65537, 70000};
+  std::vector<int> fired_at(deadlines.size(), -1);
+  int now = 0;
+  for (size_t i = 0; i < deadlines.size(); ++i) {
+    wheel.Add(At(deadlines[i]), [&, i] { fired_at[i] = now; });
+  }
+
+  for (now = 1; now <= 70000; ++now) {
+    AdvanceTo(wheel, now);
+  }
+  EXPECT_EQ(fired_at, deadlines);
+}
+
+TEST(TimerWheel, Periodic) {
+  TimerWheel wheel(origin);
+  int fired = 0;
+  wheel.Add(At(10), [&] { fired++; }, std::chrono::milliseconds(10));
+
+  for (int ms = 1; ms <= 35; ++ms) {
+    AdvanceTo(wheel, ms);
+  }
+  EXPECT_EQ(fired, 3);
+
+  // The periods elapsed in between are skipped.
+  AdvanceTo(wheel, 100);
+  EXPECT_EQ(fired, 4);
+  AdvanceTo(wheel, 109);
+  EXPECT_EQ(fired, 4);
+  AdvanceTo(wheel, 110);
+  EXPECT_EQ(fired, 5);
+  EXPECT_EQ(wheel.size(), 1u);
+}
+
+TEST(TimerWheel, Cancel) {
+  TimerWheel wheel(origin);
+  int fired = 0;
+  const size_t a = wheel.Add(At(10), [&] { fired++; });
+  const size_t b = wheel.Add(At(1000), [&] { fired += 10; },
+                             std::chrono::milliseconds(5));
+  wheel.Add(At(20), [&] { fired += 100; });
+
+  wheel.Cancel(a);
+  wheel.Cancel(b);
+  wheel.Cancel(b);
+  EXPECT_EQ(wheel.size(), 1u);
+
+  AdvanceTo(wheel, 2000);
+  EXPECT_EQ(fired, 100);
+}
+
+TEST(TimerWheel, TimeUntilNext) {
+  TimerWheel wheel(origin);
+  EXPECT_EQ(wheel.TimeUntilNext(At(0)), -1);
+
+  wheel.Add(At(10), [] {});
+  EXPECT_EQ(wheel.TimeUntilNext(At(0)), 10);
+  EXPECT_EQ(wheel.TimeUntilNext(At(4)), 6);
+  EXPECT_EQ(wheel.TimeUntilNext(At(20)), 0);
+  AdvanceTo(wheel, 10);
+  EXPECT_EQ(wheel.TimeUntilNext(At(10)), -1);
+
+  // A far timer is reached in a few wake ups, never too late.
+  int fired = 0;
+  wheel.Add(At(100000), [&] { fired++; });
+  int now = 10;
+  int wake_ups = 0;
+  while (fired == 0) {
+    const int timeout = wheel.TimeUntilNext(At(now));
+    ASSERT_GT(timeout, 0);
+    now += timeout;
+    ASSERT_LE(now, 100000);
+    AdvanceTo(wheel, now);
+    wake_ups++;
+  }
+  EXPECT_EQ(now, 100000);
+  EXPECT_LE(wake_ups, 10);
+}
+
+TEST(TimerWheel, Many) {
+  TimerWheel wheel(origin);
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> deadline(1, 200000);
+  std::uniform_int_distribution<int> step(1, 2000);
+
+  const int count = 10000;
+  std::vector<int> deadlines(count);
+  std::vector<int> fired_at(count, -1);
+  int previous = 0;
+  int now = 0;
+  for (int i = 0; i < count; ++i) {
+    deadlines[i] = deadline(random);
+    wheel.Add(At(deadlines[i]), [&, i] {
+      EXPECT_EQ(fired_at[i], -1);
+      fired_at[i] = now;
+      // Expired by the first Advance() reaching the deadline.
+      EXPECT_GT(deadlines[i], previous);
+      EXPECT_LE(deadlines[i], now);
+    });
+  }
+
+  while (now <= 200000) {
+    previous = now;
+    now += step(random);
+    AdvanceTo(wheel, now);
+  }
+  EXPECT_EQ(wheel.size(), 0u);
+  for (int i = 0; i < count; ++i) {
+    EXPECT_NE(fired_at[i], -1);
+  }
+}
+
+}  // namespace ftxui
+// NOLINTEND
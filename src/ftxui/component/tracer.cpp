@@ -0,0 +1,134 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/component/tracer.hpp"
+
+#include <algorithm>   // for max, min
+#include <array>       // for array
+#include <chrono>      // for duration_cast, microseconds
+#include <cstdio>      // for snprintf
+#include <functional>  // for hash
+#include <mutex>       // for lock_guard
+#include <string>      // for string
+#include <thread>      // for this_thread, thread
+#include <utility>     // for move
+
+#include "ftxui/component/screen_interactive.hpp"  // for ScreenInteractive
+#include "ftxui/component/trace.hpp"               // for TraceSpan
+
+namespace ftxui {
+
+namespace {
+
+void WriteEscaped(std::ostream& out, const std::string& value) {
+  for (const char c : value) {
+    switch (c) {
+      case '"':
+        out << "\\\"";
+        break;
+      case '\\':
+        out << "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {  // NOLINT
+          std::array<char, 8> buffer{};                // NOLINT
+          (void)std::snprintf(buffer.data(), buffer.size(), "\\u%04x",
+                              int(c));  // NOLINT
+          out << buffer.data();
+        } else {
+          out << c;
+        }
+    }
+  }
+}
+
+}  // namespace
+
+Tracer::Tracer(size_t capacity)
+    : origin_(animation::Clock::now()), spans_(std::max<size_t>(capacity, 1)) {}
+
+void Tracer::Add(const char* name,
+                 animation::TimePoint start,
+                 animation::TimePoint end,
+                 std::string detail) {
+  const size_t thread = std::hash<std::thread::id>()(std::this_thread::get_id());
+  const std::lock_guard<std::mutex> lock(mutex_);
+  Span& span = spans_[count_ % spans_.size()];
+  span.name = name;
+  span.detail = std::move(detail);
+  span.start = start;
+  span.end = end;
+  span.thread = thread;
+  count_++;
+}
+
+void Tracer::Write(std::ostream& out) const {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  auto microseconds = [](animation::Clock::duration duration) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+        .count();
+  };
+
+  // The thread ids are hashes. They are renumbered from 1, in the order of
+  // appearance.
+  std::vector<size_t> threads;
+  auto thread_index = [&](size_t thread) {
+    const auto it = std::find(threads.begin(), threads.end(), thread);
+    if (it != threads.end()) {
+      return size_t(it - threads.begin()) + 1;
+    }
+    threads.push_back(thread);
+    return threads.size();
+  };
+
+  out << "{\"traceEvents\":[";
+  const size_t size = std::min(count_, spans_.size());
+  for (size_t i = 0; i < size; ++i) {
+    // Oldest first.
+    const Span& span = spans_[(count_ - size + i) % spans_.size()];
+    out << (i == 0 ? "\n" : ",\n");
+    out << R"({"name":")" << span.name << R"(","cat":"ftxui","ph":"X")"
+        << ",\"ts\":" << microseconds(span.start - origin_)
+        << ",\"dur\":" << microseconds(span.end - span.start)
+        << ",\"pid\":1,\"tid\":" << thread_index(span.thread);
+    if (!span.detail.empty()) {
+      out << R"(,"args":{"detail":")";
+      WriteEscaped(out, span.detail);
+      out << "\"}";
+    }
+    out << "}";
+  }
+  out << "\n]}\n";
+}
+
+/// @brief Record a span of the trace of the active ScreenInteractive, from the
+/// construction of this object to its destruction. This does nothing unless
+/// the trace is recorded, see ScreenInteractive::RecordTrace().
+/// @param name The name of the span. It must outlive the trace, like a string
+/// literal.
+/// @ingroup component
+///
+/// ### Example
+///
+/// ```cpp
+/// auto renderer = Renderer([&] {
+///   TraceSpan span("Sidebar");
+///   return RenderSidebar();
+/// });
+/// ```
+TraceSpan::TraceSpan(const char* name) : name_(name) {
+  if (auto* screen = ScreenInteractive::Active()) {
+    tracer_ = ScreenInteractive::Private::Trace(*screen);
+  }
+  if (tracer_) {
+    start_ = animation::Clock::now();
+  }
+}
+
+TraceSpan::~TraceSpan() {
+  if (tracer_) {
+    tracer_->Add(name_, start_, animation::Clock::now());
+  }
+}
+
+}  // namespace ftxui
@@ -0,0 +1,49 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_TRACER_HPP
+#define FTXUI_COMPONENT_TRACER_HPP
+
+#include <cstddef>  // for size_t
+#include <mutex>    // for mutex
+#include <ostream>  // for ostream
+#include <string>   // for string
+#include <vector>   // for vector
+
+#include "ftxui/component/animation.hpp"  // for TimePoint
+
+namespace ftxui {
+
+// Record the last spans of time, in a ring buffer, and write them in the
+// Chrome trace event format. This is read by chrome://tracing and Perfetto.
+// Spans can be added from any thread.
+class Tracer {
+ public:
+  explicit Tracer(size_t capacity);
+
+  // |name| must outlive the Tracer, like a string literal.
+  void Add(const char* name,
+           animation::TimePoint start,
+           animation::TimePoint end,
+           std::string detail = "");
+
+  void Write(std::ostream& out) const;
+
+ private:
+  struct Span {
+    const char* name = nullptr;
+    std::string detail;
+    animation::TimePoint start;
+    animation::TimePoint end;
+    size_t thread = 0;
+  };
+
+  const animation::TimePoint origin_;
+  mutable std::mutex mutex_;
+  std::vector<Span> spans_;
+  size_t count_ = 0;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_TRACER_HPP
@@ -0,0 +1,299 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <algorithm>   // for max, min
+#include <cstddef>     // for size_t
+#include <cstdint>     // for int64_t
+#include <functional>  // for function
+#include <memory>      // for unique_ptr, make_unique
+#include <string>      // for string
+#include <utility>     // for move
+#include <vector>      // for vector
+
+#include "ftxui/component/component.hpp"  // for Make, DBMenu, TreeView
+#include "ftxui/component/component_base.hpp"  // for Component, ComponentBase
+#include "ftxui/component/component_options.hpp"  // for TreeViewOption, TreeNodeState, DataSource
+#include "ftxui/component/event.hpp"  // for Event, Event::ArrowLeft, Event::ArrowRight, Event::Return
+#include "ftxui/dom/elements.hpp"  // for operator|=, Element, text, bold, inverted
+
+namespace ftxui {
+
+namespace {
+
+// A node fetched from the model. Its children are kept once fetched, with
+// their expanded state, when it is collapsed.
+struct TreeNode {
+  int64_t id = 0;
+  TreeNode* parent = nullptr;
+  size_t index = 0;  // In |parent->children|.
+  int depth = -1;
+  bool fetched = false;
+  bool expanded = false;
+  // The rows of the node and of its visible descendants.
+  int64_t visible = 1;
+  std::vector<std::unique_ptr<TreeNode>> children;
+  // Fenwick tree over the |visible| of the children, 1-based.
+  std::vector<int64_t> tree;
+
+  // The rows of the children before |position|, and their descendants.
+  int64_t RowsBefore(size_t position) const {
+    int64_t rows = 0;
+    for (size_t i = position; i > 0; i -= i & (~i + 1)) {
+      rows += tree[i];
+    }
+    return rows;
+  }
+
+  void AddRows(size_t position, int64_t delta) {
+    for (size_t i = position + 1; i < tree.size(); i += i & (~i + 1)) {
+      tree[i] += delta;
+    }
+  }
+
+  // The child whose rows contain |row|, and the row within them.
+  size_t ChildAt(int64_t* row) const {
+    const size_t size = tree.size() - 1;
+    size_t step = 1;
+    while (step * 2 <= size) {
+      step *= 2;
+    }
+    size_t position = 0;
+    for (; step > 0; step /= 2) {
+      if (position + step <= size && tree[position + step] <= *row) {
+        position += step;
+        *row -= tree[position];
+      }
+    }
+    return position;
+  }
+};
+
+Element DefaultTransform(const TreeNodeState& state) {
+  std::string prefix(size_t(state.depth) * 2, ' ');
+  if (!state.expandable) {
+    prefix += "  ";
+  } else {
+    prefix += state.expanded ? "▾ " : "▸ ";  // NOLINT
+  }
+  Element element = text(prefix + state.label);
+  if (state.focused) {
+    element |= inverted;
+  }
+  if (state.active) {
+    element |= bold;
+  }
+  return element;
+}
+
+}  // namespace
+
+/// @brief A tree of nodes, fetched lazily from a model. The user can navigate
+/// through them, and expand or collapse them.
+///
+/// Only the visible rows are rendered, by a DBMenu. Every node fetched keeps
+/// the number of rows of its subtree in a Fenwick tree over its children, so
+/// that expanding or collapsing a node updates its ancestors, and finding the
+/// node of a row walks down the tree, both in O(depth * log(children)).
+///
+/// The arrow right expands the focused node, or focuses its first child. The
+/// arrow left collapses it, or focuses its parent. Return and space toggle it.
+/// @param option The model, and how to display its nodes.
+/// @ingroup component
+///
+/// ### Example
+///
+/// ```cpp
+/// auto tree = TreeView({
+///   .root = root_inode,
+///   .children = [&](int64_t node) { return ListDirectory(node); },
+///   .expandable = [&](int64_t node) { return IsDirectory(node); },
+///   .label = [&](int64_t node) { return Name(node); },
+/// });
+/// ```
+// NOLINTNEXTLINE
+Component TreeView(TreeViewOption option) {
+  class Impl : public ComponentBase, public TreeViewOption {
+   public:
+    explicit Impl(TreeViewOption option) : TreeViewOption(std::move(option)) {
+      FillDefault();
+      root_.id = root;
+      Toggle(&root_, true);
+      menu_ = DBMenu(&source_);
+      Add(menu_);
+    }
+
+    Element Render() override { return menu_->Render(); }
+
+   private:
+    void FillDefault() {
+      if (!transform) {
+        transform = DefaultTransform;
+      }
+      if (!label) {
+        label = [](int64_t node) { return std::to_string(node); };
+      }
+
+      // The ids of the DataSource are the indices of the visible rows.
+      source_.dataset_size = [this] {
+        const int64_t size = root_.visible - 1;
+        return DataSize{size, 0, size - 1};
+      };
+      source_.count_items_before = [](int64_t id) { return id; };
+      source_.move_id_by = [this](int64_t& id, int64_t offset) {
+        const int64_t initial = id;
+        id = std::max<int64_t>(0, std::min(id + offset, root_.visible - 2));
+        return id != initial;
+      };
+      source_.id_to_index = [](int64_t id) { return id; };
+      source_.index_to_id = [](int64_t index) { return index; };
+      source_.on_event = [this](DSEventContext context) {
+        return context.handled || (context.focused && Navigate(context.event));
+      };
+      source_.transform = [this](DSRenderContext& context) {
+        TreeNode* node = At(context.id);
+        return transform({
+            node->id,
+            label(node->id),
+            node->depth,
+            Expandable(node),
+            node->expanded,
+            context.focused,
+            context.focused && context.component_focused,
+        });
+      };
+    }
+
+    bool Navigate(const Event& event) {
+      if (root_.visible <= 1) {
+        return false;
+      }
+      TreeNode* node = At(source_.focused_id);
+      if (event == Event::Return || event == Event::Character(' ')) {
+        return Toggle(node, !node->expanded);
+      }
+      if (event == Event::ArrowRight) {
+        if (!node->expanded) {
+          return Toggle(node, true);
+        }
+        if (!node->children.empty()) {
+          source_.focused_id++;
+          return true;
+        }
+        return false;
+      }
+      if (event == Event::ArrowLeft) {
+        if (node->expanded) {
+          return Toggle(node, false);
+        }
+        if (node->parent != &root_) {
+          source_.focused_id = IndexOf(node->parent);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    bool Expandable(TreeNode* node) const {
+      if (node->fetched) {
+        return !node->children.empty();
+      }
+      return expandable ? expandable(node->id) : true;
+    }
+
+    void Fetch(TreeNode* node) {
+      node->fetched = true;
+      std::vector<int64_t> ids = children ? children(node->id)
+                                          : std::vector<int64_t>();
+      node->children.reserve(ids.size());
+      // Every child is a single row: build the tree in O(children).
+      node->tree.assign(ids.size() + 1, 0);
+      for (size_t i = 0; i < ids.size(); ++i) {
+        auto child = std::make_unique<TreeNode>();
+        child->id = ids[i];
+        child->parent = node;
+        child->index = i;
+        child->depth = node->depth + 1;
+        node->children.push_back(std::move(child));
+
+        const size_t position = i + 1;
+        node->tree[position] += 1;
+        const size_t parent = position + (position & (~position + 1));
+        if (parent < node->tree.size()) {
+          node->tree[parent] += node->tree[position];
+        }
+      }
+    }
+
+    // Show or hide the children of |node|, and update the rows counted by its
+    // ancestors. The focused row stays on the same node, or else on |node|.
+    bool Toggle(TreeNode* node, bool expand) {
+      if (node->expanded == expand) {
+        return false;
+      }
+      TreeNode* focused =
+          root_.visible > 1 ? At(source_.focused_id) : nullptr;
+      if (expand && !node->fetched) {
+        Fetch(node);
+      }
+      node->expanded = expand;
+      const int64_t rows = node->RowsBefore(node->children.size());
+      const int64_t delta = expand ? rows : -rows;
+      node->visible += delta;
+      for (TreeNode* it = node; it->parent; it = it->parent) {
+        it->parent->AddRows(it->index, delta);
+        if (!it->parent->expanded) {
+          break;
+        }
+        it->parent->visible += delta;
+      }
+
+      if (focused) {
+        source_.focused_id = IndexOf(IsVisible(focused) ? focused : node);
+      }
+      if (node != &root_ && on_toggle) {
+        on_toggle(node->id, expand);
+      }
+      return true;
+    }
+
+    bool IsVisible(TreeNode* node) const {
+      for (TreeNode* it = node->parent; it; it = it->parent) {
+        if (!it->expanded) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    // The node displayed on the row |index|.
+    TreeNode* At(int64_t index) {
+      TreeNode* node = &root_;
+      int64_t row = index;
+      while (true) {
+        TreeNode* child = node->children[node->ChildAt(&row)].get();
+        if (row == 0) {
+          return child;
+        }
+        node = child;
+        row--;
+      }
+    }
+
+    // The row displaying |node|.
+    int64_t IndexOf(TreeNode* node) const {
+      int64_t index = -1;
+      for (TreeNode* it = node; it->parent; it = it->parent) {
+        index += it->parent->RowsBefore(it->index) + 1;
+      }
+      return index;
+    }
+
+    TreeNode root_;
+    DataSource source_;
+    Component menu_;
+  };
+
+  return Make<Impl>(std::move(option));
+}
+
+}  // namespace ftxui
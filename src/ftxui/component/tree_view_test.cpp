@@ -0,0 +1,119 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <cstdint>  // for int64_t
+#include <string>   // for string
+#include <vector>   // for vector
+
+#include "ftxui/component/component.hpp"       // for TreeView
+#include "ftxui/component/component_options.hpp"  // for TreeViewOption
+#include "ftxui/component/event.hpp"  // for Event, Event::ArrowDown, Event::ArrowLeft, Event::ArrowRight, Event::End
+#include "ftxui/dom/elements.hpp"   // for text
+#include "ftxui/dom/node.hpp"       // for Render
+#include "ftxui/screen/screen.hpp"  // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+
+// The root 0 has the children 1, 2 and 3. The node 2 has 100000 children,
+// 1000 to 100999. The node 1000 has the children 4 and 5.
+TreeViewOption MakeOption(std::vector<int64_t>* fetched) {
+  TreeViewOption option;
+  option.children = [fetched](int64_t node) {
+    fetched->push_back(node);
+    std::vector<int64_t> children;
+    if (node == 0) {
+      children = {1, 2, 3};
+    } else if (node == 2) {
+      for (int64_t i = 0; i < 100000; ++i) {
+        children.push_back(1000 + i);
+      }
+    } else if (node == 1000) {
+      children = {4, 5};
+    }
+    return children;
+  };
+  option.expandable = [](int64_t node) { return node == 2 || node == 1000; };
+  option.transform = [](const TreeNodeState& state) {
+    return text(std::string(size_t(state.depth), ' ') +
+                (state.focused ? ">" : "") + std::to_string(state.node));
+  };
+  return option;
+}
+
+std::string Draw(Component tree) {
+  Screen screen(10, 4);
+  Render(screen, tree->Render());
+  std::string out;
+  for (int y = 0; y < 4; ++y) {
+    for (int x = 0; x < 9; ++x) {
+      out += screen.PixelAt(x, y).character.empty()
+                 ? " "
+                 : screen.PixelAt(x, y).character;
+    }
+    out += "|";
+  }
+  return out;
+}
+
+}  // namespace
+
+TEST(TreeViewTest, Lazy) {
+  std::vector<int64_t> fetched;
+  auto tree = TreeView(MakeOption(&fetched));
+  EXPECT_EQ(Draw(tree), ">1       |2        |3        |         |");
+  EXPECT_EQ(fetched, std::vector<int64_t>({0}));
+
+  // Expanding the node with 100000 children fetches it once.
+  tree->OnEvent(Event::ArrowDown);
+  tree->OnEvent(Event::ArrowRight);
+  EXPECT_EQ(Draw(tree), "1        |>2       | 1000    | 1001    |");
+  EXPECT_EQ(fetched, std::vector<int64_t>({0, 2}));
+
+  tree->OnEvent(Event::ArrowRight);
+  tree->OnEvent(Event::ArrowRight);
+  EXPECT_EQ(Draw(tree), "1        |2        | >1000   |  4      |");
+
+  // The last row is after the 100000 children, and the 2 grandchildren.
+  tree->OnEvent(Event::End);
+  EXPECT_EQ(Draw(tree), " 100997  | 100998  | 100999  |>3       |");
+}
+
+TEST(TreeViewTest, Collapse) {
+  std::vector<int64_t> fetched;
+  int toggles = 0;
+  TreeViewOption option = MakeOption(&fetched);
+  option.on_toggle = [&](int64_t, bool) { toggles++; };
+  auto tree = TreeView(option);
+
+  tree->OnEvent(Event::ArrowDown);
+  tree->OnEvent(Event::ArrowRight);  // Expand 2.
+  tree->OnEvent(Event::ArrowRight);  // Focus 1000.
+  tree->OnEvent(Event::ArrowRight);  // Expand 1000.
+  tree->OnEvent(Event::ArrowRight);  // Focus 4.
+  EXPECT_EQ(toggles, 2);
+
+  // Collapsing 2 moves the focus from 4 to 2.
+  tree->OnEvent(Event::ArrowUp);
+  tree->OnEvent(Event::ArrowUp);
+  tree->OnEvent(Event::ArrowLeft);  // Collapse 2.
+  EXPECT_EQ(toggles, 3);
+  EXPECT_EQ(Draw(tree), "1        |>2       |3        |         |");
+
+  // Expanding 2 again restores 1000 expanded, without fetching.
+  tree->OnEvent(Event::Return);
+  EXPECT_EQ(Draw(tree), "1        |>2       | 1000    |  4      |");
+  EXPECT_EQ(fetched, std::vector<int64_t>({0, 2, 1000}));
+
+  // The arrow left on a leaf focuses its parent.
+  tree->OnEvent(Event::ArrowDown);
+  tree->OnEvent(Event::ArrowDown);
+  tree->OnEvent(Event::ArrowLeft);
+  EXPECT_EQ(Draw(tree), "1        |2        | >1000   |  4      |");
+}
+
+}  // namespace ftxui
+// NOLINTEND
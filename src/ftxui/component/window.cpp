@@ -3,14 +3,22 @@
 // the LICENSE file.
 #define NOMINMAX
 #include <algorithm>
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint16_t
+#include <ftxui/component/animation.hpp>  // for Params
 #include <ftxui/component/component.hpp>
 #include <ftxui/component/component_base.hpp>
 #include <ftxui/component/component_options.hpp>
 #include <ftxui/component/screen_interactive.hpp>  // for ScreenInteractive
 #include <memory>
+#include <string>
+#include <tuple>
 #include <utility>
+#include <vector>
 #include "ftxui/dom/elements.hpp"  // for text, window, hbox, vbox, size, clear_under, reflect, emptyElement
+#include "ftxui/dom/node.hpp"            // for Node
 #include "ftxui/dom/node_decorator.hpp"  // for NodeDecorator
+#include "ftxui/screen/box.hpp"          // for Box
 #include "ftxui/screen/color.hpp"        // for Color
 #include "ftxui/screen/screen.hpp"       // for Screen
 
@@ -91,6 +99,114 @@ class ResizeDecorator : public NodeDecorator {
   const bool resize_down_;
 };
 
+// The pixels of a window, kept across frames. As long as it is assigned the
+// same box, its layout is kept, like with Memo, and it is drawn by copying the
+// pixels back instead of rendering its subtree. The window must paint every
+// cell of its box: the default one does, using clear_under.
+class LayerNode : public Node {
+ public:
+  explicit LayerNode(Element child) : Node(unpack(std::move(child))) {}
+
+  void ComputeRequirement() override {
+    if (layout_valid_) {
+      return;
+    }
+    Node::ComputeRequirement();
+    requirement_ = children_[0]->requirement();
+  }
+
+  void SetBox(Box box) override {
+    if (layout_valid_) {
+      if (box == box_) {
+        return;
+      }
+      layout_valid_ = false;
+      need_iteration_ = true;
+      Status status;
+      CheckChild(children_[0].get(), &status);
+    }
+    pixels_valid_ = false;
+    Node::SetBox(box);
+    children_[0]->SetBox(box);
+  }
+
+  void Check(Status* status) override {
+    if (layout_valid_) {
+      status->need_iteration |= (status->iteration == 0);
+    } else {
+      Node::Check(status);
+    }
+    status->need_iteration |= need_iteration_;
+    need_iteration_ = false;
+  }
+
+  void Render(Screen& screen) override {
+    const Box visible = Box::Intersection(box_, screen.stencil);
+    if (pixels_valid_ && visible == visible_) {
+      Blit(screen);
+      return;
+    }
+    Node::Render(screen);
+    layout_valid_ = true;
+    Capture(screen, visible);
+  }
+
+ private:
+  // The hyperlink ids are only valid for the current frame of the screen. The
+  // pixels captured refer to |links_| instead, from 1.
+  void Capture(Screen& screen, Box visible) {
+    visible_ = visible;
+    pixels_.clear();
+    links_.clear();
+    std::vector<uint16_t> link_ids;  // The screen's id of every link.
+    for (int y = visible.y_min; y <= visible.y_max; ++y) {
+      for (int x = visible.x_min; x <= visible.x_max; ++x) {
+        Pixel& pixel =
+            pixels_.emplace_back(std::as_const(screen).PixelAt(x, y));
+        if (pixel.hyperlink == 0) {
+          continue;
+        }
+        const auto it =
+            std::find(link_ids.begin(), link_ids.end(), pixel.hyperlink);
+        if (it == link_ids.end()) {
+          link_ids.push_back(pixel.hyperlink);
+          links_.push_back(screen.Hyperlink(pixel.hyperlink));
+          pixel.hyperlink = uint16_t(links_.size());
+        } else {
+          pixel.hyperlink = uint16_t(it - link_ids.begin() + 1);
+        }
+      }
+    }
+    pixels_valid_ = true;
+  }
+
+  // Register the links again, for the frame drawn.
+  void Blit(Screen& screen) const {
+    std::vector<uint16_t> link_ids;
+    link_ids.reserve(links_.size());
+    for (const std::string& link : links_) {
+      link_ids.push_back(screen.RegisterHyperlink(link));
+    }
+    auto pixel = pixels_.begin();
+    for (int y = visible_.y_min; y <= visible_.y_max; ++y) {
+      for (int x = visible_.x_min; x <= visible_.x_max; ++x) {
+        Pixel& drawn = screen.PixelAt(x, y);
+        drawn = *pixel++;
+        if (drawn.hyperlink != 0) {
+          drawn.hyperlink = link_ids[drawn.hyperlink - 1];
+        }
+      }
+    }
+  }
+
+  bool layout_valid_ = false;
+  bool need_iteration_ = false;
+  bool pixels_valid_ = false;
+  Box visible_;
+  std::vector<Pixel> pixels_;
+  std::vector<std::string> links_;
+};
+
 Element DefaultRenderState(const WindowRenderState& state) {
   Element element = state.inner;
   if (!state.active) {
@@ -125,10 +241,28 @@ class WindowImpl : public ComponentBase, public WindowOptions {
 
  private:
   Element Render() final {
-    auto element = ComponentBase::Render();
-
     const bool captureable =
         captured_mouse_ || ScreenInteractive::Active()->CaptureMouse();
+    const bool hover_left = (resize_left_hover_ || resize_left_) && captureable;
+    const bool hover_right =
+        (resize_right_hover_ || resize_right_) && captureable;
+    const bool hover_top = (resize_top_hover_ || resize_top_) && captureable;
+    const bool hover_down = (resize_down_hover_ || resize_down_) && captureable;
+
+    // Reuse the layer of the previous frame, unless the window changed.
+    if (layer) {
+      const int hover = hover_left | hover_right << 1 | hover_top << 2 |  //
+                        hover_down << 3;
+      LayerKey key{layer(), left(),   top(),     width(), height(),
+                   title(), Active(), Focused(), hover};
+      if (layer_element_ && !layer_dirty_ && key == layer_key_) {
+        return layer_element_;
+      }
+      layer_key_ = std::move(key);
+      layer_dirty_ = false;
+    }
+
+    auto element = ComponentBase::Render();
 
     const WindowRenderState state = {
         element,
@@ -136,23 +270,55 @@ class WindowImpl : public ComponentBase, public WindowOptions {
         Active(),
         drag_,
         resize_left_ || resize_right_ || resize_down_ || resize_top_,
-        (resize_left_hover_ || resize_left_) && captureable,
-        (resize_right_hover_ || resize_right_) && captureable,
-        (resize_top_hover_ || resize_top_) && captureable,
-        (resize_down_hover_ || resize_down_) && captureable,
+        hover_left,
+        hover_right,
+        hover_top,
+        hover_down,
     };
 
     element = render ? render(state) : DefaultRenderState(state);
 
     // Position and record the drawn area of the window.
     element |= reflect(box_window_);
+    if (layer) {
+      element = std::make_shared<LayerNode>(std::move(element));
+    }
     element |= PositionAndSize(left(), top(), width(), height());
     element |= reflect(box_);
 
+    if (layer) {
+      layer_element_ = element;
+    }
     return element;
   }
 
   bool OnEvent(Event event) final {
+    const bool handled = HandleEvent(event);
+    // Like Memo: the mouse events received while another component holds the
+    // mouse don't change the window.
+    layer_dirty_ |= handled || (event.is_mouse() && !MouseCaptured(event));
+    return handled;
+  }
+
+  void OnAnimation(animation::Params& params) final {
+    const size_t requests = Private::RequestCount();
+    ComponentBase::OnAnimation(params);
+    layer_dirty_ = true;
+
+    // Like Memo: the components below are animated through the window, so
+    // that its layer is rendered again.
+    if (Private::RequestCount() != requests) {
+      Private::DropRequests(requests);
+      RequestAnimationFrame();
+    }
+  }
+
+  void ReleaseCache() final {
+    layer_element_ = nullptr;
+    ComponentBase::ReleaseCache();
+  }
+
+  bool HandleEvent(Event event) {
     if (ComponentBase::OnEvent(event)) {
       return true;
     }
@@ -161,6 +327,7 @@ class WindowImpl : public ComponentBase, public WindowOptions {
       return false;
     }
 
+    const int previous_hover = HoverFlags();
     mouse_hover_ = box_window_.Contain(event.mouse().x, event.mouse().y);
 
     resize_down_hover_ = false;
@@ -181,6 +348,9 @@ class WindowImpl : public ComponentBase, public WindowOptions {
       resize_down_hover_ &= resize_down();
       resize_right_hover_ &= resize_right();
     }
+    if (HoverFlags() != previous_hover) {
+      RequestRedraw();
+    }
 
     if (captured_mouse_) {
       if (event.mouse().motion == Mouse::Released) {
@@ -260,9 +430,23 @@ class WindowImpl : public ComponentBase, public WindowOptions {
     return true;
   }
 
+  // The hover flags, changing how the window is drawn.
+  int HoverFlags() const {
+    return int(mouse_hover_) | int(resize_top_hover_) << 1 |
+           int(resize_left_hover_) << 2 | int(resize_down_hover_) << 3 |
+           int(resize_right_hover_) << 4;
+  }
+
   Box box_;
   Box box_window_;
 
+  // The layer, see WindowOptions::layer.
+  using LayerKey =
+      std::tuple<size_t, int, int, int, int, std::string, bool, bool, int>;
+  Element layer_element_;
+  LayerKey layer_key_;
+  bool layer_dirty_ = true;
+
   CapturedMouse captured_mouse_;
   int drag_start_x = 0;
   int drag_start_y = 0;
@@ -0,0 +1,170 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint16_t
+#include <memory>   // for make_shared
+#include <set>      // for set
+#include <string>   // for string, to_string
+#include <utility>  // for as_const, move
+#include <vector>   // for vector
+
+#include "ftxui/component/component.hpp"  // for Window, Renderer, Container
+#include "ftxui/component/component_options.hpp"  // for WindowOptions
+#include "ftxui/component/event.hpp"              // for Event
+#include "ftxui/component/loop.hpp"               // for Loop
+#include "ftxui/component/mouse.hpp"  // for Mouse, Mouse::Left, Mouse::Pressed
+#include "ftxui/component/screen_interactive.hpp"  // for ScreenInteractive
+#include "ftxui/dom/elements.hpp"        // for text, vbox, hyperlink
+#include "ftxui/dom/node_decorator.hpp"  // for NodeDecorator
+#include "ftxui/screen/screen.hpp"  // for Screen
+#include "gtest/gtest.h"  // for Test, EXPECT_EQ, TEST
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+
+Event MouseEvent(int x, int y, Mouse::Motion motion) {
+  Mouse mouse;
+  mouse.button = Mouse::Left;
+  mouse.motion = motion;
+  mouse.x = x;
+  mouse.y = y;
+  return Event::Mouse("", mouse);
+}
+
+// Drag the top window of a stack of 4 windows, and return the screens drawn.
+std::vector<std::string> DragWindow(bool layer, std::vector<int>* renders) {
+  auto screen = ScreenInteractive::FixedSize(40, 16);
+  renders->assign(4, 0);
+  int content_version = 0;
+  auto windows = Container::Stacked({});
+  for (int i = 0; i < 4; ++i) {
+    WindowOptions option;
+    option.inner = Renderer([renders, i, &content_version] {
+      (*renders)[size_t(i)]++;
+      return vbox({
+          text("Window " + std::to_string(i)),
+          text("Version " + std::to_string(content_version)),
+      });
+    });
+    option.title = "W" + std::to_string(i);
+    option.left = 3 * i;
+    option.top = 2 * i;
+    option.width = 16;
+    option.height = 6;
+    if (layer) {
+      option.layer = [&content_version] { return size_t(content_version); };
+    }
+    windows->Add(Window(option));
+  }
+
+  std::vector<std::string> frames;
+  Loop loop(&screen, windows);
+  auto send = [&](Event event) {
+    screen.PostEvent(event);
+    loop.RunOnce();
+    frames.push_back(screen.ToString());
+  };
+  loop.RunOnce();
+  frames.push_back(screen.ToString());
+
+  // Grab the first window, on top, by its content. The terminal coordinates
+  // start at 1.
+  send(MouseEvent(3, 3, Mouse::Pressed));
+  for (int x = 4; x < 20; ++x) {
+    send(MouseEvent(x, 3 + x / 4, Mouse::Moved));
+  }
+  send(MouseEvent(20, 8, Mouse::Released));
+
+  // The content changes.
+  content_version++;
+  screen.PostEvent(Event::Custom);
+  loop.RunOnce();
+  frames.push_back(screen.ToString());
+  return frames;
+}
+
+// Record the links of the pixels drawn by its child.
+class LinkProbe : public NodeDecorator {
+ public:
+  LinkProbe(Element child, std::set<std::string>* links)
+      : NodeDecorator(std::move(child)), links_(links) {}
+
+  void Render(Screen& screen) override {
+    NodeDecorator::Render(screen);
+    links_->clear();
+    for (int y = box_.y_min; y <= box_.y_max; ++y) {
+      for (int x = box_.x_min; x <= box_.x_max; ++x) {
+        const uint16_t id = std::as_const(screen).PixelAt(x, y).hyperlink;
+        if (id != 0) {
+          links_->insert(screen.Hyperlink(id));
+        }
+      }
+    }
+  }
+
+ private:
+  std::set<std::string>* links_;
+};
+
+}  // namespace
+
+TEST(WindowTest, Layer) {
+  std::vector<int> renders;
+  std::vector<int> layer_renders;
+  const std::vector<std::string> frames = DragWindow(false, &renders);
+  const std::vector<std::string> layer_frames =
+      DragWindow(true, &layer_renders);
+
+  // The same frames are drawn.
+  EXPECT_EQ(frames, layer_frames);
+
+  // Without layers, every window is rendered on every frame.
+  const int frame_count = int(frames.size());
+  EXPECT_EQ(renders, std::vector<int>(4, frame_count));
+
+  // With layers, only the dragged one is. The others, once for the first frame
+  // and once for the new version.
+  EXPECT_EQ(layer_renders[0], frame_count);
+  EXPECT_EQ(layer_renders[1], 2);
+  EXPECT_EQ(layer_renders[2], 2);
+  EXPECT_EQ(layer_renders[3], 2);
+}
+
+// The links of a layer are registered again on every frame: their ids are only
+// valid for one.
+TEST(WindowTest, LayerHyperlink) {
+  auto screen = ScreenInteractive::FixedSize(20, 6);
+  WindowOptions option;
+  option.inner = Renderer([] { return text("a") | hyperlink("http://a"); });
+  option.width = 10;
+  option.height = 3;
+  option.layer = [] { return size_t(0); };
+  auto window = Window(option);
+
+  bool other = false;
+  std::set<std::string> links;
+  auto component = Renderer(window, [&] {
+    return std::make_shared<LinkProbe>(
+        vbox({
+            other ? text("b") | hyperlink("http://other") : text("b"),
+            window->Render(),
+        }),
+        &links);
+  });
+
+  Loop loop(&screen, component);
+  loop.RunOnce();
+  EXPECT_EQ(links, std::set<std::string>({"http://a"}));
+
+  // The other link takes the first id of the next frame.
+  other = true;
+  screen.PostEvent(Event::Custom);
+  loop.RunOnce();
+  EXPECT_EQ(links, std::set<std::string>({"http://a", "http://other"}));
+}
+
+}  // namespace ftxui
+// NOLINTEND
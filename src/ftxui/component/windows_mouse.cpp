@@ -0,0 +1,98 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/component/windows_mouse.hpp"
+
+#include <cstdint>  // for int16_t, uint32_t
+
+namespace ftxui {
+
+namespace {
+
+// dwButtonState:
+constexpr uint32_t kLeftButton = 0x0001;    // FROM_LEFT_1ST_BUTTON_PRESSED
+constexpr uint32_t kRightButton = 0x0002;   // RIGHTMOST_BUTTON_PRESSED
+constexpr uint32_t kMiddleButton = 0x0004;  // FROM_LEFT_2ND_BUTTON_PRESSED
+constexpr uint32_t kButtons = kLeftButton | kRightButton | kMiddleButton;
+
+// dwControlKeyState:
+constexpr uint32_t kAlt = 0x0001 | 0x0002;      // RIGHT_ALT, LEFT_ALT
+constexpr uint32_t kControl = 0x0004 | 0x0008;  // RIGHT_CTRL, LEFT_CTRL
+constexpr uint32_t kShift = 0x0010;             // SHIFT_PRESSED
+
+// dwEventFlags:
+constexpr uint32_t kMoved = 0x0001;              // MOUSE_MOVED
+constexpr uint32_t kWheeled = 0x0004;            // MOUSE_WHEELED
+constexpr uint32_t kHorizontalWheeled = 0x0008;  // MOUSE_HWHEELED
+
+// The first of |buttons|, in the order of the Mouse::Button values.
+Mouse::Button FirstButton(uint32_t buttons) {
+  if (buttons & kLeftButton) {
+    return Mouse::Left;
+  }
+  if (buttons & kMiddleButton) {
+    return Mouse::Middle;
+  }
+  if (buttons & kRightButton) {
+    return Mouse::Right;
+  }
+  return Mouse::None;
+}
+
+uint32_t ButtonBit(Mouse::Button button) {
+  switch (button) {
+    case Mouse::Left:
+      return kLeftButton;
+    case Mouse::Middle:
+      return kMiddleButton;
+    case Mouse::Right:
+      return kRightButton;
+    default:
+      return 0;
+  }
+}
+
+}  // namespace
+
+bool WindowsMouseTranslator::Translate(const WindowsMouseRecord& record,
+                                       Mouse* mouse) {
+  mouse->x = record.x;
+  mouse->y = record.y;
+  mouse->shift = record.control_key_state & kShift;
+  mouse->control = record.control_key_state & kControl;
+  mouse->meta = record.control_key_state & kAlt;
+
+  // The high word of the button state is the signed distance scrolled.
+  const auto delta = int16_t(record.button_state >> 16);
+  if (record.event_flags & kWheeled) {
+    mouse->button = delta > 0 ? Mouse::WheelUp : Mouse::WheelDown;
+    mouse->motion = Mouse::Pressed;
+    return true;
+  }
+  if (record.event_flags & kHorizontalWheeled) {
+    mouse->button = delta > 0 ? Mouse::WheelRight : Mouse::WheelLeft;
+    mouse->motion = Mouse::Pressed;
+    return true;
+  }
+
+  // A button pressed or released. Only one is reported per event, like the
+  // terminals do.
+  const uint32_t buttons = record.button_state & kButtons;
+  const uint32_t changed = buttons ^ buttons_;
+  if (changed) {
+    mouse->button = FirstButton(changed);
+    const uint32_t bit = ButtonBit(mouse->button);
+    mouse->motion = (buttons & bit) ? Mouse::Pressed : Mouse::Released;
+    buttons_ ^= bit;
+    return true;
+  }
+
+  if (record.event_flags & kMoved) {
+    mouse->button = FirstButton(buttons);
+    mouse->motion = Mouse::Moved;
+    return true;
+  }
+  return false;
+}
+
+}  // namespace ftxui
@@ -0,0 +1,38 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_WINDOWS_MOUSE_HPP
+#define FTXUI_COMPONENT_WINDOWS_MOUSE_HPP
+
+#include <cstdint>  // for uint32_t
+
+#include "ftxui/component/mouse.hpp"  // for Mouse
+
+namespace ftxui {
+
+// The fields of a MOUSE_EVENT_RECORD read from the Windows console, with the
+// values of <windows.h>. It doesn't depend on it, to be tested everywhere.
+struct WindowsMouseRecord {
+  // The position in the window, starting from 1 like the terminal reports.
+  int x = 1;
+  int y = 1;
+  uint32_t button_state = 0;       // dwButtonState
+  uint32_t control_key_state = 0;  // dwControlKeyState
+  uint32_t event_flags = 0;        // dwEventFlags
+};
+
+// Translate the mouse records of the Windows console into Mouse events, as the
+// terminal input parser does for the mouse escape sequences. The records only
+// give which buttons are down, so the previous ones are remembered.
+class WindowsMouseTranslator {
+ public:
+  // Return false when |record| produces no event.
+  bool Translate(const WindowsMouseRecord& record, Mouse* mouse);
+
+ private:
+  uint32_t buttons_ = 0;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_WINDOWS_MOUSE_HPP
@@ -0,0 +1,82 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+
+#include "ftxui/component/mouse.hpp"  // for Mouse
+#include "ftxui/component/windows_mouse.hpp"
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+
+WindowsMouseRecord Record(uint32_t buttons, uint32_t flags = 0) {
+  WindowsMouseRecord record;
+  record.x = 3;
+  record.y = 4;
+  record.button_state = buttons;
+  record.event_flags = flags;
+  return record;
+}
+
+}  // namespace
+
+TEST(WindowsMouseTest, Buttons) {
+  WindowsMouseTranslator translator;
+  Mouse mouse;
+
+  EXPECT_TRUE(translator.Translate(Record(0x1), &mouse));
+  EXPECT_EQ(mouse.button, Mouse::Left);
+  EXPECT_EQ(mouse.motion, Mouse::Pressed);
+  EXPECT_EQ(mouse.x, 3);
+  EXPECT_EQ(mouse.y, 4);
+
+  // Dragging.
+  EXPECT_TRUE(translator.Translate(Record(0x1, 0x1), &mouse));
+  EXPECT_EQ(mouse.button, Mouse::Left);
+  EXPECT_EQ(mouse.motion, Mouse::Moved);
+
+  // The right button is pressed, then both are released.
+  EXPECT_TRUE(translator.Translate(Record(0x3), &mouse));
+  EXPECT_EQ(mouse.button, Mouse::Right);
+  EXPECT_EQ(mouse.motion, Mouse::Pressed);
+  EXPECT_TRUE(translator.Translate(Record(0x0), &mouse));
+  EXPECT_EQ(mouse.button, Mouse::Left);
+  EXPECT_EQ(mouse.motion, Mouse::Released);
+  EXPECT_TRUE(translator.Translate(Record(0x0), &mouse));
+  EXPECT_EQ(mouse.button, Mouse::Right);
+  EXPECT_EQ(mouse.motion, Mouse::Released);
+
+  // Moving without any button, or an event changing nothing.
+  EXPECT_TRUE(translator.Translate(Record(0x0, 0x1), &mouse));
+  EXPECT_EQ(mouse.button, Mouse::None);
+  EXPECT_EQ(mouse.motion, Mouse::Moved);
+  EXPECT_FALSE(translator.Translate(Record(0x0), &mouse));
+}
+
+TEST(WindowsMouseTest, Wheel) {
+  WindowsMouseTranslator translator;
+  Mouse mouse;
+
+  EXPECT_TRUE(translator.Translate(Record(120u << 16, 0x4), &mouse));
+  EXPECT_EQ(mouse.button, Mouse::WheelUp);
+  EXPECT_TRUE(translator.Translate(Record(uint32_t(-120) << 16, 0x4), &mouse));
+  EXPECT_EQ(mouse.button, Mouse::WheelDown);
+  EXPECT_TRUE(translator.Translate(Record(120u << 16, 0x8), &mouse));
+  EXPECT_EQ(mouse.button, Mouse::WheelRight);
+}
+
+TEST(WindowsMouseTest, Modifiers) {
+  WindowsMouseTranslator translator;
+  Mouse mouse;
+  WindowsMouseRecord record = Record(0x1);
+  record.control_key_state = 0x0010 | 0x0008;
+  EXPECT_TRUE(translator.Translate(record, &mouse));
+  EXPECT_TRUE(mouse.shift);
+  EXPECT_TRUE(mouse.control);
+  EXPECT_FALSE(mouse.meta);
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -3,9 +3,19 @@
 // the LICENSE file.
 #include <benchmark/benchmark.h>
 
-#include "ftxui/dom/elements.hpp"  // for gauge, separator, operator|, text, Element, hbox, vbox, blink, border, inverted
+#include <string>  // for string, to_string
+#include <vector>  // for vector
+
+#include "ftxui/dom/canvas.hpp"    // for Canvas
+#include "ftxui/dom/element_stats.hpp"  // for ElementStats, Inspect
+#include "ftxui/dom/elements.hpp"  // for gauge, separator, operator|, text, Element, hbox, vbox, blink, border, inverted, canvas, flexbox
+#include "ftxui/dom/flat_layout.hpp"  // for FlatLayout
+#include "ftxui/dom/linear_gradient.hpp"  // for LinearGradient
 #include "ftxui/dom/node.hpp"      // for Render
+#include "ftxui/dom/table.hpp"     // for Table
+#include "ftxui/dom/worker_pool.hpp"  // for WorkerPool
 #include "ftxui/screen/screen.hpp"  // for Screen
+#include "ftxui/screen/terminal.hpp"  // for SetColorSupport
 
 // NOLINTBEGIN
 namespace ftxui {
@@ -82,5 +92,284 @@ BENCHMARK(BenchmarkStyle)
         benchmark::CreateDenseRange(10, 200, 20),  // Screen width.
     });
 
+// The terminal sizes the benchmarks below are run with: {width, height}.
+static void TerminalSizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->Args({80, 24})->Args({200, 60})->Args({400, 120});
+}
+
+static void BenchmarkTable(benchmark::State& state) {
+  const int width = int(state.range(0));
+  const int height = int(state.range(1));
+  std::vector<std::vector<std::string>> rows;
+  for (int y = 0; y < height; ++y) {
+    std::vector<std::string> row;
+    for (int x = 0; x < width / 10; ++x) {
+      row.push_back(std::to_string(x * y));
+    }
+    rows.push_back(std::move(row));
+  }
+  Screen screen(width, height);
+  for (auto _ : state) {
+    auto table = Table(rows);
+    table.SelectAll().Border(LIGHT);
+    table.SelectAll().SeparatorVertical(LIGHT);
+    table.SelectRow(0).Decorate(bold);
+    Render(screen, table.Render());
+    benchmark::DoNotOptimize(screen.ToString());
+  }
+}
+BENCHMARK(BenchmarkTable)->Apply(TerminalSizes);
+
+static void BenchmarkCanvas(benchmark::State& state) {
+  const int width = int(state.range(0));
+  const int height = int(state.range(1));
+  Screen screen(width, height);
+  int frame = 0;
+  for (auto _ : state) {
+    auto c = Canvas(width * 2, height * 4);
+    for (int i = 0; i < 16; ++i) {
+      c.DrawPointLine(0, (i * 7 + frame) % (height * 4), width * 2 - 1,
+                      (i * 13) % (height * 4), Color::Red);
+      c.DrawBlockCircle(width, height * 2, (i * 3 + frame) % height);
+    }
+    c.DrawText(0, 0, "canvas");
+    frame++;
+    Render(screen, canvas(std::move(c)));
+    benchmark::DoNotOptimize(screen.ToString());
+  }
+}
+BENCHMARK(BenchmarkCanvas)->Apply(TerminalSizes);
+
+static void BenchmarkFlexbox(benchmark::State& state) {
+  const int width = int(state.range(0));
+  const int height = int(state.range(1));
+  Screen screen(width, height);
+  for (auto _ : state) {
+    Elements elements;
+    for (int i = 0; i < width * height / 8; ++i) {
+      elements.push_back(text(std::to_string(i)) | border);
+    }
+    Render(screen, flexbox(std::move(elements)));
+    benchmark::DoNotOptimize(screen.ToString());
+  }
+}
+BENCHMARK(BenchmarkFlexbox)->Apply(TerminalSizes);
+
+// A wall of job statuses, each with a gauge and a spinner, redrawn every tick.
+static void BenchmarkGaugeWall(benchmark::State& state) {
+  const int width = int(state.range(0));
+  const int height = int(state.range(1));
+  Screen screen(width, height);
+  size_t tick = 0;
+  for (auto _ : state) {
+    ++tick;
+    Elements rows;
+    for (int i = 0; i < 400; ++i) {
+      rows.push_back(hbox({
+          spinner(i % 20 + 1, tick + size_t(i)),
+          text(" "),
+          gauge(float((tick + size_t(i)) % 100) / 100.F) | flex,
+      }));
+    }
+    Render(screen, vbox(std::move(rows)));
+  }
+}
+BENCHMARK(BenchmarkGaugeWall)->Apply(TerminalSizes);
+
+// Windows inside of splits inside of tabs: more borders than content.
+static void BenchmarkNestedBorders(benchmark::State& state) {
+  const int width = int(state.range(0));
+  const int height = int(state.range(1));
+  Screen screen(width, height);
+  for (auto _ : state) {
+    Elements columns;
+    for (int x = 0; x < 4; ++x) {
+      Elements rows;
+      for (int y = 0; y < 3; ++y) {
+        rows.push_back(window(text("Pane"), text("content") | flex) | flex);
+        rows.push_back(separator());
+      }
+      columns.push_back(vbox(std::move(rows)) | border | flex);
+      columns.push_back(separatorHeavy());
+    }
+    Render(screen, vbox({
+                       hbox(std::move(columns)) | borderDouble | flex,
+                       gauge(0.5F),
+                   }));
+  }
+}
+BENCHMARK(BenchmarkNestedBorders)->Apply(TerminalSizes);
+
+// A modal dialog drawn over a full screen of text, like Modal() does.
+static void BenchmarkDbox(benchmark::State& state) {
+  const int width = int(state.range(0));
+  const int height = int(state.range(1));
+  Screen screen(width, height);
+  for (auto _ : state) {
+    Elements lines;
+    for (int y = 0; y < height; ++y) {
+      lines.push_back(text(std::string(width, 'a')) |
+                      color(y % 2 ? Color(Color::Red) : Color()));
+    }
+    auto dialog = window(text("Title"), text("Are you sure?") | center) |
+                  size(WIDTH, EQUAL, width / 2) |
+                  size(HEIGHT, EQUAL, height / 2);
+    auto document = dbox({
+        vbox(std::move(lines)) | bgcolor(Color::Blue),
+        std::move(dialog) | clear_under | center,
+    });
+    Render(screen, document);
+  }
+}
+BENCHMARK(BenchmarkDbox)->Apply(TerminalSizes);
+
+// A translucent layer over a gradient background: every cell is blended.
+static void BenchmarkTranslucent(benchmark::State& state) {
+  // Otherwise, the blended colors are converted to the palette.
+  Terminal::SetColorSupport(Terminal::Color::TrueColor);
+  const int width = int(state.range(0));
+  const int height = int(state.range(1));
+  Screen screen(width, height);
+  for (auto _ : state) {
+    auto document = dbox({
+        filler() | bgcolor(LinearGradient(45, Color::Red, Color::Blue)),
+        filler() | bgcolor(Color::RGBA(0, 0, 0, 128)),
+    });
+    Render(screen, document);
+  }
+}
+BENCHMARK(BenchmarkTranslucent)->Apply(TerminalSizes);
+
+// Sparklines over long histories, downsampled to the width of the screen.
+static void BenchmarkGraphSeries(benchmark::State& state) {
+  const int width = int(state.range(0));
+  const int height = int(state.range(1));
+  GraphSeries cpu(100000);
+  GraphSeries memory(100000);
+  for (int i = 0; i < 100000; ++i) {
+    cpu.Push(float(i * 7919 % 1000));
+    memory.Push(float(i % 5000));
+  }
+  GraphOption option;
+  option.colors = {Color::Red, Color::Blue};
+  Screen screen(width, height);
+  for (auto _ : state) {
+    cpu.Push(0.F);
+    memory.Push(0.F);
+    Render(screen, graph({&cpu, &memory}, option));
+  }
+}
+BENCHMARK(BenchmarkGraphSeries)->Apply(TerminalSizes);
+
+// A screen whose style changes every few cells, like highlighted source code.
+static Screen StyledScreen(int width, int height) {
+  const Color colors[] = {
+      Color::Default,          Color::Red,
+      Color::RGB(42, 87, 124), Color::DarkOrange,
+      Color::GreenLight,       Color::RGB(172, 94, 212),
+  };
+  Screen screen(width, height);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      const int style = (x / 4 + y) % 12;
+      Pixel& pixel = screen.PixelAt(x, y);
+      pixel.character = "a";
+      pixel.foreground_color = colors[style % 6];
+      pixel.background_color = style == 5 ? Color(Color::Blue) : Color();
+      pixel.bold = style == 3 || style == 7;
+      pixel.underlined = style == 11;
+    }
+  }
+  return screen;
+}
+
+static void BenchmarkToString(benchmark::State& state) {
+  const Screen screen = StyledScreen(int(state.range(0)), int(state.range(1)));
+  std::string output;
+  for (auto _ : state) {
+    output.clear();
+    screen.ToString(output);
+    benchmark::DoNotOptimize(output);
+  }
+}
+BENCHMARK(BenchmarkToString)->Apply(TerminalSizes);
+
+// Serialize a wall display sized screen by blocks of rows, on 1 to 8 threads.
+static void BenchmarkToStringParallel(benchmark::State& state) {
+  const Screen screen = StyledScreen(500, 150);
+  const int threads = int(state.range(0));
+  WorkerPool pool(threads - 1);
+  std::string output;
+  for (auto _ : state) {
+    output.clear();
+    screen.ToString(output, [&](size_t count, const auto& fn) {
+      pool.ParallelFor(count, fn, threads);
+    });
+    benchmark::DoNotOptimize(output);
+  }
+}
+BENCHMARK(BenchmarkToStringParallel)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
+
+// Build a tree, like an application does every frame, and report its size.
+static void BenchmarkElementStats(benchmark::State& state) {
+  auto build = [&] {
+    Elements rows;
+    for (int i = 0; i < state.range(0); ++i) {
+      rows.push_back(hbox({
+          text("row " + std::to_string(i)) | bold,
+          separator(),
+          gauge(0.5f) | color(Color::Red) | flex,
+      }));
+    }
+    return vbox(std::move(rows)) | border;
+  };
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(build());
+  }
+  const ElementStats stats = Inspect(build());
+  state.counters["nodes"] = double(stats.nodes);
+  state.counters["depth"] = stats.depth;
+  state.counters["bytes/node"] = double(stats.heap_bytes) / stats.nodes;
+}
+BENCHMARK(BenchmarkElementStats)->Range(1, 1024);
+
+// Lay out a large grid of rows, columns and decorators, recursively or by
+// the flat passes of FlatLayout.
+static Element LayoutGrid(int rows) {
+  Elements lines;
+  for (int y = 0; y < rows; ++y) {
+    Elements cells;
+    for (int x = 0; x < 16; ++x) {
+      cells.push_back(text("cell") | color(Color::Red) | flex);
+    }
+    lines.push_back(hbox(std::move(cells)));
+  }
+  return vbox(std::move(lines));
+}
+
+static void BenchmarkLayoutRecursive(benchmark::State& state) {
+  Screen screen(200, 50);
+  const Element document = LayoutGrid(int(state.range(0)));
+  for (auto _ : state) {
+    Render(screen, document);
+  }
+}
+BENCHMARK(BenchmarkLayoutRecursive)->Range(16, 4096);
+
+static void BenchmarkLayoutFlat(benchmark::State& state) {
+  Screen screen(200, 50);
+  const Element document = LayoutGrid(int(state.range(0)));
+  FlatLayout layout;
+  for (auto _ : state) {
+    layout.Render(screen, document);
+  }
+}
+BENCHMARK(BenchmarkLayoutFlat)->Range(16, 4096);
+
 }  // namespace ftxui
 // NOLINTEND
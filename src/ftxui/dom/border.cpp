@@ -11,6 +11,7 @@
 
 #include "ftxui/dom/elements.hpp"  // for unpack, Element, Decorator, BorderStyle, ROUNDED, borderStyled, Elements, DASHED, DOUBLE, EMPTY, HEAVY, LIGHT, border, borderDashed, borderDouble, borderEmpty, borderHeavy, borderLight, borderRounded, borderWith, window
 #include "ftxui/dom/node.hpp"      // for Node, Elements
+#include "ftxui/dom/node_pool.hpp"  // for MakeNode
 #include "ftxui/dom/requirement.hpp"  // for Requirement
 #include "ftxui/screen/box.hpp"       // for Box
 #include "ftxui/screen/pixel.hpp"     // for Pixel
@@ -91,22 +92,16 @@ class Border : public Node {
     screen.at(box_.x_min, box_.y_max) = charset_[2];  // NOLINT
     screen.at(box_.x_max, box_.y_max) = charset_[3];  // NOLINT
 
-    for (int x = box_.x_min + 1; x < box_.x_max; ++x) {
-      Pixel& p1 = screen.PixelAt(x, box_.y_min);
-      Pixel& p2 = screen.PixelAt(x, box_.y_max);
-      p1.character = charset_[4];  // NOLINT
-      p2.character = charset_[4];  // NOLINT
-      p1.automerge = true;
-      p2.automerge = true;
-    }
-    for (int y = box_.y_min + 1; y < box_.y_max; ++y) {
-      Pixel& p3 = screen.PixelAt(box_.x_min, y);
-      Pixel& p4 = screen.PixelAt(box_.x_max, y);
-      p3.character = charset_[5];  // NOLINT
-      p4.character = charset_[5];  // NOLINT
-      p3.automerge = true;
-      p4.automerge = true;
-    }
+    // NOLINTBEGIN
+    screen.FillRow(box_.x_min + 1, box_.x_max - 1, box_.y_min, charset_[4],
+                   /*automerge=*/true);
+    screen.FillRow(box_.x_min + 1, box_.x_max - 1, box_.y_max, charset_[4],
+                   /*automerge=*/true);
+    screen.FillColumn(box_.x_min, box_.y_min + 1, box_.y_max - 1, charset_[5],
+                      /*automerge=*/true);
+    screen.FillColumn(box_.x_max, box_.y_min + 1, box_.y_max - 1, charset_[5],
+                      /*automerge=*/true);
+    // NOLINTEND
 
     // Draw title.
     if (children_.size() == 2) {
@@ -115,11 +110,12 @@ class Border : public Node {
 
     // Draw the border color.
     if (foreground_color_) {
-      for (int x = box_.x_min; x <= box_.x_max; ++x) {
-        screen.PixelAt(x, box_.y_min).foreground_color = *foreground_color_;
-        screen.PixelAt(x, box_.y_max).foreground_color = *foreground_color_;
+      for (const int y : {box_.y_min, box_.y_max}) {
+        for (Pixel& pixel : screen.ClippedRow(box_.x_min, box_.x_max, y)) {
+          pixel.foreground_color = *foreground_color_;
+        }
       }
-      for (int y = box_.y_min; y <= box_.y_max; ++y) {
+      for (int y = box_.y_min + 1; y < box_.y_max; ++y) {
         screen.PixelAt(box_.x_min, y).foreground_color = *foreground_color_;
         screen.PixelAt(box_.x_max, y).foreground_color = *foreground_color_;
       }
@@ -177,19 +173,10 @@ class BorderPixel : public Node {
       return;
     }
 
-    screen.PixelAt(box_.x_min, box_.y_min) = pixel_;
-    screen.PixelAt(box_.x_max, box_.y_min) = pixel_;
-    screen.PixelAt(box_.x_min, box_.y_max) = pixel_;
-    screen.PixelAt(box_.x_max, box_.y_max) = pixel_;
-
-    for (int x = box_.x_min + 1; x < box_.x_max; ++x) {
-      screen.PixelAt(x, box_.y_min) = pixel_;
-      screen.PixelAt(x, box_.y_max) = pixel_;
-    }
-    for (int y = box_.y_min + 1; y < box_.y_max; ++y) {
-      screen.PixelAt(box_.x_min, y) = pixel_;
-      screen.PixelAt(box_.x_max, y) = pixel_;
-    }
+    screen.FillRow(box_.x_min, box_.x_max, box_.y_min, pixel_);
+    screen.FillRow(box_.x_min, box_.x_max, box_.y_max, pixel_);
+    screen.FillColumn(box_.x_min, box_.y_min + 1, box_.y_max - 1, pixel_);
+    screen.FillColumn(box_.x_max, box_.y_min + 1, box_.y_max - 1, pixel_);
   }
 };
 }  // namespace
@@ -226,7 +213,7 @@ class BorderPixel : public Node {
 /// └───────────┘
 /// ```
 Element border(Element child) {
-  return std::make_shared<Border>(unpack(std::move(child)), ROUNDED);
+  return MakeNode<Border>(unpack(std::move(child)), ROUNDED);
 }
 
 /// @brief Same as border but with a constant Pixel around the element.
@@ -234,7 +221,7 @@ Element border(Element child) {
 /// @see border
 Decorator borderWith(const Pixel& pixel) {
   return [pixel](Element child) {
-    return std::make_shared<BorderPixel>(unpack(std::move(child)), pixel);
+    return MakeNode<BorderPixel>(unpack(std::move(child)), pixel);
   };
 }
 
@@ -243,7 +230,7 @@ Decorator borderWith(const Pixel& pixel) {
 /// @see border
 Decorator borderStyled(BorderStyle style) {
   return [style](Element child) {
-    return std::make_shared<Border>(unpack(std::move(child)), style);
+    return MakeNode<Border>(unpack(std::move(child)), style);
   };
 }
 
@@ -252,7 +239,7 @@ Decorator borderStyled(BorderStyle style) {
 /// @see border
 Decorator borderStyled(Color foreground_color) {
   return [foreground_color](Element child) {
-    return std::make_shared<Border>(unpack(std::move(child)), ROUNDED,
+    return MakeNode<Border>(unpack(std::move(child)), ROUNDED,
                                     foreground_color);
   };
 }
@@ -262,7 +249,7 @@ Decorator borderStyled(Color foreground_color) {
 /// @see border
 Decorator borderStyled(BorderStyle style, Color foreground_color) {
   return [style, foreground_color](Element child) {
-    return std::make_shared<Border>(unpack(std::move(child)), style,
+    return MakeNode<Border>(unpack(std::move(child)), style,
                                     foreground_color);
   };
 }
@@ -299,7 +286,7 @@ Decorator borderStyled(BorderStyle style, Color foreground_color) {
 /// ┗╍╍╍╍╍╍╍╍╍╍╍╍╍╍┛
 /// ```
 Element borderDashed(Element child) {
-  return std::make_shared<Border>(unpack(std::move(child)), DASHED);
+  return MakeNode<Border>(unpack(std::move(child)), DASHED);
 }
 
 /// @brief Draw a light border around the element.
@@ -334,7 +321,7 @@ Element borderDashed(Element child) {
 /// └──────────────┘
 /// ```
 Element borderLight(Element child) {
-  return std::make_shared<Border>(unpack(std::move(child)), LIGHT);
+  return MakeNode<Border>(unpack(std::move(child)), LIGHT);
 }
 
 /// @brief Draw a heavy border around the element.
@@ -369,7 +356,7 @@ Element borderLight(Element child) {
 /// ┗━━━━━━━━━━━━━━┛
 /// ```
 Element borderHeavy(Element child) {
-  return std::make_shared<Border>(unpack(std::move(child)), HEAVY);
+  return MakeNode<Border>(unpack(std::move(child)), HEAVY);
 }
 
 /// @brief Draw a double border around the element.
@@ -404,7 +391,7 @@ Element borderHeavy(Element child) {
 /// ╚══════════════╝
 /// ```
 Element borderDouble(Element child) {
-  return std::make_shared<Border>(unpack(std::move(child)), DOUBLE);
+  return MakeNode<Border>(unpack(std::move(child)), DOUBLE);
 }
 
 /// @brief Draw a rounded border around the element.
@@ -439,7 +426,7 @@ Element borderDouble(Element child) {
 /// ╰──────────────╯
 /// ```
 Element borderRounded(Element child) {
-  return std::make_shared<Border>(unpack(std::move(child)), ROUNDED);
+  return MakeNode<Border>(unpack(std::move(child)), ROUNDED);
 }
 
 /// @brief Draw an empty border around the element.
@@ -474,7 +461,7 @@ Element borderRounded(Element child) {
 ///
 /// ```
 Element borderEmpty(Element child) {
-  return std::make_shared<Border>(unpack(std::move(child)), EMPTY);
+  return MakeNode<Border>(unpack(std::move(child)), EMPTY);
 }
 
 /// @brief Draw window with a title and a border around the element.
@@ -506,7 +493,7 @@ Element borderEmpty(Element child) {
 /// └───────┘
 /// ```
 Element window(Element title, Element content, BorderStyle border) {
-  return std::make_shared<Border>(unpack(std::move(content), std::move(title)),
+  return MakeNode<Border>(unpack(std::move(content), std::move(title)),
                                   border);
 }
 }  // namespace ftxui
@@ -9,19 +9,20 @@
 #include <cstdlib>                 // for abs
 #include <ftxui/screen/color.hpp>  // for Color
 #include <functional>              // for function
-#include <map>                     // for map
 #include <memory>                  // for make_shared
+#include <string_view>             // for string_view
 #include <utility>                 // for move, pair
 #include <vector>                  // for vector
 
 #include "ftxui/dom/elements.hpp"     // for Element, canvas
 #include "ftxui/dom/node.hpp"         // for Node
+#include "ftxui/dom/node_pool.hpp"    // for MakeNode
 #include "ftxui/dom/requirement.hpp"  // for Requirement
 #include "ftxui/screen/box.hpp"       // for Box
 #include "ftxui/screen/image.hpp"     // for Image
 #include "ftxui/screen/pixel.hpp"     // for Pixel
 #include "ftxui/screen/screen.hpp"    // for Pixel, Screen
-#include "ftxui/screen/string.hpp"    // for Utf8ToGlyphs
+#include "ftxui/screen/string.hpp"    // for GlyphRange
 #include "ftxui/util/ref.hpp"         // for ConstRef
 
 namespace ftxui {
@@ -66,19 +67,21 @@ uint8_t g_map_braille[2][4][2] = {
     },
 };
 
-// NOLINTNEXTLINE
-std::vector<std::string> g_map_block = {
+// The block characters, indexed by the 4 bits of their quadrants.
+constexpr std::string_view g_map_block[16] = {
     " ", "▘", "▖", "▌", "▝", "▀", "▞", "▛",
     "▗", "▚", "▄", "▙", "▐", "▜", "▟", "█",
 };
 
-// NOLINTNEXTLINE
-const std::map<std::string, uint8_t> g_map_block_inversed = {
-    {" ", 0b0000}, {"▘", 0b0001}, {"▖", 0b0010}, {"▌", 0b0011},
-    {"▝", 0b0100}, {"▀", 0b0101}, {"▞", 0b0110}, {"▛", 0b0111},
-    {"▗", 0b1000}, {"▚", 0b1001}, {"▄", 0b1010}, {"▙", 0b1011},
-    {"▐", 0b1100}, {"▜", 0b1101}, {"▟", 0b1110}, {"█", 0b1111},
-};
+// The quadrants of the block character |c|.
+uint8_t BlockValue(const std::string& c) {
+  for (uint8_t value = 0; value < 16; ++value) {  // NOLINT
+    if (g_map_block[value] == c) {
+      return value;
+    }
+  }
+  return 0;
+}
 
 constexpr auto nostyle = [](Pixel& /*pixel*/) {};
 
@@ -88,16 +91,114 @@ constexpr auto nostyle = [](Pixel& /*pixel*/) {};
 /// @param width the width of the canvas. A cell is a 2x4 braille dot.
 /// @param height the height of the canvas. A cell is a 2x4 braille dot.
 Canvas::Canvas(int width, int height)
-    : width_(width),
-      height_(height),
-      storage_(width_ * height_ / 8 /* NOLINT */) {}
+    : Canvas(width, height, Storage::Sparse) {}
+
+/// @brief Constructor.
+/// @param width the width of the canvas. A cell is a 2x4 braille dot.
+/// @param height the height of the canvas. A cell is a 2x4 braille dot.
+/// @param storage how the cells are stored. Use Storage::Dense for canvas
+/// whose cells are mostly all drawn, like charts. It avoids hashing on every
+/// dot.
+Canvas::Canvas(int width, int height, Storage storage)
+    : width_(width), height_(height), storage_type_(storage) {
+  if (storage_type_ == Storage::Sparse) {
+    storage_.rehash(std::max(0, width_ * height_ / 8));  // NOLINT
+    return;
+  }
+  dense_width_ = std::max(0, (width_ + 1) / 2);
+  dense_height_ = std::max(0, (height_ + 3) / 4);
+  dense_storage_.resize(dense_width_ * dense_height_);
+}
 
 /// @brief Get the content of a cell.
 /// @param x the x coordinate of the cell.
 /// @param y the y coordinate of the cell.
 Pixel Canvas::GetPixel(int x, int y) const {
-  auto it = storage_.find(XY{x, y});
-  return (it == storage_.end()) ? Pixel() : it->second.content;
+  const Cell* cell = FindCell(x, y);
+  return cell ? cell->content : Pixel();
+}
+
+/// @brief Get the content of a cell, without copying it.
+/// @param x the x coordinate of the cell.
+/// @param y the y coordinate of the cell.
+/// @return nullptr when the cell was never drawn.
+const Pixel* Canvas::FindPixel(int x, int y) const {
+  const Cell* cell = FindCell(x, y);
+  return cell ? &cell->content : nullptr;
+}
+
+/// @brief Erase every cell. The storage is kept, drawing the next frame of an
+/// animation doesn't allocate it again.
+void Canvas::Clear() {
+  if (storage_type_ == Storage::Sparse) {
+    storage_.clear();  // Keeps the buckets.
+    return;
+  }
+  std::fill(dense_storage_.begin(), dense_storage_.end(), Cell());
+  dense_origin_x_ = 0;
+  dense_origin_y_ = 0;
+}
+
+/// @brief Change the size of the canvas. Every cell is erased. The storage is
+/// kept, and only grows when needed.
+/// @param width the width of the canvas. A cell is a 2x4 braille dot.
+/// @param height the height of the canvas. A cell is a 2x4 braille dot.
+void Canvas::Resize(int width, int height) {
+  width_ = width;
+  height_ = height;
+  if (storage_type_ == Storage::Sparse) {
+    storage_.clear();
+    const auto buckets = size_t(std::max(0, width_ * height_ / 8));  // NOLINT
+    if (storage_.bucket_count() < buckets) {
+      storage_.rehash(buckets);
+    }
+    return;
+  }
+  dense_width_ = std::max(0, (width_ + 1) / 2);
+  dense_height_ = std::max(0, (height_ + 3) / 4);
+  dense_origin_x_ = 0;
+  dense_origin_y_ = 0;
+  dense_storage_.assign(size_t(dense_width_) * size_t(dense_height_), Cell());
+}
+
+// private
+Canvas::Cell& Canvas::CellAt(int x, int y) {
+  if (storage_type_ == Storage::Sparse) {
+    return storage_[XY{x, y}];
+  }
+
+  if (x < 0 || x >= dense_width_ || y < 0 || y >= dense_height_) {
+    // Never displayed. Drawing there is a no-op.
+    out_of_bounds_ = Cell();
+    return out_of_bounds_;
+  }
+  return dense_storage_[DenseIndex(x, y)];
+}
+
+// private
+const Canvas::Cell* Canvas::FindCell(int x, int y) const {
+  if (storage_type_ == Storage::Sparse) {
+    auto it = storage_.find(XY{x, y});
+    return (it == storage_.end()) ? nullptr : &it->second;
+  }
+
+  if (x < 0 || x >= dense_width_ || y < 0 || y >= dense_height_) {
+    return nullptr;
+  }
+  return &dense_storage_[DenseIndex(x, y)];
+}
+
+// private
+size_t Canvas::DenseIndex(int x, int y) const {
+  x += dense_origin_x_;
+  y += dense_origin_y_;
+  if (x >= dense_width_) {
+    x -= dense_width_;
+  }
+  if (y >= dense_height_) {
+    y -= dense_height_;
+  }
+  return size_t(y) * size_t(dense_width_) + size_t(x);
 }
 
 /// @brief Draw a braille dot.
@@ -138,7 +239,7 @@ void Canvas::DrawPointOn(int x, int y) {
   if (!IsIn(x, y)) {
     return;
   }
-  Cell& cell = storage_[XY{x / 2, y / 4}];
+  Cell& cell = CellAt(x / 2, y / 4);
   if (cell.type != CellType::kBraille) {
     cell.content.character = "⠀";  // 3 bytes.
     cell.type = CellType::kBraille;
@@ -155,7 +256,7 @@ void Canvas::DrawPointOff(int x, int y) {
   if (!IsIn(x, y)) {
     return;
   }
-  Cell& cell = storage_[XY{x / 2, y / 4}];
+  Cell& cell = CellAt(x / 2, y / 4);
   if (cell.type != CellType::kBraille) {
     cell.content.character = "⠀";  // 3 byt
     cell.type = CellType::kBraille;
@@ -173,7 +274,7 @@ void Canvas::DrawPointToggle(int x, int y) {
   if (!IsIn(x, y)) {
     return;
   }
-  Cell& cell = storage_[XY{x / 2, y / 4}];
+  Cell& cell = CellAt(x / 2, y / 4);
   if (cell.type != CellType::kBraille) {
     cell.content.character = "⠀";  // 3 byt
     cell.type = CellType::kBraille;
@@ -242,6 +343,272 @@ void Canvas::DrawPointLine(int x1,
   DrawPoint(x2, y2, true, style);
 }
 
+/// @brief Draw a set of braille dots.
+/// @param points the coordinates of the dots.
+void Canvas::DrawPoints(const std::vector<Point>& points) {
+  for (const Point& point : points) {
+    PlotPoint(point.x, point.y, nullptr);
+  }
+}
+
+/// @brief Draw a set of braille dots.
+/// @param points the coordinates of the dots.
+/// @param color the color of the dots.
+void Canvas::DrawPoints(const std::vector<Point>& points, const Color& color) {
+  for (const Point& point : points) {
+    PlotPoint(point.x, point.y, &color);
+  }
+}
+
+/// @brief Draw a set of braille dots.
+/// @param points the coordinates of the dots.
+/// @param colors the color of each dot. Dots without a color are skipped.
+void Canvas::DrawPoints(const std::vector<Point>& points,
+                        const std::vector<Color>& colors) {
+  const size_t size = std::min(points.size(), colors.size());
+  for (size_t i = 0; i < size; ++i) {
+    PlotPoint(points[i].x, points[i].y, &colors[i]);
+  }
+}
+
+/// @brief Draw lines made of braille dots, joining consecutive points.
+/// @param points the coordinates of the vertices.
+void Canvas::DrawPolyline(const std::vector<Point>& points) {
+  for (size_t i = 1; i < points.size(); ++i) {
+    PlotLine(points[i - 1].x, points[i - 1].y, points[i].x, points[i].y,
+             nullptr);
+  }
+}
+
+/// @brief Draw lines made of braille dots, joining consecutive points.
+/// @param points the coordinates of the vertices.
+/// @param color the color of the lines.
+void Canvas::DrawPolyline(const std::vector<Point>& points,
+                          const Color& color) {
+  for (size_t i = 1; i < points.size(); ++i) {
+    PlotLine(points[i - 1].x, points[i - 1].y, points[i].x, points[i].y,
+             &color);
+  }
+}
+
+/// @brief Draw lines made of braille dots, joining consecutive points.
+/// @param points the coordinates of the vertices.
+/// @param colors the color of each vertex. The line from points[i] to
+/// points[i+1] uses colors[i+1]. Vertices without a color are skipped.
+void Canvas::DrawPolyline(const std::vector<Point>& points,
+                          const std::vector<Color>& colors) {
+  const size_t size = std::min(points.size(), colors.size());
+  for (size_t i = 1; i < size; ++i) {
+    PlotLine(points[i - 1].x, points[i - 1].y, points[i].x, points[i].y,
+             &colors[i]);
+  }
+}
+
+/// @brief Draw a bitmap of braille dots.
+/// @param x the x coordinate of the top-left dot.
+/// @param y the y coordinate of the top-left dot.
+/// @param width the number of dots per row of the bitmap.
+/// @param height the number of rows of the bitmap.
+/// @param dots the dots, row by row. A non zero value is a filled dot.
+///
+/// Every dot covered by the bitmap is overwritten, filled or not. This is the
+/// fast way to draw an image or a heatmap made of braille dots.
+void Canvas::DrawPointBitmap(int x,
+                             int y,
+                             int width,
+                             int height,
+                             const std::vector<uint8_t>& dots) {
+  PlotBitmap(x, y, width, height, dots, nullptr);
+}
+
+/// @brief Draw a bitmap of braille dots.
+/// @param x the x coordinate of the top-left dot.
+/// @param y the y coordinate of the top-left dot.
+/// @param width the number of dots per row of the bitmap.
+/// @param height the number of rows of the bitmap.
+/// @param dots the dots, row by row. A non zero value is a filled dot.
+/// @param color the color of the cells covered by the bitmap.
+void Canvas::DrawPointBitmap(int x,
+                             int y,
+                             int width,
+                             int height,
+                             const std::vector<uint8_t>& dots,
+                             const Color& color) {
+  PlotBitmap(x, y, width, height, dots, &color);
+}
+
+/// @brief Plot the latest samples of a series, as a line of braille dots.
+/// @param x the x coordinate of the top-left dot of the plot.
+/// @param y the y coordinate of the top-left dot of the plot.
+/// @param width the number of columns of dots of the plot.
+/// @param height the number of rows of dots of the plot.
+/// @param series the samples.
+/// @param option the number of samples plotted, their range, and the color of
+/// the line, if any, in |option.colors[0]|.
+///
+/// When there are more samples than columns, each column of dots displays the
+/// minimum and the maximum of the samples it covers, found in logarithmic time
+/// by the series. Spikes are kept, and the cost doesn't depend on the number
+/// of samples.
+void Canvas::DrawPointSeries(int x,
+                             int y,
+                             int width,
+                             int height,
+                             const GraphSeries& series,
+                             const GraphOption& option) {
+  const size_t size = series.size();
+  const size_t window = option.window == 0 ? size : option.window;
+  if (width <= 0 || height <= 0 || size == 0) {
+    return;
+  }
+
+  float min = option.min;
+  float max = option.max;
+  if (min >= max) {
+    const GraphSeries::Extent extent =
+        series.ExtentOf(size - std::min(size, window), size);
+    min = extent.min;
+    max = extent.max;
+    // A constant series is drawn in the middle.
+    if (min >= max) {
+      min -= 1.F;
+      max += 1.F;
+    }
+  }
+  auto row = [&](float value) {
+    const float ratio = (max - value) / (max - min);
+    const auto dy = int(std::lround(ratio * float(height - 1)));
+    return y + std::min(height - 1, std::max(0, dy));
+  };
+
+  const Color* color = option.colors.empty() ? nullptr : &option.colors[0];
+  for (int column = 0; column < width; ++column) {
+    GraphSeries::Extent extent;
+    if (series.ColumnExtent(size_t(column), size_t(width), window, &extent)) {
+      PlotLine(x + column, row(extent.max), x + column, row(extent.min),
+               color);
+    }
+  }
+}
+
+// private
+// Build every cell covered by the bitmap at once. The cell's dots are packed
+// into the braille code point U+2800 + |mask|, whose UTF-8 encoding is:
+// 11100010 101000xx 10xxxxxx
+void Canvas::PlotBitmap(int x,
+                        int y,
+                        int width,
+                        int height,
+                        const std::vector<uint8_t>& dots,
+                        const Color* color) {
+  if (width <= 0 || height <= 0 ||
+      dots.size() < size_t(width) * size_t(height)) {
+    return;
+  }
+
+  // The bit of each dot in the code point, ordered as |g_map_braille|.
+  constexpr uint8_t bits[2][4] = {
+      {0x01, 0x02, 0x04, 0x40},  // NOLINT
+      {0x08, 0x10, 0x20, 0x80},  // NOLINT
+  };
+
+  // The dots covered by the bitmap, clipped to the canvas:
+  const int x_min = std::max(x, 0);
+  const int y_min = std::max(y, 0);
+  const int x_max = std::min(x + width, width_) - 1;
+  const int y_max = std::min(y + height, height_) - 1;
+
+  for (int cell_y = y_min / 4; cell_y <= y_max / 4; ++cell_y) {
+    for (int cell_x = x_min / 2; cell_x <= x_max / 2; ++cell_x) {
+      uint8_t mask = 0;
+      uint8_t covered = 0;
+      for (int dx = 0; dx < 2; ++dx) {
+        const int px = cell_x * 2 + dx;
+        if (px < x_min || px > x_max) {
+          continue;
+        }
+        for (int dy = 0; dy < 4; ++dy) {
+          const int py = cell_y * 4 + dy;
+          if (py < y_min || py > y_max) {
+            continue;
+          }
+          const uint8_t bit = bits[dx][dy];              // NOLINT
+          const size_t index = size_t(py - y) * size_t(width) + size_t(px - x);
+          covered |= bit;
+          mask |= dots[index] ? bit : uint8_t(0);
+        }
+      }
+
+      Cell& cell = CellAt(cell_x, cell_y);
+      if (cell.type == CellType::kBraille && covered != 0xFF) {  // NOLINT
+        // Keep the dots of the cell not covered by the bitmap.
+        const uint8_t previous =
+            uint8_t((uint8_t(cell.content.character[1]) & 0x03) << 6) |  // NOLINT
+            uint8_t(uint8_t(cell.content.character[2]) & 0x3F);          // NOLINT
+        mask |= previous & ~covered;
+      }
+
+      cell.type = CellType::kBraille;
+      cell.content.character.resize(3);
+      cell.content.character[0] = char(0xE2);                // NOLINT
+      cell.content.character[1] = char(0xA0 | (mask >> 6));  // NOLINT
+      cell.content.character[2] = char(0x80 | (mask & 0x3F));  // NOLINT
+      if (color) {
+        cell.content.foreground_color = *color;
+      }
+    }
+  }
+}
+
+// private
+void Canvas::PlotPoint(int x, int y, const Color* color) {
+  if (!IsIn(x, y)) {
+    return;
+  }
+  Cell& cell = CellAt(x / 2, y / 4);
+  if (color) {
+    cell.content.foreground_color = *color;
+  }
+  if (cell.type != CellType::kBraille) {
+    cell.content.character = "⠀";  // 3 bytes.
+    cell.type = CellType::kBraille;
+  }
+
+  cell.content.character[1] |= g_map_braille[x % 2][y % 4][0];  // NOLINT
+  cell.content.character[2] |= g_map_braille[x % 2][y % 4][1];  // NOLINT
+}
+
+// private
+// Same algorithm as DrawPointLine, without calling a Stylizer per dot.
+void Canvas::PlotLine(int x1, int y1, int x2, int y2, const Color* color) {
+  const int dx = std::abs(x2 - x1);
+  const int dy = std::abs(y2 - y1);
+  const int sx = x1 < x2 ? 1 : -1;
+  const int sy = y1 < y2 ? 1 : -1;
+  const int length = std::max(dx, dy);
+
+  if (!IsIn(x1, y1) && !IsIn(x2, y2)) {
+    return;
+  }
+  if (dx + dx > width_ * height_) {
+    return;
+  }
+
+  int error = dx - dy;
+  for (int i = 0; i < length; ++i) {
+    PlotPoint(x1, y1, color);
+    if (2 * error >= -dy) {
+      error -= dy;
+      x1 += sx;
+    }
+    if (2 * error <= dx) {
+      error += dx;
+      y1 += sy;
+    }
+  }
+  PlotPoint(x2, y2, color);
+}
+
 /// @brief Draw a circle made of braille dots.
 /// @param x the x coordinate of the center of the circle.
 /// @param y the y coordinate of the center of the circle.
@@ -470,14 +837,14 @@ void Canvas::DrawBlockOn(int x, int y) {
     return;
   }
   y /= 2;
-  Cell& cell = storage_[XY{x / 2, y / 2}];
+  Cell& cell = CellAt(x / 2, y / 2);
   if (cell.type != CellType::kBlock) {
     cell.content.character = " ";
     cell.type = CellType::kBlock;
   }
 
   const uint8_t bit = (x % 2) * 2 + y % 2;
-  uint8_t value = g_map_block_inversed.at(cell.content.character);
+  uint8_t value = BlockValue(cell.content.character);
   value |= 1U << bit;
   cell.content.character = g_map_block[value];
 }
@@ -489,7 +856,7 @@ void Canvas::DrawBlockOff(int x, int y) {
   if (!IsIn(x, y)) {
     return;
   }
-  Cell& cell = storage_[XY{x / 2, y / 4}];
+  Cell& cell = CellAt(x / 2, y / 4);
   if (cell.type != CellType::kBlock) {
     cell.content.character = " ";
     cell.type = CellType::kBlock;
@@ -497,7 +864,7 @@ void Canvas::DrawBlockOff(int x, int y) {
   y /= 2;
 
   const uint8_t bit = (y % 2) * 2 + x % 2;
-  uint8_t value = g_map_block_inversed.at(cell.content.character);
+  uint8_t value = BlockValue(cell.content.character);
   value &= ~(1U << bit);
   cell.content.character = g_map_block[value];
 }
@@ -510,7 +877,7 @@ void Canvas::DrawBlockToggle(int x, int y) {
   if (!IsIn(x, y)) {
     return;
   }
-  Cell& cell = storage_[XY{x / 2, y / 4}];
+  Cell& cell = CellAt(x / 2, y / 4);
   if (cell.type != CellType::kBlock) {
     cell.content.character = " ";
     cell.type = CellType::kBlock;
@@ -518,7 +885,7 @@ void Canvas::DrawBlockToggle(int x, int y) {
   y /= 2;
 
   const uint8_t bit = (y % 2) * 2 + x % 2;
-  uint8_t value = g_map_block_inversed.at(cell.content.character);
+  uint8_t value = BlockValue(cell.content.character);
   value ^= 1U << bit;
   cell.content.character = g_map_block[value];
 }
@@ -807,16 +1174,23 @@ void Canvas::DrawText(int x,
                       int y,
                       const std::string& value,
                       const Stylizer& style) {
-  for (const auto& it : Utf8ToGlyphs(value)) {
-    if (!IsIn(x, y)) {
+  for (const Glyph& glyph : GlyphRange(value)) {
+    // Fullwidth glyphs take two cells. The second is left empty.
+    for (int i = 0; i < glyph.width; ++i) {
+      if (!IsIn(x, y)) {
+        x += 2;
+        continue;
+      }
+      Cell& cell = CellAt(x / 2, y / 4);
+      cell.type = CellType::kCell;
+      if (i == 0) {
+        cell.content.character = glyph.text;
+      } else {
+        cell.content.character.clear();
+      }
+      style(cell.content);
       x += 2;
-      continue;
     }
-    Cell& cell = storage_[XY{x / 2, y / 4}];
-    cell.type = CellType::kCell;
-    cell.content.character = it;
-    style(cell.content);
-    x += 2;
   }
 }
 
@@ -825,7 +1199,7 @@ void Canvas::DrawText(int x,
 /// @param y the y coordinate of the pixel.
 /// @param p the pixel to draw.
 void Canvas::DrawPixel(int x, int y, const Pixel& p) {
-  Cell& cell = storage_[XY{x / 2, y / 4}];
+  Cell& cell = CellAt(x / 2, y / 4);
   cell.type = CellType::kCell;
   cell.content = p;
 }
@@ -846,10 +1220,7 @@ void Canvas::DrawImage(int x, int y, const Image& image) {
 
   for (int dy = dy_begin; dy < dy_end; ++dy) {
     for (int dx = dx_begin; dx < dx_end; ++dx) {
-      Cell& cell = storage_[XY{
-          x + dx,
-          y + dy,
-      }];
+      Cell& cell = CellAt(x + dx, y + dy);
       cell.type = CellType::kCell;
       cell.content = image.PixelAt(dx, dy);
     }
@@ -860,7 +1231,63 @@ void Canvas::DrawImage(int x, int y, const Image& image) {
 /// @param style a function that modifies the pixel.
 void Canvas::Style(int x, int y, const Stylizer& style) {
   if (IsIn(x, y)) {
-    style(storage_[XY{x / 2, y / 4}].content);
+    style(CellAt(x / 2, y / 4).content);
+  }
+}
+
+/// @brief Move the content of the canvas.
+/// @param dx the number of cells to move the content to the left. Negative
+/// values move it to the right.
+/// @param dy the number of cells to move the content to the top. Negative
+/// values move it to the bottom.
+///
+/// The cell previously at (x, y) is now at (x - dx, y - dy). The cells exposed
+/// are cleared. With Storage::Dense, the cells aren't moved: only the origin of
+/// the ring buffer storing them is. This makes strip charts cheap: scroll by
+/// one column, and only draw the new one.
+void Canvas::Scroll(int dx, int dy) {
+  if (storage_type_ == Storage::Sparse) {
+    const int cells_x = (width_ + 1) / 2;
+    const int cells_y = (height_ + 3) / 4;
+    std::unordered_map<XY, Cell, XYHash> storage(storage_.bucket_count());
+    for (auto& it : storage_) {
+      const XY xy = {it.first.x - dx, it.first.y - dy};
+      if (xy.x >= 0 && xy.x < cells_x && xy.y >= 0 && xy.y < cells_y) {
+        storage[xy] = std::move(it.second);
+      }
+    }
+    storage_ = std::move(storage);
+    return;
+  }
+
+  if (std::abs(dx) >= dense_width_ || std::abs(dy) >= dense_height_) {
+    std::fill(dense_storage_.begin(), dense_storage_.end(), Cell());
+    return;
+  }
+
+  auto wrap = [](int value, int size) {
+    value %= size;
+    return value < 0 ? value + size : value;
+  };
+  dense_origin_x_ = wrap(dense_origin_x_ + dx, dense_width_);
+  dense_origin_y_ = wrap(dense_origin_y_ + dy, dense_height_);
+
+  // Clear the exposed columns:
+  const int column_begin = dx > 0 ? dense_width_ - dx : 0;
+  const int column_end = dx > 0 ? dense_width_ : -dx;
+  for (int y = 0; y < dense_height_; ++y) {
+    for (int x = column_begin; x < column_end; ++x) {
+      dense_storage_[DenseIndex(x, y)] = Cell();
+    }
+  }
+
+  // Clear the exposed rows:
+  const int row_begin = dy > 0 ? dense_height_ - dy : 0;
+  const int row_end = dy > 0 ? dense_height_ : -dy;
+  for (int y = row_begin; y < row_end; ++y) {
+    for (int x = 0; x < dense_width_; ++x) {
+      dense_storage_[DenseIndex(x, y)] = Cell();
+    }
   }
 }
 
@@ -874,9 +1301,14 @@ class CanvasNodeBase : public Node {
     const Canvas& c = canvas();
     const int y_max = std::min(c.height() / 4, box_.y_max - box_.y_min + 1);
     const int x_max = std::min(c.width() / 2, box_.x_max - box_.x_min + 1);
+    // The cells are assigned in place, without copying them out first.
+    static const Pixel empty;
     for (int y = 0; y < y_max; ++y) {
-      for (int x = 0; x < x_max; ++x) {
-        screen.PixelAt(box_.x_min + x, box_.y_min + y) = c.GetPixel(x, y);
+      const Image::PixelRow row = screen.ClippedRow(
+          box_.x_min, box_.x_min + x_max - 1, box_.y_min + y);
+      for (int x = row.x_min; x <= row.x_max; ++x) {
+        const Pixel* pixel = c.FindPixel(x - box_.x_min, y);
+        row[x] = pixel ? *pixel : empty;
       }
     }
   }
@@ -898,7 +1330,7 @@ Element canvas(ConstRef<Canvas> canvas) {
     const Canvas& canvas() final { return *canvas_; }
     ConstRef<Canvas> canvas_;
   };
-  return std::make_shared<Impl>(canvas);
+  return MakeNode<Impl>(canvas);
 }
 
 /// @brief Produce an element drawing a canvas of requested size.
@@ -916,11 +1348,25 @@ Element canvas(int width, int height, std::function<void(Canvas&)> fn) {
       requirement_.min_y = (height_ + 3) / 4;
     }
 
-    void Render(Screen& screen) final {
+    void Check(Status* status) final {
+      Node::Check(status);
+      // A new layout discards the canvas drawn for the previous one.
+      prepared_ = false;
+    }
+
+    void Prepare() final {
       const int width = (box_.x_max - box_.x_min + 1) * 2;
       const int height = (box_.y_max - box_.y_min + 1) * 4;
       canvas_ = Canvas(width, height);
       fn_(canvas_);
+      prepared_ = true;
+    }
+
+    void Render(Screen& screen) final {
+      if (!prepared_) {
+        Prepare();
+      }
+      prepared_ = false;
       CanvasNodeBase::Render(screen);
     }
 
@@ -929,8 +1375,9 @@ Element canvas(int width, int height, std::function<void(Canvas&)> fn) {
     int width_;
     int height_;
     std::function<void(Canvas&)> fn_;
+    bool prepared_ = false;
   };
-  return std::make_shared<Impl>(width, height, std::move(fn));
+  return MakeNode<Impl>(width, height, std::move(fn));
 }
 
 /// @brief Produce an element drawing a canvas.
@@ -940,4 +1387,64 @@ Element canvas(std::function<void(Canvas&)> fn) {
   return canvas(default_dim, default_dim, std::move(fn));
 }
 
+/// @brief Produce an element drawing a canvas kept from one frame to the next.
+/// It requires the canvas's current size. The canvas is resized to the
+/// element's box and cleared, keeping its storage, before |fn| draws it.
+/// Animations don't allocate a canvas for every frame.
+/// @param canvas the canvas, owned by the caller. It must outlive the element.
+/// @param fn a function drawing the canvas.
+///
+/// ### Example
+///
+/// ```cpp
+/// Canvas c(100, 100, Canvas::Storage::Dense);
+/// auto renderer = Renderer([&] {
+///   return canvas(&c, [&](Canvas& c) { c.DrawPointLine(0, 0, x, y); });
+/// });
+/// ```
+Element canvas(Canvas* canvas, std::function<void(Canvas&)> fn) {
+  class Impl : public CanvasNodeBase {
+   public:
+    Impl(Canvas* canvas, std::function<void(Canvas&)> fn)
+        : canvas_(canvas), fn_(std::move(fn)) {}
+
+    void ComputeRequirement() final {
+      requirement_.min_x = (canvas_->width() + 1) / 2;
+      requirement_.min_y = (canvas_->height() + 3) / 4;
+    }
+
+    void Check(Status* status) final {
+      Node::Check(status);
+      // A new layout discards the canvas drawn for the previous one.
+      prepared_ = false;
+    }
+
+    void Prepare() final {
+      const int width = (box_.x_max - box_.x_min + 1) * 2;
+      const int height = (box_.y_max - box_.y_min + 1) * 4;
+      if (width == canvas_->width() && height == canvas_->height()) {
+        canvas_->Clear();
+      } else {
+        canvas_->Resize(width, height);
+      }
+      fn_(*canvas_);
+      prepared_ = true;
+    }
+
+    void Render(Screen& screen) final {
+      if (!prepared_) {
+        Prepare();
+      }
+      prepared_ = false;
+      CanvasNodeBase::Render(screen);
+    }
+
+    const Canvas& canvas() final { return *canvas_; }
+    Canvas* canvas_;
+    std::function<void(Canvas&)> fn_;
+    bool prepared_ = false;
+  };
+  return MakeNode<Impl>(canvas, std::move(fn));
+}
+
 }  // namespace ftxui
@@ -4,10 +4,12 @@
 #include <gtest/gtest.h>
 #include <cstdint>  // for uint32_t
 #include <string>   // for allocator, string
+#include <vector>   // for vector
 
-#include "ftxui/dom/canvas.hpp"    // for Canvas
-#include "ftxui/dom/elements.hpp"  // for canvas
-#include "ftxui/dom/node.hpp"      // for Render
+#include "ftxui/dom/canvas.hpp"        // for Canvas
+#include "ftxui/dom/elements.hpp"      // for canvas
+#include "ftxui/dom/graph_series.hpp"  // for GraphSeries
+#include "ftxui/dom/node.hpp"          // for Render
 #include "ftxui/screen/color.hpp"  // for Color, Color::Black, Color::Blue, Color::Red, Color::White, Color::Yellow, Color::Cyan, Color::Green
 #include "ftxui/screen/screen.hpp"    // for Screen
 #include "ftxui/screen/terminal.hpp"  // for SetColorSupport, Color, TrueColor
@@ -56,7 +58,7 @@ TEST(CanvasTest, GoldPointColor) {
   });
   Screen screen(30, 10);
   Render(screen, element);
-  EXPECT_EQ(Hash(screen.ToString()), 2295070594U) << screen.ToString();
+  EXPECT_EQ(Hash(screen.ToString()), 1385509914U) << screen.ToString();
 }
 
 TEST(CanvasTest, GoldBlock) {
@@ -89,7 +91,7 @@ TEST(CanvasTest, GoldBlockColor) {
   });
   Screen screen(30, 10);
   Render(screen, element);
-  EXPECT_EQ(Hash(screen.ToString()), 8392696U) << screen.ToString();
+  EXPECT_EQ(Hash(screen.ToString()), 4284716468U) << screen.ToString();
 }
 
 TEST(CanvasTest, GoldText) {
@@ -104,5 +106,201 @@ TEST(CanvasTest, GoldText) {
   EXPECT_EQ(Hash(screen.ToString()), 1074960375);
 }
 
+TEST(CanvasTest, DenseStorage) {
+  Terminal::SetColorSupport(Terminal::Color::TrueColor);
+  auto draw = [](Canvas& c) {
+    c.DrawPoint(3, 3, 1, Color::Red);
+    c.DrawPointToggle(2, 8);
+    c.DrawPointLine(3, 7, 10, 19, Color::Blue);
+    c.DrawPointCircleFilled(20, 5, 3, Color::Yellow);
+    c.DrawBlockLine(0, 0, 40, 30, Color::Green);
+    c.DrawText(10, 20, "Hello", Color::White);
+    // Out of bounds:
+    c.DrawPixel(60, 80, Pixel());
+    c.DrawText(-2, 0, "x");
+  };
+
+  Canvas sparse(40, 30);
+  Canvas dense(40, 30, Canvas::Storage::Dense);
+  draw(sparse);
+  draw(dense);
+
+  Screen screen_sparse(30, 10);
+  Screen screen_dense(30, 10);
+  Render(screen_sparse, canvas(&sparse));
+  Render(screen_dense, canvas(&dense));
+  EXPECT_EQ(screen_sparse.ToString(), screen_dense.ToString());
+  EXPECT_EQ(dense.GetPixel(100, 100).character, "");
+}
+
+TEST(CanvasTest, DrawPolyline) {
+  Terminal::SetColorSupport(Terminal::Color::TrueColor);
+  const std::vector<Canvas::Point> points = {
+      {0, 0}, {10, 15}, {25, 3}, {39, 29}, {-5, 10},
+  };
+  const std::vector<Color> colors = {
+      Color::Red, Color::Green, Color::Blue, Color::Yellow, Color::White,
+  };
+
+  Canvas expected(40, 30);
+  Canvas bulk(40, 30);
+  for (size_t i = 1; i < points.size(); ++i) {
+    expected.DrawPointLine(points[i - 1].x, points[i - 1].y, points[i].x,
+                           points[i].y, colors[i]);
+  }
+  bulk.DrawPolyline(points, colors);
+
+  Screen screen_expected(20, 8);
+  Screen screen_bulk(20, 8);
+  Render(screen_expected, canvas(&expected));
+  Render(screen_bulk, canvas(&bulk));
+  EXPECT_EQ(screen_expected.ToString(), screen_bulk.ToString());
+}
+
+TEST(CanvasTest, DrawPoints) {
+  Terminal::SetColorSupport(Terminal::Color::TrueColor);
+  const std::vector<Canvas::Point> points = {
+      {0, 0}, {1, 1}, {7, 5}, {39, 29}, {40, 30}, {-1, 3},
+  };
+
+  Canvas expected(40, 30);
+  Canvas bulk(40, 30);
+  for (const auto& point : points) {
+    expected.DrawPoint(point.x, point.y, true, Color::Red);
+  }
+  bulk.DrawPoints(points, Color::Red);
+
+  Screen screen_expected(20, 8);
+  Screen screen_bulk(20, 8);
+  Render(screen_expected, canvas(&expected));
+  Render(screen_bulk, canvas(&bulk));
+  EXPECT_EQ(screen_expected.ToString(), screen_bulk.ToString());
+}
+
+TEST(CanvasTest, DrawPointBitmap) {
+  Terminal::SetColorSupport(Terminal::Color::TrueColor);
+  const int width = 13;
+  const int height = 11;
+  std::vector<uint8_t> dots(width * height);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      dots[y * width + x] = (x * x + 3 * y) % 5 < 2;
+    }
+  }
+
+  for (const auto& origin : std::vector<Canvas::Point>{
+           {0, 0}, {3, 1}, {-3, -2}, {30, 22}}) {
+    Canvas expected(40, 30);
+    Canvas bitmap(40, 30);
+    expected.DrawPointLine(0, 0, 39, 29);
+    bitmap.DrawPointLine(0, 0, 39, 29);
+
+    for (int y = 0; y < height; ++y) {
+      for (int x = 0; x < width; ++x) {
+        expected.DrawPoint(origin.x + x, origin.y + y, dots[y * width + x]);
+      }
+    }
+    bitmap.DrawPointBitmap(origin.x, origin.y, width, height, dots);
+
+    Screen screen_expected(20, 8);
+    Screen screen_bitmap(20, 8);
+    Render(screen_expected, canvas(&expected));
+    Render(screen_bitmap, canvas(&bitmap));
+    EXPECT_EQ(screen_expected.ToString(), screen_bitmap.ToString());
+  }
+}
+
+TEST(CanvasTest, Scroll) {
+  Terminal::SetColorSupport(Terminal::Color::TrueColor);
+  auto draw = [](Canvas& c, int offset_x, int offset_y) {
+    for (int i = 0; i < 30; ++i) {
+      c.DrawPoint(i + 5 - offset_x, i - offset_y, true, Color::Red);
+    }
+    c.DrawText(10 - offset_x, 8 - offset_y, "Hi");
+  };
+
+  for (const auto& scroll : std::vector<Canvas::Point>{
+           {1, 0}, {0, 1}, {3, -2}, {-5, 2}, {19, 0}, {20, 0}, {0, -8}}) {
+    Canvas expected(40, 30);
+    draw(expected, scroll.x * 2, scroll.y * 4);
+
+    for (auto storage : {Canvas::Storage::Sparse, Canvas::Storage::Dense}) {
+      Canvas scrolled(40, 30, storage);
+      draw(scrolled, 0, 0);
+      scrolled.Scroll(scroll.x, scroll.y);
+
+      Screen screen_expected(20, 8);
+      Screen screen_scrolled(20, 8);
+      Render(screen_expected, canvas(&expected));
+      Render(screen_scrolled, canvas(&scrolled));
+      EXPECT_EQ(screen_expected.ToString(), screen_scrolled.ToString())
+          << scroll.x << "," << scroll.y;
+    }
+  }
+}
+
+TEST(CanvasTest, ScrollRepeated) {
+  // A strip chart: scroll by one column, and draw the new one.
+  Canvas dense(8, 4, Canvas::Storage::Dense);
+  for (int i = 0; i < 10; ++i) {
+    dense.Scroll(1, 0);
+    dense.DrawText(6, 0, std::to_string(i));
+  }
+  Screen screen(4, 1);
+  Render(screen, canvas(&dense));
+  EXPECT_EQ(screen.ToString(), "6789");
+}
+
+TEST(CanvasTest, Persistent) {
+  for (auto storage : {Canvas::Storage::Sparse, Canvas::Storage::Dense}) {
+    Canvas c(8, 4, storage);
+    for (int frame = 0; frame < 3; ++frame) {
+      Screen screen(4, 1);
+      Render(screen, canvas(&c, [&](Canvas& drawing) {
+               drawing.DrawText(frame * 2, 0, std::to_string(frame));
+             }));
+      // The previous frames were cleared.
+      EXPECT_EQ(screen.ToString(), std::string(frame, ' ') +
+                                       std::to_string(frame) +
+                                       std::string(3 - frame, ' '));
+    }
+
+    // The canvas follows the size of the element.
+    Screen screen(6, 2);
+    auto draw = [](Canvas& drawing) { drawing.DrawText(10, 4, "x"); };
+    Render(screen, canvas(&c, draw) | size(WIDTH, EQUAL, 6) |
+                       size(HEIGHT, EQUAL, 2));
+    EXPECT_EQ(c.width(), 12);
+    EXPECT_EQ(c.height(), 8);
+    EXPECT_EQ(screen.ToString(), "      \r\n     x");
+  }
+}
+
+TEST(CanvasTest, ClearKeepsSize) {
+  Canvas c(8, 8, Canvas::Storage::Dense);
+  c.DrawText(2, 4, "a");
+  c.Scroll(1, 1);
+  ASSERT_NE(c.FindPixel(0, 0), nullptr);
+  EXPECT_EQ(c.FindPixel(0, 0)->character, "a");
+  c.Clear();
+  EXPECT_EQ(c.width(), 8);
+  EXPECT_EQ(c.GetPixel(0, 0).character, "");
+  EXPECT_EQ(c.GetPixel(1, 1).character, "");
+}
+
+TEST(CanvasTest, DrawPointSeries) {
+  GraphSeries series(1000);
+  for (int i = 0; i < 1000; ++i) {
+    series.Push(i == 700 ? 1.F : 0.F);
+  }
+
+  // 1000 samples over 4 columns of dots: the spike is kept by the third one.
+  Canvas c(4, 4);
+  c.DrawPointSeries(0, 0, 4, 4, series);
+  Screen screen(2, 1);
+  Render(screen, canvas(std::move(c)));
+  EXPECT_EQ(screen.ToString(), "⣀⣇");
+}
+
 }  // namespace ftxui
 // NOLINTEND
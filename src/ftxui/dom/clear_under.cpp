@@ -7,6 +7,7 @@
 #include "ftxui/dom/elements.hpp"        // for Element, clear_under
 #include "ftxui/dom/node.hpp"            // for Node
 #include "ftxui/dom/node_decorator.hpp"  // for NodeDecorator
+#include "ftxui/dom/node_pool.hpp"       // for MakeNode
 #include "ftxui/screen/box.hpp"          // for Box
 #include "ftxui/screen/screen.hpp"       // for Pixel, Screen
 
@@ -19,6 +20,8 @@ class ClearUnder : public NodeDecorator {
  public:
   using NodeDecorator::NodeDecorator;
 
+  LayoutKind layout_kind() const override { return LayoutKind::kDecorator; }
+
   void Render(Screen& screen) override {
     for (int y = box_.y_min; y <= box_.y_max; ++y) {
       for (int x = box_.x_min; x <= box_.x_max; ++x) {
@@ -36,7 +39,7 @@ class ClearUnder : public NodeDecorator {
 /// @see ftxui::dbox
 /// @ingroup dom
 Element clear_under(Element element) {
-  return std::make_shared<ClearUnder>(std::move(element));
+  return MakeNode<ClearUnder>(std::move(element));
 }
 
 }  // namespace ftxui
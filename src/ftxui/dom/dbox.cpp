@@ -4,18 +4,86 @@
 #include <algorithm>  // for max
 #include <cstddef>    // for size_t
 #include <memory>     // for __shared_ptr_access, shared_ptr, make_shared
-#include <utility>    // for move
-#include <vector>
+#include <utility>    // for move, swap
+#include <vector>     // for vector
 
 #include "ftxui/dom/elements.hpp"     // for Element, Elements, dbox
 #include "ftxui/dom/node.hpp"         // for Node, Elements
+#include "ftxui/dom/node_pool.hpp"    // for MakeNode
 #include "ftxui/dom/requirement.hpp"  // for Requirement
 #include "ftxui/screen/box.hpp"       // for Box
 #include "ftxui/screen/pixel.hpp"     // for Pixel
+#include "ftxui/screen/screen.hpp"    // for Screen
 
 namespace ftxui {
 
 namespace {
+
+// Whether |pixel| is a default one. Compositing it changes nothing.
+bool IsDefault(const Pixel& pixel) {
+  return pixel.character.empty() && pixel.hyperlink == 0 &&           //
+         !pixel.blink && !pixel.bold && !pixel.dim && !pixel.inverted &&  //
+         !pixel.underlined && !pixel.underlined_double &&                //
+         !pixel.strikethrough && !pixel.automerge &&                     //
+         pixel.foreground_color.Key() == 0 &&                           //
+         pixel.background_color.Key() == 0;
+}
+
+// Draw |pixel| over |acc|. The character of |pixel| is moved.
+void Composite(Pixel& acc, Pixel& pixel) {
+  acc.background_color = Color::Blend(acc.background_color,  //
+                                      pixel.background_color);
+  acc.automerge = pixel.automerge || acc.automerge;
+  if (pixel.character.empty()) {
+    acc.foreground_color =
+        Color::Blend(acc.foreground_color, pixel.background_color);
+    return;
+  }
+  acc.blink = pixel.blink;
+  acc.bold = pixel.bold;
+  acc.dim = pixel.dim;
+  acc.inverted = pixel.inverted;
+  acc.underlined = pixel.underlined;
+  acc.underlined_double = pixel.underlined_double;
+  acc.strikethrough = pixel.strikethrough;
+  acc.hyperlink = pixel.hyperlink;
+  acc.character.swap(pixel.character);
+  acc.foreground_color = pixel.foreground_color;
+}
+
+// The pixels composited by the dboxes being rendered, one buffer per level of
+// nesting. The buffers are kept from one frame to the next, and hold default
+// pixels in between two uses.
+struct ScratchBuffers {
+  std::vector<std::vector<Pixel>> buffers;
+  std::size_t depth = 0;
+};
+thread_local ScratchBuffers g_scratch;  // NOLINT
+
+// The scratch buffer of a dbox, for the duration of its rendering.
+class Scratch {
+ public:
+  explicit Scratch(std::size_t size) {
+    if (g_scratch.buffers.size() <= g_scratch.depth) {
+      g_scratch.buffers.emplace_back();
+    }
+    std::vector<Pixel>& buffer = g_scratch.buffers[g_scratch.depth++];
+    if (buffer.size() < size) {
+      buffer.resize(size);
+    }
+    // The nested dboxes may move the vector, but not its pixels.
+    data_ = buffer.data();
+  }
+  ~Scratch() { --g_scratch.depth; }
+  Scratch(const Scratch&) = delete;
+  Scratch& operator=(const Scratch&) = delete;
+
+  Pixel* data() const { return data_; }
+
+ private:
+  Pixel* data_;
+};
+
 class DBox : public Node {
  public:
   explicit DBox(Elements children) : Node(std::move(children)) {}
@@ -29,7 +97,7 @@ class DBox : public Node {
     requirement_.flex_shrink_y = 0;
     requirement_.selection = Requirement::NORMAL;
     for (auto& child : children_) {
-      child->ComputeRequirement();
+      ComputeChildRequirement(child.get());
       requirement_.min_x =
           std::max(requirement_.min_x, child->requirement().min_x);
       requirement_.min_y =
@@ -46,58 +114,49 @@ class DBox : public Node {
     Node::SetBox(box);
 
     for (auto& child : children_) {
-      child->SetBox(box);
+      SetChildBox(child.get(), box);
     }
   }
 
   void Render(Screen& screen) override {
-    if (children_.size() <= 1) {
+    // Only the pixels within the stencil can be drawn.
+    const Box area = Box::Intersection(box_, screen.stencil);
+    if (children_.size() <= 1 || area.IsEmpty()) {
       Node::Render(screen);
       return;
     }
 
-    const int width = box_.x_max - box_.x_min + 1;
-    const int height = box_.y_max - box_.y_min + 1;
-    std::vector<Pixel> pixels(std::size_t(width * height));
+    const int width = area.x_max - area.x_min + 1;
+    const int height = area.y_max - area.y_min + 1;
+    const Scratch scratch(std::size_t(width) * std::size_t(height));
 
+    // Each child is drawn over default pixels. Its pixels are moved out and
+    // composited over the ones of the previous children, row by row. The
+    // default pixels, like the ones the child didn't draw, are left in place.
+    const Screen& const_screen = screen;
     for (auto& child : children_) {
       child->Render(screen);
 
-      // Accumulate the pixels
-      Pixel* acc = pixels.data();
-      for (int x = 0; x < width; ++x) {
-        for (int y = 0; y < height; ++y) {
-          auto& pixel = screen.PixelAt(x + box_.x_min, y + box_.y_min);
-          acc->background_color =
-              Color::Blend(acc->background_color, pixel.background_color);
-          acc->automerge = pixel.automerge || acc->automerge;
-          if (pixel.character.empty()) {
-            acc->foreground_color =
-                Color::Blend(acc->foreground_color, pixel.background_color);
-          } else {
-            acc->blink = pixel.blink;
-            acc->bold = pixel.bold;
-            acc->dim = pixel.dim;
-            acc->inverted = pixel.inverted;
-            acc->underlined = pixel.underlined;
-            acc->underlined_double = pixel.underlined_double;
-            acc->strikethrough = pixel.strikethrough;
-            acc->hyperlink = pixel.hyperlink;
-            acc->character = pixel.character;
-            acc->foreground_color = pixel.foreground_color;
+      Pixel* acc = scratch.data();
+      for (int y = area.y_min; y <= area.y_max; ++y) {
+        for (int x = area.x_min; x <= area.x_max; ++x, ++acc) {  // NOLINT
+          if (IsDefault(const_screen.PixelAt(x, y))) {
+            continue;
           }
-          ++acc;  // NOLINT
-
+          Pixel& pixel = screen.PixelAt(x, y);
+          Composite(*acc, pixel);
           pixel = Pixel();
         }
       }
     }
 
-    // Render the accumulated pixels:
-    Pixel* acc = pixels.data();
-    for (int x = 0; x < width; ++x) {
-      for (int y = 0; y < height; ++y) {
-        screen.PixelAt(x + box_.x_min, y + box_.y_min) = *acc++;  // NOLINT
+    // Render the accumulated pixels. The scratch pixels are left default.
+    Pixel* acc = scratch.data();
+    for (int y = area.y_min; y <= area.y_max; ++y) {
+      for (int x = area.x_min; x <= area.x_max; ++x, ++acc) {  // NOLINT
+        if (!IsDefault(*acc)) {
+          std::swap(*acc, screen.PixelAt(x, y));
+        }
       }
     }
   }
@@ -109,7 +168,7 @@ class DBox : public Node {
 /// @return The right aligned element.
 /// @ingroup dom
 Element dbox(Elements children_) {
-  return std::make_shared<DBox>(std::move(children_));
+  return MakeNode<DBox>(std::move(children_));
 }
 
 }  // namespace ftxui
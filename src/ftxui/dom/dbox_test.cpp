@@ -6,6 +6,7 @@
 
 #include "ftxui/dom/elements.hpp"  // for filler, operator|, text, border, dbox, hbox, vbox, Element
 #include "ftxui/dom/node.hpp"       // for Render
+#include "ftxui/screen/color.hpp"   // for Color
 #include "ftxui/screen/screen.hpp"  // for Screen
 
 // NOLINTBEGIN
@@ -32,5 +33,46 @@ TEST(DBoxTest, Basic) {
             "╰────╯  ");
 }
 
+TEST(DBoxTest, Style) {
+  auto root = dbox({
+      text("ab") | bgcolor(Color::Blue),
+      text("x") | bold,
+  });
+
+  Screen screen(3, 1);
+  Render(screen, root);
+  EXPECT_EQ(screen.PixelAt(0, 0).character, "x");
+  EXPECT_TRUE(screen.PixelAt(0, 0).bold);
+  EXPECT_EQ(screen.PixelAt(0, 0).background_color, Color::Blue);
+  EXPECT_EQ(screen.PixelAt(1, 0).character, "b");
+  EXPECT_FALSE(screen.PixelAt(1, 0).bold);
+  EXPECT_EQ(screen.PixelAt(1, 0).background_color, Color::Blue);
+}
+
+TEST(DBoxTest, Nested) {
+  auto root = dbox({
+      text("abcd"),
+      dbox({
+          text("xy"),
+          text("z"),
+      }),
+  });
+
+  Screen screen(5, 1);
+  Render(screen, root);
+  EXPECT_EQ(screen.ToString(), "zycd ");
+
+  // The pixels kept in between two frames don't leak into the next one.
+  Screen other(5, 1);
+  Render(other, dbox({text("a"), text("")}));
+  EXPECT_EQ(other.ToString(), "a    ");
+}
+
+TEST(DBoxTest, Clipped) {
+  Screen screen(3, 1);
+  Render(screen, dbox({text("abcde"), text("x")}));
+  EXPECT_EQ(screen.ToString(), "xbc");
+}
+
 }  // namespace ftxui
 // NOLINTEND
@@ -0,0 +1,98 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <algorithm>  // for max
+#include <cstddef>    // for size_t
+#include <cstdlib>    // for free
+#include <memory>     // for shared_ptr
+#include <string>     // for string
+#include <typeinfo>   // for type_info
+#include <utility>    // for pair
+#include <vector>     // for vector
+
+#if defined(__GNUG__)
+#include <cxxabi.h>  // for __cxa_demangle
+#endif
+
+#include "ftxui/dom/element_stats.hpp"
+#include "ftxui/dom/node.hpp"  // for Node, Element
+
+namespace ftxui {
+
+namespace {
+
+// The name of the class, without its namespaces, like "Text".
+std::string TypeName(const std::type_info& type) {
+  std::string name = type.name();
+#if defined(__GNUG__)
+  int status = 0;
+  char* demangled =
+      abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+  if (status == 0 && demangled) {
+    name = demangled;
+  }
+  std::free(demangled);  // NOLINT
+#endif
+  // MSVC prefixes the names with "class ".
+  const size_t space = name.rfind(' ');
+  if (space != std::string::npos) {
+    name = name.substr(space + 1);
+  }
+  const size_t scope = name.rfind("::");
+  if (scope != std::string::npos) {
+    name = name.substr(scope + 2);
+  }
+  return name;
+}
+
+}  // namespace
+
+/// @brief Measure a tree of elements: its number of nodes of each type, its
+/// depth, and the memory it uses.
+/// @ingroup dom
+///
+/// This is meant for debugging: the names of the types are looked up for
+/// every node.
+///
+/// ### Example
+///
+/// ```cpp
+/// ElementStats stats = Inspect(document);
+/// for (const auto& [type, count] : stats.nodes_per_type) {
+///   std::cout << type << ": " << count << std::endl;
+/// }
+/// ```
+ElementStats Inspect(const Element& element) {
+  ElementStats stats;
+  if (!element) {
+    return stats;
+  }
+
+  // A shared_ptr made by make_shared stores its reference counts next to the
+  // object.
+  constexpr size_t kNodeBytes = sizeof(Node) + 2 * sizeof(long);  // NOLINT
+
+  std::vector<std::pair<const Node*, int>> stack = {{element.get(), 1}};
+  while (!stack.empty()) {
+    const auto [node, depth] = stack.back();
+    stack.pop_back();
+
+    stats.nodes++;
+    stats.depth = std::max(stats.depth, depth);
+    stats.children_capacity += node->children_.capacity();
+    stats.text_bytes += node->TextBytes();
+    stats.nodes_per_type[TypeName(typeid(*node))]++;
+
+    for (const Element& child : node->children_) {
+      if (child) {
+        stack.emplace_back(child.get(), depth + 1);
+      }
+    }
+  }
+  stats.heap_bytes = stats.nodes * kNodeBytes +
+                     stats.children_capacity * sizeof(Element) +
+                     stats.text_bytes;
+  return stats;
+}
+
+}  // namespace ftxui
@@ -0,0 +1,43 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+
+#include "ftxui/dom/element_stats.hpp"
+#include "ftxui/dom/elements.hpp"  // for text, hbox, vbox, border
+
+// NOLINTBEGIN
+namespace ftxui {
+
+TEST(ElementStatsTest, Empty) {
+  const ElementStats stats = Inspect(nullptr);
+  EXPECT_EQ(stats.nodes, 0u);
+  EXPECT_EQ(stats.depth, 0);
+  EXPECT_TRUE(stats.nodes_per_type.empty());
+}
+
+TEST(ElementStatsTest, Tree) {
+  auto document = vbox({
+                      text("hello"),
+                      hbox({text("a"), text("bc")}),
+                  }) |
+                  border;
+  const ElementStats stats = Inspect(document);
+
+  // border > vbox > hbox > text.
+  EXPECT_EQ(stats.depth, 4);
+  EXPECT_EQ(stats.text_bytes, 8u);
+  EXPECT_GE(stats.children_capacity, 5u);
+  EXPECT_GT(stats.heap_bytes, stats.text_bytes);
+
+  size_t nodes = 0;
+  for (const auto& [type, count] : stats.nodes_per_type) {
+    nodes += count;
+  }
+  EXPECT_EQ(nodes, stats.nodes);
+  EXPECT_EQ(stats.nodes_per_type.at("Text"), 3u);
+  EXPECT_EQ(stats.nodes, 6u);
+}
+
+}  // namespace ftxui
+// NOLINTEND
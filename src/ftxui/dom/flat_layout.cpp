@@ -0,0 +1,273 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/dom/flat_layout.hpp"
+
+#include <algorithm>  // for max
+#include <chrono>     // for steady_clock, duration
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint32_t
+
+#include "ftxui/dom/box_helper.hpp"   // for Element, Compute
+#include "ftxui/dom/node.hpp"         // for Node
+#include "ftxui/dom/requirement.hpp"  // for Requirement
+#include "ftxui/screen/box.hpp"       // for Box
+#include "ftxui/screen/screen.hpp"    // for Screen
+
+namespace ftxui {
+
+namespace {
+
+// Return the seconds elapsed since |start|, and move |start| to now.
+double SecondsSince(std::chrono::steady_clock::time_point& start) {
+  const auto now = std::chrono::steady_clock::now();
+  const double seconds = std::chrono::duration<double>(now - start).count();
+  start = now;
+  return seconds;
+}
+
+// The requirement of an hbox, or of a vbox when |row| is false, from the ones
+// of its |count| children, at the indices |children| of |requirements|.
+Requirement Stack(const Requirement* requirements,
+                  const uint32_t* children,
+                  uint32_t count,
+                  bool row) {
+  Requirement r;
+  r.min_x = 0;
+  r.min_y = 0;
+  r.flex_grow_x = 0;
+  r.flex_grow_y = 0;
+  r.flex_shrink_x = 0;
+  r.flex_shrink_y = 0;
+  r.selection = Requirement::NORMAL;
+  for (uint32_t i = 0; i < count; ++i) {
+    const Requirement& child = requirements[children[i]];
+    if (r.selection < child.selection) {
+      r.selection = child.selection;
+      r.selected_box = child.selected_box;
+      if (row) {
+        r.selected_box.x_min += r.min_x;
+        r.selected_box.x_max += r.min_x;
+      } else {
+        r.selected_box.y_min += r.min_y;
+        r.selected_box.y_max += r.min_y;
+      }
+    }
+    if (row) {
+      r.min_x += child.min_x;
+      r.min_y = std::max(r.min_y, child.min_y);
+    } else {
+      r.min_y += child.min_y;
+      r.min_x = std::max(r.min_x, child.min_x);
+    }
+  }
+  return r;
+}
+
+}  // namespace
+
+FlatLayout::FlatLayout() = default;
+FlatLayout::~FlatLayout() = default;
+
+/// @brief Display an element on a ftxui::Screen, like Render() does.
+/// @ingroup dom
+void FlatLayout::Render(Screen& screen, const Element& element) {
+  Render(screen, element.get());
+}
+
+/// @brief Display an element on a ftxui::Screen, like Render() does.
+/// @ingroup dom
+void FlatLayout::Render(Screen& screen, Node* node) {
+  Screen::RenderTimings timings;
+  auto start = std::chrono::steady_clock::now();
+  const Box box = Layout(screen, node);
+  timings.layout = SecondsSince(start);
+
+  screen.stencil = box;
+  node->Render(screen);
+  timings.draw = SecondsSince(start);
+
+  screen.ApplyShader();
+  timings.shader = SecondsSince(start);
+  screen.SetRenderTimings(timings);
+}
+
+// Like Node::LayoutRoot, with the flat passes.
+Box FlatLayout::Layout(Screen& screen, Node* root) {
+  Box box;
+  box.x_min = 0;
+  box.y_min = 0;
+  box.x_max = screen.dimx() - 1;
+  box.y_max = screen.dimy() - 1;
+
+  // A Measure() is not continued: the requirements are computed again.
+  root->measured_ = false;
+
+  Node::Status status;
+  Flatten(root, &status);
+  bool measured = true;
+  const int max_iterations = 20;
+  while (status.need_iteration && status.iteration < max_iterations) {
+    ComputeRequirements(/*opaque=*/!measured);
+    measured = false;
+    SetBoxes(box);
+    status.need_iteration = false;
+    status.iteration++;
+    Check(&status);
+  }
+  return box;
+}
+
+// Depth first, in the order the nodes were built, and likely allocated. The
+// opaque nodes are checked and measured on the way, for the first iteration:
+// every node is visited once.
+void FlatLayout::Flatten(Node* root, Node::Status* status) {
+  nodes_.clear();
+  kinds_.clear();
+  first_child_.clear();
+  child_count_.clear();
+  children_.clear();
+  requirements_.clear();
+  Append(root, status);
+  boxes_.resize(nodes_.size());
+}
+
+// Append |node| and the nodes it doesn't lay out itself. Return its index.
+uint32_t FlatLayout::Append(Node* node, Node::Status* status) {
+  const auto index = uint32_t(nodes_.size());
+  const Node::LayoutKind kind = node->layout_kind();
+  nodes_.push_back(node);
+  kinds_.push_back(kind);
+  if (kind == Node::LayoutKind::kOpaque) {
+    CheckOpaque(index, status);
+    node->ComputeRequirement();
+    requirements_.push_back(node->requirement_);
+    first_child_.push_back(0);
+    child_count_.push_back(0);
+    return index;
+  }
+  // Like Node::Check: the first iteration is always needed.
+  status->need_iteration |= (status->iteration == 0);
+  requirements_.emplace_back();
+
+  const auto first = uint32_t(children_.size());
+  const auto count = uint32_t(node->children_.size());
+  first_child_.push_back(first);
+  child_count_.push_back(count);
+  children_.resize(first + count);
+  for (uint32_t k = 0; k < count; ++k) {
+    children_[first + k] = Append(node->children_[k].get(), status);
+  }
+  return index;
+}
+
+// Like Node::Check over the whole tree. The nodes laid out here only forward
+// it to their children, so only the opaque nodes are called.
+void FlatLayout::Check(Node::Status* status) {
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    if (kinds_[i] == Node::LayoutKind::kOpaque) {
+      CheckOpaque(i, status);
+    }
+  }
+}
+
+void FlatLayout::CheckOpaque(size_t index, Node::Status* status) {
+  if (index == 0) {
+    nodes_[0]->Check(status);
+  } else {
+    Node::CheckChild(nodes_[index], status);
+  }
+}
+
+// Children before parents: in reverse order. The requirements of the nodes
+// laid out here are only read by their parent, from |requirements_|: they
+// aren't written back into the nodes, except for the root. The |opaque| nodes
+// are measured too, unless Flatten() just did.
+void FlatLayout::ComputeRequirements(bool opaque) {
+  for (size_t i = nodes_.size(); i-- > 0;) {
+    const uint32_t* children = children_.data() + first_child_[i];
+    switch (kinds_[i]) {
+      case Node::LayoutKind::kOpaque: {
+        // Like Node::ComputeChildRequirement, except for the root.
+        Node* node = nodes_[i];
+        if (opaque && (i == 0 || !node->layout_stable_)) {
+          node->ComputeRequirement();
+          requirements_[i] = node->requirement_;
+        }
+        break;
+      }
+      case Node::LayoutKind::kRow:
+        requirements_[i] =
+            Stack(requirements_.data(), children, child_count_[i], true);
+        break;
+      case Node::LayoutKind::kColumn:
+        requirements_[i] =
+            Stack(requirements_.data(), children, child_count_[i], false);
+        break;
+      case Node::LayoutKind::kDecorator:
+        requirements_[i] = requirements_[children[0]];
+        break;
+      case Node::LayoutKind::kAdjust:
+        requirements_[i] = requirements_[children[0]];
+        nodes_[i]->AdjustRequirement(&requirements_[i]);
+        break;
+    }
+  }
+  nodes_[0]->requirement_ = requirements_[0];
+}
+
+// Parents before children: in order.
+void FlatLayout::SetBoxes(Box box) {
+  boxes_[0] = box;
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    Node* node = nodes_[i];
+    const Box& node_box = boxes_[i];
+    const Node::LayoutKind kind = kinds_[i];
+    if (kind == Node::LayoutKind::kOpaque) {
+      // Like Node::SetChildBox, except for the root.
+      if (i == 0 || !node->layout_stable_ || node_box != node->box_) {
+        node->SetBox(node_box);
+      }
+      continue;
+    }
+    node->box_ = node_box;
+
+    const uint32_t* children = children_.data() + first_child_[i];
+    const uint32_t count = child_count_[i];
+    if (kind == Node::LayoutKind::kDecorator ||
+        kind == Node::LayoutKind::kAdjust) {
+      boxes_[children[0]] = node_box;
+      continue;
+    }
+
+    const bool row = kind == Node::LayoutKind::kRow;
+    sizes_.resize(count);
+    for (uint32_t k = 0; k < count; ++k) {
+      const Requirement& requirement = requirements_[children[k]];
+      box_helper::Element& element = sizes_[k];
+      element.min_size = row ? requirement.min_x : requirement.min_y;
+      element.flex_grow =
+          row ? requirement.flex_grow_x : requirement.flex_grow_y;
+      element.flex_shrink =
+          row ? requirement.flex_shrink_x : requirement.flex_shrink_y;
+    }
+    box_helper::Compute(&sizes_, row ? node_box.x_max - node_box.x_min + 1
+                                     : node_box.y_max - node_box.y_min + 1);
+
+    Box child_box = node_box;
+    int position = row ? node_box.x_min : node_box.y_min;
+    for (uint32_t k = 0; k < count; ++k) {
+      if (row) {
+        child_box.x_min = position;
+        child_box.x_max = position + sizes_[k].size - 1;
+      } else {
+        child_box.y_min = position;
+        child_box.y_max = position + sizes_[k].size - 1;
+      }
+      boxes_[children[k]] = child_box;
+      position += sizes_[k].size;
+    }
+  }
+}
+
+}  // namespace ftxui
@@ -0,0 +1,77 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <string>  // for string, to_string
+
+#include "ftxui/dom/elements.hpp"  // for text, hbox, vbox, border, flex, paragraph, gauge, color, frame, focus
+#include "ftxui/dom/flat_layout.hpp"  // for FlatLayout
+#include "ftxui/dom/node.hpp"         // for Render
+#include "ftxui/screen/color.hpp"     // for Color
+#include "ftxui/screen/screen.hpp"    // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+
+Element Document() {
+  Elements rows;
+  for (int i = 0; i < 30; ++i) {
+    Element row = hbox({
+        text(std::to_string(i)) | color(Color::Red),
+        text(" "),
+        gauge(float(i) / 30.f) | flex,
+        separator(),
+        text("end") | bold,
+    });
+    if (i == 20) {
+      row = row | focus;
+    }
+    rows.push_back(row);
+  }
+  return hbox({
+      vbox(std::move(rows)) | yframe | border | flex,
+      vbox({
+          paragraph("The quick brown fox jumps over the lazy dog.") | border,
+          filler(),
+          text("bottom") | inverted | hcenter,
+      }) | size(WIDTH, EQUAL, 14),
+  });
+}
+
+}  // namespace
+
+TEST(FlatLayoutTest, SameAsRender) {
+  FlatLayout layout;
+  for (int width : {10, 30, 60}) {
+    for (int height : {5, 12, 40}) {
+      Screen expected(width, height);
+      Render(expected, Document());
+      Screen screen(width, height);
+      layout.Render(screen, Document());
+      EXPECT_EQ(screen.ToString(), expected.ToString())
+          << width << "x" << height;
+    }
+  }
+}
+
+TEST(FlatLayoutTest, StopsAtOpaqueNodes) {
+  FlatLayout layout;
+  Screen screen(6, 4);
+  auto document = vbox({
+      hbox({text("a"), text("b") | inverted}),
+      text("c") | border,
+  });
+  layout.Render(screen, document);
+  // vbox, hbox, border, a, inverted, then b. The text inside the border isn't
+  // flattened.
+  EXPECT_EQ(layout.size(), 6u);
+  EXPECT_EQ(screen.PixelAt(1, 0).character, "b");
+  EXPECT_TRUE(screen.PixelAt(1, 0).inverted);
+  EXPECT_EQ(screen.PixelAt(1, 2).character, "c");
+  EXPECT_EQ(screen.PixelAt(5, 3).character, "╯");
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -6,6 +6,7 @@
 
 #include "ftxui/dom/elements.hpp"  // for Element, unpack, filler, flex, flex_grow, flex_shrink, notflex, xflex, xflex_grow, xflex_shrink, yflex, yflex_grow, yflex_shrink
 #include "ftxui/dom/node.hpp"      // for Elements, Node
+#include "ftxui/dom/node_pool.hpp"  // for MakeNode
 #include "ftxui/dom/requirement.hpp"  // for Requirement
 #include "ftxui/screen/box.hpp"       // for Box
 
@@ -69,21 +70,30 @@ class Flex : public Node {
  public:
   explicit Flex(FlexFunction f) : f_(f) {}
   Flex(FlexFunction f, Element child) : Node(unpack(std::move(child))), f_(f) {}
+
+  LayoutKind layout_kind() const override {
+    return children_.empty() ? LayoutKind::kOpaque : LayoutKind::kAdjust;
+  }
+  void AdjustRequirement(Requirement* requirement) const override {
+    f_(*requirement);
+  }
+
   void ComputeRequirement() override {
     requirement_.min_x = 0;
     requirement_.min_y = 0;
     if (!children_.empty()) {
-      children_[0]->ComputeRequirement();
+      ComputeChildRequirement(children_[0].get());
       requirement_ = children_[0]->requirement();
     }
     f_(requirement_);
   }
 
   void SetBox(Box box) override {
+    Node::SetBox(box);
     if (children_.empty()) {
       return;
     }
-    children_[0]->SetBox(box);
+    SetChildBox(children_[0].get(), box);
   }
 
   FlexFunction f_;
@@ -95,7 +105,7 @@ class Flex : public Node {
 /// a container.
 /// @ingroup dom
 Element filler() {
-  return std::make_shared<Flex>(function_flex);
+  return MakeNode<Flex>(function_flex);
 }
 
 /// @brief Make a child element to expand proportionally to the space left in a
@@ -120,61 +130,61 @@ Element filler() {
 /// └────┘└─────────────────────────────────────────────────────────┘└─────┘
 /// ~~~
 Element flex(Element child) {
-  return std::make_shared<Flex>(function_flex, std::move(child));
+  return MakeNode<Flex>(function_flex, std::move(child));
 }
 
 /// @brief Expand/Minimize if possible/needed on the X axis.
 /// @ingroup dom
 Element xflex(Element child) {
-  return std::make_shared<Flex>(function_xflex, std::move(child));
+  return MakeNode<Flex>(function_xflex, std::move(child));
 }
 
 /// @brief Expand/Minimize if possible/needed on the Y axis.
 /// @ingroup dom
 Element yflex(Element child) {
-  return std::make_shared<Flex>(function_yflex, std::move(child));
+  return MakeNode<Flex>(function_yflex, std::move(child));
 }
 
 /// @brief Expand if possible.
 /// @ingroup dom
 Element flex_grow(Element child) {
-  return std::make_shared<Flex>(function_flex_grow, std::move(child));
+  return MakeNode<Flex>(function_flex_grow, std::move(child));
 }
 
 /// @brief Expand if possible on the X axis.
 /// @ingroup dom
 Element xflex_grow(Element child) {
-  return std::make_shared<Flex>(function_xflex_grow, std::move(child));
+  return MakeNode<Flex>(function_xflex_grow, std::move(child));
 }
 
 /// @brief Expand if possible on the Y axis.
 /// @ingroup dom
 Element yflex_grow(Element child) {
-  return std::make_shared<Flex>(function_yflex_grow, std::move(child));
+  return MakeNode<Flex>(function_yflex_grow, std::move(child));
 }
 
 /// @brief Minimize if needed.
 /// @ingroup dom
 Element flex_shrink(Element child) {
-  return std::make_shared<Flex>(function_flex_shrink, std::move(child));
+  return MakeNode<Flex>(function_flex_shrink, std::move(child));
 }
 
 /// @brief Minimize if needed on the X axis.
 /// @ingroup dom
 Element xflex_shrink(Element child) {
-  return std::make_shared<Flex>(function_xflex_shrink, std::move(child));
+  return MakeNode<Flex>(function_xflex_shrink, std::move(child));
 }
 
 /// @brief Minimize if needed on the Y axis.
 /// @ingroup dom
 Element yflex_shrink(Element child) {
-  return std::make_shared<Flex>(function_yflex_shrink, std::move(child));
+  return MakeNode<Flex>(function_yflex_shrink, std::move(child));
 }
 
 /// @brief Make the element not flexible.
 /// @ingroup dom
 Element notflex(Element child) {
-  return std::make_shared<Flex>(function_not_flex, std::move(child));
+  return MakeNode<Flex>(function_not_flex, std::move(child));
 }
 
 }  // namespace ftxui
@@ -11,6 +11,7 @@
 #include "ftxui/dom/flexbox_config.hpp"  // for FlexboxConfig, FlexboxConfig::Direction, FlexboxConfig::Direction::Column, FlexboxConfig::AlignContent, FlexboxConfig::Direction::ColumnInversed, FlexboxConfig::Direction::Row, FlexboxConfig::JustifyContent, FlexboxConfig::Wrap, FlexboxConfig::AlignContent::FlexStart, FlexboxConfig::Direction::RowInversed, FlexboxConfig::JustifyContent::FlexStart, FlexboxConfig::Wrap::Wrap
 #include "ftxui/dom/flexbox_helper.hpp"  // for Block, Global, Compute
 #include "ftxui/dom/node.hpp"            // for Node, Elements, Node::Status
+#include "ftxui/dom/node_pool.hpp"       // for MakeNode
 #include "ftxui/dom/requirement.hpp"     // for Requirement
 #include "ftxui/screen/box.hpp"          // for Box
 
@@ -62,6 +63,9 @@ class Flexbox : public Node {
     if (IsColumnOriented()) {
       std::swap(requirement_.flex_grow_x, requirement_.flex_grow_y);
     }
+
+    requirement_layout_.config = config_normalized_;
+    box_layout_.config = config_;
   }
 
   bool IsColumnOriented() const {
@@ -69,39 +73,55 @@ class Flexbox : public Node {
            config_.direction == FlexboxConfig::Direction::ColumnInversed;
   }
 
+  // Lay out the children into |global|, sized |size_x| x |size_y|. The blocks
+  // of the previous call are kept when none of the inputs changed.
   void Layout(flexbox_helper::Global& global,
+              int size_x,
+              int size_y,
               bool compute_requirement = false) {
-    global.blocks.reserve(children_.size());
-    for (auto& child : children_) {
+    bool changed = global.size_x != size_x || global.size_y != size_y ||
+                   global.blocks.size() != children_.size();
+    global.size_x = size_x;
+    global.size_y = size_y;
+    global.blocks.resize(children_.size());
+    for (size_t i = 0; i < children_.size(); ++i) {
+      const Requirement& requirement = children_[i]->requirement();
       flexbox_helper::Block block;
-      block.min_size_x = child->requirement().min_x;
-      block.min_size_y = child->requirement().min_y;
+      block.min_size_x = requirement.min_x;
+      block.min_size_y = requirement.min_y;
       if (!compute_requirement) {
-        block.flex_grow_x = child->requirement().flex_grow_x;
-        block.flex_grow_y = child->requirement().flex_grow_y;
-        block.flex_shrink_x = child->requirement().flex_shrink_x;
-        block.flex_shrink_y = child->requirement().flex_shrink_y;
+        block.flex_grow_x = requirement.flex_grow_x;
+        block.flex_grow_y = requirement.flex_grow_y;
+        block.flex_shrink_x = requirement.flex_shrink_x;
+        block.flex_shrink_y = requirement.flex_shrink_y;
+      }
+      flexbox_helper::Block& previous = global.blocks[i];
+      if (changed || previous.min_size_x != block.min_size_x ||
+          previous.min_size_y != block.min_size_y ||
+          previous.flex_grow_x != block.flex_grow_x ||
+          previous.flex_grow_y != block.flex_grow_y ||
+          previous.flex_shrink_x != block.flex_shrink_x ||
+          previous.flex_shrink_y != block.flex_shrink_y) {
+        changed = true;
+        previous = block;
       }
-      global.blocks.push_back(block);
     }
 
-    flexbox_helper::Compute(global);
+    if (changed) {
+      flexbox_helper::Compute(global);
+    }
   }
 
   void ComputeRequirement() override {
     for (auto& child : children_) {
-      child->ComputeRequirement();
+      ComputeChildRequirement(child.get());
     }
-    flexbox_helper::Global global;
-    global.config = config_normalized_;
+    flexbox_helper::Global& global = requirement_layout_;
     if (IsColumnOriented()) {
-      global.size_x = 100000;  // NOLINT
-      global.size_y = asked_;
+      Layout(global, 100000, asked_, true);  // NOLINT
     } else {
-      global.size_x = asked_;
-      global.size_y = 100000;  // NOLINT
+      Layout(global, asked_, 100000, true);  // NOLINT
     }
-    Layout(global, true);
 
     // Reset:
     requirement_.selection = Requirement::Selection::NORMAL;
@@ -154,11 +174,8 @@ class Flexbox : public Node {
                                                  : box.x_max - box.x_min + 1);
     need_iteration_ = (asked_ != asked_previous);
 
-    flexbox_helper::Global global;
-    global.config = config_;
-    global.size_x = box.x_max - box.x_min + 1;
-    global.size_y = box.y_max - box.y_min + 1;
-    Layout(global);
+    flexbox_helper::Global& global = box_layout_;
+    Layout(global, box.x_max - box.x_min + 1, box.y_max - box.y_min + 1);
 
     for (size_t i = 0; i < children_.size(); ++i) {
       auto& child = children_[i];
@@ -171,7 +188,7 @@ class Flexbox : public Node {
       children_box.y_max = box.y_min + b.y + b.dim_y - 1;
 
       const Box intersection = Box::Intersection(children_box, box);
-      child->SetBox(intersection);
+      SetChildBox(child.get(), intersection);
 
       need_iteration_ |= (intersection != children_box);
     }
@@ -179,7 +196,7 @@ class Flexbox : public Node {
 
   void Check(Status* status) override {
     for (auto& child : children_) {
-      child->Check(status);
+      CheckChild(child.get(), status);
     }
 
     if (status->iteration == 0) {
@@ -194,6 +211,11 @@ class Flexbox : public Node {
   bool need_iteration_ = true;
   const FlexboxConfig config_;
   const FlexboxConfig config_normalized_;
+
+  // The layouts used to compute the requirement and to set the box. Kept
+  // across calls, to reuse their storage and their result.
+  flexbox_helper::Global requirement_layout_;
+  flexbox_helper::Global box_layout_;
 };
 
 }  // namespace
@@ -219,7 +241,7 @@ class Flexbox : public Node {
 //  )
 /// ```
 Element flexbox(Elements children, FlexboxConfig config) {
-  return std::make_shared<Flexbox>(std::move(children), config);
+  return MakeNode<Flexbox>(std::move(children), config);
 }
 
 /// @brief A container displaying elements in rows from left to right. When
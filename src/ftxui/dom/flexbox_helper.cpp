@@ -6,7 +6,7 @@
 #include <algorithm>                     // for max, min
 #include <cstddef>                       // for size_t
 #include <ftxui/dom/flexbox_config.hpp>  // for FlexboxConfig, FlexboxConfig::Direction, FlexboxConfig::AlignContent, FlexboxConfig::JustifyContent, FlexboxConfig::Wrap, FlexboxConfig::Direction::RowInversed, FlexboxConfig::AlignItems, FlexboxConfig::Direction::Row, FlexboxConfig::Direction::Column, FlexboxConfig::Direction::ColumnInversed, FlexboxConfig::Wrap::WrapInversed, FlexboxConfig::AlignContent::Stretch, FlexboxConfig::JustifyContent::Stretch, FlexboxConfig::Wrap::Wrap, FlexboxConfig::AlignContent::Center, FlexboxConfig::AlignContent::FlexEnd, FlexboxConfig::AlignContent::FlexStart, FlexboxConfig::AlignContent::SpaceAround, FlexboxConfig::AlignContent::SpaceBetween, FlexboxConfig::AlignContent::SpaceEvenly, FlexboxConfig::AlignItems::Center, FlexboxConfig::AlignItems::FlexEnd, FlexboxConfig::AlignItems::FlexStart, FlexboxConfig::AlignItems::Stretch, FlexboxConfig::JustifyContent::Center, FlexboxConfig::JustifyContent::FlexEnd, FlexboxConfig::JustifyContent::FlexStart, FlexboxConfig::JustifyContent::SpaceAround, FlexboxConfig::JustifyContent::SpaceBetween, FlexboxConfig::JustifyContent::SpaceEvenly, FlexboxConfig::Wrap::NoWrap
-#include <utility>                       // for swap, move
+#include <utility>                       // for swap
 #include <vector>
 
 #include "ftxui/dom/box_helper.hpp"  // for Element, Compute
@@ -84,52 +84,51 @@ void SymmetryY(Global& g) {
   }
 }
 
-struct Line {
-  std::vector<Block*> blocks;
-};
-
-void SetX(Global& global, std::vector<Line> lines) {
-  for (auto& line : lines) {
-    std::vector<box_helper::Element> elements;
-    elements.reserve(line.blocks.size());
-    for (auto* block : line.blocks) {
+void SetX(Global& global) {
+  std::vector<box_helper::Element>& elements = global.elements;
+  for (const Line& line : global.lines) {
+    elements.clear();
+    for (int i = line.first; i < line.last; ++i) {
+      const Block& block = global.blocks[i];
       box_helper::Element element;
-      element.min_size = block->min_size_x;
+      element.min_size = block.min_size_x;
       element.flex_grow =
-          block->flex_grow_x != 0 || global.config.justify_content ==
-                                         FlexboxConfig::JustifyContent::Stretch
+          block.flex_grow_x != 0 || global.config.justify_content ==
+                                        FlexboxConfig::JustifyContent::Stretch
               ? 1
               : 0;
-      element.flex_shrink = block->flex_shrink_x;
+      element.flex_shrink = block.flex_shrink_x;
       elements.push_back(element);
     }
 
     box_helper::Compute(
         &elements,
-        global.size_x - global.config.gap_x * (int(line.blocks.size()) - 1));
+        global.size_x - global.config.gap_x * (line.last - line.first - 1));
 
     int x = 0;
-    for (size_t i = 0; i < line.blocks.size(); ++i) {
-      line.blocks[i]->dim_x = elements[i].size;
-      line.blocks[i]->x = x;
-      x += elements[i].size;
+    for (int i = line.first; i < line.last; ++i) {
+      Block& block = global.blocks[i];
+      block.dim_x = elements[i - line.first].size;
+      block.x = x;
+      x += block.dim_x;
       x += global.config.gap_x;
     }
   }
 }
 
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
-void SetY(Global& g, std::vector<Line> lines) {
-  std::vector<box_helper::Element> elements;
-  elements.reserve(lines.size());
-  for (auto& line : lines) {
+void SetY(Global& g) {
+  std::vector<box_helper::Element>& elements = g.elements;
+  elements.clear();
+  for (const Line& line : g.lines) {
     box_helper::Element element;
-    element.flex_shrink = line.blocks.front()->flex_shrink_y;
-    element.flex_grow = line.blocks.front()->flex_grow_y;
-    for (auto* block : line.blocks) {
-      element.min_size = std::max(element.min_size, block->min_size_y);
-      element.flex_shrink = std::min(element.flex_shrink, block->flex_shrink_y);
-      element.flex_grow = std::min(element.flex_grow, block->flex_grow_y);
+    element.flex_shrink = g.blocks[line.first].flex_shrink_y;
+    element.flex_grow = g.blocks[line.first].flex_grow_y;
+    for (int i = line.first; i < line.last; ++i) {
+      const Block& block = g.blocks[i];
+      element.min_size = std::max(element.min_size, block.min_size_y);
+      element.flex_shrink = std::min(element.flex_shrink, block.flex_shrink_y);
+      element.flex_grow = std::min(element.flex_grow, block.flex_grow_y);
     }
     elements.push_back(element);
   }
@@ -138,7 +137,8 @@ void SetY(Global& g, std::vector<Line> lines) {
   box_helper::Compute(&elements, 10000);  // NOLINT
 
   // [Align-content]
-  std::vector<int> ys(elements.size());
+  std::vector<int>& ys = g.ys;
+  ys.resize(elements.size());
   int y = 0;
   for (size_t i = 0; i < elements.size(); ++i) {
     ys[i] = y;
@@ -202,36 +202,37 @@ void SetY(Global& g, std::vector<Line> lines) {
   }
 
   // [Align items]
-  for (size_t i = 0; i < lines.size(); ++i) {
+  for (size_t i = 0; i < g.lines.size(); ++i) {
     auto& element = elements[i];
-    for (auto* block : lines[i].blocks) {
+    for (int j = g.lines[i].first; j < g.lines[i].last; ++j) {
+      Block& block = g.blocks[j];
       const bool stretch =
-          block->flex_grow_y != 0 ||
+          block.flex_grow_y != 0 ||
           g.config.align_content == FlexboxConfig::AlignContent::Stretch;
       const int size =
-          stretch ? element.size : std::min(element.size, block->min_size_y);
+          stretch ? element.size : std::min(element.size, block.min_size_y);
       switch (g.config.align_items) {
         case FlexboxConfig::AlignItems::FlexStart: {
-          block->y = ys[i];
-          block->dim_y = size;
+          block.y = ys[i];
+          block.dim_y = size;
           break;
         }
 
         case FlexboxConfig::AlignItems::Center: {
-          block->y = ys[i] + (element.size - size) / 2;
-          block->dim_y = size;
+          block.y = ys[i] + (element.size - size) / 2;
+          block.dim_y = size;
           break;
         }
 
         case FlexboxConfig::AlignItems::FlexEnd: {
-          block->y = ys[i] + element.size - size;
-          block->dim_y = size;
+          block.y = ys[i] + element.size - size;
+          block.dim_y = size;
           break;
         }
 
         case FlexboxConfig::AlignItems::Stretch: {
-          block->y = ys[i];
-          block->dim_y = element.size;
+          block.y = ys[i];
+          block.dim_y = element.size;
           break;
         }
       }
@@ -239,48 +240,50 @@ void SetY(Global& g, std::vector<Line> lines) {
   }
 }
 
-void JustifyContent(Global& g, std::vector<Line> lines) {
-  for (auto& line : lines) {
-    Block* last = line.blocks.back();
-    int remaining_space = g.size_x - last->x - last->dim_x;
+void JustifyContent(Global& g) {
+  for (const Line& line : g.lines) {
+    Block* blocks = g.blocks.data() + line.first;
+    const int count = line.last - line.first;
+    const Block& last = blocks[count - 1];
+    int remaining_space = g.size_x - last.x - last.dim_x;
     switch (g.config.justify_content) {
       case FlexboxConfig::JustifyContent::FlexStart:
       case FlexboxConfig::JustifyContent::Stretch:
         break;
 
       case FlexboxConfig::JustifyContent::FlexEnd: {
-        for (auto* block : line.blocks) {
-          block->x += remaining_space;
+        for (int i = 0; i < count; ++i) {
+          blocks[i].x += remaining_space;
         }
         break;
       }
 
       case FlexboxConfig::JustifyContent::Center: {
-        for (auto* block : line.blocks) {
-          block->x += remaining_space / 2;
+        for (int i = 0; i < count; ++i) {
+          blocks[i].x += remaining_space / 2;
         }
         break;
       }
 
       case FlexboxConfig::JustifyContent::SpaceBetween: {
-        for (int i = (int)line.blocks.size() - 1; i >= 1; --i) {
-          line.blocks[i]->x += remaining_space;
+        for (int i = count - 1; i >= 1; --i) {
+          blocks[i].x += remaining_space;
           remaining_space = remaining_space * (i - 1) / i;
         }
         break;
       }
 
       case FlexboxConfig::JustifyContent::SpaceAround: {
-        for (int i = (int)line.blocks.size() - 1; i >= 0; --i) {
-          line.blocks[i]->x += remaining_space * (2 * i + 1) / (2 * i + 2);
+        for (int i = count - 1; i >= 0; --i) {
+          blocks[i].x += remaining_space * (2 * i + 1) / (2 * i + 2);
           remaining_space = remaining_space * (2 * i) / (2 * i + 2);
         }
         break;
       }
 
       case FlexboxConfig::JustifyContent::SpaceEvenly: {
-        for (int i = (int)line.blocks.size() - 1; i >= 0; --i) {
-          line.blocks[i]->x += remaining_space * (i + 1) / (i + 2);
+        for (int i = count - 1; i >= 0; --i) {
+          blocks[i].x += remaining_space * (i + 1) / (i + 2);
           remaining_space = remaining_space * (i + 1) / (i + 2);
         }
         break;
@@ -315,38 +318,38 @@ void Compute2(Global& global) {
 
 void Compute3(Global& global) {
   // Step 1: Lay out every elements into rows:
-  std::vector<Line> lines;
+  global.lines.clear();
   {
     Line line;
     int x = 0;
-    line.blocks.reserve(global.blocks.size());
-    for (auto& block : global.blocks) {
+    for (int i = 0; i < static_cast<int>(global.blocks.size()); ++i) {
+      Block& block = global.blocks[i];
       // Does it fit the end of the row?
       // No? Then we need to start a new one:
       if (x + block.min_size_x > global.size_x) {
         x = 0;
-        if (!line.blocks.empty()) {
-          lines.push_back(std::move(line));
+        if (line.last != line.first) {
+          global.lines.push_back(line);
         }
-        line = Line();
+        line.first = i;
       }
 
-      block.line = static_cast<int>(lines.size());
-      block.line_position = static_cast<int>(line.blocks.size());
-      line.blocks.push_back(&block);
+      block.line = static_cast<int>(global.lines.size());
+      block.line_position = i - line.first;
+      line.last = i + 1;
       x += block.min_size_x + global.config.gap_x;
     }
-    if (!line.blocks.empty()) {
-      lines.push_back(std::move(line));
+    if (line.last != line.first) {
+      global.lines.push_back(line);
     }
   }
 
   // Step 2: Set positions on the X axis.
-  SetX(global, lines);
-  JustifyContent(global, lines);  // Distribute remaining space.
+  SetX(global);
+  JustifyContent(global);  // Distribute remaining space.
 
   // Step 3: Set positions on the Y axis.
-  SetY(global, lines);
+  SetY(global);
 }
 
 }  // namespace
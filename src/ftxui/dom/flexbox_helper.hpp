@@ -5,6 +5,7 @@
 #define FTXUI_DOM_FLEXBOX_HELPER_HPP
 
 #include <vector>
+#include "ftxui/dom/box_helper.hpp"
 #include "ftxui/dom/flexbox_config.hpp"
 
 namespace ftxui::flexbox_helper {
@@ -28,11 +29,23 @@ struct Block {
   bool overflow = false;
 };
 
+// A line of consecutive blocks: [first, last).
+struct Line {
+  int first = 0;
+  int last = 0;
+};
+
 struct Global {
   std::vector<Block> blocks;
   FlexboxConfig config;
-  int size_x;
-  int size_y;
+  int size_x = 0;
+  int size_y = 0;
+
+  // Scratch storage. Reusing the same Global across calls to Compute avoids
+  // allocating it again.
+  std::vector<Line> lines;
+  std::vector<box_helper::Element> elements;
+  std::vector<int> ys;
 };
 
 void Compute(Global& global);
@@ -229,5 +229,30 @@ TEST(FlexboxHelperTest, BasicColumnInversed) {
   EXPECT_EQ(g.blocks[4].dim_y, 5);
 }
 
+TEST(FlexboxHelperTest, ReuseGlobal) {
+  flexbox_helper::Block block_10_5;
+  block_10_5.min_size_x = 10;
+  block_10_5.min_size_y = 5;
+
+  flexbox_helper::Global g;
+  g.blocks = {
+      block_10_5, block_10_5, block_10_5, block_10_5, block_10_5,
+  };
+  g.size_x = 32;
+  g.size_y = 16;
+  g.config = FlexboxConfig().Set(FlexboxConfig::JustifyContent::Center);
+  flexbox_helper::Compute(g);
+
+  // The scratch storage of the first call doesn't leak into the second one.
+  g.size_x = 55;
+  flexbox_helper::Compute(g);
+
+  EXPECT_EQ(g.lines.size(), 1u);
+  EXPECT_EQ(g.blocks[0].x, 2);
+  EXPECT_EQ(g.blocks[4].x, 42);
+  EXPECT_EQ(g.blocks[4].line, 0);
+  EXPECT_EQ(g.blocks[4].line_position, 4);
+}
+
 }  // namespace ftxui
 // NOLINTEND
@@ -6,6 +6,7 @@
 
 #include "ftxui/dom/elements.hpp"  // for Decorator, Element, focusPosition, focusPositionRelative
 #include "ftxui/dom/node_decorator.hpp"  // for NodeDecorator
+#include "ftxui/dom/node_pool.hpp"       // for MakeNode
 #include "ftxui/dom/requirement.hpp"  // for Requirement, Requirement::NORMAL, Requirement::Selection
 #include "ftxui/screen/box.hpp"  // for Box
 
@@ -51,7 +52,7 @@ Decorator focusPositionRelative(float x, float y) {
   };
 
   return [x, y](Element child) {
-    return std::make_shared<Impl>(std::move(child), x, y);
+    return MakeNode<Impl>(std::move(child), x, y);
   };
 }
 
@@ -90,7 +91,7 @@ Decorator focusPosition(int x, int y) {
   };
 
   return [x, y](Element child) {
-    return std::make_shared<Impl>(std::move(child), x, y);
+    return MakeNode<Impl>(std::move(child), x, y);
   };
 }
 
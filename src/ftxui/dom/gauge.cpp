@@ -7,6 +7,7 @@
 
 #include "ftxui/dom/elements.hpp"  // for Element, gauge, gaugeDirection, gaugeDown, gaugeLeft, gaugeRight, gaugeUp
 #include "ftxui/dom/node.hpp"         // for Node
+#include "ftxui/dom/node_pool.hpp"    // for MakeNode
 #include "ftxui/dom/requirement.hpp"  // for Requirement
 #include "ftxui/screen/box.hpp"       // for Box
 #include "ftxui/screen/screen.hpp"    // for Screen, Pixel
@@ -106,20 +107,17 @@ class Gauge : public Node {
       const auto limit =
           float(box_.x_min) + progress * float(box_.x_max - box_.x_min + 1);
       const int limit_int = static_cast<int>(limit);
-      int x = box_.x_min;
-      while (x < limit_int) {
-        screen.at(x++, y) = charset_horizontal[9];  // NOLINT
-      }
+      screen.FillRow(box_.x_min, limit_int - 1, y,
+                     charset_horizontal[9]);  // NOLINT
       // NOLINTNEXTLINE
-      screen.at(x++, y) = charset_horizontal[int(9 * (limit - limit_int))];
-      while (x <= box_.x_max) {
-        screen.at(x++, y) = charset_horizontal[0];
-      }
+      screen.at(limit_int, y) =
+          charset_horizontal[int(9 * (limit - limit_int))];
+      screen.FillRow(limit_int + 1, box_.x_max, y, charset_horizontal[0]);
     }
 
     if (invert) {
-      for (int x = box_.x_min; x <= box_.x_max; x++) {
-        screen.PixelAt(x, y).inverted ^= true;
+      for (Pixel& pixel : screen.ClippedRow(box_.x_min, box_.x_max, y)) {
+        pixel.inverted ^= true;
       }
     }
   }
@@ -136,15 +134,11 @@ class Gauge : public Node {
       const float limit =
           float(box_.y_min) + progress * float(box_.y_max - box_.y_min + 1);
       const int limit_int = static_cast<int>(limit);
-      int y = box_.y_min;
-      while (y < limit_int) {
-        screen.at(x, y++) = charset_vertical[8];  // NOLINT
-      }
+      screen.FillColumn(x, box_.y_min, limit_int - 1,
+                        charset_vertical[8]);  // NOLINT
       // NOLINTNEXTLINE
-      screen.at(x, y++) = charset_vertical[int(8 * (limit - limit_int))];
-      while (y <= box_.y_max) {
-        screen.at(x, y++) = charset_vertical[0];
-      }
+      screen.at(x, limit_int) = charset_vertical[int(8 * (limit - limit_int))];
+      screen.FillColumn(x, limit_int + 1, box_.y_max, charset_vertical[0]);
     }
 
     if (invert) {
@@ -167,7 +161,7 @@ class Gauge : public Node {
 //  @param direction Direction of progress bars progression.
 /// @ingroup dom
 Element gaugeDirection(float progress, Direction direction) {
-  return std::make_shared<Gauge>(progress, direction);
+  return MakeNode<Gauge>(progress, direction);
 }
 
 /// @brief Draw a high definition progress bar progressing from left to right.
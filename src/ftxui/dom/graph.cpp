@@ -9,6 +9,7 @@
 
 #include "ftxui/dom/elements.hpp"     // for GraphFunction, Element, graph
 #include "ftxui/dom/node.hpp"         // for Node
+#include "ftxui/dom/node_pool.hpp"    // for MakeNode
 #include "ftxui/dom/requirement.hpp"  // for Requirement
 #include "ftxui/screen/box.hpp"       // for Box
 #include "ftxui/screen/screen.hpp"    // for Screen
@@ -40,13 +41,31 @@ class Graph : public Node {
     requirement_.min_y = 3;
   }
 
-  void Render(Screen& screen) override {
+  void Check(Status* status) override {
+    Node::Check(status);
+    // A new layout discards the data computed for the previous one.
+    prepared_ = false;
+  }
+
+  void Prepare() override {
     const int width = (box_.x_max - box_.x_min + 1) * 2;
     const int height = (box_.y_max - box_.y_min + 1) * 2;
-    if (width <= 0 || height <= 0) {
+    data_.clear();
+    if (width > 0 && height > 0) {
+      data_ = graph_function_(width, height);
+    }
+    prepared_ = true;
+  }
+
+  void Render(Screen& screen) override {
+    if (!prepared_) {
+      Prepare();
+    }
+    prepared_ = false;
+    if (data_.empty()) {
       return;
     }
-    auto data = graph_function_(width, height);
+    const std::vector<int>& data = data_;
     int i = 0;
     for (int x = box_.x_min; x <= box_.x_max; ++x) {
       const int height_1 = 2 * box_.y_max - data[i++];
@@ -62,6 +81,8 @@ class Graph : public Node {
 
  private:
   GraphFunction graph_function_;
+  std::vector<int> data_;
+  bool prepared_ = false;
 };
 
 }  // namespace
@@ -69,7 +90,7 @@ class Graph : public Node {
 /// @brief Draw a graph using a GraphFunction.
 /// @param graph_function the function to be called to get the data.
 Element graph(GraphFunction graph_function) {
-  return std::make_shared<Graph>(std::move(graph_function));
+  return MakeNode<Graph>(std::move(graph_function));
 }
 
 }  // namespace ftxui
@@ -0,0 +1,276 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/dom/graph_series.hpp"
+
+#include <algorithm>  // for max, min, fill
+#include <cmath>      // for lround
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint8_t, int64_t
+#include <limits>     // for numeric_limits
+#include <utility>    // for move
+#include <vector>     // for vector
+
+#include "ftxui/dom/elements.hpp"     // for Element, graph
+#include "ftxui/dom/node.hpp"         // for Node
+#include "ftxui/dom/node_pool.hpp"    // for MakeNode
+#include "ftxui/dom/requirement.hpp"  // for Requirement
+#include "ftxui/screen/box.hpp"       // for Box
+#include "ftxui/screen/screen.hpp"    // for Screen
+#include "ftxui/util/ref.hpp"         // for ConstRef
+
+namespace ftxui {
+
+namespace {
+
+using Extent = GraphSeries::Extent;
+
+void Merge(Extent& extent, const Extent& other) {
+  extent.min = std::min(extent.min, other.min);
+  extent.max = std::max(extent.max, other.max);
+}
+
+// The bit of the braille dot (x, y) of a cell, in U+2800..U+28FF.
+constexpr uint8_t kBrailleDots[2][4] = {
+    {0x01, 0x02, 0x04, 0x40},
+    {0x08, 0x10, 0x20, 0x80},
+};
+
+class SeriesGraph : public Node {
+ public:
+  SeriesGraph(std::vector<ConstRef<GraphSeries>> series, GraphOption option)
+      : series_(std::move(series)), option_(std::move(option)) {}
+
+  void ComputeRequirement() override {
+    requirement_.flex_grow_x = 1;
+    requirement_.flex_grow_y = 1;
+    requirement_.flex_shrink_x = 1;
+    requirement_.flex_shrink_y = 1;
+    requirement_.min_x = 3;
+    requirement_.min_y = 3;
+  }
+
+  void Render(Screen& screen) override {
+    const Box visible = Box::Intersection(box_, screen.stencil);
+    if (visible.IsEmpty() || !ComputeWindow() || !ComputeRange()) {
+      return;
+    }
+
+    // Each cell is made of 2x4 braille dots. Each column of dots displays the
+    // extent of the samples it covers.
+    const int height = box_.y_max - box_.y_min + 1;
+    const size_t columns = 2 * size_t(box_.x_max - box_.x_min + 1);
+    std::vector<uint8_t> dots(static_cast<size_t>(height));
+    std::vector<size_t> owner(static_cast<size_t>(height));
+
+    for (int x = visible.x_min; x <= visible.x_max; ++x) {
+      std::fill(dots.begin(), dots.end(), 0);
+      for (size_t s = 0; s < series_.size(); ++s) {
+        for (int dx = 0; dx < 2; ++dx) {
+          const size_t column = 2 * size_t(x - box_.x_min) + size_t(dx);
+          Extent extent;
+          if (!series_[s]->ColumnExtent(column, columns, window_, &extent)) {
+            continue;
+          }
+          const int top = Row(extent.max, height);
+          const int bottom = Row(extent.min, height);
+          for (int row = top; row <= bottom; ++row) {
+            dots[size_t(row / 4)] |= kBrailleDots[dx][row % 4];  // NOLINT
+            owner[size_t(row / 4)] = s;
+          }
+        }
+      }
+
+      // Only the cells with a dot are drawn.
+      for (int y = visible.y_min; y <= visible.y_max; ++y) {
+        const size_t cell = size_t(y - box_.y_min);
+        if (dots[cell] == 0) {
+          continue;
+        }
+        Pixel& pixel = screen.PixelAt(x, y);
+        const char braille[3] = {
+            char(0xE2),
+            char(0xA0 | (dots[cell] >> 6)),
+            char(0x80 | (dots[cell] & 0x3F)),
+        };
+        pixel.character.assign(braille, 3);
+        if (owner[cell] < option_.colors.size()) {
+          pixel.foreground_color = option_.colors[owner[cell]];
+        }
+      }
+    }
+  }
+
+ private:
+  // The number of samples displayed. Return false when there are none.
+  bool ComputeWindow() {
+    window_ = option_.window;
+    if (window_ == 0) {
+      for (const auto& series : series_) {
+        window_ = std::max(window_, series->size());
+      }
+    }
+    return window_ != 0;
+  }
+
+  // The range of the values displayed. Return false when there are none.
+  bool ComputeRange() {
+    min_ = option_.min;
+    max_ = option_.max;
+    if (min_ < max_) {
+      return true;
+    }
+
+    Extent extent = {
+        std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::lowest(),
+    };
+    for (const auto& series : series_) {
+      const size_t size = series->size();
+      if (size != 0) {
+        Merge(extent, series->ExtentOf(size - std::min(size, window_), size));
+      }
+    }
+    if (extent.max < extent.min) {
+      return false;
+    }
+    min_ = extent.min;
+    max_ = extent.max;
+    // A constant series is drawn in the middle.
+    if (min_ >= max_) {
+      min_ -= 1.F;
+      max_ += 1.F;
+    }
+    return true;
+  }
+
+  // The row of dots of |value|, from the top.
+  int Row(float value, int height) const {
+    const int rows = 4 * height;
+    const float ratio = (max_ - value) / (max_ - min_);
+    const auto row = int(std::lround(ratio * float(rows - 1)));
+    return std::min(rows - 1, std::max(0, row));
+  }
+
+  std::vector<ConstRef<GraphSeries>> series_;
+  GraphOption option_;
+  size_t window_ = 0;
+  float min_ = 0.F;
+  float max_ = 0.F;
+};
+
+}  // namespace
+
+GraphSeries::GraphSeries(size_t capacity)
+    : samples_(std::max<size_t>(1, capacity)) {
+  for (size_t k = 1; (size_t(1) << k) <= samples_.size(); ++k) {
+    // A block is overwritten only once all of its samples are dropped.
+    levels_.emplace_back((samples_.size() >> k) + 2);
+  }
+}
+
+void GraphSeries::Push(float value) {
+  const size_t index = pushed_++;
+  samples_[index % samples_.size()] = value;
+  for (size_t k = 1; k <= levels_.size(); ++k) {
+    std::vector<Extent>& level = levels_[k - 1];
+    Extent& extent = level[(index >> k) % level.size()];
+    if ((index & ((size_t(1) << k) - 1)) == 0) {
+      extent = {value, value};
+    } else {
+      Merge(extent, {value, value});
+    }
+  }
+  size_ = std::min(size_ + 1, samples_.size());
+}
+
+void GraphSeries::Clear() {
+  pushed_ = 0;
+  size_ = 0;
+}
+
+float GraphSeries::At(size_t index) const {
+  return samples_[(pushed_ - size_ + index) % samples_.size()];
+}
+
+GraphSeries::Extent GraphSeries::ExtentOf(size_t begin, size_t end) const {
+  auto block = [&](size_t k, size_t index) -> Extent {
+    if (k == 0) {
+      const float value = samples_[index % samples_.size()];
+      return {value, value};
+    }
+    const std::vector<Extent>& level = levels_[k - 1];
+    return level[index % level.size()];
+  };
+
+  // Like a segment tree: climb the levels from both ends of the range, merging
+  // the blocks sticking out. At most two blocks per level.
+  size_t left = pushed_ - size_ + begin;
+  size_t right = pushed_ - size_ + end;
+  Extent extent = block(0, left);
+  size_t k = 0;
+  for (; k < levels_.size() && left < right; ++k) {
+    if (left & 1) {
+      Merge(extent, block(k, left++));
+    }
+    if (right & 1) {
+      Merge(extent, block(k, --right));
+    }
+    left >>= 1;
+    right >>= 1;
+  }
+  // The blocks of the last level are larger than half of the capacity.
+  for (; left < right; ++left) {
+    Merge(extent, block(k, left));
+  }
+  return extent;
+}
+
+bool GraphSeries::ColumnExtent(size_t column,
+                               size_t columns,
+                               size_t window,
+                               Extent* extent) const {
+  const auto size = int64_t(size_);
+  const size_t spread = std::max(window, columns);
+  const int64_t first = std::max<int64_t>(0, size - int64_t(window));
+  const int64_t shift = size - int64_t(spread);
+  const int64_t begin =
+      std::max(first, shift + int64_t(column * spread / columns) - 1);
+  const int64_t end = shift + int64_t((column + 1) * spread / columns);
+  if (end <= begin) {
+    return false;
+  }
+  *extent = ExtentOf(size_t(begin), size_t(end));
+  return true;
+}
+
+/// @brief Draw the latest samples of a series, as a line. The series is
+/// referenced, not copied. When it has more samples than the graph has columns
+/// of dots, each column displays the extent of the samples it covers.
+/// @param series The samples to display.
+/// @param option The number of samples displayed, their range, and the color.
+/// @ingroup dom
+///
+/// ### Example
+///
+/// ```cpp
+/// GraphSeries latency(100000);
+/// GraphOption option;
+/// option.window = 10000;  // The latest 10000 samples.
+/// Element document = graph(&latency, option) | border;
+/// ```
+Element graph(ConstRef<GraphSeries> series, GraphOption option) {
+  return graph(std::vector<ConstRef<GraphSeries>>{std::move(series)},
+               std::move(option));
+}
+
+/// @brief Draw the latest samples of several series, on the same axes. See
+/// graph(ConstRef<GraphSeries>, GraphOption).
+/// @param series The series to display. The last one is drawn on top.
+/// @param option The number of samples displayed, their range, and the colors.
+/// @ingroup dom
+Element graph(std::vector<ConstRef<GraphSeries>> series, GraphOption option) {
+  return MakeNode<SeriesGraph>(std::move(series), std::move(option));
+}
+
+}  // namespace ftxui
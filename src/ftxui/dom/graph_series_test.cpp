@@ -0,0 +1,117 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <algorithm>  // for max, min
+#include <cstddef>    // for size_t
+
+#include "ftxui/dom/elements.hpp"      // for graph
+#include "ftxui/dom/graph_series.hpp"  // for GraphSeries, GraphOption
+#include "ftxui/dom/node.hpp"          // for Render
+#include "ftxui/screen/color.hpp"      // for Color
+#include "ftxui/screen/screen.hpp"     // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+TEST(GraphSeriesTest, Extent) {
+  GraphSeries series(100);
+  unsigned int seed = 42;
+  for (int i = 0; i < 1037; ++i) {
+    seed = seed * 1103515245 + 12345;
+    series.Push(float(seed % 1000));
+  }
+  ASSERT_EQ(series.size(), 100u);
+
+  // Compare to the samples, for every range.
+  for (size_t begin = 0; begin < series.size(); ++begin) {
+    float min = series.At(begin);
+    float max = series.At(begin);
+    for (size_t end = begin + 1; end <= series.size(); ++end) {
+      min = std::min(min, series.At(end - 1));
+      max = std::max(max, series.At(end - 1));
+      const GraphSeries::Extent extent = series.ExtentOf(begin, end);
+      ASSERT_EQ(extent.min, min) << begin << " " << end;
+      ASSERT_EQ(extent.max, max) << begin << " " << end;
+    }
+  }
+}
+
+TEST(GraphSeriesTest, Clear) {
+  GraphSeries series(4);
+  series.Push(1.F);
+  series.Push(2.F);
+  series.Clear();
+  EXPECT_EQ(series.size(), 0u);
+  series.Push(3.F);
+  EXPECT_EQ(series.size(), 1u);
+  EXPECT_EQ(series.At(0), 3.F);
+}
+
+TEST(GraphSeriesTest, Line) {
+  GraphSeries series(4);
+  for (int i = 0; i < 4; ++i) {
+    series.Push(float(i));
+  }
+
+  // Each column of dots displays a sample, joined to the previous one.
+  Screen screen(2, 1);
+  Render(screen, graph(&series));
+  EXPECT_EQ(screen.ToString(), "⣠⠞");
+}
+
+TEST(GraphSeriesTest, Downsampled) {
+  GraphSeries series(1000);
+  for (int i = 0; i < 1000; ++i) {
+    series.Push(i == 700 ? 1.F : 0.F);
+  }
+
+  // The spike is kept by the column covering it.
+  Screen screen(1, 1);
+  Render(screen, graph(&series));
+  EXPECT_EQ(screen.ToString(), "⣸");
+}
+
+TEST(GraphSeriesTest, Window) {
+  GraphSeries series(1000);
+  for (int i = 0; i < 1000; ++i) {
+    series.Push(i == 700 ? 1.F : 0.F);
+  }
+
+  // The spike is out of the window: only the latest samples are displayed.
+  GraphOption option;
+  option.window = 200;
+  option.min = 0.F;
+  option.max = 1.F;
+  Screen screen(1, 1);
+  Render(screen, graph(&series, option));
+  EXPECT_EQ(screen.ToString(), "⣀");
+}
+
+TEST(GraphSeriesTest, Colors) {
+  GraphSeries low(2);
+  GraphSeries high(2);
+  for (int i = 0; i < 2; ++i) {
+    low.Push(0.F);
+    high.Push(1.F);
+  }
+
+  GraphOption option;
+  option.colors = {Color::Blue, Color::Red};
+  Screen screen(1, 2);
+  Render(screen, graph({&low, &high}, option));
+  EXPECT_EQ(screen.PixelAt(0, 0).character, "⠉");
+  EXPECT_EQ(screen.PixelAt(0, 0).foreground_color, Color::Red);
+  EXPECT_EQ(screen.PixelAt(0, 1).character, "⣀");
+  EXPECT_EQ(screen.PixelAt(0, 1).foreground_color, Color::Blue);
+}
+
+TEST(GraphSeriesTest, Empty) {
+  GraphSeries series;
+  Screen screen(3, 1);
+  Render(screen, graph(&series));
+  EXPECT_EQ(screen.ToString(), "   ");
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -10,6 +10,7 @@
 #include "ftxui/dom/box_helper.hpp"   // for Element, Compute
 #include "ftxui/dom/elements.hpp"     // for Elements, filler, Element, gridbox
 #include "ftxui/dom/node.hpp"         // for Node
+#include "ftxui/dom/node_pool.hpp"    // for MakeNode
 #include "ftxui/dom/requirement.hpp"  // for Requirement
 #include "ftxui/screen/box.hpp"       // for Box
 
@@ -18,20 +19,6 @@ class Screen;
 
 namespace {
 
-// Accumulate the values of a list U[n] into v[n]. So that:
-// V[0] = 0;
-// V[n+1] = v[n] + U[n]
-// return the sum of U[n].
-int Integrate(std::vector<int>& elements) {
-  int accu = 0;
-  for (auto& i : elements) {
-    const int old_accu = accu;
-    accu += i;
-    i = old_accu;
-  }
-  return accu;
-}
-
 class GridBox : public Node {
  public:
   explicit GridBox(std::vector<Elements> lines) : lines_(std::move(lines)) {
@@ -56,94 +43,98 @@ class GridBox : public Node {
     requirement_.flex_shrink_x = 0;
     requirement_.flex_shrink_y = 0;
 
-    for (auto& line : lines_) {
-      for (auto& cell : line) {
-        cell->ComputeRequirement();
+    // Compute the metrics of each columns/row.
+    box_helper::Element init;
+    init.min_size = 0;
+    init.flex_grow = 1024;    // NOLINT
+    init.flex_shrink = 1024;  // NOLINT
+    columns_.assign(x_size, init);
+    rows_.assign(y_size, init);
+    for (int y = 0; y < y_size; ++y) {
+      for (int x = 0; x < x_size; ++x) {
+        Node* cell = lines_[y][x].get();
+        ComputeChildRequirement(cell);
+        const auto& requirement = cell->requirement();
+        auto& e_x = columns_[x];
+        auto& e_y = rows_[y];
+        e_x.min_size = std::max(e_x.min_size, requirement.min_x);
+        e_y.min_size = std::max(e_y.min_size, requirement.min_y);
+        e_x.flex_grow = std::min(e_x.flex_grow, requirement.flex_grow_x);
+        e_y.flex_grow = std::min(e_y.flex_grow, requirement.flex_grow_y);
+        e_x.flex_shrink = std::min(e_x.flex_shrink, requirement.flex_shrink_x);
+        e_y.flex_shrink = std::min(e_y.flex_shrink, requirement.flex_shrink_y);
       }
     }
 
-    // Compute the size of each columns/row.
-    std::vector<int> size_x(x_size, 0);
-    std::vector<int> size_y(y_size, 0);
-    for (int x = 0; x < x_size; ++x) {
-      for (int y = 0; y < y_size; ++y) {
-        size_x[x] = std::max(size_x[x], lines_[y][x]->requirement().min_x);
-        size_y[y] = std::max(size_y[y], lines_[y][x]->requirement().min_y);
-      }
+    for (const auto& column : columns_) {
+      requirement_.min_x += column.min_size;
+    }
+    for (const auto& row : rows_) {
+      requirement_.min_y += row.min_size;
     }
-
-    requirement_.min_x = Integrate(size_x);
-    requirement_.min_y = Integrate(size_y);
 
     // Forward the selected/focused child state:
     requirement_.selection = Requirement::NORMAL;
+    int offset_x = 0;
     for (int x = 0; x < x_size; ++x) {
+      int offset_y = 0;
       for (int y = 0; y < y_size; ++y) {
-        if (requirement_.selection >= lines_[y][x]->requirement().selection) {
-          continue;
+        const auto& requirement = lines_[y][x]->requirement();
+        if (requirement_.selection < requirement.selection) {
+          requirement_.selection = requirement.selection;
+          requirement_.selected_box = requirement.selected_box;
+          requirement_.selected_box.x_min += offset_x;
+          requirement_.selected_box.x_max += offset_x;
+          requirement_.selected_box.y_min += offset_y;
+          requirement_.selected_box.y_max += offset_y;
         }
-        requirement_.selection = lines_[y][x]->requirement().selection;
-        requirement_.selected_box = lines_[y][x]->requirement().selected_box;
-        requirement_.selected_box.x_min += size_x[x];
-        requirement_.selected_box.x_max += size_x[x];
-        requirement_.selected_box.y_min += size_y[y];
-        requirement_.selected_box.y_max += size_y[y];
+        offset_y += rows_[y].min_size;
       }
+      offset_x += columns_[x].min_size;
     }
   }
 
   void SetBox(Box box) override {
     Node::SetBox(box);
 
-    box_helper::Element init;
-    init.min_size = 0;
-    init.flex_grow = 1024;    // NOLINT
-    init.flex_shrink = 1024;  // NOLINT
-    std::vector<box_helper::Element> elements_x(x_size, init);
-    std::vector<box_helper::Element> elements_y(y_size, init);
-
-    for (int y = 0; y < y_size; ++y) {
-      for (int x = 0; x < x_size; ++x) {
-        const auto& cell = lines_[y][x];
-        const auto& requirement = cell->requirement();
-        auto& e_x = elements_x[x];
-        auto& e_y = elements_y[y];
-        e_x.min_size = std::max(e_x.min_size, requirement.min_x);
-        e_y.min_size = std::max(e_y.min_size, requirement.min_y);
-        e_x.flex_grow = std::min(e_x.flex_grow, requirement.flex_grow_x);
-        e_y.flex_grow = std::min(e_y.flex_grow, requirement.flex_grow_y);
-        e_x.flex_shrink = std::min(e_x.flex_shrink, requirement.flex_shrink_x);
-        e_y.flex_shrink = std::min(e_y.flex_shrink, requirement.flex_shrink_y);
-      }
-    }
-
+    // Only the sizes are computed. The metrics are kept from
+    // ComputeRequirement.
     const int target_size_x = box.x_max - box.x_min + 1;
     const int target_size_y = box.y_max - box.y_min + 1;
-    box_helper::Compute(&elements_x, target_size_x);
-    box_helper::Compute(&elements_y, target_size_y);
+    box_helper::Compute(&columns_, target_size_x);
+    box_helper::Compute(&rows_, target_size_y);
 
     Box box_y = box;
     int y = box_y.y_min;
     for (int iy = 0; iy < y_size; ++iy) {
       box_y.y_min = y;
-      y += elements_y[iy].size;
+      y += rows_[iy].size;
       box_y.y_max = y - 1;
 
       Box box_x = box_y;
       int x = box_x.x_min;
       for (int ix = 0; ix < x_size; ++ix) {
         box_x.x_min = x;
-        x += elements_x[ix].size;
+        x += columns_[ix].size;
         box_x.x_max = x - 1;
-        lines_[iy][ix]->SetBox(box_x);
+        SetChildBox(lines_[iy][ix].get(), box_x);
       }
     }
   }
 
+  void Check(Status* status) override {
+    for (auto& line : lines_) {
+      for (auto& cell : line) {
+        CheckChild(cell.get(), status);
+      }
+    }
+    status->need_iteration |= (status->iteration == 0);
+  }
+
   void Render(Screen& screen) override {
     for (auto& line : lines_) {
       for (auto& cell : line) {
-        cell->Render(screen);
+        RenderVisible(screen, cell.get());
       }
     }
   }
@@ -151,6 +142,11 @@ class GridBox : public Node {
   int x_size = 0;
   int y_size = 0;
   std::vector<Elements> lines_;
+
+  // The metrics of the columns and rows, computed with the requirement. Kept
+  // across calls, to reuse their storage.
+  std::vector<box_helper::Element> columns_;
+  std::vector<box_helper::Element> rows_;
 };
 }  // namespace
    //
@@ -181,7 +177,7 @@ class GridBox : public Node {
 /// ╰──────────╯╰──────╯╰──────────╯
 /// ```
 Element gridbox(std::vector<Elements> lines) {
-  return std::make_shared<GridBox>(std::move(lines));
+  return MakeNode<GridBox>(std::move(lines));
 }
 
 }  // namespace ftxui
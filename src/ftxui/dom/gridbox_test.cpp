@@ -617,5 +617,19 @@ TEST(GridboxTest, Focus) {
             "╰──╯");
 }
 
+TEST(GridboxTest, Paragraph) {
+  // The layout iterates until the paragraph knows its width.
+  auto root = gridbox({
+      {text("|"), paragraph("aaa bbb")},
+  });
+
+  Screen screen(5, 3);
+  Render(screen, root);
+  EXPECT_EQ(screen.ToString(),
+            "|aaa \r\n"
+            " bbb \r\n"
+            "     ");
+}
+
 }  // namespace ftxui
 // NOLINTEND
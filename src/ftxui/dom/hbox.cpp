@@ -10,6 +10,7 @@
 #include "ftxui/dom/box_helper.hpp"   // for Element, Compute
 #include "ftxui/dom/elements.hpp"     // for Element, Elements, hbox
 #include "ftxui/dom/node.hpp"         // for Node, Elements
+#include "ftxui/dom/node_pool.hpp"    // for MakeNode
 #include "ftxui/dom/requirement.hpp"  // for Requirement
 #include "ftxui/screen/box.hpp"       // for Box
 
@@ -20,6 +21,8 @@ class HBox : public Node {
  public:
   explicit HBox(Elements children) : Node(std::move(children)) {}
 
+  LayoutKind layout_kind() const override { return LayoutKind::kRow; }
+
   void ComputeRequirement() override {
     requirement_.min_x = 0;
     requirement_.min_y = 0;
@@ -29,7 +32,7 @@ class HBox : public Node {
     requirement_.flex_shrink_y = 0;
     requirement_.selection = Requirement::NORMAL;
     for (auto& child : children_) {
-      child->ComputeRequirement();
+      ComputeChildRequirement(child.get());
       if (requirement_.selection < child->requirement().selection) {
         requirement_.selection = child->requirement().selection;
         requirement_.selected_box = child->requirement().selected_box;
@@ -60,7 +63,7 @@ class HBox : public Node {
     for (size_t i = 0; i < children_.size(); ++i) {
       box.x_min = x;
       box.x_max = x + elements[i].size - 1;
-      children_[i]->SetBox(box);
+      SetChildBox(children_[i].get(), box);
       x = box.x_max + 1;
     }
   }
@@ -81,7 +84,7 @@ class HBox : public Node {
 /// });
 /// ```
 Element hbox(Elements children) {
-  return std::make_shared<HBox>(std::move(children));
+  return MakeNode<HBox>(std::move(children));
 }
 
 }  // namespace ftxui
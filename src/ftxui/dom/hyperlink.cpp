@@ -1,13 +1,14 @@
 // Copyright 2023 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <cstdint>  // for uint8_t
+#include <cstdint>  // for uint16_t
 #include <memory>   // for make_shared
 #include <string>   // for string
 #include <utility>  // for move
 
 #include "ftxui/dom/elements.hpp"        // for Element, Decorator, hyperlink
 #include "ftxui/dom/node_decorator.hpp"  // for NodeDecorator
+#include "ftxui/dom/node_pool.hpp"       // for MakeNode
 #include "ftxui/screen/box.hpp"          // for Box
 #include "ftxui/screen/screen.hpp"       // for Screen, Pixel
 
@@ -19,8 +20,10 @@ class Hyperlink : public NodeDecorator {
   Hyperlink(Element child, std::string link)
       : NodeDecorator(std::move(child)), link_(std::move(link)) {}
 
+  LayoutKind layout_kind() const override { return LayoutKind::kDecorator; }
+
   void Render(Screen& screen) override {
-    const uint8_t hyperlink_id = screen.RegisterHyperlink(link_);
+    const uint16_t hyperlink_id = screen.RegisterHyperlink(link_);
     for (int y = box_.y_min; y <= box_.y_max; ++y) {
       for (int x = box_.x_min; x <= box_.x_max; ++x) {
         screen.PixelAt(x, y).hyperlink = hyperlink_id;
@@ -49,7 +52,7 @@ class Hyperlink : public NodeDecorator {
 ///   hyperlink("https://github.com/ArthurSonzogni/FTXUI", "link");
 /// ```
 Element hyperlink(std::string link, Element child) {
-  return std::make_shared<Hyperlink>(std::move(child), std::move(link));
+  return MakeNode<Hyperlink>(std::move(child), std::move(link));
 }
 
 /// @brief Decorate using an hyperlink.
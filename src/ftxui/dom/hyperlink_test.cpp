@@ -2,7 +2,8 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 #include <gtest/gtest.h>  // for Test, EXPECT_EQ, Message, TestPartResult, TestInfo (ptr only), TEST
-#include <string>  // for allocator, string
+#include <string>  // for allocator, string, to_string
+#include <utility>  // for move
 
 #include "ftxui/dom/elements.hpp"  // for text, hyperlink, operator|, Element, hbox
 #include "ftxui/dom/node.hpp"      // for Render
@@ -39,4 +40,23 @@ TEST(HyperlinkTest, Basic) {
             "\x1B]8;;\x1B\\");
 }
 
+TEST(HyperlinkTest, Many) {
+  Elements lines;
+  for (int i = 0; i < 1000; ++i) {
+    lines.push_back(text("x") | hyperlink("https://" + std::to_string(i)));
+  }
+  Screen screen(1, 1000);
+  Render(screen, vbox(std::move(lines)));
+
+  // Each link keeps its own id.
+  EXPECT_EQ(screen.PixelAt(0, 999).hyperlink, 1000u);
+  EXPECT_EQ(screen.Hyperlink(screen.PixelAt(0, 999).hyperlink),
+            "https://999");
+  EXPECT_EQ(screen.RegisterHyperlink("https://500"), 501u);
+  EXPECT_EQ(screen.RegisterHyperlink(""), 0u);
+
+  screen.Clear();
+  EXPECT_EQ(screen.RegisterHyperlink("https://999"), 1u);
+}
+
 }  // namespace ftxui
@@ -0,0 +1,220 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <algorithm>  // for max, min
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint8_t, uint32_t
+#include <memory>     // for shared_ptr
+#include <utility>    // for move
+
+#include "ftxui/dom/elements.hpp"   // for Element, image, imageRGB
+#include "ftxui/dom/node.hpp"       // for Node
+#include "ftxui/dom/node_pool.hpp"  // for MakeNode
+#include "ftxui/screen/bitmap.hpp"  // for Bitmap
+#include "ftxui/screen/box.hpp"     // for Box
+#include "ftxui/screen/color.hpp"   // for Color
+#include "ftxui/screen/image.hpp"   // for Image
+#include "ftxui/screen/pixel.hpp"   // for Pixel
+#include "ftxui/screen/screen.hpp"  // for Screen
+#include "ftxui/screen/terminal.hpp"  // for GraphicsSupport, Graphics
+
+namespace ftxui {
+
+namespace {
+
+class ImageNode : public Node {
+ public:
+  explicit ImageNode(const Image* image) : image_(image) {}
+
+  void ComputeRequirement() override {
+    requirement_.min_x = image_->dimx();
+    requirement_.min_y = image_->dimy();
+  }
+
+  void Render(Screen& screen) override {
+    // The image is clipped by the box it was given.
+    const Box stencil = screen.stencil;
+    screen.stencil = Box::Intersection(stencil, box_);
+    screen.DrawImage(box_.x_min, box_.y_min, *image_);
+    screen.stencil = stencil;
+  }
+
+ private:
+  const Image* image_;
+};
+
+class ImageRGBNode : public Node {
+ public:
+  ImageRGBNode(const uint8_t* rgb, int width, int height)
+      : rgb_(rgb), width_(std::max(0, width)), height_(std::max(0, height)) {}
+
+  void ComputeRequirement() override {
+    requirement_.min_x = width_;
+    requirement_.min_y = (height_ + 1) / 2;
+  }
+
+  void Render(Screen& screen) override {
+    const int box_width = box_.x_max - box_.x_min + 1;
+    const int box_height = (box_.y_max - box_.y_min + 1) * 2;
+    if (box_width <= 0 || box_height <= 0 || width_ == 0 || height_ == 0) {
+      return;
+    }
+
+    // The image is shrunk by the smallest integer factor fitting it in the box,
+    // keeping its aspect ratio. Each dot is the average of factor x factor
+    // pixels.
+    const int factor =
+        std::max({1, (width_ + box_width - 1) / box_width,
+                  (height_ + box_height - 1) / box_height});
+    const int dots_x = (width_ + factor - 1) / factor;
+    const int dots_y = (height_ + factor - 1) / factor;
+
+    // Two dots per cell: the upper half block is drawn with the color of the
+    // top one, over the color of the bottom one. The colors are downgraded
+    // when encoding the screen, for terminals without true colors.
+    for (int y = 0; y < (dots_y + 1) / 2; ++y) {
+      for (int x = 0; x < dots_x; ++x) {
+        Pixel& pixel = screen.PixelAt(box_.x_min + x, box_.y_min + y);
+        pixel.character = "▀";
+        pixel.foreground_color = Dot(x, 2 * y, factor);
+        pixel.background_color =
+            2 * y + 1 < dots_y ? Dot(x, 2 * y + 1, factor) : Color();
+      }
+    }
+  }
+
+ private:
+  // The color of the dot (x, y) of the image shrunk by |factor|.
+  Color Dot(int x, int y, int factor) const {
+    if (factor == 1) {
+      const uint8_t* p = rgb_ + (size_t(y) * size_t(width_) + size_t(x)) * 3;
+      return Color::RGB(p[0], p[1], p[2]);
+    }
+    const int x_end = std::min(width_, (x + 1) * factor);
+    const int y_end = std::min(height_, (y + 1) * factor);
+    uint32_t sum[3] = {0, 0, 0};
+    for (int py = y * factor; py < y_end; ++py) {
+      const uint8_t* p = rgb_ + (size_t(py) * size_t(width_) +
+                                 size_t(x) * size_t(factor)) *
+                                    3;
+      const uint8_t* end = rgb_ + (size_t(py) * size_t(width_) + x_end) * 3;
+      for (; p != end; p += 3) {
+        sum[0] += p[0];
+        sum[1] += p[1];
+        sum[2] += p[2];
+      }
+    }
+    const auto count = uint32_t((x_end - x * factor) * (y_end - y * factor));
+    return Color::RGB(uint8_t(sum[0] / count), uint8_t(sum[1] / count),
+                      uint8_t(sum[2] / count));
+  }
+
+  const uint8_t* rgb_;
+  int width_;
+  int height_;
+};
+
+// Sent to the terminal when it supports graphics, and fully visible. Drawn
+// with half blocks otherwise.
+class BitmapNode : public ImageRGBNode {
+ public:
+  explicit BitmapNode(std::shared_ptr<const Bitmap> bitmap)
+      : ImageRGBNode(bitmap->rgb().data(), bitmap->width(), bitmap->height()),
+        bitmap_(std::move(bitmap)) {}
+
+  void Render(Screen& screen) override {
+    // The bitmap covers its cells, from the top left of the box.
+    Box box = box_;
+    box.x_max = std::min(box.x_max, box.x_min + requirement_.min_x - 1);
+    box.y_max = std::min(box.y_max, box.y_min + requirement_.min_y - 1);
+
+    // Shrunk or clipped, it is drawn with half blocks.
+    if (Terminal::GraphicsSupport() == Terminal::Graphics::None ||
+        box.IsEmpty() || box.x_max - box.x_min + 1 < requirement_.min_x ||
+        box.y_max - box.y_min + 1 < requirement_.min_y ||
+        !(Box::Intersection(box, screen.stencil) == box)) {
+      ImageRGBNode::Render(screen);
+      return;
+    }
+    // The cells below the bitmap are blank.
+    for (int y = box.y_min; y <= box.y_max; ++y) {
+      for (int x = box.x_min; x <= box.x_max; ++x) {
+        screen.PixelAt(x, y) = Pixel();
+      }
+    }
+    screen.PlaceBitmap(bitmap_, box);
+  }
+
+ private:
+  std::shared_ptr<const Bitmap> bitmap_;
+};
+
+}  // namespace
+
+/// @brief Draw the pixels of an |image|, copied a row at a time.
+/// @param image The image. It is referenced, not copied: it must outlive the
+/// rendering of the element.
+/// @ingroup dom
+/// @see Render(Image&, const Element&)
+///
+/// ### Example
+///
+/// ```cpp
+/// // Once:
+/// Image help(100, 40);
+/// Render(help, HelpPage());
+///
+/// // On every frame:
+/// auto document = hbox({
+///   content,
+///   image(help),
+/// });
+/// ```
+Element image(const Image& image) {
+  return MakeNode<ImageNode>(&image);
+}
+
+/// @brief Draw an RGB bitmap, like a thumbnail or a heatmap. Each cell displays
+/// two vertical pixels, using the upper half block "▀". The bitmap is shrunk
+/// when the element is smaller.
+/// @param rgb The pixels, row after row. Each one is 3 bytes: red, green and
+/// blue. It is referenced, not copied: it must outlive the rendering of the
+/// element.
+/// @param width The number of pixels of a row.
+/// @param height The number of rows. The element is (height + 1) / 2 cells
+/// high.
+/// @ingroup dom
+///
+/// ### Example
+///
+/// ```cpp
+/// std::vector<uint8_t> heatmap(200 * 100 * 3);
+/// auto document = imageRGB(heatmap.data(), 200, 100);
+/// ```
+Element imageRGB(const uint8_t* rgb, int width, int height) {
+  return MakeNode<ImageRGBNode>(rgb, width, height);
+}
+
+/// @brief Draw a bitmap with the graphics protocol of the terminal, see
+/// Terminal::GraphicsSupport(). With the kitty protocol, the pixels are sent
+/// once, and scaled to the box of the element. The Sixel pixels are drawn
+/// unscaled. Without graphics support, or when the element is clipped, the
+/// bitmap is drawn like imageRGB().
+///
+/// The terminal forgets the bitmap once it is destroyed: keep it for as long
+/// as it is displayed.
+/// @param bitmap The pixels. The element is as large as imageRGB() would be.
+/// @ingroup dom
+///
+/// ### Example
+///
+/// ```cpp
+/// auto photo = std::make_shared<Bitmap>(640, 480, LoadRGB("photo.png"));
+/// auto document = imageBitmap(photo) | size(WIDTH, EQUAL, 40) |
+///                 size(HEIGHT, EQUAL, 15);
+/// ```
+Element imageBitmap(std::shared_ptr<const Bitmap> bitmap) {
+  return MakeNode<BitmapNode>(std::move(bitmap));
+}
+
+}  // namespace ftxui
@@ -0,0 +1,132 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>  // for Test, EXPECT_EQ, TEST
+#include <cstdint>        // for uint8_t
+#include <memory>         // for make_shared
+#include <vector>         // for vector
+
+#include "ftxui/dom/elements.hpp"  // for image, text, border, hbox, vbox, color
+#include "ftxui/dom/node.hpp"       // for Render
+#include "ftxui/screen/bitmap.hpp"  // for Bitmap
+#include "ftxui/screen/color.hpp"   // for Color
+#include "ftxui/screen/image.hpp"   // for Image
+#include "ftxui/screen/screen.hpp"  // for Screen
+#include "ftxui/screen/terminal.hpp"  // for SetGraphicsSupport, Graphics
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+Element Panel() {
+  return vbox({
+             text("Help") | bold,
+             text("q: quit") | color(Color::Red),
+         }) |
+         border;
+}
+}  // namespace
+
+TEST(ImageTest, SameAsElement) {
+  Image panel(9, 4);
+  Render(panel, Panel());
+
+  Screen expected(20, 4);
+  Render(expected, hbox({text("left"), Panel()}));
+  Screen screen(20, 4);
+  Render(screen, hbox({text("left"), image(panel)}));
+  EXPECT_EQ(screen.ToString(), expected.ToString());
+}
+
+TEST(ImageTest, Clipped) {
+  Image panel(9, 4);
+  Render(panel, Panel());
+
+  // By the box of the element.
+  Screen screen(9, 4);
+  Render(screen, hbox({image(panel) | size(WIDTH, EQUAL, 4)}));
+  EXPECT_EQ(screen.ToString(),
+            "╭───     \r\n"
+            "│\x1B[1mHel\x1B[22m     \r\n"
+            "│\x1B[31mq: \x1B[39m     \r\n"
+            "╰───     ");
+
+  // By the screen.
+  Screen small(6, 2);
+  Render(small, hbox({text("ab"), image(panel)}));
+  EXPECT_EQ(small.ToString(),
+            "ab╭───\r\n"
+            "  │\x1B[1mHel\x1B[22m");
+}
+
+TEST(ImageTest, RGB) {
+  // 2x3 pixels: red, green / blue, white / black, red.
+  const std::vector<uint8_t> rgb = {
+      255, 0, 0,   0,   255, 0,    //
+      0,   0, 255, 255, 255, 255,  //
+      0,   0, 0,   255, 0,   0,    //
+  };
+  Screen screen(3, 3);
+  Render(screen, imageRGB(rgb.data(), 2, 3));
+
+  EXPECT_EQ(screen.PixelAt(0, 0).character, "▀");
+  EXPECT_EQ(screen.PixelAt(0, 0).foreground_color, Color::RGB(255, 0, 0));
+  EXPECT_EQ(screen.PixelAt(0, 0).background_color, Color::RGB(0, 0, 255));
+  EXPECT_EQ(screen.PixelAt(1, 0).foreground_color, Color::RGB(0, 255, 0));
+  EXPECT_EQ(screen.PixelAt(1, 0).background_color, Color::RGB(255, 255, 255));
+
+  // The last row has no pixel below.
+  EXPECT_EQ(screen.PixelAt(1, 1).foreground_color, Color::RGB(255, 0, 0));
+  EXPECT_EQ(screen.PixelAt(1, 1).background_color, Color());
+
+  // The requirement covers the pixels only.
+  EXPECT_EQ(screen.PixelAt(2, 0).character, "");
+  EXPECT_EQ(screen.PixelAt(0, 2).character, "");
+}
+
+TEST(ImageTest, RGBShrunk) {
+  // 4x4 pixels in a 2x1 box: each dot averages 2x2 pixels.
+  std::vector<uint8_t> rgb(4 * 4 * 3, 0);
+  for (int y = 0; y < 2; ++y) {
+    for (int x = 0; x < 2; ++x) {
+      rgb[(y * 4 + x) * 3] = x == 0 ? 200 : 100;
+    }
+  }
+  Screen screen(2, 1);
+  Render(screen, imageRGB(rgb.data(), 4, 4));
+
+  EXPECT_EQ(screen.PixelAt(0, 0).foreground_color, Color::RGB(150, 0, 0));
+  EXPECT_EQ(screen.PixelAt(0, 0).background_color, Color::RGB(0, 0, 0));
+  EXPECT_EQ(screen.PixelAt(1, 0).foreground_color, Color::RGB(0, 0, 0));
+}
+
+TEST(ImageTest, Bitmap) {
+  auto bitmap = std::make_shared<Bitmap>(
+      2, 3, std::vector<uint8_t>(2 * 3 * 3, 255));
+
+  // Without graphics, like imageRGB().
+  Terminal::SetGraphicsSupport(Terminal::Graphics::None);
+  Screen screen(3, 3);
+  Render(screen, imageBitmap(bitmap));
+  EXPECT_EQ(screen.PixelAt(1, 1).character, "▀");
+  EXPECT_TRUE(screen.Bitmaps().empty());
+
+  // Placed over blank cells.
+  Terminal::SetGraphicsSupport(Terminal::Graphics::Kitty);
+  screen.Clear();
+  Render(screen, hbox({text("a"), imageBitmap(bitmap)}));
+  EXPECT_EQ(screen.PixelAt(1, 1).character, "");
+  ASSERT_EQ(screen.Bitmaps().size(), 1u);
+  EXPECT_EQ(screen.Bitmaps()[0].box, (Box{1, 2, 0, 1}));
+
+  // Clipped, drawn with half blocks.
+  Screen small(2, 2);
+  Render(small, hbox({text("a"), imageBitmap(bitmap)}));
+  EXPECT_TRUE(small.Bitmaps().empty());
+  EXPECT_EQ(small.PixelAt(1, 0).character, "▀");
+
+  Terminal::SetGraphicsSupport(Terminal::Graphics::None);
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -2,7 +2,7 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 #include <algorithm>                      // for max, min, sort, copy
-#include <cmath>                          // for fmod, cos, sin
+#include <cmath>                          // for fmod, cos, sin, round, ceil
 #include <cstddef>                        // for size_t
 #include <ftxui/dom/linear_gradient.hpp>  // for LinearGradient::Stop, LinearGradient
 #include <memory>    // for allocator_traits<>::value_type, make_shared
@@ -12,6 +12,7 @@
 
 #include "ftxui/dom/elements.hpp"  // for Element, Decorator, bgcolor, color
 #include "ftxui/dom/node_decorator.hpp"  // for NodeDecorator
+#include "ftxui/dom/node_pool.hpp"       // for MakeNode
 #include "ftxui/screen/box.hpp"          // for Box
 #include "ftxui/screen/color.hpp"   // for Color, Color::Default, Color::Blue
 #include "ftxui/screen/screen.hpp"  // for Pixel, Screen
@@ -128,11 +129,30 @@ class LinearGradientColor : public NodeDecorator {
         gradient_(Normalize(gradient)),
         background_color_{background_color} {}
 
+  LayoutKind layout_kind() const override { return LayoutKind::kDecorator; }
+
  private:
   void Render(Screen& screen) override {
+    const Box box = Box::Intersection(box_, screen.stencil);
+    if (!box.IsEmpty()) {
+      Paint(screen, box);
+    }
+    NodeDecorator::Render(screen);
+  }
+
+  // Paint the gradient over the visible part |box| of the element. The
+  // colors are interpolated once per column, once per row, or once per step
+  // of a lookup table along the gradient axis, instead of once per cell.
+  void Paint(Screen& screen, const Box& box) {
     const float degtorad = 0.01745329251F;
-    const float dx = std::cos(gradient_.angle * degtorad);
-    const float dy = std::sin(gradient_.angle * degtorad);
+    float dx = std::cos(gradient_.angle * degtorad);
+    float dy = std::sin(gradient_.angle * degtorad);
+
+    // Axis aligned gradients depend on a single coordinate.
+    if (std::fmod(gradient_.angle, 90.F) == 0.F) {
+      dx = std::round(dx);
+      dy = std::round(dy);
+    }
 
     // Project every corner to get the extent of the gradient.
     const float p1 = float(box_.x_min) * dx + float(box_.y_min) * dy;
@@ -148,28 +168,57 @@ class LinearGradientColor : public NodeDecorator {
     const float dY = dy / (max - min);
     const float dZ = -min / (max - min);
 
-    // Project every pixel to get the color.
-    if (background_color_) {
-      for (int y = box_.y_min; y <= box_.y_max; ++y) {
-        for (int x = box_.x_min; x <= box_.x_max; ++x) {
-          const float t = float(x) * dX + float(y) * dY + dZ;
-          screen.PixelAt(x, y).background_color = Interpolate(gradient_, t);
+    Color Pixel::*const channel = background_color_ ? &Pixel::background_color
+                                                    : &Pixel::foreground_color;
+
+    // Horizontal gradient: one color per column, repeated on every row.
+    if (dy == 0.F) {
+      lut_.resize(box.x_max - box.x_min + 1);
+      for (int x = box.x_min; x <= box.x_max; ++x) {
+        lut_[x - box.x_min] = Interpolate(gradient_, float(x) * dX + dZ);
+      }
+      for (int y = box.y_min; y <= box.y_max; ++y) {
+        const Image::PixelRow row = screen.ClippedRow(box.x_min, box.x_max, y);
+        for (int x = row.x_min; x <= row.x_max; ++x) {
+          row[x].*channel = lut_[x - box.x_min];
         }
       }
-    } else {
-      for (int y = box_.y_min; y <= box_.y_max; ++y) {
-        for (int x = box_.x_min; x <= box_.x_max; ++x) {
-          const float t = float(x) * dX + float(y) * dY + dZ;
-          screen.PixelAt(x, y).foreground_color = Interpolate(gradient_, t);
+      return;
+    }
+
+    // Vertical gradient: one color per row.
+    if (dx == 0.F) {
+      for (int y = box.y_min; y <= box.y_max; ++y) {
+        const Color color = Interpolate(gradient_, float(y) * dY + dZ);
+        for (Pixel& pixel : screen.ClippedRow(box.x_min, box.x_max, y)) {
+          pixel.*channel = color;
         }
       }
+      return;
     }
 
-    NodeDecorator::Render(screen);
+    // Otherwise, sample the gradient along its axis, four times per cell of
+    // extent, and look the cells up in the table.
+    const int last = 4 * int(std::ceil(max - min));
+    lut_.resize(last + 1);
+    for (int i = 0; i <= last; ++i) {
+      lut_[i] = Interpolate(gradient_, float(i) / float(std::max(last, 1)));
+    }
+    const float scale = float(last);
+    for (int y = box.y_min; y <= box.y_max; ++y) {
+      const float t_row = float(y) * dY + dZ;
+      const Image::PixelRow row = screen.ClippedRow(box.x_min, box.x_max, y);
+      for (int x = row.x_min; x <= row.x_max; ++x) {
+        const float t = t_row + float(x) * dX;
+        const int index = t >= 0.F ? std::min(int(t * scale + 0.5F), last) : 0;
+        row[x].*channel = lut_[index];
+      }
+    }
   }
 
   LinearGradientNormalized gradient_;
   bool background_color_;
+  std::vector<Color> lut_;
 };
 
 }  // namespace
@@ -245,7 +294,7 @@ LinearGradient& LinearGradient::Stop(Color c) {
 /// color(LinearGradient{0, {Color::Red, Color::Blue}}, text("Hello"))
 /// ```
 Element color(const LinearGradient& gradient, Element child) {
-  return std::make_shared<LinearGradientColor>(std::move(child), gradient,
+  return MakeNode<LinearGradientColor>(std::move(child), gradient,
                                                /*background_color*/ false);
 }
 
@@ -261,7 +310,7 @@ Element color(const LinearGradient& gradient, Element child) {
 /// bgcolor(LinearGradient{0, {Color::Red, Color::Blue}}, text("Hello"))
 /// ```
 Element bgcolor(const LinearGradient& gradient, Element child) {
-  return std::make_shared<LinearGradientColor>(std::move(child), gradient,
+  return MakeNode<LinearGradientColor>(std::move(child), gradient,
                                                /*background_color*/ true);
 }
 
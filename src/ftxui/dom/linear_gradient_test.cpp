@@ -86,5 +86,41 @@ TEST(ColorTest, GradientBackground) {
   EXPECT_EQ(screen.PixelAt(4, 0).background_color, gradient_end);
 }
 
+TEST(ColorTest, GradientVertical) {
+  auto element = text("text") |
+                 bgcolor(LinearGradient(90, Color::RedLight, Color::Red));
+  Screen screen(5, 3);
+  Render(screen, element | size(HEIGHT, EQUAL, 3));
+
+  Color gradient_begin = Color::Interpolate(0, Color::RedLight, Color::Red);
+  Color gradient_middle = Color::Interpolate(0.5, Color::RedLight, Color::Red);
+  Color gradient_end = Color::Interpolate(1, Color::RedLight, Color::Red);
+
+  for (int x = 0; x < 4; ++x) {
+    EXPECT_EQ(screen.PixelAt(x, 0).background_color, gradient_begin);
+    EXPECT_EQ(screen.PixelAt(x, 1).background_color, gradient_middle);
+    EXPECT_EQ(screen.PixelAt(x, 2).background_color, gradient_end);
+  }
+}
+
+TEST(ColorTest, GradientDiagonal) {
+  auto element = text("text") |
+                 color(LinearGradient(45, Color::RedLight, Color::Red));
+  Screen screen(4, 4);
+  Render(screen, element | size(HEIGHT, EQUAL, 4));
+
+  Color gradient_begin = Color::Interpolate(0, Color::RedLight, Color::Red);
+  Color gradient_middle = Color::Interpolate(0.5, Color::RedLight, Color::Red);
+  Color gradient_end = Color::Interpolate(1, Color::RedLight, Color::Red);
+
+  EXPECT_EQ(screen.PixelAt(0, 0).foreground_color, gradient_begin);
+  EXPECT_EQ(screen.PixelAt(3, 3).foreground_color, gradient_end);
+
+  // The cells along the other diagonal project on the middle of the gradient.
+  EXPECT_EQ(screen.PixelAt(3, 0).foreground_color, gradient_middle);
+  EXPECT_EQ(screen.PixelAt(0, 3).foreground_color, gradient_middle);
+  EXPECT_EQ(screen.PixelAt(1, 2).foreground_color, gradient_middle);
+}
+
 }  // namespace ftxui
 // NOLINTEND
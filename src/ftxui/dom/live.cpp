@@ -0,0 +1,72 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <algorithm>  // for min
+#include <memory>     // for shared_ptr
+#include <utility>    // for move
+
+#include "ftxui/dom/elements.hpp"      // for Element, live
+#include "ftxui/dom/node.hpp"          // for Node
+#include "ftxui/dom/node_pool.hpp"     // for MakeNode
+#include "ftxui/dom/requirement.hpp"   // for Requirement
+#include "ftxui/screen/box.hpp"        // for Box
+#include "ftxui/screen/live_cell.hpp"  // for LiveCell
+#include "ftxui/screen/screen.hpp"     // for Screen
+
+namespace ftxui {
+
+namespace {
+
+class Live : public Node {
+ public:
+  explicit Live(std::shared_ptr<LiveCell> cell) : cell_(std::move(cell)) {}
+
+  void ComputeRequirement() override {
+    requirement_.min_x = cell_->width();
+    requirement_.min_y = 1;
+  }
+
+  // The cells left visible by the frames are the ones updated afterward.
+  void Render(Screen& screen) override {
+    Box box = box_;
+    box.x_max = std::min(box.x_max, box.x_min + cell_->width() - 1);
+    box.y_max = std::min(box.y_max, box.y_min);
+    box = Box::Intersection(box, screen.stencil);
+    if (box.IsEmpty()) {
+      return;
+    }
+    cell_->Draw(screen, box_.x_min, box_.y_min, box);
+    screen.PlaceLiveCell(cell_, box_.x_min, box_.y_min, box);
+  }
+
+ private:
+  std::shared_ptr<LiveCell> cell_;
+};
+
+}  // namespace
+
+/// @brief Reserve the cells of a LiveCell, updated at a high frequency without
+/// rendering the component tree again.
+/// @param cell The cells. Its content is set with LiveCell::Set(), from any
+/// thread.
+/// @ingroup dom
+///
+/// ScreenInteractive writes every update to the terminal as a patch of these
+/// cells only. The frames drawn meanwhile display the last content.
+///
+/// ### Example
+///
+/// ```cpp
+/// auto rate = std::make_shared<LiveCell>(10);
+/// auto component = Renderer([&] {
+///   return hbox({text("Packets/s: "), live(rate)}) | border;
+/// });
+///
+/// // From a worker thread, hundreds of times a second:
+/// rate->Set(std::to_string(packets_per_second));
+/// ```
+Element live(std::shared_ptr<LiveCell> cell) {
+  return MakeNode<Live>(std::move(cell));
+}
+
+}  // namespace ftxui
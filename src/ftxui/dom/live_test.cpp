@@ -0,0 +1,86 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <memory>  // for make_shared
+
+#include "ftxui/dom/elements.hpp"      // for live, text, hbox, xframe, size
+#include "ftxui/dom/node.hpp"          // for Render
+#include "ftxui/screen/color.hpp"      // for Color
+#include "ftxui/screen/live_cell.hpp"  // for LiveCell
+#include "ftxui/screen/screen.hpp"     // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+TEST(LiveTest, Render) {
+  auto cell = std::make_shared<LiveCell>(5);
+  Pixel style;
+  style.foreground_color = Color::Red;
+  cell->Set("12", style);
+  EXPECT_TRUE(cell->Pending());
+
+  Screen screen(8, 1);
+  Render(screen, hbox({text(">"), live(cell), text("<")}));
+  EXPECT_EQ(screen.PixelAt(1, 0).character, "1");
+  EXPECT_EQ(screen.PixelAt(2, 0).character, "2");
+  EXPECT_EQ(screen.PixelAt(3, 0).character, " ");
+  EXPECT_EQ(screen.PixelAt(3, 0).foreground_color, Color::Red);
+  EXPECT_EQ(screen.PixelAt(6, 0).character, "<");
+  EXPECT_FALSE(cell->Pending());
+
+  ASSERT_EQ(screen.LiveCells().size(), 1u);
+  EXPECT_EQ(screen.LiveCells()[0].box, (Box{1, 5, 0, 0}));
+}
+
+TEST(LiveTest, Fullwidth) {
+  auto cell = std::make_shared<LiveCell>(3);
+  cell->Set("测试");
+  Screen screen(3, 1);
+  Render(screen, live(cell));
+  EXPECT_EQ(screen.PixelAt(0, 0).character, "测");
+  EXPECT_EQ(screen.PixelAt(1, 0).character, "");
+  // The second glyph doesn't fit.
+  EXPECT_EQ(screen.PixelAt(2, 0).character, " ");
+}
+
+TEST(LiveTest, Clipped) {
+  auto cell = std::make_shared<LiveCell>(6);
+  cell->Set("abcdef");
+  Screen screen(4, 1);
+  Render(screen, hbox({text("xy"), live(cell)}) | xframe);
+  ASSERT_EQ(screen.LiveCells().size(), 1u);
+  const Screen::LiveCellPlacement& placement = screen.LiveCells()[0];
+  EXPECT_EQ(placement.box, (Box{2, 3, 0, 0}));
+
+  // The patches only cover the visible cells.
+  cell->Set("ghijkl");
+  EXPECT_TRUE(cell->Pending());
+  cell->Draw(screen, placement.x, placement.y, placement.box);
+  EXPECT_EQ(screen.PixelAt(1, 0).character, "y");
+  EXPECT_EQ(screen.PixelAt(2, 0).character, "g");
+  EXPECT_EQ(screen.PixelAt(3, 0).character, "h");
+}
+
+TEST(LiveTest, Watch) {
+  auto cell = std::make_shared<LiveCell>(2);
+  int changes = 0;
+  cell->Watch(&changes, [&] { changes++; });
+  cell->Set("a");
+  cell->Set("b");
+  // Only the first update since the last draw is notified.
+  EXPECT_EQ(changes, 1);
+
+  Screen screen(2, 1);
+  cell->Draw(screen, 0, 0, Box{0, 1, 0, 0});
+  cell->Set("c");
+  EXPECT_EQ(changes, 2);
+
+  cell->Unwatch(&changes);
+  cell->Draw(screen, 0, 0, Box{0, 1, 0, 0});
+  cell->Set("d");
+  EXPECT_EQ(changes, 2);
+}
+
+}  // namespace ftxui
+// NOLINTEND
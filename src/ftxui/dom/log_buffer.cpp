@@ -0,0 +1,494 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/dom/log_buffer.hpp"
+
+#include <algorithm>    // for max, min, min_element, upper_bound
+#include <array>        // for array
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint8_t, uint32_t
+#include <cstring>      // for memcpy
+#include <limits>       // for numeric_limits
+#include <memory>       // for make_shared
+#include <string>       // for string
+#include <string_view>  // for string_view
+#include <utility>      // for move
+
+#include "ftxui/dom/elements.hpp"     // for Element, logview
+#include "ftxui/dom/node.hpp"         // for Node, Node::Status
+#include "ftxui/dom/node_pool.hpp"    // for MakeNode
+#include "ftxui/dom/requirement.hpp"  // for Requirement, Requirement::SELECTED
+#include "ftxui/screen/box.hpp"       // for Box
+#include "ftxui/screen/screen.hpp"    // for Screen
+#include "ftxui/screen/string.hpp"    // for Glyph, GlyphRange
+#include "ftxui/util/ref.hpp"         // for ConstRef
+
+namespace ftxui {
+
+namespace {
+
+// The lines are stored into chunks of this size, unless they are longer.
+constexpr size_t kChunkSize = 1 << 16;  // NOLINT
+
+// The number of rows |line| takes, once wrapped at |width|.
+size_t WrapRows(std::string_view line, int width) {
+  size_t rows = 1;
+  int x = 0;
+  for (const Glyph& glyph : GlyphRange(line)) {
+    if (x > 0 && x + glyph.width > width) {
+      rows++;
+      x = 0;
+    }
+    x += glyph.width;
+  }
+  return rows;
+}
+
+int ClampToInt(size_t value) {
+  return int(std::min<size_t>(value, std::numeric_limits<int>::max() / 2));
+}
+
+// The chunks are compressed by LZ77, into the LZ4 block format: a sequence of
+// literals, each followed by a match copying up to 64KiB back. It favors the
+// speed over the ratio, the lines of logs repeating a lot anyway.
+constexpr size_t kMinMatch = 4;
+constexpr size_t kMaxOffset = 0xFFFF;
+constexpr int kHashBits = 12;
+
+uint32_t Read32(const char* data) {
+  uint32_t value = 0;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+uint32_t Hash(uint32_t value) {
+  return (value * 2654435761U) >> (32 - kHashBits);  // NOLINT
+}
+
+// The lengths longer than their 4 bits of the token continue by bytes, until
+// one is below 255.
+void AppendLength(std::string* out, size_t length) {
+  for (; length >= 255; length -= 255) {  // NOLINT
+    out->push_back(char(255));            // NOLINT
+  }
+  out->push_back(char(length));
+}
+
+size_t ReadLength(std::string_view in, size_t* i) {
+  size_t length = 0;
+  uint8_t byte = 255;  // NOLINT
+  while (byte == 255 && *i < in.size()) {
+    byte = uint8_t(in[(*i)++]);
+    length += byte;
+  }
+  return length;
+}
+
+// Append the |literals|, then a match of |length| bytes from |offset| back.
+// The last sequence has no match: |length| is 0.
+void AppendSequence(std::string* out,
+                    std::string_view literals,
+                    size_t offset,
+                    size_t length) {
+  const size_t match = length == 0 ? 0 : length - kMinMatch;
+  out->push_back(char(std::min<size_t>(literals.size(), 15) << 4 |  // NOLINT
+                      std::min<size_t>(match, 15)));                // NOLINT
+  if (literals.size() >= 15) {                                      // NOLINT
+    AppendLength(out, literals.size() - 15);                        // NOLINT
+  }
+  out->append(literals);
+  if (length == 0) {
+    return;
+  }
+  out->push_back(char(offset & 0xFF));  // NOLINT
+  out->push_back(char(offset >> 8));    // NOLINT
+  if (match >= 15) {                    // NOLINT
+    AppendLength(out, match - 15);      // NOLINT
+  }
+}
+
+std::string Compress(std::string_view in) {
+  std::string out;
+  out.reserve(in.size() / 2);
+  // The last position of every hash of 4 bytes.
+  std::array<uint32_t, 1 << kHashBits> table{};
+  const char* data = in.data();
+  size_t anchor = 0;
+  size_t position = 0;
+  while (position + kMinMatch <= in.size()) {
+    const uint32_t value = Read32(data + position);
+    uint32_t& entry = table[Hash(value)];
+    const size_t candidate = entry;
+    entry = uint32_t(position);
+    if (candidate >= position || position - candidate > kMaxOffset ||
+        Read32(data + candidate) != value) {
+      position++;
+      continue;
+    }
+    size_t length = kMinMatch;
+    while (position + length < in.size() &&
+           data[candidate + length] == data[position + length]) {
+      length++;
+    }
+    AppendSequence(&out, in.substr(anchor, position - anchor),
+                   position - candidate, length);
+    position += length;
+    anchor = position;
+  }
+  AppendSequence(&out, in.substr(anchor), 0, 0);
+  return out;
+}
+
+// Decompress |in| into |out|, |size| bytes long. Its buffer is reused.
+void Decompress(std::string_view in, size_t size, std::string* out) {
+  out->resize(size);
+  char* data = out->data();
+  size_t i = 0;
+  size_t o = 0;
+  while (i < in.size()) {
+    const auto token = uint8_t(in[i++]);
+    size_t literals = token >> 4;  // NOLINT
+    if (literals == 15) {          // NOLINT
+      literals += ReadLength(in, &i);
+    }
+    std::memcpy(data + o, in.data() + i, literals);
+    i += literals;
+    o += literals;
+    if (i >= in.size()) {
+      break;
+    }
+    const size_t offset = size_t(uint8_t(in[i])) |
+                          size_t(uint8_t(in[i + 1])) << 8;  // NOLINT
+    i += 2;
+    size_t length = token & 15;  // NOLINT
+    if (length == 15) {          // NOLINT
+      length += ReadLength(in, &i);
+    }
+    length += kMinMatch;
+    // Byte by byte: the match overlaps the bytes it writes when it repeats
+    // them.
+    for (size_t k = 0; k < length; ++k, ++o) {
+      data[o] = data[o - offset];
+    }
+  }
+}
+
+}  // namespace
+
+LogBuffer::LogBuffer(LogBufferOption option) : option_(option) {}
+
+/// @brief Append |text| to the log. It is split into lines at every '\n'.
+/// The last line stays open, and is continued by the next call, until a '\n'
+/// ends it.
+void LogBuffer::Append(std::string_view text) {
+  size_t start = 0;
+  while (true) {
+    const size_t end = text.find('\n', start);
+    if (end == std::string_view::npos) {
+      if (start < text.size()) {
+        AddPiece(text.substr(start));
+        open_ = true;
+      }
+      return;
+    }
+    AddPiece(text.substr(start, end - start));
+    open_ = false;
+    start = end + 1;
+  }
+}
+
+/// @brief Append |line| to the log, as a whole line.
+void LogBuffer::AppendLine(std::string_view line) {
+  Append(line);
+  Append("\n");
+}
+
+/// @brief Remove every line.
+void LogBuffer::Clear() {
+  chunks_.clear();
+  lines_.clear();
+  cache_.clear();
+  open_ = false;
+  wrap_width_ = 0;
+  wrap_rows_.clear();
+}
+
+/// @brief The line at |index|, without its '\n'. With compression, the view is
+/// only valid until the next call: its chunk can be evicted from the cache.
+/// The cache isn't guarded: the reads mustn't be concurrent.
+std::string_view LogBuffer::LineAt(size_t index) const {
+  const Line& line = lines_[index];
+  return std::string_view(ChunkText(line.chunk)).substr(line.offset, line.size);
+}
+
+/// @brief The bytes used to store the text, compressed or not, the chunks
+/// cached decompressed included.
+size_t LogBuffer::StorageSize() const {
+  size_t size = 0;
+  for (const Chunk& chunk : chunks_) {
+    size += chunk.text.capacity() + chunk.compressed.capacity();
+  }
+  for (const CachedChunk& cached : cache_) {
+    size += cached.text.capacity();
+  }
+  return size;
+}
+
+/// @brief The number of rows taken by the lines before |line|, once wrapped
+/// at |width|. The result is cached, and updated incrementally when lines are
+/// appended.
+size_t LogBuffer::WrappedRowsBefore(size_t line, int width) const {
+  UpdateWrapCache(width);
+  if (line < wrap_rows_.size()) {
+    return wrap_rows_[line];
+  }
+  // The last line is still open, it isn't cached.
+  return wrap_rows_.back() + WrapRows(LineAt(lines_.size() - 1), wrap_width_);
+}
+
+/// @brief The line displayed at the wrapped row |row|.
+size_t LogBuffer::LineAtWrappedRow(size_t row, int width) const {
+  UpdateWrapCache(width);
+  const auto it = std::upper_bound(wrap_rows_.begin(), wrap_rows_.end(), row);
+  const size_t line = size_t(it - wrap_rows_.begin()) - 1;
+  return std::min(line, std::max<size_t>(lines_.size(), 1) - 1);
+}
+
+// Add |piece| to the open line, or as a new line.
+void LogBuffer::AddPiece(std::string_view piece) {
+  if (open_) {
+    Line& line = lines_.back();
+    const std::string& chunk = chunks_[line.chunk].text;
+    // The open line is the last one of its chunk. Move it to a new chunk if
+    // it doesn't fit anymore, unless it is alone.
+    if (line.offset != 0 && chunk.size() + piece.size() > kChunkSize) {
+      const std::string moved = chunk.substr(line.offset, line.size);
+      chunks_.back().text.resize(line.offset);
+      AddChunk(line.size + piece.size());
+      chunks_.back().text = moved;
+      line.chunk = uint32_t(chunks_.size() - 1);
+      line.offset = 0;
+    }
+    chunks_[line.chunk].text.append(piece);
+    line.size += uint32_t(piece.size());
+    return;
+  }
+
+  if (chunks_.empty() ||
+      chunks_.back().text.size() + piece.size() > kChunkSize) {
+    AddChunk(piece.size());
+  }
+  std::string& chunk = chunks_.back().text;
+  Line line;
+  line.chunk = uint32_t(chunks_.size() - 1);
+  line.offset = uint32_t(chunk.size());
+  line.size = uint32_t(piece.size());
+  chunk.append(piece);
+  lines_.push_back(line);
+}
+
+// Start a new chunk, for at least |reserve| bytes. The previous one is full:
+// it is sealed.
+void LogBuffer::AddChunk(size_t reserve) {
+  if (!chunks_.empty()) {
+    Seal(&chunks_.back());
+  }
+  chunks_.emplace_back();
+  chunks_.back().text.reserve(std::max(kChunkSize, reserve));
+}
+
+// |chunk| won't be appended to anymore. Compress it, unless it doesn't make
+// it smaller. Otherwise, only release its unused capacity.
+void LogBuffer::Seal(Chunk* chunk) {
+  if (option_.compress) {
+    std::string compressed = Compress(chunk->text);
+    if (compressed.size() < chunk->text.size()) {
+      compressed.shrink_to_fit();
+      chunk->compressed = std::move(compressed);
+      chunk->size = chunk->text.size();
+      chunk->is_compressed = true;
+      std::string().swap(chunk->text);
+      return;
+    }
+  }
+  chunk->text.shrink_to_fit();
+}
+
+// The text of the chunk |index|. The compressed ones are decompressed into
+// the cache, evicting the least recently used.
+const std::string& LogBuffer::ChunkText(size_t index) const {
+  const Chunk& chunk = chunks_[index];
+  if (!chunk.is_compressed) {
+    return chunk.text;
+  }
+  use_counter_++;
+  for (CachedChunk& cached : cache_) {
+    if (cached.chunk == index) {
+      cached.last_use = use_counter_;
+      return cached.text;
+    }
+  }
+
+  CachedChunk* cached = nullptr;
+  const size_t capacity = std::max<size_t>(option_.cached_chunks, 1);
+  if (cache_.size() < capacity) {
+    // Reserved at once: filling the cache doesn't move the chunks cached
+    // before.
+    if (cache_.capacity() < capacity) {
+      cache_.reserve(capacity);
+    }
+    cached = &cache_.emplace_back();
+  } else {
+    cached = &*std::min_element(cache_.begin(), cache_.end(),
+                                [](const auto& a, const auto& b) {
+                                  return a.last_use < b.last_use;
+                                });
+  }
+  cached->chunk = index;
+  cached->last_use = use_counter_;
+  Decompress(chunk.compressed, chunk.size, &cached->text);
+  return cached->text;
+}
+
+// Measure the lines appended since the last call. Everything is measured
+// again when |width| changes.
+void LogBuffer::UpdateWrapCache(int width) const {
+  width = std::max(1, width);
+  if (width != wrap_width_ || wrap_rows_.empty()) {
+    wrap_width_ = width;
+    wrap_rows_.assign(1, 0);
+  }
+  const size_t closed = open_ ? lines_.size() - 1 : lines_.size();
+  wrap_rows_.reserve(closed + 1);
+  for (size_t i = wrap_rows_.size() - 1; i < closed; ++i) {
+    wrap_rows_.push_back(wrap_rows_.back() + WrapRows(LineAt(i), width));
+  }
+}
+
+// Draw the rows of a LogBuffer intersecting the screen's stencil. Its
+// requirement covers all of them, so that frame() and the scroll indicators
+// work as usual.
+class LogView : public Node {
+ public:
+  LogView(ConstRef<LogBuffer> log, LogViewOption option)
+      : log_(std::move(log)), option_(option) {
+    requirement_.flex_grow_x = 1;
+    // Assume the width didn't change since the previous frame, to avoid
+    // measuring every line again.
+    if (log_->wrap_width_ != 0) {
+      width_ = log_->wrap_width_;
+    }
+  }
+
+  size_t RowsBefore(size_t line) const {
+    return option_.wrap ? log_->WrappedRowsBefore(line, width_) : line;
+  }
+
+  void ComputeRequirement() override {
+    const size_t lines = log_->LineCount();
+    requirement_.min_x = 0;
+    requirement_.min_y = ClampToInt(RowsBefore(lines));
+    requirement_.selection = Requirement::NORMAL;
+    if (lines == 0) {
+      return;
+    }
+
+    size_t focused = lines - 1;
+    if (option_.focused_line >= 0) {
+      focused = std::min(focused, size_t(option_.focused_line));
+    }
+    requirement_.selection = Requirement::SELECTED;
+    requirement_.selected_box.x_min = 0;
+    requirement_.selected_box.x_max = 0;
+    requirement_.selected_box.y_min = ClampToInt(RowsBefore(focused));
+    requirement_.selected_box.y_max = ClampToInt(RowsBefore(focused + 1)) - 1;
+  }
+
+  void SetBox(Box box) override {
+    Node::SetBox(box);
+    const int width = std::max(1, box.x_max - box.x_min + 1);
+    need_iteration_ = option_.wrap && width != width_;
+    width_ = width;
+  }
+
+  void Check(Status* status) override {
+    status->need_iteration |= need_iteration_ || status->iteration == 0;
+  }
+
+  void Render(Screen& screen) override {
+    const Box visible = Box::Intersection(box_, screen.stencil);
+    const size_t lines = log_->LineCount();
+    if (visible.IsEmpty() || lines == 0) {
+      return;
+    }
+
+    const size_t first_row = size_t(visible.y_min - box_.y_min);
+    size_t line = option_.wrap ? log_->LineAtWrappedRow(first_row, width_)
+                               : first_row;
+    int skipped_rows = int(first_row - RowsBefore(line));
+    int y = visible.y_min;
+    while (y <= visible.y_max && line < lines) {
+      y = DrawLine(screen, log_->LineAt(line), skipped_rows, y, visible.y_max);
+      skipped_rows = 0;
+      line++;
+    }
+  }
+
+ private:
+  // Draw the rows of |line| after the first |skipped_rows|, from |y|. Return
+  // the y coordinate of the next line.
+  int DrawLine(Screen& screen,
+               std::string_view line,
+               int skipped_rows,
+               int y,
+               int y_max) const {
+    int row = 0;
+    int x = 0;
+    for (const Glyph& glyph : GlyphRange(line)) {
+      if (option_.wrap && x > 0 && x + glyph.width > width_) {
+        row++;
+        x = 0;
+      }
+      if (x >= width_) {
+        break;
+      }
+      const int row_y = y + row - skipped_rows;
+      if (row_y > y_max) {
+        return row_y;
+      }
+      if (row >= skipped_rows) {
+        screen.PixelAt(box_.x_min + x, row_y).character = glyph.text;
+        if (glyph.width == 2 && x + 1 < width_) {
+          screen.PixelAt(box_.x_min + x + 1, row_y).character.clear();
+        }
+      }
+      x += glyph.width;
+    }
+    return y + row - skipped_rows + 1;
+  }
+
+  ConstRef<LogBuffer> log_;
+  LogViewOption option_;
+  int width_ = 6000;  // NOLINT
+  bool need_iteration_ = false;
+};
+
+/// @brief Display the lines of a LogBuffer. Only the lines visible are drawn,
+/// so the cost doesn't depend on the size of the log. Use it inside a frame, to
+/// scroll to the focused line.
+/// @param log The lines to display.
+/// @param option Whether to wrap the lines, and the line to scroll to.
+/// @ingroup dom
+///
+/// ### Example
+///
+/// ```cpp
+/// LogBuffer log;
+/// log.Append("line 1\nline 2\n");
+/// Element document = logview(&log) | vscroll_indicator | yframe | flex;
+/// ```
+Element logview(ConstRef<LogBuffer> log, LogViewOption option) {
+  return MakeNode<LogView>(std::move(log), option);
+}
+
+}  // namespace ftxui
@@ -0,0 +1,224 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <string>  // for string, to_string
+
+#include "ftxui/dom/elements.hpp"    // for logview, yframe, vscroll_indicator
+#include "ftxui/dom/log_buffer.hpp"  // for LogBuffer, LogViewOption
+#include "ftxui/dom/node.hpp"        // for Render
+#include "ftxui/screen/screen.hpp"   // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+std::string Draw(Element element, int width, int height) {
+  Screen screen(width, height);
+  Render(screen, element);
+  return screen.ToString();
+}
+}  // namespace
+
+TEST(LogBufferTest, Append) {
+  LogBuffer log;
+  EXPECT_EQ(log.LineCount(), 0u);
+
+  log.Append("a\nb");
+  ASSERT_EQ(log.LineCount(), 2u);
+  EXPECT_EQ(log.LineAt(0), "a");
+  EXPECT_EQ(log.LineAt(1), "b");
+
+  // The last line is continued.
+  log.Append("c\n\nd");
+  ASSERT_EQ(log.LineCount(), 4u);
+  EXPECT_EQ(log.LineAt(1), "bc");
+  EXPECT_EQ(log.LineAt(2), "");
+  EXPECT_EQ(log.LineAt(3), "d");
+
+  log.AppendLine("e");
+  log.AppendLine("f");
+  ASSERT_EQ(log.LineCount(), 5u);
+  EXPECT_EQ(log.LineAt(3), "de");
+  EXPECT_EQ(log.LineAt(4), "f");
+
+  log.Clear();
+  EXPECT_EQ(log.LineCount(), 0u);
+}
+
+TEST(LogBufferTest, ManyChunks) {
+  LogBuffer log;
+  const std::string long_line(100000, 'x');
+  for (int i = 0; i < 10000; ++i) {
+    log.AppendLine(std::to_string(i));
+    if (i % 1000 == 0) {
+      log.Append(long_line);
+      log.Append(std::to_string(i));
+      log.Append("\n");
+    }
+  }
+  ASSERT_EQ(log.LineCount(), 10010u);
+  size_t line = 0;
+  for (int i = 0; i < 10000; ++i) {
+    EXPECT_EQ(log.LineAt(line++), std::to_string(i));
+    if (i % 1000 == 0) {
+      EXPECT_EQ(log.LineAt(line++), long_line + std::to_string(i));
+    }
+  }
+}
+
+TEST(LogBufferTest, Compress) {
+  LogBufferOption option;
+  option.compress = true;
+  option.cached_chunks = 2;
+  LogBuffer log(option);
+  LogBuffer raw;
+  const std::string long_line(100000, 'y');
+  for (int i = 0; i < 100000; ++i) {
+    const std::string line = "[info] request " + std::to_string(i * 7919) +
+                             " served in " + std::to_string(i % 97) + "ms";
+    log.AppendLine(line);
+    raw.AppendLine(line);
+    if (i % 20000 == 0) {
+      // A line continued across a chunk boundary.
+      log.Append(long_line);
+      raw.Append(long_line);
+      log.Append(line);
+      raw.Append(line);
+      log.Append("\n");
+      raw.Append("\n");
+    }
+  }
+  ASSERT_EQ(log.LineCount(), raw.LineCount());
+  EXPECT_LT(log.StorageSize() * 3, raw.StorageSize());
+
+  // In order, then back and forth, through the cache.
+  for (size_t i = 0; i < raw.LineCount(); ++i) {
+    ASSERT_EQ(log.LineAt(i), raw.LineAt(i)) << i;
+  }
+  for (size_t i = 0; i < raw.LineCount(); i += 7919) {
+    ASSERT_EQ(log.LineAt(i), raw.LineAt(i)) << i;
+    const size_t mirror = raw.LineCount() - 1 - i;
+    ASSERT_EQ(log.LineAt(mirror), raw.LineAt(mirror)) << mirror;
+  }
+  EXPECT_EQ(log.WrappedRowsBefore(log.LineCount(), 20),
+            raw.WrappedRowsBefore(raw.LineCount(), 20));
+
+  // Incompressible text is kept as is.
+  LogBuffer noise(option);
+  std::string line;
+  uint32_t seed = 1;
+  for (int i = 0; i < 200000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    line.push_back(char('!' + (seed >> 16) % 90));
+    if (line.size() == 80) {
+      noise.AppendLine(line);
+      line.clear();
+    }
+  }
+  EXPECT_EQ(noise.LineAt(0).size(), 80u);
+  EXPECT_EQ(noise.LineAt(noise.LineCount() - 1).size(), 80u);
+}
+
+TEST(LogBufferTest, Wrap) {
+  LogBuffer log;
+  log.Append("abcdefg\nhi\n测试测\nj");
+  EXPECT_EQ(log.WrappedRowsBefore(0, 3), 0u);
+  EXPECT_EQ(log.WrappedRowsBefore(1, 3), 3u);
+  EXPECT_EQ(log.WrappedRowsBefore(2, 3), 4u);
+  EXPECT_EQ(log.WrappedRowsBefore(3, 3), 7u);
+  EXPECT_EQ(log.WrappedRowsBefore(4, 3), 8u);
+  EXPECT_EQ(log.LineAtWrappedRow(2, 3), 0u);
+  EXPECT_EQ(log.LineAtWrappedRow(3, 3), 1u);
+  EXPECT_EQ(log.LineAtWrappedRow(6, 3), 2u);
+  EXPECT_EQ(log.LineAtWrappedRow(7, 3), 3u);
+
+  // The open line can still grow.
+  log.Append("klm");
+  EXPECT_EQ(log.WrappedRowsBefore(4, 3), 9u);
+  EXPECT_EQ(log.WrappedRowsBefore(4, 10), 4u);
+}
+
+TEST(LogViewTest, FollowEnd) {
+  LogBuffer log;
+  for (int i = 0; i < 1000; ++i) {
+    log.AppendLine("line " + std::to_string(i));
+  }
+  auto document = logview(&log) | yframe;
+  EXPECT_EQ(Draw(document, 8, 3),
+            "line 997\r\n"
+            "line 998\r\n"
+            "line 999");
+}
+
+TEST(LogViewTest, FocusedLine) {
+  LogBuffer log;
+  for (int i = 0; i < 1000; ++i) {
+    log.AppendLine("line " + std::to_string(i));
+  }
+  LogViewOption option;
+  option.focused_line = 0;
+  EXPECT_EQ(Draw(logview(&log, option) | yframe, 6, 2),
+            "line 0\r\n"
+            "line 1");
+
+  option.focused_line = 500;
+  EXPECT_EQ(Draw(logview(&log, option) | vscroll_indicator | yframe, 7, 3),
+            "line 4 \r\n"
+            "line 5┃\r\n"
+            "line 5 ");
+}
+
+TEST(LogViewTest, Compressed) {
+  LogBufferOption log_option;
+  log_option.compress = true;
+  LogBuffer log(log_option);
+  for (int i = 0; i < 100000; ++i) {
+    log.AppendLine("line " + std::to_string(i));
+  }
+  LogViewOption option;
+  option.focused_line = 500;
+  EXPECT_EQ(Draw(logview(&log, option) | yframe, 8, 3),
+            "line 499\r\n"
+            "line 500\r\n"
+            "line 501");
+  option.wrap = true;
+  option.focused_line = 10;
+  EXPECT_EQ(Draw(logview(&log, option) | yframe, 4, 4),
+            " 9  \r\n"
+            "line\r\n"
+            " 10 \r\n"
+            "line");
+}
+
+TEST(LogViewTest, Wrap) {
+  LogBuffer log;
+  log.AppendLine("abcdefg");
+  log.AppendLine("测试测");
+  log.AppendLine("hi");
+
+  LogViewOption option;
+  option.wrap = true;
+  option.focused_line = 0;
+  EXPECT_EQ(Draw(logview(&log, option) | yframe, 3, 4),
+            "abc\r\n"
+            "def\r\n"
+            "g  \r\n"
+            "测 ");
+
+  // Follow the end, the first line partially hidden.
+  option.focused_line = -1;
+  EXPECT_EQ(Draw(logview(&log, option) | yframe, 3, 3),
+            "试 \r\n"
+            "测 \r\n"
+            "hi ");
+
+  // Without wrapping, the lines are clipped, like text().
+  EXPECT_EQ(Draw(logview(&log) | yframe, 3, 3),
+            "abc\r\n"
+            "测试\r\n"
+            "hi ");
+}
+
+}  // namespace ftxui
+// NOLINTEND
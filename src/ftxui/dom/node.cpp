@@ -1,23 +1,54 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
+#include <chrono>                // for steady_clock, duration
+#include <cstddef>               // for size_t
 #include <ftxui/screen/box.hpp>  // for Box
+#include <thread>                // for thread
 #include <utility>               // for move
+#include <vector>                // for vector
 
 #include "ftxui/dom/node.hpp"
+#include "ftxui/dom/worker_pool.hpp"  // for WorkerPool
 #include "ftxui/screen/screen.hpp"  // for Screen
 
 namespace ftxui {
 
+namespace {
+
+// The decorators whose requirement is being computed, see
+// Node::ComputeChildRequirement. Used as a stack, by the nested calls too.
+thread_local std::vector<Node*> g_decorators;  // NOLINT
+
+}  // namespace
+
 Node::Node() = default;
 Node::Node(Elements children) : children_(std::move(children)) {}
-Node::~Node() = default;
+
+// The descendants are released iteratively. Otherwise, every destructor calls
+// the ones of its children, and a deep tree overflows the stack.
+Node::~Node() {
+  if (children_.empty()) {
+    return;
+  }
+  Elements pending = std::move(children_);
+  while (!pending.empty()) {
+    Element node = std::move(pending.back());
+    pending.pop_back();
+    if (node.use_count() == 1) {
+      for (auto& child : node->children_) {
+        pending.push_back(std::move(child));
+      }
+      node->children_.clear();
+    }
+  }
+}
 
 /// @brief Compute how much space an elements needs.
 /// @ingroup dom
 void Node::ComputeRequirement() {
   for (auto& child : children_) {
-    child->ComputeRequirement();
+    ComputeChildRequirement(child.get());
   }
 }
 
@@ -27,30 +58,138 @@ void Node::SetBox(Box box) {
   box_ = box;
 }
 
-/// @brief Display an element on a ftxui::Screen.
+/// @brief Display an element on a ftxui::Screen. The children entirely
+/// outside of the stencil are skipped.
 /// @ingroup dom
 void Node::Render(Screen& screen) {
   for (auto& child : children_) {
-    child->Render(screen);
+    RenderVisible(screen, child.get());
+  }
+}
+
+/// @brief Do the part of the rendering not writing into the Screen. Nothing by
+/// default.
+/// @ingroup dom
+void Node::Prepare() {}
+
+/// @brief The bytes of text owned by the node. None by default.
+/// @ingroup dom
+size_t Node::TextBytes() const {
+  return 0;
+}
+
+/// @brief How FlatLayout lays out the node. By its virtual functions by
+/// default.
+/// @ingroup dom
+Node::LayoutKind Node::layout_kind() const {
+  return LayoutKind::kOpaque;
+}
+
+/// @brief Modify the requirement of the child of a LayoutKind::kAdjust node,
+/// to get its own. Unchanged by default.
+/// @ingroup dom
+void Node::AdjustRequirement(Requirement* /*requirement*/) const {}
+
+void Node::RenderVisible(Screen& screen, Node* node) {
+  if (!Box::Intersection(node->box_, screen.stencil).IsEmpty()) {
+    node->Render(screen);
   }
 }
 
 void Node::Check(Status* status) {
   for (auto& child : children_) {
-    child->Check(status);
+    CheckChild(child.get(), status);
   }
   status->need_iteration |= (status->iteration == 0);
 }
 
+// static
+bool Node::IsDecorator(Node* node) {
+  if (node->layout_kind_ == kUnknownKind) {
+    node->layout_kind_ = node->layout_kind();
+  }
+  return node->layout_kind_ == LayoutKind::kDecorator ||
+         node->layout_kind_ == LayoutKind::kAdjust;
+}
+
+// The chains of decorators, see LayoutKind, are walked by a loop, instead of
+// calling the functions of every decorator. Their Check forwards the one of
+// their child, so they are all as stable as the first node below them.
+void Node::CheckChild(Node* node, Status* status) {
+  Node* const top = node;
+  for (; IsDecorator(node); node = node->children_[0].get()) {
+    node->measured_ = false;
+  }
+  // A child is laid out by its parent, not from a Measure() of its own.
+  node->measured_ = false;
+  const bool need_iteration = status->need_iteration;
+  status->need_iteration = false;
+  node->Check(status);
+  if (node != top) {
+    status->need_iteration |= (status->iteration == 0);
+  }
+  const bool stable = status->iteration != 0 && !status->need_iteration;
+  for (Node* it = top; it != node; it = it->children_[0].get()) {
+    it->layout_stable_ = stable;
+  }
+  node->layout_stable_ = stable;
+  status->need_iteration |= need_iteration;
+}
+
+void Node::ComputeChildRequirement(Node* node) {
+  if (node->layout_stable_) {
+    return;
+  }
+  const size_t base = g_decorators.size();
+  for (; IsDecorator(node); node = node->children_[0].get()) {
+    g_decorators.push_back(node);
+  }
+  node->ComputeRequirement();
+
+  // Back up the chain.
+  Requirement requirement = node->requirement_;
+  while (g_decorators.size() > base) {
+    Node* decorator = g_decorators.back();
+    g_decorators.pop_back();
+    if (decorator->layout_kind_ == LayoutKind::kAdjust) {
+      decorator->AdjustRequirement(&requirement);
+    }
+    decorator->requirement_ = requirement;
+  }
+}
+
+void Node::SetChildBox(Node* node, Box box) {
+  if (node->layout_stable_ && box == node->box_) {
+    return;
+  }
+  for (; IsDecorator(node); node = node->children_[0].get()) {
+    node->box_ = box;
+  }
+  if (!node->layout_stable_ || box != node->box_) {
+    node->SetBox(box);
+  }
+}
+
 /// @brief Display an element on a ftxui::Screen.
 /// @ingroup dom
 void Render(Screen& screen, const Element& element) {
   Render(screen, element.get());
 }
 
-/// @brief Display an element on a ftxui::Screen.
-/// @ingroup dom
-void Render(Screen& screen, Node* node) {
+namespace {
+
+// Return the seconds elapsed since |start|, and move |start| to now.
+double SecondsSince(std::chrono::steady_clock::time_point& start) {
+  const auto now = std::chrono::steady_clock::now();
+  const double seconds = std::chrono::duration<double>(now - start).count();
+  start = now;
+  return seconds;
+}
+
+}  // namespace
+
+// static
+Box Node::LayoutRoot(Screen& screen, Node* node) {
   Box box;
   box.x_min = 0;
   box.y_min = 0;
@@ -58,6 +197,12 @@ void Render(Screen& screen, Node* node) {
   box.y_max = screen.dimy() - 1;
 
   Node::Status status;
+  if (node->measured_) {
+    // The first iteration started with Measure(). Continue it.
+    node->measured_ = false;
+    node->SetBox(box);
+    status.iteration++;
+  }
   node->Check(&status);
   const int max_iterations = 20;
   while (status.need_iteration && status.iteration < max_iterations) {
@@ -72,13 +217,166 @@ void Render(Screen& screen, Node* node) {
     status.iteration++;
     node->Check(&status);
   }
+  return box;
+}
+
+/// @brief Compute the requirement of an element, like the first step of
+/// Render does.
+/// @ingroup dom
+///
+/// This is meant to choose the dimensions of the Screen from the requirement.
+/// The next Render of the element continues its layout from there, instead of
+/// computing the requirement again.
+///
+/// ### Example
+///
+/// ```cpp
+/// const Requirement requirement = Measure(document);
+/// Screen screen(requirement.min_x, requirement.min_y);
+/// Render(screen, document);
+/// ```
+Requirement Measure(Node* node) {
+  Node::Status status;
+  node->Check(&status);
+  node->ComputeRequirement();
+  node->measured_ = true;
+  return node->requirement();
+}
+
+/// @brief Compute the requirement of an element, like the first step of
+/// Render does.
+/// @ingroup dom
+/// @see Measure(Node*)
+Requirement Measure(const Element& element) {
+  return Measure(element.get());
+}
+
+/// @brief Display an element on a ftxui::Screen.
+/// @ingroup dom
+void Render(Screen& screen, Node* node) {
+  Screen::RenderTimings timings;
+  auto start = std::chrono::steady_clock::now();
+  const Box box = Node::LayoutRoot(screen, node);
+  timings.layout = SecondsSince(start);
 
   // Step 3: Draw the element.
   screen.stencil = box;
   node->Render(screen);
+  timings.draw = SecondsSince(start);
+
+  // Step 4: Apply shaders
+  screen.ApplyShader();
+  timings.shader = SecondsSince(start);
+  screen.SetRenderTimings(timings);
+}
+
+/// @brief Display an element on an offscreen ftxui::Image.
+/// @ingroup dom
+///
+/// The image can then be drawn by the `image` element, on every frame, without
+/// building and laying out the element again. This suits the expensive visuals
+/// which rarely change: logos, static charts, help pages. The hyperlinks are
+/// dropped: they belong to a Screen.
+void Render(Image& image, const Element& element) {
+  Screen screen(image.dimx(), image.dimy());
+  Render(screen, element);
+  image = std::move(static_cast<Image&>(screen));
+  image.stencil = Box{0, image.dimx() - 1, 0, image.dimy() - 1};
+  for (int y = 0; y < image.dimy(); ++y) {
+    for (int x = 0; x < image.dimx(); ++x) {
+      image.PixelAt(x, y).hyperlink = 0;
+    }
+  }
+}
+
+/// @brief Display an element on a ftxui::Screen, preparing its nodes on
+/// several threads.
+/// @ingroup dom
+/// @see RenderParallel(Screen&, Node*, int)
+void RenderParallel(Screen& screen, const Element& element, int threads) {
+  RenderParallel(screen, element.get(), threads);
+}
+
+/// @brief Display an element on a ftxui::Screen, preparing its nodes on
+/// several threads.
+/// @param threads The number of threads, including the calling one. Zero uses
+/// one per core.
+/// @ingroup dom
+///
+/// Once the layout is done, the nodes intersecting the screen do the work not
+/// touching the Screen, like running the functions of `canvas` and `graph`,
+/// concurrently. The threads pick the next node from a shared counter, so that
+/// a single heavy pane doesn't hold the others. The pixels are then written by
+/// the calling thread, like Render does, since the nodes share the stencil,
+/// the hyperlinks and the cursor of the Screen.
+///
+/// The functions given to the elements must be safe to call concurrently.
+/// The threads are started and joined by each call. To render many frames,
+/// pass a WorkerPool kept across them instead.
+void RenderParallel(Screen& screen, Node* node, int threads) {
+  if (threads <= 0) {
+    threads = int(std::thread::hardware_concurrency());
+  }
+  WorkerPool pool(threads - 1);
+  RenderParallel(screen, node, pool, threads);
+}
+
+/// @brief Display an element on a ftxui::Screen, preparing its nodes on the
+/// threads of |pool|.
+/// @ingroup dom
+/// @see RenderParallel(Screen&, Node*, WorkerPool&, int)
+void RenderParallel(Screen& screen,
+                    const Element& element,
+                    WorkerPool& pool,
+                    int threads) {
+  RenderParallel(screen, element.get(), pool, threads);
+}
+
+/// @brief Display an element on a ftxui::Screen, preparing its nodes on the
+/// threads of |pool|, like RenderParallel(Screen&, Node*, int) does.
+/// @param threads The number of threads, including the calling one. Zero uses
+/// all the threads of |pool|.
+/// @ingroup dom
+void RenderParallel(Screen& screen,
+                    Node* node,
+                    WorkerPool& pool,
+                    int threads) {
+  Screen::RenderTimings timings;
+  auto start = std::chrono::steady_clock::now();
+  const Box box = Node::LayoutRoot(screen, node);
+  timings.layout = SecondsSince(start);
+
+  if (threads != 1 && pool.size() != 0) {
+    // Collect the nodes intersecting the screen. The children of a node
+    // entirely outside of it are skipped.
+    std::vector<Node*> nodes;
+    std::vector<Node*> stack = {node};
+    while (!stack.empty()) {
+      Node* current = stack.back();
+      stack.pop_back();
+      if (Box::Intersection(current->box_, box).IsEmpty()) {
+        continue;
+      }
+      nodes.push_back(current);
+      for (auto& child : current->children_) {
+        stack.push_back(child.get());
+      }
+    }
+
+    pool.ParallelFor(
+        nodes.size(), [&](size_t i) { nodes[i]->Prepare(); }, threads);
+  }
+
+  // Step 3: Draw the element. The time spent preparing the nodes above counts
+  // as drawing.
+  screen.stencil = box;
+  node->Render(screen);
+  timings.draw = SecondsSince(start);
 
   // Step 4: Apply shaders
   screen.ApplyShader();
+  timings.shader = SecondsSince(start);
+  screen.SetRenderTimings(timings);
 }
 
 }  // namespace ftxui
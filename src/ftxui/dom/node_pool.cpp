@@ -0,0 +1,158 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/dom/node_pool.hpp"
+
+#include <array>    // for array
+#include <cstddef>  // for size_t
+#include <mutex>    // for mutex, lock_guard
+#include <new>      // for operator new, operator delete
+#include <vector>   // for vector
+
+namespace ftxui::node_pool {
+
+namespace {
+
+constexpr size_t kClasses = kMaxSize / kGranularity;
+constexpr size_t kChunkSize = 1 << 16;  // NOLINT
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+// The blocks are carved out of chunks, never freed: a block allocated by a
+// thread can be recycled by another one, even after the first one exited. The
+// chunks are registered globally, so that they stay reachable.
+void RegisterChunk(void* chunk) {
+  static std::mutex mutex;
+  static auto* chunks = new std::vector<void*>();  // NOLINT
+  const std::lock_guard<std::mutex> lock(mutex);
+  chunks->push_back(chunk);
+}
+
+// The free blocks are moved between the threads and a global depot in batches
+// of |kBatch| blocks. A thread freeing more blocks than it allocates, like the
+// UI thread adopting the elements built by a worker thread, hands them over to
+// the threads allocating more than they free. The blocks of a thread are given
+// to the depot when it exits.
+constexpr size_t kBatch = 256;
+
+struct FreeList {
+  FreeBlock* head = nullptr;
+  size_t size = 0;
+};
+
+struct Depot {
+  std::mutex mutex;
+  std::array<std::vector<FreeList>, kClasses> batches;
+};
+
+Depot& GetDepot() {
+  static auto* depot = new Depot();  // NOLINT
+  return *depot;
+}
+
+struct ThreadPool {
+  ThreadPool() = default;
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  ~ThreadPool() {
+    Depot& depot = GetDepot();
+    const std::lock_guard<std::mutex> lock(depot.mutex);
+    for (size_t index = 0; index < kClasses; ++index) {
+      if (free[index].head) {
+        depot.batches[index].push_back(free[index]);
+      }
+    }
+    free = {};
+  }
+
+  std::array<FreeList, kClasses> free = {};
+  char* chunk = nullptr;
+  size_t chunk_left = 0;
+};
+
+thread_local ThreadPool g_pool;  // NOLINT
+
+size_t ClassOf(size_t size) {
+  return (size + kGranularity - 1) / kGranularity - 1;
+}
+
+// Take a batch of free blocks from the depot. Return false if it has none.
+bool Refill(FreeList& list, size_t index) {
+  Depot& depot = GetDepot();
+  const std::lock_guard<std::mutex> lock(depot.mutex);
+  std::vector<FreeList>& batches = depot.batches[index];
+  if (batches.empty()) {
+    return false;
+  }
+  list = batches.back();
+  batches.pop_back();
+  return true;
+}
+
+// Give a batch of |kBatch| free blocks to the depot.
+void Spill(FreeList& list, size_t index) {
+  FreeList batch{list.head, kBatch};
+  FreeBlock* last = list.head;
+  for (size_t i = 1; i < kBatch; ++i) {
+    last = last->next;
+  }
+  list.head = last->next;
+  list.size -= kBatch;
+  last->next = nullptr;
+
+  Depot& depot = GetDepot();
+  const std::lock_guard<std::mutex> lock(depot.mutex);
+  depot.batches[index].push_back(batch);
+}
+
+}  // namespace
+
+void* Allocate(size_t size) {
+#if defined(FTXUI_NODE_POOL_DISABLED)
+  return ::operator new(size);
+#else
+  ThreadPool& pool = g_pool;
+  const size_t index = ClassOf(size);
+  FreeList& list = pool.free[index];
+  if (list.head || Refill(list, index)) {
+    FreeBlock* block = list.head;
+    list.head = block->next;
+    list.size--;
+    return block;
+  }
+
+  // The end of the previous chunk is lost, it is smaller than kMaxSize.
+  const size_t block_size = (index + 1) * kGranularity;
+  if (pool.chunk_left < block_size) {
+    pool.chunk = static_cast<char*>(::operator new(kChunkSize));
+    pool.chunk_left = kChunkSize;
+    RegisterChunk(pool.chunk);
+  }
+  void* out = pool.chunk;
+  pool.chunk += block_size;  // NOLINT
+  pool.chunk_left -= block_size;
+  return out;
+#endif
+}
+
+void Free(void* block, size_t size) {
+#if defined(FTXUI_NODE_POOL_DISABLED)
+  (void)size;
+  ::operator delete(block);
+#else
+  ThreadPool& pool = g_pool;
+  const size_t index = ClassOf(size);
+  FreeList& list = pool.free[index];
+  auto* free_block = static_cast<FreeBlock*>(block);
+  free_block->next = list.head;
+  list.head = free_block;
+  if (++list.size == 2 * kBatch) {
+    Spill(list, index);
+  }
+#endif
+}
+
+}  // namespace ftxui::node_pool
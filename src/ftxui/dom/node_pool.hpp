@@ -0,0 +1,91 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_DOM_NODE_POOL_HPP
+#define FTXUI_DOM_NODE_POOL_HPP
+
+#include <cstddef>  // for size_t
+#include <memory>   // for allocate_shared, shared_ptr
+#include <new>      // for operator new, operator delete
+#include <utility>  // for forward
+
+// The address sanitizer can't detect the use of a recycled block. Use the
+// global allocator instead.
+#if defined(__SANITIZE_ADDRESS__)
+#define FTXUI_NODE_POOL_DISABLED
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define FTXUI_NODE_POOL_DISABLED
+#endif
+#endif
+
+namespace ftxui {
+
+// The elements are built again on every frame. Instead of going through the
+// global allocator for every node, their memory is recycled using per-thread
+// free lists, one per size class. A block can be freed from any thread: the
+// surplus of a thread goes to a global depot, where the other threads take
+// from. The memory is kept for future nodes, never returned to the system.
+namespace node_pool {
+
+constexpr size_t kGranularity = 16;
+constexpr size_t kMaxSize = 512;
+
+void* Allocate(size_t size);
+void Free(void* block, size_t size);
+
+}  // namespace node_pool
+
+template <typename T>
+class NodeAllocator {
+ public:
+  using value_type = T;
+
+  NodeAllocator() = default;
+  template <typename U>
+  NodeAllocator(const NodeAllocator<U>& /*other*/) {}  // NOLINT
+
+  T* allocate(size_t n) {
+    const size_t size = n * sizeof(T);
+    if (!Pooled(size)) {
+      return static_cast<T*>(::operator new(size));
+    }
+    return static_cast<T*>(node_pool::Allocate(size));
+  }
+
+  void deallocate(T* block, size_t n) {
+    const size_t size = n * sizeof(T);
+    if (!Pooled(size)) {
+      ::operator delete(block);
+      return;
+    }
+    node_pool::Free(block, size);
+  }
+
+  template <typename U>
+  bool operator==(const NodeAllocator<U>& /*other*/) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const NodeAllocator<U>& /*other*/) const {
+    return false;
+  }
+
+ private:
+  static constexpr bool Pooled(size_t size) {
+    return size <= node_pool::kMaxSize &&
+           alignof(T) <= node_pool::kGranularity;
+  }
+};
+
+// Same as std::make_shared, using the node pool. The node and its reference
+// count share the same block.
+template <typename T, typename... Args>
+std::shared_ptr<T> MakeNode(Args&&... args) {
+  return std::allocate_shared<T>(NodeAllocator<T>(),
+                                 std::forward<Args>(args)...);
+}
+
+}  // namespace ftxui
+
+#endif  // FTXUI_DOM_NODE_POOL_HPP
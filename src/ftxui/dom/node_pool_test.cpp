@@ -0,0 +1,96 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/dom/node_pool.hpp"
+
+#include <gtest/gtest.h>
+#include <algorithm>  // for find
+#include <memory>  // for shared_ptr
+#include <string>  // for string
+#include <thread>  // for thread
+#include <vector>  // for vector
+
+#include "ftxui/dom/elements.hpp"   // for text, vbox, Elements
+#include "ftxui/dom/node.hpp"       // for Render
+#include "ftxui/screen/screen.hpp"  // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+TEST(NodePoolTest, Reuse) {
+  void* a = node_pool::Allocate(40);
+  void* b = node_pool::Allocate(48);
+  EXPECT_NE(a, b);
+  node_pool::Free(a, 40);
+  // Same size class.
+  void* c = node_pool::Allocate(33);
+#if !defined(FTXUI_NODE_POOL_DISABLED)
+  EXPECT_EQ(a, c);
+#endif
+  node_pool::Free(b, 48);
+  node_pool::Free(c, 33);
+}
+
+TEST(NodePoolTest, LargeObjects) {
+  struct Large {
+    char data[1000];
+  };
+  auto large = MakeNode<Large>();
+  large->data[999] = 'x';
+  EXPECT_EQ(large->data[999], 'x');
+}
+
+TEST(NodePoolTest, FreedByAnotherThread) {
+  std::vector<Element> elements;
+  for (int i = 0; i < 1000; ++i) {
+    elements.push_back(text(std::to_string(i)));
+  }
+  std::thread([&] { elements.clear(); }).join();
+
+  // The blocks recycled by the other thread are still usable.
+  std::thread([] {
+    Elements rows;
+    for (int i = 0; i < 1000; ++i) {
+      rows.push_back(text(std::to_string(i)));
+    }
+    Screen screen(4, 2);
+    Render(screen, vbox(std::move(rows)));
+    EXPECT_EQ(screen.ToString(), "0   \r\n1   ");
+  }).join();
+}
+
+TEST(NodePoolTest, SurplusGivenToOtherThreads) {
+  // A thread building elements, and another one releasing them, like a worker
+  // handing its elements to the UI thread.
+  std::vector<void*> blocks;
+  std::thread([&] {
+    for (int i = 0; i < 4096; ++i) {
+      blocks.push_back(node_pool::Allocate(64));
+    }
+  }).join();
+  for (void* block : blocks) {
+    node_pool::Free(block, 64);
+  }
+
+  // The blocks released are reused by the next thread building elements,
+  // instead of accumulating in the releasing thread.
+  int reused = 0;
+  std::thread([&] {
+    std::vector<void*> rebuilt;
+    for (int i = 0; i < 4096; ++i) {
+      rebuilt.push_back(node_pool::Allocate(64));
+    }
+    for (void* block : rebuilt) {
+      reused += std::find(blocks.begin(), blocks.end(), block) != blocks.end();
+    }
+    for (void* block : rebuilt) {
+      node_pool::Free(block, 64);
+    }
+  }).join();
+#if !defined(FTXUI_NODE_POOL_DISABLED)
+  EXPECT_GE(reused, 3000);
+#endif
+}
+
+}  // namespace ftxui
+// NOLINTEND
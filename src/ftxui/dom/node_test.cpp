@@ -0,0 +1,172 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <atomic>  // for atomic
+#include <memory>  // for make_shared
+#include <vector>  // for vector
+
+#include "ftxui/dom/canvas.hpp"    // for Canvas
+#include "ftxui/dom/elements.hpp"   // for text, vbox, paragraph, Element
+#include "ftxui/dom/node.hpp"       // for Node, Render
+#include "ftxui/screen/box.hpp"     // for Box
+#include "ftxui/screen/screen.hpp"  // for Screen
+#include "gtest/gtest.h"  // for Test, EXPECT_EQ, TEST
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+
+// A leaf counting how many times it is laid out.
+class Counter : public Node {
+ public:
+  void ComputeRequirement() override {
+    requirement_.min_x = 1;
+    requirement_.min_y = 1;
+    compute_requirement++;
+  }
+
+  void SetBox(Box box) override {
+    Node::SetBox(box);
+    set_box++;
+  }
+
+  int compute_requirement = 0;
+  int set_box = 0;
+};
+
+}  // namespace
+
+TEST(NodeTest, StableSubtreeIsLaidOutOnce) {
+  auto counter = std::make_shared<Counter>();
+  auto element = vbox({
+      vbox({counter}),
+      paragraph("A long text wrapped over several lines."),
+  });
+  Screen screen(10, 10);
+  Render(screen, element);
+
+  // The paragraph requests several iterations. The counter doesn't.
+  EXPECT_EQ(counter->compute_requirement, 1);
+  EXPECT_EQ(counter->set_box, 1);
+}
+
+TEST(NodeTest, StableDecoratorChainIsLaidOutOnce) {
+  auto counter = std::make_shared<Counter>();
+  Element chain = counter;
+  for (int i = 0; i < 10; ++i) {
+    chain = (i % 2) ? chain | xflex : chain | bold;
+  }
+  auto element = vbox({
+      chain,
+      paragraph("A long text wrapped over several lines."),
+  });
+  Screen screen(10, 10);
+  Render(screen, element);
+  EXPECT_EQ(counter->compute_requirement, 1);
+  EXPECT_EQ(counter->set_box, 1);
+}
+
+// The decorators are laid out, and released, by loops. A chain deeper than
+// the stack allows to recurse through.
+TEST(NodeTest, DeepDecoratorChain) {
+  auto counter = std::make_shared<Counter>();
+  Element element = counter;
+  for (int i = 0; i < 1000000; ++i) {
+    element = (i % 2) ? element | xflex : element | bold;
+  }
+  const Requirement requirement = Measure(element);
+  EXPECT_EQ(requirement.min_x, 1);
+  EXPECT_EQ(requirement.flex_grow_x, 1);
+  EXPECT_EQ(counter->compute_requirement, 1);
+  element.reset();
+}
+
+TEST(NodeTest, StableSubtreeIsLaidOutAgainOnNewFrame) {
+  auto counter = std::make_shared<Counter>();
+  auto element = vbox({
+      counter,
+      paragraph("A long text wrapped over several lines."),
+  });
+  Screen screen(10, 10);
+  Render(screen, element);
+  Render(screen, element);
+  EXPECT_EQ(counter->compute_requirement, 2);
+  EXPECT_EQ(counter->set_box, 2);
+}
+
+TEST(NodeTest, StableSubtreeIsMovedWithItsBox) {
+  auto counter = std::make_shared<Counter>();
+  // The paragraph width isn't known until the second iteration, so is the
+  // position of the counter after it.
+  auto element = hbox({
+      paragraph("A long text wrapped over several lines."),
+      counter,
+  });
+  Screen screen(10, 10);
+  Render(screen, element);
+  EXPECT_EQ(counter->compute_requirement, 1);
+  EXPECT_EQ(counter->set_box, 2);
+}
+
+TEST(NodeTest, MeasureThenRender) {
+  auto counter = std::make_shared<Counter>();
+  auto element = vbox({counter, text("hello")});
+  const Requirement requirement = Measure(element);
+  EXPECT_EQ(requirement.min_x, 5);
+  EXPECT_EQ(requirement.min_y, 2);
+
+  // The layout continues from the requirement measured.
+  Screen screen(requirement.min_x, requirement.min_y);
+  Render(screen, element);
+  EXPECT_EQ(counter->compute_requirement, 1);
+  EXPECT_EQ(counter->set_box, 1);
+  EXPECT_EQ(screen.ToString(), "     \r\nhello");
+
+  // The next Render starts over.
+  Render(screen, element);
+  EXPECT_EQ(counter->compute_requirement, 2);
+}
+
+TEST(NodeTest, FitThenRender) {
+  auto counter = std::make_shared<Counter>();
+  Element element = vbox({counter, text("hello")});
+  Screen screen = Screen::Create(Dimension::Fit(element));
+  Render(screen, element);
+  EXPECT_EQ(counter->compute_requirement, 1);
+}
+
+TEST(NodeTest, RenderParallel) {
+  std::atomic<int> canvas_calls{0};
+  std::atomic<int> graph_calls{0};
+  auto make = [&] {
+    return hbox({
+        canvas([&](Canvas& c) {
+          canvas_calls++;
+          c.DrawPointLine(0, 0, c.width() - 1, c.height() - 1);
+        }) | border,
+        graph([&](int width, int height) {
+          graph_calls++;
+          std::vector<int> data(width);
+          for (int i = 0; i < width; ++i) {
+            data[i] = i % height;
+          }
+          return data;
+        }) | flex,
+        vbox({text("text"), separator(), text("text")}),
+    });
+  };
+
+  Screen serial(30, 8);
+  Render(serial, make());
+
+  Screen parallel(30, 8);
+  RenderParallel(parallel, make(), 4);
+
+  EXPECT_EQ(parallel.ToString(), serial.ToString());
+  EXPECT_EQ(canvas_calls, 2);
+  EXPECT_EQ(graph_calls, 2);
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -1,27 +1,280 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <sstream>  // for basic_istream, stringstream
-#include <string>   // for string, allocator, getline
-#include <utility>  // for move
+#include "ftxui/dom/paragraph.hpp"
 
-#include "ftxui/dom/elements.hpp"  // for flexbox, Element, text, Elements, operator|, xflex, paragraph, paragraphAlignCenter, paragraphAlignJustify, paragraphAlignLeft, paragraphAlignRight
-#include "ftxui/dom/flexbox_config.hpp"  // for FlexboxConfig, FlexboxConfig::JustifyContent, FlexboxConfig::JustifyContent::Center, FlexboxConfig::JustifyContent::FlexEnd, FlexboxConfig::JustifyContent::SpaceBetween
+#include <algorithm>    // for min, max
+#include <cstddef>      // for size_t
+#include <string>       // for string
+#include <string_view>  // for string_view
+#include <utility>      // for move
+#include <vector>       // for vector
+
+#include "ftxui/dom/elements.hpp"  // for Element, paragraph, paragraphAlignCenter, paragraphAlignJustify, paragraphAlignLeft, paragraphAlignRight
+#include "ftxui/dom/node.hpp"         // for Node, Node::Status
+#include "ftxui/dom/node_pool.hpp"    // for MakeNode
+#include "ftxui/dom/requirement.hpp"  // for Requirement
+#include "ftxui/screen/box.hpp"       // for Box
+#include "ftxui/screen/screen.hpp"    // for Screen
+#include "ftxui/screen/string.hpp"    // for string_width, GlyphRange
+#include "ftxui/util/ref.hpp"         // for ConstRef
 
 namespace ftxui {
 
 namespace {
-Elements Split(const std::string& the_text) {
-  Elements output;
-  std::stringstream ss(the_text);
-  std::string word;
-  while (std::getline(ss, word, ' ')) {
-    output.push_back(text(word));
+
+enum class Align {
+  Left,
+  Right,
+  Center,
+  Justify,
+};
+
+// Where a word is drawn, relative to the paragraph.
+struct Placement {
+  int x = 0;
+  int y = 0;
+  int width = 0;
+};
+
+// Break the words of a paragraph into lines, and align them. The layout is the
+// one of a wrapping flexbox of text elements, separated by a gap of one cell,
+// computed over the widths of the words only.
+//
+// The justified alignment appends an empty word. In the last line, it takes
+// the remaining space when |grow|, so that this line isn't stretched.
+class WordLayout {
+ public:
+  // Lay out |words| within |size_x| cells. Return the placements, the filler
+  // included.
+  const std::vector<Placement>& Compute(
+      const std::vector<Paragraph::Word>& words,
+      int size_x,
+      Align align,
+      bool filler,
+      bool grow) {
+    const int count = int(words.size()) + (filler ? 1 : 0);
+    const auto width = [&](int i) {
+      return i < int(words.size()) ? words[i].width : 0;
+    };
+
+    placements_.resize(size_t(count));
+    int first = 0;
+    int x = 0;
+    int y = 0;
+    for (int i = 0; i < count; ++i) {
+      const int w = width(i);
+      // Doesn't it fit the end of the line? Start a new one.
+      if (x + w > size_x) {
+        if (i != first) {
+          Line(first, i, size_x, align, /*grow=*/false);
+          ++y;
+        }
+        first = i;
+        x = 0;
+      }
+      placements_[i] = {0, y, w};
+      x += w + 1;
+    }
+    if (count != first) {
+      Line(first, count, size_x, align, filler && grow);
+    }
+    return placements_;
   }
-  return output;
-}
+
+ private:
+  // Place the words [first, last) of a line. When |grow|, the last one is the
+  // filler, taking the remaining space.
+  void Line(int first, int last, int size_x, Align align, bool grow) {
+    Placement* line = placements_.data() + first;
+    const int count = last - first;
+    const int available = size_x - (count - 1);
+    if (count == 1 && line[0].width > available) {
+      // A word wider than the line is clipped.
+      line[0].width = available;
+    }
+    if (grow) {
+      int used = 0;
+      for (int i = 0; i < count - 1; ++i) {
+        used += line[i].width;
+      }
+      line[count - 1].width = std::max(0, available - used);
+    }
+
+    int x = 0;
+    for (int i = 0; i < count; ++i) {
+      line[i].x = x;
+      x += line[i].width + 1;
+    }
+
+    int remaining = size_x - line[count - 1].x - line[count - 1].width;
+    switch (align) {
+      case Align::Left:
+        break;
+      case Align::Right:
+        for (int i = 0; i < count; ++i) {
+          line[i].x += remaining;
+        }
+        break;
+      case Align::Center:
+        for (int i = 0; i < count; ++i) {
+          line[i].x += remaining / 2;
+        }
+        break;
+      case Align::Justify:
+        for (int i = count - 1; i >= 1; --i) {
+          line[i].x += remaining;
+          remaining = remaining * (i - 1) / i;
+        }
+        break;
+    }
+  }
+
+  std::vector<Placement> placements_;
+};
+
+// A paragraph is a single node. Its words are measured once by the Paragraph,
+// broken into lines here, and drawn directly.
+class ParagraphNode : public Node {
+ public:
+  ParagraphNode(ConstRef<Paragraph> paragraph, Align align)
+      : paragraph_(std::move(paragraph)), align_(align) {
+    requirement_.flex_grow_x = 1;
+    requirement_.flex_grow_y = 0;
+  }
+
+  void ComputeRequirement() override {
+    // Like for the flexbox, the space isn't distributed for the requirement.
+    const std::vector<Placement>& placements = requirement_layout_.Compute(
+        paragraph_->words(), asked_, Align::Left, align_ == Align::Justify,
+        /*grow=*/false);
+
+    requirement_.min_x = 0;
+    requirement_.min_y = 0;
+    for (const Placement& placement : placements) {
+      requirement_.min_x =
+          std::max(requirement_.min_x, placement.x + placement.width);
+    }
+    if (!placements.empty()) {
+      requirement_.min_y = placements.back().y + 1;
+    }
+  }
+
+  void SetBox(Box box) override {
+    Node::SetBox(box);
+
+    const int asked_previous = asked_;
+    asked_ = std::min(asked_, box.x_max - box.x_min + 1);
+    need_iteration_ = (asked_ != asked_previous);
+
+    const std::vector<Placement>& placements = box_layout_.Compute(
+        paragraph_->words(), box.x_max - box.x_min + 1, align_,
+        align_ == Align::Justify, /*grow=*/true);
+
+    word_boxes_.clear();
+    word_boxes_.reserve(paragraph_->words().size());
+    for (size_t i = 0; i < paragraph_->words().size(); ++i) {
+      const Placement& placement = placements[i];
+      Box word_box;
+      word_box.x_min = box.x_min + placement.x;
+      word_box.y_min = box.y_min + placement.y;
+      word_box.x_max = box.x_min + placement.x + placement.width - 1;
+      word_box.y_max = box.y_min + placement.y;
+
+      const Box intersection = Box::Intersection(word_box, box);
+      word_boxes_.push_back(intersection);
+      need_iteration_ |= (intersection != word_box);
+    }
+  }
+
+  void Check(Status* status) override {
+    if (status->iteration == 0) {
+      asked_ = 6000;  // NOLINT
+      need_iteration_ = true;
+    }
+
+    status->need_iteration |= need_iteration_;
+  }
+
+  void Render(Screen& screen) override {
+    for (size_t i = 0; i < word_boxes_.size(); ++i) {
+      RenderWord(screen, paragraph_->WordAt(i), word_boxes_[i]);
+    }
+  }
+
+ private:
+  // Draw |word| like text() would, clipped to |box|.
+  static void RenderWord(Screen& screen, std::string_view word, Box box) {
+    int x = box.x_min;
+    const int y = box.y_min;
+    if (y > box.y_max) {
+      return;
+    }
+    for (const Glyph& glyph : GlyphRange(word)) {
+      if (x > box.x_max) {
+        return;
+      }
+      if (glyph.text == "\n") {
+        continue;
+      }
+      screen.PixelAt(x, y).character = glyph.text;
+      ++x;
+
+      // Fullwidth glyphs take two cells. The second is left empty.
+      if (glyph.width == 2) {
+        if (x > box.x_max) {
+          return;
+        }
+        screen.PixelAt(x, y).character.clear();
+        ++x;
+      }
+    }
+  }
+
+  ConstRef<Paragraph> paragraph_;
+  const Align align_;
+  std::vector<Box> word_boxes_;
+  int asked_ = 6000;  // NOLINT
+  bool need_iteration_ = true;
+
+  // The layouts used to compute the requirement and to set the box. Kept
+  // across calls, to reuse their storage.
+  WordLayout requirement_layout_;
+  WordLayout box_layout_;
+};
+
 }  // namespace
 
+/// @brief Split |text| into its words, and measure them.
+Paragraph::Paragraph(std::string text) {
+  SetText(std::move(text));
+}
+
+/// @brief Replace the text, and split it into its words again.
+void Paragraph::SetText(std::string text) {
+  text_ = std::move(text);
+  words_.clear();
+  size_t start = 0;
+  while (start < text_.size()) {
+    size_t end = text_.find(' ', start);
+    if (end == std::string::npos) {
+      end = text_.size();
+    }
+    Word word;
+    word.start = start;
+    word.size = end - start;
+    word.width = string_width(text_.substr(start, end - start));
+    words_.push_back(word);
+    start = end + 1;
+  }
+}
+
+/// @brief The word at |index|, as a view of the text.
+std::string_view Paragraph::WordAt(size_t index) const {
+  const Word& word = words_[index];
+  return std::string_view(text_).substr(word.start, word.size);
+}
+
 /// @brief Return an element drawing the paragraph on multiple lines.
 /// @ingroup dom
 /// @see flexbox.
@@ -34,8 +287,7 @@ Element paragraph(const std::string& the_text) {
 /// @ingroup dom
 /// @see flexbox.
 Element paragraphAlignLeft(const std::string& the_text) {
-  static const auto config = FlexboxConfig().SetGap(1, 0);
-  return flexbox(Split(the_text), config);
+  return paragraphAlignLeft(ConstRef<Paragraph>(Paragraph(the_text)));
 }
 
 /// @brief Return an element drawing the paragraph on multiple lines, aligned on
@@ -43,9 +295,7 @@ Element paragraphAlignLeft(const std::string& the_text) {
 /// @ingroup dom
 /// @see flexbox.
 Element paragraphAlignRight(const std::string& the_text) {
-  static const auto config =
-      FlexboxConfig().SetGap(1, 0).Set(FlexboxConfig::JustifyContent::FlexEnd);
-  return flexbox(Split(the_text), config);
+  return paragraphAlignRight(ConstRef<Paragraph>(Paragraph(the_text)));
 }
 
 /// @brief Return an element drawing the paragraph on multiple lines, aligned on
@@ -53,9 +303,7 @@ Element paragraphAlignRight(const std::string& the_text) {
 /// @ingroup dom
 /// @see flexbox.
 Element paragraphAlignCenter(const std::string& the_text) {
-  static const auto config =
-      FlexboxConfig().SetGap(1, 0).Set(FlexboxConfig::JustifyContent::Center);
-  return flexbox(Split(the_text), config);
+  return paragraphAlignCenter(ConstRef<Paragraph>(Paragraph(the_text)));
 }
 
 /// @brief Return an element drawing the paragraph on multiple lines, aligned
@@ -64,11 +312,47 @@ Element paragraphAlignCenter(const std::string& the_text) {
 /// @ingroup dom
 /// @see flexbox.
 Element paragraphAlignJustify(const std::string& the_text) {
-  static const auto config = FlexboxConfig().SetGap(1, 0).Set(
-      FlexboxConfig::JustifyContent::SpaceBetween);
-  Elements words = Split(the_text);
-  words.push_back(text("") | xflex);
-  return flexbox(std::move(words), config);
+  return paragraphAlignJustify(ConstRef<Paragraph>(Paragraph(the_text)));
+}
+
+/// @brief Return an element drawing a Paragraph on multiple lines. Its words
+/// were split and measured once, when it was constructed.
+/// @ingroup dom
+/// @see Paragraph.
+Element paragraph(ConstRef<Paragraph> paragraph) {
+  return paragraphAlignLeft(std::move(paragraph));
+}
+
+/// @brief Return an element drawing a Paragraph on multiple lines, aligned on
+/// the left.
+/// @ingroup dom
+/// @see Paragraph.
+Element paragraphAlignLeft(ConstRef<Paragraph> paragraph) {
+  return MakeNode<ParagraphNode>(std::move(paragraph), Align::Left);
+}
+
+/// @brief Return an element drawing a Paragraph on multiple lines, aligned on
+/// the right.
+/// @ingroup dom
+/// @see Paragraph.
+Element paragraphAlignRight(ConstRef<Paragraph> paragraph) {
+  return MakeNode<ParagraphNode>(std::move(paragraph), Align::Right);
+}
+
+/// @brief Return an element drawing a Paragraph on multiple lines, aligned on
+/// the center.
+/// @ingroup dom
+/// @see Paragraph.
+Element paragraphAlignCenter(ConstRef<Paragraph> paragraph) {
+  return MakeNode<ParagraphNode>(std::move(paragraph), Align::Center);
+}
+
+/// @brief Return an element drawing a Paragraph on multiple lines, using a
+/// justified alignment.
+/// @ingroup dom
+/// @see Paragraph.
+Element paragraphAlignJustify(ConstRef<Paragraph> paragraph) {
+  return MakeNode<ParagraphNode>(std::move(paragraph), Align::Justify);
 }
 
 }  // namespace ftxui
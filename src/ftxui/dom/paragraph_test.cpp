@@ -0,0 +1,130 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <random>  // for mt19937, uniform_int_distribution
+#include <string>  // for string
+#include <vector>  // for vector
+
+#include "ftxui/dom/elements.hpp"        // for paragraph, flexbox, text, xflex
+#include "ftxui/dom/flexbox_config.hpp"  // for FlexboxConfig
+#include "ftxui/dom/node.hpp"            // for Render
+#include "ftxui/dom/paragraph.hpp"       // for Paragraph
+#include "ftxui/screen/screen.hpp"       // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+
+// How paragraph() used to be implemented.
+Element FlexboxParagraph(const std::string& the_text, FlexboxConfig config,
+                         bool justify) {
+  Elements words;
+  size_t start = 0;
+  while (start < the_text.size()) {
+    size_t end = the_text.find(' ', start);
+    if (end == std::string::npos) {
+      end = the_text.size();
+    }
+    words.push_back(text(the_text.substr(start, end - start)));
+    start = end + 1;
+  }
+  if (justify) {
+    words.push_back(text("") | xflex);
+  }
+  return flexbox(std::move(words), config);
+}
+
+std::string Draw(Element element, int width, int height) {
+  Screen screen(width, height);
+  Render(screen, element);
+  return screen.ToString();
+}
+
+}  // namespace
+
+TEST(ParagraphTest, Basic) {
+  auto element = paragraph("aaa bb cccc d");
+  EXPECT_EQ(Draw(element, 7, 3),
+            "aaa bb \r\n"
+            "cccc d \r\n"
+            "       ");
+  EXPECT_EQ(Draw(element, 3, 3),
+            "aaa\r\n"
+            "bb \r\n"
+            "ccc");
+}
+
+TEST(ParagraphTest, Alignments) {
+  EXPECT_EQ(Draw(paragraphAlignRight("aa bb ccc"), 6, 2),
+            " aa bb\r\n"
+            "   ccc");
+  EXPECT_EQ(Draw(paragraphAlignCenter("aa bb ccc"), 6, 2),
+            "aa bb \r\n"
+            " ccc  ");
+  EXPECT_EQ(Draw(paragraphAlignJustify("aa bb ccc d"), 7, 2),
+            "aa   bb\r\n"
+            "ccc d  ");
+}
+
+TEST(ParagraphTest, Reused) {
+  Paragraph text("测试 ab c");
+  ASSERT_EQ(text.words().size(), 3u);
+  EXPECT_EQ(text.WordAt(0), "测试");
+  EXPECT_EQ(text.words()[0].width, 4);
+  EXPECT_EQ(text.WordAt(2), "c");
+
+  EXPECT_EQ(Draw(paragraph(&text), 7, 2),
+            "测试 ab\r\n"
+            "c      ");
+  text.SetText("x");
+  EXPECT_EQ(Draw(paragraph(&text), 3, 1), "x  ");
+}
+
+// The layout is the one of a flexbox of words.
+TEST(ParagraphTest, MatchesFlexbox) {
+  const FlexboxConfig base = FlexboxConfig().SetGap(1, 0);
+  struct Alignment {
+    Element (*element)(const std::string&);
+    FlexboxConfig config;
+    bool justify;
+  };
+  const std::vector<Alignment> alignments = {
+      {paragraphAlignLeft, base, false},
+      {paragraphAlignRight,
+       FlexboxConfig(base).Set(FlexboxConfig::JustifyContent::FlexEnd), false},
+      {paragraphAlignCenter,
+       FlexboxConfig(base).Set(FlexboxConfig::JustifyContent::Center), false},
+      {paragraphAlignJustify,
+       FlexboxConfig(base).Set(FlexboxConfig::JustifyContent::SpaceBetween),
+       true},
+  };
+
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> length(0, 40);
+  std::uniform_int_distribution<int> character(0, 5);
+  for (int i = 0; i < 50; ++i) {
+    std::string input;
+    const int count = length(random);
+    for (int j = 0; j < count; ++j) {
+      const int c = character(random);
+      input += c == 0 ? " " : c == 1 ? "测" : std::string(1, char('a' + c));
+    }
+    for (const Alignment& alignment : alignments) {
+      for (int width : {1, 3, 8, 20}) {
+        const auto frame = [&](Element element) {
+          return vbox({element, text("-")}) | size(WIDTH, EQUAL, width);
+        };
+        EXPECT_EQ(Draw(frame(alignment.element(input)), 22, 24),
+                  Draw(frame(FlexboxParagraph(input, alignment.config,
+                                              alignment.justify)),
+                       22, 24))
+            << input << " " << width;
+      }
+    }
+  }
+}
+
+}  // namespace ftxui
+// NOLINTEND
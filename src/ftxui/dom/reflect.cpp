@@ -6,6 +6,7 @@
 
 #include "ftxui/dom/elements.hpp"     // for Element, unpack, Decorator, reflect
 #include "ftxui/dom/node.hpp"         // for Node, Elements
+#include "ftxui/dom/node_pool.hpp"    // for MakeNode
 #include "ftxui/dom/requirement.hpp"  // for Requirement
 #include "ftxui/screen/box.hpp"       // for Box
 #include "ftxui/screen/screen.hpp"    // for Screen
@@ -25,13 +26,14 @@ class Reflect : public Node {
   }
 
   void SetBox(Box box) final {
-    reflected_box_ = box;
+    // Empty, unless rendered. Elements outside of the stencil aren't.
+    reflected_box_ = Box{0, -1, 0, -1};
     Node::SetBox(box);
     children_[0]->SetBox(box);
   }
 
   void Render(Screen& screen) final {
-    reflected_box_ = Box::Intersection(screen.stencil, reflected_box_);
+    reflected_box_ = Box::Intersection(screen.stencil, box_);
     Node::Render(screen);
   }
 
@@ -42,7 +44,7 @@ class Reflect : public Node {
 
 Decorator reflect(Box& box) {
   return [&](Element child) -> Element {
-    return std::make_shared<Reflect>(std::move(child), box);
+    return MakeNode<Reflect>(std::move(child), box);
   };
 }
 
@@ -9,6 +9,7 @@
 #include "ftxui/dom/elements.hpp"  // for Element, vscroll_indicator, hscroll_indicator
 #include "ftxui/dom/node.hpp"            // for Node, Elements
 #include "ftxui/dom/node_decorator.hpp"  // for NodeDecorator
+#include "ftxui/dom/node_pool.hpp"       // for MakeNode
 #include "ftxui/dom/requirement.hpp"     // for Requirement
 #include "ftxui/screen/box.hpp"          // for Box
 #include "ftxui/screen/screen.hpp"       // for Screen, Pixel
@@ -67,7 +68,7 @@ Element vscroll_indicator(Element child) {
       }
     }
   };
-  return std::make_shared<Impl>(std::move(child));
+  return MakeNode<Impl>(std::move(child));
 }
 
 /// @brief Display an horizontal scrollbar to the bottom.
@@ -123,7 +124,7 @@ Element hscroll_indicator(Element child) {
       }
     }
   };
-  return std::make_shared<Impl>(std::move(child));
+  return MakeNode<Impl>(std::move(child));
 }
 
 }  // namespace ftxui
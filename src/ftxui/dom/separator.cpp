@@ -8,6 +8,7 @@
 
 #include "ftxui/dom/elements.hpp"  // for Element, BorderStyle, LIGHT, separator, DOUBLE, EMPTY, HEAVY, separatorCharacter, separatorDouble, separatorEmpty, separatorHSelector, separatorHeavy, separatorLight, separatorStyled, separatorVSelector
 #include "ftxui/dom/node.hpp"      // for Node
+#include "ftxui/dom/node_pool.hpp"  // for MakeNode
 #include "ftxui/dom/requirement.hpp"  // for Requirement
 #include "ftxui/screen/box.hpp"       // for Box
 #include "ftxui/screen/color.hpp"     // for Color
@@ -40,11 +41,7 @@ class Separator : public Node {
 
   void Render(Screen& screen) override {
     for (int y = box_.y_min; y <= box_.y_max; ++y) {
-      for (int x = box_.x_min; x <= box_.x_max; ++x) {
-        Pixel& pixel = screen.PixelAt(x, y);
-        pixel.character = value_;
-        pixel.automerge = true;
-      }
+      screen.FillRow(box_.x_min, box_.x_max, y, value_, /*automerge=*/true);
     }
   }
 
@@ -64,15 +61,11 @@ class SeparatorAuto : public Node {
     const bool is_column = (box_.x_max == box_.x_min);
     const bool is_line = (box_.y_min == box_.y_max);
 
-    const std::string c =
+    const std::string& c =
         charsets[style_][int(is_line && !is_column)];  // NOLINT
 
     for (int y = box_.y_min; y <= box_.y_max; ++y) {
-      for (int x = box_.x_min; x <= box_.x_max; ++x) {
-        Pixel& pixel = screen.PixelAt(x, y);
-        pixel.character = c;
-        pixel.automerge = true;
-      }
+      screen.FillRow(box_.x_min, box_.x_max, y, c, /*automerge=*/true);
     }
   }
 
@@ -87,9 +80,7 @@ class SeparatorWithPixel : public SeparatorAuto {
   }
   void Render(Screen& screen) override {
     for (int y = box_.y_min; y <= box_.y_max; ++y) {
-      for (int x = box_.x_min; x <= box_.x_max; ++x) {
-        screen.PixelAt(x, y) = pixel_;
-      }
+      screen.FillRow(box_.x_min, box_.x_max, y, pixel_);
     }
   }
 
@@ -132,7 +123,7 @@ class SeparatorWithPixel : public SeparatorAuto {
 /// down
 /// ```
 Element separator() {
-  return std::make_shared<SeparatorAuto>(LIGHT);
+  return MakeNode<SeparatorAuto>(LIGHT);
 }
 
 /// @brief Draw a vertical or horizontal separation in between two other
@@ -170,7 +161,7 @@ Element separator() {
 /// down
 /// ```
 Element separatorStyled(BorderStyle style) {
-  return std::make_shared<SeparatorAuto>(style);
+  return MakeNode<SeparatorAuto>(style);
 }
 
 /// @brief Draw a vertical or horizontal separation in between two other
@@ -207,7 +198,7 @@ Element separatorStyled(BorderStyle style) {
 /// down
 /// ```
 Element separatorLight() {
-  return std::make_shared<SeparatorAuto>(LIGHT);
+  return MakeNode<SeparatorAuto>(LIGHT);
 }
 
 /// @brief Draw a vertical or horizontal separation in between two other
@@ -244,7 +235,7 @@ Element separatorLight() {
 /// down
 /// ```
 Element separatorDashed() {
-  return std::make_shared<SeparatorAuto>(DASHED);
+  return MakeNode<SeparatorAuto>(DASHED);
 }
 
 /// @brief Draw a vertical or horizontal separation in between two other
@@ -281,7 +272,7 @@ Element separatorDashed() {
 /// down
 /// ```
 Element separatorHeavy() {
-  return std::make_shared<SeparatorAuto>(HEAVY);
+  return MakeNode<SeparatorAuto>(HEAVY);
 }
 
 /// @brief Draw a vertical or horizontal separation in between two other
@@ -318,7 +309,7 @@ Element separatorHeavy() {
 /// down
 /// ```
 Element separatorDouble() {
-  return std::make_shared<SeparatorAuto>(DOUBLE);
+  return MakeNode<SeparatorAuto>(DOUBLE);
 }
 
 /// @brief Draw a vertical or horizontal separation in between two other
@@ -355,7 +346,7 @@ Element separatorDouble() {
 /// down
 /// ```
 Element separatorEmpty() {
-  return std::make_shared<SeparatorAuto>(EMPTY);
+  return MakeNode<SeparatorAuto>(EMPTY);
 }
 
 /// @brief Draw a vertical or horizontal separation in between two other
@@ -393,7 +384,7 @@ Element separatorEmpty() {
 /// down
 /// ```
 Element separatorCharacter(std::string value) {
-  return std::make_shared<Separator>(std::move(value));
+  return MakeNode<Separator>(std::move(value));
 }
 
 /// @brief Draw a separator in between two element filled with a given pixel.
@@ -424,7 +415,7 @@ Element separatorCharacter(std::string value) {
 /// Down
 /// ```
 Element separator(Pixel pixel) {
-  return std::make_shared<SeparatorWithPixel>(std::move(pixel));
+  return MakeNode<SeparatorWithPixel>(std::move(pixel));
 }
 
 /// @brief Draw an horizontal bar, with the area in between left/right colored
@@ -464,9 +455,10 @@ Element separatorHSelector(float left,
       int demi_cell_left = int(left_ * 2.F - 1.F);    // NOLINT
       int demi_cell_right = int(right_ * 2.F + 2.F);  // NOLINT
 
-      const int y = box_.y_min;
-      for (int x = box_.x_min; x <= box_.x_max; ++x) {
-        Pixel& pixel = screen.PixelAt(x, y);
+      const Image::PixelRow row =
+          screen.ClippedRow(box_.x_min, box_.x_max, box_.y_min);
+      for (int x = row.x_min; x <= row.x_max; ++x) {
+        Pixel& pixel = row[x];
 
         const int a = (x - box_.x_min) * 2;
         const int b = a + 1;
@@ -494,7 +486,7 @@ Element separatorHSelector(float left,
     Color unselected_color_;
     Color selected_color_;
   };
-  return std::make_shared<Impl>(left, right, unselected_color, selected_color);
+  return MakeNode<Impl>(left, right, unselected_color, selected_color);
 }
 
 /// @brief Draw an vertical bar, with the area in between up/downcolored
@@ -564,7 +556,7 @@ Element separatorVSelector(float up,
     Color unselected_color_;
     Color selected_color_;
   };
-  return std::make_shared<Impl>(up, down, unselected_color, selected_color);
+  return MakeNode<Impl>(up, down, unselected_color, selected_color);
 }
 
 }  // namespace ftxui
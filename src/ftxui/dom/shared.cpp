@@ -0,0 +1,87 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <utility>  // for move
+
+#include "ftxui/dom/elements.hpp"   // for Element, shared
+#include "ftxui/dom/node.hpp"       // for Node
+#include "ftxui/dom/node_pool.hpp"  // for MakeNode
+#include "ftxui/screen/box.hpp"     // for Box
+#include "ftxui/screen/screen.hpp"  // for Screen
+
+namespace ftxui {
+
+// One placement of a shared subtree. The subtree isn't a child: the layout
+// only reaches it through the placements, and RenderParallel doesn't prepare
+// it concurrently from several of them.
+class SharedNode : public Node {
+ public:
+  explicit SharedNode(Element child) : child_(std::move(child)) {}
+
+  // The requirement doesn't depend on where the subtree is placed. The first
+  // placement computes it, and the others reuse it, until the next Check.
+  void ComputeRequirement() override {
+    if (!child_->shared_requirement_) {
+      ComputeChildRequirement(child_.get());
+      child_->shared_requirement_ = true;
+    }
+    requirement_ = child_->requirement();
+  }
+
+  void SetBox(Box box) override {
+    Node::SetBox(box);
+    SetChildBox(child_.get(), box);
+  }
+
+  // Every layout checks the tree before computing the requirements: the ones
+  // of a new iteration, or a new frame, are computed again.
+  void Check(Status* status) override {
+    child_->shared_requirement_ = false;
+    CheckChild(child_.get(), status);
+  }
+
+  // Another placement might have moved the subtree since the layout. Only
+  // its box is assigned again, not its requirement.
+  void Render(Screen& screen) override {
+    SetChildBox(child_.get(), box_);
+    child_->Render(screen);
+  }
+
+ private:
+  Element child_;
+};
+
+/// @brief Display |element|, which can be displayed in other places too, and
+/// kept from one frame to the next.
+/// @ingroup dom
+///
+/// An element holds its own layout, so it can't be placed twice in a tree.
+/// This one is placed by the element returned, and laid out again where it is
+/// drawn. Static subtrees, like headers, legends or help texts, can then be
+/// built once, and displayed anywhere, on every frame. Their requirement is
+/// computed once per layout iteration, whatever the number of placements.
+///
+/// The placements share the requirement. The elements whose requirement
+/// depends on their width, like `paragraph`, must be given the same width
+/// everywhere. The element must only be rendered by one thread at a time.
+///
+/// ### Example
+///
+/// ```cpp
+/// // Once:
+/// const Element legend = vbox({
+///   text("■ CPU") | color(Color::Red),
+///   text("■ Memory") | color(Color::Blue),
+/// });
+///
+/// // On every frame:
+/// auto document = hbox({
+///   vbox({graph(cpu), shared(legend)}),
+///   vbox({graph(memory), shared(legend)}),
+/// });
+/// ```
+Element shared(Element element) {
+  return MakeNode<SharedNode>(std::move(element));
+}
+
+}  // namespace ftxui
@@ -0,0 +1,81 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <memory>  // for make_shared
+#include <string>  // for string
+
+#include "ftxui/dom/elements.hpp"  // for text, hbox, vbox, shared, border, separator
+#include "ftxui/dom/node.hpp"       // for Node, Render
+#include "ftxui/screen/screen.hpp"  // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+
+// A 2x1 element, counting the computations of its requirement.
+class Counted : public Node {
+ public:
+  explicit Counted(int* count) : count_(count) {}
+  void ComputeRequirement() override {
+    (*count_)++;
+    requirement_.min_x = 2;
+    requirement_.min_y = 1;
+  }
+
+ private:
+  int* count_;
+};
+
+}  // namespace
+
+TEST(SharedTest, TwoPlacements) {
+  const Element legend = vbox({text("ab"), text("cd")});
+  auto document = hbox({
+      shared(legend),
+      separator(),
+      shared(legend) | border,
+  });
+  Screen screen(7, 4);
+  Render(screen, document);
+  EXPECT_EQ(screen.ToString(),
+            "ab│╭──╮\r\n"
+            "cd││ab│\r\n"
+            "  ││cd│\r\n"
+            "  │╰──╯");
+}
+
+TEST(SharedTest, AcrossFrames) {
+  const Element legend = text("legend") | border;
+  for (int frame = 0; frame < 3; ++frame) {
+    // Placed elsewhere on every frame.
+    auto document = vbox({
+        text(std::string(size_t(frame), 'x')),
+        hbox({text(std::string(size_t(frame), ' ')), shared(legend)}),
+    });
+    Screen screen(10, 4);
+    Render(screen, document);
+    EXPECT_EQ(screen.PixelAt(frame + 1, 2).character, "l") << frame;
+    EXPECT_EQ(screen.PixelAt(frame, 1).character, "╭") << frame;
+  }
+}
+
+TEST(SharedTest, RequirementComputedOnce) {
+  int count = 0;
+  const Element counted = std::make_shared<Counted>(&count);
+  for (int frame = 1; frame <= 3; ++frame) {
+    auto document = hbox({
+        shared(counted),
+        separator(),
+        shared(counted) | border,
+    });
+    Screen screen(8, 3);
+    Render(screen, document);
+    // Once per frame, not once per placement.
+    EXPECT_EQ(count, frame);
+  }
+}
+
+}  // namespace ftxui
+// NOLINTEND
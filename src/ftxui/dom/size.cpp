@@ -7,6 +7,7 @@
 
 #include "ftxui/dom/elements.hpp"  // for Constraint, WidthOrHeight, EQUAL, GREATER_THAN, LESS_THAN, WIDTH, unpack, Decorator, Element, size
 #include "ftxui/dom/node.hpp"      // for Node, Elements
+#include "ftxui/dom/node_pool.hpp"  // for MakeNode
 #include "ftxui/dom/requirement.hpp"  // for Requirement
 #include "ftxui/screen/box.hpp"       // for Box
 
@@ -88,7 +89,7 @@ class Size : public Node {
 /// @ingroup dom
 Decorator size(WidthOrHeight direction, Constraint constraint, int value) {
   return [=](Element e) {
-    return std::make_shared<Size>(std::move(e), direction, constraint, value);
+    return MakeNode<Size>(std::move(e), direction, constraint, value);
   };
 }
 
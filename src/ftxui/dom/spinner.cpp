@@ -1,274 +1,340 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <cstddef>  // for size_t
-#include <string>   // for basic_string, string
-#include <utility>  // for move
-#include <vector>   // for vector, __alloc_traits<>::value_type
+#include <algorithm>  // for max
+#include <cstddef>    // for size_t
+#include <string>     // for basic_string, string
+#include <vector>     // for vector, __alloc_traits<>::value_type
 
-#include "ftxui/dom/elements.hpp"  // for Element, gauge, text, vbox, spinner
+#include "ftxui/dom/elements.hpp"     // for Element, gauge, spinner
+#include "ftxui/dom/node.hpp"         // for Node
+#include "ftxui/dom/node_pool.hpp"    // for MakeNode
+#include "ftxui/dom/requirement.hpp"  // for Requirement
+#include "ftxui/screen/box.hpp"       // for Box
+#include "ftxui/screen/screen.hpp"    // for Pixel, Screen
+#include "ftxui/screen/string.hpp"    // for Utf8ToGlyphs, string_width
 
 namespace ftxui {
 
 namespace {
-// NOLINTNEXTLINE
-const std::vector<std::vector<std::vector<std::string>>> elements = {
-    {
-        {"Replaced by the gauge"},
-    },
-    {
-        {".  "},
-        {".. "},
-        {"..."},
-    },
-    {
-        {"|"},
-        {"/"},
-        {"-"},
-        {"\\"},
-    },
-    {
-        {"+"},
-        {"x"},
-    },
-    {
-        {"|  "},
-        {"|| "},
-        {"|||"},
-    },
-    {
-        {"←"},
-        {"↖"},
-        {"↑"},
-        {"↗"},
-        {"→"},
-        {"↘"},
-        {"↓"},
-        {"↙"},
-    },
-    {
-        {"▁"},
-        {"▂"},
-        {"▃"},
-        {"▄"},
-        {"▅"},
-        {"▆"},
-        {"▇"},
-        {"█"},
-        {"▇"},
-        {"▆"},
-        {"▅"},
-        {"▄"},
-        {"▃"},
-        {"▁"},
-    },
-    {
-        {"▉"},
-        {"▊"},
-        {"▋"},
-        {"▌"},
-        {"▍"},
-        {"▎"},
-        {"▏"},
-        {"▎"},
-        {"▍"},
-        {"▌"},
-        {"▋"},
-        {"▊"},
-    },
-    {
-        {"▖"},
-        {"▘"},
-        {"▝"},
-        {"▗"},
-    },
-    {
-        {"◢"},
-        {"◣"},
-        {"◤"},
-        {"◥"},
-    },
-    {
-        {"◰"},
-        {"◳"},
-        {"◲"},
-        {"◱"},
-    },
-    {
-        {"◴"},
-        {"◷"},
-        {"◶"},
-        {"◵"},
-    },
-    {
-        {"◐"},
-        {"◓"},
-        {"◑"},
-        {"◒"},
-    },
-    {
-        {"◡"},
-        {"⊙"},
-        {"◠"},
-    },
-    {
-        {"⠁"},
-        {"⠂"},
-        {"⠄"},
-        {"⡀"},
-        {"⢀"},
-        {"⠠"},
-        {"⠐"},
-        {"⠈"},
-    },
-    {
-        {"⠋"},
-        {"⠙"},
-        {"⠹"},
-        {"⠸"},
-        {"⠼"},
-        {"⠴"},
-        {"⠦"},
-        {"⠧"},
-        {"⠇"},
-        {"⠏"},
-    },
-    {
-        {"(*----------)"}, {"(-*---------)"}, {"(--*--------)"},
-        {"(---*-------)"}, {"(----*------)"}, {"(-----*-----)"},
-        {"(------*----)"}, {"(-------*---)"}, {"(--------*--)"},
-        {"(---------*-)"}, {"(----------*)"}, {"(---------*-)"},
-        {"(--------*--)"}, {"(-------*---)"}, {"(------*----)"},
-        {"(-----*-----)"}, {"(----*------)"}, {"(---*-------)"},
-        {"(--*--------)"}, {"(-*---------)"},
-    },
-    {
-        {"[      ]"},
-        {"[=     ]"},
-        {"[==    ]"},
-        {"[===   ]"},
-        {"[====  ]"},
-        {"[===== ]"},
-        {"[======]"},
-        {"[===== ]"},
-        {"[====  ]"},
-        {"[===   ]"},
-        {"[==    ]"},
-        {"[=     ]"},
-    },
-    {
-        {"[      ]"},
-        {"[=     ]"},
-        {"[==    ]"},
-        {"[===   ]"},
-        {"[====  ]"},
-        {"[===== ]"},
-        {"[======]"},
-        {"[ =====]"},
-        {"[  ====]"},
-        {"[   ===]"},
-        {"[    ==]"},
-        {"[     =]"},
-    },
-    {
-        {"[==    ]"},
-        {"[==    ]"},
-        {"[==    ]"},
-        {"[==    ]"},
-        {"[==    ]"},
-        {" [==   ]"},
-        {"[  ==  ]"},
-        {"[   == ]"},
-        {"[    ==]"},
-        {"[    ==]"},
-        {"[    ==]"},
-        {"[    ==]"},
-        {"[    ==]"},
-        {"[   ==] "},
-        {"[  ==  ]"},
-        {"[ ==   ]"},
-    },
-    {
-        {
-            " ─╮",
-            "  │",
-            "   ",
-        },
-        {
-            "  ╮",
-            "  │",
-            "  ╯",
-        },
-        {
-            "   ",
-            "  │",
-            " ─╯",
-        },
-        {
-            "   ",
-            "   ",
-            "╰─╯",
-        },
-        {
-            "   ",
-            "│  ",
-            "╰─ ",
-        },
-        {
-            "╭  ",
-            "│  ",
-            "╰  ",
-        },
-        {
-            "╭─ ",
-            "│  ",
-            "   ",
-        },
-        {
-            "╭─╮",
-            "   ",
-            "   ",
-        },
-    },
-    {
-        {
-            "   /\\O ",
-            "    /\\/",
-            "   /\\  ",
-            "  /  \\ ",
-            "LOL  LOL",
-        },
-        {
-            "    _O  ",
-            "   //|_ ",
-            "    |   ",
-            "   /|   ",
-            "   LLOL ",
-        },
-        {
-            "     O  ",
-            "    /_  ",
-            "    |\\  ",
-            "   / |  ",
-            " LOLLOL ",
-        },
-    },
-    {
-        {"       ", "_______", "       "},
-        {"       ", "______/", "       "},
-        {"      _", "_____/ ", "       "},
-        {"     _ ", "____/ \\", "       "},
-        {"    _  ", "___/ \\ ", "      \\"},
-        {"   _   ", "__/ \\  ", "     \\_"},
-        {"  _    ", "_/ \\   ", "    \\_/"},
-        {" _     ", "/ \\   _", "   \\_/ "},
-        {"_      ", " \\   __", "  \\_/  "},
-        {"       ", "\\   ___", " \\_/   "},
-        {"       ", "    ___", "\\_/    "},
-        {"       ", "  _____", "_/     "},
-        {"       ", " ______", "/      "},
-        {"       ", "_______", "       "},
-    },
+// The lines of each frame of each "video". Only read once, by Frames(), so
+// nothing is constructed when the program starts.
+std::vector<std::vector<std::vector<std::string>>> Videos() {
+  return {
+      {
+          {"Replaced by the gauge"},
+      },
+      {
+          {".  "},
+          {".. "},
+          {"..."},
+      },
+      {
+          {"|"},
+          {"/"},
+          {"-"},
+          {"\\"},
+      },
+      {
+          {"+"},
+          {"x"},
+      },
+      {
+          {"|  "},
+          {"|| "},
+          {"|||"},
+      },
+      {
+          {"←"},
+          {"↖"},
+          {"↑"},
+          {"↗"},
+          {"→"},
+          {"↘"},
+          {"↓"},
+          {"↙"},
+      },
+      {
+          {"▁"},
+          {"▂"},
+          {"▃"},
+          {"▄"},
+          {"▅"},
+          {"▆"},
+          {"▇"},
+          {"█"},
+          {"▇"},
+          {"▆"},
+          {"▅"},
+          {"▄"},
+          {"▃"},
+          {"▁"},
+      },
+      {
+          {"▉"},
+          {"▊"},
+          {"▋"},
+          {"▌"},
+          {"▍"},
+          {"▎"},
+          {"▏"},
+          {"▎"},
+          {"▍"},
+          {"▌"},
+          {"▋"},
+          {"▊"},
+      },
+      {
+          {"▖"},
+          {"▘"},
+          {"▝"},
+          {"▗"},
+      },
+      {
+          {"◢"},
+          {"◣"},
+          {"◤"},
+          {"◥"},
+      },
+      {
+          {"◰"},
+          {"◳"},
+          {"◲"},
+          {"◱"},
+      },
+      {
+          {"◴"},
+          {"◷"},
+          {"◶"},
+          {"◵"},
+      },
+      {
+          {"◐"},
+          {"◓"},
+          {"◑"},
+          {"◒"},
+      },
+      {
+          {"◡"},
+          {"⊙"},
+          {"◠"},
+      },
+      {
+          {"⠁"},
+          {"⠂"},
+          {"⠄"},
+          {"⡀"},
+          {"⢀"},
+          {"⠠"},
+          {"⠐"},
+          {"⠈"},
+      },
+      {
+          {"⠋"},
+          {"⠙"},
+          {"⠹"},
+          {"⠸"},
+          {"⠼"},
+          {"⠴"},
+          {"⠦"},
+          {"⠧"},
+          {"⠇"},
+          {"⠏"},
+      },
+      {
+          {"(*----------)"}, {"(-*---------)"}, {"(--*--------)"},
+          {"(---*-------)"}, {"(----*------)"}, {"(-----*-----)"},
+          {"(------*----)"}, {"(-------*---)"}, {"(--------*--)"},
+          {"(---------*-)"}, {"(----------*)"}, {"(---------*-)"},
+          {"(--------*--)"}, {"(-------*---)"}, {"(------*----)"},
+          {"(-----*-----)"}, {"(----*------)"}, {"(---*-------)"},
+          {"(--*--------)"}, {"(-*---------)"},
+      },
+      {
+          {"[      ]"},
+          {"[=     ]"},
+          {"[==    ]"},
+          {"[===   ]"},
+          {"[====  ]"},
+          {"[===== ]"},
+          {"[======]"},
+          {"[===== ]"},
+          {"[====  ]"},
+          {"[===   ]"},
+          {"[==    ]"},
+          {"[=     ]"},
+      },
+      {
+          {"[      ]"},
+          {"[=     ]"},
+          {"[==    ]"},
+          {"[===   ]"},
+          {"[====  ]"},
+          {"[===== ]"},
+          {"[======]"},
+          {"[ =====]"},
+          {"[  ====]"},
+          {"[   ===]"},
+          {"[    ==]"},
+          {"[     =]"},
+      },
+      {
+          {"[==    ]"},
+          {"[==    ]"},
+          {"[==    ]"},
+          {"[==    ]"},
+          {"[==    ]"},
+          {" [==   ]"},
+          {"[  ==  ]"},
+          {"[   == ]"},
+          {"[    ==]"},
+          {"[    ==]"},
+          {"[    ==]"},
+          {"[    ==]"},
+          {"[    ==]"},
+          {"[   ==] "},
+          {"[  ==  ]"},
+          {"[ ==   ]"},
+      },
+      {
+          {
+              " ─╮",
+              "  │",
+              "   ",
+          },
+          {
+              "  ╮",
+              "  │",
+              "  ╯",
+          },
+          {
+              "   ",
+              "  │",
+              " ─╯",
+          },
+          {
+              "   ",
+              "   ",
+              "╰─╯",
+          },
+          {
+              "   ",
+              "│  ",
+              "╰─ ",
+          },
+          {
+              "╭  ",
+              "│  ",
+              "╰  ",
+          },
+          {
+              "╭─ ",
+              "│  ",
+              "   ",
+          },
+          {
+              "╭─╮",
+              "   ",
+              "   ",
+          },
+      },
+      {
+          {
+              "   /\\O ",
+              "    /\\/",
+              "   /\\  ",
+              "  /  \\ ",
+              "LOL  LOL",
+          },
+          {
+              "    _O  ",
+              "   //|_ ",
+              "    |   ",
+              "   /|   ",
+              "   LLOL ",
+          },
+          {
+              "     O  ",
+              "    /_  ",
+              "    |\\  ",
+              "   / |  ",
+              " LOLLOL ",
+          },
+      },
+      {
+          {"       ", "_______", "       "},
+          {"       ", "______/", "       "},
+          {"      _", "_____/ ", "       "},
+          {"     _ ", "____/ \\", "       "},
+          {"    _  ", "___/ \\ ", "      \\"},
+          {"   _   ", "__/ \\  ", "     \\_"},
+          {"  _    ", "_/ \\   ", "    \\_/"},
+          {" _     ", "/ \\   _", "   \\_/ "},
+          {"_      ", " \\   __", "  \\_/  "},
+          {"       ", "\\   ___", " \\_/   "},
+          {"       ", "    ___", "\\_/    "},
+          {"       ", "  _____", "_/     "},
+          {"       ", " ______", "/      "},
+          {"       ", "_______", "       "},
+      },
+  };
+}
+
+// A frame of a "video", split into glyphs. Fullwidth glyphs are followed by an
+// empty one, so each glyph takes a cell.
+struct Frame {
+  std::vector<std::vector<std::string>> lines;
+  int width = 0;
+};
+
+// The frames of every "video", split on first use and shared afterward.
+const std::vector<std::vector<Frame>>& Frames() {
+  static const std::vector<std::vector<Frame>> frames = [] {
+    std::vector<std::vector<Frame>> out;
+    for (const auto& video : Videos()) {
+      std::vector<Frame>& frames_out = out.emplace_back();
+      for (const auto& image : video) {
+        Frame& frame = frames_out.emplace_back();
+        for (const auto& line : image) {
+          frame.lines.push_back(Utf8ToGlyphs(line));
+          frame.width = std::max(frame.width, string_width(line));
+        }
+      }
+    }
+    return out;
+  }();
+  return frames;
+}
+
+// Draw a frame, like a vbox of text, without copying it.
+class Spinner : public Node {
+ public:
+  explicit Spinner(const Frame& frame) : frame_(frame) {}
+
+  void ComputeRequirement() override {
+    requirement_.min_x = frame_.width;
+    requirement_.min_y = int(frame_.lines.size());
+  }
+
+  void Render(Screen& screen) override {
+    int y = box_.y_min;
+    for (const auto& line : frame_.lines) {
+      if (y > box_.y_max) {
+        return;
+      }
+      int x = box_.x_min;
+      for (const std::string& glyph : line) {
+        if (x > box_.x_max) {
+          break;
+        }
+        screen.PixelAt(x++, y).character = glyph;
+      }
+      ++y;
+    }
+  }
+
+ private:
+  const Frame& frame_;
 };
 
 }  // namespace
@@ -288,13 +354,10 @@ Element spinner(int charset_index, size_t image_index) {
     }
     return gauge(float(image_index) * 0.05F);  // NOLINT
   }
-  charset_index %= int(elements.size());
-  image_index %= int(elements[charset_index].size());
-  std::vector<Element> lines;
-  for (const auto& it : elements[charset_index][image_index]) {
-    lines.push_back(text(it));
-  }
-  return vbox(std::move(lines));
+  const auto& frames = Frames();
+  charset_index %= int(frames.size());
+  image_index %= frames[charset_index].size();
+  return MakeNode<Spinner>(frames[charset_index][image_index]);
 }
 
 }  // namespace ftxui
@@ -38,5 +38,23 @@ TEST(SpinnerTest, Spinner4) {
   EXPECT_EQ(screen.ToString(), ".   ");
 }
 
+TEST(SpinnerTest, MultiLine) {
+  auto element = spinner(22, 1);
+  Screen screen(8, 4);
+  Render(screen, element);
+  EXPECT_EQ(screen.ToString(),
+            "        \r\n"
+            "______/ \r\n"
+            "        \r\n"
+            "        ");
+}
+
+TEST(SpinnerTest, Clipped) {
+  auto element = spinner(22, 1);
+  Screen screen(3, 2);
+  Render(screen, element);
+  EXPECT_EQ(screen.ToString(), "   \r\n___");
+}
+
 }  // namespace ftxui
 // NOLINTEND
@@ -0,0 +1,54 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/dom/static_decorator.hpp"
+
+#include "ftxui/dom/elements.hpp"   // for text, bold, inverted, Decorator
+#include "ftxui/dom/node.hpp"       // for Render
+#include "ftxui/screen/screen.hpp"  // for Screen, Pixel
+#include "gtest/gtest.h"  // for Test, EXPECT_TRUE, EXPECT_FALSE, TEST
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+constexpr auto kHighlight = StaticDecorator(bold) | inverted;
+}  // namespace
+
+TEST(StaticDecoratorTest, Compose) {
+  auto element = text("text") | kHighlight;
+  Screen screen(5, 1);
+  Render(screen, element);
+  EXPECT_TRUE(screen.PixelAt(0, 0).bold);
+  EXPECT_TRUE(screen.PixelAt(0, 0).inverted);
+  EXPECT_FALSE(screen.PixelAt(0, 0).dim);
+}
+
+TEST(StaticDecoratorTest, Assign) {
+  auto element = text("text");
+  element |= StaticDecorator(dim);
+  Screen screen(5, 1);
+  Render(screen, element);
+  EXPECT_TRUE(screen.PixelAt(0, 0).dim);
+}
+
+TEST(StaticDecoratorTest, Elements) {
+  Elements elements = {text("a"), text("b")};
+  elements = std::move(elements) | kHighlight;
+  Screen screen(2, 1);
+  Render(screen, hbox(std::move(elements)));
+  EXPECT_TRUE(screen.PixelAt(0, 0).bold);
+  EXPECT_TRUE(screen.PixelAt(1, 0).bold);
+}
+
+TEST(StaticDecoratorTest, ConvertToDecorator) {
+  const Decorator decorator = kHighlight | Decorator(underlined);
+  auto element = text("text") | decorator;
+  Screen screen(5, 1);
+  Render(screen, element);
+  EXPECT_TRUE(screen.PixelAt(0, 0).bold);
+  EXPECT_TRUE(screen.PixelAt(0, 0).underlined);
+}
+
+}  // namespace ftxui
+// NOLINTEND
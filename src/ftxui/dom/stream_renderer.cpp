@@ -0,0 +1,192 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/dom/stream_renderer.hpp"
+
+#include <algorithm>  // for min
+#include <chrono>     // for steady_clock
+#include <cstddef>    // for size_t
+#include <iostream>   // for ostream, cout, flush
+#include <string>     // for string
+#include <utility>    // for move
+#include <vector>     // for vector
+
+#include "ftxui/dom/elements.hpp"     // for Element
+#include "ftxui/dom/node.hpp"         // for Render
+#include "ftxui/screen/pixel.hpp"     // for Pixel
+#include "ftxui/screen/screen.hpp"    // for Screen, Dimension
+#include "ftxui/screen/string.hpp"    // for string_width
+#include "ftxui/screen/terminal.hpp"  // for Size
+
+#if defined(_WIN32)
+#include <io.h>  // for _isatty, _fileno
+#include <cstdio>  // for stdout
+#else
+#include <unistd.h>  // for isatty, STDOUT_FILENO
+#endif
+
+namespace ftxui {
+
+namespace {
+
+bool IsStdoutTerminal() {
+#if defined(_WIN32)
+  return _isatty(_fileno(stdout)) != 0;
+#else
+  return isatty(STDOUT_FILENO) != 0;
+#endif
+}
+
+// The rows of |screen|, as plain text, without the trailing spaces.
+std::vector<std::string> PlainLines(const Screen& screen) {
+  std::vector<std::string> lines(static_cast<size_t>(screen.dimy()));
+  for (int y = 0; y < screen.dimy(); ++y) {
+    std::string& line = lines[size_t(y)];
+    bool previous_fullwidth = false;
+    for (int x = 0; x < screen.dimx(); ++x) {
+      const std::string& character = screen.PixelAt(x, y).character;
+      // The cell following a fullwidth glyph is left empty.
+      if (!previous_fullwidth) {
+        line += character.empty() ? " " : character;
+      }
+      previous_fullwidth = string_width(character) == 2;
+    }
+    line.erase(line.find_last_not_of(' ') + 1);
+  }
+  return lines;
+}
+
+}  // namespace
+
+/// @brief Write frames to |out|.
+/// @param out Where to write the frames.
+/// @param option How to write them.
+StreamRenderer::StreamRenderer(std::ostream& out, StreamRendererOption option)
+    : out_(out), option_(std::move(option)) {
+  switch (option_.mode) {
+    case StreamRendererOption::Mode::Auto:
+      terminal_ = &out_ == &std::cout && IsStdoutTerminal();
+      break;
+    case StreamRendererOption::Mode::Terminal:
+      terminal_ = true;
+      break;
+    case StreamRendererOption::Mode::Plain:
+      terminal_ = false;
+      break;
+  }
+  if (option_.width <= 0) {
+    option_.width = Terminal::Size().dimx;
+  }
+}
+
+StreamRenderer::~StreamRenderer() {
+  Finish();
+}
+
+/// @brief Draw |element|, and write what changed since the previous frame.
+void StreamRenderer::Render(Element element) {
+  finished_ = false;
+  if (terminal_) {
+    RenderTerminal(std::move(element));
+  } else {
+    RenderPlain(std::move(element));
+  }
+}
+
+/// @brief Write the last frame if it was held back, and end it.
+void StreamRenderer::Finish() {
+  if (finished_) {
+    return;
+  }
+  finished_ = true;
+
+  if (terminal_) {
+    if (!frame_.empty()) {
+      out_ << '\n' << std::flush;
+    }
+    frame_.clear();
+    reset_position_.clear();
+    return;
+  }
+
+  if (has_pending_) {
+    // Only the lines changed since the last snapshot are written.
+    size_t first = 0;
+    while (first < std::min(written_.size(), pending_.size()) &&
+           written_[first] == pending_[first]) {
+      ++first;
+    }
+    WritePlain(std::move(pending_), first);
+  }
+  written_.clear();
+  out_ << std::flush;
+}
+
+// private
+void StreamRenderer::RenderTerminal(Element element) {
+  auto screen = Screen::Create(Dimension::Fixed(option_.width),
+                               Dimension::Fit(element));
+  ftxui::Render(screen, element);
+
+  // An unchanged frame isn't drawn again.
+  std::string frame = screen.ToString();
+  if (frame == frame_) {
+    return;
+  }
+  out_ << reset_position_ << frame << std::flush;
+  reset_position_ = screen.ResetPosition();
+  frame_ = std::move(frame);
+}
+
+// private
+void StreamRenderer::RenderPlain(Element element) {
+  auto screen = Screen::Create(
+      Dimension::Fixed(option_.width),
+      Dimension::Fit(element, /*extend_beyond_screen=*/true));
+  ftxui::Render(screen, element);
+  std::vector<std::string> lines = PlainLines(screen);
+
+  size_t first = 0;
+  while (first < std::min(written_.size(), lines.size()) &&
+         written_[first] == lines[first]) {
+    ++first;
+  }
+
+  // Lines appended to the ones written are written at once.
+  if (first == written_.size()) {
+    WritePlain(std::move(lines), first);
+    return;
+  }
+
+  // Nothing new: the frame lost some lines.
+  if (first == lines.size()) {
+    written_ = std::move(lines);
+    has_pending_ = false;
+    return;
+  }
+
+  // Some lines written changed: write them again, but not too often.
+  if (std::chrono::steady_clock::now() - last_write_ >=
+      option_.snapshot_interval) {
+    WritePlain(std::move(lines), first);
+    return;
+  }
+  pending_ = std::move(lines);
+  has_pending_ = true;
+}
+
+// private
+// Write the lines from |first|, and remember them as the ones written.
+void StreamRenderer::WritePlain(std::vector<std::string> lines, size_t first) {
+  for (size_t i = first; i < lines.size(); ++i) {
+    out_ << lines[i] << '\n';
+  }
+  if (first < lines.size()) {
+    out_ << std::flush;
+    last_write_ = std::chrono::steady_clock::now();
+  }
+  written_ = std::move(lines);
+  has_pending_ = false;
+}
+
+}  // namespace ftxui
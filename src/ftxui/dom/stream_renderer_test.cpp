@@ -0,0 +1,84 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <chrono>   // for hours
+#include <sstream>  // for stringstream
+#include <string>   // for string, to_string
+
+#include "ftxui/dom/elements.hpp"         // for text, vbox, Element
+#include "ftxui/dom/stream_renderer.hpp"  // for StreamRenderer
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+StreamRendererOption Plain() {
+  StreamRendererOption option;
+  option.mode = StreamRendererOption::Mode::Plain;
+  option.width = 10;
+  option.snapshot_interval = std::chrono::milliseconds(0);
+  return option;
+}
+}  // namespace
+
+TEST(StreamRendererTest, AppendedLines) {
+  std::stringstream out;
+  StreamRenderer renderer(out, Plain());
+  Elements lines;
+  for (int i = 0; i < 3; ++i) {
+    lines.push_back(text("line " + std::to_string(i)));
+    renderer.Render(vbox(lines));
+  }
+  renderer.Finish();
+
+  // Each line is written once, without escape sequences.
+  EXPECT_EQ(out.str(), "line 0\nline 1\nline 2\n");
+}
+
+TEST(StreamRendererTest, ChangedLines) {
+  std::stringstream out;
+  StreamRenderer renderer(out, Plain());
+  renderer.Render(vbox({text("title"), text("1%")}));
+  renderer.Render(vbox({text("title"), text("1%")}));
+  renderer.Render(vbox({text("title"), text("2%")}));
+  renderer.Finish();
+
+  // Only the line changed is written again.
+  EXPECT_EQ(out.str(), "title\n1%\n2%\n");
+}
+
+TEST(StreamRendererTest, SnapshotInterval) {
+  std::stringstream out;
+  StreamRendererOption option = Plain();
+  option.snapshot_interval = std::chrono::hours(1);
+  StreamRenderer renderer(out, option);
+  for (int i = 0; i <= 100; ++i) {
+    renderer.Render(text(std::to_string(i) + "%"));
+  }
+  EXPECT_EQ(out.str(), "0%\n");
+
+  // The last frame held back is written when finishing.
+  renderer.Finish();
+  EXPECT_EQ(out.str(), "0%\n100%\n");
+}
+
+TEST(StreamRendererTest, Terminal) {
+  std::stringstream out;
+  StreamRendererOption option;
+  option.mode = StreamRendererOption::Mode::Terminal;
+  option.width = 4;
+  {
+    StreamRenderer renderer(out, option);
+    renderer.Render(text("a"));
+    renderer.Render(text("a"));
+    renderer.Render(text("b"));
+  }
+
+  // The second frame is drawn over the first one. The identical one is
+  // skipped.
+  EXPECT_EQ(out.str(), "a   \rb   \n");
+}
+
+}  // namespace ftxui
+// NOLINTEND
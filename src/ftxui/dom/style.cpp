@@ -0,0 +1,142 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/dom/style.hpp"
+
+#include <optional>  // for optional
+#include <utility>   // for move
+
+#include "ftxui/dom/elements.hpp"        // for Element
+#include "ftxui/dom/node.hpp"            // for Node
+#include "ftxui/dom/node_decorator.hpp"  // for NodeDecorator
+#include "ftxui/dom/node_pool.hpp"       // for MakeNode
+#include "ftxui/screen/box.hpp"          // for Box
+#include "ftxui/screen/color.hpp"        // for Color
+#include "ftxui/screen/screen.hpp"       // for Pixel, Screen
+
+namespace ftxui {
+
+namespace {
+
+// Whether the color set by an outer decorator, followed by the one set by an
+// inner decorator, can be expressed as a single color.
+bool CanMergeColor(const std::optional<Color>& inner,
+                   const std::optional<Color>& outer) {
+  if (!inner || !outer) {
+    return true;
+  }
+  return inner->IsOpaque() || outer->IsOpaque();
+}
+
+void MergeColor(std::optional<Color>* inner, const std::optional<Color>& outer) {
+  if (!outer) {
+    return;
+  }
+  if (!*inner) {
+    *inner = outer;
+    return;
+  }
+  // The inner color is painted over the outer one. When it is transparent, and
+  // the outer one is opaque, the result doesn't depend on what is below.
+  if (!(*inner)->IsOpaque()) {
+    *inner = Color::Blend(*outer, **inner);
+  }
+}
+
+void PaintColor(Color& pixel, const Color& color, bool opaque) {
+  pixel = opaque ? color : Color::Blend(pixel, color);
+}
+
+class Style : public NodeDecorator {
+ public:
+  Style(Element child, const PixelStyle& style)
+      : NodeDecorator(std::move(child)), style_(style) {}
+
+  LayoutKind layout_kind() const override { return LayoutKind::kDecorator; }
+
+  // Merge |outer|, applied by a decorator around this one. Return false when
+  // this can't be expressed by a single node.
+  bool Merge(const PixelStyle& outer) {
+    if (!CanMergeColor(style_.foreground, outer.foreground) ||
+        !CanMergeColor(style_.background, outer.background)) {
+      return false;
+    }
+    style_.bold |= outer.bold;
+    style_.strikethrough |= outer.strikethrough;
+    style_.automerge |= outer.automerge;
+    style_.underlined_double |= outer.underlined_double;
+    MergeColor(&style_.foreground, outer.foreground);
+    MergeColor(&style_.background, outer.background);
+
+    style_.blink |= outer.blink;
+    style_.dim |= outer.dim;
+    style_.underlined |= outer.underlined;
+    style_.inverted ^= outer.inverted;
+    return true;
+  }
+
+  void Render(Screen& screen) override {
+    RenderBefore(screen);
+    Node::Render(screen);
+    RenderAfter(screen);
+  }
+
+ private:
+  void RenderBefore(Screen& screen) const {
+    const PixelStyle& s = style_;
+    if (!s.bold && !s.strikethrough && !s.automerge && !s.underlined_double &&
+        !s.foreground && !s.background) {
+      return;
+    }
+    const bool fg_opaque = s.foreground && s.foreground->IsOpaque();
+    const bool bg_opaque = s.background && s.background->IsOpaque();
+    for (int y = box_.y_min; y <= box_.y_max; ++y) {
+      for (int x = box_.x_min; x <= box_.x_max; ++x) {
+        Pixel& pixel = screen.PixelAt(x, y);
+        pixel.bold = pixel.bold || s.bold;
+        pixel.strikethrough = pixel.strikethrough || s.strikethrough;
+        pixel.automerge = pixel.automerge || s.automerge;
+        pixel.underlined_double = pixel.underlined_double || s.underlined_double;
+        if (s.foreground) {
+          PaintColor(pixel.foreground_color, *s.foreground, fg_opaque);
+        }
+        if (s.background) {
+          PaintColor(pixel.background_color, *s.background, bg_opaque);
+        }
+      }
+    }
+  }
+
+  void RenderAfter(Screen& screen) const {
+    const PixelStyle& s = style_;
+    if (!s.blink && !s.dim && !s.underlined && !s.inverted) {
+      return;
+    }
+    for (int y = box_.y_min; y <= box_.y_max; ++y) {
+      for (int x = box_.x_min; x <= box_.x_max; ++x) {
+        Pixel& pixel = screen.PixelAt(x, y);
+        pixel.blink = pixel.blink || s.blink;
+        pixel.dim = pixel.dim || s.dim;
+        pixel.underlined = pixel.underlined || s.underlined;
+        pixel.inverted = pixel.inverted != s.inverted;
+      }
+    }
+  }
+
+  PixelStyle style_;
+};
+
+}  // namespace
+
+Element ApplyStyle(Element child, const PixelStyle& style) {
+  // A shared child may be displayed elsewhere, it can't be modified.
+  if (child.use_count() == 1) {
+    auto* node = dynamic_cast<Style*>(child.get());
+    if (node && node->Merge(style)) {
+      return child;
+    }
+  }
+  return MakeNode<Style>(std::move(child), style);
+}
+
+}  // namespace ftxui
@@ -0,0 +1,40 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_DOM_STYLE_HPP
+#define FTXUI_DOM_STYLE_HPP
+
+#include <optional>  // for optional
+
+#include "ftxui/dom/elements.hpp"  // for Element
+#include "ftxui/screen/color.hpp"  // for Color
+
+namespace ftxui {
+
+// The style set by the decorators like bold, color or inverted. Some are set
+// before rendering the child, others after, as the decorators used to.
+struct PixelStyle {
+  // Set before rendering the child:
+  bool bold = false;
+  bool strikethrough = false;
+  bool automerge = false;
+  bool underlined_double = false;
+  std::optional<Color> foreground;
+  std::optional<Color> background;
+
+  // Set after rendering the child:
+  bool blink = false;
+  bool dim = false;
+  bool underlined = false;
+  bool inverted = false;  // Toggled, instead of set.
+};
+
+// Apply |style| to |child|. When |child| was itself produced by ApplyStyle and
+// isn't shared, the styles are merged into a single node, instead of wrapping
+// it once more. The pixels of the box are then visited once for the whole
+// chain of decorators.
+Element ApplyStyle(Element child, const PixelStyle& style);
+
+}  // namespace ftxui
+
+#endif  // FTXUI_DOM_STYLE_HPP
@@ -0,0 +1,65 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/dom/elements.hpp"   // for operator|, text, bold, color, ...
+#include "ftxui/dom/node.hpp"       // for Render
+#include "ftxui/screen/color.hpp"   // for Color
+#include "ftxui/screen/screen.hpp"  // for Screen, Pixel
+#include "gtest/gtest.h"  // for Test, EXPECT_EQ, EXPECT_TRUE, TEST
+
+// NOLINTBEGIN
+namespace ftxui {
+
+TEST(StyleTest, ChainIsMerged) {
+  auto element = text("text") | bold | color(Color::Red) |
+                 bgcolor(Color::Blue) | underlined | inverted;
+  Screen screen(5, 1);
+  Render(screen, element);
+  const Pixel& pixel = screen.PixelAt(0, 0);
+  EXPECT_TRUE(pixel.bold);
+  EXPECT_TRUE(pixel.underlined);
+  EXPECT_TRUE(pixel.inverted);
+  EXPECT_EQ(pixel.foreground_color, Color(Color::Red));
+  EXPECT_EQ(pixel.background_color, Color(Color::Blue));
+}
+
+TEST(StyleTest, InnerColorWins) {
+  auto element = text("text") | color(Color::Red) | color(Color::Blue);
+  Screen screen(5, 1);
+  Render(screen, element);
+  EXPECT_EQ(screen.PixelAt(0, 0).foreground_color, Color(Color::Red));
+}
+
+TEST(StyleTest, InvertedTwice) {
+  auto element = text("text") | inverted | inverted;
+  Screen screen(5, 1);
+  Render(screen, element);
+  EXPECT_FALSE(screen.PixelAt(0, 0).inverted);
+}
+
+TEST(StyleTest, TransparentColors) {
+  const Color outer = Color::RGBA(255, 0, 0, 128);
+  const Color inner = Color::RGBA(0, 0, 255, 128);
+  auto element = text("text") | bgcolor(inner) | bgcolor(outer);
+
+  const Color below = Color::RGB(0, 255, 0);
+  const Color expected = Color::Blend(Color::Blend(below, outer), inner);
+
+  Screen screen(5, 1);
+  screen.PixelAt(0, 0).background_color = below;
+  Render(screen, element);
+  EXPECT_EQ(screen.PixelAt(0, 0).background_color, expected);
+}
+
+TEST(StyleTest, SharedChildIsNotModified) {
+  auto shared = text("text") | bold;
+  auto element = hbox({shared | inverted, shared});
+  Screen screen(8, 1);
+  Render(screen, element);
+  EXPECT_TRUE(screen.PixelAt(0, 0).inverted);
+  EXPECT_FALSE(screen.PixelAt(4, 0).inverted);
+  EXPECT_TRUE(screen.PixelAt(4, 0).bold);
+}
+
+}  // namespace ftxui
+// NOLINTEND
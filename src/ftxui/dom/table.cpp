@@ -3,12 +3,24 @@
 // the LICENSE file.
 #include "ftxui/dom/table.hpp"
 
-#include <algorithm>  // for max
+#include <algorithm>    // for max, merge, min, stable_sort
+#include <charconv>     // for to_chars
+#include <cmath>        // for isnan
+#include <cstddef>      // for size_t, ptrdiff_t
+#include <cstdint>      // for int64_t
+#include <cstdio>       // for snprintf
+#include <functional>   // for function
 #include <memory>   // for allocator, shared_ptr, allocator_traits<>::value_type
-#include <utility>  // for move, swap
-#include <vector>   // for vector
+#include <string>       // for string
+#include <string_view>  // for string_view
+#include <utility>      // for move, swap
+#include <vector>       // for vector
 
 #include "ftxui/dom/elements.hpp"  // for Element, operator|, text, separatorCharacter, Elements, BorderStyle, Decorator, emptyElement, size, gridbox, EQUAL, flex, flex_shrink, HEIGHT, WIDTH
+#include "ftxui/dom/node.hpp"      // for Node
+#include "ftxui/dom/requirement.hpp"  // for Requirement
+#include "ftxui/dom/worker_pool.hpp"  // for WorkerPool
+#include "ftxui/screen/string.hpp"    // for string_width
 
 namespace ftxui {
 namespace {
@@ -225,6 +237,13 @@ Element Table::Render() {
     for (int x = 0; x < dim_x_; ++x) {
       auto& it = elements_[y][x];
 
+      // The decorations, in the order they were made.
+      for (const Decoration& decoration : decorations_) {
+        if (decoration.Selects(x, y)) {
+          it = decoration.decorator(std::move(it));
+        }
+      }
+
       // Line
       if ((x + y) % 2 == 1) {
         it = std::move(it) | flex;
@@ -243,21 +262,63 @@ Element Table::Render() {
   }
   dim_x_ = 0;
   dim_y_ = 0;
+  decorations_.clear();
   return gridbox(std::move(elements_));
 }
 
+// private
+// Apply the decorations recorded so far, before some elements are replaced.
+// The elements replaced afterward aren't decorated.
+void Table::ApplyDecorations() {
+  for (const Decoration& decoration : decorations_) {
+    for (int y = decoration.y_min; y <= decoration.y_max; ++y) {
+      for (int x = decoration.x_min; x <= decoration.x_max; ++x) {
+        if (decoration.Selects(x, y)) {
+          Element& e = elements_[y][x];
+          e = decoration.decorator(std::move(e));
+        }
+      }
+    }
+  }
+  decorations_.clear();
+}
+
+// private
+bool Table::Decoration::Selects(int x, int y) const {
+  if (x < x_min || x > x_max || y < y_min || y > y_max) {
+    return false;
+  }
+  if ((rows_only || cells_only) && y % 2 == 0) {
+    return false;
+  }
+  if (cells_only && x % 2 == 0) {
+    return false;
+  }
+  if (column_modulo != 0 && (x / 2) % column_modulo != column_shift) {
+    return false;
+  }
+  return row_modulo == 0 || (y / 2) % row_modulo == row_shift;
+}
+
+// private
+// A decoration of every element of the selection.
+Table::Decoration TableSelection::MakeDecoration(Decorator decorator) const {
+  Table::Decoration decoration;
+  decoration.decorator = std::move(decorator);
+  decoration.x_min = x_min_;
+  decoration.x_max = x_max_;
+  decoration.y_min = y_min_;
+  decoration.y_max = y_max_;
+  return decoration;
+}
+
 /// @brief Apply the `decorator` to the selection.
 /// This decorate both the cells, the lines and the corners.
 /// @param decorator The decorator to apply.
 /// @ingroup dom
 // NOLINTNEXTLINE
 void TableSelection::Decorate(Decorator decorator) {
-  for (int y = y_min_; y <= y_max_; ++y) {
-    for (int x = x_min_; x <= x_max_; ++x) {
-      Element& e = table_->elements_[y][x];
-      e = std::move(e) | decorator;
-    }
-  }
+  table_->decorations_.push_back(MakeDecoration(std::move(decorator)));
 }
 
 /// @brief Apply the `decorator` to the selection.
@@ -266,14 +327,9 @@ void TableSelection::Decorate(Decorator decorator) {
 /// @ingroup dom
 // NOLINTNEXTLINE
 void TableSelection::DecorateCells(Decorator decorator) {
-  for (int y = y_min_; y <= y_max_; ++y) {
-    for (int x = x_min_; x <= x_max_; ++x) {
-      if (y % 2 == 1 && x % 2 == 1) {
-        Element& e = table_->elements_[y][x];
-        e = std::move(e) | decorator;
-      }
-    }
-  }
+  Table::Decoration decoration = MakeDecoration(std::move(decorator));
+  decoration.cells_only = true;
+  table_->decorations_.push_back(std::move(decoration));
 }
 
 /// @brief Apply the `decorator` to the selection.
@@ -286,14 +342,11 @@ void TableSelection::DecorateCells(Decorator decorator) {
 void TableSelection::DecorateAlternateColumn(Decorator decorator,
                                              int modulo,
                                              int shift) {
-  for (int y = y_min_; y <= y_max_; ++y) {
-    for (int x = x_min_; x <= x_max_; ++x) {
-      if (y % 2 == 1 && (x / 2) % modulo == shift) {
-        Element& e = table_->elements_[y][x];
-        e = std::move(e) | decorator;
-      }
-    }
-  }
+  Table::Decoration decoration = MakeDecoration(std::move(decorator));
+  decoration.rows_only = true;
+  decoration.column_modulo = modulo;
+  decoration.column_shift = shift;
+  table_->decorations_.push_back(std::move(decoration));
 }
 
 /// @brief Apply the `decorator` to the selection.
@@ -306,14 +359,11 @@ void TableSelection::DecorateAlternateColumn(Decorator decorator,
 void TableSelection::DecorateAlternateRow(Decorator decorator,
                                           int modulo,
                                           int shift) {
-  for (int y = y_min_ + 1; y <= y_max_ - 1; ++y) {
-    for (int x = x_min_; x <= x_max_; ++x) {
-      if (y % 2 == 1 && (y / 2) % modulo == shift) {
-        Element& e = table_->elements_[y][x];
-        e = std::move(e) | decorator;
-      }
-    }
-  }
+  Table::Decoration decoration = MakeDecoration(std::move(decorator));
+  decoration.rows_only = true;
+  decoration.row_modulo = modulo;
+  decoration.row_shift = shift;
+  table_->decorations_.push_back(std::move(decoration));
 }
 
 /// @brief Apply the `decorator` to the selection.
@@ -326,14 +376,11 @@ void TableSelection::DecorateAlternateRow(Decorator decorator,
 void TableSelection::DecorateCellsAlternateColumn(Decorator decorator,
                                                   int modulo,
                                                   int shift) {
-  for (int y = y_min_; y <= y_max_; ++y) {
-    for (int x = x_min_; x <= x_max_; ++x) {
-      if (y % 2 == 1 && x % 2 == 1 && ((x / 2) % modulo == shift)) {
-        Element& e = table_->elements_[y][x];
-        e = std::move(e) | decorator;
-      }
-    }
-  }
+  Table::Decoration decoration = MakeDecoration(std::move(decorator));
+  decoration.cells_only = true;
+  decoration.column_modulo = modulo;
+  decoration.column_shift = shift;
+  table_->decorations_.push_back(std::move(decoration));
 }
 
 /// @brief Apply the `decorator` to the selection.
@@ -346,20 +393,18 @@ void TableSelection::DecorateCellsAlternateColumn(Decorator decorator,
 void TableSelection::DecorateCellsAlternateRow(Decorator decorator,
                                                int modulo,
                                                int shift) {
-  for (int y = y_min_; y <= y_max_; ++y) {
-    for (int x = x_min_; x <= x_max_; ++x) {
-      if (y % 2 == 1 && x % 2 == 1 && ((y / 2) % modulo == shift)) {
-        Element& e = table_->elements_[y][x];
-        e = std::move(e) | decorator;
-      }
-    }
-  }
+  Table::Decoration decoration = MakeDecoration(std::move(decorator));
+  decoration.cells_only = true;
+  decoration.row_modulo = modulo;
+  decoration.row_shift = shift;
+  table_->decorations_.push_back(std::move(decoration));
 }
 
 /// @brief Apply a `border` around the selection.
 /// @param border The border style to apply.
 /// @ingroup dom
 void TableSelection::Border(BorderStyle border) {
+  table_->ApplyDecorations();
   BorderLeft(border);
   BorderRight(border);
   BorderTop(border);
@@ -379,6 +424,7 @@ void TableSelection::Border(BorderStyle border) {
 /// @param border The border style to apply.
 /// @ingroup dom
 void TableSelection::Separator(BorderStyle border) {
+  table_->ApplyDecorations();
   for (int y = y_min_ + 1; y <= y_max_ - 1; ++y) {
     for (int x = x_min_ + 1; x <= x_max_ - 1; ++x) {
       if (y % 2 == 0 || x % 2 == 0) {
@@ -395,6 +441,7 @@ void TableSelection::Separator(BorderStyle border) {
 /// @param border The border style to apply.
 /// @ingroup dom
 void TableSelection::SeparatorVertical(BorderStyle border) {
+  table_->ApplyDecorations();
   for (int y = y_min_ + 1; y <= y_max_ - 1; ++y) {
     for (int x = x_min_ + 1; x <= x_max_ - 1; ++x) {
       if (x % 2 == 0) {
@@ -409,6 +456,7 @@ void TableSelection::SeparatorVertical(BorderStyle border) {
 /// @param border The border style to apply.
 /// @ingroup dom
 void TableSelection::SeparatorHorizontal(BorderStyle border) {
+  table_->ApplyDecorations();
   for (int y = y_min_ + 1; y <= y_max_ - 1; ++y) {
     for (int x = x_min_ + 1; x <= x_max_ - 1; ++x) {
       if (y % 2 == 0) {
@@ -423,6 +471,7 @@ void TableSelection::SeparatorHorizontal(BorderStyle border) {
 /// @param border The border style to apply.
 /// @ingroup dom
 void TableSelection::BorderLeft(BorderStyle border) {
+  table_->ApplyDecorations();
   for (int y = y_min_; y <= y_max_; y++) {
     table_->elements_[y][x_min_] =
         separatorCharacter(charset[border][5]) | automerge;  // NOLINT
@@ -433,6 +482,7 @@ void TableSelection::BorderLeft(BorderStyle border) {
 /// @param border The border style to apply.
 /// @ingroup dom
 void TableSelection::BorderRight(BorderStyle border) {
+  table_->ApplyDecorations();
   for (int y = y_min_; y <= y_max_; y++) {
     table_->elements_[y][x_max_] =
         separatorCharacter(charset[border][5]) | automerge;  // NOLINT
@@ -443,6 +493,7 @@ void TableSelection::BorderRight(BorderStyle border) {
 /// @param border The border style to apply.
 /// @ingroup dom
 void TableSelection::BorderTop(BorderStyle border) {
+  table_->ApplyDecorations();
   for (int x = x_min_; x <= x_max_; x++) {
     table_->elements_[y_min_][x] =
         separatorCharacter(charset[border][4]) | automerge;  // NOLINT
@@ -453,10 +504,425 @@ void TableSelection::BorderTop(BorderStyle border) {
 /// @param border The border style to apply.
 /// @ingroup dom
 void TableSelection::BorderBottom(BorderStyle border) {
+  table_->ApplyDecorations();
   for (int x = x_min_; x <= x_max_; x++) {
     table_->elements_[y_max_][x] =
         separatorCharacter(charset[border][4]) | automerge;  // NOLINT
   }
 }
 
+/// @brief A column of strings, stored back to back in |arena|.
+/// @param arena The characters of every cell.
+/// @param offsets The |rows| + 1 positions in |arena| where the cells start.
+/// The cell at row i is [offsets[i], offsets[i + 1]).
+/// @param rows The number of cells.
+/// @ingroup dom
+TableColumn TableColumn::Strings(std::string_view arena,
+                                 const size_t* offsets,
+                                 int rows) {
+  TableColumn column;
+  column.type_ = Type::Strings;
+  column.rows_ = rows;
+  column.arena_ = arena;
+  column.offsets_ = offsets;
+  return column;
+}
+
+/// @brief A column of integers, formatted when displayed.
+/// @param values The |rows| values.
+/// @param rows The number of cells.
+/// @ingroup dom
+TableColumn TableColumn::Integers(const int64_t* values, int rows) {
+  TableColumn column;
+  column.type_ = Type::Integers;
+  column.rows_ = rows;
+  column.integers_ = values;
+  return column;
+}
+
+/// @brief A column of floating point numbers, formatted when displayed.
+/// @param values The |rows| values.
+/// @param rows The number of cells.
+/// @param precision The number of digits after the decimal point.
+/// @ingroup dom
+TableColumn TableColumn::Doubles(const double* values,
+                                 int rows,
+                                 int precision) {
+  TableColumn column;
+  column.type_ = Type::Doubles;
+  column.rows_ = rows;
+  column.doubles_ = values;
+  column.precision_ = precision;
+  return column;
+}
+
+/// @brief The text of the cell at |row|.
+/// @param row The row, within [0, RowCount()).
+/// @param buffer Where the numbers are formatted. Reuse it from one call to the
+/// next to avoid allocating.
+/// @return A view of the arena for the strings, of |buffer| for the numbers.
+/// @ingroup dom
+std::string_view TableColumn::Format(int row, std::string& buffer) const {
+  char digits[64];  // NOLINT
+  switch (type_) {
+    case Type::Strings:
+      return arena_.substr(offsets_[row], offsets_[row + 1] - offsets_[row]);
+    case Type::Integers: {
+      const auto result =
+          std::to_chars(digits, digits + sizeof(digits), integers_[row]);
+      buffer.assign(digits, result.ptr);
+      return buffer;
+    }
+    case Type::Doubles: {
+      const int size = std::snprintf(digits, sizeof(digits), "%.*f",
+                                     precision_, doubles_[row]);
+      buffer.assign(digits, size_t(std::max(0, std::min(size, 63))));
+      return buffer;
+    }
+  }
+  return {};
+}
+
+namespace {
+
+// The rows sorted in chunks concurrently, then merged pairwise, a round of
+// merges at a time. std::merge() is stable: so is the whole sort.
+template <typename Less>
+void ParallelStableSort(std::vector<int>& rows, Less less, WorkerPool* pool) {
+  constexpr size_t kChunk = 1 << 14;  // NOLINT
+  if (!pool) {
+    pool = WorkerPool::Current();
+  }
+  if (!pool || pool->size() == 0 || rows.size() <= kChunk) {
+    std::stable_sort(rows.begin(), rows.end(), less);
+    return;
+  }
+
+  const size_t size = rows.size();
+  const auto at = [&](std::vector<int>& v, size_t i) {
+    return v.begin() + std::ptrdiff_t(std::min(i, size));
+  };
+  pool->ParallelFor((size + kChunk - 1) / kChunk, [&](size_t i) {
+    std::stable_sort(at(rows, i * kChunk), at(rows, (i + 1) * kChunk), less);
+  });
+
+  std::vector<int> merged(size);
+  for (size_t width = kChunk; width < size; width *= 2) {
+    pool->ParallelFor((size + 2 * width - 1) / (2 * width), [&](size_t i) {
+      const size_t first = i * 2 * width;
+      std::merge(at(rows, first), at(rows, first + width),
+                 at(rows, first + width), at(rows, first + 2 * width),
+                 at(merged, first), less);
+    });
+    rows.swap(merged);
+  }
+}
+
+}  // namespace
+
+/// @brief Sort the rows of a table by the cells of |column|.
+/// @param rows The rows to sort, like the ones returned by FilterRows().
+/// @param column The column whose cells are compared: the strings by their
+/// bytes, the numbers by their value. NaN comes last.
+/// @param ascending Whether the smallest cells come first.
+/// @param pool The threads sorting. By default, the pool running the calling
+/// thread, if any.
+/// @return |rows|, sorted. The rows whose cells are equal keep their order.
+/// @ingroup dom
+/// @see VirtualTable::RowOrder
+std::vector<int> SortRows(std::vector<int> rows,
+                          const TableColumn& column,
+                          bool ascending,
+                          WorkerPool* pool) {
+  auto sort = [&](auto less) {
+    if (ascending) {
+      ParallelStableSort(rows, less, pool);
+    } else {
+      ParallelStableSort(
+          rows, [&](int a, int b) { return less(b, a); }, pool);
+    }
+  };
+  switch (column.type_) {
+    case TableColumn::Type::Strings:
+      sort([&](int a, int b) {
+        const size_t* offsets = column.offsets_;
+        return column.arena_.substr(offsets[a], offsets[a + 1] - offsets[a]) <
+               column.arena_.substr(offsets[b], offsets[b + 1] - offsets[b]);
+      });
+      break;
+    case TableColumn::Type::Integers:
+      sort([&](int a, int b) {
+        return column.integers_[a] < column.integers_[b];
+      });
+      break;
+    case TableColumn::Type::Doubles:
+      sort([&](int a, int b) {
+        const double x = column.doubles_[a];
+        const double y = column.doubles_[b];
+        return !std::isnan(x) && (std::isnan(y) || x < y);
+      });
+      break;
+  }
+  return rows;
+}
+
+/// @brief Sort the rows of a table with a comparison function.
+/// @param rows The rows to sort, like the ones returned by FilterRows().
+/// @param less Whether the row |a| comes before the row |b|. It is called
+/// concurrently.
+/// @param pool The threads sorting. By default, the pool running the calling
+/// thread, if any.
+/// @return |rows|, sorted. The rows equal to each other keep their order.
+/// @ingroup dom
+/// @see VirtualTable::RowOrder
+std::vector<int> SortRows(std::vector<int> rows,
+                          const std::function<bool(int a, int b)>& less,
+                          WorkerPool* pool) {
+  ParallelStableSort(rows, std::cref(less), pool);
+  return rows;
+}
+
+/// @brief The rows of a table to keep.
+/// @param count The number of rows of the model.
+/// @param keep Whether to keep a row. It is called concurrently.
+/// @param pool The threads filtering. By default, the pool running the calling
+/// thread, if any.
+/// @return The rows kept, in increasing order.
+/// @ingroup dom
+/// @see VirtualTable::RowOrder
+std::vector<int> FilterRows(int count,
+                            const std::function<bool(int row)>& keep,
+                            WorkerPool* pool) {
+  constexpr int kChunk = 1 << 14;  // NOLINT
+  if (!pool) {
+    pool = WorkerPool::Current();
+  }
+  count = std::max(0, count);
+  const int chunks = (count + kChunk - 1) / kChunk;
+  std::vector<std::vector<int>> kept(size_t(std::max(1, chunks)));
+  const auto filter = [&](size_t chunk) {
+    const int end = std::min(count, int(chunk + 1) * kChunk);
+    for (int row = int(chunk) * kChunk; row < end; ++row) {
+      if (keep(row)) {
+        kept[chunk].push_back(row);
+      }
+    }
+  };
+  if (pool && chunks > 1) {
+    pool->ParallelFor(size_t(chunks), filter);
+  } else {
+    for (int chunk = 0; chunk < chunks; ++chunk) {
+      filter(size_t(chunk));
+    }
+  }
+
+  std::vector<int> rows = std::move(kept[0]);
+  for (size_t chunk = 1; chunk < kept.size(); ++chunk) {
+    rows.insert(rows.end(), kept[chunk].begin(), kept[chunk].end());
+  }
+  return rows;
+}
+
+/// @brief Create a table producing its rows on demand.
+/// @param columns The number of columns.
+/// @param rows A function returning the number of rows.
+/// @param cell A function producing the cell at a given column and row. It is
+/// called only for the rows rendered.
+/// @ingroup dom
+VirtualTable::VirtualTable(int columns, std::function<int()> rows, Cell cell)
+    : columns_(columns), rows_(std::move(rows)), cell_(std::move(cell)) {}
+
+/// @brief Create a table reading its cells from |columns|, borrowed from the
+/// caller. Only the cells rendered or measured are formatted.
+/// @param columns The columns. The table has as many rows as the shortest.
+/// @ingroup dom
+VirtualTable::VirtualTable(std::vector<TableColumn> columns)
+    : columns_(int(columns.size())), data_(std::move(columns)) {}
+
+/// @brief Provide the width of every column.
+/// @param width A function returning the width of a column.
+/// This avoids the width of the columns to depend on the rows displayed, and
+/// to vary while scrolling.
+/// @ingroup dom
+void VirtualTable::ColumnWidths(ColumnWidth width) {
+  column_width_ = std::move(width);
+  measure_ = false;
+  InvalidateColumnWidths();
+}
+
+/// @brief Use the largest width of every cell of each column.
+/// The widths are cached. When rows are appended, only the new rows are
+/// measured.
+/// @see InvalidateColumnWidths
+/// @ingroup dom
+void VirtualTable::MeasureColumnWidths() {
+  SampleColumnWidths(0);
+}
+
+/// @brief Estimate the width of the columns from |sample_size| rows, evenly
+/// spread over the table. The rows appended afterward are measured
+/// incrementally, like with MeasureColumnWidths().
+/// @param sample_size The number of rows to measure. 0 measures every rows.
+/// @see InvalidateColumnWidths
+/// @ingroup dom
+void VirtualTable::SampleColumnWidths(int sample_size) {
+  column_width_ = nullptr;
+  measure_ = true;
+  sample_size_ = std::max(0, sample_size);
+  InvalidateColumnWidths();
+}
+
+/// @brief Drop the cached column widths. They are measured again on the next
+/// render. Call this when existing rows are modified or removed.
+/// @ingroup dom
+void VirtualTable::InvalidateColumnWidths() {
+  measured_widths_.clear();
+  measured_rows_ = 0;
+}
+
+/// @brief The width of a column, as used for rendering.
+/// @param column The column index.
+/// @return The width of the column, or -1 if the column has no fixed width.
+/// @ingroup dom
+int VirtualTable::ColumnWidthAt(int column) const {
+  if (column_width_) {
+    return column_width_(column);
+  }
+  if (!measure_ || column < 0 || column >= columns_) {
+    return -1;
+  }
+  UpdateColumnWidths();
+  return measured_widths_[column];
+}
+
+void VirtualTable::UpdateColumnWidths() const {
+  const int total = RowCount();
+  if (total < measured_rows_) {
+    // Rows were removed. Measure again.
+    measured_widths_.clear();
+    measured_rows_ = 0;
+  }
+
+  if (measured_widths_.empty()) {
+    measured_widths_.assign(columns_, 0);
+    if (sample_size_ != 0 && sample_size_ < total) {
+      for (int i = 0; i < sample_size_; ++i) {
+        MeasureRow(int(int64_t(i) * total / sample_size_));
+      }
+      measured_rows_ = total;
+    }
+  }
+
+  for (; measured_rows_ < total; ++measured_rows_) {
+    MeasureRow(measured_rows_);
+  }
+}
+
+void VirtualTable::MeasureRow(int row) const {
+  row = ModelRow(row);
+  // The columns of text are measured without building elements.
+  if (!data_.empty()) {
+    std::string buffer;
+    for (int column = 0; column < columns_; ++column) {
+      measured_widths_[column] =
+          std::max(measured_widths_[column],
+                   string_width(data_[column].Format(row, buffer)));
+    }
+    return;
+  }
+  for (int column = 0; column < columns_; ++column) {
+    Element cell = cell_(column, row);
+    cell->ComputeRequirement();
+    measured_widths_[column] =
+        std::max(measured_widths_[column], cell->requirement().min_x);
+  }
+}
+
+/// @brief Decorate the rows rendered.
+/// @param decorator A function decorating the Table made of the rows rendered.
+/// It receives the index of the first row of the slice, to align alternating
+/// decorations on the whole table.
+/// @ingroup dom
+void VirtualTable::Decorate(Decorator decorator) {
+  decorator_ = std::move(decorator);
+}
+
+/// @brief Display the rows of the model in the order of |rows|.
+/// @param rows The indices of the rows of the model to display, in order. Null
+/// to display all of them.
+/// The order is replaced at once, and never modified by the table. Compute the
+/// next one in the background, with SortRows() and FilterRows(), and set it
+/// from the thread rendering the table, like with the |on_done| closure of
+/// ScreenInteractive::RunInBackground(). The previous order is rendered until
+/// then.
+/// @ingroup dom
+void VirtualTable::RowOrder(std::shared_ptr<const std::vector<int>> rows) {
+  order_ = std::move(rows);
+  InvalidateColumnWidths();
+}
+
+/// @brief The number of rows of the table.
+/// @ingroup dom
+int VirtualTable::RowCount() const {
+  if (order_) {
+    return int(order_->size());
+  }
+  if (!data_.empty()) {
+    int rows = data_[0].RowCount();
+    for (const TableColumn& column : data_) {
+      rows = std::min(rows, column.RowCount());
+    }
+    return rows;
+  }
+  return rows_ ? rows_() : 0;
+}
+
+Element VirtualTable::MakeCell(int column, int row) const {
+  row = ModelRow(row);
+  if (!data_.empty()) {
+    std::string buffer;
+    return text(std::string(data_[column].Format(row, buffer)));
+  }
+  return cell_(column, row);
+}
+
+/// @brief Render a range of rows of the table.
+/// @param first_row The first row to render.
+/// @param row_count The number of rows to render.
+/// @return The rendered rows. This is an element you can draw.
+/// @ingroup dom
+Element VirtualTable::Render(int first_row, int row_count) const {
+  const int total = RowCount();
+  first_row = std::max(0, std::min(first_row, total - 1));
+  const int last_row = std::min(first_row + std::max(0, row_count), total);
+
+  std::vector<int> widths(columns_, -1);
+  if (column_width_ || measure_) {
+    for (int column = 0; column < columns_; ++column) {
+      widths[column] = ColumnWidthAt(column);
+    }
+  }
+
+  std::vector<std::vector<Element>> input;
+  input.reserve(std::max(0, last_row - first_row));
+  for (int row = first_row; row < last_row; ++row) {
+    std::vector<Element> cells;
+    cells.reserve(columns_);
+    for (int column = 0; column < columns_; ++column) {
+      Element cell = MakeCell(column, row);
+      if (widths[column] >= 0) {
+        cell = std::move(cell) | size(WIDTH, EQUAL, widths[column]);
+      }
+      cells.push_back(std::move(cell));
+    }
+    input.push_back(std::move(cells));
+  }
+
+  Table slice(std::move(input));
+  if (decorator_ && last_row > first_row) {
+    decorator_(slice, first_row);
+  }
+  return slice.Render();
+}
+
 }  // namespace ftxui
@@ -2,10 +2,18 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 #include <gtest/gtest.h>
+#include <algorithm>  // for stable_sort
+#include <cmath>      // for nan
+#include <cstdint>    // for int64_t, uint32_t
+#include <future>     // for promise
+#include <memory>     // for make_shared
+#include <string>     // for string
+#include <vector>     // for vector
 
 #include "ftxui/dom/elements.hpp"  // for LIGHT, flex, center, EMPTY, DOUBLE
 #include "ftxui/dom/node.hpp"      // for Render
 #include "ftxui/dom/table.hpp"
+#include "ftxui/dom/worker_pool.hpp"  // for WorkerPool
 #include "ftxui/screen/screen.hpp"  // for Screen
 
 // NOLINTBEGIN
@@ -745,5 +753,290 @@ TEST(TableTest, Issue912) {
   });
 }
 
+TEST(TableTest, VirtualTable) {
+  std::vector<std::vector<std::string>> rows;
+  for (int i = 0; i < 1000; ++i) {
+    rows.push_back({std::to_string(i), std::to_string(i * i)});
+  }
+
+  int requested = 0;
+  auto table = VirtualTable(
+      2, [&] { return int(rows.size()); },
+      [&](int column, int row) {
+        requested++;
+        return text(rows[row][column]);
+      });
+  table.ColumnWidths([](int column) { return column == 0 ? 4 : 6; });
+  table.Decorate([](Table& slice, int /*first_row*/) {
+    slice.SelectAll().Border(LIGHT);
+    slice.SelectColumn(0).BorderRight(LIGHT);
+  });
+  EXPECT_EQ(table.RowCount(), 1000);
+
+  Screen screen(13, 5);
+  Render(screen, table.Render(500, 3));
+  EXPECT_EQ(requested, 6);
+  EXPECT_EQ(
+      "┌────┼──────┐\r\n"
+      "│500 │250000│\r\n"
+      "│501 │251001│\r\n"
+      "│502 │252004│\r\n"
+      "└────┼──────┘",
+      screen.ToString());
+}
+
+TEST(TableTest, VirtualTableColumns) {
+  const std::string names = "AliceBob测试";
+  const std::vector<size_t> offsets = {0, 5, 8, 14};
+  const std::vector<int64_t> ages = {31, -4, 1000000};
+  const std::vector<double> scores = {1.5, 2.25, 10};
+
+  auto table = VirtualTable({
+      TableColumn::Strings(names, offsets.data(), 3),
+      TableColumn::Integers(ages.data(), 3),
+      TableColumn::Doubles(scores.data(), 2, 1),
+  });
+  table.MeasureColumnWidths();
+  EXPECT_EQ(table.RowCount(), 2);
+  EXPECT_EQ(table.ColumnWidthAt(0), 5);
+  EXPECT_EQ(table.ColumnWidthAt(1), 2);
+  EXPECT_EQ(table.ColumnWidthAt(2), 3);
+
+  Screen screen(10, 2);
+  Render(screen, table.Render(0, 2));
+  EXPECT_EQ(
+      "Alice311.5\r\n"
+      "Bob  -42.2",
+      screen.ToString());
+
+  std::string buffer;
+  EXPECT_EQ(TableColumn::Strings(names, offsets.data(), 3).Format(2, buffer),
+            "测试");
+  EXPECT_EQ(TableColumn::Integers(ages.data(), 3).Format(2, buffer),
+            "1000000");
+}
+
+TEST(TableTest, SortRows) {
+  const std::string names = "bobalicecarolbob";
+  const std::vector<size_t> offsets = {0, 3, 8, 13, 16};
+  const std::vector<int64_t> ages = {31, -4, 31, 7};
+  const double nan = std::nan("");
+  const std::vector<double> scores = {nan, 2.5, -1, 2.5};
+  const std::vector<int> all = {0, 1, 2, 3};
+
+  const auto names_column = TableColumn::Strings(names, offsets.data(), 4);
+  const auto ages_column = TableColumn::Integers(ages.data(), 4);
+  const auto scores_column = TableColumn::Doubles(scores.data(), 4);
+  EXPECT_EQ(SortRows(all, names_column), std::vector<int>({1, 0, 3, 2}));
+  EXPECT_EQ(SortRows(all, names_column, false),
+            std::vector<int>({2, 0, 3, 1}));
+  EXPECT_EQ(SortRows(all, ages_column), std::vector<int>({1, 3, 0, 2}));
+  EXPECT_EQ(SortRows(all, ages_column, false), std::vector<int>({0, 2, 3, 1}));
+  EXPECT_EQ(SortRows(all, scores_column), std::vector<int>({2, 1, 3, 0}));
+  EXPECT_EQ(SortRows({3, 1}, scores_column), std::vector<int>({3, 1}));
+  EXPECT_EQ(SortRows(all, [](int a, int b) { return a % 2 < b % 2; }),
+            std::vector<int>({0, 2, 1, 3}));
+  EXPECT_EQ(FilterRows(4, [&](int row) { return ages[row] > 0; }),
+            std::vector<int>({0, 2, 3}));
+}
+
+TEST(TableTest, SortRowsParallel) {
+  // Enough rows to be sorted and filtered in several chunks.
+  std::vector<int64_t> values(100000);
+  uint32_t seed = 1;
+  for (auto& value : values) {
+    seed = seed * 1103515245 + 12345;
+    value = (seed >> 16) % 1000;
+  }
+  const auto column = TableColumn::Integers(values.data(), int(values.size()));
+  auto keep = [&](int row) { return values[row] % 3 != 0; };
+
+  std::vector<int> expected;
+  for (int row = 0; row < int(values.size()); ++row) {
+    if (keep(row)) {
+      expected.push_back(row);
+    }
+  }
+  WorkerPool pool(3);
+  const std::vector<int> kept = FilterRows(int(values.size()), keep, &pool);
+  EXPECT_EQ(kept, expected);
+
+  std::stable_sort(expected.begin(), expected.end(), [&](int a, int b) {
+    return values[a] > values[b];
+  });
+  EXPECT_EQ(SortRows(kept, column, false, &pool), expected);
+
+  // From a task of the pool, the pool is used by default.
+  std::promise<std::vector<int>> sorted;
+  std::promise<WorkerPool*> current;
+  pool.Run([&] {
+    current.set_value(WorkerPool::Current());
+    sorted.set_value(SortRows(kept, column, false));
+  });
+  EXPECT_EQ(current.get_future().get(), &pool);
+  EXPECT_EQ(sorted.get_future().get(), expected);
+  EXPECT_EQ(WorkerPool::Current(), nullptr);
+}
+
+TEST(TableTest, VirtualTableRowOrder) {
+  const std::string names = "AliceBobCarol";
+  const std::vector<size_t> offsets = {0, 5, 8, 13};
+  auto table = VirtualTable({TableColumn::Strings(names, offsets.data(), 3)});
+  table.MeasureColumnWidths();
+  EXPECT_EQ(table.ColumnWidthAt(0), 5);
+
+  table.RowOrder(std::make_shared<std::vector<int>>(std::vector<int>{2, 1}));
+  EXPECT_EQ(table.RowCount(), 2);
+  Screen screen(5, 3);
+  Render(screen, table.Render(0, 3));
+  EXPECT_EQ(
+      "Carol\r\n"
+      "Bob  \r\n"
+      "     ",
+      screen.ToString());
+
+  table.RowOrder(nullptr);
+  EXPECT_EQ(table.RowCount(), 3);
+}
+
+TEST(TableTest, VirtualTableClamp) {
+  auto table = VirtualTable(
+      1, [] { return 3; },
+      [](int /*column*/, int row) { return text(std::to_string(row)); });
+
+  Screen screen(3, 3);
+  Render(screen, table.Render(2, 10));
+  EXPECT_EQ(
+      "2  \r\n"
+      "   \r\n"
+      "   ",
+      screen.ToString());
+
+  auto empty = VirtualTable(
+      1, [] { return 0; },
+      [](int /*column*/, int /*row*/) { return text("x"); });
+  Render(screen, empty.Render(0, 10));
+}
+
+TEST(TableTest, VirtualTableAlternateRow) {
+  std::vector<std::vector<std::string>> rows = {
+      {"a"}, {"b"}, {"c"}, {"d"}, {"e"},
+  };
+  auto decorate = [](Table& table, int first_row) {
+    table.SelectAll().DecorateCellsAlternateRow(inverted, 2, first_row % 2);
+  };
+  auto table = VirtualTable(
+      1, [&] { return int(rows.size()); },
+      [&](int /*column*/, int row) { return text(rows[row][0]); });
+  table.Decorate(decorate);
+
+  // Rendering the slice [1,4) must look like rows [1,4) of the whole table.
+  Table full(rows);
+  decorate(full, 0);
+  Screen expected(1, 5);
+  Render(expected, full.Render());
+
+  Screen screen(1, 3);
+  Render(screen, table.Render(1, 3));
+  for (int y = 0; y < 3; ++y) {
+    EXPECT_EQ(screen.PixelAt(0, y).character,
+              expected.PixelAt(0, y + 1).character);
+    EXPECT_EQ(screen.PixelAt(0, y).inverted,
+              expected.PixelAt(0, y + 1).inverted);
+  }
+}
+
+TEST(TableTest, VirtualTableMeasureColumnWidths) {
+  std::vector<std::string> rows = {"a", "bbb", "cc"};
+  int requested = 0;
+  auto table = VirtualTable(
+      1, [&] { return int(rows.size()); },
+      [&](int /*column*/, int row) {
+        requested++;
+        return text(rows[row]);
+      });
+  table.MeasureColumnWidths();
+  EXPECT_EQ(table.ColumnWidthAt(0), 3);
+  EXPECT_EQ(requested, 3);
+
+  // The width is cached.
+  Screen screen(5, 1);
+  Render(screen, table.Render(0, 1) | border);
+  EXPECT_EQ(table.ColumnWidthAt(0), 3);
+  EXPECT_EQ(requested, 4);
+
+  // Only the appended rows are measured.
+  rows.push_back("ddddd");
+  EXPECT_EQ(table.ColumnWidthAt(0), 5);
+  EXPECT_EQ(requested, 5);
+
+  table.InvalidateColumnWidths();
+  rows[3] = "d";
+  EXPECT_EQ(table.ColumnWidthAt(0), 3);
+  EXPECT_EQ(requested, 9);
+}
+
+TEST(TableTest, VirtualTableSampleColumnWidths) {
+  int requested = 0;
+  auto table = VirtualTable(
+      2, [&] { return 100000; },
+      [&](int column, int row) {
+        requested++;
+        return text(std::string(column == 0 ? 1 : 1 + row % 7, 'x'));
+      });
+  table.SampleColumnWidths(10);
+  EXPECT_EQ(table.ColumnWidthAt(0), 1);
+  EXPECT_EQ(table.ColumnWidthAt(1), 7);
+  EXPECT_EQ(requested, 20);
+
+  Screen screen(8, 2);
+  Render(screen, table.Render(0, 2));
+  EXPECT_EQ(
+      "xx      \r\n"
+      "xxx     ",
+      screen.ToString());
+}
+
+TEST(TableTest, DecorationOrder) {
+  auto table = Table({
+      {"a", "b"},
+      {"c", "d"},
+  });
+  // Applied before the border replaces the lines: they aren't inverted.
+  table.SelectAll().Decorate(inverted);
+  table.SelectAll().Border(LIGHT);
+  // Applied after: the second row, its cells and its lines, are bold.
+  table.SelectAll().DecorateAlternateRow(bold, 2, 1);
+  table.SelectAll().DecorateCellsAlternateColumn(underlined, 2, 0);
+  Screen screen(4, 4);
+  Render(screen, table.Render());
+  EXPECT_EQ(screen.PixelAt(0, 0).character, "┌");
+  EXPECT_EQ(screen.PixelAt(2, 2).character, "d");
+
+  EXPECT_FALSE(screen.PixelAt(0, 0).inverted);
+  EXPECT_FALSE(screen.PixelAt(0, 1).inverted);
+  EXPECT_TRUE(screen.PixelAt(1, 1).inverted);
+  EXPECT_TRUE(screen.PixelAt(2, 2).inverted);
+
+  EXPECT_FALSE(screen.PixelAt(1, 1).bold);
+  EXPECT_TRUE(screen.PixelAt(1, 2).bold);
+  EXPECT_TRUE(screen.PixelAt(0, 2).bold);
+  EXPECT_FALSE(screen.PixelAt(0, 3).bold);
+
+  EXPECT_TRUE(screen.PixelAt(1, 1).underlined);
+  EXPECT_TRUE(screen.PixelAt(1, 2).underlined);
+  EXPECT_FALSE(screen.PixelAt(2, 1).underlined);
+}
+
+TEST(TableTest, VirtualTableExplicitColumnWidths) {
+  auto table = VirtualTable(
+      2, [] { return 2; },
+      [](int /*column*/, int /*row*/) { return text("x"); });
+  EXPECT_EQ(table.ColumnWidthAt(0), -1);
+  table.ColumnWidths([](int column) { return column + 2; });
+  EXPECT_EQ(table.ColumnWidthAt(0), 2);
+  EXPECT_EQ(table.ColumnWidthAt(1), 3);
+}
+
 }  // namespace ftxui
 // NOLINTEND
@@ -1,7 +1,8 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <algorithm>  // for min
+#include <algorithm>  // for all_of, min
+#include <cstddef>    // for size_t
 #include <memory>     // for make_shared
 #include <string>     // for string, wstring
 #include <utility>    // for move
@@ -9,10 +10,11 @@
 #include "ftxui/dom/deprecated.hpp"   // for text, vtext
 #include "ftxui/dom/elements.hpp"     // for Element, text, vtext
 #include "ftxui/dom/node.hpp"         // for Node
+#include "ftxui/dom/node_pool.hpp"    // for MakeNode
 #include "ftxui/dom/requirement.hpp"  // for Requirement
 #include "ftxui/screen/box.hpp"       // for Box
 #include "ftxui/screen/screen.hpp"    // for Pixel, Screen
-#include "ftxui/screen/string.hpp"  // for string_width, Utf8ToGlyphs, to_string
+#include "ftxui/screen/string.hpp"  // for string_width, GlyphRange, to_string
 
 namespace ftxui {
 
@@ -24,30 +26,77 @@ class Text : public Node {
   explicit Text(std::string text) : text_(std::move(text)) {}
 
   void ComputeRequirement() override {
-    requirement_.min_x = string_width(text_);
+    Measure();
+    requirement_.min_x = width_;
     requirement_.min_y = 1;
   }
 
   void Render(Screen& screen) override {
-    int x = box_.x_min;
     const int y = box_.y_min;
     if (y > box_.y_max) {
       return;
     }
-    for (const auto& cell : Utf8ToGlyphs(text_)) {
-      if (x > box_.x_max) {
+    Measure();
+    // The cells of the text left visible by the box and the stencil.
+    const Image::PixelRow row = screen.ClippedRow(
+        box_.x_min, std::min(box_.x_max, box_.x_min + width_ - 1), y);
+    if (row.empty()) {
+      return;
+    }
+    if (ascii_) {
+      // One cell per byte: nothing to decode.
+      const char* c = text_.data() + (row.x_min - box_.x_min);
+      for (Pixel& pixel : row) {
+        pixel.character.assign(1, *c++);
+      }
+      return;
+    }
+    int x = box_.x_min;
+    for (const Glyph& glyph : GlyphRange(text_)) {
+      if (x > row.x_max) {
         return;
       }
-      if (cell == "\n") {
+      if (glyph.text == "\n") {
         continue;
       }
-      screen.PixelAt(x, y).character = cell;
+      if (x >= row.x_min) {
+        row[x].character = glyph.text;
+      }
       ++x;
+
+      // Fullwidth glyphs take two cells. The second is left empty.
+      if (glyph.width == 2) {
+        if (x > row.x_max) {
+          return;
+        }
+        if (x >= row.x_min) {
+          row[x].character.clear();
+        }
+        ++x;
+      }
     }
   }
 
+  size_t TextBytes() const override { return text_.size(); }
+
  private:
+  // Measure the text once. It is laid out several times, and rendered every
+  // frame.
+  void Measure() {
+    if (width_ >= 0) {
+      return;
+    }
+    ascii_ = std::all_of(text_.begin(), text_.end(), [](char c) {
+      return c >= ' ' && c <= '~';
+    });
+    width_ = ascii_ ? int(text_.size()) : string_width(text_);
+  }
+
   std::string text_;
+  // The width of the text, -1 until measured.
+  int width_ = -1;
+  // Whether the text is made of printable ASCII characters only.
+  bool ascii_ = false;
 };
 
 class VText : public Node {
@@ -66,15 +115,23 @@ class VText : public Node {
     if (x + width_ - 1 > box_.x_max) {
       return;
     }
-    for (const auto& it : Utf8ToGlyphs(text_)) {
-      if (y > box_.y_max) {
-        return;
+    for (const Glyph& glyph : GlyphRange(text_)) {
+      for (int i = 0; i < glyph.width; ++i) {
+        if (y > box_.y_max) {
+          return;
+        }
+        if (i == 0) {
+          screen.PixelAt(x, y).character = glyph.text;
+        } else {
+          screen.PixelAt(x, y).character.clear();
+        }
+        y += 1;
       }
-      screen.PixelAt(x, y).character = it;
-      y += 1;
     }
   }
 
+  size_t TextBytes() const override { return text_.size(); }
+
  private:
   std::string text_;
   int width_ = 1;
@@ -98,7 +155,7 @@ class VText : public Node {
 /// Hello world!
 /// ```
 Element text(std::string text) {
-  return std::make_shared<Text>(std::move(text));
+  return MakeNode<Text>(std::move(text));
 }
 
 /// @brief Display a piece of unicode text.
@@ -117,7 +174,7 @@ Element text(std::string text) {
 /// Hello world!
 /// ```
 Element text(std::wstring text) {  // NOLINT
-  return std::make_shared<Text>(to_string(text));
+  return MakeNode<Text>(to_string(text));
 }
 
 /// @brief Display a piece of unicode text vertically.
@@ -147,7 +204,7 @@ Element text(std::wstring text) {  // NOLINT
 /// !
 /// ```
 Element vtext(std::string text) {
-  return std::make_shared<VText>(std::move(text));
+  return MakeNode<VText>(std::move(text));
 }
 
 /// @brief Display a piece unicode text vertically.
@@ -177,7 +234,7 @@ Element vtext(std::string text) {
 /// !
 /// ```
 Element vtext(std::wstring text) {  // NOLINT
-  return std::make_shared<VText>(to_string(text));
+  return MakeNode<VText>(to_string(text));
 }
 
 }  // namespace ftxui
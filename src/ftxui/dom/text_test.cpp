@@ -2,7 +2,9 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 #include <gtest/gtest.h>
-#include <string>  // for allocator, string
+#include <string>   // for allocator, string
+#include <utility>  // for pair
+#include <vector>   // for vector
 
 #include "ftxui/dom/elements.hpp"   // for text, operator|, border, Element
 #include "ftxui/dom/node.hpp"       // for Render
@@ -51,6 +53,24 @@ TEST(TextTest, ScreenBigger2) {
   EXPECT_EQ("test  \r\n      ", screen.ToString());
 }
 
+TEST(TextTest, RenderTwice) {
+  // The text is measured once, and rendered again at another size.
+  const std::vector<std::pair<std::string, std::string>> cases = {
+      {"test", "tes"},
+      {"tést", "tés"},
+      {"te\nst", "tes"},
+  };
+  for (const auto& [input, clipped] : cases) {
+    auto element = text(input);
+    Screen small(3, 1);
+    Render(small, element);
+    EXPECT_EQ(small.ToString(), clipped);
+    Screen large(5, 1);
+    Render(large, element);
+    EXPECT_EQ(large.ToString(), clipped + "t ");
+  }
+}
+
 // See https://github.com/ArthurSonzogni/FTXUI/issues/2#issuecomment-504871456
 TEST(TextTest, CJK) {
   auto element = text("测试") | border;
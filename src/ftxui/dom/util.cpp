@@ -49,7 +49,7 @@ Elements operator|(Elements elements, Decorator decorator) {  // NOLINT
   Elements output;
   output.reserve(elements.size());
   for (auto& it : elements) {
-    output.push_back(std::move(it) | decorator);
+    output.push_back(decorator(std::move(it)));
   }
   return output;
 }
@@ -83,7 +83,7 @@ Element operator|(Element element, Decorator decorator) {  // NOLINT
 /// element |= bold;
 /// ```
 Element& operator|=(Element& e, Decorator d) {
-  e = e | std::move(d);
+  e = d(std::move(e));
   return e;
 }
 
@@ -129,6 +129,9 @@ Dimensions Dimension::Fit(Element& e, bool extend_beyond_screen) {
     }
   }
 
+  // The requirement is computed. The next Render continues from it.
+  e->measured_ = true;
+
   return {
       box.x_max,
       box.y_max,
@@ -1,8 +1,11 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <algorithm>  // for max
-#include <cstddef>    // for size_t
+#include <algorithm>   // for max, min
+#include <cstddef>     // for size_t
+#include <cstdint>     // for int64_t
+#include <functional>  // for function
+#include <limits>      // for numeric_limits
 #include <memory>  // for __shared_ptr_access, shared_ptr, make_shared, allocator_traits<>::value_type
 #include <utility>  // for move
 #include <vector>   // for vector, __alloc_traits<>::value_type
@@ -10,8 +13,10 @@
 #include "ftxui/dom/box_helper.hpp"   // for Element, Compute
 #include "ftxui/dom/elements.hpp"     // for Element, Elements, vbox
 #include "ftxui/dom/node.hpp"         // for Node, Elements
+#include "ftxui/dom/node_pool.hpp"    // for MakeNode
 #include "ftxui/dom/requirement.hpp"  // for Requirement
 #include "ftxui/screen/box.hpp"       // for Box
+#include "ftxui/screen/screen.hpp"    // for Screen
 
 namespace ftxui {
 
@@ -20,6 +25,8 @@ class VBox : public Node {
  public:
   explicit VBox(Elements children) : Node(std::move(children)) {}
 
+  LayoutKind layout_kind() const override { return LayoutKind::kColumn; }
+
   void ComputeRequirement() override {
     requirement_.min_x = 0;
     requirement_.min_y = 0;
@@ -29,7 +36,7 @@ class VBox : public Node {
     requirement_.flex_shrink_y = 0;
     requirement_.selection = Requirement::NORMAL;
     for (auto& child : children_) {
-      child->ComputeRequirement();
+      ComputeChildRequirement(child.get());
       if (requirement_.selection < child->requirement().selection) {
         requirement_.selection = child->requirement().selection;
         requirement_.selected_box = child->requirement().selected_box;
@@ -60,11 +67,106 @@ class VBox : public Node {
     for (size_t i = 0; i < children_.size(); ++i) {
       box.y_min = y;
       box.y_max = y + elements[i].size - 1;
-      children_[i]->SetBox(box);
+      SetChildBox(children_[i].get(), box);
       y = box.y_max + 1;
     }
   }
 };
+
+// Lay out |node| inside |box|, the same way Render(Screen&, Node*) does.
+void Layout(Node* node, Box box) {
+  Node::Status status;
+  node->Check(&status);
+  const int max_iterations = 20;
+  while (status.need_iteration && status.iteration < max_iterations) {
+    node->ComputeRequirement();
+    node->SetBox(box);
+    status.need_iteration = false;
+    status.iteration++;
+    node->Check(&status);
+  }
+}
+
+// A vbox of |count| rows of the same height. The rows are produced while
+// rendering, only for the ones intersecting the stencil. The selected row is
+// produced upfront, so that frame() can scroll to it.
+class VBoxVirtual : public Node {
+ public:
+  VBoxVirtual(int count,
+              int row_height,
+              std::function<Element(int)> generator,
+              int selected)
+      : count_(std::max(0, count)),
+        row_height_(std::max(1, row_height)),
+        generator_(std::move(generator)),
+        selected_(selected >= 0 && selected < count_ ? selected : -1) {
+    if (selected_ != -1) {
+      children_.push_back(generator_(selected_));
+    }
+  }
+
+  void ComputeRequirement() override {
+    Node::ComputeRequirement();
+    requirement_ = Requirement();
+    // The rows aren't measured: expand to the width available instead.
+    requirement_.flex_grow_x = 1;
+    requirement_.min_y = int(std::min<int64_t>(
+        int64_t(count_) * row_height_, std::numeric_limits<int>::max() / 2));
+    if (selected_ == -1) {
+      return;
+    }
+
+    const Requirement row = children_[0]->requirement();
+    requirement_.min_x = row.min_x;
+    requirement_.selection = std::max(row.selection, Requirement::SELECTED);
+    if (row.selection == Requirement::NORMAL) {
+      requirement_.selected_box = Box{0, row.min_x - 1, 0, row_height_ - 1};
+    } else {
+      requirement_.selected_box = row.selected_box;
+    }
+    requirement_.selected_box.y_min += selected_ * row_height_;
+    requirement_.selected_box.y_max += selected_ * row_height_;
+  }
+
+  void SetBox(Box box) override {
+    Node::SetBox(box);
+    if (selected_ != -1) {
+      children_[0]->SetBox(RowBox(selected_));
+    }
+  }
+
+  void Render(Screen& screen) override {
+    const Box visible = Box::Intersection(box_, screen.stencil);
+    if (visible.IsEmpty() || count_ == 0) {
+      return;
+    }
+    const int first = (visible.y_min - box_.y_min) / row_height_;
+    const int last =
+        std::min(count_ - 1, (visible.y_max - box_.y_min) / row_height_);
+    for (int i = first; i <= last; ++i) {
+      if (i == selected_) {
+        RenderVisible(screen, children_[0].get());
+        continue;
+      }
+      const Element row = generator_(i);
+      Layout(row.get(), RowBox(i));
+      row->Render(screen);
+    }
+  }
+
+ private:
+  Box RowBox(int index) const {
+    Box box = box_;
+    box.y_min = box_.y_min + index * row_height_;
+    box.y_max = box.y_min + row_height_ - 1;
+    return box;
+  }
+
+  int count_;
+  int row_height_;
+  std::function<Element(int)> generator_;
+  int selected_;
+};
 }  // namespace
 
 /// @brief A container displaying elements vertically one by one.
@@ -81,7 +183,32 @@ class VBox : public Node {
 /// });
 /// ```
 Element vbox(Elements children) {
-  return std::make_shared<VBox>(std::move(children));
+  return MakeNode<VBox>(std::move(children));
+}
+
+/// @brief A vbox of many rows of the same height, produced on demand. Only the
+/// rows visible, usually inside a frame, are produced and rendered.
+/// @param count The number of rows.
+/// @param row_height The height of every row.
+/// @param generator Produce the row at the given index.
+/// @param selected The row produced upfront, for frame() to scroll to it. It
+/// may contain a focus or a select element. -1 for none.
+/// @return The container.
+/// @ingroup dom
+///
+/// #### Example
+///
+/// ```cpp
+/// vbox_virtual(100000, 1, [&](int i) {
+///   return text(entries[i]) | (i == selected ? inverted : nothing);
+/// }, selected) | vscroll_indicator | yframe;
+/// ```
+Element vbox_virtual(int count,
+                     int row_height,
+                     std::function<Element(int)> generator,
+                     int selected) {
+  return MakeNode<VBoxVirtual>(count, row_height, std::move(generator),
+                                       selected);
 }
 
 }  // namespace ftxui
@@ -4,11 +4,13 @@
 #include <gtest/gtest.h>
 #include <algorithm>  // for remove
 #include <cstddef>    // for size_t
-#include <string>     // for string, allocator, basic_string
+#include <memory>     // for make_shared
+#include <string>     // for string, allocator, basic_string, to_string
 #include <vector>     // for vector
 
-#include "ftxui/dom/elements.hpp"  // for vtext, operator|, vbox, Element, flex_grow, flex_shrink
-#include "ftxui/dom/node.hpp"       // for Render
+#include "ftxui/dom/elements.hpp"  // for vtext, operator|, vbox, Element, flex_grow, flex_shrink, reflect, yframe, size, vbox_virtual, vscroll_indicator, focus
+#include "ftxui/dom/node.hpp"       // for Render, Node
+#include "ftxui/screen/box.hpp"     // for Box
 #include "ftxui/screen/screen.hpp"  // for Screen
 
 // NOLINTBEGIN
@@ -21,6 +23,31 @@ std::string rotate(std::string str) {
   return str;
 }
 
+// A text, counting how many times it is rendered.
+class CountRender : public Node {
+ public:
+  CountRender(std::string text, int* count)
+      : Node({ftxui::text(std::move(text))}), count_(count) {}
+
+  void ComputeRequirement() override {
+    Node::ComputeRequirement();
+    requirement_ = children_[0]->requirement();
+  }
+
+  void SetBox(Box box) override {
+    Node::SetBox(box);
+    children_[0]->SetBox(box);
+  }
+
+  void Render(Screen& screen) override {
+    ++*count_;
+    Node::Render(screen);
+  }
+
+ private:
+  int* count_;
+};
+
 }  // namespace
 
 TEST(VBoxText, NoFlex_NoFlex_NoFlex) {
@@ -368,5 +395,85 @@ TEST(VBoxText, FlexGrow_NoFlex_FlewShrink) {
   }
 }
 
+TEST(VBoxTest, CullRowsOutsideFrame) {
+  int count = 0;
+  std::vector<Box> boxes(20000);
+  Elements rows;
+  for (int i = 0; i < 20000; ++i) {
+    auto row = std::make_shared<CountRender>(std::to_string(i), &count) |
+               reflect(boxes[i]);
+    if (i == 10000) {
+      row |= focus;
+    }
+    rows.push_back(row);
+  }
+  auto root = vbox({
+      vbox(std::move(rows)) | yframe | size(HEIGHT, EQUAL, 3),
+      text("end"),
+  });
+
+  Screen screen(5, 4);
+  Render(screen, root);
+  EXPECT_EQ(screen.ToString(),
+            "9999 \r\n"
+            "10000\r\n"
+            "10001\r\n"
+            "end  ");
+
+  // Only the visible rows are rendered.
+  EXPECT_EQ(count, 3);
+
+  // The rows skipped aren't visible, even when laid out below the frame.
+  EXPECT_TRUE(boxes[10000].Contain(0, 1));
+  EXPECT_FALSE(boxes[0].Contain(0, 0));
+  EXPECT_FALSE(boxes[10002].Contain(0, 3));
+}
+
+TEST(VBoxTest, Virtual) {
+  int generated = 0;
+  auto generator = [&](int i) {
+    generated++;
+    return text(std::to_string(i));
+  };
+
+  // Without selection, the first rows are displayed.
+  Screen screen(6, 3);
+  Render(screen, vbox_virtual(100000, 1, generator) | yframe);
+  EXPECT_EQ(screen.ToString(),
+            "0     \r\n"
+            "1     \r\n"
+            "2     ");
+  EXPECT_EQ(generated, 3);
+
+  // The frame scrolls to the selected row. It is produced only once.
+  generated = 0;
+  screen.Clear();
+  Render(screen, vbox_virtual(100000, 1, generator, 50000) |
+                     vscroll_indicator | yframe);
+  EXPECT_EQ(screen.ToString(),
+            "49999 \r\n"
+            "50000┃\r\n"
+            "50001 ");
+  EXPECT_EQ(generated, 3);
+}
+
+TEST(VBoxTest, VirtualFocus) {
+  // Rows of 2 lines, the second one focused in the selected row.
+  auto generator = [](int i) {
+    Element second = text("  " + std::to_string(i));
+    if (i == 20) {
+      second |= focus;
+    }
+    return vbox({text(std::to_string(i)), second});
+  };
+
+  Screen screen(4, 3);
+  Render(screen, vbox_virtual(100, 2, generator, 20) | yframe);
+  EXPECT_EQ(screen.ToString(),
+            "20  \r\n"
+            "  20\r\n"
+            "21  ");
+}
+
 }  // namespace ftxui
 // NOLINTEND
@@ -0,0 +1,180 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/dom/worker_pool.hpp"
+
+#include <algorithm>  // for min
+#include <memory>     // for make_shared, make_unique
+#include <utility>    // for move
+
+namespace ftxui {
+
+namespace {
+
+// The pool, and the index of the thread running on the calling thread, if any.
+// The tasks it runs queue their own tasks in its queue.
+thread_local WorkerPool* g_current_pool = nullptr;  // NOLINT
+thread_local size_t g_current_index = 0;            // NOLINT
+
+// The state of a ParallelFor, shared with the threads helping. A thread
+// starting after every index is taken does nothing.
+struct ParallelForState {
+  const std::function<void(size_t)>* fn = nullptr;
+  size_t count = 0;
+  std::atomic<size_t> next{0};
+
+  std::mutex mutex;
+  std::condition_variable done;
+  int running = 0;
+
+  void Work() {
+    for (size_t i = next++; i < count; i = next++) {
+      (*fn)(i);
+    }
+  }
+};
+
+}  // namespace
+
+/// @brief Start the threads.
+/// @param threads The number of threads. Negative for one per core.
+WorkerPool::WorkerPool(int threads) {
+  if (threads < 0) {
+    threads = int(std::thread::hardware_concurrency());
+  }
+#if defined(__EMSCRIPTEN__)
+  threads = 0;
+#endif
+  for (int i = 0; i < threads; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  for (size_t i = 0; i < queues_.size(); ++i) {
+    threads_.emplace_back(&WorkerPool::Work, this, i);
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    quit_ = true;
+  }
+  wake_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+/// @brief Run |task| on one of the threads.
+/// @param task The task. Without threads, it is run immediately.
+/// @note This can be called from any thread, including the pool's ones.
+void WorkerPool::Run(std::function<void()> task) {
+  if (queues_.empty()) {
+    task();
+    return;
+  }
+
+  const size_t index = g_current_pool == this
+                           ? g_current_index
+                           : next_queue_++ % queues_.size();
+  // Counted first, so that |pending_| never underflows. A thread woken up
+  // before the task is queued looks for it again.
+  {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    pending_++;
+  }
+  {
+    Queue& queue = *queues_[index];
+    const std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  wake_.notify_one();
+}
+
+/// @brief Call |fn| for every index in [0, count), concurrently. The indices
+/// are taken one at a time, from a shared counter.
+/// @param count The number of indices.
+/// @param fn The function. It must be safe to call concurrently.
+/// @param threads The number of threads, including the calling one. Zero for
+/// the calling one and all the threads of the pool.
+void WorkerPool::ParallelFor(size_t count,
+                             const std::function<void(size_t)>& fn,
+                             int threads) {
+  size_t helpers = queues_.size();
+  if (threads > 0) {
+    helpers = std::min(helpers, size_t(threads - 1));
+  }
+  helpers = std::min(helpers, count == 0 ? 0 : count - 1);
+
+  auto state = std::make_shared<ParallelForState>();
+  state->fn = &fn;
+  state->count = count;
+  for (size_t i = 0; i < helpers; ++i) {
+    Run([state] {
+      {
+        const std::lock_guard<std::mutex> lock(state->mutex);
+        state->running++;
+      }
+      state->Work();
+      {
+        const std::lock_guard<std::mutex> lock(state->mutex);
+        state->running--;
+      }
+      state->done.notify_one();
+    });
+  }
+
+  // Every index is taken once this returns. Only the helpers running |fn| are
+  // waited for. The others find no index left.
+  state->Work();
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->done.wait(lock, [&] { return state->running == 0; });
+}
+
+/// @brief The pool running the calling thread, null if none.
+/// The tasks run by a pool can use it to split their work further.
+WorkerPool* WorkerPool::Current() {
+  return g_current_pool;
+}
+
+void WorkerPool::Work(size_t index) {
+  g_current_pool = this;
+  g_current_index = index;
+  std::function<void()> task;
+  while (true) {
+    if (Pop(index, &task)) {
+      task();
+      task = nullptr;
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    wake_.wait(lock, [this] { return quit_ || pending_ != 0; });
+    if (quit_) {
+      return;
+    }
+  }
+}
+
+// Take the last task of the thread's own queue, or else the first task of
+// another one.
+bool WorkerPool::Pop(size_t index, std::function<void()>* task) {
+  for (size_t i = 0; i < queues_.size(); ++i) {
+    const bool own = i == 0;
+    Queue& queue = *queues_[(index + i) % queues_.size()];
+    const std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+      continue;
+    }
+    if (own) {
+      *task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      *task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+    pending_--;
+    return true;
+  }
+  return false;
+}
+
+}  // namespace ftxui
@@ -0,0 +1,106 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <atomic>              // for atomic
+#include <condition_variable>  // for condition_variable
+#include <mutex>               // for mutex, unique_lock
+#include <thread>              // for thread
+#include <vector>              // for vector
+
+#include "ftxui/dom/worker_pool.hpp"  // for WorkerPool
+
+// NOLINTBEGIN
+namespace ftxui {
+
+TEST(WorkerPoolTest, Run) {
+  std::mutex mutex;
+  std::condition_variable done;
+  int count = 0;
+  {
+    WorkerPool pool(4);
+    EXPECT_EQ(pool.size(), 4);
+    for (int i = 0; i < 100; ++i) {
+      pool.Run([&] {
+        const std::lock_guard<std::mutex> lock(mutex);
+        count++;
+        done.notify_one();
+      });
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&] { return count == 100; });
+  }
+  EXPECT_EQ(count, 100);
+}
+
+TEST(WorkerPoolTest, RunFromTask) {
+  std::atomic<int> count{0};
+  std::atomic<bool> nested_done{false};
+  WorkerPool pool(2);
+  pool.Run([&] {
+    count++;
+    pool.Run([&] {
+      count++;
+      nested_done = true;
+    });
+  });
+  while (!nested_done) {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(count, 2);
+}
+
+TEST(WorkerPoolTest, WithoutThreads) {
+  WorkerPool pool(0);
+  EXPECT_EQ(pool.size(), 0);
+  bool called = false;
+  pool.Run([&] { called = true; });
+  EXPECT_TRUE(called);
+
+  std::vector<int> values(10, 0);
+  pool.ParallelFor(values.size(), [&](size_t i) { values[i] = int(i); });
+  for (size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(values[i], int(i));
+  }
+}
+
+TEST(WorkerPoolTest, ParallelFor) {
+  WorkerPool pool(3);
+  for (int threads : {0, 1, 2, 8}) {
+    std::vector<std::atomic<int>> calls(1000);
+    pool.ParallelFor(
+        calls.size(), [&](size_t i) { calls[i]++; }, threads);
+    for (auto& call : calls) {
+      EXPECT_EQ(call, 1);
+    }
+  }
+}
+
+TEST(WorkerPoolTest, ParallelForWhileBusy) {
+  // The threads of the pool are all busy. The calling thread does the work.
+  WorkerPool pool(2);
+  std::mutex mutex;
+  std::condition_variable notifier;
+  bool release = false;
+  for (int i = 0; i < pool.size(); ++i) {
+    pool.Run([&] {
+      std::unique_lock<std::mutex> lock(mutex);
+      notifier.wait(lock, [&] { return release; });
+    });
+  }
+
+  std::vector<int> values(100, 0);
+  pool.ParallelFor(values.size(), [&](size_t i) { values[i] = 1; });
+  for (int value : values) {
+    EXPECT_EQ(value, 1);
+  }
+
+  {
+    const std::lock_guard<std::mutex> lock(mutex);
+    release = true;
+  }
+  notifier.notify_all();
+}
+
+}  // namespace ftxui
+// NOLINTEND
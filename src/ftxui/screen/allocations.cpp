@@ -0,0 +1,104 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/screen/allocations.hpp"
+
+#include <cstddef>  // for size_t
+
+#if defined(FTXUI_ALLOCATION_COUNTING)
+#include <cstdlib>  // for malloc, free
+#include <new>      // for bad_alloc, nothrow_t
+#endif
+
+namespace ftxui {
+
+namespace {
+// Constant initialized, so that it is usable from operator new at any time.
+thread_local AllocationCount g_allocations;  // NOLINT
+}  // namespace
+
+/// @brief Subtract two counts, to get the allocations in between them.
+/// @ingroup screen
+AllocationCount operator-(const AllocationCount& a, const AllocationCount& b) {
+  return {a.count - b.count, a.bytes - b.bytes};
+}
+
+/// @brief The heap allocations made by the calling thread so far.
+///
+/// Only counted when FTXUI is built with `-DFTXUI_ALLOCATION_COUNTING=ON`.
+/// Otherwise, this is always zero.
+/// @ingroup screen
+/// @see AllocationCountingEnabled
+AllocationCount Allocations() {
+  return g_allocations;
+}
+
+/// @brief Whether the heap allocations are counted. See Allocations().
+/// @ingroup screen
+bool AllocationCountingEnabled() {
+#if defined(FTXUI_ALLOCATION_COUNTING)
+  return true;
+#else
+  return false;
+#endif
+}
+
+}  // namespace ftxui
+
+#if defined(FTXUI_ALLOCATION_COUNTING)
+
+// Replacements of the global allocation functions. The over-aligned variants
+// aren't replaced, they aren't used by FTXUI.
+
+namespace {
+void* CountedAllocation(std::size_t size) noexcept {
+  ftxui::g_allocations.count++;
+  ftxui::g_allocations.bytes += size;
+  return std::malloc(size == 0 ? 1 : size);  // NOLINT
+}
+}  // namespace
+
+void* operator new(std::size_t size) {
+  if (void* pointer = CountedAllocation(size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+  return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t& /*tag*/) noexcept {
+  return CountedAllocation(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& /*tag*/) noexcept {
+  return CountedAllocation(size);
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);  // NOLINT
+}
+
+void operator delete[](void* pointer) noexcept {
+  std::free(pointer);  // NOLINT
+}
+
+void operator delete(void* pointer, std::size_t /*size*/) noexcept {
+  std::free(pointer);  // NOLINT
+}
+
+void operator delete[](void* pointer, std::size_t /*size*/) noexcept {
+  std::free(pointer);  // NOLINT
+}
+
+void operator delete(void* pointer, const std::nothrow_t& /*tag*/) noexcept {
+  std::free(pointer);  // NOLINT
+}
+
+void operator delete[](void* pointer, const std::nothrow_t& /*tag*/) noexcept {
+  std::free(pointer);  // NOLINT
+}
+
+#endif  // FTXUI_ALLOCATION_COUNTING
@@ -0,0 +1,47 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <array>   // for array
+#include <memory>  // for make_unique
+#include <string>  // for string
+
+#include "ftxui/screen/allocations.hpp"
+#include "ftxui/screen/screen.hpp"  // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+TEST(AllocationsTest, Count) {
+  if (!AllocationCountingEnabled()) {
+    EXPECT_EQ(Allocations().count, 0u);
+    GTEST_SKIP() << "Requires -DFTXUI_ALLOCATION_COUNTING=ON";
+  }
+
+  const AllocationCount before = Allocations();
+  auto allocated = std::make_unique<std::array<char, 100>>();
+  const AllocationCount after = Allocations();
+  EXPECT_EQ((after - before).count, 1u);
+  EXPECT_EQ((after - before).bytes, 100u);
+}
+
+// Serializing a Screen again into the same buffer doesn't allocate.
+TEST(AllocationsTest, SteadyState) {
+  if (!AllocationCountingEnabled()) {
+    GTEST_SKIP() << "Requires -DFTXUI_ALLOCATION_COUNTING=ON";
+  }
+
+  Screen screen(80, 24);
+  screen.PixelAt(3, 4).character = "a";
+  screen.PixelAt(3, 4).bold = true;
+  std::string output;
+  screen.ToString(output);
+
+  const AllocationCount before = Allocations();
+  output.clear();
+  screen.ToString(output);
+  EXPECT_EQ((Allocations() - before).count, 0u);
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -0,0 +1,146 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/screen/bitmap.hpp"
+
+#include <algorithm>  // for max, min
+#include <array>      // for array
+#include <atomic>     // for atomic
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint8_t, uint32_t
+#include <mutex>      // for call_once
+#include <string>     // for string, to_string
+#include <utility>    // for move
+#include <vector>     // for vector
+
+namespace ftxui {
+
+namespace {
+
+std::atomic<uint32_t> g_next_bitmap_id{1};  // NOLINT
+
+// The colors are reduced to a 6x6x6 cube, like the 256 colors palette.
+constexpr int kLevels = 6;
+constexpr int kColors = kLevels * kLevels * kLevels;
+
+int Quantize(uint8_t value) {
+  return (value * (kLevels - 1) + 127) / 255;
+}
+
+// Append |count| times the sixel |c|, using the repeat introducer when
+// shorter.
+void AppendRun(std::string& out, char c, int count) {
+  if (count > 3) {
+    out += '!';
+    out += std::to_string(count);
+    out += c;
+  } else {
+    out.append(size_t(count), c);
+  }
+}
+
+std::string EncodeSixel(int width,
+                        int height,
+                        const std::vector<uint8_t>& rgb) {
+  const auto w = size_t(width);
+  std::vector<uint8_t> colors(w * size_t(height));
+  std::array<bool, kColors> used{};
+  for (size_t i = 0; i < colors.size(); ++i) {
+    const uint8_t* p = rgb.data() + i * 3;
+    colors[i] = uint8_t(Quantize(p[0]) * kLevels * kLevels +
+                        Quantize(p[1]) * kLevels + Quantize(p[2]));
+    used[colors[i]] = true;
+  }
+
+  // Introducer, 1:1 pixel aspect ratio, and the size.
+  std::string out = "\x1BP0;1;0q\"1;1;";
+  out += std::to_string(width) + ";" + std::to_string(height);
+
+  // The palette, in percents.
+  for (int color = 0; color < kColors; ++color) {
+    if (!used[size_t(color)]) {
+      continue;
+    }
+    const int r = color / (kLevels * kLevels);
+    const int g = color / kLevels % kLevels;
+    const int b = color % kLevels;
+    out += "#" + std::to_string(color) + ";2;" +
+           std::to_string(r * 100 / (kLevels - 1)) + ";" +
+           std::to_string(g * 100 / (kLevels - 1)) + ";" +
+           std::to_string(b * 100 / (kLevels - 1));
+  }
+
+  // Bands of 6 rows. Each color of the band is drawn over the same band, the
+  // other bits left transparent.
+  std::vector<uint8_t> sixels(w);
+  for (int band = 0; band < height; band += 6) {
+    const int rows = std::min(6, height - band);
+    std::array<bool, kColors> in_band{};
+    for (int y = band; y < band + rows; ++y) {
+      for (int x = 0; x < width; ++x) {
+        in_band[colors[size_t(y) * w + size_t(x)]] = true;
+      }
+    }
+
+    bool first = true;
+    for (int color = 0; color < kColors; ++color) {
+      if (!in_band[size_t(color)]) {
+        continue;
+      }
+      int last = -1;
+      for (int x = 0; x < width; ++x) {
+        uint8_t bits = 0;
+        for (int k = 0; k < rows; ++k) {
+          if (colors[size_t(band + k) * w + size_t(x)] == color) {
+            bits |= uint8_t(1 << k);
+          }
+        }
+        sixels[size_t(x)] = bits;
+        if (bits) {
+          last = x;
+        }
+      }
+
+      if (!first) {
+        out += '$';  // Back to the start of the band.
+      }
+      first = false;
+      out += "#" + std::to_string(color);
+      for (int x = 0; x <= last;) {
+        int run = 1;
+        while (x + run <= last &&
+               sixels[size_t(x + run)] == sixels[size_t(x)]) {
+          ++run;
+        }
+        AppendRun(out, char(63 + sixels[size_t(x)]), run);
+        x += run;
+      }
+    }
+    out += '-';  // Next band.
+  }
+  out += "\x1B\\";
+  return out;
+}
+
+}  // namespace
+
+/// @brief A bitmap of |width| x |height| pixels.
+/// @param rgb 3 bytes per pixel, row after row. Missing pixels are black.
+Bitmap::Bitmap(int width, int height, std::vector<uint8_t> rgb)
+    : width_(std::max(0, width)),
+      height_(std::max(0, height)),
+      rgb_(std::move(rgb)),
+      id_(g_next_bitmap_id++) {
+  rgb_.resize(size_t(width_) * size_t(height_) * 3);
+}
+
+/// @brief The bitmap encoded for terminals supporting Sixel graphics. Unlike
+/// the kitty protocol, Sixel images are sent again whenever they are drawn, so
+/// the encoding is kept.
+const std::string& Bitmap::Sixel() const {
+  std::call_once(sixel_once_,
+                 [this] { sixel_ = EncodeSixel(width_, height_, rgb_); });
+  return sixel_;
+}
+
+}  // namespace ftxui
@@ -0,0 +1,122 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/screen/cell_buffer.hpp"
+
+#include <array>    // for array
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint32_t, uint16_t
+
+#include "ftxui/screen/pixel.hpp"            // for Pixel
+#include "ftxui/screen/string_internal.hpp"  // for EatCodePoint
+
+namespace ftxui {
+
+/// @brief The Attribute bits of the style of |pixel|.
+uint32_t CellBuffer::Attributes(const Pixel& pixel) {
+  uint32_t bits = 0;
+  bits |= pixel.bold ? kBold : 0U;
+  bits |= pixel.dim ? kDim : 0U;
+  bits |= pixel.underlined ? kUnderlined : 0U;
+  bits |= pixel.underlined_double ? kUnderlinedDouble : 0U;
+  bits |= pixel.blink ? kBlink : 0U;
+  bits |= pixel.inverted ? kInverted : 0U;
+  bits |= pixel.strikethrough ? kStrikethrough : 0U;
+  return bits;
+}
+
+/// @brief Copy the pixels of |screen|, and list the cells changed since the
+/// previous update.
+/// @param screen The screen, once rendered.
+void CellBuffer::Update(const Screen& screen) {
+  updates_.clear();
+  cursor_ = screen.cursor();
+  const bool resized = screen.dimx() != dimx_ || screen.dimy() != dimy_;
+  if (resized) {
+    dimx_ = screen.dimx();
+    dimy_ = screen.dimy();
+    cells_.assign(size_t(dimx_) * size_t(dimy_) * kCellSize, 0);
+    glyphs_.clear();
+    glyph_ids_.clear();
+    hyperlinks_ = {""};
+    hyperlink_ids_.clear();
+  }
+
+  // The screen's hyperlink ids, translated once per update.
+  std::vector<uint32_t> links;
+  uint32_t index = 0;
+  for (int y = 0; y < dimy_; ++y) {
+    for (int x = 0; x < dimx_; ++x, ++index) {
+      const Pixel& pixel = screen.PixelAt(x, y);
+      uint32_t link = 0;
+      if (pixel.hyperlink != 0) {
+        if (links.size() <= pixel.hyperlink) {
+          links.resize(size_t(pixel.hyperlink) + 1, 0);
+        }
+        if (links[pixel.hyperlink] == 0) {
+          links[pixel.hyperlink] = HyperlinkOf(screen, pixel.hyperlink);
+        }
+        link = links[pixel.hyperlink];
+      }
+
+      const std::array<uint32_t, kCellSize> cell = {
+          GlyphOf(pixel.character),
+          pixel.foreground_color.Key(),
+          pixel.background_color.Key(),
+          Attributes(pixel) | link << 16U,
+      };
+      uint32_t* out = cells_.data() + size_t(index) * kCellSize;
+      if (!resized && out[kGlyph] == cell[kGlyph] &&
+          out[kForeground] == cell[kForeground] &&
+          out[kBackground] == cell[kBackground] &&
+          out[kStyle] == cell[kStyle]) {
+        continue;
+      }
+      for (uint32_t i = 0; i < kCellSize; ++i) {
+        out[i] = cell[i];  // NOLINT
+      }
+      updates_.push_back(index);
+    }
+  }
+}
+
+// The codepoint of a single codepoint character, or else the id of the
+// cluster, registered on first use. Empty pixels are drawn as spaces.
+uint32_t CellBuffer::GlyphOf(const std::string& character) {
+  uint32_t codepoint = 0;
+  size_t end = 0;
+  if (character.empty()) {
+    return ' ';
+  }
+  if (EatCodePoint(character, 0, &end, &codepoint) &&
+      end == character.size()) {
+    return codepoint;
+  }
+  auto it = glyph_ids_.find(character);
+  if (it != glyph_ids_.end()) {
+    return kGlyphBase + it->second;
+  }
+  const auto id = uint32_t(glyphs_.size());
+  glyphs_.push_back(character);
+  glyph_ids_.emplace(character, id);
+  return kGlyphBase + id;
+}
+
+// The id of the hyperlink |id| of |screen|, registered on first use. Past
+// 65535 distinct hyperlinks, 0 is returned.
+uint32_t CellBuffer::HyperlinkOf(const Screen& screen, uint16_t id) {
+  const std::string& link = screen.Hyperlink(id);
+  auto it = hyperlink_ids_.find(link);
+  if (it != hyperlink_ids_.end()) {
+    return it->second;
+  }
+  if (hyperlinks_.size() > 0xFFFF) {  // NOLINT
+    return 0;
+  }
+  const auto buffer_id = uint32_t(hyperlinks_.size());
+  hyperlinks_.push_back(link);
+  hyperlink_ids_.emplace(link, buffer_id);
+  return buffer_id;
+}
+
+}  // namespace ftxui
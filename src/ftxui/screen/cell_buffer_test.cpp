@@ -0,0 +1,81 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <cstdint>  // for uint32_t
+#include <vector>   // for vector
+
+#include "ftxui/screen/cell_buffer.hpp"  // for CellBuffer
+#include "ftxui/screen/color.hpp"        // for Color
+#include "ftxui/screen/screen.hpp"       // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+TEST(CellBufferTest, Layout) {
+  Screen screen(3, 2);
+  screen.PixelAt(0, 0).character = "a";
+  screen.PixelAt(0, 0).bold = true;
+  screen.PixelAt(0, 0).foreground_color = Color::RGB(1, 2, 3);
+  screen.PixelAt(1, 0).character = "é";
+  screen.PixelAt(2, 1).background_color = Color::Red;
+  screen.PixelAt(2, 1).hyperlink = screen.RegisterHyperlink("https://a.b");
+
+  CellBuffer cells;
+  cells.Update(screen);
+  EXPECT_EQ(cells.dimx(), 3);
+  EXPECT_EQ(cells.dimy(), 2);
+  ASSERT_EQ(cells.cells().size(), 3 * 2 * CellBuffer::kCellSize);
+  EXPECT_EQ(cells.updates(), (std::vector<uint32_t>{0, 1, 2, 3, 4, 5}));
+
+  const uint32_t* a = cells.cell(0);
+  EXPECT_EQ(a[CellBuffer::kGlyph], uint32_t('a'));
+  EXPECT_EQ(a[CellBuffer::kForeground], Color::RGB(1, 2, 3).Key());
+  EXPECT_EQ(a[CellBuffer::kBackground], 0u);
+  EXPECT_EQ(a[CellBuffer::kStyle], uint32_t(CellBuffer::kBold));
+
+  EXPECT_EQ(cells.cell(1)[CellBuffer::kGlyph], 0xE9u);
+  EXPECT_EQ(cells.cell(2)[CellBuffer::kGlyph], uint32_t(' '));
+
+  const uint32_t* link = cells.cell(5);
+  EXPECT_EQ(Color::FromKey(link[CellBuffer::kBackground]), Color(Color::Red));
+  EXPECT_EQ(cells.Hyperlink(link[CellBuffer::kStyle] >> 16), "https://a.b");
+}
+
+TEST(CellBufferTest, Cluster) {
+  Screen screen(2, 1);
+  screen.PixelAt(0, 0).character = "é";
+  screen.PixelAt(1, 0).character = "é";
+
+  CellBuffer cells;
+  cells.Update(screen);
+  const uint32_t glyph = cells.cell(0)[CellBuffer::kGlyph];
+  ASSERT_GE(glyph, CellBuffer::kGlyphBase);
+  EXPECT_EQ(cells.cell(1)[CellBuffer::kGlyph], glyph);
+  EXPECT_EQ(cells.Glyph(glyph - CellBuffer::kGlyphBase), "é");
+}
+
+TEST(CellBufferTest, Updates) {
+  Screen screen(4, 2);
+  CellBuffer cells;
+  cells.Update(screen);
+
+  // Unchanged.
+  cells.Update(screen);
+  EXPECT_TRUE(cells.updates().empty());
+
+  screen.PixelAt(1, 0).character = "x";
+  screen.PixelAt(3, 1).inverted = true;
+  cells.Update(screen);
+  EXPECT_EQ(cells.updates(), (std::vector<uint32_t>{1, 7}));
+  EXPECT_EQ(cells.cell(7)[CellBuffer::kStyle],
+            uint32_t(CellBuffer::kInverted));
+
+  // Every cell is listed once resized.
+  Screen smaller(2, 1);
+  cells.Update(smaller);
+  EXPECT_EQ(cells.updates(), (std::vector<uint32_t>{0, 1}));
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -3,9 +3,11 @@
 // the LICENSE file.
 #include "ftxui/screen/color.hpp"
 
-#include <array>  // for array
+#include <algorithm>  // for min
+#include <array>      // for array
 #include <cmath>
 #include <cstdint>
+#include <cstring>  // for memcpy
 #include <string>
 
 #include "ftxui/screen/color_info.hpp"  // for GetColorInfo, ColorInfo
@@ -32,6 +34,153 @@ const std::array<const char*, 33> palette16code = {
     "97", "107",  //
 };
 
+// The decimal representation of a color channel, up to 3 digits.
+struct Decimal {
+  std::array<char, 3> digits{};
+  uint8_t size = 0;
+};
+
+constexpr std::array<Decimal, 256> BuildDecimals() {
+  std::array<Decimal, 256> decimals{};
+  for (int i = 0; i < 256; ++i) {
+    Decimal& decimal = decimals[i];  // NOLINT
+    if (i >= 100) {
+      decimal.digits[decimal.size++] = char('0' + i / 100);
+    }
+    if (i >= 10) {
+      decimal.digits[decimal.size++] = char('0' + i / 10 % 10);
+    }
+    decimal.digits[decimal.size++] = char('0' + i % 10);
+  }
+  return decimals;
+}
+
+constexpr std::array<Decimal, 256> decimals = BuildDecimals();
+
+void AppendNumber(std::string& output, uint8_t value) {
+  const Decimal& decimal = decimals[value];  // NOLINT
+  output.append(decimal.digits.data(), decimal.size);
+}
+
+// Find the closest color from the 256 colors palette, ignoring the 16 first
+// ones, configured by the user.
+uint8_t FindClosestPalette256(uint8_t red, uint8_t green, uint8_t blue) {
+  const int max_distance = 256 * 256 * 3;
+  int closest = max_distance;
+  int best = 0;
+  const int database_begin = 16;
+  const int database_end = 256;
+  for (int i = database_begin; i < database_end; ++i) {
+    const ColorInfo color_info = GetColorInfo(Color::Palette256(i));
+    const int dr = color_info.red - red;
+    const int dg = color_info.green - green;
+    const int db = color_info.blue - blue;
+    const int dist = dr * dr + dg * dg + db * db;
+    if (closest > dist) {
+      closest = dist;
+      best = i;
+    }
+  }
+  return uint8_t(best);
+}
+
+// Same as FindClosestPalette256, memoized in a direct mapped cache. Gradients
+// and blending produce the same colors over and over on low color terminals.
+uint8_t ClosestPalette256(uint8_t red, uint8_t green, uint8_t blue) {
+  struct Entry {
+    uint32_t key = 0;  // 0 for an empty entry.
+    uint8_t index = 0;
+  };
+  constexpr uint32_t cache_bits = 12;
+  thread_local std::array<Entry, 1U << cache_bits> cache;
+
+  const uint32_t key = (1U << 24U) | (uint32_t(red) << 16U) |  //
+                       (uint32_t(green) << 8U) | uint32_t(blue);
+  const uint32_t hash = (key * 2654435761U) >> (32U - cache_bits);
+  Entry& entry = cache[hash];  // NOLINT
+  if (entry.key != key) {
+    entry.key = key;
+    entry.index = FindClosestPalette256(red, green, blue);
+  }
+  return entry.index;
+}
+
+// The gamma correction of the channel values, in tables. See Interpolate().
+struct GammaTables {
+  // The linear light intensity of each channel value.
+  std::array<float, 256> linear{};
+  // The smallest intensity converted back to each channel value.
+  std::array<float, 256> threshold{};
+  // The channel value converted back from the intensity i*i.
+  std::array<uint8_t, 448> from_square{};
+};
+
+constexpr float gamma = 2.2F;
+
+// The conversion replaced by the tables: the channel value of an intensity,
+// rounded down.
+int Channel(float intensity) {
+  return static_cast<int>(powf(intensity, 1.F / gamma));
+}
+
+GammaTables BuildGammaTables() {
+  GammaTables tables;
+  for (size_t i = 0; i < tables.linear.size(); ++i) {
+    tables.linear[i] = powf(float(i), gamma);
+  }
+
+  // Each threshold is found by a binary search over the positive floats, whose
+  // bit patterns are ordered like their values.
+  auto from_bits = [](uint32_t bits) {
+    float value = 0.F;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  };
+  uint32_t low = 0;
+  uint32_t high = 0;
+  const float max = powf(256.F, gamma);
+  std::memcpy(&high, &max, sizeof(high));
+  for (size_t i = 1; i < tables.threshold.size(); ++i) {
+    uint32_t a = low;
+    uint32_t b = high;
+    while (a < b) {
+      const uint32_t middle = a + (b - a) / 2;
+      if (Channel(from_bits(middle)) >= int(i)) {
+        b = middle;
+      } else {
+        a = middle + 1;
+      }
+    }
+    tables.threshold[i] = from_bits(a);
+    low = a;
+  }
+
+  for (size_t i = 0; i < tables.from_square.size(); ++i) {
+    tables.from_square[i] = uint8_t(std::min(255, Channel(float(i * i))));
+  }
+  return tables;
+}
+
+const GammaTables& GetGammaTables() {
+  static const GammaTables tables = BuildGammaTables();
+  return tables;
+}
+
+float ToLinear(const GammaTables& tables, uint8_t value) {
+  return tables.linear[value];  // NOLINT
+}
+
+// Same as Channel(intensity), without calling powf(). The channel value grows
+// slower than the square root of the intensity: starting from the value of the
+// square of its integer part, at most one step is left.
+uint8_t FromLinear(const GammaTables& tables, float intensity) {
+  size_t value = tables.from_square[size_t(std::sqrt(intensity))];  // NOLINT
+  while (value < 255 && tables.threshold[value + 1] <= intensity) {  // NOLINT
+    ++value;
+  }
+  return uint8_t(value);
+}
+
 }  // namespace
 
 bool Color::operator==(const Color& rhs) const {
@@ -44,39 +193,83 @@ bool Color::operator!=(const Color& rhs) const {
 }
 
 std::string Color::Print(bool is_background_color) const {
-  if (is_background_color) {
-    switch (type_) {
-      case ColorType::Palette1:
-        return "49";
-      case ColorType::Palette16:
-        return palette16code[2 * red_ + 1];  // NOLINT
-      case ColorType::Palette256:
-        return "48;5;" + std::to_string(red_);
-      case ColorType::TrueColor:
-        return "48;2;" + std::to_string(red_) + ";" + std::to_string(green_) +
-               ";" + std::to_string(blue_);
-    }
-  } else {
-    switch (type_) {
-      case ColorType::Palette1:
-        return "39";
-      case ColorType::Palette16:
-        return palette16code[2 * red_];  // NOLINT
-      case ColorType::Palette256:
-        return "38;5;" + std::to_string(red_);
-      case ColorType::TrueColor:
-        return "38;2;" + std::to_string(red_) + ";" + std::to_string(green_) +
-               ";" + std::to_string(blue_);
-    }
+  std::string output;
+  PrintTo(output, is_background_color);
+  return output;
+}
+
+/// @brief Append the SGR parameters of this color to |output|. This is the
+/// allocation free equivalent of `output += Print(is_background_color)`, as
+/// long as |output| has enough capacity. The channels are written from a
+/// precomputed table, without formatting numbers.
+/// @param output The buffer to append to.
+/// @param is_background_color Whether the color is used as a background.
+void Color::PrintTo(std::string& output, bool is_background_color) const {
+  switch (type_) {
+    case ColorType::Palette1:
+      output += is_background_color ? "49" : "39";
+      return;
+    case ColorType::Palette16:
+      output += palette16code[2 * red_ + int(is_background_color)];  // NOLINT
+      return;
+    case ColorType::Palette256:
+      output += is_background_color ? "48;5;" : "38;5;";
+      AppendNumber(output, red_);
+      return;
+    case ColorType::TrueColor:
+      output += is_background_color ? "48;2;" : "38;2;";
+      AppendNumber(output, red_);
+      output += ';';
+      AppendNumber(output, green_);
+      output += ';';
+      AppendNumber(output, blue_);
+      return;
   }
-  // NOTREACHED();
-  return "";
 }
 
 /// @brief Build a transparent color.
 /// @ingroup screen
 Color::Color() = default;
 
+/// @brief Build the color identified by |key|, see Key().
+/// @ingroup screen
+// static
+Color Color::FromKey(uint32_t key) {
+  Color color;
+  color.type_ = ColorType((key >> 24) & 0x3);                   // NOLINT
+  color.red_ = uint8_t(key >> 16);                              // NOLINT
+  color.green_ = uint8_t(key >> 8);                             // NOLINT
+  color.blue_ = uint8_t(key);                                   // NOLINT
+  color.alpha_ = color.type_ == ColorType::Palette1 ? 0 : 255;  // NOLINT
+  return color;
+}
+
+/// @brief The closest color a terminal supporting |support| colors displays.
+/// The RGB colors are replaced by the closest color of the 256 colors palette,
+/// and those by the closest one of the 16 colors palette.
+/// @param support The colors supported by the terminal.
+/// @return Color::Default for a monochrome terminal.
+/// @ingroup screen
+Color Color::Downgrade(Terminal::Color support) const {
+  if (support == Terminal::Color::Palette1) {
+    return {};
+  }
+  Color color = *this;
+  if (color.type_ == ColorType::TrueColor &&
+      support != Terminal::Color::TrueColor) {
+    color.type_ = ColorType::Palette256;
+    color.red_ = ClosestPalette256(red_, green_, blue_);
+    color.green_ = 0;
+    color.blue_ = 0;
+  }
+  if (color.type_ == ColorType::Palette256 &&
+      support == Terminal::Color::Palette16) {
+    color.type_ = ColorType::Palette16;
+    color.red_ = GetColorInfo(Color::Palette256(color.red_)).index_16;
+  }
+  return color;
+}
+
 /// @brief Build a transparent color.
 /// @ingroup screen
 Color::Color(Palette1 /*value*/) : Color() {}
@@ -115,24 +308,7 @@ Color::Color(uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
     return;
   }
 
-  // Find the closest Color from the database:
-  const int max_distance = 256 * 256 * 3;
-  int closest = max_distance;
-  int best = 0;
-  const int database_begin = 16;
-  const int database_end = 256;
-  for (int i = database_begin; i < database_end; ++i) {
-    const ColorInfo color_info = GetColorInfo(Color::Palette256(i));
-    const int dr = color_info.red - red;
-    const int dg = color_info.green - green;
-    const int db = color_info.blue - blue;
-    const int dist = dr * dr + dg * dg + db * db;
-    if (closest > dist) {
-      closest = dist;
-      best = i;
-    }
-  }
-
+  const uint8_t best = ClosestPalette256(red, green, blue);
   if (Terminal::ColorSupport() == Terminal::Color::Palette256) {
     type_ = ColorType::Palette256;
     red_ = best;
@@ -263,13 +439,11 @@ Color Color::Interpolate(float t, const Color& a, const Color& b) {
 
   // Gamma correction:
   // https://en.wikipedia.org/wiki/Gamma_correction
-  auto interp = [t](uint8_t a_u, uint8_t b_u) {
-    constexpr float gamma = 2.2F;
-    const float a_f = powf(a_u, gamma);
-    const float b_f = powf(b_u, gamma);
-    const float c_f = a_f * (1.0F - t) +  //
-                      b_f * t;
-    return static_cast<uint8_t>(powf(c_f, 1.F / gamma));
+  const GammaTables& tables = GetGammaTables();
+  auto interp = [t, &tables](uint8_t a_u, uint8_t b_u) {
+    const float c_f = ToLinear(tables, a_u) * (1.0F - t) +  //
+                      ToLinear(tables, b_u) * t;
+    return FromLinear(tables, c_f);
   };
   return Color::RGB(interp(a_r, b_r),   //
                     interp(a_g, b_g),   //
@@ -279,6 +453,14 @@ Color Color::Interpolate(float t, const Color& a, const Color& b) {
 /// @brief Blend two colors together using the alpha channel.
 // static
 Color Color::Blend(const Color& lhs, const Color& rhs) {
+  // Nothing is drawn over |lhs|, or |rhs| covers it entirely.
+  if (rhs.type_ == ColorType::Palette1) {
+    return lhs;
+  }
+  if (rhs.alpha_ == 255) {
+    return rhs;
+  }
+
   Color out = Interpolate(float(rhs.alpha_) / 255.F, lhs, rhs);
   out.alpha_ = lhs.alpha_ + rhs.alpha_ - lhs.alpha_ * rhs.alpha_ / 255;
   return out;
@@ -3,6 +3,9 @@
 // the LICENSE file.
 #include "ftxui/screen/color.hpp"
 #include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+#include <vector>
 #include "ftxui/screen/terminal.hpp"
 
 namespace ftxui {
@@ -31,11 +34,44 @@ TEST(ColorTest, PrintTrueCOlor) {
   EXPECT_EQ(Color::RGB(1, 2, 3).Print(true), "48;2;1;2;3");
 }
 
+TEST(ColorTest, PrintTo) {
+  Terminal::SetColorSupport(Terminal::Color::TrueColor);
+  std::string output = "x";
+  Color().PrintTo(output, false);
+  Color(Color::Red).PrintTo(output, true);
+  Color(Color::DarkRed).PrintTo(output, false);
+  Color::RGB(255, 20, 3).PrintTo(output, true);
+  EXPECT_EQ(output, "x394138;5;5248;2;255;20;3");
+}
+
 TEST(ColorTest, FallbackTo256) {
   Terminal::SetColorSupport(Terminal::Color::Palette256);
   EXPECT_EQ(Color::RGB(1, 2, 3).Print(false), "38;5;16");
 }
 
+TEST(ColorTest, FallbackCached) {
+  // Many colors share the same cache entries. Looking them up a second time
+  // must give the same result.
+  Terminal::SetColorSupport(Terminal::Color::Palette256);
+  std::vector<Color> first;
+  for (int i = 0; i < 256; i += 3) {
+    for (int j = 0; j < 256; j += 5) {
+      first.push_back(Color::RGB(i, j, 255 - i));
+    }
+  }
+  size_t index = 0;
+  for (int i = 0; i < 256; i += 3) {
+    for (int j = 0; j < 256; j += 5) {
+      EXPECT_EQ(Color::RGB(i, j, 255 - i), first[index++]);
+    }
+  }
+  EXPECT_EQ(Color::RGB(1, 2, 3).Print(false), "38;5;16");
+  EXPECT_EQ(Color::RGB(255, 0, 0).Print(false), "38;5;196");
+
+  Terminal::SetColorSupport(Terminal::Color::Palette16);
+  EXPECT_EQ(Color::RGB(1, 2, 3).Print(false), "30");
+}
+
 TEST(ColorTest, FallbackTo16) {
   Terminal::SetColorSupport(Terminal::Color::Palette16);
   EXPECT_EQ(Color::RGB(1, 2, 3).Print(false), "30");
@@ -78,6 +114,44 @@ TEST(ColorTest, Interpolate) {
             "38;2;251;198;225");
 }
 
+TEST(ColorTest, InterpolateGamma) {
+  Terminal::SetColorSupport(Terminal::Color::TrueColor);
+
+  // The channels are interpolated in linear light, using tables. They match
+  // the formula.
+  auto reference = [](float t, int a, int b) {
+    const float c = powf(float(a), 2.2F) * (1.F - t) +  //
+                    powf(float(b), 2.2F) * t;
+    return static_cast<int>(powf(c, 1.F / 2.2F));
+  };
+  for (int a = 0; a < 256; ++a) {
+    for (int b = 0; b < 256; b += 15) {
+      for (float t : {0.F, 0.1F, 0.25F, 0.5F, 0.7F, 0.9F, 1.F}) {
+        const Color color =
+            Color::Interpolate(t, Color::RGB(a, a, a), Color::RGB(b, 0, 255));
+        const std::string expected = "38;2;" +
+                                     std::to_string(reference(t, a, b)) + ";" +
+                                     std::to_string(reference(t, a, 0)) + ";" +
+                                     std::to_string(reference(t, a, 255));
+        ASSERT_EQ(color.Print(false), expected) << a << " " << b << " " << t;
+      }
+    }
+  }
+}
+
+TEST(ColorTest, Downgrade) {
+  Terminal::SetColorSupport(Terminal::Color::TrueColor);
+  const Color color = Color::RGB(255, 0, 0);
+  EXPECT_EQ(color.Downgrade(Terminal::Color::TrueColor), color);
+  EXPECT_EQ(color.Downgrade(Terminal::Color::Palette256),
+            Color(Color::Palette256(196)));
+  EXPECT_EQ(color.Downgrade(Terminal::Color::Palette16),
+            Color(Color::RedLight));
+  EXPECT_EQ(color.Downgrade(Terminal::Color::Palette1), Color());
+  EXPECT_EQ(Color(Color::Red).Downgrade(Terminal::Color::Palette256),
+            Color(Color::Red));
+}
+
 TEST(ColorTest, HSV) {
   Terminal::SetColorSupport(Terminal::Color::TrueColor);
   EXPECT_EQ(Color::HSV(0, 255, 255).Print(false), "38;2;255;0;0");
@@ -0,0 +1,273 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/screen/cpu_dispatch.hpp"
+
+#include <cstdint>  // for uint64_t, uint32_t
+#include <cstring>  // for memcpy
+#include <vector>   // for vector
+
+// The vectorized kernels are compiled with the instruction sets they use, and
+// only called once the CPU is known to support them.
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define FTXUI_CPU_X86 1
+#include <immintrin.h>
+#elif defined(_MSC_VER) && defined(_M_X64)
+// Only SSE2, always available on x86-64.
+#define FTXUI_CPU_X86_MSVC 1
+#include <emmintrin.h>
+#include <intrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+// NEON is always available on AArch64.
+#define FTXUI_CPU_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace ftxui::cpu {
+
+namespace {
+
+// Scalar ----------------------------------------------------------------------
+// 8 bytes at a time, in integer registers.
+
+constexpr uint64_t kOnes = 0x0101010101010101ULL;
+constexpr uint64_t kHigh = 0x8080808080808080ULL;
+
+bool IsPrintableAscii(char c) {
+  return c >= 0x20 && c < 0x7f;  // NOLINT
+}
+
+bool IsAscii(char c) {
+  return (static_cast<unsigned char>(c) & 0x80) == 0;  // NOLINT
+}
+
+// Whether the 8 bytes of |word| are all printable ASCII characters.
+bool IsPrintableAscii(uint64_t word) {
+  if ((word & kHigh) != 0) {
+    return false;
+  }
+  // With every high bit cleared, the subtractions below set the high bit of
+  // the bytes smaller than the subtrahend.
+  const bool has_control = ((word - 0x20 * kOnes) & kHigh) != 0;
+  const uint64_t del = word ^ (0x7f * kOnes);
+  const bool has_del = ((del - kOnes) & ~del & kHigh) != 0;
+  return !has_control && !has_del;
+}
+
+size_t ScalarAsciiRun(const char* data, size_t size) {
+  size_t end = 0;
+  while (end + sizeof(uint64_t) <= size) {
+    uint64_t word = 0;
+    std::memcpy(&word, data + end, sizeof(word));  // NOLINT
+    if ((word & kHigh) != 0) {
+      break;
+    }
+    end += sizeof(word);
+  }
+  while (end < size && IsAscii(data[end])) {  // NOLINT
+    ++end;
+  }
+  return end;
+}
+
+size_t ScalarPrintableAsciiRun(const char* data, size_t size) {
+  size_t end = 0;
+  while (end + sizeof(uint64_t) <= size) {
+    uint64_t word = 0;
+    std::memcpy(&word, data + end, sizeof(word));  // NOLINT
+    if (!IsPrintableAscii(word)) {
+      break;
+    }
+    end += sizeof(word);
+  }
+  while (end < size && IsPrintableAscii(data[end])) {  // NOLINT
+    ++end;
+  }
+  return end;
+}
+
+// The index of the lowest bit set in |mask|, which isn't zero.
+int LowestBit(uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index = 0;  // NOLINT
+  _BitScanForward(&index, mask);
+  return int(index);
+#else
+  return __builtin_ctz(mask);
+#endif
+}
+
+// SSE2 ------------------------------------------------------------------------
+// 16 bytes at a time. The bytes are compared as signed: the non-ASCII ones
+// are negative.
+
+#if defined(FTXUI_CPU_X86) || defined(FTXUI_CPU_X86_MSVC)
+
+#if defined(FTXUI_CPU_X86)
+#define FTXUI_TARGET_SSE2 __attribute__((target("sse2")))
+#define FTXUI_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define FTXUI_TARGET_SSE2
+#endif
+
+FTXUI_TARGET_SSE2 size_t Sse2AsciiRun(const char* data, size_t size) {
+  size_t end = 0;
+  while (end + 16 <= size) {
+    const __m128i bytes = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(data + end));  // NOLINT
+    const auto non_ascii = uint32_t(_mm_movemask_epi8(bytes));
+    if (non_ascii != 0) {
+      return end + LowestBit(non_ascii);
+    }
+    end += 16;
+  }
+  return end + ScalarAsciiRun(data + end, size - end);  // NOLINT
+}
+
+FTXUI_TARGET_SSE2 size_t Sse2PrintableAsciiRun(const char* data,
+                                               size_t size) {
+  const __m128i low = _mm_set1_epi8(0x1f);   // NOLINT
+  const __m128i high = _mm_set1_epi8(0x7f);  // NOLINT
+  size_t end = 0;
+  while (end + 16 <= size) {
+    const __m128i bytes = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(data + end));  // NOLINT
+    const __m128i printable = _mm_and_si128(_mm_cmpgt_epi8(bytes, low),
+                                            _mm_cmplt_epi8(bytes, high));
+    const auto other = uint32_t(~_mm_movemask_epi8(printable)) & 0xffffU;
+    if (other != 0) {
+      return end + LowestBit(other);
+    }
+    end += 16;
+  }
+  return end + ScalarPrintableAsciiRun(data + end, size - end);  // NOLINT
+}
+
+#endif
+
+// AVX2 ------------------------------------------------------------------------
+// 32 bytes at a time.
+
+#if defined(FTXUI_CPU_X86)
+
+FTXUI_TARGET_AVX2 size_t Avx2AsciiRun(const char* data, size_t size) {
+  size_t end = 0;
+  while (end + 32 <= size) {
+    const __m256i bytes = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(data + end));  // NOLINT
+    const auto non_ascii = uint32_t(_mm256_movemask_epi8(bytes));
+    if (non_ascii != 0) {
+      return end + LowestBit(non_ascii);
+    }
+    end += 32;
+  }
+  return end + Sse2AsciiRun(data + end, size - end);  // NOLINT
+}
+
+FTXUI_TARGET_AVX2 size_t Avx2PrintableAsciiRun(const char* data,
+                                               size_t size) {
+  const __m256i low = _mm256_set1_epi8(0x1f);   // NOLINT
+  const __m256i high = _mm256_set1_epi8(0x7f);  // NOLINT
+  size_t end = 0;
+  while (end + 32 <= size) {
+    const __m256i bytes = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(data + end));  // NOLINT
+    const __m256i printable = _mm256_and_si256(
+        _mm256_cmpgt_epi8(bytes, low), _mm256_cmpgt_epi8(high, bytes));
+    const auto other = ~uint32_t(_mm256_movemask_epi8(printable));
+    if (other != 0) {
+      return end + LowestBit(other);
+    }
+    end += 32;
+  }
+  return end + Sse2PrintableAsciiRun(data + end, size - end);  // NOLINT
+}
+
+#endif
+
+// NEON ------------------------------------------------------------------------
+// 16 bytes at a time. A chunk with other bytes is finished by the scalar
+// loop, NEON having no movemask.
+
+#if defined(FTXUI_CPU_NEON)
+
+size_t NeonAsciiRun(const char* data, size_t size) {
+  size_t end = 0;
+  while (end + 16 <= size) {
+    const uint8x16_t bytes =
+        vld1q_u8(reinterpret_cast<const uint8_t*>(data + end));  // NOLINT
+    if (vmaxvq_u8(bytes) >= 0x80) {                              // NOLINT
+      break;
+    }
+    end += 16;
+  }
+  return end + ScalarAsciiRun(data + end, size - end);  // NOLINT
+}
+
+size_t NeonPrintableAsciiRun(const char* data, size_t size) {
+  const uint8x16_t low = vdupq_n_u8(0x20);   // NOLINT
+  const uint8x16_t high = vdupq_n_u8(0x7e);  // NOLINT
+  size_t end = 0;
+  while (end + 16 <= size) {
+    const uint8x16_t bytes =
+        vld1q_u8(reinterpret_cast<const uint8_t*>(data + end));  // NOLINT
+    const uint8x16_t printable =
+        vandq_u8(vcgeq_u8(bytes, low), vcleq_u8(bytes, high));
+    if (vminvq_u8(printable) == 0) {
+      break;
+    }
+    end += 16;
+  }
+  return end + ScalarPrintableAsciiRun(data + end, size - end);  // NOLINT
+}
+
+#endif
+
+}  // namespace
+
+/// Detect the instruction sets of the running CPU. The result is cached.
+const Features& Detect() {
+  static const Features features = [] {
+    Features f;
+#if defined(FTXUI_CPU_X86)
+    __builtin_cpu_init();
+    f.sse2 = __builtin_cpu_supports("sse2");
+    f.avx2 = __builtin_cpu_supports("avx2");
+#elif defined(FTXUI_CPU_X86_MSVC)
+    f.sse2 = true;
+#elif defined(FTXUI_CPU_NEON)
+    f.neon = true;
+#endif
+    return f;
+  }();
+  return features;
+}
+
+const std::vector<Kernels>& SupportedKernels() {
+  static const std::vector<Kernels> kernels = [] {
+    std::vector<Kernels> k;
+    k.push_back({"scalar", ScalarAsciiRun, ScalarPrintableAsciiRun});
+    const Features& features = Detect();
+    (void)features;
+#if defined(FTXUI_CPU_X86) || defined(FTXUI_CPU_X86_MSVC)
+    if (features.sse2) {
+      k.push_back({"sse2", Sse2AsciiRun, Sse2PrintableAsciiRun});
+    }
+#endif
+#if defined(FTXUI_CPU_X86)
+    if (features.avx2) {
+      k.push_back({"avx2", Avx2AsciiRun, Avx2PrintableAsciiRun});
+    }
+#endif
+#if defined(FTXUI_CPU_NEON)
+    if (features.neon) {
+      k.push_back({"neon", NeonAsciiRun, NeonPrintableAsciiRun});
+    }
+#endif
+    return k;
+  }();
+  return kernels;
+}
+
+}  // namespace ftxui::cpu
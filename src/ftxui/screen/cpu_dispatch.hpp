@@ -0,0 +1,44 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_SCREEN_CPU_DISPATCH_HPP
+#define FTXUI_SCREEN_CPU_DISPATCH_HPP
+
+#include <cstddef>  // for size_t
+#include <vector>   // for vector
+
+namespace ftxui::cpu {
+
+// The instruction sets usable on the running CPU, detected once.
+struct Features {
+  bool sse2 = false;
+  bool avx2 = false;
+  bool neon = false;
+};
+const Features& Detect();
+
+// The kernels vectorized for an instruction set. Each one has the same result
+// as the scalar one, which is the reference.
+struct Kernels {
+  const char* name;
+
+  // The number of ASCII bytes at the start of |data|.
+  size_t (*ascii_run)(const char* data, size_t size);
+
+  // The number of printable ASCII bytes, from ' ' to '~', at the start of
+  // |data|.
+  size_t (*printable_ascii_run)(const char* data, size_t size);
+};
+
+// The kernels runnable on this CPU, the scalar ones first.
+const std::vector<Kernels>& SupportedKernels();
+
+// The fastest kernels runnable on this CPU, picked once.
+inline const Kernels& Best() {
+  static const Kernels& best = SupportedKernels().back();
+  return best;
+}
+
+}  // namespace ftxui::cpu
+
+#endif  // FTXUI_SCREEN_CPU_DISPATCH_HPP
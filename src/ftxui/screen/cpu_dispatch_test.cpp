@@ -0,0 +1,48 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <random>  // for mt19937
+#include <string>  // for string
+
+#include "ftxui/screen/cpu_dispatch.hpp"
+
+// NOLINTBEGIN
+namespace ftxui::cpu {
+
+// Every kernel supported by the CPU has the result of the scalar one.
+TEST(CpuDispatchTest, KernelsMatchScalar) {
+  const auto& kernels = SupportedKernels();
+  ASSERT_FALSE(kernels.empty());
+  const Kernels& scalar = kernels.front();
+  EXPECT_STREQ(scalar.name, "scalar");
+  EXPECT_EQ(&Best(), &kernels.back());
+
+  std::mt19937 random(42);
+  const char alphabet[] = {'a', ' ', '~', '\x7f', '\x1f', '\n', '\xc3', '\x80'};
+  for (int iteration = 0; iteration < 2000; ++iteration) {
+    // Mostly printable, with an other byte somewhere, or nowhere.
+    std::string input(random() % 100, 'x');
+    if (!input.empty() && random() % 4 != 0) {
+      input[random() % input.size()] = alphabet[random() % 8];
+    }
+    for (const Kernels& k : kernels) {
+      SCOPED_TRACE(k.name);
+      EXPECT_EQ(k.ascii_run(input.data(), input.size()),
+                scalar.ascii_run(input.data(), input.size()));
+      EXPECT_EQ(k.printable_ascii_run(input.data(), input.size()),
+                scalar.printable_ascii_run(input.data(), input.size()));
+    }
+  }
+}
+
+TEST(CpuDispatchTest, ScalarReference) {
+  const Kernels& scalar = SupportedKernels().front();
+  const std::string input = "hello world, this is \x7f ascii \xc3\xa9";
+  EXPECT_EQ(scalar.printable_ascii_run(input.data(), input.size()), 21u);
+  EXPECT_EQ(scalar.ascii_run(input.data(), input.size()), 29u);
+  EXPECT_EQ(scalar.ascii_run(input.data(), 0), 0u);
+}
+
+}  // namespace ftxui::cpu
+// NOLINTEND
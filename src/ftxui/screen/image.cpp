@@ -1,18 +1,22 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <sstream>  // IWYU pragma: keep
+#include <algorithm>  // for copy, fill, max, min, sort
+#include <cstddef>    // for size_t
+#include <sstream>    // IWYU pragma: keep
 #include <string>
 #include <vector>
 
+#include "ftxui/screen/box.hpp"  // for Box
 #include "ftxui/screen/image.hpp"
 #include "ftxui/screen/pixel.hpp"
 
 namespace ftxui {
 
 namespace {
+// Per thread: the screens can be drawn by several threads at once.
 Pixel& dev_null_pixel() {
-  static Pixel pixel;
+  thread_local Pixel pixel;
   return pixel;
 }
 }  // namespace
@@ -21,7 +25,10 @@ Image::Image(int dimx, int dimy)
     : stencil{0, dimx - 1, 0, dimy - 1},
       dimx_(dimx),
       dimy_(dimy),
-      pixels_(dimy, std::vector<Pixel>(dimx)) {}
+      pixels_(static_cast<size_t>(std::max(0, dimx) * std::max(0, dimy))),
+      touched_(static_cast<size_t>(std::max(0, dimy))) {
+  touched_rows_.reserve(touched_.size());
+}
 
 /// @brief Access a character in a cell at a given position.
 /// @param x The cell position along the x-axis.
@@ -41,23 +48,213 @@ const std::string& Image::at(int x, int y) const {
 /// @param x The cell position along the x-axis.
 /// @param y The cell position along the y-axis.
 Pixel& Image::PixelAt(int x, int y) {
-  return stencil.Contain(x, y) ? pixels_[y][x] : dev_null_pixel();
+  if (!stencil.Contain(x, y)) {
+    return dev_null_pixel();
+  }
+
+  // The caller might modify the pixel. Keep track of it.
+  Touch(y, x, x);
+  return RowAt(y)[x];
 }
 
 /// @brief Access a cell (Pixel) at a given position.
 /// @param x The cell position along the x-axis.
 /// @param y The cell position along the y-axis.
 const Pixel& Image::PixelAt(int x, int y) const {
-  return stencil.Contain(x, y) ? pixels_[y][x] : dev_null_pixel();
+  return stencil.Contain(x, y) ? RowAt(y)[x] : dev_null_pixel();
+}
+
+/// @brief Access the pixels of a row, clipped to the stencil.
+/// @param x_min The first pixel of the row, along the x-axis.
+/// @param x_max The last pixel of the row, along the x-axis.
+/// @param y The row, along the y-axis.
+/// @return The pixels, indexed by their column. Their x_min and x_max are the
+/// clipped ones.
+Image::PixelRow Image::ClippedRow(int x_min, int x_max, int y) {
+  PixelRow row;
+  x_min = std::max(x_min, stencil.x_min);
+  x_max = std::min(x_max, stencil.x_max);
+  if (x_min > x_max || y < stencil.y_min || y > stencil.y_max) {
+    return row;
+  }
+  // The caller might modify the pixels. Keep track of them.
+  Touch(y, x_min, x_max);
+  row.pixels = RowAt(y) + x_min;
+  row.x_min = x_min;
+  row.x_max = x_max;
+  return row;
 }
 
 /// @brief Clear all the pixel from the screen.
 void Image::Clear() {
-  for (auto& line : pixels_) {
-    for (auto& cell : line) {
-      cell = Pixel();
+  // Only the pixels handed out by PixelAt() might differ from the default. The
+  // cost is proportional to what was drawn, not to the size of the image.
+  const Pixel default_pixel;
+  for (const int y : touched_rows_) {
+    TouchedSpan& span = touched_[y];
+    Pixel* line = RowAt(y);
+    std::fill(line + span.x_min, line + span.x_max + 1, default_pixel);
+    span = TouchedSpan();
+  }
+  touched_rows_.clear();
+}
+
+// protected
+void Image::DrawImage(int x, int y, const Image& image) {
+  const Box area = Box::Intersection(
+      stencil, Box{x, x + image.dimx() - 1, y, y + image.dimy() - 1});
+  if (area.IsEmpty()) {
+    return;
+  }
+  const int width = area.x_max - area.x_min + 1;
+  for (int dst_y = area.y_min; dst_y <= area.y_max; ++dst_y) {
+    const Pixel* source = image.RowAt(dst_y - y) + (area.x_min - x);
+    std::copy(source, source + width, RowAt(dst_y) + area.x_min);
+    Touch(dst_y, area.x_min, area.x_max);
+  }
+}
+
+/// @brief Set the character of a row of pixels.
+/// @param x_min The first pixel of the row, along the x-axis.
+/// @param x_max The last pixel of the row, along the x-axis.
+/// @param y The row, along the y-axis.
+/// @param character The character of the pixels.
+/// @param automerge Whether to merge the pixels with the adjacent box drawing
+/// characters.
+void Image::FillRow(int x_min,
+                    int x_max,
+                    int y,
+                    const std::string& character,
+                    bool automerge) {
+  x_min = std::max(x_min, stencil.x_min);
+  x_max = std::min(x_max, stencil.x_max);
+  if (x_min > x_max || y < stencil.y_min || y > stencil.y_max) {
+    return;
+  }
+  Touch(y, x_min, x_max);
+  Pixel* line = RowAt(y);
+  for (int x = x_min; x <= x_max; ++x) {
+    line[x].character = character;
+    if (automerge) {
+      line[x].automerge = true;
+    }
+  }
+}
+
+/// @brief Set the character of a column of pixels.
+/// @param x The column, along the x-axis.
+/// @param y_min The first pixel of the column, along the y-axis.
+/// @param y_max The last pixel of the column, along the y-axis.
+/// @param character The character of the pixels.
+/// @param automerge Whether to merge the pixels with the adjacent box drawing
+/// characters.
+void Image::FillColumn(int x,
+                       int y_min,
+                       int y_max,
+                       const std::string& character,
+                       bool automerge) {
+  y_min = std::max(y_min, stencil.y_min);
+  y_max = std::min(y_max, stencil.y_max);
+  if (y_min > y_max || x < stencil.x_min || x > stencil.x_max) {
+    return;
+  }
+  for (int y = y_min; y <= y_max; ++y) {
+    Touch(y, x, x);
+    Pixel& pixel = RowAt(y)[x];
+    pixel.character = character;
+    if (automerge) {
+      pixel.automerge = true;
     }
   }
 }
 
+/// @brief Replace a row of pixels by |pixel|.
+/// @param x_min The first pixel of the row, along the x-axis.
+/// @param x_max The last pixel of the row, along the x-axis.
+/// @param y The row, along the y-axis.
+/// @param pixel The value of the pixels.
+void Image::FillRow(int x_min, int x_max, int y, const Pixel& pixel) {
+  x_min = std::max(x_min, stencil.x_min);
+  x_max = std::min(x_max, stencil.x_max);
+  if (x_min > x_max || y < stencil.y_min || y > stencil.y_max) {
+    return;
+  }
+  Touch(y, x_min, x_max);
+  Pixel* line = RowAt(y);
+  std::fill(line + x_min, line + x_max + 1, pixel);
+}
+
+/// @brief Replace a column of pixels by |pixel|.
+/// @param x The column, along the x-axis.
+/// @param y_min The first pixel of the column, along the y-axis.
+/// @param y_max The last pixel of the column, along the y-axis.
+/// @param pixel The value of the pixels.
+void Image::FillColumn(int x, int y_min, int y_max, const Pixel& pixel) {
+  y_min = std::max(y_min, stencil.y_min);
+  y_max = std::min(y_max, stencil.y_max);
+  if (y_min > y_max || x < stencil.x_min || x > stencil.x_max) {
+    return;
+  }
+  for (int y = y_min; y <= y_max; ++y) {
+    Touch(y, x, x);
+    RowAt(y)[x] = pixel;
+  }
+}
+
+// protected
+const std::vector<int>& Image::TouchedRows() {
+  std::sort(touched_rows_.begin(), touched_rows_.end());
+  return touched_rows_;
+}
+
+/// @brief The number of bytes allocated by the image.
+/// Include the storage kept from larger dimensions, see Resize(), and the
+/// characters too long to be stored inline.
+size_t Image::MemoryUsage() const {
+  const size_t inline_capacity = std::string().capacity();
+  size_t bytes = pixels_.capacity() * sizeof(Pixel) +
+                 touched_.capacity() * sizeof(TouchedSpan) +
+                 touched_rows_.capacity() * sizeof(int);
+  for (const Pixel& pixel : pixels_) {
+    if (pixel.character.capacity() > inline_capacity) {
+      bytes += pixel.character.capacity() + 1;
+    }
+  }
+  return bytes;
+}
+
+/// @brief Release the storage not needed by the current dimensions.
+/// The pixels are kept. The characters are shrunk to their content.
+void Image::ShrinkToFit() {
+  pixels_.shrink_to_fit();
+  for (Pixel& pixel : pixels_) {
+    pixel.character.shrink_to_fit();
+  }
+  touched_.shrink_to_fit();
+  // Still reserved for one entry per row, so that drawing doesn't allocate.
+  std::vector<int> touched_rows;
+  touched_rows.reserve(touched_.size());
+  touched_rows.assign(touched_rows_.begin(), touched_rows_.end());
+  touched_rows_.swap(touched_rows);
+}
+
+void Image::Resize(int dimx, int dimy) {
+  // The pixels outside of the touched spans are default ones already. Once the
+  // others are reset, the buffer is reused as is, whatever the new dimensions.
+  Clear();
+  dimx_ = dimx;
+  dimy_ = dimy;
+  stencil = {0, dimx - 1, 0, dimy - 1};
+
+  // The buffer grows geometrically, and is kept when shrinking. A terminal
+  // being resized back and forth doesn't reallocate.
+  const auto size = static_cast<size_t>(std::max(0, dimx) * std::max(0, dimy));
+  if (size > pixels_.capacity()) {
+    pixels_.reserve(std::max(size, 2 * pixels_.capacity()));
+  }
+  pixels_.resize(size);
+  touched_.assign(static_cast<size_t>(std::max(0, dimy)), TouchedSpan());
+  touched_rows_.reserve(touched_.size());
+}
+
 }  // namespace ftxui
@@ -0,0 +1,89 @@
+// Copyright 2024 Alex Kordic. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/screen/live_cell.hpp"
+
+#include <algorithm>    // for max, min
+#include <functional>   // for function
+#include <mutex>        // for mutex, lock_guard
+#include <string_view>  // for string_view
+#include <utility>      // for move
+
+#include "ftxui/screen/box.hpp"     // for Box
+#include "ftxui/screen/image.hpp"   // for Image
+#include "ftxui/screen/pixel.hpp"   // for Pixel
+#include "ftxui/screen/string.hpp"  // for Glyph, GlyphRange
+
+namespace ftxui {
+
+LiveCell::LiveCell(int width)
+    : width_(std::max(0, width)), cells_(size_t(width_)) {}
+
+void LiveCell::Set(std::string_view text, const Pixel& style) {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  int x = 0;
+  for (const Glyph& glyph : GlyphRange(text)) {
+    if (x + glyph.width > width_) {
+      break;
+    }
+    Pixel& cell = cells_[size_t(x++)];
+    cell = style;
+    cell.character = glyph.text;
+
+    // Fullwidth glyphs take two cells. The second is left empty.
+    if (glyph.width == 2) {
+      Pixel& next = cells_[size_t(x++)];
+      next = style;
+      next.character.clear();
+    }
+  }
+  for (; x < width_; ++x) {
+    Pixel& cell = cells_[size_t(x)];
+    cell = style;
+    cell.character = " ";
+  }
+
+  if (!pending_) {
+    pending_ = true;
+    if (on_change_) {
+      on_change_();
+    }
+  }
+}
+
+void LiveCell::Draw(Image& image, int x, int y, const Box& clip) {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  pending_ = false;
+  if (y < clip.y_min || y > clip.y_max || y < 0 || y >= image.dimy()) {
+    return;
+  }
+  const int begin = std::max({x, clip.x_min, 0});
+  const int end = std::min({x + width_, clip.x_max + 1, image.dimx()});
+  for (int i = begin; i < end; ++i) {
+    image.PixelAt(i, y) = cells_[size_t(i - x)];
+  }
+}
+
+bool LiveCell::Pending() {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  return pending_;
+}
+
+void LiveCell::Watch(const void* owner, std::function<void()> on_change) {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  owner_ = owner;
+  on_change_ = std::move(on_change);
+  if (pending_ && on_change_) {
+    on_change_();
+  }
+}
+
+void LiveCell::Unwatch(const void* owner) {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  if (owner_ == owner) {
+    owner_ = nullptr;
+    on_change_ = nullptr;
+  }
+}
+
+}  // namespace ftxui
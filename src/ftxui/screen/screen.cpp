@@ -1,21 +1,29 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <cstddef>  // for size_t
+#include <algorithm>  // for min, max
+#include <array>      // for array
+#include <charconv>   // for to_chars
+#include <cstddef>    // for size_t
 #include <cstdint>
+#include <cstdlib>  // for abs
 #include <iostream>  // for operator<<, stringstream, basic_ostream, flush, cout, ostream
 #include <limits>
-#include <map>      // for _Rb_tree_const_iterator, map, operator!=, operator==
+#include <map>      // for map
 #include <sstream>  // IWYU pragma: keep
-#include <utility>  // for pair
+#include <string_view>  // for string_view
+#include <utility>  // for pair, move
+#include <vector>   // for vector
 
 #include <chrono>
 
+#include "ftxui/screen/bitmap.hpp"  // for Bitmap
 #include "ftxui/screen/image.hpp"  // for Image
 #include "ftxui/screen/pixel.hpp"  // for Pixel
 #include "ftxui/screen/screen.hpp"
 #include "ftxui/screen/string.hpp"    // for string_width
-#include "ftxui/screen/terminal.hpp"  // for Dimensions, Size
+#include "ftxui/screen/string_internal.hpp"  // for EatCodePoint, IsFullWidth
+#include "ftxui/screen/terminal.hpp"  // for Dimensions, Size, ColorSupport
 
 #if defined(_WIN32)
 #define WIN32_LEAN_AND_MEAN
@@ -69,84 +77,237 @@ void WindowsEmulateVT100Terminal() {
 }
 #endif
 
-// NOLINTNEXTLINE(readability-function-cognitive-complexity)
-void UpdatePixelStyle(const Screen* screen,
-                      std::stringstream& ss,
-                      const Pixel& prev,
-                      const Pixel& next) {
-  // See https://gist.github.com/egmontkob/eb114294efbcd5adb1944c9f3cb5feda
-  if (FTXUI_UNLIKELY(next.hyperlink != prev.hyperlink)) {
-    ss << "\x1B]8;;" << screen->Hyperlink(next.hyperlink) << "\x1B\\";
+// Accumulates SGR parameters into a single `CSI ... m` sequence.
+class SGRSequence {
+ public:
+  explicit SGRSequence(std::string& out) : out_(out) {}
+  ~SGRSequence() {
+    if (open_) {
+      out_ += 'm';
+    }
+  }
+  SGRSequence(const SGRSequence&) = delete;
+  SGRSequence& operator=(const SGRSequence&) = delete;
+
+  // Returns the output, ready to receive the next parameter.
+  std::string& Next() {
+    out_ += open_ ? ";" : "\x1B[";
+    open_ = true;
+    return out_;
   }
 
+ private:
+  std::string& out_;
+  bool open_ = false;
+};
+
+// Append the SGR parameter of |color|, for a terminal supporting |depth|
+// colors. Nothing is written for a monochrome terminal.
+template <Terminal::Color depth>
+void AppendColor(SGRSequence& sgr, const Color& color, bool background) {
+  if constexpr (depth == Terminal::Color::TrueColor) {
+    color.PrintTo(sgr.Next(), background);
+  } else if constexpr (depth != Terminal::Color::Palette1) {
+    color.Downgrade(depth).PrintTo(sgr.Next(), background);
+  }
+}
+
+// Append the SGR sequence switching from the style of |prev| to the style of
+// |next|, for a terminal supporting |depth| colors. The hyperlinks are left
+// aside.
+template <Terminal::Color depth>
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+void AppendStyleTransition(std::string& out,
+                           const Pixel& prev,
+                           const Pixel& next) {
+  // The attributes and the colors that changed are emitted together, in a
+  // single sequence.
+  SGRSequence sgr(out);
+
   // Bold
   if (FTXUI_UNLIKELY((next.bold ^ prev.bold) | (next.dim ^ prev.dim))) {
-    // BOLD_AND_DIM_RESET:
-    ss << ((prev.bold && !next.bold) || (prev.dim && !next.dim) ? "\x1B[22m"
-                                                                : "");
-    ss << (next.bold ? "\x1B[1m" : "");  // BOLD_SET
-    ss << (next.dim ? "\x1B[2m" : "");   // DIM_SET
+    if ((prev.bold && !next.bold) || (prev.dim && !next.dim)) {
+      sgr.Next() += "22";  // BOLD_AND_DIM_RESET
+    }
+    if (next.bold) {
+      sgr.Next() += '1';  // BOLD_SET
+    }
+    if (next.dim) {
+      sgr.Next() += '2';  // DIM_SET
+    }
   }
 
   // Underline
   if (FTXUI_UNLIKELY(next.underlined != prev.underlined ||
                      next.underlined_double != prev.underlined_double)) {
-    ss << (next.underlined          ? "\x1B[4m"     // UNDERLINE
-           : next.underlined_double ? "\x1B[21m"    // UNDERLINE_DOUBLE
-                                    : "\x1B[24m");  // UNDERLINE_RESET
+    sgr.Next() += (next.underlined          ? "4"     // UNDERLINE
+                   : next.underlined_double ? "21"    // UNDERLINE_DOUBLE
+                                            : "24");  // UNDERLINE_RESET
   }
 
   // Blink
   if (FTXUI_UNLIKELY(next.blink != prev.blink)) {
-    ss << (next.blink ? "\x1B[5m"     // BLINK_SET
-                      : "\x1B[25m");  // BLINK_RESET
+    sgr.Next() += (next.blink ? "5"     // BLINK_SET
+                              : "25");  // BLINK_RESET
   }
 
   // Inverted
   if (FTXUI_UNLIKELY(next.inverted != prev.inverted)) {
-    ss << (next.inverted ? "\x1B[7m"     // INVERTED_SET
-                         : "\x1B[27m");  // INVERTED_RESET
+    sgr.Next() += (next.inverted ? "7"     // INVERTED_SET
+                                 : "27");  // INVERTED_RESET
   }
 
   // StrikeThrough
   if (FTXUI_UNLIKELY(next.strikethrough != prev.strikethrough)) {
-    ss << (next.strikethrough ? "\x1B[9m"     // CROSSED_OUT
-                              : "\x1B[29m");  // CROSSED_OUT_RESET
+    sgr.Next() += (next.strikethrough ? "9"     // CROSSED_OUT
+                                      : "29");  // CROSSED_OUT_RESET
+  }
+
+  if (FTXUI_UNLIKELY(next.foreground_color != prev.foreground_color)) {
+    AppendColor<depth>(sgr, next.foreground_color, false);
+  }
+
+  if (FTXUI_UNLIKELY(next.background_color != prev.background_color)) {
+    AppendColor<depth>(sgr, next.background_color, true);
   }
+}
 
-  if (FTXUI_UNLIKELY(next.foreground_color != prev.foreground_color ||
-                     next.background_color != prev.background_color)) {
-    ss << "\x1B[" + next.foreground_color.Print(false) + "m";
-    ss << "\x1B[" + next.background_color.Print(true) + "m";
+using StyleTransitionEncoder = void (*)(std::string&,
+                                        const Pixel&,
+                                        const Pixel&);
+
+// The encoder of the terminal's color depth, picked once per frame. The
+// capabilities aren't checked again for every style transition.
+StyleTransitionEncoder GetStyleTransitionEncoder(Terminal::Color depth) {
+  switch (depth) {
+    case Terminal::Color::Palette1:
+      return &AppendStyleTransition<Terminal::Color::Palette1>;
+    case Terminal::Color::Palette16:
+      return &AppendStyleTransition<Terminal::Color::Palette16>;
+    case Terminal::Color::Palette256:
+      return &AppendStyleTransition<Terminal::Color::Palette256>;
+    case Terminal::Color::TrueColor:
+      break;
   }
+  return &AppendStyleTransition<Terminal::Color::TrueColor>;
 }
 
+// The style of a pixel packed into an integer: its attributes and its colors,
+// but not its hyperlink. Two pixels are drawn the same way when their styles
+// are equal. The style of the default pixel is 0.
+uint64_t StyleOf(const Pixel& pixel) {
+  const uint64_t attributes = uint64_t(pixel.bold) |                    //
+                              uint64_t(pixel.dim) << 1 |                //
+                              uint64_t(pixel.underlined) << 2 |         //
+                              uint64_t(pixel.underlined_double) << 3 |  //
+                              uint64_t(pixel.blink) << 4 |              //
+                              uint64_t(pixel.inverted) << 5 |           //
+                              uint64_t(pixel.strikethrough) << 6;
+  return uint64_t(pixel.foreground_color.Key()) |        //
+         uint64_t(pixel.background_color.Key()) << 26 |  //
+         attributes << 52;
+}
+
+// The bits of StyleOf() holding the attributes.
+constexpr uint64_t kAttributesMask = ~((uint64_t(1) << 52) - 1);
+
+// The SGR sequences switching from a style to another, serialized once and
+// looked up afterward. A frame uses few styles, so a small direct-mapped table
+// holds most of its transitions.
+struct StyleTransition {
+  uint64_t from = 0;
+  uint64_t to = 0;
+  std::string sgr;
+};
+struct StyleTransitions {
+  // The color depth the transitions are encoded for.
+  Terminal::Color depth = Terminal::Color::TrueColor;
+  std::array<StyleTransition, 256> entries;
+};
+
+// The transitions of the calling thread, encoded for |depth|.
+StyleTransitions& GetStyleTransitions(Terminal::Color depth) {
+  thread_local StyleTransitions transitions;
+  if (transitions.depth != depth) {
+    transitions.depth = depth;
+    for (StyleTransition& entry : transitions.entries) {
+      entry = {};
+    }
+  }
+  return transitions;
+}
+
+// Writes the sequences switching the terminal from the style of a pixel to the
+// style of the next one.
+class StyleWriter {
+ public:
+  StyleWriter(const Screen* screen, std::string& out)
+      : screen_(screen),
+        out_(out),
+        depth_(Terminal::ColorSupport()),
+        encoder_(GetStyleTransitionEncoder(depth_)),
+        transitions_(GetStyleTransitions(depth_).entries),
+        // The colors a monochrome terminal drops don't change the style.
+        style_mask_(depth_ == Terminal::Color::Palette1 ? kAttributesMask
+                                                        : ~uint64_t(0)) {}
+  StyleWriter(const StyleWriter&) = delete;
+  StyleWriter& operator=(const StyleWriter&) = delete;
+
+  void Write(const Pixel& next) {
+    // See https://gist.github.com/egmontkob/eb114294efbcd5adb1944c9f3cb5feda
+    if (FTXUI_UNLIKELY(next.hyperlink != prev_->hyperlink)) {
+      out_ += "\x1B]8;;";
+      out_ += screen_->Hyperlink(next.hyperlink);
+      out_ += "\x1B\\";
+    }
+
+    const uint64_t style = StyleOf(next) & style_mask_;
+    if (FTXUI_UNLIKELY(style != style_)) {
+      const uint64_t hash =
+          (style_ ^ (style * 0x9E3779B97F4A7C15ULL)) * 0xBF58476D1CE4E5B9ULL;
+      auto& entry = transitions_[hash >> 56];
+      if (entry.from != style_ || entry.to != style) {
+        entry.from = style_;
+        entry.to = style;
+        entry.sgr.clear();
+        encoder_(entry.sgr, *prev_, next);
+      }
+      out_ += entry.sgr;
+      style_ = style;
+    }
+    prev_ = &next;
+  }
+
+  // Switch back to the default style.
+  void Reset() { Write(default_pixel_); }
+
+ private:
+  const Screen* screen_;
+  std::string& out_;
+  const Terminal::Color depth_;
+  const StyleTransitionEncoder encoder_;
+  std::array<StyleTransition, 256>& transitions_;
+  const uint64_t style_mask_;
+  const Pixel default_pixel_;
+  const Pixel* prev_ = &default_pixel_;
+  uint64_t style_ = 0;
+};
+
 struct TileEncoding {
   std::uint8_t left : 2;
   std::uint8_t top : 2;
   std::uint8_t right : 2;
   std::uint8_t down : 2;
   std::uint8_t round : 1;
+};
 
-  // clang-format off
-  bool operator<(const TileEncoding& other) const {
-    if (left < other.left)   { return  true;  }
-    if (left > other.left)   { return  false; }
-    if (top < other.top)     { return  true;  }
-    if (top > other.top)     { return  false; }
-    if (right < other.right) { return  true;  }
-    if (right > other.right) { return  false; }
-    if (down < other.down)   { return  true;  }
-    if (down > other.down)   { return  false; }
-    if (round < other.round) { return  true;  }
-    if (round > other.round) { return  false; }
-      return false;
-  }
-  // clang-format on
+struct Tile {
+  std::string_view character;
+  TileEncoding encoding;
 };
 
 // clang-format off
-const std::map<std::string, TileEncoding> tile_encoding = { // NOLINT
+constexpr Tile tile_encoding[] = {
     {"─", {1, 0, 1, 0, 0}},
     {"━", {2, 0, 2, 0, 0}},
     {"╍", {2, 0, 2, 0, 0}},
@@ -289,72 +450,122 @@ const std::map<std::string, TileEncoding> tile_encoding = { // NOLINT
 };
 // clang-format on
 
-template <class A, class B>
-std::map<B, A> InvertMap(const std::map<A, B> input) {
-  std::map<B, A> output;
-  for (const auto& it : input) {
-    output[it.second] = it.first;
+// Box drawing characters are U+2500 to U+257F. In UTF-8, they are encoded
+// from "\xE2\x94\x80" to "\xE2\x95\xBF".
+constexpr int kBoxDrawingCount = 128;
+
+// The index of the box drawing character |c|, or -1.
+constexpr int BoxDrawingIndex(std::string_view c) {
+  if (c.size() != 3 || uint8_t(c[0]) != 0xE2) {  // NOLINT
+    return -1;
   }
-  return output;
+  const int high = uint8_t(c[1]) - 0x94;  // NOLINT
+  const int low = uint8_t(c[2]) - 0x80;   // NOLINT
+  if (high < 0 || high > 1 || low < 0 || low >= 64) {  // NOLINT
+    return -1;
+  }
+  return high * 64 + low;  // NOLINT
+}
+
+// Replace the box drawing character |c| by the one at |index|. Only the last
+// two bytes differ.
+void SetBoxDrawing(std::string& c, int index) {
+  c[1] = char(0x94 + index / 64);  // NOLINT
+  c[2] = char(0x80 + index % 64);  // NOLINT
+}
+
+constexpr int TileKey(const TileEncoding& encoding) {
+  return encoding.left | (encoding.top << 2) | (encoding.right << 4) |  // NOLINT
+         (encoding.down << 6) | (encoding.round << 8);                  // NOLINT
+}
+
+// |tile_encoding|, as dense tables indexed by BoxDrawingIndex() and TileKey().
+struct TileTables {
+  std::array<bool, kBoxDrawingCount> valid{};
+  std::array<TileEncoding, kBoxDrawingCount> encoding{};
+  std::array<int16_t, 512> inverse{};  // NOLINT
+};
+
+// Built at compile time: nothing is constructed when the program starts.
+constexpr TileTables BuildTileTables() {
+  TileTables tables;
+  for (auto& inverse : tables.inverse) {
+    inverse = -1;
+  }
+  for (const Tile& tile : tile_encoding) {
+    const int index = BoxDrawingIndex(tile.character);
+    tables.valid[index] = true;                               // NOLINT
+    tables.encoding[index] = tile.encoding;                   // NOLINT
+    tables.inverse[TileKey(tile.encoding)] = int16_t(index);  // NOLINT
+  }
+  return tables;
 }
 
-const std::map<TileEncoding, std::string> tile_encoding_inverse =  // NOLINT
-    InvertMap(tile_encoding);
+constexpr TileTables tile_tables = BuildTileTables();
+
+// The encoding of |c|, or nullptr if it isn't a character to merge.
+const TileEncoding* FindTile(const std::string& c) {
+  const int index = BoxDrawingIndex(c);
+  if (index < 0 || !tile_tables.valid[index]) {  // NOLINT
+    return nullptr;
+  }
+  return &tile_tables.encoding[index];  // NOLINT
+}
 
 void UpgradeLeftRight(std::string& left, std::string& right) {
-  const auto it_left = tile_encoding.find(left);
-  if (it_left == tile_encoding.end()) {
+  const TileEncoding* tile_left = FindTile(left);
+  if (tile_left == nullptr) {
     return;
   }
-  const auto it_right = tile_encoding.find(right);
-  if (it_right == tile_encoding.end()) {
+  const TileEncoding* tile_right = FindTile(right);
+  if (tile_right == nullptr) {
     return;
   }
 
-  if (it_left->second.right == 0 && it_right->second.left != 0) {
-    TileEncoding encoding_left = it_left->second;
-    encoding_left.right = it_right->second.left;
-    const auto it_left_upgrade = tile_encoding_inverse.find(encoding_left);
-    if (it_left_upgrade != tile_encoding_inverse.end()) {
-      left = it_left_upgrade->second;
+  if (tile_left->right == 0 && tile_right->left != 0) {
+    TileEncoding encoding_left = *tile_left;
+    encoding_left.right = tile_right->left;
+    const int upgrade = tile_tables.inverse[TileKey(encoding_left)];  // NOLINT
+    if (upgrade >= 0) {
+      SetBoxDrawing(left, upgrade);
     }
   }
 
-  if (it_right->second.left == 0 && it_left->second.right != 0) {
-    TileEncoding encoding_right = it_right->second;
-    encoding_right.left = it_left->second.right;
-    const auto it_right_upgrade = tile_encoding_inverse.find(encoding_right);
-    if (it_right_upgrade != tile_encoding_inverse.end()) {
-      right = it_right_upgrade->second;
+  if (tile_right->left == 0 && tile_left->right != 0) {
+    TileEncoding encoding_right = *tile_right;
+    encoding_right.left = tile_left->right;
+    const int upgrade = tile_tables.inverse[TileKey(encoding_right)];  // NOLINT
+    if (upgrade >= 0) {
+      SetBoxDrawing(right, upgrade);
     }
   }
 }
 
 void UpgradeTopDown(std::string& top, std::string& down) {
-  const auto it_top = tile_encoding.find(top);
-  if (it_top == tile_encoding.end()) {
+  const TileEncoding* tile_top = FindTile(top);
+  if (tile_top == nullptr) {
     return;
   }
-  const auto it_down = tile_encoding.find(down);
-  if (it_down == tile_encoding.end()) {
+  const TileEncoding* tile_down = FindTile(down);
+  if (tile_down == nullptr) {
     return;
   }
 
-  if (it_top->second.down == 0 && it_down->second.top != 0) {
-    TileEncoding encoding_top = it_top->second;
-    encoding_top.down = it_down->second.top;
-    const auto it_top_down = tile_encoding_inverse.find(encoding_top);
-    if (it_top_down != tile_encoding_inverse.end()) {
-      top = it_top_down->second;
+  if (tile_top->down == 0 && tile_down->top != 0) {
+    TileEncoding encoding_top = *tile_top;
+    encoding_top.down = tile_down->top;
+    const int upgrade = tile_tables.inverse[TileKey(encoding_top)];  // NOLINT
+    if (upgrade >= 0) {
+      SetBoxDrawing(top, upgrade);
     }
   }
 
-  if (it_down->second.top == 0 && it_top->second.down != 0) {
-    TileEncoding encoding_down = it_down->second;
-    encoding_down.top = it_top->second.down;
-    const auto it_down_top = tile_encoding_inverse.find(encoding_down);
-    if (it_down_top != tile_encoding_inverse.end()) {
-      down = it_down_top->second;
+  if (tile_down->top == 0 && tile_top->down != 0) {
+    TileEncoding encoding_down = *tile_down;
+    encoding_down.top = tile_top->down;
+    const int upgrade = tile_tables.inverse[TileKey(encoding_down)];  // NOLINT
+    if (upgrade >= 0) {
+      SetBoxDrawing(down, upgrade);
     }
   }
 }
@@ -363,6 +574,246 @@ bool ShouldAttemptAutoMerge(Pixel& pixel) {
   return pixel.automerge && pixel.character.size() == 3;
 }
 
+// Whether the pixel is drawn over two cells. This is called for every cell
+// when serializing the screen. A single byte can't represent a fullwidth
+// glyph, so this avoids decoding the most frequent case: ASCII. Then, most
+// pixels hold a single codepoint, like the box drawing and braille characters.
+bool IsFullWidth(const Pixel& pixel) {
+  if (FTXUI_LIKELY(pixel.character.size() <= 1)) {
+    return false;
+  }
+  uint32_t codepoint = 0;
+  size_t end = 0;
+  if (EatCodePoint(pixel.character, 0, &end, &codepoint) &&
+      end == pixel.character.size()) {
+    return ftxui::IsFullWidth(codepoint);
+  }
+  return string_width(pixel.character) == 2;
+}
+
+// Whether a pixel is drawn as a blank cell with the default style, like the
+// cells cleared by the erase sequences.
+bool IsBlank(const Pixel& pixel) {
+  return (pixel.character.empty() || pixel.character == " ") &&  //
+         StyleOf(pixel) == 0 && pixel.hyperlink == 0;
+}
+
+// Whether a pixel holds a single narrow codepoint, that the REP sequence can
+// repeat.
+bool IsRepeatable(const Pixel& pixel) {
+  uint32_t codepoint = 0;
+  size_t end = 0;
+  return !pixel.character.empty() &&
+         EatCodePoint(pixel.character, 0, &end, &codepoint) &&
+         end == pixel.character.size() && !IsCombining(codepoint) &&
+         !ftxui::IsFullWidth(codepoint);
+}
+
+// Whether two pixels, possibly belonging to different screens, are drawn the
+// same way on the terminal.
+bool SamePixel(const Screen& screen_a,
+               const Pixel& a,
+               const Screen& screen_b,
+               const Pixel& b) {
+  return StyleOf(a) == StyleOf(b) &&   //
+         a.character == b.character &&  //
+         screen_a.Hyperlink(a.hyperlink) == screen_b.Hyperlink(b.hyperlink);
+}
+
+void AppendNumber(std::string& out, int value) {
+  std::array<char, 16> buffer{};
+  const auto result =
+      std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+  out.append(buffer.data(), result.ptr);
+}
+
+void MoveCursorDown(std::string& out, int n) {
+  if (n > 0) {
+    out += "\x1B[";
+    AppendNumber(out, n);
+    out += "B";
+  }
+}
+
+void MoveCursorRight(std::string& out, int n) {
+  if (n > 0) {
+    out += "\x1B[";
+    AppendNumber(out, n);
+    out += "C";
+  }
+}
+
+void MoveCursorUp(std::string& out, int n) {
+  if (n > 0) {
+    out += "\x1B[";
+    AppendNumber(out, n);
+    out += "A";
+  }
+}
+
+// Below this many cells, a screen is encoded by a single thread.
+const int kParallelCells = 16384;
+// The rows encoded by each task. Several blocks per thread balance the rows
+// costing more than the others.
+const int kRowsPerBlock = 8;
+
+// Append to |output| the rows [0, dimy) encoded by |encode(y_min, y_max,
+// block)|, by blocks of kRowsPerBlock rows, on the threads of |parallel_for|.
+// The first block is encoded into |output| directly, the others into their own
+// buffer, appended in order. Return what |encode| returned for the last block.
+template <class Encode>
+bool AppendRowsByBlocks(int dimy,
+                        const Screen::ParallelFor& parallel_for,
+                        std::string& output,
+                        Encode encode) {
+  const int blocks = (dimy + kRowsPerBlock - 1) / kRowsPerBlock;
+  std::vector<std::string> buffers(size_t(std::max(0, blocks - 1)));
+  bool last = false;
+  parallel_for(size_t(blocks), [&](size_t i) {
+    const int y_min = int(i) * kRowsPerBlock;
+    const int y_max = std::min(dimy, y_min + kRowsPerBlock);
+    std::string& block = i == 0 ? output : buffers[i - 1];
+    const bool result = encode(y_min, y_max, block);
+    if (int(i) == blocks - 1) {
+      last = result;
+    }
+  });
+
+  size_t size = output.size();
+  for (const std::string& buffer : buffers) {
+    size += buffer.size();
+  }
+  output.reserve(size);
+  for (const std::string& buffer : buffers) {
+    output += buffer;
+  }
+  return last;
+}
+
+// A cheap fingerprint of a row: the characters and the attributes, but not
+// the colors nor the hyperlinks. Two rows with different fingerprints differ.
+uint64_t HashRow(const Pixel* row, int size) {
+  uint64_t hash = 14695981039346656037ULL;  // NOLINT
+  auto mix = [&](uint64_t value) {
+    hash ^= value;
+    hash *= 1099511628211ULL;  // NOLINT
+  };
+  for (int x = 0; x < size; ++x) {
+    const Pixel& pixel = row[x];
+    for (const char c : pixel.character) {
+      mix(static_cast<unsigned char>(c));
+    }
+    mix(0x100U | (pixel.bold ? 0x1U : 0U) | (pixel.dim ? 0x2U : 0U) |  //
+        (pixel.inverted ? 0x4U : 0U) | (pixel.underlined ? 0x8U : 0U) |
+        (pixel.blink ? 0x10U : 0U) | (pixel.strikethrough ? 0x20U : 0U) |
+        (pixel.underlined_double ? 0x40U : 0U));
+  }
+  return hash;
+}
+
+// A block of rows found in the previous screen, shifted vertically.
+struct RowShift {
+  int top = 0;     // The first row of the block, in the next screen.
+  int size = 0;    // The number of rows. Zero when there is no shift.
+  int offset = 0;  // The block was at |top + offset| in the previous screen.
+};
+
+// Find the shift saving the most rows from being rewritten. A shift is worth
+// it only when it saves at least |min_saved| rows, scrolling costs a few
+// bytes.
+RowShift FindRowShift(const std::vector<uint64_t>& next,
+                      const std::vector<uint64_t>& previous,
+                      int min_saved) {
+  const int dimy = static_cast<int>(next.size());
+  RowShift best;
+  int best_saved = min_saved - 1;
+  for (int offset = 1 - dimy; offset < dimy; ++offset) {
+    if (offset == 0) {
+      continue;
+    }
+    const int y_begin = std::max(0, -offset);
+    const int y_end = std::min(dimy, dimy - offset);
+    int top = y_begin;
+    int saved = 0;
+    for (int y = y_begin; y <= y_end; ++y) {
+      if (y != y_end && next[y] == previous[y + offset]) {
+        saved += next[y] != previous[y] ? 1 : 0;
+        continue;
+      }
+      if (saved > best_saved) {
+        best_saved = saved;
+        best = {top, y - top, offset};
+      }
+      top = y + 1;
+      saved = 0;
+    }
+  }
+  return best;
+}
+
+// The snapshots: see Screen::ToSnapshot().
+const char kSnapshotMagic[] = "FTXP";
+const uint64_t kSnapshotVersion = 1;
+
+// LEB128 varints, the signed integers being zigzag encoded.
+void AppendVarint(std::string& out, uint64_t value) {
+  while (value >= 0x80) {                // NOLINT
+    out += char((value & 0x7F) | 0x80);  // NOLINT
+    value >>= 7;                         // NOLINT
+  }
+  out += char(value);
+}
+
+void AppendSigned(std::string& out, int value) {
+  const auto wide = int64_t(value);
+  AppendVarint(out, (uint64_t(wide) << 1) ^ uint64_t(wide >> 63));  // NOLINT
+}
+
+void AppendBytes(std::string& out, const std::string& value) {
+  AppendVarint(out, value.size());
+  out += value;
+}
+
+// Read the values appended above. Once something is malformed, |ok| is false
+// and every value read is 0.
+struct SnapshotReader {
+  std::string_view in;
+  bool ok = true;
+
+  uint64_t Varint() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64 && ok; shift += 7) {  // NOLINT
+      if (in.empty()) {
+        break;
+      }
+      const auto byte = uint8_t(in[0]);
+      in.remove_prefix(1);
+      value |= uint64_t(byte & 0x7F) << shift;  // NOLINT
+      if ((byte & 0x80) == 0) {                 // NOLINT
+        return value;
+      }
+    }
+    ok = false;
+    return 0;
+  }
+
+  int Signed() {
+    const uint64_t value = Varint();
+    return int(int64_t(value >> 1) ^ -int64_t(value & 1));  // NOLINT
+  }
+
+  std::string Bytes() {
+    const uint64_t size = Varint();
+    if (!ok || size > in.size()) {
+      ok = false;
+      return "";
+    }
+    std::string value(in.substr(0, size));
+    in.remove_prefix(size);
+    return value;
+  }
+};
+
 }  // namespace
 
 /// A fixed dimension.
@@ -409,39 +860,639 @@ Screen::Screen(int dimx, int dimy) : Image{dimx, dimy} {
 /// @note Don't forget to flush stdout. Alternatively, you can use
 /// Screen::Print();
 std::string Screen::ToString() const {
-  std::stringstream ss;
+  std::string output;
+  ToString(output);
+  return output;
+}
+
+/// Append to |output| what can be used to print the Screen on the terminal.
+/// Reusing the same |output| buffer in between frames avoids allocating.
+/// @param output The buffer to append to.
+void Screen::ToString(std::string& output) const {
+  AppendRows(0, dimy_, output);
+  AppendBitmaps(/*full=*/true, output);
+}
 
-  const Pixel default_pixel;
-  const Pixel* previous_pixel_ref = &default_pixel;
+/// Append to |output| what can be used to print the Screen on the terminal,
+/// like ToString(), encoding the rows by blocks on several threads.
+/// @param output The buffer to append to.
+/// @param parallel_for Call its function for every index in [0, count), on
+/// any thread, and return once done.
+///
+/// Every row starts from the default style: the blocks are encoded into their
+/// own buffer, independently, then appended in order. The output is the one of
+/// ToString(). The small screens are encoded by the calling thread only.
+///
+/// ### Example
+///
+/// ```cpp
+/// WorkerPool pool;
+/// screen.ToString(output, [&](size_t count, auto& fn) {
+///   pool.ParallelFor(count, fn);
+/// });
+/// ```
+void Screen::ToString(std::string& output,
+                      const ParallelFor& parallel_for) const {
+  if (!parallel_for || dimx_ * dimy_ < kParallelCells) {
+    ToString(output);
+    return;
+  }
+  AppendRowsByBlocks(dimy_, parallel_for, output,
+                     [this](int y_min, int y_max, std::string& block) {
+                       AppendRows(y_min, y_max, block);
+                       return false;
+                     });
+  AppendBitmaps(/*full=*/true, output);
+}
 
-  for (int y = 0; y < dimy_; ++y) {
+// Append the rows [y_min, y_max) of ToString(). The style is the default one
+// before and after them.
+void Screen::AppendRows(int y_min, int y_max, std::string& output) const {
+  StyleWriter style(this, output);
+
+  for (int y = y_min; y < y_max; ++y) {
     // New line in between two lines.
     if (y != 0) {
-      UpdatePixelStyle(this, ss, *previous_pixel_ref, default_pixel);
-      previous_pixel_ref = &default_pixel;
-      ss << "\r\n";
+      style.Reset();
+      output += "\r\n";
+    }
+
+    // A row never written is made of default pixels.
+    if (TouchedSpanAt(y).IsEmpty()) {
+      output.append(dimx_, ' ');
+      continue;
     }
 
     // After printing a fullwith character, we need to skip the next cell.
     bool previous_fullwidth = false;
-    for (const auto& pixel : pixels_[y]) {
+    const Pixel* line = RowAt(y);
+    for (int x = 0; x < dimx_; ++x) {
+      const Pixel& pixel = line[x];
       if (!previous_fullwidth) {
-        UpdatePixelStyle(this, ss, *previous_pixel_ref, pixel);
-        previous_pixel_ref = &pixel;
+        style.Write(pixel);
         if (pixel.character.empty()) {
-          ss << " ";
+          output += " ";
         } else {
-          ss << pixel.character;
+          output += pixel.character;
         }
       }
-      previous_fullwidth = (string_width(pixel.character) == 2);
+      previous_fullwidth = IsFullWidth(pixel);
     }
   }
 
   // Reset the style to default:
-  UpdatePixelStyle(this, ss, *previous_pixel_ref, default_pixel);
+  style.Reset();
+}
 
-  return ss.str();
+/// Produce a std::string printing the Screen on the terminal, like ToString(),
+/// but shorter. The runs of blank cells are erased instead of written, and the
+/// runs of repeated characters use the REP sequence when the terminal supports
+/// it. See Terminal::SetRepeatSupport().
+///
+/// The cursor ends at the same position as after printing ToString().
+std::string Screen::ToCompactString() const {
+  std::string output;
+  ToCompactString(output);
+  return output;
+}
+
+/// Append to |output| what prints the Screen on the terminal. See
+/// ToCompactString().
+/// @param output The buffer to append to.
+void Screen::ToCompactString(std::string& output) const {
+  const bool erased_end = AppendCompactRows(0, dimy_, output);
+
+  // Leave the cursor where ToString() would have left it.
+  if (erased_end) {
+    output += "\r";
+    MoveCursorRight(output, dimx_);
+  }
+  AppendBitmaps(/*full=*/true, output);
+}
+
+/// Append to |output| what prints the Screen on the terminal, like
+/// ToCompactString(), encoding the rows by blocks on several threads. See
+/// ToString(std::string&, const ParallelFor&).
+/// @param output The buffer to append to.
+/// @param parallel_for Call its function for every index in [0, count), on
+/// any thread, and return once done.
+void Screen::ToCompactString(std::string& output,
+                             const ParallelFor& parallel_for) const {
+  if (!parallel_for || dimx_ * dimy_ < kParallelCells) {
+    ToCompactString(output);
+    return;
+  }
+  const bool erased_end = AppendRowsByBlocks(
+      dimy_, parallel_for, output,
+      [this](int y_min, int y_max, std::string& block) {
+        return AppendCompactRows(y_min, y_max, block);
+      });
+
+  // Leave the cursor where ToString() would have left it.
+  if (erased_end) {
+    output += "\r";
+    MoveCursorRight(output, dimx_);
+  }
+  AppendBitmaps(/*full=*/true, output);
+}
+
+// Append the rows [y_min, y_max) of ToCompactString(). The style is the
+// default one before and after them. Return whether the end of the last row
+// was erased instead of written.
+bool Screen::AppendCompactRows(int y_min,
+                               int y_max,
+                               std::string& output) const {
+  StyleWriter style(this, output);
+  const bool repeat = Terminal::RepeatSupport();
+  bool erased_end = false;
+
+  // Below these lengths, writing the cells is cheaper than the sequences.
+  const int min_erased_run = 12;
+  const int min_repeated_bytes = 8;
+
+  auto write = [&](const Pixel& pixel) {
+    style.Write(pixel);
+    if (pixel.character.empty()) {
+      output += " ";
+    } else {
+      output += pixel.character;
+    }
+  };
+
+  for (int y = y_min; y < y_max; ++y) {
+    // New line in between two lines.
+    if (y != 0) {
+      style.Reset();
+      output += "\r\n";
+    }
+
+    // The blank cells ending the row are erased at once. Outside of the
+    // touched span, the pixels are known to be blank.
+    const Pixel* line = RowAt(y);
+    const TouchedSpan& span = TouchedSpanAt(y);
+    int x_end = span.IsEmpty() ? 0 : std::min(dimx_, span.x_max + 1);
+    while (x_end > 0 && IsBlank(line[x_end - 1])) {
+      --x_end;
+    }
+    // On the last row, the cursor must also be moved back to the end.
+    const int min_erased_end = y == dimy_ - 1 ? 10 : 3;
+    if (dimx_ - x_end < min_erased_end) {
+      x_end = dimx_;
+    }
+
+    int x = 0;
+    while (x < x_end) {
+      const Pixel& pixel = line[x];
+
+      if (IsBlank(pixel)) {
+        int run = 1;
+        while (x + run < x_end && IsBlank(line[x + run])) {
+          ++run;
+        }
+        if (run >= min_erased_run) {
+          style.Reset();
+          output += "\x1B[";
+          AppendNumber(output, run);
+          output += "X\x1B[";
+          AppendNumber(output, run);
+          output += "C";
+          x += run;
+          continue;
+        }
+      }
+
+      write(pixel);
+      if (IsFullWidth(pixel)) {
+        x += 2;
+        continue;
+      }
+      ++x;
+
+      if (!repeat || !IsRepeatable(pixel)) {
+        continue;
+      }
+      int run = 0;
+      while (x + run < x_end &&
+             SamePixel(*this, line[x + run], *this, pixel)) {
+        ++run;
+      }
+      if (run * static_cast<int>(pixel.character.size()) <
+          min_repeated_bytes) {
+        continue;
+      }
+      output += "\x1B[";
+      AppendNumber(output, run);
+      output += "b";
+      x += run;
+    }
+
+    erased_end = x_end != dimx_;
+    if (erased_end) {
+      style.Reset();
+      output += "\x1B[K";
+    }
+  }
+
+  // Reset the style to default:
+  style.Reset();
+  return erased_end;
+}
+
+/// Produce a std::string updating the terminal from |previous| to this Screen.
+/// Only the cells that changed are written, the cursor is moved over the other
+/// ones.
+///
+/// The terminal cursor is expected to be at the top-left corner of
+/// |previous|, as left by ResetPosition(). It ends at the same position as
+/// after printing ToString(). When the dimensions differ, this falls back to
+/// ToCompactString().
+/// @param previous The Screen currently displayed by the terminal.
+std::string Screen::ToDiffString(const Screen& previous) const {
+  std::string output;
+  ToDiffString(previous, output);
+  return output;
+}
+
+/// Append to |output| what updates the terminal from |previous| to this
+/// Screen. See ToDiffString(previous).
+/// @param previous The Screen currently displayed by the terminal.
+/// @param output The buffer to append to.
+void Screen::ToDiffString(const Screen& previous, std::string& output) const {
+  if (previous.dimx_ != dimx_ || previous.dimy_ != dimy_) {
+    ToCompactString(output);
+    return;
+  }
+
+  StyleWriter style(this, output);
+
+  // Position of the terminal cursor, relative to the top-left corner.
+  int cursor_x = 0;
+  int cursor_y = 0;
+
+  // When a block of rows moved vertically, like a scrolling log, the terminal
+  // shifts it with "delete lines" and "insert lines" instead of repainting it.
+  // |source_rows| is the row of |previous| displayed at each row afterward, or
+  // -1 for a blank row.
+  std::vector<int> source_rows;
+  std::vector<Pixel> blank_row;
+  const TouchedSpan blank_span;
+  if (dimy_ >= 3) {
+    std::vector<uint64_t> hashes(dimy_);
+    std::vector<uint64_t> previous_hashes(dimy_);
+    for (int y = 0; y < dimy_; ++y) {
+      hashes[y] = HashRow(RowAt(y), dimx_);
+      previous_hashes[y] = HashRow(previous.RowAt(y), dimx_);
+    }
+    RowShift shift = FindRowShift(hashes, previous_hashes, /*min_saved=*/2);
+
+    // The fingerprints ignore the colors, check the rows really match.
+    for (int y = shift.top; y < shift.top + shift.size; ++y) {
+      const Pixel* line = RowAt(y);
+      const Pixel* previous_line = previous.RowAt(y + shift.offset);
+      for (int x = 0; x < dimx_; ++x) {
+        if (!SamePixel(*this, line[x], previous, previous_line[x])) {
+          shift.size = 0;
+          break;
+        }
+      }
+    }
+
+    if (shift.size != 0) {
+      source_rows.resize(dimy_);
+      for (int y = 0; y < dimy_; ++y) {
+        source_rows[y] = y;
+      }
+      const int n = std::abs(shift.offset);
+      std::string count;
+      AppendNumber(count, n);
+      if (shift.offset > 0) {
+        // Scroll up: delete the rows above the block, and insert blank ones
+        // below it.
+        MoveCursorDown(output, shift.top);
+        output += "\x1B[" + count + "M";
+        MoveCursorDown(output, shift.size);
+        output += "\x1B[" + count + "L";
+        MoveCursorUp(output, shift.top + shift.size);
+        for (int y = shift.top; y < shift.top + shift.size; ++y) {
+          source_rows[y] = y + n;
+        }
+        for (int y = shift.top + shift.size; y < shift.top + shift.size + n;
+             ++y) {
+          source_rows[y] = -1;
+        }
+      } else {
+        // Scroll down: delete the rows below the block, and insert blank ones
+        // above it.
+        MoveCursorDown(output, shift.top + shift.size - n);
+        output += "\x1B[" + count + "M";
+        MoveCursorUp(output, shift.size);
+        output += "\x1B[" + count + "L";
+        MoveCursorUp(output, shift.top - n);
+        for (int y = shift.top; y < shift.top + shift.size; ++y) {
+          source_rows[y] = y - n;
+        }
+        for (int y = shift.top - n; y < shift.top; ++y) {
+          source_rows[y] = -1;
+        }
+      }
+      output += "\r";  // Back to the top-left corner.
+      blank_row.resize(dimx_);
+    }
+  }
+
+  for (int y = 0; y < dimy_; ++y) {
+    const int source_y = source_rows.empty() ? y : source_rows[y];
+    const Pixel* line = RowAt(y);
+    const Pixel* previous_line =
+        source_y >= 0 ? previous.RowAt(source_y) : blank_row.data();
+
+    auto changed = [&](int x) {
+      return !SamePixel(*this, line[x], previous, previous_line[x]);
+    };
+
+    // A cell must be written when it changed, or when it was or is covered by
+    // a fullwidth character being rewritten.
+    auto needs_write = [&](int x) {
+      if (changed(x)) {
+        return true;
+      }
+      return x > 0 && (IsFullWidth(line[x - 1]) ||  //
+                       IsFullWidth(previous_line[x - 1])) &&
+             changed(x - 1);
+    };
+
+    // Moving the cursor costs a few bytes. Rewriting short unchanged gaps in
+    // between two changed runs is cheaper.
+    const int max_gap = 3;
+    auto needs_write_soon = [&](int x) {
+      for (int i = x; i < std::min(x + max_gap, dimx_); ++i) {
+        if (needs_write(i)) {
+          return true;
+        }
+      }
+      return false;
+    };
+
+    // Outside of the touched spans, both rows are made of default pixels. One
+    // more cell is checked, in case the last one is fullwidth.
+    const TouchedSpan& span = TouchedSpanAt(y);
+    const TouchedSpan& previous_span =
+        source_y >= 0 ? previous.TouchedSpanAt(source_y) : blank_span;
+    if (span.IsEmpty() && previous_span.IsEmpty()) {
+      continue;
+    }
+    const int x_end =
+        std::min(dimx_, std::max(span.x_max, previous_span.x_max) + 2);
+
+    int x = std::min(span.x_min, previous_span.x_min);
+    while (x < x_end) {
+      if (!needs_write(x)) {
+        ++x;
+        continue;
+      }
+
+      // The second half of a fullwidth character can't be written alone.
+      if (x > 0 && IsFullWidth(line[x - 1])) {
+        --x;
+      }
+
+      MoveCursorDown(output, y - cursor_y);
+      cursor_y = y;
+      if (x < cursor_x) {
+        output += "\r";
+        cursor_x = 0;
+      }
+      MoveCursorRight(output, x - cursor_x);
+
+      while (x < dimx_ && needs_write_soon(x)) {
+        const Pixel& pixel = line[x];
+        style.Write(pixel);
+        if (pixel.character.empty()) {
+          output += " ";
+        } else {
+          output += pixel.character;
+        }
+        x += IsFullWidth(pixel) ? 2 : 1;
+      }
+      cursor_x = x;
+    }
+  }
+
+  // Reset the style to default:
+  style.Reset();
+
+  // Leave the cursor where ToString() would have left it.
+  MoveCursorDown(output, dimy_ - 1 - cursor_y);
+  if (cursor_x != dimx_) {
+    output += "\r";
+    MoveCursorRight(output, dimx_);
+  }
+  AppendBitmaps(/*full=*/false, output);
+}
+
+/// @brief Return a compact binary snapshot of the pixels: their characters,
+/// their style and their hyperlink, with the size and the cursor. To store
+/// the expected result of a test, compared using FromSnapshot() and Diff().
+///
+/// The distinct styles are listed once, and the pixels refer to them by
+/// index. The runs of identical pixels, like the blank ones, are stored once.
+std::string Screen::ToSnapshot() const {
+  std::string output = kSnapshotMagic;
+  AppendVarint(output, kSnapshotVersion);
+  AppendVarint(output, uint64_t(dimx_));
+  AppendVarint(output, uint64_t(dimy_));
+  AppendSigned(output, cursor_.x);
+  AppendSigned(output, cursor_.y);
+  AppendVarint(output, uint64_t(cursor_.shape));
+
+  AppendVarint(output, hyperlinks_.size());
+  for (const auto& link : hyperlinks_) {
+    AppendBytes(output, link);
+  }
+
+  // The styles, in order of appearance, with the pixels referring to them.
+  std::map<std::pair<uint64_t, uint16_t>, size_t> style_ids;
+  std::string styles;
+  std::string runs;
+  const auto* begin = pixels_.data();
+  const auto* end = begin + pixels_.size();
+  for (const auto* pixel = begin; pixel != end;) {
+    const auto* run_end = pixel + 1;
+    while (run_end != end && SamePixel(*this, *run_end, *this, *pixel)) {
+      ++run_end;
+    }
+    const auto style = std::make_pair(StyleOf(*pixel), pixel->hyperlink);
+    auto it = style_ids.find(style);
+    if (it == style_ids.end()) {
+      it = style_ids.emplace(style, style_ids.size()).first;
+      AppendVarint(styles, style.first);
+      AppendVarint(styles, style.second);
+    }
+    AppendVarint(runs, uint64_t(run_end - pixel));
+    AppendVarint(runs, it->second);
+    AppendBytes(runs, pixel->character);
+    pixel = run_end;
+  }
+  AppendVarint(output, style_ids.size());
+  output += styles;
+  output += runs;
+  return output;
+}
+
+/// @brief Restore a Screen from ToSnapshot().
+/// @param snapshot The snapshot.
+/// @param screen The Screen to restore.
+/// @return false if the snapshot is malformed. |screen| is unchanged then.
+// static
+bool Screen::FromSnapshot(std::string_view snapshot, Screen* screen) {
+  const std::string_view magic = kSnapshotMagic;
+  if (snapshot.substr(0, magic.size()) != magic) {
+    return false;
+  }
+  SnapshotReader in{snapshot.substr(magic.size())};
+  const uint64_t version = in.Varint();
+  const uint64_t dimx = in.Varint();
+  const uint64_t dimy = in.Varint();
+  const int max_dimension = 1 << 16;
+  if (!in.ok || version != kSnapshotVersion || dimx > max_dimension ||
+      dimy > max_dimension) {
+    return false;
+  }
+
+  Screen result(static_cast<int>(dimx), static_cast<int>(dimy));
+  result.cursor_.x = in.Signed();
+  result.cursor_.y = in.Signed();
+  result.cursor_.shape = Cursor::Shape(in.Varint());
+
+  const uint64_t link_count = in.Varint();
+  if (link_count == 0 || link_count > in.in.size()) {
+    return false;
+  }
+  in.Bytes();  // The link 0 is no link.
+  for (uint64_t i = 1; i < link_count && in.ok; ++i) {
+    result.hyperlinks_.push_back(in.Bytes());
+    result.hyperlink_ids_.emplace(result.hyperlinks_.back(), uint16_t(i));
+  }
+
+  // Each style is read into a pixel, copied by the runs using it.
+  const uint64_t style_count = in.Varint();
+  if (!in.ok || style_count > in.in.size()) {
+    return false;
+  }
+  // The inverse of StyleOf().
+  const uint64_t color_mask = (1 << 26) - 1;
+  std::vector<Pixel> styles(style_count);
+  std::vector<bool> default_styles(style_count);
+  for (size_t i = 0; i < styles.size(); ++i) {
+    Pixel& pixel = styles[i];
+    const uint64_t style = in.Varint();
+    const uint64_t hyperlink = in.Varint();
+    const uint64_t attributes = style >> 52;  // NOLINT
+    pixel.foreground_color = Color::FromKey(style & color_mask);
+    pixel.background_color = Color::FromKey((style >> 26) & color_mask);
+    pixel.bold = (attributes & 0x1) != 0;               // NOLINT
+    pixel.dim = (attributes & 0x2) != 0;                // NOLINT
+    pixel.underlined = (attributes & 0x4) != 0;         // NOLINT
+    pixel.underlined_double = (attributes & 0x8) != 0;  // NOLINT
+    pixel.blink = (attributes & 0x10) != 0;             // NOLINT
+    pixel.inverted = (attributes & 0x20) != 0;          // NOLINT
+    pixel.strikethrough = (attributes & 0x40) != 0;     // NOLINT
+    pixel.hyperlink = uint16_t(hyperlink);
+    in.ok &= hyperlink < link_count;
+    default_styles[i] = style == 0 && hyperlink == 0;
+  }
+
+  uint64_t x = 0;
+  uint64_t y = 0;
+  while (in.ok && y < dimy) {
+    const uint64_t length = in.Varint();
+    const uint64_t style = in.Varint();
+    std::string character = in.Bytes();
+    if (!in.ok || length == 0 || style >= style_count) {
+      return false;
+    }
+    // The default pixels are left untouched.
+    const bool blank = default_styles[style] && character.empty();
+    for (uint64_t i = 0; i < length; ++i) {
+      if (y >= dimy) {
+        return false;
+      }
+      if (!blank) {
+        Pixel& pixel = result.PixelAt(int(x), int(y));
+        pixel = styles[style];
+        pixel.character = character;
+      }
+      if (++x == dimx) {
+        x = 0;
+        ++y;
+      }
+    }
+  }
+  if (!in.ok || !in.in.empty()) {
+    return false;
+  }
+  *screen = std::move(result);
+  return true;
+}
+
+/// @brief Return the rectangles covering the pixels drawn differently in
+/// |other|. Empty when both are drawn the same way. The whole Screen when their
+/// sizes differ.
+///
+/// The pixels are compared like ToDiffString() does: by their character, their
+/// style and the target of their hyperlink. A rectangle covers a run of
+/// changed pixels of a row, extended downward while the next rows have the
+/// same run.
+std::vector<Box> Screen::Diff(const Screen& other) const {
+  if (dimx_ != other.dimx_ || dimy_ != other.dimy_) {
+    return {Box{0, std::max(dimx_, other.dimx_) - 1,  //
+                0, std::max(dimy_, other.dimy_) - 1}};
+  }
+
+  std::vector<Box> boxes;
+  // The boxes ending on the previous row, that the current one can extend.
+  size_t open_begin = 0;
+  for (int y = 0; y < dimy_; ++y) {
+    // Outside of the touched spans, both rows are made of default pixels.
+    const TouchedSpan& span = TouchedSpanAt(y);
+    const TouchedSpan& other_span = other.TouchedSpanAt(y);
+    const size_t open_end = boxes.size();
+    const int x_end =
+        std::min(dimx_, std::max(span.x_max, other_span.x_max) + 1);
+    const Pixel* line = RowAt(y);
+    const Pixel* other_line = other.RowAt(y);
+    for (int x = std::min(span.x_min, other_span.x_min); x < x_end;) {
+      if (SamePixel(*this, line[x], other, other_line[x])) {
+        ++x;
+        continue;
+      }
+      const int x_min = x;
+      while (x < x_end && !SamePixel(*this, line[x], other, other_line[x])) {
+        ++x;
+      }
+      const int x_max = x - 1;
+
+      bool extended = false;
+      for (size_t i = open_begin; i < open_end; ++i) {
+        Box& box = boxes[i];
+        if (box.x_min == x_min && box.x_max == x_max && box.y_max == y - 1) {
+          box.y_max = y;
+          extended = true;
+          break;
+        }
+      }
+      if (!extended) {
+        boxes.push_back(Box{x_min, x_max, y, y});
+      }
+    }
+
+    // Only the boxes reaching this row can be extended further.
+    auto reaching = std::stable_partition(
+        boxes.begin() + long(open_begin), boxes.end(),
+        [y](const Box& box) { return box.y_max != y; });
+    open_begin = size_t(reaching - boxes.begin());
+  }
+  return boxes;
 }
 
 // Print the Screen to the terminal.
@@ -493,30 +1544,59 @@ void Screen::Clear() {
   cursor_.x = dimx_ - 1;
   cursor_.y = dimy_ - 1;
 
-  hyperlinks_ = {
-      "",
-  };
+  // Keep the storage, and the empty link with id 0.
+  hyperlinks_.resize(1);
+  hyperlink_ids_.clear();
+  bitmaps_.clear();
+  live_cells_.clear();
+}
+
+/// @brief The number of bytes allocated by the screen.
+/// Like Image::MemoryUsage(), with the hyperlinks registered.
+size_t Screen::MemoryUsage() const {
+  size_t bytes = Image::MemoryUsage() +
+                 hyperlinks_.capacity() * sizeof(std::string) +
+                 hyperlink_ids_.bucket_count() * sizeof(void*);
+  const size_t inline_capacity = std::string().capacity();
+  for (const auto& link : hyperlinks_) {
+    // Once in |hyperlinks_|, once as a key of |hyperlink_ids_|.
+    if (link.capacity() > inline_capacity) {
+      bytes += 2 * (link.capacity() + 1);
+    }
+  }
+  return bytes;
+}
+
+/// @brief Release the storage not needed by the current screen.
+/// Like Image::ShrinkToFit(), with the hyperlinks registered.
+void Screen::ShrinkToFit() {
+  Image::ShrinkToFit();
+  hyperlinks_.shrink_to_fit();
+  hyperlink_ids_.rehash(0);
 }
 
 // clang-format off
 void Screen::ApplyShader() {
-  // Merge box characters togethers.
-  for (int y = 0; y < dimy_; ++y) {
-    for (int x = 0; x < dimx_; ++x) {
+  // Merge box characters togethers. Pixels to merge have been written. They
+  // belong to the touched spans, the rows left blank are skipped.
+  for (const int y : TouchedRows()) {
+    const TouchedSpan& span = TouchedSpanAt(y);
+    Pixel* line = RowAt(y);
+    for (int x = span.x_min; x <= span.x_max; ++x) {
       // Box drawing character uses exactly 3 byte.
-      Pixel& cur = pixels_[y][x];
+      Pixel& cur = line[x];
       if (!ShouldAttemptAutoMerge(cur)) {
         continue;
       }
 
       if (x > 0) {
-        Pixel& left = pixels_[y][x-1];
+        Pixel& left = line[x-1];
         if (ShouldAttemptAutoMerge(left)) {
           UpgradeLeftRight(left.character, cur.character);
         }
       }
       if (y > 0) {
-        Pixel& top = pixels_[y-1][x];
+        Pixel& top = line[x - dimx_];
         if (ShouldAttemptAutoMerge(top)) {
           UpgradeTopDown(top.character, cur.character);
         }
@@ -526,20 +1606,212 @@ void Screen::ApplyShader() {
 }
 // clang-format on
 
-std::uint8_t Screen::RegisterHyperlink(const std::string& link) {
-  for (std::size_t i = 0; i < hyperlinks_.size(); ++i) {
-    if (hyperlinks_[i] == link) {
-      return i;
+/// @brief Place |bitmap| over the cells of |box|. When the screen is printed,
+/// it is sent to the terminal after the cells, see Terminal::GraphicsSupport().
+///
+/// With the kitty protocol, the pixels are transmitted once, and only placed
+/// on the next frames. A bitmap whose placement didn't change since the last
+/// ToDiffString() costs nothing. Sixel images have no id: they are sent again
+/// whenever they are drawn, but not by ToDiffString() when they didn't move.
+void Screen::PlaceBitmap(std::shared_ptr<const Bitmap> bitmap,
+                         const Box& box) {
+  if (bitmap && !box.IsEmpty()) {
+    bitmaps_.push_back({std::move(bitmap), box});
+  }
+}
+
+/// @brief Place a LiveCell over the cells of |box|. Its updates are written
+/// over them by ScreenInteractive, until the next frame.
+/// @param cell The cell.
+/// @param x The column of its first cell, possibly outside of |box|.
+/// @param y Its row.
+/// @param box The cells it covers, inside of the screen.
+void Screen::PlaceLiveCell(std::shared_ptr<LiveCell> cell,
+                           int x,
+                           int y,
+                           const Box& box) {
+  if (cell && !box.IsEmpty()) {
+    live_cells_.push_back({std::move(cell), x, y, box});
+  }
+}
+
+// Update the bitmaps displayed by the terminal, from the cursor position left
+// by ToString(). When |full|, the cells were all written again, and so are the
+// bitmaps.
+void Screen::AppendBitmaps(bool full, std::string& output) const {
+  // The bitmaps destroyed are deleted from the terminal.
+  for (size_t i = 0; i < transmitted_bitmaps_.size();) {
+    if (transmitted_bitmaps_[i].second.expired()) {
+      output += "\x1B_Ga=d,d=I,i=";
+      AppendNumber(output, int(transmitted_bitmaps_[i].first));
+      output += ",q=2\x1B\\";
+      transmitted_bitmaps_[i] = transmitted_bitmaps_.back();
+      transmitted_bitmaps_.pop_back();
+    } else {
+      ++i;
+    }
+  }
+  if (bitmaps_.empty() && placed_bitmaps_.empty()) {
+    return;
+  }
+
+  std::vector<PlacedBitmap> placed;
+  placed.reserve(bitmaps_.size());
+  for (const BitmapPlacement& placement : bitmaps_) {
+    int index = 1;
+    for (const PlacedBitmap& it : placed) {
+      index += int(it.id == placement.bitmap->id());
+    }
+    placed.push_back({placement.bitmap->id(), index, placement.box});
+  }
+  auto find = [](const std::vector<PlacedBitmap>& list,
+                 const PlacedBitmap& candidate, bool same_box) {
+    for (const PlacedBitmap& it : list) {
+      if (it.id == candidate.id && it.placement == candidate.placement &&
+          (!same_box || it.box == candidate.box)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  // The bitmaps no longer placed there are removed first. A kitty placement
+  // moved is replaced instead. The pixels of a Sixel image belong to the
+  // cells: the cells below it are written again, unless they all were.
+  const Terminal::Graphics graphics = Terminal::GraphicsSupport();
+  for (const PlacedBitmap& it : placed_bitmaps_) {
+    if (graphics == Terminal::Graphics::Kitty &&
+        !find(placed, it, /*same_box=*/false)) {
+      output += "\x1B_Ga=d,d=i,i=";
+      AppendNumber(output, int(it.id));
+      output += ",p=";
+      AppendNumber(output, it.placement);
+      output += ",q=2\x1B\\";
+    }
+    if (graphics == Terminal::Graphics::Sixel && !full &&
+        !find(placed, it, /*same_box=*/true)) {
+      AppendCells(it.box, output);
+    }
+  }
+
+  for (size_t i = 0; i < placed.size(); ++i) {
+    if (!full && find(placed_bitmaps_, placed[i], /*same_box=*/true)) {
+      continue;
     }
+    const Bitmap& bitmap = *bitmaps_[i].bitmap;
+    const Box& box = placed[i].box;
+
+    // Move to the top left corner of the box, and back.
+    output += "\x1B" "7\r";
+    MoveCursorUp(output, dimy_ - 1 - box.y_min);
+    MoveCursorRight(output, box.x_min);
+    if (graphics == Terminal::Graphics::Sixel) {
+      output += bitmap.Sixel();
+      output += "\x1B" "8";
+      continue;
+    }
+
+    bool transmitted = false;
+    for (const auto& it : transmitted_bitmaps_) {
+      transmitted |= it.first == bitmap.id();
+    }
+    output += transmitted ? "\x1B_Ga=p" : "\x1B_Ga=T,f=24,s=";
+    if (!transmitted) {
+      AppendNumber(output, bitmap.width());
+      output += ",v=";
+      AppendNumber(output, bitmap.height());
+    }
+    output += ",i=";
+    AppendNumber(output, int(bitmap.id()));
+    output += ",p=";
+    AppendNumber(output, placed[i].placement);
+    output += ",c=";
+    AppendNumber(output, box.x_max - box.x_min + 1);
+    output += ",r=";
+    AppendNumber(output, box.y_max - box.y_min + 1);
+    output += ",C=1,q=2";
+    if (transmitted) {
+      output += "\x1B\\\x1B" "8";
+      continue;
+    }
+
+    // The pixels, in base64, by chunks of 4096 bytes.
+    static constexpr char kBase64[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    const std::vector<uint8_t>& rgb = bitmap.rgb();
+    std::string payload;
+    payload.reserve((rgb.size() + 2) / 3 * 4);
+    for (size_t j = 0; j < rgb.size(); j += 3) {
+      const size_t left = rgb.size() - j;
+      const uint32_t bits = uint32_t(rgb[j]) << 16 |
+                            (left > 1 ? uint32_t(rgb[j + 1]) << 8 : 0) |
+                            (left > 2 ? uint32_t(rgb[j + 2]) : 0);
+      payload += kBase64[(bits >> 18) & 63];
+      payload += kBase64[(bits >> 12) & 63];
+      payload += left > 1 ? kBase64[(bits >> 6) & 63] : '=';
+      payload += left > 2 ? kBase64[bits & 63] : '=';
+    }
+    const size_t chunk = 4096;
+    for (size_t j = 0; j < payload.size() || j == 0; j += chunk) {
+      if (j != 0) {
+        output += "\x1B_Gq=2";
+      }
+      output += j + chunk < payload.size() ? ",m=1;" : ",m=0;";
+      output.append(payload, j, chunk);
+      output += "\x1B\\";
+    }
+    output += "\x1B" "8";
+    transmitted_bitmaps_.emplace_back(bitmap.id(), bitmaps_[i].bitmap);
+  }
+  placed_bitmaps_ = std::move(placed);
+}
+
+/// @brief Append to |output| what writes the pixels of |box| again. The
+/// cursor is expected where ToString() leaves it, and is moved back there. It
+/// updates the terminal cheaply, when only these cells changed.
+/// @param box The cells to write. It is clipped to the screen.
+/// @param output The buffer to append to.
+void Screen::ToPatchString(const Box& box, std::string& output) const {
+  AppendCells(box, output);
+}
+
+// Write the cells of |box| again, from the cursor position left by ToString().
+void Screen::AppendCells(const Box& box, std::string& output) const {
+  const Box clipped = Box::Intersection(box, {0, dimx_ - 1, 0, dimy_ - 1});
+  StyleWriter style(this, output);
+  for (int y = clipped.y_min; y <= clipped.y_max; ++y) {
+    output += "\x1B" "7\r";
+    MoveCursorUp(output, dimy_ - 1 - y);
+    MoveCursorRight(output, clipped.x_min);
+    for (int x = clipped.x_min; x <= clipped.x_max;) {
+      const Pixel& pixel = PixelAt(x, y);
+      style.Write(pixel);
+      output += pixel.character.empty() ? " " : pixel.character;
+      x += IsFullWidth(pixel) ? 2 : 1;
+    }
+    style.Reset();
+    output += "\x1B" "8";
+  }
+}
+
+std::uint16_t Screen::RegisterHyperlink(const std::string& link) {
+  if (link.empty()) {
+    return 0;
+  }
+  auto it = hyperlink_ids_.find(link);
+  if (it != hyperlink_ids_.end()) {
+    return it->second;
   }
-  if (hyperlinks_.size() == std::numeric_limits<std::uint8_t>::max()) {
+  if (hyperlinks_.size() > std::numeric_limits<std::uint16_t>::max()) {
     return 0;
   }
+  const auto id = static_cast<std::uint16_t>(hyperlinks_.size());
   hyperlinks_.push_back(link);
-  return hyperlinks_.size() - 1;
+  hyperlink_ids_.emplace(link, id);
+  return id;
 }
 
-const std::string& Screen::Hyperlink(std::uint8_t id) const {
+const std::string& Screen::Hyperlink(std::uint16_t id) const {
   if (id >= hyperlinks_.size()) {
     return hyperlinks_[0];
   }
@@ -0,0 +1,626 @@
+// Copyright 2024 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <memory>   // for make_shared, shared_ptr
+#include <functional>  // for function
+#include <string>      // for allocator, string
+#include <thread>      // for thread
+#include <utility>     // for as_const
+#include <vector>  // for vector
+
+#include "ftxui/screen/bitmap.hpp"  // for Bitmap
+#include "ftxui/screen/box.hpp"     // for Box
+#include "ftxui/screen/color.hpp"   // for Color, Color::Red
+#include "ftxui/screen/screen.hpp"  // for Screen, Pixel
+#include "ftxui/screen/terminal.hpp"  // for SetColorSupport, Color
+
+// NOLINTBEGIN
+namespace ftxui {
+
+TEST(ScreenTest, ToStringAppend) {
+  Screen screen(2, 2);
+  screen.PixelAt(0, 0).character = "a";
+  screen.PixelAt(1, 1).character = "b";
+
+  std::string output = "prefix";
+  screen.ToString(output);
+  EXPECT_EQ(output, "prefix" + screen.ToString());
+  EXPECT_EQ(screen.ToString(), "a \r\n b");
+}
+
+TEST(ScreenTest, ToStringParallel) {
+  // Large enough to be encoded by blocks, with a number of rows not multiple
+  // of the blocks.
+  Screen screen(300, 101);
+  const int link = screen.RegisterHyperlink("https://example.com");
+  for (int y = 0; y < screen.dimy(); ++y) {
+    // The end of some rows is left blank, and erased by ToCompactString().
+    const int width = y % 3 == 0 ? screen.dimx() : screen.dimx() / 2;
+    for (int x = 0; x < width; x += 1 + (x % 7 == 0)) {
+      Pixel& pixel = screen.PixelAt(x, y);
+      pixel.character = x % 7 == 0 ? "测" : "a";
+      pixel.foreground_color =
+          (x / 5 + y) % 3 ? Color(Color::Red) : Color(Color::Default);
+      pixel.bold = (x + y) % 11 == 0;
+      pixel.hyperlink = (x + y) % 13 == 0 ? link : 0;
+    }
+  }
+
+  // The blocks are encoded in reverse order, on their own thread.
+  int calls = 0;
+  auto parallel_for = [&](size_t count, const std::function<void(size_t)>& fn) {
+    calls++;
+    std::vector<std::thread> threads;
+    for (size_t i = count; i-- > 0;) {
+      threads.emplace_back([&fn, i] { fn(i); });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  };
+
+  std::string output = "prefix";
+  screen.ToString(output, parallel_for);
+  EXPECT_EQ(output, "prefix" + screen.ToString());
+
+  output = "prefix";
+  screen.ToCompactString(output, parallel_for);
+  EXPECT_EQ(output, "prefix" + screen.ToCompactString());
+  EXPECT_EQ(calls, 2);
+
+  // A small screen is encoded by the calling thread.
+  Screen small(10, 10);
+  small.PixelAt(1, 1).character = "b";
+  output.clear();
+  small.ToString(output, parallel_for);
+  EXPECT_EQ(output, small.ToString());
+  EXPECT_EQ(calls, 2);
+}
+
+TEST(ScreenTest, DiffIdentical) {
+  Screen previous(4, 2);
+  previous.PixelAt(1, 0).character = "a";
+  Screen next = previous;
+
+  // Only move the cursor where ToString() would have left it.
+  EXPECT_EQ(next.ToDiffString(previous), "\x1B[1B\r\x1B[4C");
+}
+
+TEST(ScreenTest, DiffSingleCell) {
+  Screen previous(4, 2);
+  Screen next(4, 2);
+  next.PixelAt(2, 1).character = "b";
+
+  EXPECT_EQ(next.ToDiffString(previous), "\x1B[1B\x1B[2Cb\r\x1B[4C");
+}
+
+TEST(ScreenTest, DiffLastCell) {
+  Screen previous(4, 2);
+  Screen next(4, 2);
+  next.PixelAt(3, 1).character = "b";
+
+  EXPECT_EQ(next.ToDiffString(previous), "\x1B[1B\x1B[3Cb");
+}
+
+TEST(ScreenTest, DiffBridgeSmallGap) {
+  Screen previous(8, 1);
+  Screen next(8, 1);
+  next.PixelAt(0, 0).character = "a";
+  next.PixelAt(3, 0).character = "b";
+
+  // Rewriting the two unchanged cells is cheaper than moving the cursor.
+  EXPECT_EQ(next.ToDiffString(previous), "a  b\r\x1B[8C");
+}
+
+TEST(ScreenTest, DiffStyle) {
+  Screen previous(3, 1);
+  Screen next(3, 1);
+  next.PixelAt(1, 0).character = "a";
+  next.PixelAt(1, 0).foreground_color = Color::Red;
+
+  EXPECT_EQ(next.ToDiffString(previous),
+            "\x1B[1C\x1B[31ma\x1B[39m\r\x1B[3C");
+}
+
+TEST(ScreenTest, DiffFullWidth) {
+  Screen previous(4, 1);
+  previous.PixelAt(0, 0).character = "测";
+  previous.PixelAt(1, 0).character = "";
+  Screen next = previous;
+  next.PixelAt(1, 0).character = "a";
+
+  // The fullwidth character must be written again, not only its second half.
+  EXPECT_EQ(next.ToDiffString(previous), "测\r\x1B[4C");
+}
+
+TEST(ScreenTest, DiffFullWidthRemoved) {
+  Screen previous(4, 1);
+  previous.PixelAt(0, 0).character = "测";
+  Screen next(4, 1);
+  next.PixelAt(0, 0).character = "a";
+
+  // The cell previously covered by the fullwidth character is repainted.
+  EXPECT_EQ(next.ToDiffString(previous), "a \r\x1B[4C");
+}
+
+TEST(ScreenTest, DiffHyperlink) {
+  Screen previous(2, 1);
+  previous.PixelAt(0, 0).hyperlink = previous.RegisterHyperlink("a");
+  Screen next(2, 1);
+  next.PixelAt(0, 0).hyperlink = next.RegisterHyperlink("b");
+
+  // Same hyperlink id, but different links.
+  EXPECT_EQ(next.ToDiffString(previous),
+            "\x1B]8;;b\x1B\\ \x1B]8;;\x1B\\\r\x1B[2C");
+}
+
+TEST(ScreenTest, DiffErased) {
+  Screen previous(4, 2);
+  previous.PixelAt(2, 0).character = "a";
+  Screen next(4, 2);
+
+  // The row is not touched anymore, but it still must be repainted.
+  EXPECT_EQ(next.ToDiffString(previous), "\x1B[2C \x1B[1B\r\x1B[4C");
+}
+
+TEST(ScreenTest, DiffScrollUp) {
+  Screen previous(2, 4);
+  Screen next(2, 4);
+  for (int y = 0; y < 4; ++y) {
+    previous.PixelAt(0, y).character = std::string(1, 'a' + y);
+    next.PixelAt(0, y).character = std::string(1, 'b' + y);
+  }
+
+  // The rows are shifted by the terminal. Only the new one is written.
+  EXPECT_EQ(next.ToDiffString(previous),
+            "\x1B[1M\x1B[3B\x1B[1L\x1B[3A\r\x1B[3Be\r\x1B[2C");
+}
+
+TEST(ScreenTest, DiffScrollDown) {
+  Screen previous(2, 4);
+  Screen next(2, 4);
+  for (int y = 0; y < 4; ++y) {
+    previous.PixelAt(0, y).character = std::string(1, 'b' + y);
+    next.PixelAt(0, y).character = std::string(1, 'a' + y);
+  }
+
+  EXPECT_EQ(next.ToDiffString(previous),
+            "\x1B[3B\x1B[1M\x1B[3A\x1B[1L\ra\x1B[3B\r\x1B[2C");
+}
+
+TEST(ScreenTest, Clear) {
+  Screen screen(4, 3);
+  screen.PixelAt(1, 1).character = "a";
+  screen.PixelAt(3, 1).bold = true;
+  screen.PixelAt(2, 2).character = "b";
+  EXPECT_EQ(screen.ToString(), "    \r\n a \x1B[1m \x1B[22m\r\n  b ");
+
+  screen.Clear();
+  EXPECT_EQ(screen.ToString(), "    \r\n    \r\n    ");
+  EXPECT_EQ(screen.PixelAt(1, 1).character, "");
+  EXPECT_FALSE(screen.PixelAt(3, 1).bold);
+}
+
+TEST(ScreenTest, StyleSequence) {
+  Terminal::SetColorSupport(Terminal::Color::TrueColor);
+  Screen screen(3, 1);
+  screen.PixelAt(0, 0).bold = true;
+  screen.PixelAt(0, 0).foreground_color = Color::RGB(1, 2, 3);
+  screen.PixelAt(1, 0).bold = true;
+  screen.PixelAt(1, 0).foreground_color = Color::RGB(1, 2, 3);
+  screen.PixelAt(1, 0).background_color = Color::Red;
+  screen.PixelAt(2, 0).background_color = Color::Red;
+
+  // The changes are grouped in a single sequence, and only the color channels
+  // that changed are emitted.
+  EXPECT_EQ(screen.ToString(),
+            "\x1B[1;38;2;1;2;3m \x1B[41m \x1B[22;39m \x1B[49m");
+}
+
+TEST(ScreenTest, StyleSequenceRepeated) {
+  Terminal::SetColorSupport(Terminal::Color::TrueColor);
+  Screen screen(4, 1);
+  screen.PixelAt(0, 0).foreground_color = Color::RGB(1, 2, 3);
+  screen.PixelAt(1, 0).underlined = true;
+  screen.PixelAt(2, 0).foreground_color = Color::RGB(1, 2, 3);
+  screen.PixelAt(3, 0).underlined = true;
+
+  // The transitions already seen are reused.
+  const std::string expected =
+      "\x1B[38;2;1;2;3m \x1B[4;39m \x1B[24;38;2;1;2;3m \x1B[4;39m \x1B[24m";
+  EXPECT_EQ(screen.ToString(), expected);
+  EXPECT_EQ(screen.ToString(), expected);
+
+}
+
+TEST(ScreenTest, StyleSequenceColorDepth) {
+  Terminal::SetColorSupport(Terminal::Color::TrueColor);
+  Screen screen(2, 1);
+  screen.PixelAt(0, 0).character = "x";
+  screen.PixelAt(0, 0).bold = true;
+  screen.PixelAt(0, 0).foreground_color = Color::RGB(255, 0, 0);
+
+  // The colors are encoded for the terminal the frame is written to.
+  EXPECT_EQ(screen.ToString(), "\x1B[1;38;2;255;0;0mx\x1B[22;39m ");
+  Terminal::SetColorSupport(Terminal::Color::Palette256);
+  EXPECT_EQ(screen.ToString(), "\x1B[1;38;5;196mx\x1B[22;39m ");
+  Terminal::SetColorSupport(Terminal::Color::Palette16);
+  EXPECT_EQ(screen.ToString(), "\x1B[1;91mx\x1B[22;39m ");
+
+  // Monochrome: the colors are dropped, the attributes are kept.
+  Terminal::SetColorSupport(Terminal::Color::Palette1);
+  EXPECT_EQ(screen.ToString(), "\x1B[1mx\x1B[22m ");
+  screen.PixelAt(1, 0).background_color = Color::Blue;
+  EXPECT_EQ(screen.ToString(), "\x1B[1mx\x1B[22m ");
+
+  Terminal::SetColorSupport(Terminal::Color::TrueColor);
+}
+
+TEST(ScreenTest, DiffDimensionMismatch) {
+  Screen previous(2, 1);
+  Screen next(3, 2);
+  next.PixelAt(0, 0).character = "a";
+
+  EXPECT_EQ(next.ToDiffString(previous), next.ToCompactString());
+}
+
+TEST(ScreenTest, CompactString) {
+  Screen screen(20, 2);
+  screen.PixelAt(0, 0).character = "a";
+  screen.PixelAt(19, 0).character = "b";
+  screen.PixelAt(0, 1).character = "c";
+
+  // The blank runs are erased instead of written. The cursor ends where
+  // ToString() leaves it.
+  EXPECT_EQ(screen.ToCompactString(),
+            "a\x1B[18X\x1B[18Cb\r\nc\x1B[K\r\x1B[20C");
+
+  // Short blank runs are written.
+  Screen small(4, 1);
+  small.PixelAt(0, 0).character = "a";
+  EXPECT_EQ(small.ToCompactString(), small.ToString());
+}
+
+TEST(ScreenTest, CompactStringRepeat) {
+  Screen screen(10, 1);
+  for (int x = 0; x < 10; ++x) {
+    screen.PixelAt(x, 0).character = "─";
+  }
+  EXPECT_EQ(screen.ToCompactString(), screen.ToString());
+
+  Terminal::SetRepeatSupport(true);
+  EXPECT_EQ(screen.ToCompactString(), "─\x1B[9b");
+  Terminal::SetRepeatSupport(false);
+}
+
+TEST(ScreenTest, ApplyShader) {
+  Screen screen(3, 2);
+  auto draw = [&](int x, int y, const char* character, bool automerge) {
+    screen.PixelAt(x, y).character = character;
+    screen.PixelAt(x, y).automerge = automerge;
+  };
+  draw(0, 0, "─", true);
+  draw(1, 0, "│", true);
+  draw(2, 0, "─", false);
+  draw(0, 1, "│", true);
+  draw(1, 1, "a", true);
+  draw(2, 1, "━", true);
+  screen.ApplyShader();
+
+  EXPECT_EQ(screen.PixelAt(0, 0).character, "┬");
+  EXPECT_EQ(screen.PixelAt(1, 0).character, "┤");
+  EXPECT_EQ(screen.PixelAt(2, 0).character, "─");
+  EXPECT_EQ(screen.PixelAt(0, 1).character, "│");
+  EXPECT_EQ(screen.PixelAt(1, 1).character, "a");
+  EXPECT_EQ(screen.PixelAt(2, 1).character, "━");
+}
+
+TEST(ScreenTest, ApplyShaderRowsDrawnOutOfOrder) {
+  Screen screen(3, 4);
+  screen.FillColumn(1, 1, 3, "│", /*automerge=*/true);
+  screen.FillRow(0, 2, 1, "─", /*automerge=*/true);
+  screen.FillRow(0, 2, 3, "─", /*automerge=*/true);
+  screen.ApplyShader();
+
+  // The rows are merged from the top, whatever the order they were drawn in.
+  // The blank row 0 is skipped.
+  EXPECT_EQ(screen.ToString(), "   \r\n─┬─\r\n │ \r\n─┴─");
+}
+
+TEST(ScreenTest, Fill) {
+  Screen screen(4, 3);
+  screen.stencil = Box{1, 3, 0, 1};
+  screen.FillRow(-5, 5, 0, "─", /*automerge=*/true);
+  screen.FillColumn(2, -5, 5, "│");
+  Pixel pixel;
+  pixel.character = "x";
+  screen.FillRow(0, 1, 1, pixel);
+
+  // Only the pixels within the stencil are drawn.
+  screen.stencil = Box{0, 3, 0, 2};
+  EXPECT_EQ(screen.ToString(), " ─│─\r\n x│ \r\n    ");
+  EXPECT_TRUE(screen.PixelAt(1, 0).automerge);
+  EXPECT_FALSE(screen.PixelAt(2, 1).automerge);
+
+  // The pixels drawn are cleared.
+  screen.Clear();
+  EXPECT_EQ(screen.ToString(), "    \r\n    \r\n    ");
+}
+
+TEST(ScreenTest, ClippedRow) {
+  Screen screen(4, 3);
+  screen.stencil = Box{1, 2, 0, 1};
+  Image::PixelRow row = screen.ClippedRow(-5, 5, 1);
+  EXPECT_EQ(row.x_min, 1);
+  EXPECT_EQ(row.x_max, 2);
+  EXPECT_EQ(row.size(), 2);
+  row[1].character = "a";
+  row[2].character = "b";
+  EXPECT_TRUE(screen.ClippedRow(0, 3, 2).empty());
+  EXPECT_TRUE(screen.ClippedRow(3, 5, 0).empty());
+
+  screen.stencil = Box{0, 3, 0, 2};
+  EXPECT_EQ(screen.ToString(), "    \r\n ab \r\n    ");
+
+  // The pixels written are cleared.
+  screen.Clear();
+  EXPECT_EQ(screen.ToString(), "    \r\n    \r\n    ");
+}
+
+TEST(ScreenTest, Snapshot) {
+  Screen screen(5, 3);
+  screen.PixelAt(0, 0).character = "a";
+  screen.PixelAt(1, 0).character = "a";
+  screen.PixelAt(2, 1).character = "æ¼¢";  // Fullwidth.
+  screen.PixelAt(2, 1).bold = true;
+  screen.PixelAt(2, 1).foreground_color = Color::Red;
+  screen.PixelAt(3, 2).background_color = Color::RGB(1, 2, 3);
+  screen.PixelAt(4, 2).hyperlink = screen.RegisterHyperlink("https://a.b");
+  screen.SetCursor({1, 2, Screen::Cursor::Bar});
+
+  const std::string snapshot = screen.ToSnapshot();
+  // Made of runs: much smaller than the pixels.
+  EXPECT_LT(snapshot.size(), 80u);
+
+  Screen restored(0, 0);
+  ASSERT_TRUE(Screen::FromSnapshot(snapshot, &restored));
+  EXPECT_EQ(restored.dimx(), 5);
+  EXPECT_EQ(restored.dimy(), 3);
+  EXPECT_TRUE(restored.Diff(screen).empty());
+  EXPECT_EQ(restored.ToString(), screen.ToString());
+  EXPECT_EQ(restored.cursor().x, 1);
+  EXPECT_EQ(restored.cursor().shape, Screen::Cursor::Bar);
+  EXPECT_EQ(restored.Hyperlink(restored.PixelAt(4, 2).hyperlink), "https://a.b");
+  EXPECT_EQ(restored.ToSnapshot(), snapshot);
+}
+
+// Two identical screens, never given a cursor, have the same snapshot.
+TEST(ScreenTest, SnapshotDeterministic) {
+  std::vector<std::string> snapshots;
+  for (int i = 0; i < 2; ++i) {
+    Screen screen(3, 2);
+    screen.PixelAt(1, 1).character = "a";
+    snapshots.push_back(screen.ToSnapshot());
+  }
+  EXPECT_EQ(snapshots[0], snapshots[1]);
+
+  Screen restored(1, 1);
+  ASSERT_TRUE(Screen::FromSnapshot(snapshots[0], &restored));
+  EXPECT_EQ(restored.cursor().shape, Screen::Cursor::Hidden);
+}
+
+TEST(ScreenTest, SnapshotMalformed) {
+  Screen screen(3, 2);
+  screen.PixelAt(1, 1).character = "a";
+  const std::string snapshot = screen.ToSnapshot();
+
+  Screen restored(1, 1);
+  EXPECT_FALSE(Screen::FromSnapshot("", &restored));
+  EXPECT_FALSE(Screen::FromSnapshot("FTXP", &restored));
+  for (size_t size = 0; size < snapshot.size(); ++size) {
+    EXPECT_FALSE(Screen::FromSnapshot(snapshot.substr(0, size), &restored));
+  }
+  EXPECT_FALSE(Screen::FromSnapshot(snapshot + "x", &restored));
+  EXPECT_EQ(restored.dimx(), 1);
+}
+
+TEST(ScreenTest, DiffRectangles) {
+  Screen expected(6, 4);
+  Screen actual(6, 4);
+  EXPECT_TRUE(actual.Diff(expected).empty());
+
+  // A 2x2 block, and a single pixel with a different style.
+  for (int y = 1; y <= 2; ++y) {
+    actual.PixelAt(1, y).character = "x";
+    actual.PixelAt(2, y).character = "x";
+  }
+  expected.PixelAt(5, 0).character = "a";
+  actual.PixelAt(5, 0).character = "a";
+  actual.PixelAt(5, 0).bold = true;
+
+  const std::vector<Box> boxes = actual.Diff(expected);
+  ASSERT_EQ(boxes.size(), 2u);
+  EXPECT_EQ(boxes[0], (Box{5, 5, 0, 0}));
+  EXPECT_EQ(boxes[1], (Box{1, 2, 1, 2}));
+
+  EXPECT_EQ(actual.Diff(Screen(2, 2)).size(), 1u);
+  EXPECT_EQ(actual.Diff(Screen(2, 2))[0], (Box{0, 5, 0, 3}));
+}
+
+TEST(ScreenTest, ClearTouchedRows) {
+  Screen screen(300, 100);
+  screen.PixelAt(10, 5).character = "a";
+  screen.PixelAt(299, 99).bold = true;
+  screen.PixelAt(0, 5).character = "b";
+  screen.Clear();
+  EXPECT_EQ(screen.ToString(), Screen(300, 100).ToString());
+
+  // The rows cleared are tracked again.
+  screen.PixelAt(1, 5).character = "c";
+  screen.Clear();
+  EXPECT_EQ(screen.ToString(), Screen(300, 100).ToString());
+}
+
+TEST(ScreenTest, ResizeReusesStorage) {
+  class ResizableScreen : public Screen {
+   public:
+    using Screen::Screen;
+    using Screen::Resize;
+    const Pixel* data() const { return RowAt(0); }
+  };
+
+  ResizableScreen screen(80, 24);
+  screen.PixelAt(79, 23).character = "a";
+  screen.PixelAt(3, 2).bold = true;
+
+  // Growing past the capacity reallocates, with room to spare.
+  screen.Resize(100, 30);
+  const Pixel* data = screen.data();
+  EXPECT_EQ(screen.dimx(), 100);
+  EXPECT_EQ(screen.dimy(), 30);
+
+  // Jittering around that size reuses the storage, with every pixel reset.
+  for (int i = 0; i < 10; ++i) {
+    screen.PixelAt(i, i).character = "b";
+    screen.Resize(100 + i % 3 * 10, 30 - i % 2);
+    EXPECT_EQ(screen.data(), data);
+  }
+  // The stencil follows the dimensions: every pixel is the stored one.
+  EXPECT_EQ(screen.dimx(), 100);
+  for (int y = 0; y < screen.dimy(); ++y) {
+    for (int x = 0; x < screen.dimx(); ++x) {
+      const Pixel& pixel = std::as_const(screen).PixelAt(x, y);
+      ASSERT_EQ(&pixel, data + y * screen.dimx() + x) << x << "," << y;
+      ASSERT_EQ(pixel.character, "") << x << "," << y;
+      ASSERT_FALSE(pixel.bold) << x << "," << y;
+    }
+  }
+  screen.PixelAt(99, 28).character = "c";
+  EXPECT_EQ(std::as_const(screen).PixelAt(99, 28).character, "c");
+
+  // Shrinking, the pixels past the new dimensions are out of the stencil.
+  screen.Resize(10, 5);
+  EXPECT_EQ(screen.data(), data);
+  screen.PixelAt(9, 4).character = "d";
+  EXPECT_EQ(std::as_const(screen).PixelAt(9, 4).character, "d");
+  EXPECT_EQ(&std::as_const(screen).PixelAt(9, 4), data + 4 * 10 + 9);
+  screen.PixelAt(10, 0).character = "e";
+  screen.PixelAt(50, 20).character = "e";
+  EXPECT_EQ(std::as_const(screen).PixelAt(0, 1).character, "");
+  EXPECT_EQ(screen.ToString(), std::string(10, ' ') + "\r\n" +
+                                   std::string(10, ' ') + "\r\n" +
+                                   std::string(10, ' ') + "\r\n" +
+                                   std::string(10, ' ') + "\r\n" +
+                                   std::string(9, ' ') + "d");
+}
+
+TEST(ScreenTest, ShrinkToFit) {
+  class ResizableScreen : public Screen {
+   public:
+    using Screen::Screen;
+    using Screen::Resize;
+  };
+
+  ResizableScreen screen(200, 100);
+  screen.PixelAt(0, 0).character = std::string(100, 'x');
+  screen.PixelAt(1, 0).character = "a";
+  screen.RegisterHyperlink(std::string(100, 'y'));
+  screen.Clear();
+  screen.Resize(10, 5);
+  screen.PixelAt(2, 0).character = "b";
+  screen.PixelAt(2, 0).bold = true;
+  const size_t peak = screen.MemoryUsage();
+  EXPECT_GE(peak, 200 * 100 * sizeof(Pixel));
+
+  // The storage of the larger dimensions is released, the pixels are kept.
+  screen.ShrinkToFit();
+  EXPECT_LT(screen.MemoryUsage(), peak);
+  EXPECT_LT(screen.MemoryUsage(), 200 * sizeof(Pixel) + 1000);
+  EXPECT_EQ(screen.PixelAt(2, 0).character, "b");
+  EXPECT_TRUE(screen.PixelAt(2, 0).bold);
+
+  // The characters longer than the inline storage are shrunk to their size.
+  screen.PixelAt(0, 0).character = std::string(1000, 'x');
+  screen.PixelAt(0, 0).character.resize(20);
+  const size_t before = screen.MemoryUsage();
+  screen.ShrinkToFit();
+  EXPECT_LT(screen.MemoryUsage() + 900, before);
+  EXPECT_EQ(screen.PixelAt(0, 0).character, std::string(20, 'x'));
+}
+
+TEST(ScreenTest, BitmapKitty) {
+  Terminal::SetGraphicsSupport(Terminal::Graphics::Kitty);
+  auto bitmap = std::make_shared<Bitmap>(
+      2, 1, std::vector<uint8_t>{255, 0, 0, 0, 0, 255});
+  const std::string id = std::to_string(bitmap->id());
+  Screen screen(4, 3);
+
+  // Transmitted once.
+  screen.PlaceBitmap(bitmap, Box{1, 2, 0, 1});
+  std::string output = screen.ToString();
+  EXPECT_NE(output.find("\x1B_Ga=T,f=24,s=2,v=1,i=" + id +
+                        ",p=1,c=2,r=2,C=1,q=2,m=0;/wAAAAD/\x1B\\"),
+            std::string::npos);
+
+  // Unchanged, it costs nothing.
+  Screen previous = screen;
+  screen.Clear();
+  screen.PlaceBitmap(bitmap, Box{1, 2, 0, 1});
+  EXPECT_EQ(screen.ToDiffString(previous).find("\x1B_G"), std::string::npos);
+
+  // Moved, it is placed again.
+  screen.Clear();
+  screen.PlaceBitmap(bitmap, Box{2, 3, 1, 2});
+  output = screen.ToDiffString(previous);
+  EXPECT_NE(output.find("\x1B_Ga=p,i=" + id + ",p=1,c=2,r=2,C=1,q=2\x1B\\"),
+            std::string::npos);
+  EXPECT_EQ(output.find("a=T"), std::string::npos);
+
+  // Not placed, it is removed. Destroyed, it is deleted.
+  screen.Clear();
+  output = screen.ToDiffString(previous);
+  EXPECT_NE(output.find("\x1B_Ga=d,d=i,i=" + id + ",p=1,q=2\x1B\\"),
+            std::string::npos);
+  previous.Clear();
+  bitmap.reset();
+  output = screen.ToDiffString(previous);
+  EXPECT_NE(output.find("\x1B_Ga=d,d=I,i=" + id + ",q=2\x1B\\"),
+            std::string::npos);
+  EXPECT_EQ(screen.ToDiffString(previous).find("\x1B_G"), std::string::npos);
+
+  Terminal::SetGraphicsSupport(Terminal::Graphics::None);
+}
+
+TEST(ScreenTest, BitmapSixel) {
+  Terminal::SetGraphicsSupport(Terminal::Graphics::Sixel);
+  auto bitmap = std::make_shared<Bitmap>(
+      2, 1, std::vector<uint8_t>{255, 0, 0, 0, 0, 255});
+  const std::string sixel =
+      "\x1BP0;1;0q\"1;1;2;1#5;2;0;0;100#180;2;100;0;0#5?@$#180@-\x1B\\";
+  EXPECT_EQ(bitmap->Sixel(), sixel);
+
+  Screen screen(4, 3);
+  screen.PlaceBitmap(bitmap, Box{1, 2, 0, 1});
+  // Drawn in between saving the cursor position (DECSC) and restoring it.
+  EXPECT_NE(screen.ToString().find("\x1B" "7\r\x1B[2A\x1B[1C" + sixel +
+                                   "\x1B" "8"),
+            std::string::npos);
+
+  // Drawn again only when moved. The cells it covered are written again.
+  Screen previous = screen;
+  screen.Clear();
+  screen.PlaceBitmap(bitmap, Box{1, 2, 0, 1});
+  EXPECT_EQ(screen.ToDiffString(previous).find(sixel), std::string::npos);
+  screen.Clear();
+  screen.PixelAt(1, 0).character = "x";
+  screen.PlaceBitmap(bitmap, Box{2, 3, 1, 2});
+  const std::string output = screen.ToDiffString(previous);
+  EXPECT_NE(output.find(sixel), std::string::npos);
+  EXPECT_LT(output.rfind("x"), output.find(sixel));
+
+  Terminal::SetGraphicsSupport(Terminal::Graphics::None);
+}
+
+}  // namespace ftxui
+// NOLINTEND
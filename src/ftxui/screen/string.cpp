@@ -11,14 +11,17 @@
 
 #include "ftxui/screen/string.hpp"
 
-#include <array>    // for array
-#include <cstddef>  // for size_t
-#include <cstdint>  // for uint32_t, uint8_t, uint16_t, int32_t
-#include <string>   // for string, basic_string, wstring
-#include <tuple>    // for _Swallow_assign, ignore
+#include <array>        // for array
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t, uint8_t, uint16_t, int32_t, uint64_t
+#include <functional>   // for hash
+#include <string>       // for string, basic_string, wstring
+#include <string_view>  // for string_view
+#include <tuple>        // for _Swallow_assign, ignore
 #include <vector>
 
-#include "ftxui/screen/deprecated.hpp"       // for wchar_width, wstring_width
+#include "ftxui/screen/cpu_dispatch.hpp"  // for Best
+#include "ftxui/screen/deprecated.hpp"    // for wchar_width, wstring_width
 #include "ftxui/screen/string_internal.hpp"  // for WordBreakProperty, EatCodePoint, CodepointToWordBreakProperty, GlyphCount, GlyphIterate, GlyphNext, GlyphPrevious, IsCombining, IsControl, IsFullWidth, Utf8ToWordBreakProperty
 
 namespace {
@@ -1076,30 +1079,6 @@ constexpr std::array<WordBreakPropertyInterval, 993> g_word_break_intervals = {{
     {0xE0100, 0xE01EF, WBP::Extend},
 }};
 
-// Construct table of just WBP::Extend character intervals
-constexpr auto g_extend_characters{[]() constexpr {
-  // Compute number of extend character intervals
-  constexpr size_t size = []() constexpr {
-    size_t count = 0;
-    for (auto interval : g_word_break_intervals) {
-      if (interval.property == WBP::Extend) {
-        count++;
-      }
-    }
-    return count;
-  }();
-
-  // Create array of extend character intervals
-  std::array<Interval, size> result{};
-  size_t index = 0;
-  for (auto interval : g_word_break_intervals) {
-    if (interval.property == WBP::Extend) {
-      result[index++] = {interval.first, interval.last};  // NOLINT
-    }
-  }
-  return result;
-}()};
-
 // Find a codepoint inside a sorted list of Interval.
 template <size_t N>
 bool Bisearch(uint32_t ucs, const std::array<Interval, N>& table) {
@@ -1147,16 +1126,194 @@ bool Bisearch(uint32_t ucs, const std::array<C, N>& table, C* out) {
   return false;
 }
 
+// A codepoint is a control character if it belongs to C0 (excepted the line
+// feed) or C1.
+constexpr bool IsControlCharacter(uint32_t ucs) {
+  if (ucs == 0) {
+    return true;
+  }
+  if (ucs < 32) {  // NOLINT
+    const uint32_t LINE_FEED = 10;
+    return ucs != LINE_FEED;
+  }
+  return ucs >= 0x7f && ucs < 0xa0;  // NOLINT
+}
+
+// The properties of a codepoint, packed into one byte:
+// - bits 0-4: the WordBreakProperty.
+// - bit 5: fullwidth.
+// - bit 6: control.
+// Combining characters are the ones with the WBP::Extend property.
+constexpr uint8_t kWordBreakMask = 0x1f;
+constexpr uint8_t kFullWidth = 0x20;
+constexpr uint8_t kControl = 0x40;
+constexpr size_t kPackedValues = 0x80;
+
+// The properties of the codepoints below |kTableEnd| are stored into a two
+// level table. The codepoints are grouped by pages of |kPageSize|. The first
+// level gives the block of every page, the second level holds the blocks of
+// properties. Pages with a single value share the same block. Above, there
+// are only a few tags and variation selectors, found by a binary search.
+constexpr uint32_t kPageBits = 7;
+constexpr uint32_t kPageSize = 1 << kPageBits;
+constexpr uint32_t kTableEnd = 0x40000;
+constexpr uint32_t kPages = kTableEnd / kPageSize;
+
+// Walk |table| from |*cursor| up to the interval containing |ucs|, or the
+// next one. The codepoints must be visited in increasing order.
+template <class C, size_t N>
+constexpr bool Advance(const std::array<C, N>& table,
+                       size_t* cursor,
+                       uint32_t ucs) {
+  while (*cursor < N && table[*cursor].last < ucs) {  // NOLINT
+    ++*cursor;
+  }
+  return *cursor < N && table[*cursor].first <= ucs;  // NOLINT
+}
+
+// The packed properties of |ucs|, with the same cursors as Advance().
+constexpr uint8_t PackedProperties(uint32_t ucs,
+                                   size_t* word_break,
+                                   size_t* full_width) {
+  uint8_t out = static_cast<uint8_t>(WBP::ALetter);
+  if (Advance(g_word_break_intervals, word_break, ucs)) {
+    out = static_cast<uint8_t>(
+        g_word_break_intervals[*word_break].property);  // NOLINT
+  }
+  if (Advance(g_full_width_characters, full_width, ucs)) {
+    out |= kFullWidth;
+  }
+  if (IsControlCharacter(ucs)) {
+    out |= kControl;
+  }
+  return out;
+}
+
+// Whether every codepoint of the page starting at |first| shares the same
+// properties. The cursors must be advanced to |first|.
+template <class C, size_t N>
+constexpr bool IsUniform(const std::array<C, N>& table,
+                         size_t cursor,
+                         uint32_t first) {
+  const uint32_t last = first + kPageSize - 1;
+  return cursor >= N || table[cursor].first > last ||  // NOLINT
+         (table[cursor].first <= first &&                // NOLINT
+          table[cursor].last >= last);                   // NOLINT
+}
+
+constexpr bool IsUniformPage(uint32_t page,
+                             size_t word_break,
+                             size_t full_width) {
+  const uint32_t first = page * kPageSize;
+  return !IsControlCharacter(first) &&
+         !IsControlCharacter(first + kPageSize - 1) &&
+         IsUniform(g_word_break_intervals, word_break, first) &&
+         IsUniform(g_full_width_characters, full_width, first);
+}
+
+constexpr size_t g_property_blocks = []() constexpr {
+  std::array<bool, kPackedValues> uniform{};
+  size_t count = 0;
+  size_t word_break = 0;
+  size_t full_width = 0;
+  for (uint32_t page = 0; page < kPages; ++page) {
+    const uint8_t value =
+        PackedProperties(page * kPageSize, &word_break, &full_width);
+    if (!IsUniformPage(page, word_break, full_width)) {
+      count++;
+    } else if (!uniform[value]) {  // NOLINT
+      uniform[value] = true;       // NOLINT
+      count++;
+    }
+  }
+  return count;
+}();
+static_assert(g_property_blocks <= 256, "The block index must fit a uint8_t");
+
+struct PropertyTable {
+  std::array<uint8_t, kPages> index;
+  std::array<uint8_t, g_property_blocks * kPageSize> blocks;
+};
+
+constexpr PropertyTable g_properties = []() constexpr {
+  PropertyTable table{};
+  std::array<int, kPackedValues> uniform_block{};
+  for (auto& block : uniform_block) {
+    block = -1;
+  }
+  size_t count = 0;
+  size_t word_break = 0;
+  size_t full_width = 0;
+  for (uint32_t page = 0; page < kPages; ++page) {
+    const uint32_t first = page * kPageSize;
+    const uint8_t value = PackedProperties(first, &word_break, &full_width);
+    if (IsUniformPage(page, word_break, full_width) &&
+        uniform_block[value] != -1) {                    // NOLINT
+      table.index[page] = uint8_t(uniform_block[value]);  // NOLINT
+      continue;
+    }
+    if (IsUniformPage(page, word_break, full_width)) {
+      uniform_block[value] = int(count);  // NOLINT
+    }
+
+    table.index[page] = uint8_t(count);  // NOLINT
+    for (uint32_t i = 0; i < kPageSize; ++i) {
+      table.blocks[count * kPageSize + i] =  // NOLINT
+          PackedProperties(first + i, &word_break, &full_width);
+    }
+    count++;
+  }
+  return table;
+}();
+
+// The packed properties of |ucs|.
+uint8_t Properties(uint32_t ucs) {
+  if (ucs < kTableEnd) {
+    const size_t block = g_properties.index[ucs >> kPageBits];  // NOLINT
+    return g_properties.blocks[block * kPageSize +              // NOLINT
+                               (ucs & (kPageSize - 1))];
+  }
+
+  WordBreakPropertyInterval interval = {0, 0, WBP::ALetter};
+  std::ignore = Bisearch(ucs, g_word_break_intervals, &interval);
+  uint8_t out = static_cast<uint8_t>(interval.property);
+  if (Bisearch(ucs, g_full_width_characters)) {
+    out |= kFullWidth;
+  }
+  return out;
+}
+
+// Printable ASCII characters are one cell wide, and are never combined with
+// the previous character.
+bool IsPrintableAscii(char c) {
+  return c >= 0x20 && c < 0x7f;  // NOLINT
+}
+
+// Return the number of printable ASCII characters starting at |start|. They
+// are scanned with the fastest instructions of the CPU.
+size_t PrintableAsciiRun(std::string_view input, size_t start) {
+  return ftxui::cpu::Best().printable_ascii_run(input.data() + start,
+                                                input.size() - start);
+}
+
+// Return the number of ASCII characters starting at |start|. They are scanned
+// with the fastest instructions of the CPU.
+size_t AsciiRun(std::string_view input, size_t start) {
+  return ftxui::cpu::Best().ascii_run(input.data() + start,
+                                      input.size() - start);
+}
+
 int codepoint_width(uint32_t ucs) {
-  if (ftxui::IsControl(ucs)) {
+  const uint8_t properties = Properties(ucs);
+  if (properties & kControl) {
     return -1;
   }
 
-  if (ftxui::IsCombining(ucs)) {
+  if ((properties & kWordBreakMask) == static_cast<uint8_t>(WBP::Extend)) {
     return 0;
   }
 
-  if (ftxui::IsFullWidth(ucs)) {
+  if (properties & kFullWidth) {
     return 2;
   }
 
@@ -1171,7 +1328,7 @@ namespace ftxui {
 // one codepoint. Put the codepoint into |ucs|. Start at |start| and update
 // |end| to represent the beginning of the next byte to eat for consecutive
 // executions.
-bool EatCodePoint(const std::string& input,
+bool EatCodePoint(std::string_view input,
                   size_t start,
                   size_t* end,
                   uint32_t* ucs) {
@@ -1280,34 +1437,24 @@ bool EatCodePoint(const std::wstring& input,
 }
 
 bool IsCombining(uint32_t ucs) {
-  return Bisearch(ucs, g_extend_characters);
+  return (Properties(ucs) & kWordBreakMask) ==
+         static_cast<uint8_t>(WBP::Extend);
 }
 
 bool IsFullWidth(uint32_t ucs) {
   if (ucs < 0x0300)  // Quick path: // NOLINT
     return false;
 
-  return Bisearch(ucs, g_full_width_characters);
+  return (Properties(ucs) & kFullWidth) != 0;
 }
 
 bool IsControl(uint32_t ucs) {
-  if (ucs == 0) {
-    return true;
-  }
-  if (ucs < 32) {  // NOLINT
-    const uint32_t LINE_FEED = 10;
-    return ucs != LINE_FEED;
-  }
-  if (ucs >= 0x7f && ucs < 0xa0) {  // NOLINT
-    return true;
-  }
-  return false;
+  return IsControlCharacter(ucs);
 }
 
 WordBreakProperty CodepointToWordBreakProperty(uint32_t codepoint) {
-  WordBreakPropertyInterval interval = {0, 0, WBP::ALetter};
-  std::ignore = Bisearch(codepoint, g_word_break_intervals, &interval);
-  return interval.property;
+  return static_cast<WordBreakProperty>(Properties(codepoint) &
+                                        kWordBreakMask);
 }
 
 int wchar_width(wchar_t ucs) {
@@ -1327,10 +1474,19 @@ int wstring_width(const std::wstring& text) {
   return width;
 }
 
-int string_width(const std::string& input) {
+namespace {
+
+int MeasureWidth(std::string_view input, size_t start) {
   int width = 0;
-  size_t start = 0;
   while (start < input.size()) {
+    // Fast path:
+    const size_t ascii = PrintableAsciiRun(input, start);
+    width += int(ascii);
+    start += ascii;
+    if (start >= input.size()) {
+      break;
+    }
+
     uint32_t codepoint = 0;
     if (!EatCodePoint(input, start, &start, &codepoint)) {
       continue;
@@ -1354,12 +1510,64 @@ int string_width(const std::string& input) {
   return width;
 }
 
+// The strings measured are mostly the same from one frame to the next: the
+// labels, the menu entries, the table cells... The width of the ones not made
+// of printable ASCII only is memoized in a direct mapped cache. The shorter
+// ones are faster to measure than to look up. The longer ones would use too
+// much memory.
+constexpr size_t kWidthCacheMinSize = 16;
+constexpr size_t kWidthCacheMaxSize = 256;
+constexpr size_t kWidthCacheBits = 9;
+
+int CachedWidth(std::string_view input, size_t start) {
+  struct Entry {
+    size_t hash = 0;
+    std::string text;
+    int width = 0;
+  };
+  thread_local std::array<Entry, size_t(1) << kWidthCacheBits> cache;
+
+  const size_t hash = std::hash<std::string_view>()(input);
+  Entry& entry = cache[hash & ((size_t(1) << kWidthCacheBits) - 1)];  // NOLINT
+  if (entry.hash != hash || entry.text != input) {
+    entry.hash = hash;
+    entry.text.assign(input);
+    entry.width = int(start) + MeasureWidth(input, start);
+  }
+  return entry.width;
+}
+
+}  // namespace
+
+int string_width(std::string_view input) {
+  // Fast path:
+  const size_t ascii = PrintableAsciiRun(input, 0);
+  if (ascii == input.size()) {
+    return int(ascii);
+  }
+  if (input.size() >= kWidthCacheMinSize &&
+      input.size() <= kWidthCacheMaxSize) {
+    return CachedWidth(input, ascii);
+  }
+  return int(ascii) + MeasureWidth(input, ascii);
+}
+
 std::vector<std::string> Utf8ToGlyphs(const std::string& input) {
   std::vector<std::string> out;
   out.reserve(input.size());
   size_t start = 0;
   size_t end = 0;
   while (start < input.size()) {
+    // Fast path:
+    const size_t ascii = PrintableAsciiRun(input, start);
+    for (size_t i = start; i < start + ascii; ++i) {
+      out.emplace_back(1, input[i]);
+    }
+    start += ascii;
+    if (start >= input.size()) {
+      break;
+    }
+
     uint32_t codepoint = 0;
     if (!EatCodePoint(input, start, &end, &codepoint)) {
       start = end;
@@ -1396,6 +1604,56 @@ std::vector<std::string> Utf8ToGlyphs(const std::string& input) {
   return out;
 }
 
+GlyphRange::Iterator::Iterator(std::string_view input, size_t start)
+    : input_(input), start_(start), next_(start) {
+  if (start_ < input_.size()) {
+    Advance();
+  }
+}
+
+// Move to the next glyph, or to the end of the input.
+void GlyphRange::Iterator::Advance() {
+  size_t start = next_;
+  size_t end = start;
+  uint32_t codepoint = 0;
+  while (start < input_.size()) {
+    // Fast path: an ASCII character not followed by a combining one.
+    if (IsPrintableAscii(input_[start]) &&
+        (start + 1 >= input_.size() ||
+         static_cast<uint8_t>(input_[start + 1]) < 0x80)) {  // NOLINT
+      start_ = start;
+      next_ = start + 1;
+      glyph_ = {input_.substr(start, 1), 1};
+      return;
+    }
+
+    // Ignore invalid, control characters and combining characters not
+    // following a glyph.
+    if (!EatCodePoint(input_, start, &end, &codepoint) ||
+        IsControl(codepoint) || IsCombining(codepoint)) {
+      start = end;
+      continue;
+    }
+    const int width = IsFullWidth(codepoint) ? 2 : 1;
+
+    // Combining characters are part of the glyph they are modifying.
+    size_t next = end;
+    while (next < input_.size() &&
+           EatCodePoint(input_, next, &end, &codepoint) &&
+           IsCombining(codepoint)) {
+      next = end;
+    }
+
+    start_ = start;
+    next_ = next;
+    glyph_ = {input_.substr(start, next - start), width};
+    return;
+  }
+  start_ = input_.size();
+  next_ = input_.size();
+  glyph_ = {};
+}
+
 size_t GlyphPrevious(const std::string& input, size_t start) {
   while (true) {
     if (start == 0) {
@@ -1554,9 +1812,7 @@ std::vector<WordBreakProperty> Utf8ToWordBreakProperty(
       continue;
     }
 
-    WordBreakPropertyInterval interval = {0, 0, WBP::ALetter};
-    std::ignore = Bisearch(codepoint, g_word_break_intervals, &interval);
-    out.push_back(interval.property);
+    out.push_back(CodepointToWordBreakProperty(codepoint));
   }
   return out;
 }
@@ -1564,10 +1820,18 @@ std::vector<WordBreakProperty> Utf8ToWordBreakProperty(
 /// Convert a UTF8 std::string into a std::wstring.
 std::string to_string(const std::wstring& s) {
   std::string out;
+  out.reserve(s.size());
 
   size_t i = 0;
   uint32_t codepoint = 0;
-  while (EatCodePoint(s, i, &i, &codepoint)) {
+  while (true) {
+    // Copy the ASCII characters, without decoding them.
+    while (i < s.size() && uint32_t(s[i]) < 0x80) {  // NOLINT
+      out.push_back(char(s[i++]));                   // NOLINT
+    }
+    if (!EatCodePoint(s, i, &i, &codepoint)) {
+      break;
+    }
     // Code point <-> UTF-8 conversion
     //
     // ┏━━━━━━━━┳━━━━━━━━┳━━━━━━━━┳━━━━━━━━┓
@@ -1636,10 +1900,18 @@ std::string to_string(const std::wstring& s) {
 /// Convert a std::wstring into a UTF8 std::string.
 std::wstring to_wstring(const std::string& s) {
   std::wstring out;
+  out.reserve(s.size());
 
   size_t i = 0;
   uint32_t codepoint = 0;
-  while (EatCodePoint(s, i, &i, &codepoint)) {
+  while (true) {
+    // Copy the ASCII characters, without decoding them.
+    const size_t ascii = AsciiRun(s, i);
+    out.append(s.begin() + i, s.begin() + i + ascii);  // NOLINT
+    i += ascii;
+    if (!EatCodePoint(s, i, &i, &codepoint)) {
+      break;
+    }
     // On linux wstring are UTF32 encoded:
     if constexpr (sizeof(wchar_t) == 4) {
       out.push_back(codepoint);  // NOLINT
@@ -6,11 +6,12 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace ftxui {
 
-bool EatCodePoint(const std::string& input,
+bool EatCodePoint(std::string_view input,
                   size_t start,
                   size_t* end,
                   uint32_t* ucs);
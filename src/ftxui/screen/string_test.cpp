@@ -3,7 +3,9 @@
 // the LICENSE file.
 #include "ftxui/screen/string.hpp"
 #include <gtest/gtest.h>
-#include <string>  // for allocator, string
+#include <string>   // for allocator, string
+#include <utility>  // for pair
+#include <vector>   // for vector
 #include "ftxui/screen/string_internal.hpp"
 
 namespace ftxui {
@@ -30,6 +32,30 @@ TEST(StringTest, StringWidth) {
   EXPECT_EQ(2, string_width("a\1a"));
 }
 
+TEST(StringTest, StringWidthCached) {
+  // The strings long enough to be memoized, measured several times, and
+  // evicting each other.
+  std::vector<std::string> inputs;
+  for (int i = 0; i < 2000; ++i) {
+    std::string input = "label " + std::to_string(i) + " ";
+    for (int j = 0; j <= i % 7; ++j) {
+      input += (i + j) % 2 ? "测试" : "e\u0301";
+    }
+    inputs.push_back(input);
+  }
+  for (int pass = 0; pass < 3; ++pass) {
+    for (const auto& input : inputs) {
+      int expected = 0;
+      for (const Glyph& glyph : GlyphRange(input)) {
+        expected += glyph.width;
+      }
+      ASSERT_EQ(string_width(input), expected) << input;
+    }
+  }
+  EXPECT_EQ(string_width("0123456789abcdef测"), 18);
+  EXPECT_EQ(string_width("0123456789abcdef\x01"), 16);
+}
+
 TEST(StringTest, Utf8ToGlyphs) {
   using T = std::vector<std::string>;
   // Basic:
@@ -48,6 +74,70 @@ TEST(StringTest, Utf8ToGlyphs) {
   EXPECT_EQ(Utf8ToGlyphs("a\1a"), T({"a", "a"}));
 }
 
+TEST(StringTest, AsciiRuns) {
+  using T = std::vector<std::string>;
+  const std::string ascii = "0123456789abcdefghij";
+  EXPECT_EQ(20, string_width(ascii));
+  EXPECT_EQ(Utf8ToGlyphs(ascii).size(), 20u);
+
+  // Characters breaking the ASCII runs, at every position of a word:
+  for (size_t i = 0; i < ascii.size(); ++i) {
+    for (const std::string c : {"\1", "\x7f", "\x1f"}) {
+      std::string input = ascii;
+      input[i] = c[0];
+      EXPECT_EQ(19, string_width(input));
+      EXPECT_EQ(Utf8ToGlyphs(input).size(), 19u);
+    }
+
+    std::string input = ascii;
+    input.replace(i, 1, "测");
+    EXPECT_EQ(21, string_width(input));
+    EXPECT_EQ(Utf8ToGlyphs(input).size(), 21u);
+    EXPECT_EQ(Utf8ToGlyphs(input)[i], "测");
+
+    // A combining character is appended to the last ASCII character.
+    input = ascii;
+    input.insert(i + 1, "\u0317");
+    EXPECT_EQ(20, string_width(input));
+    EXPECT_EQ(Utf8ToGlyphs(input).size(), 20u);
+    EXPECT_EQ(Utf8ToGlyphs(input)[i], ascii.substr(i, 1) + "\u0317");
+  }
+
+  EXPECT_EQ(Utf8ToGlyphs("abcdefgh\nij"),
+            T({"a", "b", "c", "d", "e", "f", "g", "h", "\n", "i", "j"}));
+}
+
+TEST(StringTest, GlyphRange) {
+  using T = std::vector<std::pair<std::string, int>>;
+  auto glyphs = [](const std::string& input) {
+    T out;
+    for (const Glyph& glyph : GlyphRange(input)) {
+      out.emplace_back(glyph.text, glyph.width);
+    }
+    return out;
+  };
+  // Basic:
+  EXPECT_EQ(glyphs(""), T({}));
+  EXPECT_EQ(glyphs("a"), T({{"a", 1}}));
+  EXPECT_EQ(glyphs("ab"), T({{"a", 1}, {"b", 1}}));
+  EXPECT_EQ(glyphs("a\nb"), T({{"a", 1}, {"\n", 1}, {"b", 1}}));
+  // Fullwidth glyphs:
+  EXPECT_EQ(glyphs("测试"), T({{"测", 2}, {"试", 2}}));
+  EXPECT_EQ(glyphs("a测"), T({{"a", 1}, {"测", 2}}));
+  // Combining characters:
+  EXPECT_EQ(glyphs("ā"), T({{"ā", 1}}));
+  EXPECT_EQ(glyphs("a⃒b"), T({{"a⃒", 1}, {"b", 1}}));
+  EXPECT_EQ(glyphs("a̗̗"), T({{"a̗̗", 1}}));
+  EXPECT_EQ(glyphs("\u0317a"), T({{"a", 1}}));
+  // Control characters:
+  EXPECT_EQ(glyphs("\1"), T({}));
+  EXPECT_EQ(glyphs("a\1a\1"), T({{"a", 1}, {"a", 1}}));
+
+  // The glyphs are views of the input:
+  const std::string input = "abc";
+  EXPECT_EQ(GlyphRange(input).begin()->text.data(), input.data());
+}
+
 TEST(StringTest, GlyphCount) {
   // Basic:
   EXPECT_EQ(GlyphCount(""), 0);
@@ -142,6 +232,34 @@ TEST(StringTest, Utf8ToWordBreakProperty) {
   EXPECT_EQ(Utf8ToWordBreakProperty("\n"), T({P::LF}));
 }
 
+TEST(StringTest, CodepointProperties) {
+  using P = WordBreakProperty;
+  // Around the bounds of the intervals:
+  EXPECT_FALSE(IsFullWidth(0x10ff));
+  EXPECT_TRUE(IsFullWidth(0x1100));
+  EXPECT_TRUE(IsFullWidth(0x115f));
+  EXPECT_FALSE(IsFullWidth(0x1160));
+  EXPECT_FALSE(IsCombining(0x2ff));
+  EXPECT_TRUE(IsCombining(0x300));
+  EXPECT_TRUE(IsCombining(0x36f));
+  EXPECT_FALSE(IsCombining(0x370));
+  EXPECT_TRUE(IsControl(0x9f));
+  EXPECT_FALSE(IsControl(0xa0));
+  EXPECT_EQ(CodepointToWordBreakProperty(0x1f1e5), P::ALetter);
+  EXPECT_EQ(CodepointToWordBreakProperty(0x1f1e6), P::Regional_Indicator);
+
+  // Fullwidth pages:
+  EXPECT_TRUE(IsFullWidth(0x4e00));
+  EXPECT_TRUE(IsFullWidth(0x9fff));
+  EXPECT_TRUE(IsFullWidth(0x20000));
+
+  // Beyond the two level table:
+  EXPECT_EQ(CodepointToWordBreakProperty(0xe0001), P::Format);
+  EXPECT_TRUE(IsCombining(0xe0100));
+  EXPECT_FALSE(IsCombining(0xe01f0));
+  EXPECT_EQ(CodepointToWordBreakProperty(0x10ffff), P::ALetter);
+}
+
 TEST(StringTest, to_string) {
   EXPECT_EQ(to_string(L"hello"), "hello");
   EXPECT_EQ(to_string(L"€"), "€");
@@ -164,4 +282,16 @@ TEST(StringTest, to_wstring) {
   EXPECT_EQ(to_wstring(std::string("🎅🎄")), L"🎅🎄");
 }
 
+TEST(StringTest, TranscodeLongRuns) {
+  // ASCII runs longer than a word, around multi-byte code points.
+  const std::string utf8 = "the quick brown fox €jumps over🎅 the lazy dog ß";
+  const std::wstring wide = L"the quick brown fox €jumps over🎅 the lazy dog ß";
+  EXPECT_EQ(to_wstring(utf8), wide);
+  EXPECT_EQ(to_string(wide), utf8);
+  EXPECT_EQ(to_string(to_wstring(utf8)), utf8);
+
+  // The conversion stops at the first byte not starting a code point.
+  EXPECT_EQ(to_wstring(std::string("abcdefghij\x80klm")), L"abcdefghij");
+}
+
 }  // namespace ftxui
@@ -1,6 +1,7 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
+#include <atomic>   // for atomic
 #include <cstdlib>  // for getenv
 #include <string>   // for string, allocator
 
@@ -23,8 +24,12 @@ namespace ftxui {
 
 namespace {
 
-bool g_cached = false;                     // NOLINT
-Terminal::Color g_cached_supported_color;  // NOLINT
+// Atomic: colors are built by any thread, like the ones building elements.
+// -1 until the color support is computed.
+std::atomic<int> g_cached_supported_color = -1;  // NOLINT
+std::atomic<bool> g_repeat_supported = false;    // NOLINT
+// -1 until the graphics support is computed.
+std::atomic<int> g_graphics_support = -1;  // NOLINT
 
 Dimensions& FallbackSize() {
 #if defined(__EMSCRIPTEN__)
@@ -61,6 +66,12 @@ Terminal::Color ComputeColorSupport() {
   return Terminal::Color::TrueColor;
 #endif
 
+  // https://no-color.org: the colors are dropped when NO_COLOR is set and not
+  // empty.
+  if (*Safe(std::getenv("NO_COLOR")) != '\0') {  // NOLINT
+    return Terminal::Color::Palette1;
+  }
+
   std::string COLORTERM = Safe(std::getenv("COLORTERM"));  // NOLINT
   if (Contains(COLORTERM, "24bit") || Contains(COLORTERM, "truecolor")) {
     return Terminal::Color::TrueColor;
@@ -84,6 +95,19 @@ Terminal::Color ComputeColorSupport() {
   return Terminal::Color::Palette16;
 }
 
+// Only the terminals announcing themselves are known to support the kitty
+// graphics protocol. Sixel support must be declared, see SetGraphicsSupport().
+Terminal::Graphics ComputeGraphicsSupport() {
+  const std::string TERM = Safe(std::getenv("TERM"));                  // NOLINT
+  const std::string TERM_PROGRAM = Safe(std::getenv("TERM_PROGRAM"));  // NOLINT
+  if (Contains(TERM, "kitty") || Contains(TERM, "ghostty") ||
+      Contains(TERM_PROGRAM, "WezTerm") ||
+      *Safe(std::getenv("KITTY_WINDOW_ID")) != '\0') {  // NOLINT
+    return Terminal::Graphics::Kitty;
+  }
+  return Terminal::Graphics::None;
+}
+
 }  // namespace
 
 namespace Terminal {
@@ -107,9 +131,22 @@ Dimensions Size() {
   }
 
   return FallbackSize();
+#else
+  return Size(STDOUT_FILENO);
+#endif
+}
+
+/// @brief Get the size of the terminal behind |fd|, like a pseudo terminal.
+/// @return The terminal size, or the fallback size if |fd| isn't a terminal.
+/// @note This is only supported on POSIX systems. Elsewhere, this is Size().
+/// @ingroup screen
+Dimensions Size(int fd) {
+#if defined(__EMSCRIPTEN__) || defined(_WIN32)
+  (void)fd;
+  return Size();
 #else
   winsize w{};
-  const int status = ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);  // NOLINT
+  const int status = ioctl(fd, TIOCGWINSZ, &w);  // NOLINT
   // The ioctl return value result should be checked. Some operating systems
   // don't support TIOCGWINSZ.
   if (w.ws_col == 0 || w.ws_row == 0 || status < 0) {
@@ -128,19 +165,57 @@ void SetFallbackSize(const Dimensions& fallbackSize) {
 /// @brief Get the color support of the terminal.
 /// @ingroup screen
 Color ColorSupport() {
-  if (!g_cached) {
-    g_cached = true;
-    g_cached_supported_color = ComputeColorSupport();
+  int color = g_cached_supported_color;
+  if (color < 0) {
+    // Several threads may compute it at once. They find the same value.
+    color = ComputeColorSupport();
+    int expected = -1;
+    g_cached_supported_color.compare_exchange_strong(expected, color);
+    color = g_cached_supported_color;
   }
-  return g_cached_supported_color;
+  return Color(color);
 }
 
 /// @brief Override terminal color support in case auto-detection fails
 /// @ingroup dom
 void SetColorSupport(Color color) {
-  g_cached = true;
   g_cached_supported_color = color;
 }
 
+/// @brief Whether the terminal supports the REP sequence, repeating the
+/// previous character. It can't be detected reliably, so it is false unless
+/// set by SetRepeatSupport().
+/// @ingroup screen
+bool RepeatSupport() {
+  return g_repeat_supported;
+}
+
+/// @brief Declare the terminal supports the REP sequence. The frames then use
+/// it for the runs of repeated characters, like the borders.
+/// @ingroup screen
+void SetRepeatSupport(bool supported) {
+  g_repeat_supported = supported;
+}
+
+/// @brief Get the graphics protocol supported by the terminal. Guessed from
+/// the environment, unless set by SetGraphicsSupport().
+/// @ingroup screen
+Graphics GraphicsSupport() {
+  int cached = g_graphics_support;
+  if (cached < 0) {
+    cached = int(ComputeGraphicsSupport());
+    g_graphics_support = cached;
+  }
+  return Graphics(cached);
+}
+
+/// @brief Declare the graphics protocol supported by the terminal. The bitmaps
+/// are then sent to the terminal, instead of being drawn with half blocks.
+/// See imageBitmap().
+/// @ingroup screen
+void SetGraphicsSupport(Graphics graphics) {
+  g_graphics_support = int(graphics);
+}
+
 }  // namespace Terminal
 }  // namespace ftxui
@@ -64,4 +64,25 @@ TEST(ConstStringListRef, UniquePtrAdapter) {
   auto menu = Menu(std::move(a), &selected);
 }
 
+TEST(ConstStringListRef, View) {
+  std::vector<std::string> entries = {"a", "b"};
+  ConstStringListRef ref(&entries);
+  EXPECT_EQ(ref.view(1), "b");
+  EXPECT_EQ(ref.view(1).data(), entries[1].data());
+
+  std::vector<std::wstring> wide = {L"a", L"€"};
+  ConstStringListRef wide_ref(&wide);
+  const std::string_view converted = wide_ref.view(1);
+  EXPECT_EQ(converted, "€");
+  // The conversion is cached, until the source changes.
+  EXPECT_EQ(wide_ref.view(1).data(), converted.data());
+  wide[1] = L"c";
+  EXPECT_EQ(wide_ref.view(1), "c");
+
+  Adapter adapter(entries);
+  ConstStringListRef adapter_ref(&adapter);
+  EXPECT_EQ(adapter_ref.view(3), "b");
+  EXPECT_EQ(ConstStringListRef().view(0), "");
+}
+
 }  // namespace ftxui